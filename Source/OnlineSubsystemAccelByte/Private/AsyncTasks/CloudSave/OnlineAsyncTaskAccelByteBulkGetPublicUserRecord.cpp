@@ -6,28 +6,84 @@
 #include "OnlineSubsystemAccelByte.h"
 #include "OnlineCloudSaveInterfaceAccelByte.h"
 #include "OnlineError.h"
+#include "Algo/Reverse.h"
+#include "Misc/ConfigCacheIni.h"
+#if WITH_DEV_AUTOMATION_TESTS
+#include "ExecTests/ExecTestBackendOverrides.h"
+#endif
 
 
 #define ONLINE_ERROR_NAMESPACE "FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord"
 
-FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const FString& InKey, const TArray<FString>& InUserIds)
+FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const TArray<FString>& InKeys, const TArray<FString>& InUserIds, EAccelByteBulkGetPublicUserRecordMode InMode)
 	: FOnlineAsyncTaskAccelByte(InABInterface)
-	, Key(InKey)
-	, UserIds(InUserIds)
+	, Keys(InKeys)
+	, Mode(InMode)
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InLocalUserId);
+
+	// Lobby sized lists often repeat users, such as a party that is also in the same session, so only ask for each once
+	UserIds.Reserve(InUserIds.Num());
+	for (const FString& RecordUserId : InUserIds)
+	{
+		UserIds.AddUnique(RecordUserId);
+	}
+
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("BulkGetPublicUserRecordChunkSize"), ChunkSize, GEngineIni);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("MaxConcurrentUserRecordQueries"), MaxConcurrentChunkQueries, GEngineIni);
+	ChunkSize = FMath::Max(ChunkSize, 1);
+	MaxConcurrentChunkQueries = FMath::Max(MaxConcurrentChunkQueries, 1);
 }
 
 void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::Initialize()
 {
 	Super::Initialize();
 
-	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Getting bulk user record, UserId: %s"), *UserId->ToDebugString());
+	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Getting bulk user record, UserId: %s, KeyCount: %d, UserCount: %d"), *UserId->ToDebugString(), Keys.Num(), UserIds.Num());
 
-	OnBulkGetPublicUserRecordSuccessDelegate = TDelegateUtils<THandler<FListAccelByteModelsUserRecord>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordSuccess);
-	OnBulkGetPublicUserRecordErrorDelegate = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordError);
-	ApiClient->CloudSave.BulkGetPublicUserRecord(Key, UserIds, OnBulkGetPublicUserRecordSuccessDelegate, OnBulkGetPublicUserRecordErrorDelegate);
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
+	const bool bIsCacheEnabled = CloudSaveInterface.IsValid() && CloudSaveInterface->IsUserRecordCacheEnabled();
+
+	{
+		FScopeLock ScopeLock(&ChunkQueueLock);
+		for (const FString& Key : Keys)
+		{
+			FListAccelByteModelsUserRecord& KeyRecords = KeyToUserRecords.FindOrAdd(Key);
 
+			// Only request records for users that we don't have a fresh copy of
+			TArray<FString> UserIdsToQuery;
+			for (const FString& RecordUserId : UserIds)
+			{
+				FAccelByteModelsUserRecord CachedRecord;
+				if (bIsCacheEnabled && CloudSaveInterface->LookupUserRecordForRead(RecordUserId, Key, true, CachedRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Hit)
+				{
+					KeyRecords.Data.Add(CachedRecord);
+				}
+				else
+				{
+					UserIdsToQuery.Add(RecordUserId);
+				}
+			}
+
+			for (int32 ChunkStart = 0; ChunkStart < UserIdsToQuery.Num(); ChunkStart += ChunkSize)
+			{
+				const int32 ChunkCount = FMath::Min(ChunkSize, UserIdsToQuery.Num() - ChunkStart);
+				QueuedChunks.Emplace(Key, TArray<FString>(UserIdsToQuery.GetData() + ChunkStart, ChunkCount));
+			}
+		}
+
+		if (QueuedChunks.Num() <= 0)
+		{
+			CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+			AB_OSS_ASYNC_TASK_TRACE_END(TEXT("All requested public user records served from cache"));
+			return;
+		}
+
+		// Pop from the back of the queue when dispatching, so reverse to keep requesting chunks in the order they were built
+		Algo::Reverse(QueuedChunks);
+	}
+
+	DispatchQueuedChunks();
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
@@ -36,34 +92,126 @@ void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::TriggerDelegates()
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 
 	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
-	if (CloudSaveInterface.IsValid())
+	if (CloudSaveInterface.IsValid() && Mode != EAccelByteBulkGetPublicUserRecordMode::Prefetch)
 	{
-		if (bWasSuccessful)
+		// Chunks that were still in flight when another failed may land while we trigger, so fire with a copy of the records
+		FAccelByteUserRecordsByKey FoundUserRecords;
+		{
+			FScopeLock ScopeLock(&ChunkQueueLock);
+			FoundUserRecords = KeyToUserRecords;
+		}
+
+		const FOnlineError Result = bWasSuccessful ? ONLINE_ERROR(EOnlineErrorResult::Success) : ONLINE_ERROR(EOnlineErrorResult::RequestFailure, ErrorCode, ErrorStr);
+		if (Mode == EAccelByteBulkGetPublicUserRecordMode::SingleKey)
 		{
-			CloudSaveInterface->TriggerOnBulkGetPublicUserRecordCompletedDelegates(LocalUserNum, ONLINE_ERROR(EOnlineErrorResult::Success), ListUserRecord);
+			const FListAccelByteModelsUserRecord* ListUserRecord = Keys.Num() > 0 ? FoundUserRecords.Find(Keys[0]) : nullptr;
+			CloudSaveInterface->TriggerOnBulkGetPublicUserRecordCompletedDelegates(LocalUserNum, Result, ListUserRecord != nullptr ? *ListUserRecord : FListAccelByteModelsUserRecord());
 		}
 		else
 		{
-			CloudSaveInterface->TriggerOnBulkGetPublicUserRecordCompletedDelegates(LocalUserNum, ONLINE_ERROR(EOnlineErrorResult::RequestFailure, ErrorCode, ErrorStr), ListUserRecord);
+			CloudSaveInterface->TriggerOnBulkGetPublicUserRecordsCompletedDelegates(LocalUserNum, Result, FoundUserRecords);
 		}
 	}
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
-void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordSuccess(const FListAccelByteModelsUserRecord& Result)
+void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::SetChunkLimits(int32 InChunkSize, int32 InMaxConcurrentChunkQueries)
+{
+	ChunkSize = FMath::Max(InChunkSize, 1);
+	MaxConcurrentChunkQueries = FMath::Max(InMaxConcurrentChunkQueries, 1);
+}
+
+void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::QueryChunk(const FString& Key, const TArray<FString>& ChunkUserIds)
 {
-	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
-	ListUserRecord = Result;
-	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+#if WITH_DEV_AUTOMATION_TESTS
+	const TFunction<void(const FString&, const TArray<FString>&)> QueryChunkOverride = Subsystem->GetExecTestBackendOverrides().BulkGetPublicUserRecordChunk;
+	if (QueryChunkOverride)
+	{
+		QueryChunkOverride(Key, ChunkUserIds);
+		return;
+	}
+#endif
+
+	const THandler<FListAccelByteModelsUserRecord> OnBulkGetPublicUserRecordSuccessDelegate = TDelegateUtils<THandler<FListAccelByteModelsUserRecord>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordSuccess, Key);
+	const FErrorHandler OnBulkGetPublicUserRecordErrorDelegate = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordError, Key);
+	ApiClient->CloudSave.BulkGetPublicUserRecord(Key, ChunkUserIds, OnBulkGetPublicUserRecordSuccessDelegate, OnBulkGetPublicUserRecordErrorDelegate);
+}
+
+void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordSuccess(const FListAccelByteModelsUserRecord& Result, FString Key)
+{
+	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Key: %s, RecordCount: %d"), *Key, Result.Data.Num());
+	SetLastUpdateTimeToCurrentTime();
+
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
+	if (CloudSaveInterface.IsValid() && CloudSaveInterface->IsUserRecordCacheEnabled())
+	{
+		for (const FAccelByteModelsUserRecord& Record : Result.Data)
+		{
+			CloudSaveInterface->AddUserRecordToCache(Record.UserId, Key, true, Record);
+		}
+	}
+
+	bool bIsLastChunk = true;
+	{
+		FScopeLock ScopeLock(&ChunkQueueLock);
+		KeyToUserRecords.FindOrAdd(Key).Data.Append(Result.Data);
+		ChunksInFlight--;
+		if (QueuedChunks.Num() > 0 || ChunksInFlight > 0)
+		{
+			bIsLastChunk = false;
+		}
+		else if (!bIsComplete)
+		{
+			// A failed chunk will have already completed the task, so only mark success if every chunk came back. Checked
+			// under the lock so that a failure landing on another thread cannot complete the task at the same time.
+			CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+		}
+	}
+
+	if (!bIsLastChunk)
+	{
+		DispatchQueuedChunks();
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+		return;
+	}
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT("Request to get bulk public user record for user '%s' Success!"), *UserId->ToDebugString());
 }
 
-void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordError(int32 Code, const FString& ErrorMessage)
+void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::OnBulkGetPublicUserRecordError(int32 Code, const FString& ErrorMessage, FString Key)
 {
+	// Stop sending any queued chunks, responses for chunks already in flight will still be cached as they arrive
+	FScopeLock ScopeLock(&ChunkQueueLock);
+	ChunksInFlight--;
+	QueuedChunks.Empty();
+	if (bIsComplete)
+	{
+		return;
+	}
+
 	ErrorCode = FString::Printf(TEXT("%d"), Code);
 	ErrorStr = FText::FromString(TEXT("request-failed-get-bulk-public-user-record-error"));
-	UE_LOG_AB(Warning, TEXT("Failed to get bulk public user record! Error Code: %d; Error Message: %s"), Code, *ErrorMessage);
+	UE_LOG_AB(Warning, TEXT("Failed to get bulk public user record for key '%s'! Error Code: %d; Error Message: %s"), *Key, Code, *ErrorMessage);
 	CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
 }
 
+void FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord::DispatchQueuedChunks()
+{
+	// Take chunks and count them as in flight under the lock, but send them once it is released so that a response
+	// arriving straight away on another thread is not held up behind us
+	TArray<TPair<FString, TArray<FString>>> ChunksToSend;
+	{
+		FScopeLock ScopeLock(&ChunkQueueLock);
+		while (QueuedChunks.Num() > 0 && ChunksInFlight < MaxConcurrentChunkQueries)
+		{
+			ChunksToSend.Emplace(QueuedChunks.Pop(false));
+			ChunksInFlight++;
+		}
+	}
+
+	for (const TPair<FString, TArray<FString>>& Chunk : ChunksToSend)
+	{
+		QueryChunk(Chunk.Key, Chunk.Value);
+	}
+}
+
 #undef ONLINE_ERROR_NAMESPACE
\ No newline at end of file
@@ -9,16 +9,45 @@
 #include "OnlineCloudSaveInterfaceAccelByte.h"
 
 /**
- * Task for getting another user record
+ * What a bulk public user record fetch was requested for, which decides the delegates fired once it completes
+ */
+enum class EAccelByteBulkGetPublicUserRecordMode : uint8
+{
+	/** Single key requested through BulkGetPublicUserRecord, fires OnBulkGetPublicUserRecordCompleted */
+	SingleKey,
+	/** Several keys requested through BulkGetPublicUserRecords, fires OnBulkGetPublicUserRecordsCompleted */
+	MultipleKeys,
+	/** Records requested through PrefetchPublicUserRecords only to warm the cache, fires no delegates */
+	Prefetch
+};
+
+/**
+ * Task for getting public records of one or more keys for many users. Users are split into chunks no larger than the
+ * backend allows per request, and a bounded amount of chunks are requested at once.
  */
 class FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord : public FOnlineAsyncTaskAccelByte, public TSelfPtr<FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord, ESPMode::ThreadSafe>
 {
 public:
-	FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const FString& InKey, const TArray<FString>& InUserIds);
+	FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const TArray<FString>& InKeys, const TArray<FString>& InUserIds, EAccelByteBulkGetPublicUserRecordMode InMode = EAccelByteBulkGetPublicUserRecordMode::SingleKey);
 
 	virtual void Initialize() override;
 	virtual void TriggerDelegates() override;
 
+PACKAGE_SCOPE:
+
+	/** Override the chunk size and concurrent chunk limit read from config, must be called before Initialize */
+	void SetChunkLimits(int32 InChunkSize, int32 InMaxConcurrentChunkQueries);
+
+	/**
+	 * Delegate handler for when getting a chunk of public user records succeeds
+	 */
+	void OnBulkGetPublicUserRecordSuccess(const FListAccelByteModelsUserRecord& Result, FString Key);
+
+	/**
+	 * Delegate handler for when getting a chunk of public user records fails
+	 */
+	void OnBulkGetPublicUserRecordError(int32 Code, const FString& ErrorMessage, FString Key);
+
 protected:
 
 	virtual const FString GetTaskName() const override
@@ -29,16 +58,15 @@ protected:
 private:
 
 	/**
-	 * Delegate handler for when get another user record succeed
+	 * Send a request for the records of a single key for a chunk of users
 	 */
-	void OnBulkGetPublicUserRecordSuccess(const FListAccelByteModelsUserRecord& Result);
-	THandler<FListAccelByteModelsUserRecord> OnBulkGetPublicUserRecordSuccessDelegate;
+	void QueryChunk(const FString& Key, const TArray<FString>& ChunkUserIds);
 
 	/**
-	 * Delegate handler for when get another user record fails
+	 * Take queued chunks until we hit the concurrent chunk limit or run out of chunks, then send requests for them once
+	 * ChunkQueueLock has been released. Must not be called while holding ChunkQueueLock.
 	 */
-	void OnBulkGetPublicUserRecordError(int32 Code, const FString& ErrorMessage);
-	FErrorHandler OnBulkGetPublicUserRecordErrorDelegate;
+	void DispatchQueuedChunks();
 
 	/**
 	 * String representing the error code that occurred
@@ -46,16 +74,42 @@ private:
 	FText ErrorStr;
 
 	/**
-	 * String representing the record key to get
+	 * Record keys to get
 	 */
-	FString Key;
+	TArray<FString> Keys;
 
 	/**
-	 * String representing another user id
+	 * IDs of the users to get records for
 	 */
 	TArray<FString> UserIds;
 
+	/**
+	 * What these records were requested for
+	 */
+	EAccelByteBulkGetPublicUserRecordMode Mode;
+
 	FString ErrorCode;
 
-	FListAccelByteModelsUserRecord ListUserRecord;
+	/**
+	 * Records found for each key, both from cache and from the backend
+	 */
+	FAccelByteUserRecordsByKey KeyToUserRecords;
+
+	/** Chunks that still need to be requested, as pairs of key and user IDs */
+	TArray<TPair<FString, TArray<FString>>> QueuedChunks;
+
+	/** Number of chunk requests that have been sent and not yet responded to */
+	int32 ChunksInFlight = 0;
+
+	/**
+	 * Lock for the queued chunks, in flight count, found records and completing the task, as chunk responses may arrive on
+	 * different threads
+	 */
+	FCriticalSection ChunkQueueLock;
+
+	/** Maximum users to request records for in a single request, read from BulkGetPublicUserRecordChunkSize in config */
+	int32 ChunkSize = 20;
+
+	/** Maximum number of chunk requests that may be in flight at once, read from MaxConcurrentUserRecordQueries in config */
+	int32 MaxConcurrentChunkQueries = 4;
 };
\ No newline at end of file
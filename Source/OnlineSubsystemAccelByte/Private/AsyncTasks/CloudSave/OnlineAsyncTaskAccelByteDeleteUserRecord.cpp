@@ -79,6 +79,13 @@ void FOnlineAsyncTaskAccelByteDeleteUserRecord::TriggerDelegates()
 void FOnlineAsyncTaskAccelByteDeleteUserRecord::OnDeleteUserRecordSuccess()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
+
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
+	if (CloudSaveInterface.IsValid())
+	{
+		CloudSaveInterface->RemoveUserRecordFromCache(UserId->GetAccelByteId(), Key);
+	}
+
 	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT("Request to delete user record for user '%s' Success!"), *UserId->ToDebugString());
 }
@@ -51,6 +51,21 @@ void FOnlineAsyncTaskAccelByteGetUserRecord::Initialize()
 		return;
 	}
 
+	// Clients read their own records unless told otherwise, so resolve the owner up front to look the record up in cache
+	if (!IsRunningDedicatedServer() && RecordUserId.IsEmpty())
+	{
+		RecordUserId = UserId->GetAccelByteId();
+	}
+
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
+	if (CloudSaveInterface.IsValid() && CloudSaveInterface->IsUserRecordCacheEnabled()
+		&& CloudSaveInterface->LookupUserRecordForRead(RecordUserId, Key, IsPublicRecord, UserRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Hit)
+	{
+		CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT("User record '%s' for user '%s' served from cache"), *Key, *RecordUserId);
+		return;
+	}
+
 	if (IsRunningDedicatedServer())
 	{
 
@@ -69,15 +84,11 @@ void FOnlineAsyncTaskAccelByteGetUserRecord::Initialize()
 
 		if (IsPublicRecord)
 		{
-			if (RecordUserId.IsEmpty())
-			{
-				RecordUserId = *UserId->GetAccelByteId();
-			}
 			ApiClient->CloudSave.GetPublicUserRecord(Key, RecordUserId, OnGetUserRecordsSuccessDelegate, OnGetUserRecordsErrorDelegate);
 		}
 		else
 		{
-			if (RecordUserId.IsEmpty() || RecordUserId == *UserId->GetAccelByteId())
+			if (RecordUserId == UserId->GetAccelByteId())
 			{
 				ApiClient->CloudSave.GetUserRecord(Key, OnGetUserRecordsSuccessDelegate, OnGetUserRecordsErrorDelegate);
 			}
@@ -118,6 +129,13 @@ void FOnlineAsyncTaskAccelByteGetUserRecord::OnGetUserRecordsSuccess(const FAcce
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
 	UserRecord = Result;
+
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
+	if (CloudSaveInterface.IsValid() && CloudSaveInterface->IsUserRecordCacheEnabled())
+	{
+		CloudSaveInterface->AddUserRecordToCache(RecordUserId, Key, IsPublicRecord, UserRecord);
+	}
+
 	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT("Request to get user '%s' record Success!"), *RecordUserId);
 }
@@ -75,6 +75,13 @@ void FOnlineAsyncTaskAccelByteReplaceUserRecord::TriggerDelegates()
 void FOnlineAsyncTaskAccelByteReplaceUserRecord::OnReplaceUserRecordsSuccess()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
+
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = Subsystem->GetCloudSaveInterface();
+	if (CloudSaveInterface.IsValid() && CloudSaveInterface->IsUserRecordCacheEnabled())
+	{
+		CloudSaveInterface->OnUserRecordReplaced(UserId->GetAccelByteId(), Key, IsPublicRecord);
+	}
+
 	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT("Request to replace user '%s' record Success!"), *UserId->ToDebugString());
 }
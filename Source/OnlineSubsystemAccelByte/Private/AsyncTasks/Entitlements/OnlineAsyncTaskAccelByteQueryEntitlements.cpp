@@ -1,14 +1,21 @@
 ﻿#include "OnlineAsyncTaskAccelByteQueryEntitlements.h"
 
 #include "OnlineEntitlementsInterfaceAccelByte.h"
+#include "OnlineSubsystemAccelByteUtils.h"
 #include "Interfaces/OnlineEntitlementsInterface.h"
+#include "Algo/Reverse.h"
 
-FOnlineAsyncTaskAccelByteQueryEntitlements::FOnlineAsyncTaskAccelByteQueryEntitlements(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FString& InNamespace, const FPagedQuery& InPage)
+FOnlineAsyncTaskAccelByteQueryEntitlements::FOnlineAsyncTaskAccelByteQueryEntitlements(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FString& InNamespace, const FPagedQuery& InPage, const FString& InItemId, const FOnQueryEntitlementsCompleteDelegate& InDelegate)
 	: FOnlineAsyncTaskAccelByte(InABSubsystem),
 	Namespace(InNamespace),
-	PagedQuery(InPage)
+	PagedQuery(InPage),
+	ItemId(InItemId),
+	Delegate(InDelegate)
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InUserId);
+	bIsFullRefresh = PagedQuery.Start <= 0 && PagedQuery.Count == -1;
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("MaxConcurrentEntitlementPageQueries"), MaxConcurrentPageQueries, GEngineIni);
+	MaxConcurrentPageQueries = FMath::Max(MaxConcurrentPageQueries, 1);
 }
 
 void FOnlineAsyncTaskAccelByteQueryEntitlements::Initialize()
@@ -16,13 +23,27 @@ void FOnlineAsyncTaskAccelByteQueryEntitlements::Initialize()
 	FOnlineAsyncTaskAccelByte::Initialize();
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
 
-	if (PagedQuery.Count == -1 || PagedQuery.Count >= 100)
-	{
-		QueryEntitlement(PagedQuery.Start, 100);
-	}
-	else
+	QueryEntitlement(PagedQuery.Start, GetClampedPageLimit(PagedQuery.Start, 100));
+	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+}
+
+void FOnlineAsyncTaskAccelByteQueryEntitlements::Finalize()
+{
+	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
+	FOnlineAsyncTaskAccelByte::Finalize();
+
+	if (bIsFullRefresh)
 	{
-		QueryEntitlement(PagedQuery.Start, PagedQuery.Count);
+		const TSharedPtr<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> EntitlementsInterface = StaticCastSharedPtr<FOnlineEntitlementsAccelByte>(Subsystem->GetEntitlementsInterface());
+		if (bWasSuccessful)
+		{
+			EntitlementsInterface->ReplaceEntitlementsInMap(UserId.ToSharedRef(), ItemId, FetchedEntitlements);
+		}
+		else
+		{
+			// Not every page arrived, so we cannot tell what was removed. Keep what we did fetch without dropping anything.
+			EntitlementsInterface->AddEntitlementsToMap(UserId.ToSharedRef(), FetchedEntitlements);
+		}
 	}
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -32,22 +53,111 @@ void FOnlineAsyncTaskAccelByteQueryEntitlements::TriggerDelegates()
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
 	FOnlineAsyncTaskAccelByte::TriggerDelegates();
 	
+	Delegate.ExecuteIfBound(bWasSuccessful, *UserId, Namespace, ErrorMessage);
 	Subsystem->GetEntitlementsInterface()->TriggerOnQueryEntitlementsCompleteDelegates(bWasSuccessful, *UserId, Namespace, ErrorMessage);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
-void FOnlineAsyncTaskAccelByteQueryEntitlements::QueryEntitlement(int32 Offset, int32 Limit)
+void FOnlineAsyncTaskAccelByteQueryEntitlements::QueryEntitlement(int32 Offset, int32 Limit, bool bIsConcurrentPage)
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Starting Query entitlement, Offset: %d, Limit: %d"), Offset, Limit);
 	THandler<FAccelByteModelsEntitlementPagingSlicedResult> OnQueryEntitlementSuccess =
-		TDelegateUtils<THandler<FAccelByteModelsEntitlementPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementSuccess);
-	FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementError);
-	ApiClient->Entitlement.QueryUserEntitlements(TEXT(""), TEXT(""), Offset, Limit, OnQueryEntitlementSuccess, OnError, EAccelByteEntitlementClass::NONE, EAccelByteAppType::NONE);
+		TDelegateUtils<THandler<FAccelByteModelsEntitlementPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementSuccess, bIsConcurrentPage);
+	FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementError, bIsConcurrentPage);
+	ApiClient->Entitlement.QueryUserEntitlements(TEXT(""), ItemId, Offset, Limit, OnQueryEntitlementSuccess, OnError, EAccelByteEntitlementClass::NONE, EAccelByteAppType::NONE);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
-void FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementSuccess(FAccelByteModelsEntitlementPagingSlicedResult const& Result)
-{	
+void FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementSuccess(FAccelByteModelsEntitlementPagingSlicedResult const& Result, bool bIsConcurrentPage)
+{
+	SetLastUpdateTimeToCurrentTime();
+	AddEntitlementsFromPage(Result);
+
+	if (bIsConcurrentPage)
+	{
+		bool bIsLastPage = false;
+		bool bHasFailed = false;
+		{
+			FScopeLock ScopeLock(&PageQueueLock);
+			PagesInFlight--;
+			bIsLastPage = PagesInFlight == 0 && QueuedPages.Num() == 0;
+			bHasFailed = bHasPageFailed;
+		}
+
+		if (!bIsLastPage)
+		{
+			DispatchQueuedPages();
+			return;
+		}
+
+		// Only the last page to come back completes the task, failing it if any other page failed along the way
+		CompleteTask(bHasFailed ? EAccelByteAsyncTaskCompleteState::RequestFailed : EAccelByteAsyncTaskCompleteState::Success);
+		return;
+	}
+
+	int32 NextOffset = -1;
+	int32 NextLimit = -1;
+	if (!FOnlineSubsystemAccelByteUtils::GetOffsetAndLimitFromPagingUrl(Result.Paging.Next, NextOffset, NextLimit)
+		|| GetClampedPageLimit(NextOffset, NextLimit) <= 0)
+	{
+		CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+		return;
+	}
+
+	// If the backend told us where the last page starts, we know every remaining offset up front and can fetch them
+	// concurrently. Otherwise fall back to walking the next links one page at a time.
+	int32 LastOffset = -1;
+	int32 LastLimit = -1;
+	if (FOnlineSubsystemAccelByteUtils::GetOffsetAndLimitFromPagingUrl(Result.Paging.Last, LastOffset, LastLimit)
+		&& QueueRemainingPages(NextOffset, NextLimit, LastOffset))
+	{
+		DispatchQueuedPages();
+		return;
+	}
+
+	QueryEntitlement(NextOffset, GetClampedPageLimit(NextOffset, NextLimit));
+}
+
+void FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementError(int32 Code, FString const& ErrMsg, bool bIsConcurrentPage)
+{
+	AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Error, TEXT("Code: %d; Message: %s"), Code, *ErrMsg);
+
+	if (bIsConcurrentPage)
+	{
+		// Stop sending any queued pages, but let pages already in flight come back before completing, caching them as
+		// they arrive. Whichever page comes back last completes the task.
+		bool bIsLastPage = false;
+		{
+			FScopeLock ScopeLock(&PageQueueLock);
+			PagesInFlight--;
+			QueuedPages.Empty();
+			if (!bHasPageFailed)
+			{
+				bHasPageFailed = true;
+				ErrorMessage = ErrMsg;
+			}
+			bIsLastPage = PagesInFlight == 0;
+		}
+
+		if (bIsLastPage)
+		{
+			CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
+		}
+
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+		return;
+	}
+
+	ErrorMessage = ErrMsg;
+	CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
+
+	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+}
+
+void FOnlineAsyncTaskAccelByteQueryEntitlements::AddEntitlementsFromPage(FAccelByteModelsEntitlementPagingSlicedResult const& Result)
+{
+	TArray<TSharedRef<FOnlineEntitlement>> Entitlements;
+	Entitlements.Reserve(Result.Data.Num());
 	for(FAccelByteModelsEntitlementInfo const& EntInfo : Result.Data)
 	{
 		TSharedRef<FOnlineEntitlement> Entitlement = MakeShared<FOnlineEntitlement>();
@@ -62,65 +172,70 @@ void FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementSuccess(F
 		Entitlement->ItemId = EntInfo.ItemId;
 		Entitlement->RemainingCount = EntInfo.UseCount;
 		Entitlement->StartDate = EntInfo.StartDate;
-		
-		const TSharedPtr<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> EntitlementsInterface = StaticCastSharedPtr<FOnlineEntitlementsAccelByte>(Subsystem->GetEntitlementsInterface());
-		EntitlementsInterface->AddEntitlementToMap(UserId.ToSharedRef(), Entitlement);
-		
-		if(PagedQuery.Count != -1)
-		{
-			PagedQuery.Count -= 1;
+		Entitlements.Add(Entitlement);
+	}
 
-			if(PagedQuery.Count == 0)
-			{
-				CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
-			}
-		}
+	if (bIsFullRefresh)
+	{
+		FScopeLock ScopeLock(&PageQueueLock);
+		FetchedEntitlements.Append(MoveTemp(Entitlements));
+		return;
+	}
+
+	const TSharedPtr<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> EntitlementsInterface = StaticCastSharedPtr<FOnlineEntitlementsAccelByte>(Subsystem->GetEntitlementsInterface());
+	EntitlementsInterface->AddEntitlementsToMap(UserId.ToSharedRef(), Entitlements);
+}
+
+bool FOnlineAsyncTaskAccelByteQueryEntitlements::QueueRemainingPages(int32 NextOffset, int32 PageLimit, int32 LastOffset)
+{
+	if (PageLimit <= 0 || LastOffset <= NextOffset)
+	{
+		return false;
 	}
 
-	// this should global function, can be accessed anywhere
-	if(!Result.Paging.Next.IsEmpty())
+	FScopeLock ScopeLock(&PageQueueLock);
+	for (int32 Offset = NextOffset; Offset <= LastOffset; Offset += PageLimit)
 	{
-		FString UrlOut;
-		FString Params;
-		Result.Paging.Next.Split(TEXT("?"), &UrlOut, &Params);
-		if(!Params.IsEmpty())
+		const int32 Limit = GetClampedPageLimit(Offset, PageLimit);
+		if (Limit <= 0)
 		{
-			TArray<FString> ParamsArray;
-			Params.ParseIntoArray(ParamsArray, TEXT("&"));
-			int32 Offset = -1;
-			int32 Limit = -1;
-			for(FString Param : ParamsArray)
-			{
-				FString Key;
-				FString Value;
-				Param.Split(TEXT("="), &Key, &Value);
-				if(Key.Equals(TEXT("offset")) && Value.IsNumeric())
-				{
-					Offset = FCString::Atoi(*Value);
-				}
-				else if(Key.Equals(TEXT("limit")) && Value.IsNumeric())
-				{
-					Limit = FCString::Atoi(*Value);
-				}
-
-				if(Offset != -1 && Limit != -1)
-				{
-					QueryEntitlement(Offset, Limit);
-					return;
-				}
-			}
+			break;
 		}
+		QueuedPages.Emplace(Offset, Limit);
 	}
-	
-	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+
+	// Pop from the back of the queue when dispatching, so reverse to keep requesting pages in ascending order
+	Algo::Reverse(QueuedPages);
+	return QueuedPages.Num() > 0;
 }
 
-void FOnlineAsyncTaskAccelByteQueryEntitlements::HandleQueryEntitlementError(int32 Code, FString const& ErrMsg)
+void FOnlineAsyncTaskAccelByteQueryEntitlements::DispatchQueuedPages()
 {
-	AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Error, TEXT("Code: %d; Message: %s"), Code, *ErrMsg);
+	// Count pages as in flight while still holding the lock, so that no response can see the queue empty with nothing in
+	// flight and complete the task before these pages are sent
+	TArray<TPair<int32, int32>> PagesToSend;
+	{
+		FScopeLock ScopeLock(&PageQueueLock);
+		while (QueuedPages.Num() > 0 && PagesInFlight < MaxConcurrentPageQueries)
+		{
+			PagesToSend.Add(QueuedPages.Pop(false));
+			PagesInFlight++;
+		}
+	}
 
-	ErrorMessage = ErrMsg;
-	CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
+	for (const TPair<int32, int32>& Page : PagesToSend)
+	{
+		QueryEntitlement(Page.Key, Page.Value, true);
+	}
+}
 
-	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+int32 FOnlineAsyncTaskAccelByteQueryEntitlements::GetClampedPageLimit(int32 Offset, int32 Limit) const
+{
+	if (PagedQuery.Count == -1)
+	{
+		return Limit;
+	}
+
+	const int32 EndOffset = PagedQuery.Start + PagedQuery.Count;
+	return FMath::Min(Limit, EndOffset - Offset);
 }
@@ -5,13 +5,15 @@
 #pragma once
 #include "AsyncTasks/OnlineAsyncTaskAccelByte.h"
 #include "AsyncTasks/OnlineAsyncTaskAccelByteUtils.h"
+#include "Interfaces/OnlineEntitlementsInterface.h"
 
 class FOnlineAsyncTaskAccelByteQueryEntitlements : public FOnlineAsyncTaskAccelByte, public TSelfPtr<FOnlineAsyncTaskAccelByteQueryEntitlements, ESPMode::ThreadSafe>
 {
 public:
-	FOnlineAsyncTaskAccelByteQueryEntitlements(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FString& InNamespace, const FPagedQuery& InPage);
+	FOnlineAsyncTaskAccelByteQueryEntitlements(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FString& InNamespace, const FPagedQuery& InPage, const FString& InItemId = TEXT(""), const FOnQueryEntitlementsCompleteDelegate& InDelegate = FOnQueryEntitlementsCompleteDelegate());
 
 	virtual void Initialize() override;
+	virtual void Finalize() override;
 	virtual void TriggerDelegates() override;
 
 protected:
@@ -22,11 +24,69 @@ protected:
 	}
 
 private:
-	void QueryEntitlement(int32 Offset, int32 Limit);
-	void HandleQueryEntitlementSuccess(FAccelByteModelsEntitlementPagingSlicedResult const& Result);
-	void HandleQueryEntitlementError(int32 Code, FString const& ErrMsg);
+	void QueryEntitlement(int32 Offset, int32 Limit, bool bIsConcurrentPage = false);
+	void HandleQueryEntitlementSuccess(FAccelByteModelsEntitlementPagingSlicedResult const& Result, bool bIsConcurrentPage);
+	void HandleQueryEntitlementError(int32 Code, FString const& ErrMsg, bool bIsConcurrentPage);
+
+	/**
+	 * Convert a page of results and add them to the entitlement cache in a single batch. For a full refresh the page is
+	 * held back instead, so that the cache can be replaced once every page has arrived.
+	 */
+	void AddEntitlementsFromPage(FAccelByteModelsEntitlementPagingSlicedResult const& Result);
+
+	/**
+	 * Once the last page is known from the first response, queue every remaining page and start fetching them concurrently.
+	 *
+	 * @returns true if remaining pages were queued, false if there is nothing to fetch concurrently
+	 */
+	bool QueueRemainingPages(int32 NextOffset, int32 PageLimit, int32 LastOffset);
+
+	/**
+	 * Take queued pages until we hit the concurrent page limit or run out of pages, then send queries for them once
+	 * PageQueueLock has been released. Must not be called while holding PageQueueLock.
+	 */
+	void DispatchQueuedPages();
+
+	/** Get the limit to use for a page at the given offset, so that we never fetch past the requested count */
+	int32 GetClampedPageLimit(int32 Offset, int32 Limit) const;
 
 	FString Namespace;
 	FPagedQuery PagedQuery;
 	FString ErrorMessage;
+
+	/** ID of the item to query entitlements for, or empty to query entitlements for every item */
+	FString ItemId;
+
+	/** Delegate fired for this query only, on top of the interface's query entitlements complete delegates */
+	FOnQueryEntitlementsCompleteDelegate Delegate;
+
+	/**
+	 * Whether this query fetches every page, in which case the cached entitlements it covers are replaced on success so
+	 * that revoked or consumed entitlements are dropped, rather than merged page by page
+	 */
+	bool bIsFullRefresh = false;
+
+	/** Entitlements fetched so far by a full refresh, guarded by PageQueueLock */
+	TArray<TSharedRef<FOnlineEntitlement>> FetchedEntitlements;
+
+	/** Pages that still need to be fetched, as pairs of offset and limit */
+	TArray<TPair<int32, int32>> QueuedPages;
+
+	/** Number of concurrent page queries that have been sent and not yet responded to */
+	int32 PagesInFlight = 0;
+
+	/**
+	 * Whether a concurrent page query has failed. The task still waits for pages already in flight before completing, so
+	 * that none of them respond to a task that has already finished.
+	 */
+	bool bHasPageFailed = false;
+
+	/**
+	 * Lock for the queued pages, in flight count, page failure and fetched entitlements, as page responses may arrive on
+	 * different threads
+	 */
+	FCriticalSection PageQueueLock;
+
+	/** Maximum number of page queries that may be in flight at once, read from MaxConcurrentEntitlementPageQueries in config */
+	int32 MaxConcurrentPageQueries = 4;
 };
@@ -8,8 +8,9 @@
 #include "Api/AccelByteUserApi.h"
 #include <OnlineFriendsInterfaceAccelByte.h>
 
-FOnlineAsyncTaskAccelByteQueryBlockedPlayers::FOnlineAsyncTaskAccelByteQueryBlockedPlayers(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InUserId)
+FOnlineAsyncTaskAccelByteQueryBlockedPlayers::FOnlineAsyncTaskAccelByteQueryBlockedPlayers(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InUserId, const FOnQueryBlockedPlayersCompleteDelegate& InDelegate)
 	: FOnlineAsyncTaskAccelByte(InABInterface)
+	, Delegate(InDelegate)
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InUserId);
 }
@@ -44,6 +45,8 @@ void FOnlineAsyncTaskAccelByteQueryBlockedPlayers::TriggerDelegates()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 
+	Delegate.ExecuteIfBound(UserId.ToSharedRef().Get(), bWasSuccessful, ErrorStr);
+
 	const IOnlineFriendsPtr FriendInterface = Subsystem->GetFriendsInterface();
 	FriendInterface->TriggerOnQueryBlockedPlayersCompleteDelegates(UserId.ToSharedRef().Get(), bWasSuccessful, ErrorStr);
 
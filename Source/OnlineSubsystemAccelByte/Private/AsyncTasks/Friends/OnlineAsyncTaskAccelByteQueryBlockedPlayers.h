@@ -9,6 +9,7 @@
 #include "Models/AccelByteLobbyModels.h"
 #include "Models/AccelByteUserModels.h"
 #include "OnlineUserCacheAccelByte.h"
+#include "Interfaces/OnlineFriendsInterface.h"
 
 /**
  * Task to get a list of all users that the user has blocked
@@ -17,7 +18,7 @@ class FOnlineAsyncTaskAccelByteQueryBlockedPlayers : public FOnlineAsyncTaskAcce
 {
 public:
 
-	FOnlineAsyncTaskAccelByteQueryBlockedPlayers(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InUserId);
+	FOnlineAsyncTaskAccelByteQueryBlockedPlayers(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InUserId, const FOnQueryBlockedPlayersCompleteDelegate& InDelegate = FOnQueryBlockedPlayersCompleteDelegate());
 
 	virtual void Initialize() override;
 	virtual void Finalize() override;
@@ -38,6 +39,9 @@ private:
 	/** String representing errors that occurred while trying to query blocked players, passed to delegate */
 	FString ErrorStr;
 
+	/** Delegate fired for this query only, on top of the interface's query blocked players complete delegates */
+	FOnQueryBlockedPlayersCompleteDelegate Delegate;
+
 	/** Delegate handler for when the request to list all blocked users succeeds */
 	void OnGetListOfBlockedUsersSuccess(const FAccelByteModelsListBlockedUserResponse& Result);
 
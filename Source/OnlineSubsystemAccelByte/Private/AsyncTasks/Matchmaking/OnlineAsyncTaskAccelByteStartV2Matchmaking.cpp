@@ -5,6 +5,7 @@
 #include "OnlineAsyncTaskAccelByteStartV2Matchmaking.h"
 #include "OnlineSessionInterfaceV2AccelByte.h"
 #include "OnlineSubsystemAccelByteSessionSettings.h"
+#include "OnlineRegionRankingAccelByte.h"
 
 #define ONLINE_ERROR_NAMESPACE "FOnlineAsyncTaskAccelByteStartV2Matchmaking"
 
@@ -100,6 +101,12 @@ void FOnlineAsyncTaskAccelByteStartV2Matchmaking::OnGetLatenciesSuccess(const TA
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
 
+	const FOnlineRegionRankingAccelBytePtr RegionRanking = Subsystem->GetRegionRanking();
+	if (RegionRanking.IsValid())
+	{
+		RegionRanking->AddLatencySamples(InLatencies);
+	}
+
 	CreateMatchTicket();
 
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
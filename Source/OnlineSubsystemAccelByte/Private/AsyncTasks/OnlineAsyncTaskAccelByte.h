@@ -13,6 +13,8 @@
 #include <Core/AccelByteMultiRegistry.h>
 #include <OnlineIdentityInterfaceAccelByte.h>
 #include <OnlineSubsystemAccelByte.h>
+#include <OnlineAsyncTaskMetricsAccelByte.h>
+#include <OnlineOperationTraceAccelByte.h>
 #include <Interfaces/OnlineStatsInterface.h>
 
 #define AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Verbosity, Format, ...) UE_LOG_AB(Verbosity, TEXT(">>> %s::%s (AsyncTask method) was called. Args: ") Format, *GetTaskName(), *FString(__func__), ##__VA_ARGS__)
@@ -42,15 +44,22 @@
 /**
  * Defines two delegates for use in an SDK call wrapped in an async task. Success delegate will have the name
  * On{Verb}SuccessDelegate, and be bound to the On{Verb}Success method of the class. Error delegate will have
- * the name On{Verb}ErrorDelegate, and be bound to the On{Verb}Error method of the class.
+ * the name On{Verb}ErrorDelegate, and be bound to the On{Verb}Error method of the class. The trace context of the task
+ * is made current while either handler runs, so that anything dispatched from the handler is traced under the task.
  * 
  * @param AsyncTaskClass Name of the class that we are binding delegate methods to
  * @param Verb Name of the action that is being handled by the two delegates, effects the name of the final delegates
  * @param SuccessType Delegate type for the success delegate
  */
 #define AB_ASYNC_TASK_DEFINE_SDK_DELEGATES(AsyncTaskClass, Verb, SuccessType) \
-	const SuccessType On##Verb##SuccessDelegate = SuccessType::CreateRaw(this, &AsyncTaskClass::On##Verb##Success); \
-	const FErrorHandler On##Verb##ErrorDelegate = FErrorHandler::CreateRaw(this, &AsyncTaskClass::On##Verb##Error);
+	const SuccessType On##Verb##SuccessDelegate = SuccessType::CreateLambda([this](auto&&... Args) { \
+		const FAccelByteTraceContextScope TraceContextScope(TraceContext); \
+		this->AsyncTaskClass::On##Verb##Success(Forward<decltype(Args)>(Args)...); \
+	}); \
+	const FErrorHandler On##Verb##ErrorDelegate = FErrorHandler::CreateLambda([this](int32 ErrorCode, const FString& ErrorMessage) { \
+		const FAccelByteTraceContextScope TraceContextScope(TraceContext); \
+		this->AsyncTaskClass::On##Verb##Error(ErrorCode, ErrorMessage); \
+	});
 
 /**
  * Convenience macro for async tasks to ensure that a expression evaluates to true, otherwise throwing an InvalidState error in the task.
@@ -171,6 +180,69 @@ public:
 		// than the SDK HTTP timeout to give the SDK a chance to fire off its delegates for a timeout.
 		// Fix this once https://accelbyte.atlassian.net/browse/OSS-193 is implemented.
 		TaskTimeoutInSeconds = static_cast<double>(AccelByte::FHttpRetryScheduler::TotalTimeout) + 1.0;
+
+		// Decide whether to record metrics and trace spans once on creation, so that a task never records only part of its lifetime
+		const FOnlineAsyncTaskMetricsAccelBytePtr Metrics = (InABSubsystem != nullptr) ? InABSubsystem->GetAsyncTaskMetrics() : nullptr;
+		bIsRecordingMetrics = Metrics.IsValid() && Metrics->IsEnabled();
+
+		// Tasks created while a traced operation is in progress on this thread are traced as part of that operation
+		const FOnlineOperationTraceAccelBytePtr OperationTrace = (InABSubsystem != nullptr) ? InABSubsystem->GetOperationTrace() : nullptr;
+		if (OperationTrace.IsValid() && OperationTrace->IsEnabled())
+		{
+			TraceContext = OperationTrace->CreateSpanContext(FAccelByteTraceContext::GetCurrent());
+		}
+
+		if (IsRecordingTimings())
+		{
+			CreatedTimeInSeconds = FPlatformTime::Seconds();
+		}
+	}
+
+	/**
+	 * Records how long it took for the delegates of this task to be triggered once it completed, as tasks are destroyed
+	 * by the manager straight after their delegates have been triggered on the game thread.
+	 */
+	virtual ~FOnlineAsyncTaskAccelByte() override
+	{
+		// Stop the timer wheel from tracking us, in case we are destroyed without having been completed
+		TimeoutState->bIsActive = false;
+
+		// Restore the trace context that was current before Finalize made ours current
+		if (bHasSetTraceContextForDelegates)
+		{
+			FAccelByteTraceContext::SetCurrent(TraceContextBeforeDelegates);
+		}
+
+		if (!IsRecordingTimings() || !bIsComplete || Subsystem == nullptr)
+		{
+			return;
+		}
+
+		const double DestroyedTimeInSeconds = FPlatformTime::Seconds();
+		const FOnlineAsyncTaskMetricsAccelBytePtr Metrics = Subsystem->GetAsyncTaskMetrics();
+		if (bIsRecordingMetrics && Metrics.IsValid())
+		{
+			Metrics->RecordTaskDelegatesTriggered(CachedTaskName, DestroyedTimeInSeconds - CompletedTimeInSeconds);
+		}
+
+		if (TraceContext.IsValid())
+		{
+			RecordTraceSpans(DestroyedTimeInSeconds);
+		}
+	}
+
+	/**
+	 * Makes the trace span of this task current while its Finalize and TriggerDelegates run on the game thread, so that
+	 * anything they dispatch is traced as part of the same operation. The previous context is restored once the task is
+	 * destroyed, which the manager does straight after triggering its delegates.
+	 */
+	virtual void Finalize() override
+	{
+		if (TraceContext.IsValid() && !bHasSetTraceContextForDelegates)
+		{
+			TraceContextBeforeDelegates = FAccelByteTraceContext::SetCurrent(TraceContext);
+			bHasSetTraceContextForDelegates = true;
+		}
 	}
 
 	/**
@@ -197,17 +269,27 @@ public:
 	}
 
 	/**
-	 * Basic initialize override to check if we are using timeouts, and if so update the last task update time to the
-	 * current time.
+	 * Basic initialize override to arm the timeout for this task in the manager's timer wheel, and to get the API client
+	 * and identifiers for the user performing this task.
 	 */
 	virtual void Initialize() override
 	{
 		CurrentState = EAccelByteAsyncTaskState::Initializing;
 
-		// We only care about setting the last update time if we are using a timeout
-		if (bShouldUseTimeout)
+		if (IsRecordingTimings())
+		{
+			RecordTimingsForStart();
+		}
+
+		// Arm our timeout in the manager's timer wheel rather than checking it on every tick. Tasks that do not use a
+		// timeout are still tracked, so that we can warn when they have been idle for too long.
+		SetLastUpdateTimeToCurrentTime();
+		TimeoutState->TimeoutInSeconds = TaskTimeoutInSeconds;
+		TimeoutState->bCompleteOnTimeout = bShouldUseTimeout;
+		const FOnlineAsyncTaskManagerAccelBytePtr AsyncTaskManager = (Subsystem != nullptr) ? Subsystem->GetAsyncTaskManager() : nullptr;
+		if (AsyncTaskManager.IsValid())
 		{
-			SetLastUpdateTimeToCurrentTime();
+			AsyncTaskManager->RegisterTaskTimeout(TimeoutState);
 		}
 
 		// Do not attempt to get API clients for server async tasks, as servers do not have API client support.
@@ -228,6 +310,14 @@ public:
 		}
 	}
 
+	/**
+	 * Get the context of the span recorded for this task, invalid if the task is not traced.
+	 */
+	const FAccelByteTraceContext& GetTraceContext() const
+	{
+		return TraceContext;
+	}
+
 	virtual FString ToString() const override
 	{
 		const FString CompleteStateString = AsyncTaskCompleteStateToString(CompleteState);
@@ -248,14 +338,11 @@ protected:
 	/** Whether this task requires a timeout to be used, will be set up through the constructor for the task */
 	bool bShouldUseTimeout = false;
 
-	/** Time in seconds since the last time an async portion of a task has updated its timeout */
-	double LastTaskUpdateInSeconds = FPlatformTime::Seconds();
-
 	/** Time in seconds that we should timeout this request, set to 30 seconds by default */
 	double TaskTimeoutInSeconds = 30.0;
 
-	/** Critical section for locking the last update time in seconds */
-	FCriticalSection TimeoutLock;
+	/** Timeout state shared with the manager's timer wheel, which flags this task once its deadline has passed */
+	FAccelByteAsyncTaskTimeoutRef TimeoutState = MakeShared<FAccelByteAsyncTaskTimeout, ESPMode::ThreadSafe>();
 
 	/**
 	 * Index of the user that we want to perform actions with, can be blank in favor of a user ID. Will be set to
@@ -272,6 +359,30 @@ protected:
 	/** Flags associated with this async task */
 	uint8 Flags = 0;
 
+	/** Whether this task records its timings into the subsystem's async task metrics, decided when the task is created */
+	bool bIsRecordingMetrics = false;
+
+	/** Trace span recorded for this task, invalid unless operation tracing was enabled when this task was created */
+	FAccelByteTraceContext TraceContext;
+
+	/** Trace context that was current before Finalize made ours current, restored once this task is destroyed */
+	FAccelByteTraceContext TraceContextBeforeDelegates;
+
+	/** Whether Finalize has made our trace context current */
+	bool bHasSetTraceContextForDelegates = false;
+
+	/** Name of this task cached for metrics and tracing, as the task name can no longer be retrieved once the task is being destroyed */
+	FString CachedTaskName;
+
+	/** Platform time in seconds that this task was created and queued at, only set when recording metrics or tracing */
+	double CreatedTimeInSeconds = 0.0;
+
+	/** Platform time in seconds that this task was initialized at, only set when recording metrics or tracing */
+	double StartedTimeInSeconds = 0.0;
+
+	/** Platform time in seconds that this task was completed at, only set when recording metrics or tracing */
+	double CompletedTimeInSeconds = 0.0;
+
 	/**
 	 * Basic method to get the current name of the task, used for ToString on tasks as well as trace logs.
 	 *
@@ -301,28 +412,102 @@ protected:
 		CompleteState = InCompleteState;
 		bWasSuccessful = (CompleteState == EAccelByteAsyncTaskCompleteState::Success);
 		bIsComplete = true;
+		TimeoutState->bIsActive = false;
+
+		if (IsRecordingTimings())
+		{
+			RecordTimingsForCompletion();
+		}
+
+		// Wake the online thread so that it hands us over for our delegates to be triggered now, rather than on its next poll
+		const FOnlineAsyncTaskManagerAccelBytePtr AsyncTaskManager = (Subsystem != nullptr) ? Subsystem->GetAsyncTaskManager() : nullptr;
+		if (AsyncTaskManager.IsValid())
+		{
+			AsyncTaskManager->WakeOnlineThread();
+		}
+	}
+
+	/**
+	 * Whether this task records the times it moves between stages, for either metrics or tracing.
+	 */
+	bool IsRecordingTimings() const
+	{
+		return bIsRecordingMetrics || TraceContext.IsValid();
+	}
+
+	/**
+	 * Record the time this task was initialized at, and the time it spent queued into the subsystem's async task metrics.
+	 */
+	void RecordTimingsForStart()
+	{
+		StartedTimeInSeconds = FPlatformTime::Seconds();
+		CachedTaskName = GetTaskName();
+
+		const FOnlineAsyncTaskMetricsAccelBytePtr Metrics = Subsystem->GetAsyncTaskMetrics();
+		if (bIsRecordingMetrics && Metrics.IsValid())
+		{
+			Metrics->RecordTaskStarted(CachedTaskName, StartedTimeInSeconds - CreatedTimeInSeconds);
+		}
+	}
+
+	/**
+	 * Record the time this task was completed at, and the time it spent executing and the state it completed in into the
+	 * subsystem's async task metrics.
+	 */
+	void RecordTimingsForCompletion()
+	{
+		CompletedTimeInSeconds = FPlatformTime::Seconds();
+
+		// A task may be completed before it has been initialized, in which case it spent no time executing
+		if (CachedTaskName.IsEmpty())
+		{
+			CachedTaskName = GetTaskName();
+			StartedTimeInSeconds = CompletedTimeInSeconds;
+		}
+
+		const FOnlineAsyncTaskMetricsAccelBytePtr Metrics = Subsystem->GetAsyncTaskMetrics();
+		if (bIsRecordingMetrics && Metrics.IsValid())
+		{
+			Metrics->RecordTaskCompleted(CachedTaskName, CompletedTimeInSeconds - StartedTimeInSeconds, bWasSuccessful, CompleteState == EAccelByteAsyncTaskCompleteState::TimedOut);
+		}
 	}
 
 	/**
-	 * Method for checking in tick whether we should consider this task as timed out, will handle locking mechanisms
+	 * Record a span for the lifetime of this task, with child spans for the time it spent queued, executing and waiting
+	 * for its delegates to be triggered.
+	 */
+	void RecordTraceSpans(double DestroyedTimeInSeconds)
+	{
+		const FOnlineOperationTraceAccelBytePtr OperationTrace = Subsystem->GetOperationTrace();
+		if (!OperationTrace.IsValid())
+		{
+			return;
+		}
+
+		OperationTrace->AddSpan(CachedTaskName, TraceContext, CreatedTimeInSeconds, DestroyedTimeInSeconds);
+		OperationTrace->AddSpan(CachedTaskName + TEXT(": Queued"), OperationTrace->CreateSpanContext(TraceContext), CreatedTimeInSeconds, StartedTimeInSeconds);
+		OperationTrace->AddSpan(CachedTaskName + TEXT(": Executing"), OperationTrace->CreateSpanContext(TraceContext), StartedTimeInSeconds, CompletedTimeInSeconds);
+		OperationTrace->AddSpan(CachedTaskName + TEXT(": Delegates"), OperationTrace->CreateSpanContext(TraceContext), CompletedTimeInSeconds, DestroyedTimeInSeconds);
+	}
+
+	/**
+	 * Method for checking in tick whether the timer wheel has flagged this task as timed out. Clears the flag, so that a
+	 * task that does not use a timeout is only reported once per timeout period.
 	 */
 	virtual bool HasTaskTimedOut()
 	{
-		FScopeLock ScopeLock(&TimeoutLock);
-		const double CurrentTimeInSeconds = FPlatformTime::Seconds();
-		return (CurrentTimeInSeconds - LastTaskUpdateInSeconds >= TaskTimeoutInSeconds);
+		return TimeoutState->bHasTimedOut.exchange(false);
 	}
 
 	/**
-	 * Method for updating a timeout value with the current time in seconds, handles locking mechanisms.
+	 * Method for pushing back the timeout deadline to a full timeout from the current time, safe to call from any thread.
 	 *
 	 * This should be called for any task that utilizes a timeout either when getting a response back from an async request
 	 * or after kicking off async requests (ex. at the end of your Initialize method).
 	 */
 	virtual void SetLastUpdateTimeToCurrentTime()
 	{
-		FScopeLock ScopeLock(&TimeoutLock);
-		LastTaskUpdateInSeconds = FPlatformTime::Seconds();
+		TimeoutState->DeadlineInSeconds = FPlatformTime::Seconds() + TaskTimeoutInSeconds;
 	}
 
 	/**
@@ -425,3 +610,11 @@ protected:
 	}
 
 };
+
+/**
+ * Delegates bound to an async task through TDelegateUtils::CreateThreadSafeSelfPtr run under the trace context of the task.
+ */
+inline FAccelByteTraceContext GetDelegateTraceContext(const FOnlineAsyncTaskAccelByte* Task)
+{
+	return Task->GetTraceContext();
+}
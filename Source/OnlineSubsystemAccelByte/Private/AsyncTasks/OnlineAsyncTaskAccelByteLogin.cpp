@@ -8,6 +8,7 @@
 #include "OnlineSubsystemAccelByte.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineUserInterfaceAccelByte.h"
+#include "OnlineLoginBootstrapAccelByte.h"
 #include "Interfaces/OnlineExternalUIInterface.h"
 #include "Interfaces/OnlineIdentityInterface.h"
 #include "OnlineSubsystemAccelByteTypes.h"
@@ -431,8 +432,12 @@ void FOnlineAsyncTaskAccelByteLogin::OnLoginSuccess()
 		return;
 	}
 
-	// Bind delegate for Query UserProfile
-	UserInterface->AddOnQueryUserProfileCompleteDelegate_Handle(LoginUserNum, FOnQueryUserProfileCompleteDelegate::CreateThreadSafeSP(UserInterface.Get(), &FOnlineUserAccelByte::PostLoginBulkGetUserProfileCompleted));
+	// Bind delegate for Query UserProfile, unless the login bootstrap has been asked to query or create the profile itself
+	const FOnlineLoginBootstrapAccelBytePtr LoginBootstrap = Subsystem->GetLoginBootstrap();
+	if (!LoginBootstrap.IsValid() || !LoginBootstrap->IsStageRequested(FOnlineLoginBootstrapAccelByte::UserProfileStage))
+	{
+		UserInterface->AddOnQueryUserProfileCompleteDelegate_Handle(LoginUserNum, FOnQueryUserProfileCompleteDelegate::CreateThreadSafeSP(UserInterface.Get(), &FOnlineUserAccelByte::PostLoginBulkGetUserProfileCompleted));
+	}
 	UserInterface->QueryUserInfo(LoginUserNum, { UserId.ToSharedRef() });
 
 	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
@@ -5,9 +5,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "OnlineOperationTraceAccelByte.h"
 
 namespace AccelByte
 {
+
+/**
+ * Get the trace context that delegates bound to an object through TDelegateUtils::CreateThreadSafeSelfPtr should run
+ * under. Objects that are not traced have none, async tasks provide their own overload found through argument dependent
+ * lookup.
+ */
+inline FAccelByteTraceContext GetDelegateTraceContext(const void* /*UserObject*/)
+{
+	return FAccelByteTraceContext();
+}
 	
 #if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 26)
 template <typename DelegateSignature, typename UserPolicy = FDefaultDelegateUserPolicy>
@@ -36,11 +47,22 @@ class TDelegateUtils<DELEGATE_TEMPLATE_TYPE>
 	typedef InRetValType RetValType;
 
 public:
+	/**
+	 * Bind a member function of an object that manages its own lifetime through TSelfPtr. If the object is traced, such
+	 * as an async task created during a traced operation, its trace context is made current while the function runs, so
+	 * that anything dispatched from the handler is traced under the object.
+	 */
 	template <typename UserClass, typename... VarTypes>
 	UE_NODISCARD inline static DELEGATE_TEMPLATE_TYPE CreateThreadSafeSelfPtr(TSelfPtr<UserClass, ESPMode::ThreadSafe> *InUserObjectRef, typename TMemFunPtrType<false, UserClass, RetValType(ParamTypes..., VarTypes...)>::Type InFunc, VarTypes... Vars)
 	{
 		static_assert(!TIsConst<UserClass>::Value, "Attempting to bind a delegate with a const object pointer and non-const member function.");
 
+		const FAccelByteTraceContext TraceContext = GetDelegateTraceContext(static_cast<const UserClass*>(InUserObjectRef));
+		if (TraceContext.IsValid())
+		{
+			return CreateTracedLambda<UserClass>(InUserObjectRef->GetInternalSP(), TraceContext, InFunc, Vars...);
+		}
+
 		DELEGATE_TEMPLATE_TYPE Result;
 #if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 26)
 		TBaseSPMethodDelegateInstance<false, UserClass, ESPMode::ThreadSafe, FuncType, UserPolicy, VarTypes...>::Create(Result, InUserObjectRef->GetInternalSP(), InFunc, Vars...);
@@ -52,6 +74,12 @@ public:
 	template <typename UserClass, typename... VarTypes>
 	UE_NODISCARD inline static DELEGATE_TEMPLATE_TYPE CreateThreadSafeSelfPtr(TSelfPtr<UserClass, ESPMode::ThreadSafe> *InUserObjectRef, typename TMemFunPtrType<true, UserClass, RetValType(ParamTypes..., VarTypes...)>::Type InFunc, VarTypes... Vars)
 	{
+		const FAccelByteTraceContext TraceContext = GetDelegateTraceContext(static_cast<const UserClass*>(InUserObjectRef));
+		if (TraceContext.IsValid())
+		{
+			return CreateTracedLambda<UserClass>(InUserObjectRef->GetInternalSP(), TraceContext, InFunc, Vars...);
+		}
+
 		DELEGATE_TEMPLATE_TYPE Result;
 #if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 26)
 		TBaseSPMethodDelegateInstance<true, const UserClass, ESPMode::ThreadSafe, FuncType, UserPolicy, VarTypes...>::Create(Result, InUserObjectRef->GetInternalSP(), InFunc, Vars...);
@@ -60,6 +88,27 @@ public:
 #endif
 		return Result;
 	}
+
+private:
+	/**
+	 * Bind a member function through a lambda that only holds a weak reference to the object, as the SP delegate does,
+	 * and makes the trace context given current while the function runs.
+	 */
+	template <typename UserClass, typename MemFuncPtrType, typename... VarTypes>
+	static DELEGATE_TEMPLATE_TYPE CreateTracedLambda(const TSharedRef<UserClass, ESPMode::ThreadSafe>& InUserObject, const FAccelByteTraceContext& InTraceContext, MemFuncPtrType InFunc, VarTypes... Vars)
+	{
+		const TWeakPtr<UserClass, ESPMode::ThreadSafe> WeakUserObject = InUserObject;
+		return DELEGATE_TEMPLATE_TYPE::CreateLambda([WeakUserObject, InTraceContext, InFunc, Vars...](ParamTypes... Params) -> RetValType {
+			const TSharedPtr<UserClass, ESPMode::ThreadSafe> UserObject = WeakUserObject.Pin();
+			if (!UserObject.IsValid())
+			{
+				return RetValType();
+			}
+
+			const FAccelByteTraceContextScope TraceContextScope(InTraceContext);
+			return (UserObject.Get()->*InFunc)(Params..., Vars...);
+		});
+	}
 };
 
 /**
@@ -13,6 +13,22 @@ FOnlineAsyncTaskAccelByteUpdateV1PartyData::FOnlineAsyncTaskAccelByteUpdateV1Par
 	, PartyId(StaticCastSharedRef<const FOnlinePartyIdAccelByte>(InPartyId.AsShared()))
 	, Namespace(InNamespace)
 	, PartyData(MakeShared<FOnlinePartyData>(InPartyData))
+{
+	UserId = FUniqueNetIdAccelByteUser::CastChecked(InLocalUserId);
+
+	// Grab only the data that has been modified for this party data, as we don't want to overwrite keys that other
+	// members may have changed with our possibly stale copy
+	PartyData->GetDirtyKeyValAttrs(ChangedAttributes, RemovedAttributes);
+}
+
+FOnlineAsyncTaskAccelByteUpdateV1PartyData::FOnlineAsyncTaskAccelByteUpdateV1PartyData(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const FOnlinePartyId& InPartyId, const FName& InNamespace, const FOnlineKeyValuePairs<FString, FVariantData>& InChangedAttributes, const TArray<FString>& InRemovedAttributes)
+	: FOnlineAsyncTaskAccelByte(InABInterface, true)
+	, PartyId(StaticCastSharedRef<const FOnlinePartyIdAccelByte>(InPartyId.AsShared()))
+	, Namespace(InNamespace)
+	, PartyData(MakeShared<FOnlinePartyData>())
+	, ChangedAttributes(InChangedAttributes)
+	, RemovedAttributes(InRemovedAttributes)
+	, bIsIncrementalUpdate(true)
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InLocalUserId);
 }
@@ -21,10 +37,11 @@ void FOnlineAsyncTaskAccelByteUpdateV1PartyData::Initialize()
 {
 	Super::Initialize();
 
-	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("UserId: %s; PartyId: %s"), *UserId->ToDebugString(), *PartyId->ToString());
+	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("UserId: %s; PartyId: %s; ChangedAttributes: %d; RemovedAttributes: %d"), *UserId->ToDebugString(), *PartyId->ToString(), ChangedAttributes.Num(), RemovedAttributes.Num());
 
-	// Create function for writing new data to party storage
-	TFunction<FJsonObjectWrapper(FJsonObjectWrapper)> PartyStorageWriterFunction = [PartyData = PartyData](FJsonObjectWrapper PartyStorageData) {
+	// Create function for writing new data to party storage. The changed and removed attributes are captured by value as
+	// the writer may be invoked again by the SDK if the write conflicts with another member's write.
+	TFunction<FJsonObjectWrapper(FJsonObjectWrapper)> PartyStorageWriterFunction = [DirtyData = ChangedAttributes, RemovedData = RemovedAttributes](FJsonObjectWrapper PartyStorageData) {
 		// Before doing anything, we want to make sure that the JSON object is valid so that we can modify it
 		if (!PartyStorageData.JsonObject.IsValid())
 		{
@@ -32,12 +49,7 @@ void FOnlineAsyncTaskAccelByteUpdateV1PartyData::Initialize()
 			return PartyStorageData;
 		}
 
-		// First we want to retrieve all dirty data that has been modified for this party data
-		FOnlineKeyValuePairs<FString, FVariantData> DirtyData;
-		TArray<FString> RemovedData;
-		PartyData->GetDirtyKeyValAttrs(DirtyData, RemovedData);
-
-		// Once we have done that, we want to iterate through the data that has changed, and update the JSON object
+		// Iterate through the data that has changed, and update the JSON object
 		for (const TPair<FString, FVariantData>& Data : DirtyData)
 		{
 			// We also don't want a type suffix for this data, so just pass false at the end
@@ -51,10 +63,6 @@ void FOnlineAsyncTaskAccelByteUpdateV1PartyData::Initialize()
 			PartyStorageData.JsonObject->RemoveField(Key);
 		}
 
-		// Finally, clear all data marked dirty from the party data object
-		// NOTE : Damar, we want to retry this in case if process is fail.
-		//PartyData->ClearDirty();
-
 		return PartyStorageData;
 	};
 
@@ -69,7 +77,21 @@ void FOnlineAsyncTaskAccelByteUpdateV1PartyData::Finalize()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 	
-	if (bWasSuccessful)
+	// Incremental updates have already been applied to the local party data, so there is nothing to replace here. The
+	// party still needs the result though, so that it can queue the keys again if the write failed.
+	if (bIsIncrementalUpdate)
+	{
+		const TSharedPtr<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe> PartyInterface = StaticCastSharedPtr<FOnlinePartySystemAccelByte>(Subsystem->GetPartyInterface());
+		if (PartyInterface.IsValid())
+		{
+			TSharedPtr<FOnlinePartyAccelByte> PartyObject = PartyInterface->GetPartyForUser(UserId.ToSharedRef(), PartyId);
+			if (PartyObject.IsValid())
+			{
+				PartyObject->OnPartyDataUpdateComplete(UserId.ToSharedRef(), bWasSuccessful, ChangedAttributes, RemovedAttributes);
+			}
+		}
+	}
+	else if (bWasSuccessful)
 	{
 		// If we successfully wrote new data for the party, then we want to update the party data on the party object with
 		// with the updated data that we just sent off to the backend.
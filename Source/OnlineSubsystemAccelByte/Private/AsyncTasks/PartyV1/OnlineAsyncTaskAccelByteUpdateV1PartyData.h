@@ -19,6 +19,12 @@ public:
 
 	FOnlineAsyncTaskAccelByteUpdateV1PartyData(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const FOnlinePartyId& InPartyId, const FName& InNamespace, const FOnlinePartyData& InPartyData);
 
+	/**
+	 * Construct a task that only writes the given attributes to party storage, leaving every other key untouched. Used
+	 * by the party object to send attribute changes that were batched over a frame without sending the whole blob.
+	 */
+	FOnlineAsyncTaskAccelByteUpdateV1PartyData(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, const FOnlinePartyId& InPartyId, const FName& InNamespace, const FOnlineKeyValuePairs<FString, FVariantData>& InChangedAttributes, const TArray<FString>& InRemovedAttributes);
+
 	virtual void Initialize() override;
 	virtual void Finalize() override;
 
@@ -40,6 +46,18 @@ private:
 	/** Data that we wish to use to update the party */
 	TSharedRef<FOnlinePartyData> PartyData;
 
+	/** Attributes that have changed and will be written to party storage */
+	FOnlineKeyValuePairs<FString, FVariantData> ChangedAttributes;
+
+	/** Attributes that have been removed and will be removed from party storage */
+	TArray<FString> RemovedAttributes;
+
+	/**
+	 * Whether this task was created with only the changed attributes rather than a full party data instance. If so,
+	 * the local party data already has these changes applied and will not be replaced once the write succeeds.
+	 */
+	bool bIsIncrementalUpdate = false;
+
 	/** Delegate handler for when the request to update party storage was a success */
 	void OnWritePartyStorageSuccess(const FAccelByteModelsPartyDataNotif& Result);
 
@@ -1,7 +1,13 @@
 ﻿#include "OnlineAsyncTaskAccelByteCheckout.h"
 
 #include "OnlinePurchaseInterfaceAccelByte.h"
+#include "OnlineStoreInterfaceV2AccelByte.h"
+#include "OnlineEntitlementsInterfaceAccelByte.h"
+#include "OnlineWalletInterfaceAccelByte.h"
 #include "OnlineError.h"
+#if WITH_DEV_AUTOMATION_TESTS
+#include "ExecTests/ExecTestBackendOverrides.h"
+#endif
 
 #define ONLINE_ERROR_NAMESPACE "FOnlineStoreSystemAccelByte"
 
@@ -37,6 +43,12 @@ void FOnlineAsyncTaskAccelByteCheckout::Initialize()
 	}
 	
 	TSharedPtr<FOnlineStoreOffer> Offer = Subsystem->GetStoreV2Interface()->GetOffer(CheckoutRequest.PurchaseOffers[0].OfferId);
+	if (!Offer.IsValid())
+	{
+		AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Error, TEXT("Offer '%s' is not cached, query it before checking out!"), *CheckoutRequest.PurchaseOffers[0].OfferId);
+		CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
+		return;
+	}
 
 	FAccelByteModelsOrderCreate OrderRequest;
 	OrderRequest.Language = Language;
@@ -45,11 +57,22 @@ void FOnlineAsyncTaskAccelByteCheckout::Initialize()
 	OrderRequest.Price = Offer->RegularPrice;
 	OrderRequest.DiscountedPrice = Offer->NumericPrice;
 	OrderRequest.CurrencyCode = Offer->CurrencyCode;
+	CurrencyCode = Offer->CurrencyCode;
 	if(FString* Region = Offer->DynamicFields.Find(TEXT("Region")))
 	{
 		OrderRequest.Region = *Region;
 	}
 	
+#if WITH_DEV_AUTOMATION_TESTS
+	const TFunction<void(const FAccelByteModelsOrderCreate&)> CreateOrderOverride = Subsystem->GetExecTestBackendOverrides().CreateOrder;
+	if (CreateOrderOverride)
+	{
+		CreateOrderOverride(OrderRequest);
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+		return;
+	}
+#endif
+
 	THandler<FAccelByteModelsOrderInfo> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsOrderInfo>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteCheckout::HandleCheckoutComplete);
 	FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteCheckout::HandleAsyncTaskError);
 	ApiClient->Order.CreateNewOrder(OrderRequest, OnSuccess, OnError);
@@ -63,6 +86,30 @@ void FOnlineAsyncTaskAccelByteCheckout::Finalize()
 	
 	const FOnlinePurchaseAccelBytePtr PurchaseInterface = StaticCastSharedPtr<FOnlinePurchaseAccelByte>(Subsystem->GetPurchaseInterface());
 	PurchaseInterface->AddReceipt(UserId.ToSharedRef(), Receipt);
+
+	// A fulfilled order has spent from the wallet and granted the item, so only refresh those rather than everything
+	if (bWasSuccessful && Receipt.TransactionState == EPurchaseTransactionState::Purchased)
+	{
+		const FOnlineWalletAccelBytePtr WalletInterface = Subsystem->GetWalletInterface();
+		if (WalletInterface.IsValid())
+		{
+			WalletInterface->InvalidateWalletInfo(LocalUserNum, CurrencyCode);
+		}
+
+		const TSharedPtr<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> EntitlementsInterface = StaticCastSharedPtr<FOnlineEntitlementsAccelByte>(Subsystem->GetEntitlementsInterface());
+		if (EntitlementsInterface.IsValid() && !PurchasedItemId.IsEmpty())
+		{
+			EntitlementsInterface->InvalidateItemEntitlement(LocalUserNum, PurchasedItemId);
+		}
+	}
+
+	// An order changes the offer's purchase limits and stock, and a refused order means the cached values were already
+	// out of date, so either way its dynamic data is fetched again on the next query
+	const FOnlineStoreV2AccelBytePtr StoreV2Interface = StaticCastSharedPtr<FOnlineStoreV2AccelByte>(Subsystem->GetStoreV2Interface());
+	if (StoreV2Interface.IsValid() && CheckoutRequest.PurchaseOffers.Num() > 0)
+	{
+		StoreV2Interface->InvalidateOfferDynamicData(*UserId.Get(), CheckoutRequest.PurchaseOffers[0].OfferId);
+	}
 	
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -94,6 +141,7 @@ void FOnlineAsyncTaskAccelByteCheckout::HandleCheckoutComplete(const FAccelByteM
 	
 	Receipt.ReceiptOffers.Add(ReceiptOfferEntry);
 	Receipt.TransactionId = Result.OrderNo;
+	PurchasedItemId = Result.ItemId;
 	switch (Result.Status)
 	{
 	case EAccelByteOrderStatus::FULFILLED:
@@ -16,6 +16,10 @@ public:
 	virtual void Finalize() override;
 	virtual void TriggerDelegates() override;
 
+PACKAGE_SCOPE:
+	void HandleCheckoutComplete(const FAccelByteModelsOrderInfo& Result);
+	void HandleAsyncTaskError(int32 Code, FString const& ErrMsg);
+
 protected:
 
 	virtual const FString GetTaskName() const override
@@ -24,14 +28,17 @@ protected:
 	}
 
 private:
-	void HandleCheckoutComplete(const FAccelByteModelsOrderInfo& Result);
-	void HandleAsyncTaskError(int32 Code, FString const& ErrMsg);
-
 	FPurchaseCheckoutRequest CheckoutRequest;
 	FOnPurchaseCheckoutComplete Delegate;
 	FString ErrorCode;
 	FText ErrorMessage;
 	FString Language;
 
+	/** Currency that the offer was bought with, whose cached wallet info is invalidated once the order is fulfilled */
+	FString CurrencyCode;
+
+	/** ID of the item granted by the order, whose cached entitlements are refreshed once the order is fulfilled */
+	FString PurchasedItemId;
+
 	FPurchaseReceipt Receipt;
 };
@@ -1,6 +1,11 @@
 ﻿#include "OnlineAsyncTaskAccelByteRedeemCode.h"
 
 #include "OnlinePurchaseInterfaceAccelByte.h"
+#include "OnlineEntitlementsInterfaceAccelByte.h"
+#include "OnlineWalletInterfaceAccelByte.h"
+#if WITH_DEV_AUTOMATION_TESTS
+#include "ExecTests/ExecTestBackendOverrides.h"
+#endif
 
 FOnlineAsyncTaskAccelByteRedeemCode::FOnlineAsyncTaskAccelByteRedeemCode(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FRedeemCodeRequest& InRedeemCodeRequest, const FOnPurchaseRedeemCodeComplete& InDelegate)
 	: FOnlineAsyncTaskAccelByte(InABSubsystem)
@@ -24,6 +29,16 @@ void FOnlineAsyncTaskAccelByteRedeemCode::Initialize()
 		return;
 	}
 
+#if WITH_DEV_AUTOMATION_TESTS
+	const TFunction<void(const FString&)> RedeemCodeOverride = Subsystem->GetExecTestBackendOverrides().RedeemCode;
+	if (RedeemCodeOverride)
+	{
+		RedeemCodeOverride(RedeemCodeRequest.Code);
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+		return;
+	}
+#endif
+
 	THandler<FAccelByteModelsFulfillmentResult> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsFulfillmentResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteRedeemCode::HandleRedeemCodeComplete);
 	FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteRedeemCode::HandleAsyncTaskError);
 	ApiClient->Fulfillment.RedeemCode(RedeemCodeRequest.Code, TEXT(""), Language, OnSuccess, OnError);
@@ -38,6 +53,34 @@ void FOnlineAsyncTaskAccelByteRedeemCode::Finalize()
 	const FOnlinePurchaseAccelBytePtr PurchaseInterface = StaticCastSharedPtr<FOnlinePurchaseAccelByte>(Subsystem->GetPurchaseInterface());
 	PurchaseInterface->AddReceipt(UserId.ToSharedRef(), Receipt);
 
+	if (bWasSuccessful)
+	{
+		// Make the granted items visible straight away, then queue a refresh to fill in the rest of each entitlement
+		const TSharedPtr<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> EntitlementsInterface = StaticCastSharedPtr<FOnlineEntitlementsAccelByte>(Subsystem->GetEntitlementsInterface());
+		if (EntitlementsInterface.IsValid())
+		{
+			TArray<TSharedRef<FOnlineEntitlement>> NewEntitlements;
+			for (const TSharedRef<FOnlineEntitlement>& Entitlement : RedeemedEntitlements)
+			{
+				if (!EntitlementsInterface->GetEntitlement(*UserId, Entitlement->Id).IsValid())
+				{
+					NewEntitlements.Add(Entitlement);
+				}
+				EntitlementsInterface->InvalidateItemEntitlement(LocalUserNum, Entitlement->ItemId);
+			}
+			EntitlementsInterface->AddEntitlementsToMap(UserId.ToSharedRef(), NewEntitlements);
+		}
+
+		const FOnlineWalletAccelBytePtr WalletInterface = Subsystem->GetWalletInterface();
+		if (WalletInterface.IsValid())
+		{
+			for (const FString& WalletId : CreditedWalletIds)
+			{
+				WalletInterface->InvalidateWalletInfoByWalletId(LocalUserNum, WalletId);
+			}
+		}
+	}
+
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
@@ -67,11 +110,20 @@ void FOnlineAsyncTaskAccelByteRedeemCode::HandleRedeemCodeComplete(const FAccelB
 		ReceiptOfferEntry.LineItems.Add(ItemInfo);
 
 		Receipt.ReceiptOffers.Add(ReceiptOfferEntry);
+
+		TSharedRef<FOnlineEntitlement> RedeemedEntitlement = MakeShared<FOnlineEntitlement>();
+		RedeemedEntitlement->Id = Entitlement.Id;
+		RedeemedEntitlement->Name = ItemInfo.ItemName;
+		RedeemedEntitlement->Namespace = Entitlement.Namespace;
+		RedeemedEntitlement->ItemId = Entitlement.ItemId;
+		RedeemedEntitlement->Status = FAccelByteUtilities::GetUEnumValueAsString<EAccelByteEntitlementStatus>(EAccelByteEntitlementStatus::ACTIVE);
+		RedeemedEntitlements.Add(RedeemedEntitlement);
 	}
 
 	for (const auto& Credit : Result.CreditSummaries)
 	{
 		UE_LOG_AB(Log, TEXT("Credit Redeemed to Wallet! WalletId: %s | Amount: %s"), *Credit.WalletId, Credit.Amount);
+		CreditedWalletIds.AddUnique(Credit.WalletId);
 	}
 
 	//Receipt.TransactionId = Result.OrderNo;
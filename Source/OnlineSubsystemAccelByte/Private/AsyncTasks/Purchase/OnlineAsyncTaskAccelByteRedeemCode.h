@@ -16,6 +16,10 @@ public:
 	virtual void Finalize() override;
 	virtual void TriggerDelegates() override;
 
+PACKAGE_SCOPE:
+	void HandleRedeemCodeComplete(const FAccelByteModelsFulfillmentResult& Result);
+	void HandleAsyncTaskError(int32 Code, FString const& ErrMsg);
+
 protected:
 
 	virtual const FString GetTaskName() const override
@@ -24,13 +28,16 @@ protected:
 	}
 
 private:
-	void HandleRedeemCodeComplete(const FAccelByteModelsFulfillmentResult& Result);
-	void HandleAsyncTaskError(int32 Code, FString const& ErrMsg);
-
 	FRedeemCodeRequest RedeemCodeRequest;
 	FOnPurchaseRedeemCodeComplete Delegate;
 	FString Language;
 
 	FOnlineError Error;
 	FPurchaseReceipt Receipt;
+
+	/** Entitlements granted by the code, added to the entitlement cache on finalize */
+	TArray<TSharedRef<FOnlineEntitlement>> RedeemedEntitlements;
+
+	/** IDs of wallets credited by the code, whose cached wallet info is invalidated on finalize */
+	TArray<FString> CreditedWalletIds;
 };
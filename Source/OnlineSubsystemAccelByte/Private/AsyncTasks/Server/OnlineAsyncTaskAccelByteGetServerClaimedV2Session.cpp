@@ -40,6 +40,8 @@ void FOnlineAsyncTaskAccelByteGetServerClaimedV2Session::Finalize()
         return;
     }
 
+    SessionInterface->EndServerStartupPhase(EAccelByteServerStartupPhase::ClaimedSessionFetch, bWasSuccessful);
+
     if (bWasSuccessful)
     {
         // Super janky, but we want to remove the stub game session that we created to reflect creating state and
@@ -5,6 +5,7 @@
 #include "OnlineAsyncTaskAccelByteLoginServer.h"
 #include "GameServerApi/AccelByteServerOauth2Api.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
+#include "OnlineSessionInterfaceV2AccelByte.h"
 
 FOnlineAsyncTaskAccelByteLoginServer::FOnlineAsyncTaskAccelByteLoginServer(FOnlineSubsystemAccelByte* const InABInterface, int32 InLocalUserNum)
     : FOnlineAsyncTaskAccelByte(InABInterface, ASYNC_TASK_FLAG_BIT(EAccelByteAsyncTaskFlags::ServerTask))
@@ -18,6 +19,12 @@ void FOnlineAsyncTaskAccelByteLoginServer::Initialize()
 
     AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
 
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface))
+	{
+		SessionInterface->BeginServerStartupPhase(EAccelByteServerStartupPhase::ServerLogin);
+	}
+
 	const FVoidHandler OnServerLoginSuccessDelegate = TDelegateUtils<FVoidHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteLoginServer::OnLoginServerSuccess);
 	const FErrorHandler OnServerLoginErrorDelegate = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteLoginServer::OnLoginServerError);
 	FRegistry::ServerOauth2.LoginWithClientCredentials(OnServerLoginSuccessDelegate, OnServerLoginErrorDelegate);
@@ -29,6 +36,12 @@ void FOnlineAsyncTaskAccelByteLoginServer::Finalize()
 {
     AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface))
+	{
+		SessionInterface->EndServerStartupPhase(EAccelByteServerStartupPhase::ServerLogin, bWasSuccessful);
+	}
+
     if (bWasSuccessful)
     {
 		const FOnlineIdentityAccelBytePtr IdentityInterface = StaticCastSharedPtr<FOnlineIdentityAccelByte>(Subsystem->GetIdentityInterface());
@@ -38,15 +38,18 @@ void FOnlineAsyncTaskAccelByteRegisterLocalServerV2::Finalize()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 
-	if (bWasSuccessful)
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!ensure(FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface)))
 	{
-		FOnlineSessionV2AccelBytePtr SessionInterface;
-		if (!ensure(FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface)))
-		{
-			AB_OSS_ASYNC_TASK_TRACE_END_VERBOSITY(Warning, TEXT("Failed to finalize registering local server as our session interface is invalid!"));
-			return;
-		}
+		AB_OSS_ASYNC_TASK_TRACE_END_VERBOSITY(Warning, TEXT("Failed to finalize registering local server as our session interface is invalid!"));
+		return;
+	}
+
+	SessionInterface->EndServerStartupPhase(EAccelByteServerStartupPhase::RegisterServer, bWasSuccessful);
 
+	if (bWasSuccessful)
+	{
+		// #NOTE Does nothing if the connection was already started alongside registration
 		SessionInterface->ConnectToDSHub(ServerName);
 
 		// #NOTE Deliberately not checking session ID here as there's no way to have a buffer local server. Local servers
@@ -43,17 +43,29 @@ void FOnlineAsyncTaskAccelByteRegisterRemoteServerV2::Finalize()
             return;
         }
 
+        SessionInterface->EndServerStartupPhase(EAccelByteServerStartupPhase::RegisterServer, true);
+
+        // #NOTE Does nothing if the connection was already started alongside registration
 		const FString PodName = FPlatformMisc::GetEnvironmentVariable(TEXT("POD_NAME"));
         SessionInterface->ConnectToDSHub(PodName);
 
         // Check if we have a session ID as an environment variable, if so then we want to start the process of creating
-        // a local session for the server based on the backend session data
+        // a local session for the server based on the backend session data. Skip this if the session was prefetched
+        // alongside registration and is either still being retrieved or already here.
 		const FString SessionId = FPlatformMisc::GetEnvironmentVariable(TEXT("NOMAD_META_session_id"));
-        if (!SessionId.IsEmpty())
+        if (!SessionId.IsEmpty() && SessionInterface->GetNamedSession(SessionName) == nullptr)
         {
             SessionInterface->GetServerClaimedSession(SessionName, SessionId);
         }
     }
+    else
+    {
+		FOnlineSessionV2AccelBytePtr SessionInterface;
+        if (FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface))
+        {
+            SessionInterface->EndServerStartupPhase(EAccelByteServerStartupPhase::RegisterServer, false);
+        }
+    }
 
     AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -7,6 +7,7 @@
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineSubsystemAccelByteUtils.h"
 #include "OnlineUserCacheAccelByte.h"
+#include "OnlinePlayerActivityCacheAccelByte.h"
 #include "Core/AccelByteRegistry.h"
 
 FOnlineAsyncTaskAccelByteRegisterPlayersV1::FOnlineAsyncTaskAccelByteRegisterPlayersV1(FOnlineSubsystemAccelByte* const InABInterface, const FName& InSessionName, const TArray<TSharedRef<const FUniqueNetId>>& InPlayers, bool InBWasInvited, bool InBIsSpectator)
@@ -126,6 +127,8 @@ void FOnlineAsyncTaskAccelByteRegisterPlayersV1::RegisterAllPlayers()
 	FNamedOnlineSession* Session = SessionInterface->GetNamedSession(SessionName);
 	AB_ASYNC_TASK_ENSURE(Session != nullptr, "Failed to register players to session as our local session instance is invalid!");
 	
+	const FOnlinePlayerActivityCacheAccelBytePtr PlayerActivityCache = Subsystem->GetPlayerActivityCache();
+
 	// For each player that we want to register to the session, we want to check if the player is already in the session,
 	// if not, we want to add them to the local copy of the session, and if we are the session host, we want to take the
 	// responsibility of registering the player to the session on the backend.
@@ -141,7 +144,10 @@ void FOnlineAsyncTaskAccelByteRegisterPlayersV1::RegisterAllPlayers()
 		}
 
 		Session->RegisteredPlayers.Add(Player);
-		FOnlineSubsystemAccelByteUtils::AddUserJoinTime(Player->GetAccelByteId(), FDateTime::Now().ToIso8601());
+		if (PlayerActivityCache.IsValid())
+		{
+			PlayerActivityCache->SetJoinTime(Player->GetAccelByteId(), FDateTime::Now());
+		}
 
 		// #AB Apin: splitgate use different type of calculating open connections
 		if (bIsSpectator)
@@ -6,6 +6,7 @@
 #include "OnlineSubsystemAccelByte.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineSubsystemAccelByteUtils.h"
+#include "OnlinePlayerActivityCacheAccelByte.h"
 #include "Core/AccelByteRegistry.h"
 
 FOnlineAsyncTaskAccelByteUnregisterPlayersV1::FOnlineAsyncTaskAccelByteUnregisterPlayersV1(FOnlineSubsystemAccelByte* const InABInterface, const FName& InSessionName, const TArray<TSharedRef<const FUniqueNetId>>& InPlayers)
@@ -50,6 +51,8 @@ void FOnlineAsyncTaskAccelByteUnregisterPlayersV1::Initialize()
 		return;
 	}
 
+	const FOnlinePlayerActivityCacheAccelBytePtr PlayerActivityCache = Subsystem->GetPlayerActivityCache();
+
 	// For each player that we want to unregister to the session, we want to check if the player is already in the session,
 	// if not, we want to remove them from the local copy of the session, and if we are the session host, we want to take the
 	// responsibility of unregistering the player from the session on the backend.
@@ -66,7 +69,10 @@ void FOnlineAsyncTaskAccelByteUnregisterPlayersV1::Initialize()
 			return;
 		}
 
-		FOnlineSubsystemAccelByteUtils::AddUserDisconnectedTime(Player->GetAccelByteId(), FDateTime::Now().ToIso8601());
+		if (PlayerActivityCache.IsValid())
+		{
+			PlayerActivityCache->SetDisconnectedTime(Player->GetAccelByteId(), FDateTime::Now());
+		}
 
 		// First, remove the player from the registered player array on the session and update open connection slots
 		Session->RegisteredPlayers.RemoveAtSwap(IndexOfPlayer);
@@ -3,6 +3,9 @@
 // and restrictions contact your company contract manager.
 
 #include "OnlineAsyncTaskAccelByteQueryOfferByFilter.h"
+#include "OnlineSubsystemAccelByteUtils.h"
+#include "Async/Async.h"
+#include "Algo/Reverse.h"
 
 FOnlineAsyncTaskAccelByteQueryOfferByFilter::FOnlineAsyncTaskAccelByteQueryOfferByFilter(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FOnlineStoreFilter& InFilter, const FOnQueryOnlineStoreOffersComplete& InDelegate)
 	: FOnlineAsyncTaskAccelByte(InABSubsystem)
@@ -11,6 +14,8 @@ FOnlineAsyncTaskAccelByteQueryOfferByFilter::FOnlineAsyncTaskAccelByteQueryOffer
 	, Language(InABSubsystem->GetLanguage())
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InUserId);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("MaxConcurrentStorePageQueries"), MaxConcurrentPageQueries, GEngineIni);
+	MaxConcurrentPageQueries = FMath::Max(MaxConcurrentPageQueries, 1);
 }
 
 void FOnlineAsyncTaskAccelByteQueryOfferByFilter::Initialize()
@@ -23,27 +28,19 @@ void FOnlineAsyncTaskAccelByteQueryOfferByFilter::Initialize()
 		AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Warning, TEXT("Multiple filter value currently not supported! Keyword.Num: %d, IncludeCategories.Num: %d, ExcludeCategories.Num: %d"), Filter.Keywords.Num(), Filter.IncludeCategories.Num(), Filter.ExcludeCategories.Num());
 	}
 
-	if(Filter.Keywords.Num() == 0)
+	// Search all items by criteria, otherwise search by keyword and filter the results by categories
+	bIsSearchByCriteria = Filter.Keywords.Num() == 0;
+	bIsCompleteCatalog = bIsSearchByCriteria && Filter.IncludeCategories.Num() == 0 && Filter.ExcludeCategories.Num() == 0;
+	if(bIsSearchByCriteria)
 	{
-		bIsSearchByCriteria = true;
-		// Search all items
-		THandler<FAccelByteModelsItemPagingSlicedResult> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsItemPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleGetItemByCriteria);
-		FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleAsyncTaskError);
 		SearchCriteriaRequest = {};
 		SearchCriteriaRequest.Language = Language;
 		if (Filter.IncludeCategories.Num() != 0)
 		{
 			SearchCriteriaRequest.CategoryPath = Filter.IncludeCategories[0].Id;
 		}
-		ApiClient->Item.GetItemsByCriteria(SearchCriteriaRequest, 0, 20, OnSuccess, OnError);
-	}
-	else
-	{
-		// search by keyword, and the result filtered by categories
-		THandler<FAccelByteModelsItemPagingSlicedResult> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsItemPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleSearchItem);
-		FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleAsyncTaskError);
-		ApiClient->Item.SearchItem(Language, Filter.Keywords[0], 0, 20, TEXT(""), OnSuccess, OnError);
 	}
+	QueryItems(0, 20);
 	
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -53,9 +50,26 @@ void FOnlineAsyncTaskAccelByteQueryOfferByFilter::Finalize()
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT(""));
 	FOnlineAsyncTaskAccelByte::Finalize();
 	
+	// Only a successful fetch of every page is the complete catalog, as a failed fetch must not remove offers it never saw
+	const bool bIsMergingCompleteCatalog = bIsCompleteCatalog && bWasSuccessful;
 	const FOnlineStoreV2AccelBytePtr StoreV2Interface = StaticCastSharedPtr<FOnlineStoreV2AccelByte>(Subsystem->GetStoreV2Interface());
-	StoreV2Interface->EmplaceOffers(OfferMap);
-	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+	FScopeLock ScopeLock(&OfferMapLock);
+	const int32 ChangedOffers = StoreV2Interface->MergeOffers(OfferMap, bIsMergingCompleteCatalog, Language);
+
+	if (bIsMergingCompleteCatalog && ChangedOffers > 0 && StoreV2Interface->IsCatalogSnapshotEnabled())
+	{
+		// Write the snapshot off the game thread, as the catalog may hold thousands of offers
+		const TWeakPtr<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe> StoreV2InterfaceWeak = StoreV2Interface;
+		const FString SnapshotLanguage = Language;
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [StoreV2InterfaceWeak, SnapshotLanguage]() {
+			const FOnlineStoreV2AccelBytePtr PinnedStoreV2Interface = StoreV2InterfaceWeak.Pin();
+			if (PinnedStoreV2Interface.IsValid())
+			{
+				PinnedStoreV2Interface->SaveCatalogSnapshot(SnapshotLanguage);
+			}
+		});
+	}
+	AB_OSS_ASYNC_TASK_TRACE_END(TEXT("Offers fetched: %d; Offers changed: %d"), OfferMap.Num(), ChangedOffers);
 }
 
 void FOnlineAsyncTaskAccelByteQueryOfferByFilter::TriggerDelegates()
@@ -64,90 +78,154 @@ void FOnlineAsyncTaskAccelByteQueryOfferByFilter::TriggerDelegates()
 	FOnlineAsyncTaskAccelByte::TriggerDelegates();
 
 	TArray<FString> OfferIds;
-	OfferMap.GenerateKeyArray(OfferIds);
+	{
+		FScopeLock ScopeLock(&OfferMapLock);
+		OfferMap.GenerateKeyArray(OfferIds);
+	}
 	Delegate.ExecuteIfBound(bWasSuccessful, OfferIds, ErrorMsg);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
-void FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleGetItemByCriteria(const FAccelByteModelsItemPagingSlicedResult& Result)
+void FOnlineAsyncTaskAccelByteQueryOfferByFilter::QueryItems(int32 Offset, int32 Limit, bool bIsConcurrentPage)
 {
-	FilterAndAddResults(Result);
-
-	if(!Result.Paging.Next.IsEmpty())
+	THandler<FAccelByteModelsItemPagingSlicedResult> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsItemPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleQueryItemsSuccess, bIsConcurrentPage);
+	FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleQueryItemsError, bIsConcurrentPage);
+	if(bIsSearchByCriteria)
 	{
-		int32 Offset = -1;
-		int32 Limit = -1;
-		GetNextOffset(Result.Paging.Next, Offset, Limit);
-		if(Offset != -1 && Limit != -1)
-		{
-			THandler<FAccelByteModelsItemPagingSlicedResult> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsItemPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleGetItemByCriteria);
-			FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleAsyncTaskError);
-			ApiClient->Item.GetItemsByCriteria(SearchCriteriaRequest, Offset, Limit, OnSuccess, OnError);
-			return;
-		}
+		ApiClient->Item.GetItemsByCriteria(SearchCriteriaRequest, Offset, Limit, OnSuccess, OnError);
+	}
+	else
+	{
+		ApiClient->Item.SearchItem(Language, Filter.Keywords[0], Offset, Limit, TEXT(""), OnSuccess, OnError);
 	}
-	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
 }
 
-void FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleSearchItem(const FAccelByteModelsItemPagingSlicedResult& Result)
+void FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleQueryItemsSuccess(const FAccelByteModelsItemPagingSlicedResult& Result, bool bIsConcurrentPage)
 {
+	SetLastUpdateTimeToCurrentTime();
 	FilterAndAddResults(Result);
 
-	if(!Result.Paging.Next.IsEmpty())
+	if (bIsConcurrentPage)
 	{
-		int32 Offset = -1;
-		int32 Limit = -1;
-		GetNextOffset(Result.Paging.Next, Offset, Limit);
-		if(Offset != -1 && Limit != -1)
+		bool bIsLastPage = false;
+		bool bHasFailed = false;
+		{
+			FScopeLock ScopeLock(&PageQueueLock);
+			PagesInFlight--;
+			bIsLastPage = PagesInFlight == 0 && QueuedPages.Num() == 0;
+			bHasFailed = bHasPageFailed;
+		}
+
+		if (!bIsLastPage)
 		{
-			THandler<FAccelByteModelsItemPagingSlicedResult> OnSuccess = TDelegateUtils<THandler<FAccelByteModelsItemPagingSlicedResult>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleGetItemByCriteria);
-			FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleAsyncTaskError);
-			ApiClient->Item.SearchItem(Language, Filter.Keywords[0], Offset, Limit, TEXT(""), OnSuccess, OnError);
+			DispatchQueuedPages();
 			return;
 		}
+
+		// Only the last page to come back completes the task, failing it if any other page failed along the way
+		CompleteTask(bHasFailed ? EAccelByteAsyncTaskCompleteState::RequestFailed : EAccelByteAsyncTaskCompleteState::Success);
+		return;
+	}
+
+	int32 NextOffset = -1;
+	int32 NextLimit = -1;
+	if(Result.Paging.Next.IsEmpty() || !FOnlineSubsystemAccelByteUtils::GetOffsetAndLimitFromPagingUrl(Result.Paging.Next, NextOffset, NextLimit))
+	{
+		CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+		return;
+	}
+
+	// If the backend told us where the last page starts, we know every remaining offset up front and can fetch them
+	// concurrently. Otherwise fall back to walking the next links one page at a time.
+	int32 LastOffset = -1;
+	int32 LastLimit = -1;
+	if (FOnlineSubsystemAccelByteUtils::GetOffsetAndLimitFromPagingUrl(Result.Paging.Last, LastOffset, LastLimit)
+		&& QueueRemainingPages(NextOffset, NextLimit, LastOffset))
+	{
+		DispatchQueuedPages();
+		return;
 	}
-	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
-}
 
+	QueryItems(NextOffset, NextLimit);
+}
 
-void FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleAsyncTaskError(int32 Code, FString const& ErrMsg)
+void FOnlineAsyncTaskAccelByteQueryOfferByFilter::HandleQueryItemsError(int32 Code, FString const& ErrMsg, bool bIsConcurrentPage)
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Error, TEXT("Code: %d; Message: %s"), Code, *ErrMsg);
 
+	if (bIsConcurrentPage)
+	{
+		// Stop sending any queued pages, as the task has failed once any page fails. Pages already in flight still add
+		// their offers as they arrive, so the task only completes once the last of them comes back.
+		bool bIsLastPage = false;
+		{
+			FScopeLock ScopeLock(&PageQueueLock);
+			PagesInFlight--;
+			QueuedPages.Empty();
+			if (!bHasPageFailed)
+			{
+				bHasPageFailed = true;
+				ErrorMsg = ErrMsg;
+			}
+			bIsLastPage = PagesInFlight == 0;
+		}
+
+		if (bIsLastPage)
+		{
+			CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
+		}
+
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+		return;
+	}
+
 	ErrorMsg = ErrMsg;
 	CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
 
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
-void FOnlineAsyncTaskAccelByteQueryOfferByFilter::GetNextOffset(FString const& NextUrl, int32& OutOffset, int32& OutLimit)
+bool FOnlineAsyncTaskAccelByteQueryOfferByFilter::QueueRemainingPages(int32 NextOffset, int32 PageLimit, int32 LastOffset)
 {
-	FString UrlOut;
-	FString Params;
-	NextUrl.Split(TEXT("?"), &UrlOut, &Params);
-	if(!Params.IsEmpty())
+	if (PageLimit <= 0 || LastOffset <= NextOffset)
 	{
-		TArray<FString> ParamsArray;
-		Params.ParseIntoArray(ParamsArray, TEXT("&"));
-		for(FString Param : ParamsArray)
+		return false;
+	}
+
+	FScopeLock ScopeLock(&PageQueueLock);
+	for (int32 Offset = NextOffset; Offset <= LastOffset; Offset += PageLimit)
+	{
+		QueuedPages.Emplace(Offset, PageLimit);
+	}
+
+	// Pop from the back of the queue when dispatching, so reverse to keep requesting pages in ascending order
+	Algo::Reverse(QueuedPages);
+	return QueuedPages.Num() > 0;
+}
+
+void FOnlineAsyncTaskAccelByteQueryOfferByFilter::DispatchQueuedPages()
+{
+	// Count pages as in flight while still holding the lock, so that no response can see the queue empty with nothing in
+	// flight and complete the task before these pages are sent
+	TArray<TPair<int32, int32>> PagesToSend;
+	{
+		FScopeLock ScopeLock(&PageQueueLock);
+		while (QueuedPages.Num() > 0 && PagesInFlight < MaxConcurrentPageQueries)
 		{
-			FString Key;
-			FString Value;
-			Param.Split(TEXT("="), &Key, &Value);
-			if(Key.Equals(TEXT("offset")) && Value.IsNumeric())
-			{
-				OutOffset = FCString::Atoi(*Value);
-			}
-			else if(Key.Equals(TEXT("limit")) && Value.IsNumeric())
-			{
-				OutLimit = FCString::Atoi(*Value);
-			}
+			PagesToSend.Add(QueuedPages.Pop(false));
+			PagesInFlight++;
 		}
 	}
+
+	for (const TPair<int32, int32>& Page : PagesToSend)
+	{
+		QueryItems(Page.Key, Page.Value, true);
+	}
 }
 
 void FOnlineAsyncTaskAccelByteQueryOfferByFilter::FilterAndAddResults(const FAccelByteModelsItemPagingSlicedResult& Result)
 {
+	FScopeLock ScopeLock(&OfferMapLock);
 	for(FAccelByteModelsItemInfo const& Item : Result.Data)
 	{
 		if(!Item.Purchasable ||	Item.ItemType == EAccelByteItemType::APP ||
@@ -179,6 +257,7 @@ void FOnlineAsyncTaskAccelByteQueryOfferByFilter::FilterAndAddResults(const FAcc
 		Offer->DynamicFields.Add(TEXT("Name"), Item.Name);
 		Offer->DynamicFields.Add(TEXT("ItemType"), FAccelByteUtilities::GetUEnumValueAsString(Item.ItemType));
 		Offer->DynamicFields.Add(TEXT("Sku"), Item.Sku);
+		Offer->DynamicFields.Add(TEXT("UpdatedAt"), Item.UpdatedAt.ToIso8601());
 		if (Item.ItemType == EAccelByteItemType::COINS)
 		{
 			Offer->DynamicFields.Add(TEXT("TargetCurrencyCode"), Item.TargetCurrencyCode);
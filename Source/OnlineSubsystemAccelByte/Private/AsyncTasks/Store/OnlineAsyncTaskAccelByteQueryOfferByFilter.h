@@ -24,12 +24,25 @@ protected:
 	}
 
 private:
-	void HandleGetItemByCriteria(const FAccelByteModelsItemPagingSlicedResult& Result);
-	void HandleSearchItem(const FAccelByteModelsItemPagingSlicedResult& Result);
-	void HandleAsyncTaskError(int32 Code, FString const& ErrMsg);
+	/** Query a page of items, either by criteria or by keyword depending on the filter */
+	void QueryItems(int32 Offset, int32 Limit, bool bIsConcurrentPage = false);
+	void HandleQueryItemsSuccess(const FAccelByteModelsItemPagingSlicedResult& Result, bool bIsConcurrentPage);
+	void HandleQueryItemsError(int32 Code, FString const& ErrMsg, bool bIsConcurrentPage);
 
 	void FilterAndAddResults(const FAccelByteModelsItemPagingSlicedResult& Result);
-	void GetNextOffset(FString const& NextUrl, int32& OutOffset, int32& OutLimit);
+
+	/**
+	 * Once the last page is known from the first response, queue every remaining page and start fetching them concurrently.
+	 *
+	 * @returns true if remaining pages were queued, false if there is nothing to fetch concurrently
+	 */
+	bool QueueRemainingPages(int32 NextOffset, int32 PageLimit, int32 LastOffset);
+
+	/**
+	 * Take queued pages until we hit the concurrent page limit or run out of pages, then send queries for them once
+	 * PageQueueLock has been released. Must not be called while holding PageQueueLock.
+	 */
+	void DispatchQueuedPages();
 
 	FOnlineStoreFilter Filter;
 	FOnQueryOnlineStoreOffersComplete Delegate;
@@ -38,5 +51,30 @@ private:
 	FString ErrorMsg;
 	FAccelByteModelsItemCriteria SearchCriteriaRequest;
 	bool bIsSearchByCriteria {false};
+
+	/** Whether the filter matches every purchasable offer, in which case the results replace the catalog snapshot */
+	bool bIsCompleteCatalog {false};
+
 	TMap<FUniqueOfferId, FOnlineStoreOfferRef> OfferMap;
+
+	/** Lock for the offer map, as page responses may arrive on different threads */
+	FCriticalSection OfferMapLock;
+
+	/** Pages that still need to be fetched, as pairs of offset and limit */
+	TArray<TPair<int32, int32>> QueuedPages;
+
+	/** Number of concurrent page queries that have been sent and not yet responded to */
+	int32 PagesInFlight = 0;
+
+	/**
+	 * Whether a concurrent page query has failed. The task still waits for pages already in flight before completing, so
+	 * that none of them add offers while the task is finalizing.
+	 */
+	bool bHasPageFailed = false;
+
+	/** Lock for the queued pages, in flight count and page failure, as page responses may arrive on different threads */
+	FCriticalSection PageQueueLock;
+
+	/** Maximum number of page queries that may be in flight at once, read from MaxConcurrentStorePageQueries in config */
+	int32 MaxConcurrentPageQueries = 4;
 };
@@ -5,23 +5,36 @@
 #include "OnlineAsyncTaskAccelByteQueryOfferDynamicData.h"
 
 FOnlineAsyncTaskAccelByteQueryOfferDynamicData::FOnlineAsyncTaskAccelByteQueryOfferDynamicData(
-	FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FUniqueOfferId& InOfferId,
+	FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const TArray<FUniqueOfferId>& InOfferIds,
 	const FOnQueryOnlineStoreOffersComplete& InDelegate) 
 	: FOnlineAsyncTaskAccelByte(InABSubsystem)
-	, OfferId(InOfferId)
+	, OfferIds(InOfferIds)
 	, Delegate(InDelegate)
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InUserId);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("MaxConcurrentOfferDynamicDataQueries"), MaxConcurrentQueries, GEngineIni);
+	MaxConcurrentQueries = FMath::Max(MaxConcurrentQueries, 1);
 }
 
 void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::Initialize()
 {
-	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Initialized"));
+	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Initialized, Offers: %d"), OfferIds.Num());
 	Super::Initialize();
+
+	if (OfferIds.Num() == 0)
+	{
+		CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+		AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
+		return;
+	}
 	
 	OnSuccess = TDelegateUtils<THandler<FAccelByteModelsItemDynamicData>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferDynamicData::HandleGetItemDynamicData);
 	OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteQueryOfferDynamicData::HandleAsyncTaskError);
-	ApiClient->Item.GetItemDynamicData(OfferId, OnSuccess, OnError);
+
+	// The item API only has a single offer dynamic data query, so the batch is sent as concurrent queries
+	FScopeLock ScopeLock(&QueryLock);
+	QueuedOfferIds = OfferIds;
+	DispatchQueuedQueries();
 	
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -32,7 +45,11 @@ void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::Finalize()
 	Super::Finalize();
 	
 	const FOnlineStoreV2AccelBytePtr StoreV2Interface = StaticCastSharedPtr<FOnlineStoreV2AccelByte>(Subsystem->GetStoreV2Interface());
-	StoreV2Interface->EmplaceOfferDynamicData(*UserId.Get(), MakeShared<FAccelByteModelsItemDynamicData>(DynamicData));
+	FScopeLock ScopeLock(&QueryLock);
+	for (const FAccelByteModelsItemDynamicData& DynamicData : DynamicDataResults)
+	{
+		StoreV2Interface->EmplaceOfferDynamicData(*UserId.Get(), MakeShared<FAccelByteModelsItemDynamicData>(DynamicData));
+	}
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
 
@@ -41,7 +58,15 @@ void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::TriggerDelegates()
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Trigger Delegates"));
 	Super::TriggerDelegates();
 
-	TArray<FString> QueriedOfferIds{DynamicData.ItemId};
+	TArray<FString> QueriedOfferIds;
+	{
+		FScopeLock ScopeLock(&QueryLock);
+		QueriedOfferIds.Reserve(DynamicDataResults.Num());
+		for (const FAccelByteModelsItemDynamicData& DynamicData : DynamicDataResults)
+		{
+			QueriedOfferIds.Add(DynamicData.ItemId);
+		}
+	}
 	Delegate.ExecuteIfBound(bWasSuccessful, QueriedOfferIds, ErrorMsg);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -49,9 +74,11 @@ void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::TriggerDelegates()
 void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::HandleGetItemDynamicData(const FAccelByteModelsItemDynamicData& Result)
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("Get Success"));
+	SetLastUpdateTimeToCurrentTime();
 
-	DynamicData = Result;
-	CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+	FScopeLock ScopeLock(&QueryLock);
+	DynamicDataResults.Add(Result);
+	OnQueryFinished();
 	
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -60,8 +87,38 @@ void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::HandleAsyncTaskError(int32
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN_VERBOSITY(Error, TEXT("Code: %d; Message: %s"), Code, *ErrMsg);
 	
+	// Keep querying the rest of the batch, so that one bad offer doesn't stop the others from being refreshed
+	FScopeLock ScopeLock(&QueryLock);
 	ErrorMsg = ErrMsg;
-	CompleteTask(EAccelByteAsyncTaskCompleteState::RequestFailed);
+	bHasQueryFailed = true;
+	OnQueryFinished();
 
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
-}
\ No newline at end of file
+}
+
+void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::DispatchQueuedQueries()
+{
+	// Caller must hold QueryLock
+	while (QueuedOfferIds.Num() > 0 && QueriesInFlight < MaxConcurrentQueries)
+	{
+		const FUniqueOfferId OfferId = QueuedOfferIds.Pop(false);
+		QueriesInFlight++;
+		ApiClient->Item.GetItemDynamicData(OfferId, OnSuccess, OnError);
+	}
+}
+
+void FOnlineAsyncTaskAccelByteQueryOfferDynamicData::OnQueryFinished()
+{
+	// Caller must hold QueryLock
+	QueriesInFlight--;
+	if (QueuedOfferIds.Num() > 0)
+	{
+		DispatchQueuedQueries();
+		return;
+	}
+
+	if (QueriesInFlight == 0)
+	{
+		CompleteTask(bHasQueryFailed ? EAccelByteAsyncTaskCompleteState::RequestFailed : EAccelByteAsyncTaskCompleteState::Success);
+	}
+}
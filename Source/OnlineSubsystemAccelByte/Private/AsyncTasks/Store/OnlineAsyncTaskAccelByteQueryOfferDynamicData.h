@@ -10,7 +10,7 @@
 class FOnlineAsyncTaskAccelByteQueryOfferDynamicData : public FOnlineAsyncTaskAccelByte, public TSelfPtr<FOnlineAsyncTaskAccelByteQueryOfferDynamicData, ESPMode::ThreadSafe>
 {
 public:
-	FOnlineAsyncTaskAccelByteQueryOfferDynamicData(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const FUniqueOfferId& InOfferId,
+	FOnlineAsyncTaskAccelByteQueryOfferDynamicData(FOnlineSubsystemAccelByte* const InABSubsystem, const FUniqueNetId& InUserId, const TArray<FUniqueOfferId>& InOfferIds,
 		const FOnQueryOnlineStoreOffersComplete& InDelegate);
 
 	virtual void Initialize() override;
@@ -28,10 +28,31 @@ private:
 	void HandleGetItemDynamicData(const FAccelByteModelsItemDynamicData& Result);
 	void HandleAsyncTaskError(int32 Code, FString const& ErrMsg);
 
+	/** Send queries for queued offers until we hit the concurrent query limit or run out of offers */
+	void DispatchQueuedQueries();
+
+	/** Mark a query as finished, completing the task once every offer has been responded to */
+	void OnQueryFinished();
+
 	FString ErrorMsg;
-	FUniqueOfferId OfferId;
+	TArray<FUniqueOfferId> OfferIds;
 	THandler<FAccelByteModelsItemDynamicData> OnSuccess;
 	FErrorHandler OnError;
 	FOnQueryOnlineStoreOffersComplete Delegate;
-	FAccelByteModelsItemDynamicData DynamicData;
+	TArray<FAccelByteModelsItemDynamicData> DynamicDataResults;
+
+	/** Offers that still need to be queried */
+	TArray<FUniqueOfferId> QueuedOfferIds;
+
+	/** Number of queries that have been sent and not yet responded to */
+	int32 QueriesInFlight = 0;
+
+	/** Whether any of the queries failed */
+	bool bHasQueryFailed = false;
+
+	/** Lock for the queued offers, results and in flight count, as responses may arrive on different threads */
+	FCriticalSection QueryLock;
+
+	/** Maximum number of queries that may be in flight at once, read from MaxConcurrentOfferDynamicDataQueries in config */
+	int32 MaxConcurrentQueries = 4;
 };
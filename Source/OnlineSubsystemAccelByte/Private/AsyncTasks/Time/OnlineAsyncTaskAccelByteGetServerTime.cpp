@@ -7,10 +7,12 @@
 #include "OnlineTimeInterfaceAccelByte.h"
 #include "Models/AccelByteGeneralModels.h"
 
-FOnlineAsyncTaskAccelByteGetServerTime::FOnlineAsyncTaskAccelByteGetServerTime(FOnlineSubsystemAccelByte* const InABInterface)
+FOnlineAsyncTaskAccelByteGetServerTime::FOnlineAsyncTaskAccelByteGetServerTime(FOnlineSubsystemAccelByte* const InABInterface, bool bInIsResyncSample)
 	: FOnlineAsyncTaskAccelByte(InABInterface, true)
 	, LocalCachedServerTime(MakeShared<FDateTime>())
 	, ErrorMessage(TEXT(""))
+	, bIsResyncSample(bInIsResyncSample)
+	, RequestSentLocalSeconds(0.0)
 {
 }
 
@@ -22,6 +24,7 @@ void FOnlineAsyncTaskAccelByteGetServerTime::Initialize()
 	THandler<FTime> OnGetServerTimeSuccess =
 		TDelegateUtils<THandler<FTime>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteGetServerTime::HandleGetServerTimeSuccess);
 	FErrorHandler OnError = TDelegateUtils<FErrorHandler>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteGetServerTime::HandleGetServerTimeError);
+	RequestSentLocalSeconds = FPlatformTime::Seconds();
 	FRegistry::Miscellaneous.GetServerCurrentTime(OnGetServerTimeSuccess, OnError);
 	AB_OSS_ASYNC_TASK_TRACE_END(TEXT(""));
 }
@@ -30,8 +33,12 @@ void FOnlineAsyncTaskAccelByteGetServerTime::TriggerDelegates()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 
-	const IOnlineTimePtr TimeInterface = Subsystem->GetTimeInterface();
-	if (TimeInterface.IsValid()) 
+	const FOnlineTimeAccelBytePtr TimeInterface = StaticCastSharedPtr<FOnlineTimeAccelByte>(Subsystem->GetTimeInterface());
+	if (TimeInterface.IsValid() && bIsResyncSample)
+	{
+		TimeInterface->OnResyncSampleComplete();
+	}
+	else if (TimeInterface.IsValid()) 
 	{
 		TimeInterface->TriggerOnQueryServerUtcTimeCompleteDelegates(bWasSuccessful, LocalCachedServerTime->ToString(), ErrorMessage);
 	}
@@ -44,7 +51,7 @@ void FOnlineAsyncTaskAccelByteGetServerTime::HandleGetServerTimeSuccess(FTime co
 	const FOnlineTimeAccelBytePtr TimeInterface =  StaticCastSharedPtr<FOnlineTimeAccelByte>(Subsystem->GetTimeInterface());
 	if (TimeInterface.IsValid())
 	{
-		TimeInterface->UpdateServerTime(Result.CurrentTime);
+		TimeInterface->UpdateServerTime(Result.CurrentTime, RequestSentLocalSeconds, FPlatformTime::Seconds());
 		CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
 	}
 	else
@@ -16,7 +16,7 @@ class FOnlineAsyncTaskAccelByteGetServerTime : public FOnlineAsyncTaskAccelByte,
 {
 public:
 
-	FOnlineAsyncTaskAccelByteGetServerTime(FOnlineSubsystemAccelByte* const InABInterface);
+	FOnlineAsyncTaskAccelByteGetServerTime(FOnlineSubsystemAccelByte* const InABInterface, bool bInIsResyncSample = false);
 
 	virtual void Initialize() override;
 	virtual void TriggerDelegates() override;
@@ -32,6 +32,13 @@ private:
 	/** ServerTime cached on the client */
 	TSharedRef<FDateTime> LocalCachedServerTime;
 	FString ErrorMessage;
+
+	/** Whether this task is a background resync of the server clock, in which case query delegates are not fired */
+	bool bIsResyncSample;
+
+	/** FPlatformTime::Seconds() when the request was sent, used to measure the round trip */
+	double RequestSentLocalSeconds;
+
 	void HandleGetServerTimeSuccess(FTime const& Result);
 	void HandleGetServerTimeError(int32 Code, FString const& ErrMsg);
 };
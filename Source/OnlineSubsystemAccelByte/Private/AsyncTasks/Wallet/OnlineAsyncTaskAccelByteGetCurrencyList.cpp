@@ -7,9 +7,10 @@
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineWalletInterfaceAccelByte.h"
 
-FOnlineAsyncTaskAccelByteGetCurrencyList::FOnlineAsyncTaskAccelByteGetCurrencyList(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, bool bInAlwaysRequestToService)
+FOnlineAsyncTaskAccelByteGetCurrencyList::FOnlineAsyncTaskAccelByteGetCurrencyList(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, bool bInAlwaysRequestToService, const FOnGetCurrencyListCompletedDelegate& InDelegate)
 	: FOnlineAsyncTaskAccelByte(InABInterface)
 	, bAlwaysRequestToService(bInAlwaysRequestToService)
+	, Delegate(InDelegate)
 {
 	UserId = FUniqueNetIdAccelByteUser::CastChecked(InLocalUserId);
 }
@@ -60,6 +61,15 @@ void FOnlineAsyncTaskAccelByteGetCurrencyList::TriggerDelegates()
 {
 	AB_OSS_ASYNC_TASK_TRACE_BEGIN(TEXT("bWasSuccessful: %s"), LOG_BOOL_FORMAT(bWasSuccessful));
 
+	if (bWasSuccessful)
+	{
+		Delegate.ExecuteIfBound(LocalUserNum, true, CachedCurrencyList, TEXT(""));
+	}
+	else
+	{
+		Delegate.ExecuteIfBound(LocalUserNum, false, TArray<FAccelByteModelsCurrencyList>{}, ErrorStr);
+	}
+
 	const FOnlineWalletAccelBytePtr WalletInterface = StaticCastSharedPtr<FOnlineWalletAccelByte>(Subsystem->GetWalletInterface());
 	if (WalletInterface.IsValid())
 	{
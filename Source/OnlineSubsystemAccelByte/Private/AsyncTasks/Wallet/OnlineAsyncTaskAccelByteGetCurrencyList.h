@@ -17,7 +17,7 @@ class FOnlineAsyncTaskAccelByteGetCurrencyList : public FOnlineAsyncTaskAccelByt
 {
 public:
 
-	FOnlineAsyncTaskAccelByteGetCurrencyList(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, bool bInAlwaysRequestToService);
+	FOnlineAsyncTaskAccelByteGetCurrencyList(FOnlineSubsystemAccelByte* const InABInterface, const FUniqueNetId& InLocalUserId, bool bInAlwaysRequestToService, const FOnGetCurrencyListCompletedDelegate& InDelegate = FOnGetCurrencyListCompletedDelegate());
 
 	virtual void Initialize() override;
 	virtual void TriggerDelegates() override;
@@ -50,4 +50,7 @@ private:
 
 	TArray<FAccelByteModelsCurrencyList> CachedCurrencyList;
 	bool bAlwaysRequestToService;
+
+	/** Delegate fired for this request only, on top of the wallet interface's get currency list completed delegates */
+	FOnGetCurrencyListCompletedDelegate Delegate;
 };
@@ -25,7 +25,7 @@ void FOnlineAsyncTaskAccelByteGetWalletInfo::Initialize()
 	if (WalletInterface.IsValid())
 	{
 		FAccelByteModelsWalletInfo WalletInfo;
-		if (!WalletInterface->GetWalletInfoFromCache(LocalUserNum, CurrencyCode, WalletInfo) || bAlwaysRequestToService)
+		if (!WalletInterface->GetWalletInfoFromCache(LocalUserNum, CurrencyCode, WalletInfo) || bAlwaysRequestToService || WalletInterface->IsWalletInfoStale(LocalUserNum, CurrencyCode))
 		{	
 			// Create delegates for successfully as well as unsuccessfully requesting to get wallet info
 			OnGetWalletInfoSuccessDelegate = TDelegateUtils<THandler<FAccelByteModelsWalletInfo>>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteGetWalletInfo::OnGetWalletInfoSuccess);
@@ -0,0 +1,268 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestAsyncTaskBenchmark.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "AsyncTasks/OnlineAsyncTaskAccelByte.h"
+#include "HAL/PlatformProcess.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/WindowsHWrapper.h"
+#elif PLATFORM_UNIX || PLATFORM_MAC
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	/** Amount of tasks that are left to time out rather than being completed by the benchmark */
+	constexpr int32 TimedOutTaskCount = 10;
+
+	/** Timeout used for the tasks that are left to time out */
+	constexpr double ShortTaskTimeoutSeconds = 1.0;
+
+	/** Most CPU the process may use while every task is idle, as a percentage of one core */
+	constexpr float MaxIdleCPUPercent = 50.0f;
+
+	/** Seconds past the idle window that the tasks the benchmark completes itself are allowed to live before timing out */
+	constexpr double CompletedTaskTimeoutMarginSeconds = 10.0;
+
+	/**
+	 * Get the CPU time used by every thread in this process so far, straight from the OS. FPlatformTime::GetCPUTime is only
+	 * refreshed by the engine tick, which is blocked for the whole idle window, so it cannot be used here.
+	 *
+	 * @return CPU seconds used by the process, or a negative value if this platform does not support reading it
+	 */
+	double GetProcessCPUSeconds()
+	{
+#if PLATFORM_WINDOWS
+		FILETIME CreationTime, ExitTime, KernelTime, UserTime;
+		if (!::GetProcessTimes(::GetCurrentProcess(), &CreationTime, &ExitTime, &KernelTime, &UserTime))
+		{
+			return -1.0;
+		}
+		const auto ToSeconds = [](const FILETIME& Time) {
+			// FILETIME counts in 100 nanosecond intervals
+			return static_cast<double>((static_cast<uint64>(Time.dwHighDateTime) << 32) | Time.dwLowDateTime) / 10000000.0;
+		};
+		return ToSeconds(KernelTime) + ToSeconds(UserTime);
+#elif PLATFORM_UNIX || PLATFORM_MAC
+		struct rusage Usage;
+		if (getrusage(RUSAGE_SELF, &Usage) != 0)
+		{
+			return -1.0;
+		}
+		const auto ToSeconds = [](const struct timeval& Time) {
+			return static_cast<double>(Time.tv_sec) + static_cast<double>(Time.tv_usec) / 1000000.0;
+		};
+		return ToSeconds(Usage.ru_utime) + ToSeconds(Usage.ru_stime);
+#else
+		return -1.0;
+#endif
+	}
+
+	class FOnlineAsyncTaskAccelByteBenchmark;
+
+	/**
+	 * Results shared between the benchmark and each task that it dispatches. Only touched from the game thread.
+	 */
+	struct FAsyncTaskBenchmarkResults
+	{
+		/** Tasks that the benchmark will complete itself once the idle window has passed */
+		TArray<FOnlineAsyncTaskAccelByteBenchmark*> TasksToComplete;
+
+		/** Time between each task being completed and its delegates being triggered */
+		TArray<double> CompletionToDelegateMs;
+
+		/** Amount of tasks that were completed by timing out */
+		int32 TimedOutTasks = 0;
+
+		/** Longest time between a task's deadline and it being flagged as timed out */
+		double LongestTimeoutOvershootSeconds = 0.0;
+
+		/** Amount of tasks that have had their delegates triggered */
+		int32 DelegatesTriggered = 0;
+
+		/** Amount of tasks that the benchmark dispatched */
+		int32 ExpectedDelegates = 0;
+
+		/** Called once every task has had its delegates triggered */
+		TFunction<void()> OnAllDelegatesTriggered;
+	};
+
+	/**
+	 * Task that does no work of its own, staying in flight until it is completed by the benchmark or times out.
+	 */
+	class FOnlineAsyncTaskAccelByteBenchmark : public FOnlineAsyncTaskAccelByte
+	{
+	public:
+
+		FOnlineAsyncTaskAccelByteBenchmark(FOnlineSubsystemAccelByte* const InABSubsystem, const TSharedRef<FAsyncTaskBenchmarkResults>& InResults, bool bInShouldTimeOut, double InIdleSeconds)
+			: FOnlineAsyncTaskAccelByte(InABSubsystem, ASYNC_TASK_FLAG_BIT(EAccelByteAsyncTaskFlags::UseTimeout) | ASYNC_TASK_FLAG_BIT(EAccelByteAsyncTaskFlags::ServerTask))
+			, Results(InResults)
+		{
+			if (bInShouldTimeOut)
+			{
+				TaskTimeoutInSeconds = ShortTaskTimeoutSeconds;
+			}
+			else
+			{
+				// Outlive the idle window whatever its length, so that these tasks are only ever completed by the benchmark
+				TaskTimeoutInSeconds = InIdleSeconds + CompletedTaskTimeoutMarginSeconds;
+				Results->TasksToComplete.Add(this);
+			}
+		}
+
+		virtual void Initialize() override
+		{
+			Super::Initialize();
+			InitializedTimeInSeconds = FPlatformTime::Seconds();
+		}
+
+		virtual void TriggerDelegates() override
+		{
+			Super::TriggerDelegates();
+
+			if (bWasSuccessful)
+			{
+				Results->CompletionToDelegateMs.Add((FPlatformTime::Seconds() - BenchmarkCompletedTimeInSeconds) * 1000.0);
+			}
+			else if (CompleteState == EAccelByteAsyncTaskCompleteState::TimedOut)
+			{
+				Results->TimedOutTasks++;
+				const double OvershootSeconds = BenchmarkCompletedTimeInSeconds - (InitializedTimeInSeconds + TaskTimeoutInSeconds);
+				Results->LongestTimeoutOvershootSeconds = FMath::Max(Results->LongestTimeoutOvershootSeconds, OvershootSeconds);
+			}
+
+			Results->DelegatesTriggered++;
+			if (Results->DelegatesTriggered == Results->ExpectedDelegates && Results->OnAllDelegatesTriggered)
+			{
+				Results->OnAllDelegatesTriggered();
+			}
+		}
+
+		/**
+		 * Complete this task successfully from the game thread, as an SDK callback would.
+		 */
+		void CompleteForBenchmark()
+		{
+			BenchmarkCompletedTimeInSeconds = FPlatformTime::Seconds();
+			CompleteTask(EAccelByteAsyncTaskCompleteState::Success);
+		}
+
+	protected:
+
+		virtual const FString GetTaskName() const override
+		{
+			return TEXT("FOnlineAsyncTaskAccelByteBenchmark");
+		}
+
+		virtual void OnTaskTimedOut() override
+		{
+			BenchmarkCompletedTimeInSeconds = FPlatformTime::Seconds();
+		}
+
+	private:
+
+		/** Results that this task records into */
+		TSharedRef<FAsyncTaskBenchmarkResults> Results;
+
+		/** Platform time in seconds that this task was initialized, and so had its timeout armed, at */
+		double InitializedTimeInSeconds = 0.0;
+
+		/** Platform time in seconds that this task was completed at, either by the benchmark or by timing out */
+		double BenchmarkCompletedTimeInSeconds = 0.0;
+	};
+}
+
+FExecTestAsyncTaskBenchmark::FExecTestAsyncTaskBenchmark(UWorld* InWorld, const FName& InSubsystemName, int32 InTaskCount, float InIdleSeconds)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, TaskCount(FMath::Max(1, InTaskCount))
+	, IdleSeconds(FMath::Max(static_cast<float>(ShortTaskTimeoutSeconds) * 2.0f, InIdleSeconds))
+{
+}
+
+bool FExecTestAsyncTaskBenchmark::Run()
+{
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	if (!Check(Subsystem != nullptr, TEXT("subsystem is available")))
+	{
+		bIsComplete = true;
+		return ReportResult(TEXT("FExecTestAsyncTaskBenchmark"));
+	}
+
+	const TSharedRef<FAsyncTaskBenchmarkResults> Results = MakeShared<FAsyncTaskBenchmarkResults>();
+	Results->ExpectedDelegates = TaskCount + TimedOutTaskCount;
+
+	const TWeakPtr<FExecTestAsyncTaskBenchmark> WeakThis = AsShared();
+	Results->OnAllDelegatesTriggered = [WeakThis, Results]() {
+		const TSharedPtr<FExecTestAsyncTaskBenchmark> StrongThis = WeakThis.Pin();
+		if (StrongThis.IsValid())
+		{
+			StrongThis->OnAllDelegatesTriggered(Results->CompletionToDelegateMs, Results->TimedOutTasks, Results->LongestTimeoutOvershootSeconds);
+		}
+	};
+
+	for (int32 Index = 0; Index < TaskCount; Index++)
+	{
+		Subsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteBenchmark>(Subsystem, Results, false, static_cast<double>(IdleSeconds));
+	}
+	for (int32 Index = 0; Index < TimedOutTaskCount; Index++)
+	{
+		Subsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteBenchmark>(Subsystem, Results, true, static_cast<double>(IdleSeconds));
+	}
+
+	// Hold the game thread while every task is in flight, so that the only work left in the process is the online thread
+	// ticking them, and measure the CPU time the process uses over that window
+	const double StartCPUSeconds = GetProcessCPUSeconds();
+	const double StartTimeInSeconds = FPlatformTime::Seconds();
+	FPlatformProcess::Sleep(IdleSeconds);
+	const double EndCPUSeconds = GetProcessCPUSeconds();
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTimeInSeconds;
+	if (StartCPUSeconds >= 0.0 && EndCPUSeconds >= 0.0 && ElapsedSeconds > 0.0)
+	{
+		IdleCPUPercent = static_cast<float>((EndCPUSeconds - StartCPUSeconds) / ElapsedSeconds * 100.0);
+	}
+
+	// Complete every remaining task in one go, as a burst of SDK responses would
+	for (FOnlineAsyncTaskAccelByteBenchmark* Task : Results->TasksToComplete)
+	{
+		Task->CompleteForBenchmark();
+	}
+	Results->TasksToComplete.Empty();
+
+	return true;
+}
+
+void FExecTestAsyncTaskBenchmark::OnAllDelegatesTriggered(const TArray<double>& CompletionToDelegateMs, int32 TimedOutTasks, double LongestTimeoutOvershootSeconds)
+{
+	bIsComplete = true;
+
+	Check(CompletionToDelegateMs.Num() == TaskCount, TEXT("every completed task has its delegates triggered"));
+	Check(TimedOutTasks == TimedOutTaskCount, TEXT("every task left in flight times out"));
+	Check(LongestTimeoutOvershootSeconds < 1.0, TEXT("timeouts are flagged within a second of their deadline"));
+
+	// A busy polling online thread would use a whole core on its own while nothing is happening
+	Check(IdleCPUPercent < MaxIdleCPUPercent, TEXT("online thread does not spin while tasks are idle"));
+
+	TArray<double> SortedLatencies = CompletionToDelegateMs;
+	SortedLatencies.Sort();
+	const auto GetPercentile = [&SortedLatencies](double Percentile) {
+		return SortedLatencies.Num() > 0 ? SortedLatencies[FMath::Min(SortedLatencies.Num() - 1, static_cast<int32>(Percentile * SortedLatencies.Num()))] : 0.0;
+	};
+
+	UE_LOG_AB(Log, TEXT("FExecTestAsyncTaskBenchmark with %d task(s) in flight: idle CPU %.2f%% of one core over %.1f s; completion to delegate p50 %.2f ms, p95 %.2f ms, max %.2f ms; longest timeout overshoot %.3f s")
+		, TaskCount
+		, IdleCPUPercent
+		, IdleSeconds
+		, GetPercentile(0.5)
+		, GetPercentile(0.95)
+		, SortedLatencies.Num() > 0 ? SortedLatencies.Last() : 0.0
+		, LongestTimeoutOvershootSeconds);
+	ReportResult(TEXT("FExecTestAsyncTaskBenchmark"));
+}
+
+#endif
@@ -0,0 +1,51 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Benchmark for the async task manager. Dispatches a large amount of tasks that stay in flight while the game thread is
+ * idle, reading the process CPU time from the OS over that window to check that the online thread is not spinning. It
+ * then completes them all from the game thread to measure the latency from completion to delegates being triggered. A handful of extra tasks are left to time out through the timer
+ * wheel, checking that they are flagged close to their deadline.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST ASYNCTASK BENCHMARK <optional task count, defaults to 1000> <optional idle seconds, defaults to 2>
+ */
+class FExecTestAsyncTaskBenchmark : public FExecTestBase, public TSharedFromThis<FExecTestAsyncTaskBenchmark>
+{
+public:
+
+	/**
+	 * Constructs an instance of the async task benchmark.
+	 * 
+	 * @param TaskCount Amount of tasks to keep in flight and then complete
+	 * @param IdleSeconds Seconds to keep the tasks in flight for while measuring CPU usage
+	 */
+	FExecTestAsyncTaskBenchmark(UWorld* InWorld, const FName& InSubsystemName, int32 InTaskCount, float InIdleSeconds);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Amount of tasks to keep in flight and then complete */
+	int32 TaskCount;
+
+	/** Seconds to keep the tasks in flight for while measuring CPU usage */
+	float IdleSeconds;
+
+	/** Process CPU time used while the tasks were in flight, as a percentage of one core, or negative if unavailable */
+	float IdleCPUPercent = -1.0f;
+
+	/** Called once the delegates of every task dispatched by the benchmark have been triggered */
+	void OnAllDelegatesTriggered(const TArray<double>& CompletionToDelegateMs, int32 TimedOutTasks, double LongestTimeoutOvershootSeconds);
+
+};
+
+#endif
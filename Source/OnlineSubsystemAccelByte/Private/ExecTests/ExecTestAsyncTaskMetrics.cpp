@@ -0,0 +1,229 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestAsyncTaskMetrics.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineAsyncTaskMetricsAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "AsyncTasks/OnlineAsyncTaskAccelByte.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Threads recording into the same metrics at once */
+	constexpr int32 RecordingThreadCount = 8;
+
+	/** Tasks recorded by each of those threads */
+	constexpr int32 TasksPerRecordingThread = 1000;
+
+	/**
+	 * Task that does no work of its own, completed by the test as an SDK callback would.
+	 */
+	class FOnlineAsyncTaskAccelByteMetricsTest : public FOnlineAsyncTaskAccelByte
+	{
+	public:
+
+		explicit FOnlineAsyncTaskAccelByteMetricsTest(FOnlineSubsystemAccelByte* const InABSubsystem)
+			: FOnlineAsyncTaskAccelByte(InABSubsystem, ASYNC_TASK_FLAG_BIT(EAccelByteAsyncTaskFlags::ServerTask))
+		{
+		}
+
+		void CompleteForTest(EAccelByteAsyncTaskCompleteState InCompleteState)
+		{
+			CompleteTask(InCompleteState);
+		}
+
+		static const TCHAR* GetTestTaskName()
+		{
+			return TEXT("FOnlineAsyncTaskAccelByteMetricsTest");
+		}
+
+	protected:
+
+		virtual const FString GetTaskName() const override
+		{
+			return GetTestTaskName();
+		}
+	};
+
+	/** Get the metrics recorded for a task class, or empty metrics if nothing has been recorded for it */
+	FAccelByteAsyncTaskClassMetrics FindTaskClassMetrics(const FOnlineAsyncTaskMetricsAccelByte& Metrics, const FString& TaskName)
+	{
+		const FAccelByteAsyncTaskMetricsSnapshot Snapshot = Metrics.GetSnapshot();
+		const FAccelByteAsyncTaskClassMetrics* TaskMetrics = Snapshot.TaskClasses.FindByPredicate([&TaskName](const FAccelByteAsyncTaskClassMetrics& Candidate) {
+			return Candidate.TaskName == TaskName;
+		});
+		return (TaskMetrics != nullptr) ? *TaskMetrics : FAccelByteAsyncTaskClassMetrics();
+	}
+}
+
+FExecTestAsyncTaskMetrics::FExecTestAsyncTaskMetrics(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestAsyncTaskMetrics::Run()
+{
+	bIsComplete = true;
+
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	const TSharedRef<FOnlineAsyncTaskMetricsAccelByte, ESPMode::ThreadSafe> Metrics = MakeShared<FOnlineAsyncTaskMetricsAccelByte, ESPMode::ThreadSafe>(Subsystem);
+	Metrics->SetEnabled(true);
+	Metrics->Reset();
+
+	const FString FastTaskName = TEXT("FExecTestFastTask");
+	const FString SlowTaskName = TEXT("FExecTestSlowTask");
+
+	// One hundred fast tasks taking 1 to 100 ms each, one of which is still in flight
+	for (int32 Index = 1; Index <= 100; Index++)
+	{
+		Metrics->RecordTaskStarted(FastTaskName, 0.001);
+		if (Index < 100)
+		{
+			Metrics->RecordTaskCompleted(FastTaskName, Index / 1000.0, true, false);
+			Metrics->RecordTaskDelegatesTriggered(FastTaskName, 0.002);
+		}
+	}
+
+	// Two slow tasks, one timing out and one failing
+	Metrics->RecordTaskStarted(SlowTaskName, 2.0);
+	Metrics->RecordTaskCompleted(SlowTaskName, 31.0, false, true);
+	Metrics->RecordTaskStarted(SlowTaskName, 4.0);
+	Metrics->RecordTaskCompleted(SlowTaskName, 12.0, false, false);
+
+	Metrics->RecordQueueDepths(7, 3);
+	Metrics->RecordQueueDepths(2, 5);
+
+	const FAccelByteAsyncTaskMetricsSnapshot Snapshot = Metrics->GetSnapshot();
+	Check(Snapshot.TaskClasses.Num() == 2, TEXT("one entry is recorded per task class"));
+	Check(Snapshot.QueuedSerialTasks == 2 && Snapshot.PeakQueuedSerialTasks == 7, TEXT("serial queue depth and peak are recorded"));
+	Check(Snapshot.ParallelTasks == 5 && Snapshot.PeakParallelTasks == 5, TEXT("parallel task count and peak are recorded"));
+
+	if (Snapshot.TaskClasses.Num() == 2)
+	{
+		// Classes are ordered by total execution time, so the slow tasks come first
+		const FAccelByteAsyncTaskClassMetrics& SlowMetrics = Snapshot.TaskClasses[0];
+		const FAccelByteAsyncTaskClassMetrics& FastMetrics = Snapshot.TaskClasses[1];
+		Check(SlowMetrics.TaskName == SlowTaskName, TEXT("task classes are ordered by total execution time"));
+		Check(SlowMetrics.TimedOut == 1 && SlowMetrics.Failed == 1 && SlowMetrics.Succeeded == 0, TEXT("timeouts are counted apart from other failures"));
+		Check(SlowMetrics.GetInFlight() == 0, TEXT("completed tasks are not in flight"));
+		Check(FMath::IsNearlyEqual(SlowMetrics.QueueWait.MaxMs, 4000.0), TEXT("queue wait is recorded in milliseconds"));
+
+		Check(FastMetrics.Started == 100 && FastMetrics.Succeeded == 99, TEXT("started and succeeded tasks are counted"));
+		Check(FastMetrics.GetInFlight() == 1, TEXT("started tasks without a completion are in flight"));
+		Check(FastMetrics.Execution.Count == 99 && FastMetrics.TimeToDelegates.Count == 99, TEXT("a sample is recorded per completed task"));
+		Check(FMath::IsNearlyEqual(FastMetrics.Execution.GetMeanMs(), 50.0), TEXT("mean execution time is exact"));
+		Check(FMath::IsNearlyEqual(FastMetrics.Execution.GetPercentileMs(0.5), 50.0), TEXT("median execution time lands in its bucket"));
+		Check(FMath::IsNearlyEqual(FastMetrics.Execution.GetPercentileMs(0.95), 99.0), TEXT("percentiles never exceed the largest sample"));
+		Check(FMath::IsNearlyEqual(FastMetrics.TimeToDelegates.GetPercentileMs(0.99), 2.0), TEXT("time to delegates is recorded"));
+	}
+
+	// Samples past the largest bucket are reported as the largest sample seen
+	FAccelByteAsyncTaskLatencyHistogram OverflowHistogram;
+	OverflowHistogram.AddSample(90000.0);
+	OverflowHistogram.AddSample(120000.0);
+	Check(FMath::IsNearlyEqual(OverflowHistogram.GetPercentileMs(0.5), 120000.0), TEXT("overflow bucket reports the largest sample"));
+
+	// Samples on a bucket bound land in that bucket, and anything past it in the next one
+	FAccelByteAsyncTaskLatencyHistogram BoundaryHistogram;
+	BoundaryHistogram.AddSample(5.0);
+	Check(FMath::IsNearlyEqual(BoundaryHistogram.GetPercentileMs(1.0), 5.0), TEXT("a sample on a bucket bound lands in that bucket"));
+	BoundaryHistogram.AddSample(5.5);
+	BoundaryHistogram.AddSample(5.5);
+	Check(BoundaryHistogram.BucketCounts[2] == 1 && BoundaryHistogram.BucketCounts[3] == 2, TEXT("a sample past a bucket bound lands in the next bucket"));
+	Check(FMath::IsNearlyEqual(BoundaryHistogram.GetPercentileMs(0.5), 5.5), TEXT("percentiles are capped at the largest sample"));
+	Check(FMath::IsNearlyEqual(FAccelByteAsyncTaskLatencyHistogram().GetPercentileMs(0.5), 0.0), TEXT("an empty histogram reports zero"));
+
+	// Percentiles never go down as the percentile asked for goes up
+	const auto ArePercentilesOrdered = [](const FAccelByteAsyncTaskLatencyHistogram& Histogram) {
+		double LastPercentileMs = 0.0;
+		for (int32 Step = 0; Step <= 100; Step++)
+		{
+			const double PercentileMs = Histogram.GetPercentileMs(Step / 100.0);
+			if (PercentileMs < LastPercentileMs)
+			{
+				return false;
+			}
+			LastPercentileMs = PercentileMs;
+		}
+		return true;
+	};
+	Check(ArePercentilesOrdered(OverflowHistogram) && ArePercentilesOrdered(BoundaryHistogram), TEXT("percentiles are ordered"));
+
+	// Tasks record from the online thread, parallel tasks and the game thread, so recording at once must not lose anything
+	Metrics->Reset();
+	const FString ThreadedTaskName = TEXT("FExecTestThreadedTask");
+	ParallelFor(RecordingThreadCount, [&Metrics, &ThreadedTaskName](int32 ThreadIndex) {
+		for (int32 Index = 0; Index < TasksPerRecordingThread; Index++)
+		{
+			Metrics->RecordTaskStarted(ThreadedTaskName, 0.001);
+			Metrics->RecordTaskCompleted(ThreadedTaskName, 0.002, Index % 2 == 0, false);
+			Metrics->RecordTaskDelegatesTriggered(ThreadedTaskName, 0.001);
+			Metrics->RecordQueueDepths(ThreadIndex, ThreadIndex * 2);
+		}
+	});
+	const FAccelByteAsyncTaskClassMetrics ThreadedMetrics = FindTaskClassMetrics(Metrics.Get(), ThreadedTaskName);
+	constexpr uint32 ThreadedTaskCount = RecordingThreadCount * TasksPerRecordingThread;
+	Check(ThreadedMetrics.Started == ThreadedTaskCount && ThreadedMetrics.Succeeded + ThreadedMetrics.Failed == ThreadedTaskCount, TEXT("no task is lost when recording from many threads"));
+	Check(ThreadedMetrics.Succeeded == ThreadedTaskCount / 2 && ThreadedMetrics.GetInFlight() == 0, TEXT("outcomes recorded from many threads are exact"));
+	Check(ThreadedMetrics.Execution.Count == ThreadedTaskCount && ThreadedMetrics.TimeToDelegates.Count == ThreadedTaskCount, TEXT("no sample is lost when recording from many threads"));
+	Check(FMath::IsNearlyEqual(ThreadedMetrics.Execution.GetMeanMs(), 2.0), TEXT("samples recorded from many threads are summed exactly"));
+	const FAccelByteAsyncTaskMetricsSnapshot ThreadedSnapshot = Metrics->GetSnapshot();
+	Check(ThreadedSnapshot.PeakQueuedSerialTasks == RecordingThreadCount - 1 && ThreadedSnapshot.PeakParallelTasks == (RecordingThreadCount - 1) * 2, TEXT("queue peaks recorded from many threads are the largest sampled"));
+
+	// Resetting drops every class and queue depth
+	Metrics->Reset();
+	const FAccelByteAsyncTaskMetricsSnapshot ResetSnapshot = Metrics->GetSnapshot();
+	Check(ResetSnapshot.TaskClasses.Num() == 0 && ResetSnapshot.PeakQueuedSerialTasks == 0, TEXT("reset discards recorded metrics"));
+
+	Metrics->SetEnabled(false);
+	Check(!Metrics->IsEnabled(), TEXT("metrics can be disabled"));
+
+	// Run tasks through their lifecycle against the subsystem's own metrics, as the async task manager would
+	const FOnlineAsyncTaskMetricsAccelBytePtr SubsystemMetrics = (Subsystem != nullptr) ? Subsystem->GetAsyncTaskMetrics() : nullptr;
+	if (Check(SubsystemMetrics.IsValid(), TEXT("subsystem has async task metrics")))
+	{
+		const bool bWasEnabled = SubsystemMetrics->IsEnabled();
+		const FString TestTaskName = FOnlineAsyncTaskAccelByteMetricsTest::GetTestTaskName();
+		const FAccelByteAsyncTaskClassMetrics Before = FindTaskClassMetrics(*SubsystemMetrics, TestTaskName);
+
+		// A task created while metrics are disabled records nothing, even once they are enabled
+		SubsystemMetrics->SetEnabled(false);
+		TUniquePtr<FOnlineAsyncTaskAccelByteMetricsTest> UnrecordedTask = MakeUnique<FOnlineAsyncTaskAccelByteMetricsTest>(Subsystem);
+		SubsystemMetrics->SetEnabled(true);
+		UnrecordedTask->Initialize();
+		UnrecordedTask->CompleteForTest(EAccelByteAsyncTaskCompleteState::Success);
+		UnrecordedTask.Reset();
+		Check(FindTaskClassMetrics(*SubsystemMetrics, TestTaskName).Started == Before.Started, TEXT("tasks created with metrics disabled record nothing"));
+
+		// Destroying a task once its delegates have been triggered records the time it took to get there
+		TUniquePtr<FOnlineAsyncTaskAccelByteMetricsTest> SucceedingTask = MakeUnique<FOnlineAsyncTaskAccelByteMetricsTest>(Subsystem);
+		TUniquePtr<FOnlineAsyncTaskAccelByteMetricsTest> FailingTask = MakeUnique<FOnlineAsyncTaskAccelByteMetricsTest>(Subsystem);
+		SucceedingTask->Initialize();
+		FailingTask->Initialize();
+		const FAccelByteAsyncTaskClassMetrics Started = FindTaskClassMetrics(*SubsystemMetrics, TestTaskName);
+		Check(Started.Started == Before.Started + 2 && Started.GetInFlight() == Before.GetInFlight() + 2, TEXT("initialized tasks are recorded as in flight"));
+
+		SucceedingTask->CompleteForTest(EAccelByteAsyncTaskCompleteState::Success);
+		FailingTask->CompleteForTest(EAccelByteAsyncTaskCompleteState::RequestFailed);
+		SucceedingTask->TriggerDelegates();
+		FailingTask->TriggerDelegates();
+		SucceedingTask.Reset();
+		FailingTask.Reset();
+
+		const FAccelByteAsyncTaskClassMetrics After = FindTaskClassMetrics(*SubsystemMetrics, TestTaskName);
+		Check(After.Succeeded == Before.Succeeded + 1 && After.Failed == Before.Failed + 1 && After.TimedOut == Before.TimedOut, TEXT("task outcomes are recorded"));
+		Check(After.GetInFlight() == Before.GetInFlight(), TEXT("completed tasks are no longer in flight"));
+		Check(After.QueueWait.Count == Before.QueueWait.Count + 2 && After.Execution.Count == Before.Execution.Count + 2, TEXT("queue wait and execution are recorded per task"));
+		Check(After.TimeToDelegates.Count == Before.TimeToDelegates.Count + 2, TEXT("time to delegates is recorded as tasks are destroyed"));
+
+		SubsystemMetrics->SetEnabled(bWasEnabled);
+	}
+
+	return ReportResult(TEXT("FExecTestAsyncTaskMetrics"));
+}
+
+#endif
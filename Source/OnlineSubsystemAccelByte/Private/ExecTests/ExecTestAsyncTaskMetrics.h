@@ -0,0 +1,34 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the async task metrics, checking per task class counters, latency percentiles, bucket boundaries and queue
+ * depth peaks, and that nothing is lost when many threads record at once. Also runs tasks through their real lifecycle to
+ * check that they record into the subsystem's metrics only when metrics were enabled as they were created, comparing
+ * against the counts before the test so that metrics already recorded by the subsystem are left untouched.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST ASYNCTASK METRICS
+ */
+class FExecTestAsyncTaskMetrics : public FExecTestBase, public TSharedFromThis<FExecTestAsyncTaskMetrics>
+{
+public:
+
+	/**
+	 * Constructs an instance of the async task metrics test case.
+	 */
+	FExecTestAsyncTaskMetrics(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
@@ -0,0 +1,47 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "OnlineSubsystemAccelByteTypes.h"
+#include "Interfaces/OnlineStoreInterfaceV2.h"
+#include "Models/AccelByteOrderModels.h"
+
+/**
+ * Backend calls that exec tests answer themselves in place of the AccelByte backend, so that the code around a call can
+ * be checked without a live environment. Owned by the subsystem and only compiled into builds with automation tests.
+ *
+ * A test sets the override it needs before dispatching the work under test, and calls Reset once it is done, so that
+ * later calls go to the backend again.
+ */
+class FExecTestBackendOverrides
+{
+public:
+	/** Takes the order a checkout would create, answered through FOnlineAsyncTaskAccelByteCheckout::HandleCheckoutComplete */
+	TFunction<void(const FAccelByteModelsOrderCreate& /*OrderRequest*/)> CreateOrder;
+
+	/** Takes the code a redemption would send, answered through FOnlineAsyncTaskAccelByteRedeemCode::HandleRedeemCodeComplete */
+	TFunction<void(const FString& /*Code*/)> RedeemCode;
+
+	/** Takes a chunk of a bulk public user record fetch, answered through the task's chunk success and error handlers */
+	TFunction<void(const FString& /*Key*/, const TArray<FString>& /*ChunkUserIds*/)> BulkGetPublicUserRecordChunk;
+
+	/** Takes an offer dynamic data fetch, answered by emplacing the dynamic data in the store and firing the delegate */
+	TFunction<void(const FUniqueNetIdAccelByteUserRef& /*UserId*/, const TArray<FUniqueOfferId>& /*OfferIds*/, const FOnQueryOnlineStoreOffersComplete& /*Delegate*/)> FetchOfferDynamicData;
+
+	/** Clear every override, sending calls to the backend again */
+	void Reset()
+	{
+		CreateOrder = nullptr;
+		RedeemCode = nullptr;
+		BulkGetPublicUserRecordChunk = nullptr;
+		FetchOfferDynamicData = nullptr;
+	}
+};
+
+#endif
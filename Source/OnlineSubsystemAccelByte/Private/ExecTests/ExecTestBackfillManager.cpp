@@ -0,0 +1,125 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestBackfillManager.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSessionInterfaceV2AccelByte.h"
+#include "OnlineBackfillManagerAccelByte.h"
+#include "OnlineSubsystemAccelByteSessionSettings.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestBackfillManager::FExecTestBackfillManager(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestBackfillManager::Run()
+{
+	bIsComplete = true;
+
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	if (!Check(Subsystem != nullptr, TEXT("subsystem is available")))
+	{
+		return ReportResult(TEXT("FExecTestBackfillManager"));
+	}
+
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	const FOnlineBackfillManagerAccelBytePtr BackfillManager = Subsystem->GetBackfillManager();
+	if (!Check(FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface) && BackfillManager.IsValid(), TEXT("V2 session interface and backfill manager are available")))
+	{
+		return ReportResult(TEXT("FExecTestBackfillManager"));
+	}
+
+	const FName SessionName(TEXT("ExecTestBackfillSession"));
+	const FString BackfillTicketId = TEXT("exectestbackfillticket");
+	const int32 MaxPlayers = 4;
+	const FString MatchPool = TEXT("exectestbackfillpool");
+
+	// Set up a local session holding the backfill ticket, with no one joined yet
+	const auto AddSession = [&]() {
+		FOnlineSessionSettings SessionSettings;
+		SessionSettings.NumPublicConnections = MaxPlayers;
+		SessionSettings.Set(SETTING_MATCHMAKING_BACKFILL_TICKET_ID, BackfillTicketId);
+		SessionSettings.Set(SETTING_SESSION_MATCHPOOL, MatchPool);
+		FNamedOnlineSession* Session = SessionInterface->AddNamedSession(SessionName, SessionSettings);
+		SessionInterface->SetNamedSessionInfo(*Session, MakeShared<FOnlineSessionInfoAccelByteV2>(TEXT("exectestbackfillsession")));
+	};
+
+	int32 ProposalCount = 0;
+	const auto MakeTeamsProposal = [&](const TArray<TArray<FString>>& TeamUserIds) {
+		FAccelByteModelsV2MatchmakingBackfillProposalNotif Proposal;
+		Proposal.BackfillTicketID = BackfillTicketId;
+		Proposal.ProposalID = FString::Printf(TEXT("exectestproposal%d"), ProposalCount++);
+		for (const TArray<FString>& UserIds : TeamUserIds)
+		{
+			FAccelByteModelsV2GameSessionTeam& Team = Proposal.ProposedTeams.AddDefaulted_GetRef();
+			Team.Parties.AddDefaulted_GetRef().UserIDs = UserIds;
+		}
+		return Proposal;
+	};
+	const auto MakeProposal = [&](const TArray<FString>& UserIds) {
+		return MakeTeamsProposal({ UserIds });
+	};
+
+	// Defer everything to the game, keeping the context each proposal was evaluated with
+	TArray<FAccelByteBackfillProposalContext> Contexts;
+	const bool bWasEnabled = BackfillManager->IsEnabled();
+	const uint64 DeferredBefore = BackfillManager->GetMetrics().ProposalsDeferred;
+	BackfillManager->SetPolicy([&Contexts](const FAccelByteBackfillProposalContext& Context) {
+		Contexts.Add(Context);
+		return EAccelByteBackfillDecision::Defer;
+	});
+
+	AddSession();
+
+	const FAccelByteModelsV2MatchmakingBackfillProposalNotif FirstProposal = MakeProposal({ TEXT("usera"), TEXT("userb") });
+	BackfillManager->HandleProposal(FirstProposal);
+	Check(Contexts.Num() == 1 && Contexts.Last().SessionName == SessionName && Contexts.Last().ProposedNewPlayers == 2 && Contexts.Last().GetOpenSlots() == MaxPlayers, TEXT("first proposal is evaluated against every slot"));
+
+	const FAccelByteModelsV2MatchmakingBackfillProposalNotif SecondProposal = MakeProposal({ TEXT("userc"), TEXT("userd") });
+	BackfillManager->HandleProposal(SecondProposal);
+	Check(Contexts.Num() == 2 && Contexts.Last().ReservedPlayers == 2 && Contexts.Last().GetOpenSlots() == MaxPlayers - 2, TEXT("deferred players hold their slots while the game decides"));
+
+	BackfillManager->HandleProposal(MakeProposal({ TEXT("usere") }));
+	Check(Contexts.Num() == 3 && Contexts.Last().GetOpenSlots() == 0 && !Contexts.Last().bFitsCapacity, TEXT("proposal does not fit once deferred proposals hold every slot"));
+
+	// Rejecting a deferred proposal gives its slots back, while the other two deferred proposals keep theirs
+	BackfillManager->OnDeferredProposalDecided(SessionName, FirstProposal.ProposalID, false);
+	BackfillManager->HandleProposal(MakeProposal({ TEXT("usera") }));
+	Check(Contexts.Num() == 4 && Contexts.Last().ReservedPlayers == 3 && Contexts.Last().ProposedNewPlayers == 1, TEXT("rejected proposal gives its slots back"));
+
+	// Accepting a deferred proposal keeps its players' slots, so they are not counted as new players again
+	BackfillManager->OnDeferredProposalDecided(SessionName, SecondProposal.ProposalID, true);
+	BackfillManager->HandleProposal(MakeProposal({ TEXT("userc"), TEXT("userf") }));
+	Check(Contexts.Num() == 5 && Contexts.Last().ProposedNewPlayers == 1 && Contexts.Last().Teams.Num() == 1 && Contexts.Last().Teams[0].CurrentPlayers == 1, TEXT("accepted proposal keeps holding its slots"));
+
+	// Removing the session must drop everything held for it, so a new session with the same name starts out empty
+	SessionInterface->RemoveNamedSession(SessionName);
+	AddSession();
+	BackfillManager->HandleProposal(MakeProposal({ TEXT("usera") }));
+	Check(Contexts.Num() == 6 && Contexts.Last().ReservedPlayers == 0 && Contexts.Last().GetOpenSlots() == MaxPlayers, TEXT("removing the session drops its reservations"));
+
+	// Team sizes come from the session's match pool, not from how many teams the proposal happens to list. A proposal
+	// adding to a single team must not give that team every slot in the session.
+	SessionInterface->RemoveNamedSession(SessionName);
+	AddSession();
+	BackfillManager->SetMatchPoolTeamSizes(MatchPool, { 1, 3 });
+	BackfillManager->HandleProposal(MakeProposal({ TEXT("usera"), TEXT("userb") }));
+	Check(Contexts.Num() == 7 && Contexts.Last().Teams.Num() == 1 && Contexts.Last().Teams[0].MaxPlayers == 1 && !Contexts.Last().bFitsCapacity, TEXT("team size comes from the match pool"));
+	BackfillManager->HandleProposal(MakeTeamsProposal({ {}, { TEXT("userc"), TEXT("userd") }, { TEXT("usere") } }));
+	Check(Contexts.Num() == 8 && Contexts.Last().Teams.Num() == 3 && Contexts.Last().Teams[1].MaxPlayers == 3 && Contexts.Last().Teams[2].MaxPlayers == 3, TEXT("teams past the configured sizes use the last size"));
+	BackfillManager->SetMatchPoolTeamSizes(MatchPool, {});
+
+	Check(BackfillManager->GetMetrics().ProposalsDeferred - DeferredBefore == static_cast<uint64>(Contexts.Num()), TEXT("every deferred proposal is counted"));
+
+	SessionInterface->RemoveNamedSession(SessionName);
+	BackfillManager->SetPolicy(nullptr);
+	BackfillManager->SetEnabled(bWasEnabled);
+
+	return ReportResult(TEXT("FExecTestBackfillManager"));
+}
+
+#endif
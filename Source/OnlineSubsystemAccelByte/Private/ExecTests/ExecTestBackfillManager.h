@@ -0,0 +1,33 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for FOnlineBackfillManagerAccelByte, deferring proposals for a local session to the game and checking that
+ * deferred players hold their slots until the game decides, that rejecting gives the slots back, that removing the
+ * session drops its backfill state, and that team sizes come from the session's match pool.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST BACKFILL MANAGER
+ */
+class FExecTestBackfillManager : public FExecTestBase, public TSharedFromThis<FExecTestBackfillManager>
+{
+public:
+
+	/**
+	 * Constructs an instance of the backfill manager test case.
+	 */
+	FExecTestBackfillManager(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
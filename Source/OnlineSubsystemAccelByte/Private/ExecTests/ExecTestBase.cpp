@@ -0,0 +1,68 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestBase.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+namespace
+{
+	void PollUntil(FOnlineSubsystemAccelByte* Subsystem, const TFunction<bool()>& Condition, const TFunction<void(bool)>& OnComplete, double TimeoutAtSeconds)
+	{
+		if (Condition())
+		{
+			OnComplete(true);
+			return;
+		}
+
+		if (FPlatformTime::Seconds() >= TimeoutAtSeconds)
+		{
+			OnComplete(false);
+			return;
+		}
+
+		Subsystem->ExecuteNextTick([Subsystem, Condition, OnComplete, TimeoutAtSeconds]() {
+			PollUntil(Subsystem, Condition, OnComplete, TimeoutAtSeconds);
+		});
+	}
+}
+
+bool FExecTestBase::Check(bool bCondition, const TCHAR* Description)
+{
+	if (!bCondition)
+	{
+		UE_LOG_AB(Error, TEXT("Exec test check failed: %s"), Description);
+		bAllChecksPassed = false;
+	}
+	return bCondition;
+}
+
+bool FExecTestBase::ReportResult(const TCHAR* TestName) const
+{
+	if (bAllChecksPassed)
+	{
+		UE_LOG_AB(Log, TEXT("%s passed"), TestName);
+	}
+	else
+	{
+		UE_LOG_AB(Error, TEXT("%s failed"), TestName);
+	}
+	return bAllChecksPassed;
+}
+
+void FExecTestBase::WaitUntil(const TFunction<bool()>& Condition, const TFunction<void(bool)>& OnComplete, float TimeoutSeconds) const
+{
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	if (Subsystem == nullptr)
+	{
+		OnComplete(Condition());
+		return;
+	}
+
+	PollUntil(Subsystem, Condition, OnComplete, FPlatformTime::Seconds() + TimeoutSeconds);
+}
+
+#endif
@@ -56,6 +56,36 @@ public:
 
 protected:
 
+	/**
+	 * Record the result of a single check made by this test, logging the description as an error if it failed.
+	 *
+	 * @param bCondition Result of the check, false marks the whole test as failed
+	 * @param Description Short description of what was expected, logged on failure
+	 * @return the value of bCondition, so that checks that depend on this one can be skipped
+	 */
+	bool Check(bool bCondition, const TCHAR* Description);
+
+	/**
+	 * Log whether every check made by this test has passed.
+	 *
+	 * @param TestName Name of the test to log the result for
+	 * @return true if every check passed, false otherwise
+	 */
+	bool ReportResult(const TCHAR* TestName) const;
+
+	/**
+	 * Check a condition once per tick until it holds or the timeout passes, for tests that wait on connections or other
+	 * work that completes on later ticks.
+	 *
+	 * @param Condition Checked on the game thread each tick, starting with the current one
+	 * @param OnComplete Called on the game thread once, with true if the condition held or false if the timeout passed
+	 * @param TimeoutSeconds Seconds to keep checking the condition for
+	 */
+	void WaitUntil(const TFunction<bool()>& Condition, const TFunction<void(bool)>& OnComplete, float TimeoutSeconds) const;
+
+	/** Whether every check made through Check has passed so far */
+	bool bAllChecksPassed = true;
+
 	/** World associated with this exec test */
 	UWorld* World;
 
@@ -0,0 +1,263 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestChatRoomMembership.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineChatInterfaceAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Math/RandomStream.h"
+
+FExecTestChatRoomMembership::FExecTestChatRoomMembership(UWorld* InWorld, const FName& InSubsystemName, int32 InMembersPerRoom, int32 InRoomCount)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, MembersPerRoom(FMath::Max(InMembersPerRoom, 2))
+	, RoomCount(FMath::Max(InRoomCount, 3))
+{
+}
+
+bool FExecTestChatRoomMembership::Run()
+{
+	bIsComplete = true;
+
+	// Use a separate chat interface from the subsystem's one, so that the test does not touch any real cached topics
+	const TSharedRef<FOnlineChatAccelByte, ESPMode::ThreadSafe> Chat = MakeShared<FOnlineChatAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+
+	const auto MakeMemberId = [](int32 Index) {
+		return FString::Printf(TEXT("exectest-chat-member-%d"), Index);
+	};
+	const auto MakeTopicId = [](int32 Index) {
+		return FString::Printf(TEXT("exectest-chat-room-%d"), Index);
+	};
+
+	// Every room shares the same members, except for the last room which only has the first half of them. That way a
+	// member from the second half should be in every room but one.
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 RoomIndex = 0; RoomIndex < RoomCount; RoomIndex++)
+	{
+		FAccelByteModelsChatTopicQueryData TopicData;
+		TopicData.TopicId = MakeTopicId(RoomIndex);
+
+		const int32 RoomMemberCount = RoomIndex == RoomCount - 1 ? MembersPerRoom / 2 : MembersPerRoom;
+		TopicData.Members.Reserve(RoomMemberCount);
+		for (int32 MemberIndex = 0; MemberIndex < RoomMemberCount; MemberIndex++)
+		{
+			TopicData.Members.Add(MakeMemberId(MemberIndex));
+		}
+
+		FAccelByteChatRoomInfoRef ChatRoomInfo = FAccelByteChatRoomInfo::Create();
+		ChatRoomInfo->SetTopicData(TopicData);
+		Chat->AddTopic(ChatRoomInfo);
+	}
+	const double CacheSeconds = FPlatformTime::Seconds() - StartTime;
+
+	FAccelByteUniqueIdComposite CompositeId;
+	CompositeId.Id = MakeMemberId(MembersPerRoom - 1);
+	const FUniqueNetIdAccelByteUserRef LastMemberId = FUniqueNetIdAccelByteUser::Create(CompositeId);
+
+	// Look up joined rooms and membership for every member, which would be quadratic in room size with a linear scan
+	StartTime = FPlatformTime::Seconds();
+	int32 MembershipHits = 0;
+	for (int32 MemberIndex = 0; MemberIndex < MembersPerRoom; MemberIndex++)
+	{
+		if (Chat->IsJoinedTopic(MakeMemberId(MemberIndex), MakeTopicId(0)))
+		{
+			MembershipHits++;
+		}
+	}
+	TArray<FChatRoomId> JoinedRooms;
+	Chat->GetJoinedRooms(LastMemberId.Get(), JoinedRooms);
+	const double LookupSeconds = FPlatformTime::Seconds() - StartTime;
+
+	Check(MembershipHits == MembersPerRoom, TEXT("every member is found in the first room"));
+	Check(JoinedRooms.Num() == RoomCount - 1, TEXT("member is joined to every room they were added to"));
+	Check(!JoinedRooms.Contains(MakeTopicId(RoomCount - 1)), TEXT("member is not joined to a room they were not added to"));
+	Check(!Chat->IsJoinedTopic(MakeMemberId(MembersPerRoom), MakeTopicId(0)), TEXT("unknown user is not a member"));
+
+	// Adding and removing members as notifications would should keep both the room and the joined room index in sync
+	StartTime = FPlatformTime::Seconds();
+	Chat->AddMemberToTopic(LastMemberId->GetAccelByteId(), MakeTopicId(RoomCount - 1));
+	Chat->AddMemberToTopic(LastMemberId->GetAccelByteId(), MakeTopicId(RoomCount - 1));
+	JoinedRooms.Empty();
+	Chat->GetJoinedRooms(LastMemberId.Get(), JoinedRooms);
+	Check(JoinedRooms.Num() == RoomCount, TEXT("added member is joined to the new room"));
+
+	const FAccelByteChatRoomInfoPtr LastRoom = Chat->GetTopic(MakeTopicId(RoomCount - 1));
+	Check(LastRoom.IsValid() && LastRoom->GetMembers().Num() == MembersPerRoom / 2 + 1, TEXT("adding the same member twice only adds them once"));
+
+	for (int32 MemberIndex = 0; MemberIndex < MembersPerRoom; MemberIndex += 2)
+	{
+		Chat->RemoveMemberFromTopic(MakeMemberId(MemberIndex), MakeTopicId(0));
+	}
+	const double UpdateSeconds = FPlatformTime::Seconds() - StartTime;
+
+	const FAccelByteChatRoomInfoPtr FirstRoom = Chat->GetTopic(MakeTopicId(0));
+	Check(FirstRoom.IsValid() && FirstRoom->GetMembers().Num() == MembersPerRoom / 2, TEXT("removed members leave the room"));
+	Check(!Chat->IsJoinedTopic(MakeMemberId(0), MakeTopicId(0)), TEXT("removed member is no longer a member"));
+	Check(Chat->IsJoinedTopic(MakeMemberId(1), MakeTopicId(0)), TEXT("remaining member is still a member"));
+
+	bool bAllRemainingMembersFound = FirstRoom.IsValid();
+	if (FirstRoom.IsValid())
+	{
+		for (const FString& MemberId : FirstRoom->GetMembers())
+		{
+			bAllRemainingMembersFound &= FirstRoom->HasMember(MemberId);
+		}
+	}
+	Check(bAllRemainingMembersFound, TEXT("members moved by a removal are still found"));
+
+	// Removing a topic should drop it from the joined rooms of all of its members
+	Chat->RemoveTopic(MakeTopicId(1));
+	JoinedRooms.Empty();
+	Chat->GetJoinedRooms(LastMemberId.Get(), JoinedRooms);
+	Check(JoinedRooms.Num() == RoomCount - 1 && !JoinedRooms.Contains(MakeTopicId(1)), TEXT("removed topic is no longer joined"));
+
+	// Re-adding a topic that is already cached should replace its members rather than add to them
+	FAccelByteModelsChatTopicQueryData ReplacementTopicData;
+	ReplacementTopicData.TopicId = MakeTopicId(2);
+	ReplacementTopicData.Members.Add(MakeMemberId(0));
+	FAccelByteChatRoomInfoRef ReplacementRoom = FAccelByteChatRoomInfo::Create();
+	ReplacementRoom->SetTopicData(ReplacementTopicData);
+	Chat->AddTopic(ReplacementRoom);
+	JoinedRooms.Empty();
+	Chat->GetJoinedRooms(LastMemberId.Get(), JoinedRooms);
+	Check(!JoinedRooms.Contains(MakeTopicId(2)), TEXT("replaced topic drops its old members"));
+
+	UE_LOG_AB(Log, TEXT("FExecTestChatRoomMembership with %d room(s) of %d member(s): cached in %.3f ms, looked up in %.3f ms, updated in %.3f ms"), RoomCount, MembersPerRoom, CacheSeconds * 1000.0, LookupSeconds * 1000.0, UpdateSeconds * 1000.0);
+
+	for (int32 RoomIndex = 0; RoomIndex < RoomCount; RoomIndex++)
+	{
+		Chat->RemoveTopic(MakeTopicId(RoomIndex));
+	}
+
+	// Backend data can list a member twice, which must not leave a second copy behind once the first is removed
+	const FString DuplicateTopicId = TEXT("exectest-chat-room-duplicates");
+	FAccelByteModelsChatTopicQueryData DuplicateTopicData;
+	DuplicateTopicData.TopicId = DuplicateTopicId;
+	DuplicateTopicData.Members = { MakeMemberId(0), MakeMemberId(1), MakeMemberId(0) };
+	FAccelByteChatRoomInfoRef DuplicateRoom = FAccelByteChatRoomInfo::Create();
+	DuplicateRoom->SetTopicData(DuplicateTopicData);
+	Chat->AddTopic(DuplicateRoom);
+	Check(DuplicateRoom->GetMembers().Num() == 2, TEXT("member listed twice by the backend is only cached once"));
+	Chat->RemoveMemberFromTopic(MakeMemberId(0), DuplicateTopicId);
+	Check(!DuplicateRoom->HasMember(MakeMemberId(0)) && !Chat->IsJoinedTopic(MakeMemberId(0), DuplicateTopicId), TEXT("member listed twice by the backend is fully removed"));
+	Chat->RemoveTopic(DuplicateTopicId);
+
+	// Churn members through a handful of small rooms at random, as a stream of join and leave notifications and topic
+	// re-queries would, and compare both indexes against a plain model after every step
+	constexpr int32 ChurnRoomCount = 4;
+	constexpr int32 ChurnUserCount = 32;
+	constexpr int32 ChurnSteps = 2000;
+	FRandomStream Random(0x41);
+	TArray<TSet<FString>> ModelRoomMembers;
+	ModelRoomMembers.SetNum(ChurnRoomCount);
+	TArray<FUniqueNetIdAccelByteUserRef> ChurnUserIds;
+	for (int32 UserIndex = 0; UserIndex < ChurnUserCount; UserIndex++)
+	{
+		FAccelByteUniqueIdComposite ChurnCompositeId;
+		ChurnCompositeId.Id = FString::Printf(TEXT("exectest-chat-churn-member-%d"), UserIndex);
+		ChurnUserIds.Add(FUniqueNetIdAccelByteUser::Create(ChurnCompositeId));
+	}
+	const auto MakeChurnTopicId = [](int32 Index) {
+		return FString::Printf(TEXT("exectest-chat-churn-room-%d"), Index);
+	};
+	for (int32 RoomIndex = 0; RoomIndex < ChurnRoomCount; RoomIndex++)
+	{
+		FAccelByteModelsChatTopicQueryData TopicData;
+		TopicData.TopicId = MakeChurnTopicId(RoomIndex);
+		FAccelByteChatRoomInfoRef ChatRoomInfo = FAccelByteChatRoomInfo::Create();
+		ChatRoomInfo->SetTopicData(TopicData);
+		Chat->AddTopic(ChatRoomInfo);
+	}
+
+	int32 FirstMismatchStep = INDEX_NONE;
+	for (int32 Step = 0; Step < ChurnSteps && FirstMismatchStep == INDEX_NONE; Step++)
+	{
+		const int32 RoomIndex = Random.RandRange(0, ChurnRoomCount - 1);
+		const FString TopicId = MakeChurnTopicId(RoomIndex);
+		const FString UserId = ChurnUserIds[Random.RandRange(0, ChurnUserCount - 1)]->GetAccelByteId();
+		const int32 Action = Random.RandRange(0, 19);
+		if (Action == 0)
+		{
+			// Topic queried again, replacing its members with a random subset
+			FAccelByteModelsChatTopicQueryData TopicData;
+			TopicData.TopicId = TopicId;
+			ModelRoomMembers[RoomIndex].Empty();
+			for (const FUniqueNetIdAccelByteUserRef& ChurnUserId : ChurnUserIds)
+			{
+				if (Random.FRand() < 0.5f)
+				{
+					TopicData.Members.Add(ChurnUserId->GetAccelByteId());
+					ModelRoomMembers[RoomIndex].Add(ChurnUserId->GetAccelByteId());
+				}
+			}
+			FAccelByteChatRoomInfoRef ChatRoomInfo = FAccelByteChatRoomInfo::Create();
+			ChatRoomInfo->SetTopicData(TopicData);
+			Chat->AddTopic(ChatRoomInfo);
+		}
+		else if (Action < 10)
+		{
+			Chat->AddMemberToTopic(UserId, TopicId);
+			ModelRoomMembers[RoomIndex].Add(UserId);
+		}
+		else
+		{
+			Chat->RemoveMemberFromTopic(UserId, TopicId);
+			ModelRoomMembers[RoomIndex].Remove(UserId);
+		}
+
+		bool bMatchesModel = true;
+		for (int32 CheckRoomIndex = 0; CheckRoomIndex < ChurnRoomCount; CheckRoomIndex++)
+		{
+			const FAccelByteChatRoomInfoPtr Room = Chat->GetTopic(MakeChurnTopicId(CheckRoomIndex));
+			const TSet<FString>& ModelMembers = ModelRoomMembers[CheckRoomIndex];
+			bMatchesModel &= Room.IsValid() && Room->GetMembers().Num() == ModelMembers.Num();
+			if (Room.IsValid())
+			{
+				for (const FString& MemberId : Room->GetMembers())
+				{
+					bMatchesModel &= ModelMembers.Contains(MemberId) && Room->HasMember(MemberId);
+				}
+				for (const FString& MemberId : ModelMembers)
+				{
+					bMatchesModel &= Room->GetMembers().Contains(MemberId);
+				}
+			}
+		}
+		for (const FUniqueNetIdAccelByteUserRef& ChurnUserId : ChurnUserIds)
+		{
+			TArray<FChatRoomId> ChurnJoinedRooms;
+			Chat->GetJoinedRooms(ChurnUserId.Get(), ChurnJoinedRooms);
+			int32 ExpectedJoinedRooms = 0;
+			for (int32 CheckRoomIndex = 0; CheckRoomIndex < ChurnRoomCount; CheckRoomIndex++)
+			{
+				const bool bIsModelMember = ModelRoomMembers[CheckRoomIndex].Contains(ChurnUserId->GetAccelByteId());
+				ExpectedJoinedRooms += bIsModelMember ? 1 : 0;
+				bMatchesModel &= ChurnJoinedRooms.Contains(MakeChurnTopicId(CheckRoomIndex)) == bIsModelMember;
+			}
+			bMatchesModel &= ChurnJoinedRooms.Num() == ExpectedJoinedRooms;
+		}
+
+		if (!bMatchesModel)
+		{
+			FirstMismatchStep = Step;
+		}
+	}
+	if (!Check(FirstMismatchStep == INDEX_NONE, TEXT("room members and joined rooms match a plain model through random churn")))
+	{
+		UE_LOG_AB(Warning, TEXT("FExecTestChatRoomMembership churn first diverged from the model at step %d"), FirstMismatchStep);
+	}
+
+	for (int32 RoomIndex = 0; RoomIndex < ChurnRoomCount; RoomIndex++)
+	{
+		Chat->RemoveTopic(MakeChurnTopicId(RoomIndex));
+	}
+	TArray<FChatRoomId> LeftoverRooms;
+	Chat->GetJoinedRooms(ChurnUserIds[0].Get(), LeftoverRooms);
+	Check(LeftoverRooms.Num() == 0, TEXT("removing every topic empties the joined room index"));
+
+	return ReportResult(TEXT("FExecTestChatRoomMembership"));
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for chat room membership caching, filling a chat interface with large rooms and checking that membership
+ * checks, joined room lookups and member updates stay correct. Then churns members through small rooms at random and
+ * compares the room and joined room indexes against a plain model after every step. Uses its own chat interface and
+ * cached topics only, so no chat connection is needed.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST CHAT MEMBERSHIP <optional members per room, defaults to 10000> <optional room count, defaults to 10>
+ */
+class FExecTestChatRoomMembership : public FExecTestBase, public TSharedFromThis<FExecTestChatRoomMembership>
+{
+public:
+
+	/**
+	 * Constructs an instance of the chat room membership test case.
+	 * 
+	 * @param MembersPerRoom Amount of members to add to each room
+	 * @param RoomCount Amount of rooms to cache
+	 */
+	FExecTestChatRoomMembership(UWorld* InWorld, const FName& InSubsystemName, int32 InMembersPerRoom, int32 InRoomCount);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Amount of members to add to each room */
+	int32 MembersPerRoom;
+
+	/** Amount of rooms to cache */
+	int32 RoomCount;
+
+};
+
+#endif
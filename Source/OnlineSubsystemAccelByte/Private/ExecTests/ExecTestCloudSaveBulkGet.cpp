@@ -0,0 +1,311 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestCloudSaveBulkGet.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineCloudSaveInterfaceAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+#include "AsyncTasks/CloudSave/OnlineAsyncTaskAccelByteBulkGetPublicUserRecord.h"
+#include "ExecTestBackendOverrides.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Times to race a failing chunk against the last successful one */
+	constexpr int32 RaceIterations = 200;
+
+	/** Chunk requests sent by a bulk get task that the test has not answered yet */
+	struct FPendingChunks
+	{
+		FCriticalSection Lock;
+
+		/** Chunks waiting for an answer, as pairs of key and user IDs, in the order they were sent */
+		TArray<TPair<FString, TArray<FString>>> Chunks;
+
+		/** Every user requested for each key, including duplicates */
+		TMap<FString, TArray<FString>> RequestedUserIds;
+
+		/** Amount of chunks sent so far */
+		int32 SentCount = 0;
+
+		/** Most chunks waiting for an answer at once */
+		int32 PeakInFlight = 0;
+
+		void OnChunkSent(const FString& Key, const TArray<FString>& ChunkUserIds)
+		{
+			FScopeLock ScopeLock(&Lock);
+			Chunks.Emplace(Key, ChunkUserIds);
+			RequestedUserIds.FindOrAdd(Key).Append(ChunkUserIds);
+			SentCount++;
+			PeakInFlight = FMath::Max(PeakInFlight, Chunks.Num());
+		}
+
+		bool PopChunk(TPair<FString, TArray<FString>>& OutChunk)
+		{
+			FScopeLock ScopeLock(&Lock);
+			if (Chunks.Num() <= 0)
+			{
+				return false;
+			}
+			OutChunk = Chunks[0];
+			Chunks.RemoveAt(0);
+			return true;
+		}
+	};
+
+	using FBulkGetTask = FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord;
+
+	TArray<FString> MakeUserIds(const FString& Prefix, int32 Count)
+	{
+		TArray<FString> UserIds;
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			UserIds.Add(FString::Printf(TEXT("%s-%03d"), *Prefix, Index));
+		}
+		return UserIds;
+	}
+
+	FListAccelByteModelsUserRecord MakeRecords(const FString& Key, const TArray<FString>& UserIds)
+	{
+		FListAccelByteModelsUserRecord Records;
+		for (const FString& RecordUserId : UserIds)
+		{
+			FAccelByteModelsUserRecord& Record = Records.Data.AddDefaulted_GetRef();
+			Record.Key = Key;
+			Record.UserId = RecordUserId;
+			Record.UpdatedAt = FDateTime(2022, 1, 1);
+			Record.Value.JsonObject = MakeShared<FJsonObject>();
+			Record.Value.JsonObject->SetStringField(TEXT("owner"), RecordUserId);
+		}
+		return Records;
+	}
+
+	TUniquePtr<FBulkGetTask> MakeTask(FOnlineSubsystemAccelByte* Subsystem, const FUniqueNetId& LocalUserId, const TArray<FString>& Keys, const TArray<FString>& UserIds, EAccelByteBulkGetPublicUserRecordMode Mode, int32 ChunkSize, int32 MaxConcurrentChunkQueries, FPendingChunks& PendingChunks)
+	{
+		TUniquePtr<FBulkGetTask> Task = MakeUnique<FBulkGetTask>(Subsystem, LocalUserId, Keys, UserIds, Mode);
+		Task->SetChunkLimits(ChunkSize, MaxConcurrentChunkQueries);
+		Subsystem->GetExecTestBackendOverrides().BulkGetPublicUserRecordChunk = [&PendingChunks](const FString& Key, const TArray<FString>& ChunkUserIds) {
+			PendingChunks.OnChunkSent(Key, ChunkUserIds);
+		};
+		return Task;
+	}
+
+	/** Answer the oldest pending chunk, returning false if there was none */
+	bool AnswerChunk(FBulkGetTask& Task, FPendingChunks& PendingChunks, bool bSucceed)
+	{
+		TPair<FString, TArray<FString>> Chunk;
+		if (!PendingChunks.PopChunk(Chunk))
+		{
+			return false;
+		}
+
+		if (bSucceed)
+		{
+			Task.OnBulkGetPublicUserRecordSuccess(MakeRecords(Chunk.Key, Chunk.Value), Chunk.Key);
+		}
+		else
+		{
+			Task.OnBulkGetPublicUserRecordError(500, TEXT("ExecTestCloudSaveBulkGet failure"), Chunk.Key);
+		}
+		return true;
+	}
+}
+
+FExecTestCloudSaveBulkGet::FExecTestCloudSaveBulkGet(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestCloudSaveBulkGet::Run()
+{
+	bIsComplete = true;
+
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	const IOnlineIdentityPtr IdentityInterface = (Subsystem != nullptr) ? Subsystem->GetIdentityInterface() : nullptr;
+	const FOnlineCloudSaveAccelBytePtr CloudSave = (Subsystem != nullptr) ? Subsystem->GetCloudSaveInterface() : nullptr;
+	const TSharedPtr<const FUniqueNetId> LocalUserId = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(0) : nullptr;
+	if (!CloudSave.IsValid() || !LocalUserId.IsValid())
+	{
+		UE_LOG_AB(Error, TEXT("FExecTestCloudSaveBulkGet requires local user 0 to be logged in"));
+		return false;
+	}
+
+	const FString SingleKey = TEXT("exectest-bulk-single");
+	const FString FirstMultipleKey = TEXT("exectest-bulk-first");
+	const FString SecondMultipleKey = TEXT("exectest-bulk-second");
+	const FString PrefetchKey = TEXT("exectest-bulk-prefetch");
+	const FString RaceKey = TEXT("exectest-bulk-race");
+
+	int32 SingleKeyDelegateCount = 0;
+	int32 MultipleKeysDelegateCount = 0;
+	bool bLastDelegateSucceeded = false;
+	FListAccelByteModelsUserRecord SingleKeyRecords;
+	FAccelByteUserRecordsByKey MultipleKeyRecords;
+	FDelegateHandle SingleKeyHandle = CloudSave->AddOnBulkGetPublicUserRecordCompletedDelegate_Handle(0, FOnBulkGetPublicUserRecordCompletedDelegate::CreateLambda(
+		[&](int32, const FOnlineError& Result, const FListAccelByteModelsUserRecord& Records) {
+			SingleKeyDelegateCount++;
+			bLastDelegateSucceeded = Result.bSucceeded;
+			SingleKeyRecords = Records;
+		}));
+	FDelegateHandle MultipleKeysHandle = CloudSave->AddOnBulkGetPublicUserRecordsCompletedDelegate_Handle(0, FOnBulkGetPublicUserRecordsCompletedDelegate::CreateLambda(
+		[&](int32, const FOnlineError& Result, const FAccelByteUserRecordsByKey& Records) {
+			MultipleKeysDelegateCount++;
+			bLastDelegateSucceeded = Result.bSucceeded;
+			MultipleKeyRecords = Records;
+		}));
+
+	// Single key: 45 users with the first five repeated, and the first five already fresh in the cache
+	{
+		const TArray<FString> UniqueUserIds = MakeUserIds(TEXT("exectest-bulk-single-user"), 45);
+		TArray<FString> UserIds = UniqueUserIds;
+		UserIds.Append(TArray<FString>(UniqueUserIds.GetData(), 5));
+
+		TSet<FString> CachedUserIds;
+		if (CloudSave->IsUserRecordCacheEnabled())
+		{
+			const FListAccelByteModelsUserRecord CachedRecords = MakeRecords(SingleKey, TArray<FString>(UniqueUserIds.GetData(), 5));
+			for (const FAccelByteModelsUserRecord& Record : CachedRecords.Data)
+			{
+				CloudSave->AddUserRecordToCache(Record.UserId, SingleKey, true, Record);
+				CachedUserIds.Add(Record.UserId);
+			}
+		}
+
+		FPendingChunks PendingChunks;
+		const TUniquePtr<FBulkGetTask> Task = MakeTask(Subsystem, *LocalUserId, { SingleKey }, UserIds, EAccelByteBulkGetPublicUserRecordMode::SingleKey, 10, 2, PendingChunks);
+		Task->Initialize();
+		Check(PendingChunks.SentCount == 2, TEXT("single key: only the concurrent chunk limit is sent up front"));
+
+		int32 AnsweredCount = 0;
+		while (AnswerChunk(*Task, PendingChunks, true) && AnsweredCount < 100)
+		{
+			AnsweredCount++;
+		}
+
+		const TArray<FString>& RequestedUserIds = PendingChunks.RequestedUserIds.FindRef(SingleKey);
+		const TSet<FString> UniqueRequestedUserIds(RequestedUserIds);
+		Check(RequestedUserIds.Num() == UniqueRequestedUserIds.Num(), TEXT("single key: repeated users are only requested once"));
+		Check(RequestedUserIds.Num() + CachedUserIds.Num() == UniqueUserIds.Num(), TEXT("single key: only users without a fresh cached record are requested"));
+		Check(!CachedUserIds.Array().ContainsByPredicate([&UniqueRequestedUserIds](const FString& CachedUserId) { return UniqueRequestedUserIds.Contains(CachedUserId); }), TEXT("single key: fresh cached users are not requested"));
+		Check(PendingChunks.SentCount == FMath::DivideAndRoundUp(RequestedUserIds.Num(), 10), TEXT("single key: users are split into full chunks"));
+		Check(PendingChunks.PeakInFlight <= 2, TEXT("single key: chunks in flight never pass the concurrent limit"));
+		Check(Task->IsDone() && Task->WasSuccessful(), TEXT("single key: task succeeds once every chunk is answered"));
+
+		Task->TriggerDelegates();
+		Check(SingleKeyDelegateCount == 1 && MultipleKeysDelegateCount == 0, TEXT("single key: only the single key delegate fires"));
+		Check(bLastDelegateSucceeded && SingleKeyRecords.Data.Num() == UniqueUserIds.Num(), TEXT("single key: records from cache and backend are both returned"));
+	}
+
+	// Multiple keys: three chunks per key, where the second chunk fails while the third is still in flight
+	{
+		const TArray<FString> UserIds = MakeUserIds(TEXT("exectest-bulk-multiple-user"), 30);
+		FPendingChunks PendingChunks;
+		const TUniquePtr<FBulkGetTask> Task = MakeTask(Subsystem, *LocalUserId, { FirstMultipleKey, SecondMultipleKey }, UserIds, EAccelByteBulkGetPublicUserRecordMode::MultipleKeys, 10, 2, PendingChunks);
+		Task->Initialize();
+
+		AnswerChunk(*Task, PendingChunks, true);
+		Check(PendingChunks.SentCount == 3, TEXT("multiple keys: an answered chunk makes room for the next"));
+		AnswerChunk(*Task, PendingChunks, false);
+		Check(Task->IsDone() && !Task->WasSuccessful(), TEXT("multiple keys: a failed chunk fails the task"));
+		AnswerChunk(*Task, PendingChunks, true);
+		Check(PendingChunks.SentCount == 3 && PendingChunks.Chunks.Num() == 0, TEXT("multiple keys: queued chunks are dropped after a failure"));
+		Check(!PendingChunks.RequestedUserIds.Contains(SecondMultipleKey), TEXT("multiple keys: keys are requested in order"));
+
+		FAccelByteModelsUserRecord CachedRecord;
+		const TArray<FString>& FirstKeyUserIds = PendingChunks.RequestedUserIds.FindRef(FirstMultipleKey);
+		Check(!CloudSave->IsUserRecordCacheEnabled() || (FirstKeyUserIds.Num() == 30 && CloudSave->GetUserRecordFromCache(FirstMultipleKey, FirstKeyUserIds.Last(), true, CachedRecord)), TEXT("multiple keys: chunks answered after a failure are still cached"));
+
+		Task->TriggerDelegates();
+		Check(SingleKeyDelegateCount == 1 && MultipleKeysDelegateCount == 1, TEXT("multiple keys: only the multiple keys delegate fires"));
+		Check(!bLastDelegateSucceeded, TEXT("multiple keys: the delegate reports the failure"));
+		const FListAccelByteModelsUserRecord* FirstKeyRecords = MultipleKeyRecords.Find(FirstMultipleKey);
+		Check(FirstKeyRecords != nullptr && FirstKeyRecords->Data.Num() == 20, TEXT("multiple keys: records found before the failure are returned by key"));
+	}
+
+	// Prefetch: records only land in the cache, and no delegates fire
+	{
+		const TArray<FString> UserIds = MakeUserIds(TEXT("exectest-bulk-prefetch-user"), 15);
+		FPendingChunks PendingChunks;
+		const TUniquePtr<FBulkGetTask> Task = MakeTask(Subsystem, *LocalUserId, { PrefetchKey }, UserIds, EAccelByteBulkGetPublicUserRecordMode::Prefetch, 10, 4, PendingChunks);
+		Task->Initialize();
+		Check(PendingChunks.SentCount == 2, TEXT("prefetch: every chunk within the limit is sent at once"));
+		while (AnswerChunk(*Task, PendingChunks, true))
+		{
+		}
+		Check(Task->IsDone() && Task->WasSuccessful(), TEXT("prefetch: task succeeds once every chunk is answered"));
+
+		FAccelByteModelsUserRecord CachedRecord;
+		Check(!CloudSave->IsUserRecordCacheEnabled() || CloudSave->GetUserRecordFromCache(PrefetchKey, UserIds.Last(), true, CachedRecord), TEXT("prefetch: records are cached"));
+
+		Task->TriggerDelegates();
+		Check(SingleKeyDelegateCount == 1 && MultipleKeysDelegateCount == 1, TEXT("prefetch: no delegates fire"));
+	}
+
+	// Race a failing chunk against the last successful one on separate threads, the task must fail and complete only once
+	{
+		const TArray<FString> UserIds = MakeUserIds(TEXT("exectest-bulk-race-user"), 2);
+		int32 RaceFailures = 0;
+		for (int32 Iteration = 0; Iteration < RaceIterations; Iteration++)
+		{
+			// Drop what the last iteration cached, so that both users are requested again
+			for (const FString& RecordUserId : UserIds)
+			{
+				CloudSave->RemoveUserRecordFromCache(RecordUserId, RaceKey);
+			}
+
+			FPendingChunks PendingChunks;
+			const TUniquePtr<FBulkGetTask> Task = MakeTask(Subsystem, *LocalUserId, { RaceKey }, UserIds, EAccelByteBulkGetPublicUserRecordMode::Prefetch, 1, 2, PendingChunks);
+			Task->Initialize();
+			if (PendingChunks.Chunks.Num() != 2)
+			{
+				RaceFailures++;
+				continue;
+			}
+
+			const TPair<FString, TArray<FString>> SucceedingChunk = PendingChunks.Chunks[0];
+			const TPair<FString, TArray<FString>> FailingChunk = PendingChunks.Chunks[1];
+			ParallelFor(2, [&](int32 Index) {
+				if (Index == 0)
+				{
+					Task->OnBulkGetPublicUserRecordSuccess(MakeRecords(SucceedingChunk.Key, SucceedingChunk.Value), SucceedingChunk.Key);
+				}
+				else
+				{
+					Task->OnBulkGetPublicUserRecordError(500, TEXT("ExecTestCloudSaveBulkGet race"), FailingChunk.Key);
+				}
+			});
+
+			if (!Task->IsDone() || Task->WasSuccessful())
+			{
+				RaceFailures++;
+			}
+		}
+		Check(RaceFailures == 0, TEXT("race: a failing chunk always fails the task, whichever chunk lands last"));
+	}
+
+	Subsystem->GetExecTestBackendOverrides().Reset();
+	CloudSave->ClearOnBulkGetPublicUserRecordCompletedDelegate_Handle(0, SingleKeyHandle);
+	CloudSave->ClearOnBulkGetPublicUserRecordsCompletedDelegate_Handle(0, MultipleKeysHandle);
+
+	// Leave nothing from this test in the cache
+	for (const TPair<FString, FString>& KeyAndPrefix : TArray<TPair<FString, FString>>{
+		{ SingleKey, TEXT("exectest-bulk-single-user") },
+		{ FirstMultipleKey, TEXT("exectest-bulk-multiple-user") },
+		{ SecondMultipleKey, TEXT("exectest-bulk-multiple-user") },
+		{ PrefetchKey, TEXT("exectest-bulk-prefetch-user") },
+		{ RaceKey, TEXT("exectest-bulk-race-user") } })
+	{
+		for (const FString& RecordUserId : MakeUserIds(KeyAndPrefix.Value, 45))
+		{
+			CloudSave->RemoveUserRecordFromCache(RecordUserId, KeyAndPrefix.Key);
+		}
+	}
+
+	return ReportResult(TEXT("FExecTestCloudSaveBulkGet"));
+}
+
+#endif
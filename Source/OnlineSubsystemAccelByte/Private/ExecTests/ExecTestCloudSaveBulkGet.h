@@ -0,0 +1,34 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for bulk public user record fetches, running the task for single key, multiple key and prefetch requests with
+ * the test answering each chunk in place of the backend. Checks that users are de-duplicated and chunked, that no more
+ * than the concurrent chunk limit is in flight, that each mode fires only its own delegates, and that a failing chunk
+ * racing the last successful one completes the task exactly once. Requires local user 0 to be logged in.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST CLOUDSAVE BULK
+ */
+class FExecTestCloudSaveBulkGet : public FExecTestBase, public TSharedFromThis<FExecTestCloudSaveBulkGet>
+{
+public:
+
+	/**
+	 * Constructs an instance of the cloud save bulk get test case.
+	 */
+	FExecTestCloudSaveBulkGet(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
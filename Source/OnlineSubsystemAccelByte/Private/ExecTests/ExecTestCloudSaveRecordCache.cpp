@@ -0,0 +1,102 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestCloudSaveRecordCache.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineCloudSaveInterfaceAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestCloudSaveRecordCache::FExecTestCloudSaveRecordCache(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestCloudSaveRecordCache::Run()
+{
+	bIsComplete = true;
+
+	// Use a separate cloud save interface from the subsystem's one, so that the test does not touch any real cached records
+	const TSharedRef<FOnlineCloudSaveAccelByte, ESPMode::ThreadSafe> CloudSave = MakeShared<FOnlineCloudSaveAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+	CloudSave->SetUserRecordCacheFreshness(60.0);
+
+	const FString RecordUserId = TEXT("exectest-cloudsave-user");
+	const FString Key = TEXT("exectest-loadout");
+
+	FJsonObject Value;
+	Value.SetStringField(TEXT("weapon"), TEXT("sword"));
+	Value.SetNumberField(TEXT("level"), 3);
+
+	FAccelByteModelsUserRecord Record;
+	Record.Key = Key;
+	Record.UserId = RecordUserId;
+	Record.UpdatedAt = FDateTime(2022, 1, 1);
+	Record.Value.JsonObject = MakeShared<FJsonObject>(Value);
+
+	// Nothing is cached to begin with
+	FAccelByteModelsUserRecord OutRecord;
+	Check(CloudSave->LookupUserRecordForRead(RecordUserId, Key, false, OutRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Miss, TEXT("uncached record is a miss"));
+
+	// Fetched records are served from cache within the freshness window, and only for the visibility they were read with
+	CloudSave->AddUserRecordToCache(RecordUserId, Key, false, Record);
+	Check(CloudSave->LookupUserRecordForRead(RecordUserId, Key, false, OutRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Hit, TEXT("fetched record is a hit"));
+	Check(OutRecord.UpdatedAt == Record.UpdatedAt, TEXT("cached record keeps its version"));
+	Check(CloudSave->LookupUserRecordForRead(RecordUserId, Key, true, OutRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Miss, TEXT("private record is not served for a public read"));
+
+	// Revalidating with the same version is counted as unchanged
+	CloudSave->AddUserRecordToCache(RecordUserId, Key, false, Record);
+
+	// Outside of the freshness window the record has to be revalidated, and another client may have replaced it since, so
+	// writing the value we last read has to go to the backend too
+	const FString SameValue = FOnlineCloudSaveAccelByte::SerializeUserRecordValue(Value);
+	CloudSave->SetUserRecordCacheFreshness(0.0);
+	Check(CloudSave->LookupUserRecordForRead(RecordUserId, Key, false, OutRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Stale, TEXT("record outside of freshness window is stale"));
+	Check(!CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, SameValue), TEXT("identical replace of a stale record is not skipped"));
+	CloudSave->SetUserRecordCacheFreshness(60.0);
+
+	// Replacing a fresh record with the value we read is skipped, and any other value is not
+	Check(CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, SameValue), TEXT("identical replace of a fresh record is skipped"));
+
+	FJsonObject NewValue = Value;
+	NewValue.SetNumberField(TEXT("level"), 4);
+	const FString ChangedValue = FOnlineCloudSaveAccelByte::SerializeUserRecordValue(NewValue);
+	Check(!CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, ChangedValue), TEXT("changed replace is not skipped"));
+
+	// A replace invalidates the record, for reads and for skipping replaces, until it is read back from the backend
+	CloudSave->OnUserRecordReplaced(RecordUserId, Key, false);
+	Check(CloudSave->LookupUserRecordForRead(RecordUserId, Key, false, OutRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Stale, TEXT("replaced record is revalidated"));
+	Check(!CloudSave->GetUserRecordFromCache(Key, RecordUserId, false, OutRecord), TEXT("replaced record is not returned from cache"));
+	Check(!CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, ChangedValue), TEXT("replacing with the value just written is not skipped"));
+	Check(!CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, SameValue), TEXT("replacing with the value read before the replace is not skipped"));
+
+	// Replacing an already invalidated record is not counted as another invalidation
+	CloudSave->OnUserRecordReplaced(RecordUserId, Key, false);
+	Check(CloudSave->GetUserRecordCacheMetrics().Invalidations == 1, TEXT("invalidated record is only invalidated once"));
+
+	// Reading the written value back lets replacing it with the same value be skipped again
+	FAccelByteModelsUserRecord ReplacedRecord = Record;
+	ReplacedRecord.UpdatedAt = FDateTime(2022, 1, 2);
+	ReplacedRecord.Value.JsonObject = MakeShared<FJsonObject>(NewValue);
+	CloudSave->AddUserRecordToCache(RecordUserId, Key, false, ReplacedRecord);
+	Check(CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, ChangedValue), TEXT("identical replace of a read back record is skipped"));
+	Check(!CloudSave->IsUserRecordValueUnchanged(RecordUserId, Key, false, SameValue), TEXT("replacing with the previous value is not skipped"));
+
+	// A delete drops the record entirely
+	CloudSave->RemoveUserRecordFromCache(RecordUserId, Key);
+	Check(CloudSave->LookupUserRecordForRead(RecordUserId, Key, false, OutRecord) == FOnlineCloudSaveAccelByte::EUserRecordCacheLookup::Miss, TEXT("deleted record is a miss"));
+
+	const FAccelByteCloudSaveUserRecordCacheMetrics Metrics = CloudSave->GetUserRecordCacheMetrics();
+	Check(Metrics.Hits == 1, TEXT("hits are counted"));
+	Check(Metrics.Misses == 3, TEXT("misses are counted"));
+	Check(Metrics.Revalidations == 2, TEXT("revalidations are counted"));
+	Check(Metrics.UnchangedRevalidations == 1, TEXT("unchanged revalidations are counted"));
+	Check(Metrics.SkippedReplaces == 2, TEXT("skipped replaces are counted"));
+	Check(Metrics.Invalidations == 2, TEXT("invalidations are counted"));
+
+	UE_LOG_AB(Log, TEXT("FExecTestCloudSaveRecordCache finished with %d hit(s), %d miss(es), %d revalidation(s), %d skipped replace(s)"), Metrics.Hits, Metrics.Misses, Metrics.Revalidations, Metrics.SkippedReplaces);
+	return ReportResult(TEXT("FExecTestCloudSaveRecordCache"));
+}
+
+#endif
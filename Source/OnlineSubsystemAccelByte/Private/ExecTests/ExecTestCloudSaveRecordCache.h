@@ -0,0 +1,34 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the CloudSave user record cache, checking freshness, revalidation, invalidation and the hit and miss
+ * metrics. Also checks that a replace is only skipped against a fresh value this client read from the backend, and never
+ * against a stale or invalidated record, or against a value it just wrote. Uses its own cloud save interface and cached
+ * records only, so no backend calls are made.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST CLOUDSAVE CACHE
+ */
+class FExecTestCloudSaveRecordCache : public FExecTestBase, public TSharedFromThis<FExecTestCloudSaveRecordCache>
+{
+public:
+
+	/**
+	 * Constructs an instance of the cloud save record cache test case.
+	 */
+	FExecTestCloudSaveRecordCache(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
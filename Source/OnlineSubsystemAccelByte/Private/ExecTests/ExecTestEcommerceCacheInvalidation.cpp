@@ -0,0 +1,235 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestEcommerceCacheInvalidation.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineEntitlementsInterfaceAccelByte.h"
+#include "OnlineStoreInterfaceV2AccelByte.h"
+#include "OnlineWalletInterfaceAccelByte.h"
+#include "OnlineCacheRefreshDebouncerAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Interfaces/OnlineIdentityInterface.h"
+#include "AsyncTasks/Purchase/OnlineAsyncTaskAccelByteCheckout.h"
+#include "AsyncTasks/Purchase/OnlineAsyncTaskAccelByteRedeemCode.h"
+#include "ExecTestBackendOverrides.h"
+
+FExecTestEcommerceCacheInvalidation::FExecTestEcommerceCacheInvalidation(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestEcommerceCacheInvalidation::Run()
+{
+	bIsComplete = true;
+
+	// Bursts of requests within a window are released together, once, when the window closes
+	FOnlineCacheRefreshDebouncerAccelByte Debouncer(1.0);
+	Debouncer.Schedule(0, TEXT("GOLD"), 10.0);
+	Debouncer.Schedule(0, TEXT("GOLD"), 10.2);
+	Debouncer.Schedule(0, TEXT("GEMS"), 10.4);
+	Debouncer.Schedule(1, TEXT("ItemA"), 10.5);
+	Check(Debouncer.Num() == 3, TEXT("repeated requests for the same entry are coalesced"));
+
+	TMap<int32, TSet<FString>> Refreshes;
+	Check(!Debouncer.Flush(10.9, Refreshes), TEXT("nothing is released before the window closes"));
+	Check(Debouncer.Flush(11.0, Refreshes), TEXT("queued refreshes are released once the window closes"));
+	Check(Refreshes.Num() == 2 && Refreshes.FindRef(0).Num() == 2 && Refreshes.FindRef(1).Contains(TEXT("ItemA")), TEXT("each user gets only the entries queued for them"));
+	Check(Debouncer.Num() == 0, TEXT("the queue is empty after a flush"));
+
+	Refreshes.Reset();
+	Check(!Debouncer.Flush(20.0, Refreshes), TEXT("an empty queue releases nothing"));
+
+	// An empty entry refreshes everything, so it replaces and absorbs item refreshes for the same user
+	Debouncer.Schedule(0, TEXT("ItemA"), 30.0);
+	Debouncer.Schedule(0, TEXT(""), 30.0);
+	Debouncer.Schedule(0, TEXT("ItemB"), 30.9);
+	Check(Debouncer.Num() == 1, TEXT("a full refresh replaces item refreshes"));
+	Check(Debouncer.IsPending(0, TEXT("ItemB")), TEXT("items are pending through a full refresh"));
+	Check(!Debouncer.IsPending(1, TEXT("ItemB")), TEXT("a full refresh only covers its own user"));
+	Check(Debouncer.Flush(31.0, Refreshes), TEXT("later requests in a burst do not extend the window"));
+
+	Debouncer.Schedule(0, TEXT("GOLD"), 40.0);
+	Debouncer.Schedule(0, TEXT("GEMS"), 40.0);
+	Debouncer.Cancel(0, TEXT("GOLD"));
+	Check(!Debouncer.IsPending(0, TEXT("GOLD")) && Debouncer.IsPending(0, TEXT("GEMS")), TEXT("cancelling drops only that entry"));
+	Debouncer.Reset();
+	Check(Debouncer.Num() == 0 && !Debouncer.Flush(50.0, Refreshes), TEXT("reset drops queued refreshes"));
+
+	// Entitlement writes are timestamped per user
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	if (!Check(Subsystem != nullptr, TEXT("the AccelByte subsystem is available")))
+	{
+		return ReportResult(TEXT("FExecTestEcommerceCacheInvalidation"));
+	}
+
+	{
+		const TSharedRef<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> Entitlements = MakeShared<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe>(Subsystem);
+
+		FAccelByteUniqueIdComposite CompositeId;
+		CompositeId.Id = TEXT("ExecTestEcommerceCacheInvalidationUser");
+		const FUniqueNetIdAccelByteUserRef TestUserId = FUniqueNetIdAccelByteUser::Create(CompositeId);
+
+		Check(Entitlements->GetEntitlementsLastUpdatedTime(TestUserId.Get()) == FDateTime::MinValue(), TEXT("a user with nothing cached has no last updated time"));
+
+		const FDateTime BeforeWrite = FDateTime::UtcNow();
+		TSharedRef<FOnlineEntitlement> Entitlement = MakeShared<FOnlineEntitlement>();
+		Entitlement->Id = TEXT("ExecTestEntitlement");
+		Entitlement->ItemId = TEXT("ExecTestItem");
+		Entitlements->AddEntitlementToMap(TestUserId, Entitlement);
+		Check(Entitlements->GetEntitlementsLastUpdatedTime(TestUserId.Get()) >= BeforeWrite, TEXT("writing an entitlement updates the last updated time"));
+		Check(Entitlements->GetItemEntitlement(TestUserId.Get(), TEXT("ExecTestItem")).IsValid(), TEXT("a written entitlement can be read back by item"));
+	}
+
+	// Checkout, redemption and notifications go through the subsystem's own caches, so they need a logged in user
+	const IOnlineIdentityPtr IdentityInterface = Subsystem->GetIdentityInterface();
+	const TSharedPtr<const FUniqueNetId> LocalUserId = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(0) : nullptr;
+	const FOnlineWalletAccelBytePtr Wallet = Subsystem->GetWalletInterface();
+	const TSharedPtr<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe> Entitlements = StaticCastSharedPtr<FOnlineEntitlementsAccelByte>(Subsystem->GetEntitlementsInterface());
+	const FOnlineStoreV2AccelBytePtr Store = StaticCastSharedPtr<FOnlineStoreV2AccelByte>(Subsystem->GetStoreV2Interface());
+	if (!Check(LocalUserId.IsValid() && Wallet.IsValid() && Entitlements.IsValid() && Store.IsValid(), TEXT("local user 0 is logged in to the AccelByte subsystem")))
+	{
+		return ReportResult(TEXT("FExecTestEcommerceCacheInvalidation"));
+	}
+
+	// Currencies, wallets and items that no real namespace uses, removed from the caches again at the end
+	const FString GoldCurrency = TEXT("EXECTESTGOLD");
+	const FString GemsCurrency = TEXT("EXECTESTGEMS");
+	const FString GemsWalletId = TEXT("ExecTestEcommerceGemsWallet");
+	const FString OfferId = TEXT("ExecTestEcommerceOffer");
+	const auto CacheWallet = [&Wallet](const FString& CurrencyCode, const FString& WalletId) {
+		FAccelByteModelsWalletInfo WalletInfo;
+		WalletInfo.Id = WalletId;
+		WalletInfo.CurrencyCode = CurrencyCode;
+		Wallet->AddWalletInfoToList(0, CurrencyCode, MakeShared<FAccelByteModelsWalletInfo>(WalletInfo));
+	};
+	const auto IsWalletServed = [&Wallet](const FString& CurrencyCode) {
+		FAccelByteModelsWalletInfo WalletInfo;
+		return Wallet->GetWalletInfoFromCache(0, CurrencyCode, WalletInfo);
+	};
+	CacheWallet(GoldCurrency, TEXT("ExecTestEcommerceGoldWallet"));
+	CacheWallet(GemsCurrency, GemsWalletId);
+	Check(IsWalletServed(GoldCurrency) && IsWalletServed(GemsCurrency), TEXT("cached wallets are served from the cache"));
+
+	// A fulfilled checkout invalidates the wallet it spent from and the item it granted
+	TArray<FOnlineStoreOfferRef> OriginalOffers;
+	Store->GetOffers(OriginalOffers);
+	FOnlineStoreOfferRef Offer = MakeShared<FOnlineStoreOffer>();
+	Offer->OfferId = OfferId;
+	Offer->NumericPrice = 100;
+	Offer->RegularPrice = 100;
+	Offer->CurrencyCode = GoldCurrency;
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> TestOffers;
+	TestOffers.Add(OfferId, Offer);
+	Store->EmplaceOffers(TestOffers);
+
+	TSharedRef<FAccelByteModelsItemDynamicData> DynamicData = MakeShared<FAccelByteModelsItemDynamicData>();
+	DynamicData->ItemId = OfferId;
+	Store->EmplaceOfferDynamicData(*LocalUserId, DynamicData);
+	Check(Store->IsOfferDynamicDataFresh(*LocalUserId, OfferId), TEXT("the offer's dynamic data is fresh before the checkout"));
+
+	FPurchaseCheckoutRequest CheckoutRequest;
+	CheckoutRequest.AddPurchaseOffer(TEXT(""), OfferId, 1);
+	const TUniquePtr<FOnlineAsyncTaskAccelByteCheckout> CheckoutTask = MakeUnique<FOnlineAsyncTaskAccelByteCheckout>(Subsystem, *LocalUserId, CheckoutRequest, FOnPurchaseCheckoutComplete());
+	FString OrderCurrency;
+	FExecTestBackendOverrides& BackendOverrides = Subsystem->GetExecTestBackendOverrides();
+	BackendOverrides.CreateOrder = [&OrderCurrency](const FAccelByteModelsOrderCreate& OrderRequest) {
+		OrderCurrency = OrderRequest.CurrencyCode;
+	};
+	CheckoutTask->Initialize();
+	Check(OrderCurrency == GoldCurrency, TEXT("the order is sent in the offer's currency"));
+
+	FAccelByteModelsOrderInfo OrderInfo;
+	OrderInfo.OrderNo = TEXT("ExecTestEcommerceOrder");
+	OrderInfo.ItemId = OfferId;
+	OrderInfo.Quantity = 1;
+	OrderInfo.Status = EAccelByteOrderStatus::FULFILLED;
+	CheckoutTask->HandleCheckoutComplete(OrderInfo);
+	CheckoutTask->Finalize();
+	Check(CheckoutTask->WasSuccessful(), TEXT("the checkout completes"));
+	Check(Wallet->IsWalletInfoStale(0, GoldCurrency) && !IsWalletServed(GoldCurrency), TEXT("the wallet spent from by a checkout is stale and not served"));
+	Check(!Wallet->IsWalletInfoStale(0, GemsCurrency) && IsWalletServed(GemsCurrency), TEXT("other wallets are still served after a checkout"));
+	Check(Wallet->RefreshDebouncer.IsPending(0, GoldCurrency), TEXT("a refresh is queued for the wallet spent from"));
+	Check(Entitlements->RefreshDebouncer.IsPending(0, OfferId), TEXT("a refresh is queued for the item granted by a checkout"));
+	Check(!Store->IsOfferDynamicDataFresh(*LocalUserId, OfferId), TEXT("the dynamic data of the ordered offer is stale"));
+
+	CacheWallet(GoldCurrency, TEXT("ExecTestEcommerceGoldWallet"));
+	Check(!Wallet->IsWalletInfoStale(0, GoldCurrency) && IsWalletServed(GoldCurrency), TEXT("a refreshed wallet is served from the cache again"));
+
+	// A redemption invalidates the wallets it credited, which it only identifies by wallet ID
+	FRedeemCodeRequest RedeemCodeRequest;
+	RedeemCodeRequest.Code = TEXT("EXECTESTCODE");
+	const TUniquePtr<FOnlineAsyncTaskAccelByteRedeemCode> RedeemTask = MakeUnique<FOnlineAsyncTaskAccelByteRedeemCode>(Subsystem, *LocalUserId, RedeemCodeRequest, FOnPurchaseRedeemCodeComplete());
+	FString RedeemedCode;
+	BackendOverrides.RedeemCode = [&RedeemedCode](const FString& Code) {
+		RedeemedCode = Code;
+	};
+	RedeemTask->Initialize();
+	Check(RedeemedCode == RedeemCodeRequest.Code, TEXT("the code is sent for redemption"));
+
+	FAccelByteModelsFulfillmentResult FulfillmentResult;
+	FulfillmentResult.CreditSummaries.AddDefaulted_GetRef().WalletId = GemsWalletId;
+	RedeemTask->HandleRedeemCodeComplete(FulfillmentResult);
+	RedeemTask->Finalize();
+	Check(RedeemTask->WasSuccessful(), TEXT("the redemption completes"));
+	Check(Wallet->IsWalletInfoStale(0, GemsCurrency) && !IsWalletServed(GemsCurrency), TEXT("the wallet credited by a redemption is stale and not served"));
+	Check(IsWalletServed(GoldCurrency), TEXT("wallets not credited by a redemption are still served"));
+
+	// A notification topic configured for both caches reaches both, rather than stopping at the wallet
+	CacheWallet(GemsCurrency, GemsWalletId);
+	const FString SharedTopic = TEXT("EXECTEST_ECOMMERCE_UPDATED");
+	Wallet->WalletNotificationTopics.Add(SharedTopic);
+	Entitlements->EntitlementNotificationTopics.Add(SharedTopic);
+
+	FAccelByteModelsNotificationMessage Message;
+	Message.Topic = TEXT("EXECTEST_UNRELATED");
+	Message.Payload = FString::Printf(TEXT("{\"currencyCode\":\"%s\",\"itemId\":\"ExecTestNotifiedItem\"}"), *GemsCurrency);
+	Subsystem->OnMessageNotif(Message, 0);
+	Check(IsWalletServed(GemsCurrency) && !Entitlements->RefreshDebouncer.IsPending(0, TEXT("ExecTestNotifiedItem")), TEXT("unrelated notification topics are ignored"));
+
+	Message.Topic = SharedTopic;
+	Subsystem->OnMessageNotif(Message, 0);
+	Check(Wallet->IsWalletInfoStale(0, GemsCurrency) && !IsWalletServed(GemsCurrency), TEXT("a notification invalidates the wallet it names"));
+	Check(Entitlements->RefreshDebouncer.IsPending(0, TEXT("ExecTestNotifiedItem")), TEXT("the same notification also queues a refresh of the item it names"));
+	Check(IsWalletServed(GoldCurrency), TEXT("wallets not named by a notification are still served"));
+
+	// Leave the subsystem's caches as they were, without sending the queued refreshes of made up entries
+	Wallet->WalletNotificationTopics.Remove(SharedTopic);
+	Entitlements->EntitlementNotificationTopics.Remove(SharedTopic);
+	Wallet->RefreshDebouncer.Cancel(0, GoldCurrency);
+	Wallet->RefreshDebouncer.Cancel(0, GemsCurrency);
+	Entitlements->RefreshDebouncer.Cancel(0, OfferId);
+	Entitlements->RefreshDebouncer.Cancel(0, TEXT("ExecTestNotifiedItem"));
+	{
+		FScopeLock ScopeLock(&Wallet->WalletInfoListLock);
+		for (const FString& CurrencyCode : { GoldCurrency, GemsCurrency })
+		{
+			if (TMap<FString, TSharedRef<FAccelByteModelsWalletInfo>>* WalletInfos = Wallet->UserToWalletInfoMap.Find(LocalUserId.ToSharedRef()))
+			{
+				WalletInfos->Remove(CurrencyCode);
+			}
+			if (TMap<FString, FDateTime>* LastUpdatedTimes = Wallet->UserToWalletLastUpdatedMap.Find(LocalUserId.ToSharedRef()))
+			{
+				LastUpdatedTimes->Remove(CurrencyCode);
+			}
+			if (TSet<FString>* StaleWallets = Wallet->UserToStaleWalletMap.Find(LocalUserId.ToSharedRef()))
+			{
+				StaleWallets->Remove(CurrencyCode);
+			}
+		}
+	}
+
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> OriginalOfferMap;
+	for (const FOnlineStoreOfferRef& OriginalOffer : OriginalOffers)
+	{
+		OriginalOfferMap.Add(OriginalOffer->OfferId, OriginalOffer);
+	}
+	Store->ReplaceOffers(OriginalOfferMap);
+	BackendOverrides.Reset();
+
+	return ReportResult(TEXT("FExecTestEcommerceCacheInvalidation"));
+}
+
+#endif
@@ -0,0 +1,36 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for invalidation of the wallet and entitlement caches, checking that bursts of refresh requests are
+ * coalesced into a single batch per debounce window, that full refreshes replace item refreshes, and that entitlement
+ * writes are timestamped. Then runs a checkout and a code redemption with their backend requests answered by the test,
+ * and sends lobby notifications through the subsystem, checking that each invalidates exactly the wallets and items it
+ * touched and that stale wallets are not served from the cache. Requires local user 0 to be logged in, and removes
+ * the made up wallets, offers and queued refreshes from the subsystem's caches again once done.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST ECOMMERCE INVALIDATION
+ */
+class FExecTestEcommerceCacheInvalidation : public FExecTestBase, public TSharedFromThis<FExecTestEcommerceCacheInvalidation>
+{
+public:
+
+	/**
+	 * Constructs an instance of the e-commerce cache invalidation test case.
+	 */
+	FExecTestEcommerceCacheInvalidation(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
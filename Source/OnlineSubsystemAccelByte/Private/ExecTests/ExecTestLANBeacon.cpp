@@ -0,0 +1,141 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestLANBeacon.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSessionInterfaceV1AccelByte.h"
+#include "FNboSerializeToBufferAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestLANBeacon::FExecTestLANBeacon(UWorld* InWorld, const FName& InSubsystemName, int32 InIterations)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, Iterations(FMath::Max(InIterations, 1))
+{
+}
+
+bool FExecTestLANBeacon::Run()
+{
+	bIsComplete = true;
+
+	// Run against a standalone session interface, so that the beacon cache of any real session is left alone
+	const TSharedRef<FOnlineSessionV1AccelByte, ESPMode::ThreadSafe> SessionInterface = MakeShared<FOnlineSessionV1AccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+
+	FAccelByteUniqueIdComposite OwnerCompositeId;
+	OwnerCompositeId.Id = TEXT("0123456789abcdef0123456789abcdef");
+	OwnerCompositeId.PlatformType = TEXT("STEAM");
+	OwnerCompositeId.PlatformId = TEXT("76561197960287930");
+	const FUniqueNetIdAccelByteUserRef OwnerId = FUniqueNetIdAccelByteUser::Create(OwnerCompositeId);
+
+	FOnlineSessionSettings Settings;
+	Settings.NumPublicConnections = 16;
+	Settings.bIsLANMatch = true;
+	Settings.bShouldAdvertise = true;
+	for (int32 Index = 0; Index < 16; Index++)
+	{
+		Settings.Set(FName(*FString::Printf(TEXT("ADVERTISED_%d"), Index)), FString::Printf(TEXT("value-%d"), Index), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	}
+	for (int32 Index = 0; Index < 4; Index++)
+	{
+		Settings.Set(FName(*FString::Printf(TEXT("HIDDEN_%d"), Index)), Index, EOnlineDataAdvertisementType::DontAdvertise);
+	}
+
+	FNamedOnlineSession Session(FName(TEXT("LANBeaconTest")), Settings);
+	Session.OwningUserId = OwnerId;
+	Session.OwningUserName = TEXT("LANBeaconHost");
+	Session.NumOpenPublicConnections = 12;
+	const TSharedRef<FOnlineSessionInfoAccelByteV1> SessionInfo = MakeShared<FOnlineSessionInfoAccelByteV1>();
+	SessionInfo->SetSessionId(TEXT("fedcba9876543210fedcba9876543210"));
+	Session.SessionInfo = SessionInfo;
+
+	// Time writing beacons, only the first of which should have to encode the advertised settings
+	int32 BytesPerBeacon = 0;
+	TArray<uint8> LastBeacon;
+	double StartTimeInSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		FNboSerializeToBufferAccelByte Packet(LAN_BEACON_MAX_PACKET_SIZE);
+		SessionInterface->AppendSessionToPacket(Packet, &Session);
+		if (Iteration == Iterations - 1)
+		{
+			Check(!Packet.HasOverflow(), TEXT("beacon should fit in a single packet"));
+			BytesPerBeacon = Packet.GetByteCount();
+			LastBeacon.Append(Packet.GetRawBuffer(0), Packet.GetByteCount());
+		}
+	}
+	const double WriteMicroseconds = (FPlatformTime::Seconds() - StartTimeInSeconds) * 1000000.0 / Iterations;
+
+	// Time parsing the beacon back into search results, as a client would for each host that responds
+	FOnlineSessionSearchResult Result;
+	StartTimeInSeconds = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		FNboSerializeFromBufferAccelByte Packet(LastBeacon.GetData(), LastBeacon.Num());
+		const bool bWasRead = SessionInterface->ReadSessionFromPacket(Packet, &Result.Session);
+		Check(Iteration > 0 || (bWasRead && !Packet.HasOverflow()), TEXT("beacon should parse without overflowing"));
+	}
+	const double ParseMicroseconds = (FPlatformTime::Seconds() - StartTimeInSeconds) * 1000000.0 / Iterations;
+
+	FNboSerializeToBufferAccelByte CompositeIdPacket(LAN_BEACON_MAX_PACKET_SIZE);
+	CompositeIdPacket << *OwnerId;
+	FNboSerializeToBufferAccelByte CompactIdPacket(LAN_BEACON_MAX_PACKET_SIZE);
+	CompactIdPacket.WriteCompactUserId(*OwnerId);
+	UE_LOG_AB(Log, TEXT("FExecTestLANBeacon: %d bytes per beacon; owner ID %d bytes, was %d; %.2f us per write; %.2f us per parse over %d iterations"),
+		BytesPerBeacon, CompactIdPacket.GetByteCount(), CompositeIdPacket.GetByteCount(), WriteMicroseconds, ParseMicroseconds, Iterations);
+
+	Check(*Result.Session.OwningUserId == *OwnerId, TEXT("owning user ID should round trip"));
+	Check(Result.Session.OwningUserName == Session.OwningUserName && Result.Session.NumOpenPublicConnections == 12, TEXT("session fields should round trip"));
+	Check(Result.Session.SessionInfo.IsValid() && Result.Session.SessionInfo->GetSessionId().ToString() == SessionInfo->GetSessionId().ToString(), TEXT("session ID should round trip"));
+	Check(Result.Session.SessionSettings.Settings.Num() == 16, TEXT("only advertised settings should be sent"));
+
+	FString ReadValue;
+	Check(Result.Session.SessionSettings.Get(FName(TEXT("ADVERTISED_7")), ReadValue) && ReadValue == TEXT("value-7"), TEXT("advertised setting values should round trip"));
+	Check(FUniqueNetIdAccelByteUser::Invalid()->GetAccelByteId().IsEmpty(), TEXT("parsing should not write into the shared invalid ID"));
+
+	const auto WriteAndReadBack = [&SessionInterface, &Result](FNamedOnlineSession& InSession, const TCHAR* Key, FString& OutValue) {
+		FNboSerializeToBufferAccelByte Packet(LAN_BEACON_MAX_PACKET_SIZE);
+		SessionInterface->AppendSessionToPacket(Packet, &InSession);
+		FNboSerializeFromBufferAccelByte Reader(Packet.GetRawBuffer(0), Packet.GetByteCount());
+		return SessionInterface->ReadSessionFromPacket(Reader, &Result.Session) && Result.Session.SessionSettings.Get(FName(Key), OutValue);
+	};
+
+	// Change a setting in place, as a game would through GetSessionSettings, without updating the session. The next
+	// beacon must still carry the new value.
+	Session.SessionSettings.Set(FName(TEXT("ADVERTISED_7")), FString(TEXT("changed")), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	Check(WriteAndReadBack(Session, TEXT("ADVERTISED_7"), ReadValue) && ReadValue == TEXT("changed"), TEXT("changing a setting in place should invalidate the cached block"));
+
+	// Changing only the advertisement type must also be caught, as it decides whether the setting is sent at all
+	Session.SessionSettings.Set(FName(TEXT("ADVERTISED_3")), FString(TEXT("value-3")), EOnlineDataAdvertisementType::DontAdvertise);
+	Check(!WriteAndReadBack(Session, TEXT("ADVERTISED_3"), ReadValue), TEXT("settings that stop being advertised should leave the cached block"));
+	Session.SessionSettings.Set(FName(TEXT("ADVERTISED_3")), FString(TEXT("value-3")), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+
+	// Updating the session drops the block outright, and the next beacon still carries the current values
+	SessionInterface->InvalidateLANBeaconSettings(Session.SessionName);
+	Check(WriteAndReadBack(Session, TEXT("ADVERTISED_7"), ReadValue) && ReadValue == TEXT("changed"), TEXT("updating the session should invalidate the cached block"));
+
+	// Adding a setting is caught without an update as well
+	Session.SessionSettings.Set(FName(TEXT("ADVERTISED_NEW")), FString(TEXT("added")), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	Check(WriteAndReadBack(Session, TEXT("ADVERTISED_NEW"), ReadValue) && ReadValue == TEXT("added"), TEXT("adding a setting should invalidate the cached block"));
+
+	// Another session with the same amount of settings must get its own block rather than reuse this one
+	FNamedOnlineSession OtherSession(FName(TEXT("LANBeaconTestOther")), Session.SessionSettings);
+	OtherSession.OwningUserId = OwnerId;
+	OtherSession.SessionInfo = SessionInfo;
+	OtherSession.SessionSettings.Set(FName(TEXT("ADVERTISED_7")), FString(TEXT("other")), EOnlineDataAdvertisementType::ViaOnlineServiceAndPing);
+	Check(WriteAndReadBack(OtherSession, TEXT("ADVERTISED_7"), ReadValue) && ReadValue == TEXT("other"), TEXT("sessions should not share cached blocks"));
+	Check(WriteAndReadBack(Session, TEXT("ADVERTISED_7"), ReadValue) && ReadValue == TEXT("changed"), TEXT("cached block should stay with its own session"));
+
+	// A response from a host on another format version should be refused before anything else is read from it
+	FNboSerializeToBufferAccelByte OldVersionPacket(LAN_BEACON_MAX_PACKET_SIZE);
+	SessionInterface->AppendSessionToPacket(OldVersionPacket, &Session);
+	TArray<uint8> OldVersionBeacon(OldVersionPacket.GetRawBuffer(0), OldVersionPacket.GetByteCount());
+	OldVersionBeacon[0] = LAN_BEACON_FORMAT_VERSION - 1;
+	FNboSerializeFromBufferAccelByte OldVersionReader(OldVersionBeacon.GetData(), OldVersionBeacon.Num());
+	Check(!SessionInterface->ReadSessionFromPacket(OldVersionReader, &Result.Session), TEXT("responses with another format version should be refused"));
+
+	return ReportResult(TEXT("FExecTestLANBeacon"));
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Loopback test case for LAN session beacons, writing a hosted session into beacon packets and reading them back
+ * through a standalone V1 session interface. Logs the bytes per beacon along with write and parse times, and checks
+ * that the cached settings block is kept per session, that it is rebuilt whenever an advertised setting is changed in
+ * place or added or the session is updated, and that responses from another format version are refused.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST LAN BEACON <Iterations=1000>
+ */
+class FExecTestLANBeacon : public FExecTestBase, public TSharedFromThis<FExecTestLANBeacon>
+{
+public:
+
+	/**
+	 * Constructs an instance of the LAN beacon test case.
+	 *
+	 * @param InIterations Amount of beacons to write and parse when timing
+	 */
+	FExecTestLANBeacon(UWorld* InWorld, const FName& InSubsystemName, int32 InIterations);
+
+	virtual bool Run() override;
+
+private:
+
+	/**
+	 * Amount of beacons to write and parse when timing
+	 */
+	int32 Iterations;
+
+};
+
+#endif
@@ -0,0 +1,84 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestLobbyNotificationQueue.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineLobbyNotificationQueueAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestLobbyNotificationQueue::FExecTestLobbyNotificationQueue(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestLobbyNotificationQueue::Run()
+{
+	bIsComplete = true;
+
+	// Run against a standalone queue, so that we don't process or disturb real notifications
+	const TSharedRef<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe> Queue = MakeShared<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+	Queue->SetLimits(0.0, 8);
+
+	TArray<FString> HandledNotifications;
+	const auto Enqueue = [&Queue, &HandledNotifications](EAccelByteLobbyNotificationPriority Priority, const FString& Type, const FString& EntityId, bool bCollapse, const FString& Label) {
+		Queue->Enqueue(Priority, Type, EntityId, bCollapse, [&HandledNotifications, Label]() { HandledNotifications.Add(Label); });
+	};
+
+	Enqueue(EAccelByteLobbyNotificationPriority::Low, TEXT("Presence"), TEXT("user-a"), true, TEXT("presence-a-1"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Normal, TEXT("SessionUpdated"), TEXT("session-a"), true, TEXT("session-a-1"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Low, TEXT("Presence"), TEXT("user-a"), true, TEXT("presence-a-2"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Normal, TEXT("SessionUpdated"), TEXT("session-a"), true, TEXT("session-a-2"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Critical, TEXT("Kicked"), TEXT("session-a"), false, TEXT("kicked-a"));
+	Enqueue(EAccelByteLobbyNotificationPriority::High, TEXT("MatchFound"), TEXT("session-b"), false, TEXT("match-b"));
+
+	// Invites are keyed by session and sender, so invites from two players to the same session are both kept
+	Enqueue(EAccelByteLobbyNotificationPriority::Normal, TEXT("InvitedToGameSession"), TEXT("session-c:sender-a"), true, TEXT("invite-c-a"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Normal, TEXT("InvitedToGameSession"), TEXT("session-c:sender-b"), true, TEXT("invite-c-b"));
+
+	Check(Queue->Num() == 6, TEXT("superseded updates for the same entity should collapse"));
+	Queue->ProcessNotifications(0.0);
+
+	const TArray<FString> ExpectedOrder = { TEXT("kicked-a"), TEXT("match-b"), TEXT("session-a-2"), TEXT("invite-c-a"), TEXT("invite-c-b"), TEXT("presence-a-2") };
+	Check(HandledNotifications == ExpectedOrder, TEXT("notifications should be handled in priority order with only the latest update for each entity"));
+
+	// Fill the queue with presence, then queue something more important, which should push out the oldest presence
+	HandledNotifications.Reset();
+	for (int32 Index = 0; Index < 8; Index++)
+	{
+		Enqueue(EAccelByteLobbyNotificationPriority::Low, TEXT("Presence"), FString::Printf(TEXT("user-%d"), Index), true, FString::Printf(TEXT("presence-%d"), Index));
+	}
+	Enqueue(EAccelByteLobbyNotificationPriority::Critical, TEXT("Kicked"), TEXT("party-a"), false, TEXT("kicked-party-a"));
+	Check(Queue->Num() == 8, TEXT("queue should not grow past its limit"));
+
+	// With a budget, at least one notification should be handled each time even if the budget is tiny
+	Check(Queue->ProcessNotifications(0.0000001) >= 1, TEXT("at least one notification should be handled per tick"));
+	Queue->ProcessNotifications(0.0);
+	Check(HandledNotifications.Num() == 8 && HandledNotifications[0] == TEXT("kicked-party-a") && !HandledNotifications.Contains(TEXT("presence-0")), TEXT("a full queue should drop the oldest informational notification"));
+
+	// Fill the queue with state changes only. Nothing may be dropped, so further state changes go past the limit while
+	// further presence is dropped on arrival.
+	HandledNotifications.Reset();
+	for (int32 Index = 0; Index < 8; Index++)
+	{
+		Enqueue(EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyMemberLeave"), FString(), false, FString::Printf(TEXT("leave-%d"), Index));
+	}
+	Enqueue(EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyDataUpdate"), TEXT("party-a"), true, TEXT("party-data-a"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Critical, TEXT("PartyKick"), TEXT("party-a"), false, TEXT("kicked-party-a"));
+	Enqueue(EAccelByteLobbyNotificationPriority::Low, TEXT("Presence"), TEXT("user-a"), true, TEXT("presence-dropped"));
+	Check(Queue->Num() == 10, TEXT("state changing notifications should be queued past the limit rather than dropped"));
+
+	Queue->ProcessNotifications(0.0);
+	Check(HandledNotifications.Num() == 10 && HandledNotifications[0] == TEXT("kicked-party-a") && HandledNotifications.Contains(TEXT("leave-0")) && HandledNotifications.Contains(TEXT("party-data-a")), TEXT("every kick, member leave and party data notification should be handled"));
+	Check(!HandledNotifications.Contains(TEXT("presence-dropped")), TEXT("incoming presence should be dropped when nothing informational is waiting"));
+
+	const FAccelByteLobbyNotificationQueueMetrics Metrics = Queue->GetMetrics();
+	UE_LOG_AB(Log, TEXT("FExecTestLobbyNotificationQueue metrics: enqueued %llu; processed %llu; collapsed %llu; dropped %llu; over limit %llu; peak depth %d"), Metrics.EnqueuedCount, Metrics.ProcessedCount, Metrics.CollapsedCount, Metrics.DroppedCount, Metrics.OverLimitCount, Metrics.PeakQueueDepth);
+	Check(Metrics.CollapsedCount == 2 && Metrics.DroppedCount == 2 && Metrics.OverLimitCount == 2 && Metrics.QueueDepth == 0, TEXT("metrics should count collapsed, dropped and over limit notifications"));
+
+	return ReportResult(TEXT("FExecTestLobbyNotificationQueue"));
+}
+
+#endif
@@ -0,0 +1,33 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for FOnlineLobbyNotificationQueueAccelByte, queueing notifications on a standalone queue and checking that
+ * they are processed in priority order, that superseded updates collapse, and that a full queue only ever drops
+ * informational notifications.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST LOBBYNOTIFICATION QUEUE
+ */
+class FExecTestLobbyNotificationQueue : public FExecTestBase, public TSharedFromThis<FExecTestLobbyNotificationQueue>
+{
+public:
+
+	/**
+	 * Constructs an instance of the lobby notification queue test case.
+	 */
+	FExecTestLobbyNotificationQueue(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
@@ -0,0 +1,104 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestLoginBootstrap.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineLoginBootstrapAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestLoginBootstrap::FExecTestLoginBootstrap(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestLoginBootstrap::Run()
+{
+	bIsComplete = true;
+
+	// Run against a standalone bootstrap with fake stages, so that no real requests are made for the logged in user
+	const TSharedRef<FOnlineLoginBootstrapAccelByte, ESPMode::ThreadSafe> Bootstrap = MakeShared<FOnlineLoginBootstrapAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+	const int32 LocalUserNum = 0;
+
+	// Stages that finish later hold on to their delegate here until the test fires it
+	TMap<FName, FOnLoginBootstrapStageFinished> InFlightStages;
+	const auto RegisterDeferredStage = [&Bootstrap, &InFlightStages](const TCHAR* Stage, const TArray<FName>& Prerequisites) {
+		const FName StageName(Stage);
+		Bootstrap->RegisterStage(StageName, Prerequisites, [&InFlightStages, StageName](int32, const FOnLoginBootstrapStageFinished& OnFinished) {
+			InFlightStages.Add(StageName, OnFinished);
+		});
+	};
+	const auto FinishStage = [&InFlightStages](const TCHAR* Stage, bool bStageWasSuccessful) {
+		FOnLoginBootstrapStageFinished OnFinished;
+		if (InFlightStages.RemoveAndCopyValue(FName(Stage), OnFinished))
+		{
+			OnFinished.ExecuteIfBound(bStageWasSuccessful, bStageWasSuccessful ? TEXT("") : TEXT("fake-stage-failed"));
+		}
+	};
+
+	Bootstrap->RegisterStage(FName(TEXT("Login")), {}, [](int32, const FOnLoginBootstrapStageFinished& OnFinished) {
+		OnFinished.ExecuteIfBound(true, TEXT(""));
+	});
+	RegisterDeferredStage(TEXT("Lobby"), { FName(TEXT("Login")) });
+	RegisterDeferredStage(TEXT("Friends"), { FName(TEXT("Lobby")) });
+	RegisterDeferredStage(TEXT("Wallet"), { FName(TEXT("Login")) });
+	RegisterDeferredStage(TEXT("Stats"), {});
+
+	int32 CompleteCount = 0;
+	FAccelByteLoginBootstrapReport LastReport;
+	Bootstrap->AddOnLoginBootstrapCompleteDelegate_Handle(LocalUserNum, FOnLoginBootstrapCompleteDelegate::CreateLambda([&CompleteCount, &LastReport](int32, const FAccelByteLoginBootstrapReport& Report) {
+		CompleteCount++;
+		LastReport = Report;
+	}));
+
+	// Only list the leaves, prerequisites should be pulled in and independent stages started straight away
+	Check(Bootstrap->StartBootstrap(LocalUserNum, { FName(TEXT("Friends")), FName(TEXT("Wallet")), FName(TEXT("Stats")) }), TEXT("bootstrap should start"));
+	Check(InFlightStages.Num() == 3 && InFlightStages.Contains(FName(TEXT("Lobby"))) && InFlightStages.Contains(FName(TEXT("Wallet"))) && InFlightStages.Contains(FName(TEXT("Stats"))), TEXT("independent stages should run side by side"));
+	Check(Bootstrap->IsStageInBootstrap(LocalUserNum, FName(TEXT("Lobby"))), TEXT("prerequisites should be added to the run"));
+
+	FinishStage(TEXT("Lobby"), false);
+	FinishStage(TEXT("Stats"), true);
+	Check(!InFlightStages.Contains(FName(TEXT("Friends"))), TEXT("a stage should not start once its prerequisite fails"));
+	Check(CompleteCount == 0 && Bootstrap->IsBootstrapRunning(LocalUserNum), TEXT("run should wait on stages still in flight"));
+
+	FinishStage(TEXT("Wallet"), true);
+	Check(CompleteCount == 1 && !LastReport.bWasSuccessful && !LastReport.bWasCancelled, TEXT("run should finish as failed once every stage is done"));
+	const FAccelByteLoginBootstrapStageReport* FriendsReport = LastReport.Stages.FindByPredicate([](const FAccelByteLoginBootstrapStageReport& StageReport) { return StageReport.Stage == FName(TEXT("Friends")); });
+	Check(FriendsReport != nullptr && FriendsReport->State == EAccelByteLoginBootstrapStageState::Skipped, TEXT("dependent stage should be reported as skipped"));
+	Check(LastReport.Stages.Num() == 5 && LastReport.Stages[0].Stage == FName(TEXT("Login")), TEXT("report should list stages after their prerequisites"));
+
+	// Cancelling part way should report the run as cancelled, and late results from it should be ignored
+	Check(Bootstrap->StartBootstrap(LocalUserNum, { FName(TEXT("Wallet")) }), TEXT("second bootstrap should start"));
+	Bootstrap->CancelBootstrap(LocalUserNum);
+	Check(CompleteCount == 2 && LastReport.bWasCancelled, TEXT("cancelled run should be reported"));
+	FinishStage(TEXT("Wallet"), true);
+	Check(CompleteCount == 2 && !Bootstrap->IsBootstrapRunning(LocalUserNum), TEXT("results from a cancelled run should be ignored"));
+
+	// Cycles and unknown stages should be refused rather than started
+	Bootstrap->RegisterStage(FName(TEXT("CycleA")), { FName(TEXT("CycleB")) }, [](int32, const FOnLoginBootstrapStageFinished&) {});
+	Bootstrap->RegisterStage(FName(TEXT("CycleB")), { FName(TEXT("CycleA")) }, [](int32, const FOnLoginBootstrapStageFinished&) {});
+	Check(!Bootstrap->StartBootstrap(LocalUserNum, { FName(TEXT("CycleA")) }), TEXT("cyclic stages should not start"));
+	Check(!Bootstrap->StartBootstrap(LocalUserNum, { FName(TEXT("NotRegistered")) }), TEXT("unregistered stages should not start"));
+
+	// A run whose stages all finish straight away is over before the start call returns, so the stages it ran have to
+	// come back from the start call itself for the subsystem to know whether the lobby was connected by the run
+	TArray<FName> StartedStages;
+	Check(Bootstrap->StartBootstrap(LocalUserNum, { FName(TEXT("Login")) }, &StartedStages), TEXT("synchronous bootstrap should start"));
+	Check(!Bootstrap->IsBootstrapRunning(LocalUserNum) && !Bootstrap->IsStageInBootstrap(LocalUserNum, FName(TEXT("Login"))), TEXT("synchronous bootstrap should have finished before the start call returned"));
+	Check(StartedStages.Num() == 1 && StartedStages[0] == FName(TEXT("Login")), TEXT("start call should report the stages of a run that has already finished"));
+
+	// Profile creation is a built in stage, and the login task only hands it over when a run would include it
+	Bootstrap->SetRequestedStages({ FName(TEXT("Login")) });
+	Check(!Bootstrap->IsStageRequested(FOnlineLoginBootstrapAccelByte::UserProfileStage), TEXT("profile stage should not be requested unless a run needs it"));
+	Bootstrap->RegisterStage(FName(TEXT("CloudSave")), { FOnlineLoginBootstrapAccelByte::UserProfileStage }, [](int32, const FOnLoginBootstrapStageFinished&) {});
+	Bootstrap->SetRequestedStages({ FName(TEXT("CloudSave")) });
+	Check(Bootstrap->IsStageRequested(FOnlineLoginBootstrapAccelByte::UserProfileStage), TEXT("profile stage should be requested as a prerequisite"));
+	Bootstrap->SetRequestedStages({ FName(TEXT("NotRegistered")), FOnlineLoginBootstrapAccelByte::UserProfileStage });
+	Check(!Bootstrap->IsStageRequested(FOnlineLoginBootstrapAccelByte::UserProfileStage), TEXT("profile stage should not be handed over if the run would fail to start"));
+
+	return ReportResult(TEXT("FExecTestLoginBootstrap"));
+}
+
+#endif
@@ -0,0 +1,34 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for FOnlineLoginBootstrapAccelByte, running fake stages on a standalone bootstrap and checking that
+ * independent stages run side by side, that stages wait on their prerequisites, that failures skip dependent stages,
+ * that results from a cancelled run are ignored, that a run finishing synchronously still reports its stages, and that the
+ * built in profile stage is only handed to the bootstrap when a run would include it.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST LOGIN BOOTSTRAP
+ */
+class FExecTestLoginBootstrap : public FExecTestBase, public TSharedFromThis<FExecTestLoginBootstrap>
+{
+public:
+
+	/**
+	 * Constructs an instance of the login bootstrap test case.
+	 */
+	FExecTestLoginBootstrap(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
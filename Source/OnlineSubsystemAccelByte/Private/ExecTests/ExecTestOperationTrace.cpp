@@ -0,0 +1,232 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestOperationTrace.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineOperationTraceAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "AsyncTasks/OnlineAsyncTaskAccelByte.h"
+#include "Async/Async.h"
+
+namespace
+{
+	DECLARE_DELEGATE_OneParam(FExecTestTraceDelegate, int32 /*Calls*/);
+
+	/**
+	 * Task that does no work of its own, used to check the trace context that its SDK style delegates run under.
+	 */
+	class FOnlineAsyncTaskAccelByteTraceTest : public FOnlineAsyncTaskAccelByte, public AccelByte::TSelfPtr<FOnlineAsyncTaskAccelByteTraceTest, ESPMode::ThreadSafe>
+	{
+	public:
+
+		explicit FOnlineAsyncTaskAccelByteTraceTest(FOnlineSubsystemAccelByte* const InABSubsystem)
+			: FOnlineAsyncTaskAccelByte(InABSubsystem, ASYNC_TASK_FLAG_BIT(EAccelByteAsyncTaskFlags::ServerTask))
+		{
+		}
+
+		/** Bind a delegate to this task in the same way that tasks bind their SDK delegates */
+		FExecTestTraceDelegate CreateDelegate()
+		{
+			return AccelByte::TDelegateUtils<FExecTestTraceDelegate>::CreateThreadSafeSelfPtr(this, &FOnlineAsyncTaskAccelByteTraceTest::OnDelegate);
+		}
+
+		/** Trace context that was current the last time the delegate ran */
+		FAccelByteTraceContext ContextInDelegate;
+
+		/** Amount of times the delegate has run */
+		FThreadSafeCounter DelegateCalls;
+
+	protected:
+
+		virtual const FString GetTaskName() const override
+		{
+			return TEXT("FOnlineAsyncTaskAccelByteTraceTest");
+		}
+
+	private:
+
+		void OnDelegate(int32 Calls)
+		{
+			ContextInDelegate = FAccelByteTraceContext::GetCurrent();
+			DelegateCalls.Add(Calls);
+		}
+	};
+}
+
+FExecTestOperationTrace::FExecTestOperationTrace(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestOperationTrace::Run()
+{
+	bIsComplete = true;
+
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	const TSharedRef<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe> Trace = MakeShared<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe>(Subsystem);
+	Trace->SetEnabled(true);
+	Trace->Clear();
+
+	const FAccelByteTraceContext ContextBeforeTest = FAccelByteTraceContext::GetCurrent();
+	FAccelByteTraceContext RootContext;
+	FAccelByteTraceContext ChildContext;
+	FAccelByteTraceContext TaskContext;
+	{
+		const FAccelByteTraceSpanScope RootScope(Trace, TEXT("Root"));
+		RootContext = RootScope.GetContext();
+		Check(FAccelByteTraceContext::GetCurrent().SpanId == RootContext.SpanId, TEXT("a span scope makes its span current"));
+		{
+			const FAccelByteTraceSpanScope ChildScope(Trace, TEXT("Child"));
+			ChildContext = ChildScope.GetContext();
+		}
+		Check(FAccelByteTraceContext::GetCurrent().SpanId == RootContext.SpanId, TEXT("the parent span is current again once a nested scope ends"));
+
+		// Simulate a task created under the root span completing later, outside of any scope
+		TaskContext = Trace->CreateSpanContext(FAccelByteTraceContext::GetCurrent());
+	}
+	Check(FAccelByteTraceContext::GetCurrent().SpanId == ContextBeforeTest.SpanId, TEXT("the context from before the test is restored once the root scope ends"));
+	Check(RootContext.IsValid() && RootContext.TraceId == RootContext.SpanId && RootContext.ParentSpanId == 0, TEXT("a span started with no current context starts a new trace"));
+	Check(ChildContext.TraceId == RootContext.TraceId && ChildContext.ParentSpanId == RootContext.SpanId, TEXT("a nested span is parented to the current span"));
+	Check(TaskContext.TraceId == RootContext.TraceId && TaskContext.ParentSpanId == RootContext.SpanId, TEXT("a context created under a span shares its trace"));
+
+	{
+		// Anything dispatched while a task's context is applied, such as from an SDK delegate, is traced under the task
+		const FAccelByteTraceContextScope TaskScope(TaskContext);
+		const FAccelByteTraceSpanScope SubTaskScope(Trace, TEXT("SubTask"));
+		Check(SubTaskScope.GetContext().TraceId == RootContext.TraceId && SubTaskScope.GetContext().ParentSpanId == TaskContext.SpanId, TEXT("a span started under an applied context is parented to it"));
+	}
+	// Two tasks of the same class running in parallel under the root span, overlapping each other
+	const double TaskStartTimeInSeconds = FPlatformTime::Seconds();
+	Trace->AddSpan(TEXT("Task"), TaskContext, TaskStartTimeInSeconds, TaskStartTimeInSeconds + 0.25);
+	Trace->AddSpan(TEXT("Task"), Trace->CreateSpanContext(RootContext), TaskStartTimeInSeconds + 0.1, TaskStartTimeInSeconds + 0.35);
+
+	const TArray<FAccelByteTraceSpan> TraceSpans = Trace->GetSpansForTrace(RootContext.TraceId);
+	Check(TraceSpans.Num() == 5, TEXT("every span of the operation is recorded under its trace"));
+
+	// Export, and check that the root span is extended to cover the task completing after the root scope ended
+	const FString ChromeTrace = Trace->SerializeChromeTrace();
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(ChromeTrace);
+	const bool bIsValidJson = FJsonSerializer::Deserialize(JsonReader, JsonObject) && JsonObject.IsValid();
+	Check(bIsValidJson, TEXT("the exported Chrome trace is valid JSON"));
+	if (bIsValidJson)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* TraceEvents = nullptr;
+		Check(JsonObject->TryGetArrayField(TEXT("traceEvents"), TraceEvents) && TraceEvents->Num() == 10, TEXT("each span is exported as a begin and end event"));
+
+		// Viewers pair begin and end events by ID, so each span needs its own ID for overlapping spans to be drawn right
+		const FString ExpectedTraceId = FString::Printf(TEXT("0x%llx"), RootContext.TraceId);
+		TMap<FString, TPair<int32, int32>> IdToBeginAndEndCounts;
+		bool bAreEventsInTrace = true;
+		double RootEndTime = -1.0;
+		double TaskEndTime = -1.0;
+		for (int32 Index = 0; TraceEvents != nullptr && Index < TraceEvents->Num(); Index++)
+		{
+			const TSharedPtr<FJsonObject> Event = (*TraceEvents)[Index]->AsObject();
+			if (!Event.IsValid())
+			{
+				continue;
+			}
+
+			const FString Phase = Event->GetStringField(TEXT("ph"));
+			TPair<int32, int32>& BeginAndEndCounts = IdToBeginAndEndCounts.FindOrAdd(Event->GetStringField(TEXT("id")));
+			(Phase == TEXT("b") ? BeginAndEndCounts.Key : BeginAndEndCounts.Value)++;
+
+			const TSharedPtr<FJsonObject>* Args = nullptr;
+			bAreEventsInTrace &= Event->TryGetObjectField(TEXT("args"), Args) && (*Args)->GetStringField(TEXT("traceId")) == ExpectedTraceId;
+
+			if (Phase != TEXT("e"))
+			{
+				continue;
+			}
+
+			const FString Name = Event->GetStringField(TEXT("name"));
+			if (Name == TEXT("Root"))
+			{
+				RootEndTime = Event->GetNumberField(TEXT("ts"));
+			}
+			else if (Name == TEXT("Task"))
+			{
+				TaskEndTime = FMath::Max(TaskEndTime, Event->GetNumberField(TEXT("ts")));
+			}
+		}
+
+		bool bIsEachIdOneSpan = IdToBeginAndEndCounts.Num() == 5;
+		for (const TPair<FString, TPair<int32, int32>>& BeginAndEndCounts : IdToBeginAndEndCounts)
+		{
+			bIsEachIdOneSpan &= BeginAndEndCounts.Value.Key == 1 && BeginAndEndCounts.Value.Value == 1;
+		}
+		Check(bIsEachIdOneSpan, TEXT("each span is exported with its own ID, shared only by its begin and end events"));
+		Check(bAreEventsInTrace, TEXT("each event carries the ID of its trace"));
+		Check(TaskEndTime > 0.0 && RootEndTime >= TaskEndTime, TEXT("a parent span is extended to cover the spans nested under it"));
+	}
+
+	// Bound the ring buffer and check that only the newest spans are kept
+	Trace->Clear();
+	Trace->SetMaxSpans(3);
+	for (int32 Index = 0; Index < 5; Index++)
+	{
+		Trace->AddSpan(FString::Printf(TEXT("Span%d"), Index), Trace->CreateSpanContext(FAccelByteTraceContext()), Index, Index + 1.0);
+	}
+	const TArray<FAccelByteTraceSpan> BoundedSpans = Trace->GetSpans();
+	Check(BoundedSpans.Num() == 3, TEXT("the span buffer never grows past its maximum"));
+	Check(BoundedSpans.Num() == 3 && BoundedSpans[0].Name == TEXT("Span2") && BoundedSpans[2].Name == TEXT("Span4"), TEXT("the oldest spans are overwritten first"));
+
+	// Disabled traces hand out invalid contexts, so that nothing is recorded
+	Trace->SetEnabled(false);
+	Check(!Trace->CreateSpanContext(RootContext).IsValid(), TEXT("a disabled trace does not create span contexts"));
+
+	// Tasks take their trace from the subsystem, so enable it while creating them. The tasks are never completed, so they
+	// record no spans into it.
+	const FOnlineOperationTraceAccelBytePtr SubsystemTrace = (Subsystem != nullptr) ? Subsystem->GetOperationTrace() : nullptr;
+	if (Check(SubsystemTrace.IsValid(), TEXT("subsystem has an operation trace")))
+	{
+		const bool bWasEnabled = SubsystemTrace->IsEnabled();
+		SubsystemTrace->SetEnabled(true);
+
+		FAccelByteTraceContext OperationContext;
+		TUniquePtr<FOnlineAsyncTaskAccelByteTraceTest> TracedTask;
+		{
+			// Stand in for an interface call that starts an operation, without recording a span for it
+			OperationContext = SubsystemTrace->CreateSpanContext(FAccelByteTraceContext());
+			const FAccelByteTraceContextScope OperationScope(OperationContext);
+			TracedTask = MakeUnique<FOnlineAsyncTaskAccelByteTraceTest>(Subsystem);
+		}
+		SubsystemTrace->SetEnabled(false);
+		TUniquePtr<FOnlineAsyncTaskAccelByteTraceTest> UntracedTask = MakeUnique<FOnlineAsyncTaskAccelByteTraceTest>(Subsystem);
+		SubsystemTrace->SetEnabled(bWasEnabled);
+
+		const FAccelByteTraceContext TracedTaskContext = TracedTask->GetTraceContext();
+		Check(TracedTaskContext.TraceId == OperationContext.TraceId && TracedTaskContext.ParentSpanId == OperationContext.SpanId, TEXT("a task created during an operation is traced under it"));
+
+		// SDK delegates run on HTTP and websocket threads, so check both this thread and a pool thread
+		const FExecTestTraceDelegate TracedDelegate = TracedTask->CreateDelegate();
+		const FAccelByteTraceContext ContextBeforeDelegate = FAccelByteTraceContext::GetCurrent();
+		TracedDelegate.ExecuteIfBound(1);
+		Check(TracedTask->ContextInDelegate.SpanId == TracedTaskContext.SpanId, TEXT("a delegate bound to a traced task runs under the task's context"));
+		Check(FAccelByteTraceContext::GetCurrent().SpanId == ContextBeforeDelegate.SpanId, TEXT("the previous context is restored once a delegate has run"));
+
+		TracedTask->ContextInDelegate = FAccelByteTraceContext();
+		Async(EAsyncExecution::ThreadPool, [&TracedDelegate]() { TracedDelegate.ExecuteIfBound(1); }).Wait();
+		Check(TracedTask->DelegateCalls.GetValue() == 2 && TracedTask->ContextInDelegate.SpanId == TracedTaskContext.SpanId, TEXT("a delegate run on another thread runs under the task's context"));
+
+		const FExecTestTraceDelegate UntracedDelegate = UntracedTask->CreateDelegate();
+		UntracedDelegate.ExecuteIfBound(1);
+		Check(!UntracedTask->GetTraceContext().IsValid() && UntracedTask->DelegateCalls.GetValue() == 1, TEXT("a delegate bound to an untraced task still runs"));
+		Check(UntracedTask->ContextInDelegate.SpanId == ContextBeforeDelegate.SpanId, TEXT("a delegate bound to an untraced task leaves the context alone"));
+
+		// Delegates only hold a weak reference to their task, so a late response after the task is gone does nothing
+		TracedTask.Reset();
+		TracedDelegate.ExecuteIfBound(1);
+	}
+
+	return ReportResult(TEXT("FExecTestOperationTrace"));
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the operation trace, checking that trace context is propagated to nested spans, that the previous
+ * context is restored once a scope ends, that the span ring buffer is bounded and that spans export as a Chrome trace
+ * with a begin and end event pair per span, even where spans of the same name overlap. Records into its own trace
+ * instance, other than briefly enabling the subsystem's trace to check that delegates bound to a traced async task run
+ * under the task's trace context on any thread. No spans are recorded into the subsystem's trace.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST TRACE SPANS
+ */
+class FExecTestOperationTrace : public FExecTestBase, public TSharedFromThis<FExecTestOperationTrace>
+{
+public:
+
+	/**
+	 * Constructs an instance of the operation trace test case.
+	 */
+	FExecTestOperationTrace(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
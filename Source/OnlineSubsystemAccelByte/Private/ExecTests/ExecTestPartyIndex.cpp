@@ -0,0 +1,134 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestPartyIndex.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlinePartyInterfaceAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestPartyIndex::FExecTestPartyIndex(UWorld* InWorld, const FName& InSubsystemName, int32 InPartySize, int32 InPartyCount)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, PartySize(FMath::Max(InPartySize, 2))
+	, PartyCount(FMath::Max(InPartyCount, 3))
+{
+}
+
+bool FExecTestPartyIndex::Run()
+{
+	bIsComplete = true;
+
+	// Use a separate party interface from the subsystem's one, so that no real parties or invites are touched
+	const TSharedRef<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe> PartyInterface = MakeShared<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+
+	const auto MakeUserId = [](const FString& AccelByteId) {
+		FAccelByteUniqueIdComposite CompositeId;
+		CompositeId.Id = AccelByteId;
+		return FUniqueNetIdAccelByteUser::Create(CompositeId);
+	};
+	const auto MakeMemberId = [](int32 PartyIndex, int32 MemberIndex) {
+		return FString::Printf(TEXT("exectest-party-%d-member-%d"), PartyIndex, MemberIndex);
+	};
+	const auto MakePartyId = [](int32 PartyIndex) {
+		return MakeShared<const FOnlinePartyIdAccelByte>(FString::Printf(TEXT("exectest-party-%d"), PartyIndex));
+	};
+
+	// The local user is not the leader of any of these parties, so removing members never writes to party storage
+	const FUniqueNetIdAccelByteUserRef LocalUserId = MakeUserId(TEXT("exectest-party-local"));
+
+	TArray<TSharedRef<FOnlinePartyAccelByte>> Parties;
+	Parties.Reserve(PartyCount);
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 PartyIndex = 0; PartyIndex < PartyCount; PartyIndex++)
+	{
+		const TSharedRef<FOnlinePartyAccelByte> Party = MakeShared<FOnlinePartyAccelByte>(PartyInterface, MakePartyId(PartyIndex)->ToString(), TEXT(""), FPartyConfiguration(), MakeUserId(MakeMemberId(PartyIndex, 0)));
+		for (int32 MemberIndex = 0; MemberIndex < PartySize; MemberIndex++)
+		{
+			const FUniqueNetIdAccelByteUserRef MemberId = MakeUserId(MakeMemberId(PartyIndex, MemberIndex));
+			Party->AddMember(LocalUserId, MakeShared<FOnlinePartyMemberAccelByte>(MemberId, MemberId->GetAccelByteId()));
+			Party->AddUserToInvitedPlayers(LocalUserId, MemberId, MakeUserId(FString::Printf(TEXT("exectest-party-%d-invitee-%d"), PartyIndex, MemberIndex)));
+		}
+		Parties.Add(Party);
+
+		// Each party's leader sends the local user an invite, so the local user ends up with a full invite list
+		PartyInterface->AddPartyInvite(LocalUserId, MakeShared<FAccelBytePartyInvite>(MakePartyId(PartyIndex), MakeUserId(MakeMemberId(PartyIndex, 0)), MakeMemberId(PartyIndex, 0), TEXT("")));
+	}
+	const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// Look up every member of every party and every invite by both party and inviter
+	StartTime = FPlatformTime::Seconds();
+	int32 MemberHits = 0;
+	int32 InviteHits = 0;
+	for (int32 PartyIndex = 0; PartyIndex < PartyCount; PartyIndex++)
+	{
+		for (int32 MemberIndex = 0; MemberIndex < PartySize; MemberIndex++)
+		{
+			const TSharedPtr<const FOnlinePartyMemberAccelByte> Member = Parties[PartyIndex]->GetMember(MakeUserId(MakeMemberId(PartyIndex, MemberIndex)));
+			if (Member.IsValid() && Member->GetDisplayName() == MakeMemberId(PartyIndex, MemberIndex))
+			{
+				MemberHits++;
+			}
+		}
+
+		const TSharedPtr<const FAccelBytePartyInvite> InviteByParty = PartyInterface->GetInviteForParty(LocalUserId, MakePartyId(PartyIndex));
+		const TSharedPtr<const FAccelBytePartyInvite> InviteByInviter = PartyInterface->GetInviteForParty(LocalUserId, MakeUserId(MakeMemberId(PartyIndex, 0)));
+		if (InviteByParty.IsValid() && InviteByParty == InviteByInviter)
+		{
+			InviteHits++;
+		}
+	}
+	const double LookupSeconds = FPlatformTime::Seconds() - StartTime;
+
+	Check(MemberHits == PartySize * PartyCount, TEXT("every member is found in their party"));
+	Check(Parties[0]->GetMemberCount() == static_cast<uint32>(PartySize), TEXT("party has one entry per member"));
+	Check(Parties[0]->GetAllPendingInvitedUsers().Num() == PartySize, TEXT("party has a full pending invite list"));
+	Check(InviteHits == PartyCount, TEXT("every invite is found by both party and inviter"));
+	Check(!Parties[0]->GetMember(MakeUserId(MakeMemberId(1, 0))).IsValid(), TEXT("member of another party is not found"));
+
+	// Remove every other member from the first party
+	StartTime = FPlatformTime::Seconds();
+	for (int32 MemberIndex = 0; MemberIndex < PartySize; MemberIndex += 2)
+	{
+		Parties[0]->RemoveMember(LocalUserId, MakeUserId(MakeMemberId(0, MemberIndex)), EMemberExitedReason::Left);
+	}
+	const double RemoveSeconds = FPlatformTime::Seconds() - StartTime;
+
+	Check(Parties[0]->GetMemberCount() == static_cast<uint32>(PartySize / 2), TEXT("removed members leave the party"));
+	Check(!Parties[0]->GetMember(MakeUserId(MakeMemberId(0, 0))).IsValid(), TEXT("removed member is no longer found"));
+	Check(Parties[0]->GetMember(MakeUserId(MakeMemberId(0, 1))).IsValid(), TEXT("remaining member is still found"));
+	Check(!Parties[0]->RemoveMember(LocalUserId, MakeUserId(MakeMemberId(0, 0)), EMemberExitedReason::Left), TEXT("removing a member twice does not find them"));
+
+	// A new invite for the same party replaces the old one, so the old inviter should no longer resolve to anything
+	const FUniqueNetIdAccelByteUserRef ReplacementInviterId = MakeUserId(MakeMemberId(0, 1));
+	PartyInterface->AddPartyInvite(LocalUserId, MakeShared<FAccelBytePartyInvite>(MakePartyId(0), ReplacementInviterId, ReplacementInviterId->GetAccelByteId(), TEXT("")));
+	const TSharedPtr<const FAccelBytePartyInvite> ReplacedInvite = PartyInterface->GetInviteForParty(LocalUserId, MakePartyId(0));
+	Check(ReplacedInvite.IsValid() && ReplacedInvite->InviterId.Get() == ReplacementInviterId.Get(), TEXT("new invite for a party replaces the old one"));
+	Check(PartyInterface->GetInviteForParty(LocalUserId, ReplacementInviterId) == ReplacedInvite, TEXT("new invite is found by its inviter"));
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakeUserId(MakeMemberId(0, 0))).IsValid(), TEXT("replaced invite is no longer found by its inviter"));
+
+	// Remove one invite by party and one by inviter, neither should leave anything behind in the other lookup
+	PartyInterface->RemoveInviteForParty(LocalUserId, MakePartyId(1), EPartyInvitationRemovedReason::Declined);
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakePartyId(1)).IsValid(), TEXT("invite removed by party is not found by party"));
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakeUserId(MakeMemberId(1, 0))).IsValid(), TEXT("invite removed by party is not found by inviter"));
+
+	PartyInterface->RemoveInviteForParty(LocalUserId, MakeUserId(MakeMemberId(2, 0)), EPartyInvitationRemovedReason::Declined);
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakePartyId(2)).IsValid(), TEXT("invite removed by inviter is not found by party"));
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakeUserId(MakeMemberId(2, 0))).IsValid(), TEXT("invite removed by inviter is not found by inviter"));
+
+	TArray<IOnlinePartyJoinInfoConstRef> PendingInvites;
+	PartyInterface->GetPendingInvites(LocalUserId.Get(), PendingInvites);
+	Check(PendingInvites.Num() == PartyCount - 2, TEXT("invite list only loses the removed invites"));
+	Check(PartyInterface->GetInviteForParty(LocalUserId, MakePartyId(PartyCount - 1)).IsValid(), TEXT("untouched invite is still found"));
+
+	// Clearing every invite should empty both lookups
+	PartyInterface->ClearInviteForParty(LocalUserId, nullptr, EPartyInvitationRemovedReason::Cleared);
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakePartyId(PartyCount - 1)).IsValid(), TEXT("cleared invite is not found by party"));
+	Check(!PartyInterface->GetInviteForParty(LocalUserId, MakeUserId(MakeMemberId(PartyCount - 1, 0))).IsValid(), TEXT("cleared invite is not found by inviter"));
+
+	UE_LOG_AB(Log, TEXT("FExecTestPartyIndex with %d part(ies) of %d member(s): built in %.3f ms, looked up in %.3f ms, removed in %.3f ms"), PartyCount, PartySize, BuildSeconds * 1000.0, LookupSeconds * 1000.0, RemoveSeconds * 1000.0);
+	return ReportResult(TEXT("FExecTestPartyIndex"));
+}
+
+#endif
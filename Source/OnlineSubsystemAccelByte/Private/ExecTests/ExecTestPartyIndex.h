@@ -0,0 +1,44 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the party member and invite indexes, building max size parties with full invite lists and checking
+ * that member and invite lookups stay correct as members leave and invites are replaced or removed. Uses its own party
+ * interface and locally constructed parties only, so no lobby connection is needed.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST PARTY INDEX <optional party size, defaults to 50> <optional party count, defaults to 100>
+ */
+class FExecTestPartyIndex : public FExecTestBase, public TSharedFromThis<FExecTestPartyIndex>
+{
+public:
+
+	/**
+	 * Constructs an instance of the party index test case.
+	 * 
+	 * @param PartySize Amount of members and pending invites for each party
+	 * @param PartyCount Amount of parties to build, each one sending an invite to the local user
+	 */
+	FExecTestPartyIndex(UWorld* InWorld, const FName& InSubsystemName, int32 InPartySize, int32 InPartyCount);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Amount of members and pending invites for each party */
+	int32 PartySize;
+
+	/** Amount of parties to build, each one sending an invite to the local user */
+	int32 PartyCount;
+
+};
+
+#endif
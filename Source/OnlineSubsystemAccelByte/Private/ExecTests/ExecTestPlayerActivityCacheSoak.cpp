@@ -0,0 +1,86 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestPlayerActivityCacheSoak.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlinePlayerActivityCacheAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Async/ParallelFor.h"
+
+/** Amount of players that are joined and unregistered between each purge of the cache */
+#define SOAK_PLAYERS_PER_BATCH 1000
+
+FExecTestPlayerActivityCacheSoak::FExecTestPlayerActivityCacheSoak(UWorld* InWorld, const FName& InSubsystemName, int32 InPlayerCount)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, PlayerCount(InPlayerCount)
+{
+}
+
+bool FExecTestPlayerActivityCacheSoak::Run()
+{
+	bIsComplete = true;
+
+	// Run against a standalone cache rather than the subsystem's own, so that we do not evict real players
+	FOnlinePlayerActivityCacheAccelByte Cache(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+	Cache.SetTimeouts(0.0, 0.0);
+
+	SIZE_T FirstBatchAllocatedSize = 0;
+	SIZE_T PeakAllocatedSize = 0;
+	int32 PlayersCycled = 0;
+	while (PlayersCycled < PlayerCount)
+	{
+		const int32 BatchSize = FMath::Min(SOAK_PLAYERS_PER_BATCH, PlayerCount - PlayersCycled);
+		for (int32 Index = 0; Index < BatchSize; Index++)
+		{
+			const FString AccelByteId = FString::Printf(TEXT("%032x"), PlayersCycled + Index);
+			Cache.SetPlatform(AccelByteId, TEXT("SOAK"));
+			Cache.SetJoinTime(AccelByteId, FDateTime::Now());
+			Cache.SetDisconnectedTime(AccelByteId, FDateTime::Now());
+		}
+		PlayersCycled += BatchSize;
+
+		// Measure at the high water mark of each batch, before purging
+		const SIZE_T AllocatedSize = Cache.GetAllocatedSize();
+		if (FirstBatchAllocatedSize == 0)
+		{
+			FirstBatchAllocatedSize = AllocatedSize;
+		}
+		PeakAllocatedSize = FMath::Max(PeakAllocatedSize, AllocatedSize);
+
+		Cache.Purge(FPlatformTime::Seconds());
+	}
+
+	UE_LOG_AB(Log, TEXT("FExecTestPlayerActivityCacheSoak cycled %d players, first batch allocation: %llu bytes, peak allocation: %llu bytes"),
+		PlayersCycled, static_cast<uint64>(FirstBatchAllocatedSize), static_cast<uint64>(PeakAllocatedSize));
+	Check(Cache.Num() == 0, TEXT("every cycled player should be purged"));
+	Check(PeakAllocatedSize <= FirstBatchAllocatedSize, TEXT("peak allocation should stay at the level of the first batch"));
+
+	// Write and read the same players from several threads at once, the cache lock should keep every entry intact
+	const int32 ConcurrentPlayerCount = FMath::Min(SOAK_PLAYERS_PER_BATCH, PlayerCount);
+	const FDateTime JoinTime = FDateTime::UtcNow();
+	ParallelFor(ConcurrentPlayerCount * 4, [&Cache, ConcurrentPlayerCount, &JoinTime](int32 Index) {
+		const FString AccelByteId = FString::Printf(TEXT("%032x"), Index % ConcurrentPlayerCount);
+		Cache.SetPlatform(AccelByteId, TEXT("SOAK"));
+		Cache.SetJoinTime(AccelByteId, JoinTime);
+		FAccelBytePlayerActivity Activity;
+		Cache.GetPlayerActivity(AccelByteId, Activity);
+	});
+	Check(Cache.Num() == ConcurrentPlayerCount, TEXT("concurrent writes for the same players should not add duplicate entries"));
+
+	FAccelBytePlayerActivity Activity;
+	Check(Cache.GetPlayerActivity(FString::Printf(TEXT("%032x"), 0), Activity) && Activity.JoinTime == JoinTime && Activity.Platform == TEXT("SOAK"), TEXT("concurrently written entries should keep their values"));
+	Check(!Cache.GetPlayerActivity(TEXT("unknown-player"), Activity), TEXT("players that were never written should not be found"));
+
+	// Registered players expire on the idle timeout rather than the disconnected one
+	Cache.Purge(FPlatformTime::Seconds());
+	Check(Cache.Num() == 0, TEXT("idle entries should be purged once the idle timeout has passed"));
+
+	return ReportResult(TEXT("FExecTestPlayerActivityCacheSoak"));
+}
+
+#undef SOAK_PLAYERS_PER_BATCH
+
+#endif
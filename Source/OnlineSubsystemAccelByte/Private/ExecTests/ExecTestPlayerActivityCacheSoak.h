@@ -0,0 +1,40 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Soak test for FOnlinePlayerActivityCacheAccelByte, cycling a large amount of players through join and unregister
+ * and checking that the cache's memory stays flat once expired entries are purged. Also writes the same players from
+ * several threads at once to check that entries stay intact under the cache lock.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST PLAYERACTIVITY SOAK <optional player count, defaults to 100000>
+ */
+class FExecTestPlayerActivityCacheSoak : public FExecTestBase, public TSharedFromThis<FExecTestPlayerActivityCacheSoak>
+{
+public:
+
+	/**
+	 * Constructs an instance of the player activity cache soak test case.
+	 * 
+	 * @param PlayerCount Amount of unique players to cycle through the cache
+	 */
+	FExecTestPlayerActivityCacheSoak(UWorld* InWorld, const FName& InSubsystemName, int32 InPlayerCount);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Amount of unique players to cycle through the cache */
+	int32 PlayerCount;
+
+};
+
+#endif
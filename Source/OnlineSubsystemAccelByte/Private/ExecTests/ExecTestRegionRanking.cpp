@@ -0,0 +1,82 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestRegionRanking.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineRegionRankingAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestRegionRanking::FExecTestRegionRanking(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestRegionRanking::Run()
+{
+	bIsComplete = true;
+
+	// Run against a standalone ranking with a fake latency source, so that we neither ping QoS nor disturb the real ranking
+	const TSharedRef<FOnlineRegionRankingAccelByte, ESPMode::ThreadSafe> Ranking = MakeShared<FOnlineRegionRankingAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+
+	TArray<TPair<FString, float>> FakeLatencies;
+	int32 LatencyRequestCount = 0;
+	Ranking->SetLatencySource([&FakeLatencies, &LatencyRequestCount](const FOnRegionLatenciesReceived& OnLatenciesReceived) {
+		LatencyRequestCount++;
+		OnLatenciesReceived.ExecuteIfBound(FakeLatencies);
+	});
+
+	const auto SetFakeLatencies = [&FakeLatencies](float RegionALatency, float RegionBLatency) {
+		FakeLatencies.Reset();
+		FakeLatencies.Emplace(TEXT("region-a"), RegionALatency);
+		FakeLatencies.Emplace(TEXT("region-b"), RegionBLatency);
+	};
+
+	SetFakeLatencies(50.0f, 80.0f);
+	Ranking->RequestLatencies();
+	Check(Ranking->GetPreferredRegion() == TEXT("region-a"), TEXT("lowest latency region should be preferred after the first samples"));
+	Check(!Ranking->AddLatencySamples(FakeLatencies), TEXT("identical latencies should not recompute the ranking"));
+
+	// Region B becomes slightly faster, but not by enough to overcome hysteresis, so region A stays preferred
+	for (int32 Sample = 0; Sample < 50; Sample++)
+	{
+		SetFakeLatencies(50.0f + (Sample % 2), 49.0f - (Sample % 2));
+		Ranking->RequestLatencies();
+	}
+	Check(Ranking->GetPreferredRegion() == TEXT("region-a"), TEXT("preferred region should not flap for a marginally better region"));
+
+	// Region B becomes clearly faster, so it should eventually take over
+	for (int32 Sample = 0; Sample < 50; Sample++)
+	{
+		SetFakeLatencies(50.0f + (Sample % 2), 20.0f - (Sample % 2));
+		Ranking->RequestLatencies();
+	}
+	Check(Ranking->GetPreferredRegion() == TEXT("region-b"), TEXT("preferred region should change once another region is clearly better"));
+
+	FAccelByteRegionLatency RegionLatency;
+	Check(Ranking->GetRegionLatency(TEXT("region-a"), RegionLatency) && RegionLatency.JitterMs > 0.0f, TEXT("alternating samples should produce a jitter estimate"));
+
+	// A later set that brings in a new region, as GetRegionList passes on after any QoS ping, should reseed the ranking
+	FakeLatencies.Emplace(TEXT("region-c"), 5.0f);
+	Check(Ranking->AddLatencySamples(FakeLatencies), TEXT("changed latencies should recompute the ranking"));
+	const TArray<FString> RankedRegions = Ranking->GetRankedRegions();
+	Check(RankedRegions.Num() == 3 && RankedRegions.Contains(TEXT("region-c")), TEXT("region seen after the first samples should be ranked"));
+
+	// Background re-pings only happen once an interval is set, and then only once that interval has passed
+	Ranking->SetRepingIntervalSeconds(0.0f);
+	LatencyRequestCount = 0;
+	Ranking->Tick(3600.0f);
+	Check(LatencyRequestCount == 0, TEXT("ranking should not re-ping without an interval"));
+
+	Ranking->SetRepingIntervalSeconds(10.0f);
+	Ranking->Tick(5.0f);
+	Check(LatencyRequestCount == 0, TEXT("ranking should not re-ping before the interval has passed"));
+	Ranking->Tick(6.0f);
+	Check(LatencyRequestCount == 1, TEXT("ranking should re-ping once the interval has passed"));
+
+	return ReportResult(TEXT("FExecTestRegionRanking"));
+}
+
+#endif
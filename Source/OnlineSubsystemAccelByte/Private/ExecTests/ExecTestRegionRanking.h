@@ -0,0 +1,32 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for FOnlineRegionRankingAccelByte, feeding latencies through an injected latency source and checking that
+ * duplicate samples are ignored and that the preferred region only changes once another region is clearly better.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST QOS RANKING
+ */
+class FExecTestRegionRanking : public FExecTestBase, public TSharedFromThis<FExecTestRegionRanking>
+{
+public:
+
+	/**
+	 * Constructs an instance of the region ranking test case.
+	 */
+	FExecTestRegionRanking(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
@@ -0,0 +1,120 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestServerClock.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineTimeInterfaceAccelByte.h"
+#include "Async/ParallelFor.h"
+
+FExecTestServerClock::FExecTestServerClock(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestServerClock::Run()
+{
+	bIsComplete = true;
+
+	// Simulated server clock running 40ppm fast and a few hours ahead of the simulated local clock
+	const double SimulatedDriftRate = 0.00004;
+	const double SimulatedOffsetSeconds = 12345.678;
+	const int64 ServerEpochTicks = FDateTime(2022, 6, 1).GetTicks();
+	const auto GetTrueServerTicks = [=](double LocalSeconds) {
+		return ServerEpochTicks + static_cast<int64>(((LocalSeconds * (1.0 + SimulatedDriftRate)) + SimulatedOffsetSeconds) * ETimespan::TicksPerSecond);
+	};
+
+	double SimulatedLocalSeconds = 0.0;
+	FOnlineServerClockAccelByte ServerClock([&SimulatedLocalSeconds]() { return SimulatedLocalSeconds; });
+
+	Check(!ServerClock.IsSynced() && ServerClock.GetServerUtcNow() == FDateTime::MinValue(), TEXT("clock should not be synced before any samples"));
+	Check(!ServerClock.AddSample(FDateTime(GetTrueServerTicks(0.0)), 1.0, 0.5), TEXT("a sample received before it was sent should be rejected"));
+	Check(!ServerClock.IsSynced(), TEXT("a rejected sample should not sync the clock"));
+
+	// Take a sample every 30 seconds. Most have a short round trip with the server reading its clock near the middle, but
+	// every fifth is a slow round trip where the server read its clock near the end, which would skew the estimate.
+	FRandomStream Random(1234);
+	for (int32 SampleIndex = 0; SampleIndex < 60; SampleIndex++)
+	{
+		const double SentSeconds = SampleIndex * 30.0;
+		const bool bIsOutlier = (SampleIndex % 5) == 4;
+		const double RoundTripSeconds = bIsOutlier ? Random.FRandRange(0.8f, 1.4f) : Random.FRandRange(0.04f, 0.06f);
+		const double ServerReadFraction = bIsOutlier ? 0.9 : Random.FRandRange(0.45f, 0.55f);
+		const FDateTime ServerTime(GetTrueServerTicks(SentSeconds + (RoundTripSeconds * ServerReadFraction)));
+		ServerClock.AddSample(ServerTime, SentSeconds, SentSeconds + RoundTripSeconds);
+	}
+
+	SimulatedLocalSeconds = (59 * 30.0) + 10.0;
+	const double ErrorSeconds = static_cast<double>(ServerClock.GetServerUtcNowTicks() - GetTrueServerTicks(SimulatedLocalSeconds)) / ETimespan::TicksPerSecond;
+	UE_LOG_AB(Log, TEXT("FExecTestServerClock estimate error %.3fms, modelled drift %.2fppm"), ErrorSeconds * 1000.0, ServerClock.GetDriftRate() * 1000000.0);
+	Check(FMath::Abs(ErrorSeconds) < 0.005, TEXT("estimated server time should be within 5ms of the simulated server time"));
+	Check(FMath::Abs(ServerClock.GetDriftRate() - SimulatedDriftRate) < 0.00001, TEXT("modelled drift should be within 10ppm of the simulated drift"));
+
+	// Extrapolate a few minutes past the last sample, drift should keep the estimate close
+	SimulatedLocalSeconds += 300.0;
+	const double ExtrapolatedErrorSeconds = static_cast<double>(ServerClock.GetServerUtcNowTicks() - GetTrueServerTicks(SimulatedLocalSeconds)) / ETimespan::TicksPerSecond;
+	Check(FMath::Abs(ExtrapolatedErrorSeconds) < 0.01, TEXT("estimate should stay within 10ms when extrapolating past the last sample"));
+
+	// A fast sample claiming the server is half a second behind will pull the estimate back, but the returned time must
+	// hold still rather than step backwards
+	const int64 TicksBeforeStep = ServerClock.GetServerUtcNowTicks();
+	ServerClock.AddSample(FDateTime(GetTrueServerTicks(SimulatedLocalSeconds) - ETimespan::TicksPerSecond / 2), SimulatedLocalSeconds - 0.001, SimulatedLocalSeconds + 0.001);
+	Check(ServerClock.GetServerUtcNowTicks() >= TicksBeforeStep, TEXT("estimated server time should never go backwards"));
+
+	ServerClock.Reset();
+	Check(!ServerClock.IsSynced() && ServerClock.GetSampleCount() == 0, TEXT("clock should not be synced after a reset"));
+
+	// Readers are lock free while a writer republishes the model, so hammer the accessor from several threads while
+	// samples keep arriving. Each reader must only ever see time move forward, and never a torn model far from the truth.
+	std::atomic<double> ConcurrentLocalSeconds{0.0};
+	FOnlineServerClockAccelByte ConcurrentClock([&ConcurrentLocalSeconds]() { return ConcurrentLocalSeconds.load(); });
+	ConcurrentClock.AddSample(FDateTime(GetTrueServerTicks(0.0)), 0.0, 0.0);
+
+	const int32 ReaderCount = 4;
+	const int32 WriterSampleCount = 500;
+	std::atomic<int32> BackwardsReadCount{0};
+	std::atomic<int32> InaccurateReadCount{0};
+	ParallelFor(ReaderCount + 1, [&](int32 Index) {
+		if (Index == 0)
+		{
+			for (int32 SampleIndex = 1; SampleIndex <= WriterSampleCount; SampleIndex++)
+			{
+				const double SentSeconds = SampleIndex * 0.1;
+				ConcurrentClock.AddSample(FDateTime(GetTrueServerTicks(SentSeconds + 0.025)), SentSeconds, SentSeconds + 0.05);
+				ConcurrentLocalSeconds.store(SentSeconds + 0.05);
+			}
+			return;
+		}
+
+		int64 LastTicks = 0;
+		for (int32 ReadIndex = 0; ReadIndex < 20000; ReadIndex++)
+		{
+			const double LocalSecondsBefore = ConcurrentLocalSeconds.load();
+			const int64 Ticks = ConcurrentClock.GetServerUtcNowTicks();
+			const double LocalSecondsAfter = ConcurrentLocalSeconds.load();
+			if (Ticks < LastTicks)
+			{
+				BackwardsReadCount++;
+			}
+			LastTicks = Ticks;
+
+			// The local clock may have moved while we read, so accept anything between the truth before and after
+			const int64 ToleranceTicks = ETimespan::TicksPerMillisecond * 50;
+			if (Ticks < GetTrueServerTicks(LocalSecondsBefore) - ToleranceTicks || Ticks > GetTrueServerTicks(LocalSecondsAfter) + ToleranceTicks)
+			{
+				InaccurateReadCount++;
+			}
+		}
+	});
+
+	UE_LOG_AB(Log, TEXT("FExecTestServerClock concurrent reads: %d went backwards, %d were inaccurate"), BackwardsReadCount.load(), InaccurateReadCount.load());
+	Check(BackwardsReadCount.load() == 0, TEXT("concurrent readers should never see the estimated server time go backwards"));
+	Check(InaccurateReadCount.load() == 0, TEXT("concurrent readers should never see a torn model"));
+	Check(ConcurrentClock.GetSampleCount() > 0 && ConcurrentClock.IsSynced(), TEXT("clock should stay synced while samples are added concurrently"));
+
+	return ReportResult(TEXT("FExecTestServerClock"));
+}
+
+#endif
@@ -0,0 +1,33 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for FOnlineServerClockAccelByte, feeding samples from a simulated server clock with a fixed offset and drift
+ * through a simulated local clock. Checks that outliers are ignored, that drift is modelled, and that the estimated time
+ * never goes backwards, including for lock free readers racing a writer that keeps adding samples.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST TIME CLOCK
+ */
+class FExecTestServerClock : public FExecTestBase, public TSharedFromThis<FExecTestServerClock>
+{
+public:
+
+	/**
+	 * Constructs an instance of the server clock test case.
+	 */
+	FExecTestServerClock(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
@@ -0,0 +1,115 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestServerHeartbeat.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineServerHeartbeatAccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Core/AccelByteRegistry.h"
+#include "GameServerApi/AccelByteServerWatchdogApi.h"
+#include "GameServerApi/AccelByteServerDSHubApi.h"
+#include "HAL/PlatformProcess.h"
+
+namespace
+{
+	/** Seconds to wait for the stand-in connections to be established before failing the check */
+	constexpr float ConnectTimeoutSeconds = 10.0f;
+
+	/** Seconds between heartbeats while the test runs, kept short so that a few seconds of blocking covers many of them */
+	constexpr float TestIntervalSeconds = 0.1f;
+
+	/** Server name that the test connects to the DS hub stand-in with */
+	const FString TestServerName = TEXT("exec-test-server");
+}
+
+FExecTestServerHeartbeat::FExecTestServerHeartbeat(UWorld* InWorld, const FName& InSubsystemName, float InBlockSeconds)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, BlockSeconds(InBlockSeconds)
+{
+}
+
+bool FExecTestServerHeartbeat::Run()
+{
+	if (!Check(!FRegistry::ServerWatchdog.IsConnected() && !FRegistry::ServerDSHub.IsConnected(), TEXT("server has not connected to the watchdog or DS hub yet")))
+	{
+		bIsComplete = true;
+		return ReportResult(TEXT("FExecTestServerHeartbeat"));
+	}
+
+	WatchdogStandIn = MakeUnique<FExecTestStandInWebSocketServer>(TEXT("ExecTestWatchdogStandIn"));
+	DSHubStandIn = MakeUnique<FExecTestStandInWebSocketServer>(TEXT("ExecTestDSHubStandIn"));
+	if (!Check(WatchdogStandIn->StartServer() && DSHubStandIn->StartServer(), TEXT("stand-in endpoints start listening")))
+	{
+		bIsComplete = true;
+		return ReportResult(TEXT("FExecTestServerHeartbeat"));
+	}
+
+	PreviousWatchdogServerUrl = FRegistry::ServerSettings.WatchdogServerUrl;
+	PreviousDSHubServerUrl = FRegistry::ServerSettings.DSHubServerUrl;
+	FRegistry::ServerSettings.WatchdogServerUrl = WatchdogStandIn->GetUrl();
+	FRegistry::ServerSettings.DSHubServerUrl = DSHubStandIn->GetUrl();
+	FRegistry::ServerWatchdog.Connect();
+	FRegistry::ServerDSHub.Connect(TestServerName);
+
+	// Connections are driven by the SDK's tick, so wait for them on later ticks rather than blocking here
+	WaitUntil([this]() {
+		return FRegistry::ServerWatchdog.IsConnected() && FRegistry::ServerDSHub.IsConnected();
+	}, [this](bool bIsConnected) {
+		if (Check(bIsConnected, TEXT("watchdog and DS hub connect to their stand-ins")))
+		{
+			RunBlockedGameThread();
+		}
+		Finish();
+	}, ConnectTimeoutSeconds);
+	return true;
+}
+
+void FExecTestServerHeartbeat::RunBlockedGameThread()
+{
+	// Use a separate heartbeat from the subsystem's one, so that its interval and state are left alone
+	const TSharedRef<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe> Heartbeat = MakeShared<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe>(static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName)));
+	Heartbeat->SetHeartbeatInterval(TestIntervalSeconds);
+
+	// Block the game thread, as a long hitch would. Nothing else can send over either connection while it is blocked, so
+	// every message the stand-ins receive in the meantime came from the heartbeat thread.
+	const int32 WatchdogCountBeforeBlock = WatchdogStandIn->GetMessageCount();
+	const int32 DSHubCountBeforeBlock = DSHubStandIn->GetMessageCount();
+	Heartbeat->StartHeartbeat();
+	FPlatformProcess::Sleep(BlockSeconds);
+	const int64 HeartbeatsWhileBlocked = Heartbeat->GetHeartbeatCount();
+	const double SecondsSinceLastHeartbeat = Heartbeat->GetSecondsSinceLastHeartbeat();
+	Heartbeat->StopHeartbeat();
+	Check(!Heartbeat->IsHeartbeatRunning(), TEXT("heartbeat thread stops"));
+
+	// Messages sent just before the thread stopped may still be on their way, so give them a moment to land
+	FPlatformProcess::Sleep(TestIntervalSeconds * 5.0f);
+	const int32 WatchdogHeartbeatsWhileBlocked = WatchdogStandIn->GetMessageCount() - WatchdogCountBeforeBlock;
+	const int32 DSHubHeartbeatsWhileBlocked = DSHubStandIn->GetMessageCount() - DSHubCountBeforeBlock;
+
+	// Allow for a generous amount of scheduling jitter, a heartbeat sent from the game thread would send none at all here
+	const int32 ExpectedHeartbeats = FMath::FloorToInt(BlockSeconds / TestIntervalSeconds);
+	Check(HeartbeatsWhileBlocked >= ExpectedHeartbeats / 2, TEXT("heartbeats keep being sent while the game thread is blocked"));
+	Check(WatchdogHeartbeatsWhileBlocked >= ExpectedHeartbeats / 2, TEXT("watchdog heartbeats reach the stand-in while the game thread is blocked"));
+	Check(DSHubHeartbeatsWhileBlocked >= ExpectedHeartbeats / 2, TEXT("DS hub heartbeats reach the stand-in while the game thread is blocked"));
+	Check(SecondsSinceLastHeartbeat >= 0.0 && SecondsSinceLastHeartbeat < TestIntervalSeconds * 5.0, TEXT("last heartbeat is recent"));
+
+	UE_LOG_AB(Log, TEXT("FExecTestServerHeartbeat sent %lld heartbeat(s), %d reaching the watchdog and %d the DS hub, while the game thread was blocked for %.2f seconds (expected about %d)"), HeartbeatsWhileBlocked, WatchdogHeartbeatsWhileBlocked, DSHubHeartbeatsWhileBlocked, BlockSeconds, ExpectedHeartbeats);
+}
+
+void FExecTestServerHeartbeat::Finish()
+{
+	FRegistry::ServerWatchdog.Disconnect();
+	FRegistry::ServerDSHub.Disconnect();
+	FRegistry::ServerSettings.WatchdogServerUrl = PreviousWatchdogServerUrl;
+	FRegistry::ServerSettings.DSHubServerUrl = PreviousDSHubServerUrl;
+	WatchdogStandIn->StopServer();
+	DSHubStandIn->StopServer();
+
+	bIsComplete = true;
+	ReportResult(TEXT("FExecTestServerHeartbeat"));
+}
+
+#endif
@@ -0,0 +1,60 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+#include "ExecTestStandInWebSocketServer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for FOnlineServerHeartbeatAccelByte, connecting the watchdog and DS hub to local stand-ins, then blocking the
+ * game thread and checking that the default heartbeat keeps reaching both stand-ins from the heartbeat thread while it
+ * is blocked. Must be run before the server has connected to the watchdog or DS hub, as the test replaces both
+ * connections.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST SERVER HEARTBEAT <optional seconds to block the game thread for, defaults to 5>
+ */
+class FExecTestServerHeartbeat : public FExecTestBase, public TSharedFromThis<FExecTestServerHeartbeat>
+{
+public:
+
+	/**
+	 * Constructs an instance of the server heartbeat test case.
+	 * 
+	 * @param BlockSeconds Seconds to block the game thread for while heartbeats are being sent
+	 */
+	FExecTestServerHeartbeat(UWorld* InWorld, const FName& InSubsystemName, float InBlockSeconds);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Seconds to block the game thread for while heartbeats are being sent */
+	float BlockSeconds;
+
+	/** Stand-in for the watchdog websocket */
+	TUniquePtr<FExecTestStandInWebSocketServer> WatchdogStandIn;
+
+	/** Stand-in for the DS hub websocket */
+	TUniquePtr<FExecTestStandInWebSocketServer> DSHubStandIn;
+
+	/** Watchdog URL from the server settings before the test replaced it */
+	FString PreviousWatchdogServerUrl;
+
+	/** DS hub URL from the server settings before the test replaced it */
+	FString PreviousDSHubServerUrl;
+
+	/** Block the game thread while heartbeats are sent to the connected stand-ins, then check what reached them */
+	void RunBlockedGameThread();
+
+	/** Disconnect from the stand-ins, put the server settings back and report the result */
+	void Finish();
+
+};
+
+#endif
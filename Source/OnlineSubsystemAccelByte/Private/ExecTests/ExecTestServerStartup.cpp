@@ -0,0 +1,205 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestServerStartup.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSessionInterfaceV2AccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "Core/AccelByteRegistry.h"
+#include "GameServerApi/AccelByteServerDSHubApi.h"
+#include "Misc/ConfigCacheIni.h"
+
+namespace
+{
+	/** Seconds to wait for a connection or message to reach a stand-in before failing the check */
+	constexpr float StandInTimeoutSeconds = 10.0f;
+
+	/** Server name that the test connects to the DS hub stand-in with */
+	const FString TestServerName = TEXT("exec-test-server");
+
+	const FAccelByteServerStartupPhaseTiming* FindTiming(const TArray<FAccelByteServerStartupPhaseTiming>& Timings, EAccelByteServerStartupPhase Phase)
+	{
+		return Timings.FindByPredicate([Phase](const FAccelByteServerStartupPhaseTiming& Timing) {
+			return Timing.Phase == Phase;
+		});
+	}
+}
+
+FExecTestServerStartup::FExecTestServerStartup(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestServerStartup::Run()
+{
+	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World, SubsystemName);
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!Check(Subsystem != nullptr && FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface) && IsRunningDedicatedServer(), TEXT("running on a dedicated server using V2 sessions"))
+		|| !Check(!FRegistry::ServerDSHub.IsConnected() && !FRegistry::ServerWatchdog.IsConnected() && !SessionInterface->HasRequestedDSHubConnection(), TEXT("server has not connected to the DS hub or watchdog yet")))
+	{
+		bIsComplete = true;
+		return ReportResult(TEXT("FExecTestServerStartup"));
+	}
+
+	DSHubStandIn = MakeUnique<FExecTestStandInWebSocketServer>(TEXT("ExecTestDSHubStandIn"));
+	WatchdogStandIn = MakeUnique<FExecTestStandInWebSocketServer>(TEXT("ExecTestWatchdogStandIn"));
+	RefusedStandIn = MakeUnique<FExecTestStandInWebSocketServer>(TEXT("ExecTestRefusedStandIn"));
+	if (!Check(DSHubStandIn->StartServer() && WatchdogStandIn->StartServer() && RefusedStandIn->StartServer(), TEXT("stand-in endpoints start listening")))
+	{
+		bIsComplete = true;
+		return ReportResult(TEXT("FExecTestServerStartup"));
+	}
+	RefusedStandIn->StopServer();
+
+	PreviousDSHubServerUrl = FRegistry::ServerSettings.DSHubServerUrl;
+	PreviousWatchdogServerUrl = FRegistry::ServerSettings.WatchdogServerUrl;
+	FRegistry::ServerSettings.DSHubServerUrl = DSHubStandIn->GetUrl();
+	FRegistry::ServerSettings.WatchdogServerUrl = WatchdogStandIn->GetUrl();
+
+	RegisterStartTimeInSeconds = FPlatformTime::Seconds();
+	SessionInterface->RegisterServer(NAME_GameSession, FOnRegisterServerComplete::CreateSP(AsShared(), &FExecTestServerStartup::OnRegisterServerComplete));
+	return true;
+}
+
+void FExecTestServerStartup::OnRegisterServerComplete(bool bWasSuccessful)
+{
+	UE_LOG_AB(Log, TEXT("FExecTestServerStartup registration %s after %.3f seconds"), bWasSuccessful ? TEXT("succeeded") : TEXT("failed"), FPlatformTime::Seconds() - RegisterStartTimeInSeconds);
+
+	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World, SubsystemName);
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!Check(Subsystem != nullptr && FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface), TEXT("session interface is still available")))
+	{
+		Finish();
+		return;
+	}
+
+	const TArray<FAccelByteServerStartupPhaseTiming> Timings = SessionInterface->GetServerStartupTimings();
+	const FAccelByteServerStartupPhaseTiming* RegisterTiming = FindTiming(Timings, EAccelByteServerStartupPhase::RegisterServer);
+	const FAccelByteServerStartupPhaseTiming* DSHubTiming = FindTiming(Timings, EAccelByteServerStartupPhase::ConnectToDSHub);
+	Check(RegisterTiming != nullptr && RegisterTiming->IsComplete(), TEXT("registration phase is recorded as complete"));
+	Check(DSHubTiming != nullptr, TEXT("DS hub connection phase is recorded"));
+
+	// With overlapped startup the DS hub connection should start before registration finishes rather than after it
+	bool bOverlapServerStartup = true;
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bOverlapServerStartup"), bOverlapServerStartup, GEngineIni);
+	if (bOverlapServerStartup && RegisterTiming != nullptr && DSHubTiming != nullptr)
+	{
+		Check(DSHubTiming->StartSeconds <= RegisterTiming->EndSeconds, TEXT("DS hub connection starts alongside registration"));
+	}
+
+	WaitUntil([this]() {
+		return DSHubStandIn->GetOpenConnectionCount() > 0 && FRegistry::ServerDSHub.IsConnected();
+	}, [this, SessionInterface](bool bIsConnected) {
+		Check(bIsConnected, TEXT("DS hub connection reaches the stand-in"));
+
+		const TArray<FAccelByteServerStartupPhaseTiming> Timings = SessionInterface->GetServerStartupTimings();
+		const FAccelByteServerStartupPhaseTiming* DSHubTiming = FindTiming(Timings, EAccelByteServerStartupPhase::ConnectToDSHub);
+		Check(DSHubTiming != nullptr && DSHubTiming->IsComplete() && DSHubTiming->bWasSuccessful, TEXT("DS hub connection phase is recorded as succeeded"));
+		Check(SessionInterface->HasRequestedDSHubConnection(), TEXT("connected DS hub is not requested twice"));
+
+		RunDSHubRetry();
+	}, StandInTimeoutSeconds);
+}
+
+void FExecTestServerStartup::RunDSHubRetry()
+{
+	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World, SubsystemName);
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!Check(Subsystem != nullptr && FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface), TEXT("session interface is still available")))
+	{
+		Finish();
+		return;
+	}
+
+	// Point the DS hub at an endpoint that refuses connections, as though the DS hub were down
+	SessionInterface->DisconnectFromDSHub();
+	FRegistry::ServerSettings.DSHubServerUrl = RefusedStandIn->GetUrl();
+	SessionInterface->ConnectToDSHub(TestServerName);
+
+	WaitUntil([SessionInterface]() {
+		return !SessionInterface->HasRequestedDSHubConnection();
+	}, [this, SessionInterface](bool bCanRequestAgain) {
+		Check(bCanRequestAgain, TEXT("failed DS hub connection can be requested again"));
+
+		// Bring the DS hub back, the next request should reach it
+		const int32 ConnectionCountBeforeRetry = DSHubStandIn->GetConnectionCount();
+		FRegistry::ServerSettings.DSHubServerUrl = DSHubStandIn->GetUrl();
+		SessionInterface->ConnectToDSHub(TestServerName);
+
+		WaitUntil([this, ConnectionCountBeforeRetry]() {
+			return DSHubStandIn->GetConnectionCount() > ConnectionCountBeforeRetry && FRegistry::ServerDSHub.IsConnected();
+		}, [this, SessionInterface](bool bIsConnected) {
+			Check(bIsConnected, TEXT("DS hub connection requested again reaches the stand-in"));
+			Check(SessionInterface->HasRequestedDSHubConnection(), TEXT("DS hub connection requested again is tracked"));
+
+			RunReadyToWatchdog();
+		}, StandInTimeoutSeconds);
+	}, StandInTimeoutSeconds);
+}
+
+void FExecTestServerStartup::RunReadyToWatchdog()
+{
+	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World, SubsystemName);
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!Check(Subsystem != nullptr && FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface), TEXT("session interface is still available")))
+	{
+		Finish();
+		return;
+	}
+
+	if (!FRegistry::ServerWatchdog.IsConnected())
+	{
+		FRegistry::ServerWatchdog.Connect();
+	}
+
+	WaitUntil([this]() {
+		return WatchdogStandIn->GetOpenConnectionCount() > 0 && FRegistry::ServerWatchdog.IsConnected();
+	}, [this, SessionInterface](bool bIsConnected) {
+		if (!Check(bIsConnected, TEXT("watchdog connection reaches the stand-in")))
+		{
+			Finish();
+			return;
+		}
+
+		// Heartbeats may also arrive at the stand-in, so look for the ready message itself rather than any message
+		SessionInterface->SendReadyToWatchdog();
+		WaitUntil([this]() {
+			return WatchdogStandIn->GetMessages().ContainsByPredicate([](const FString& Message) {
+				return Message.Contains(TEXT("ready"), ESearchCase::IgnoreCase);
+			});
+		}, [this, SessionInterface](bool bWasReceived) {
+			Check(bWasReceived, TEXT("ready message reaches the watchdog stand-in"));
+
+			const TArray<FAccelByteServerStartupPhaseTiming> Timings = SessionInterface->GetServerStartupTimings();
+			const FAccelByteServerStartupPhaseTiming* ReadyTiming = FindTiming(Timings, EAccelByteServerStartupPhase::ReadyToWatchdog);
+			Check(ReadyTiming != nullptr && ReadyTiming->IsComplete(), TEXT("ready phase is recorded"));
+
+			Finish();
+		}, StandInTimeoutSeconds);
+	}, StandInTimeoutSeconds);
+}
+
+void FExecTestServerStartup::Finish()
+{
+	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World, SubsystemName);
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (Subsystem != nullptr && FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface))
+	{
+		SessionInterface->DisconnectFromDSHub();
+		SessionInterface->DisconnectFromWatchdog();
+		SessionInterface->LogServerStartupTimings();
+	}
+
+	FRegistry::ServerSettings.DSHubServerUrl = PreviousDSHubServerUrl;
+	FRegistry::ServerSettings.WatchdogServerUrl = PreviousWatchdogServerUrl;
+	DSHubStandIn->StopServer();
+	WatchdogStandIn->StopServer();
+
+	bIsComplete = true;
+	ReportResult(TEXT("FExecTestServerStartup"));
+}
+
+#endif
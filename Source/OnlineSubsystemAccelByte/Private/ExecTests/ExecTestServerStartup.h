@@ -0,0 +1,70 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+#include "ExecTestStandInWebSocketServer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the dedicated server startup pipeline in FOnlineSessionV2AccelByte::RegisterServer, run against local
+ * stand-in DS hub and watchdog endpoints rather than the real ones. Registers the server and checks that the DS hub
+ * connection starts alongside registration and reaches the stand-in, then checks that a failed DS hub connection can be
+ * requested again and that the ready message reaches the watchdog stand-in, along with the timing of each phase.
+ *
+ * Registration itself still talks to the backend, so its result is logged rather than checked. Must be run on a
+ * dedicated server that has not connected to the DS hub or watchdog yet, as the test replaces both connections.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST SERVER STARTUP
+ */
+class FExecTestServerStartup : public FExecTestBase, public TSharedFromThis<FExecTestServerStartup>
+{
+public:
+
+	/**
+	 * Constructs an instance of the server startup test case.
+	 */
+	FExecTestServerStartup(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Platform time in seconds that registration was requested */
+	double RegisterStartTimeInSeconds = 0.0;
+
+	/** Stand-in for the DS hub websocket */
+	TUniquePtr<FExecTestStandInWebSocketServer> DSHubStandIn;
+
+	/** Stand-in for the watchdog websocket */
+	TUniquePtr<FExecTestStandInWebSocketServer> WatchdogStandIn;
+
+	/** Stand-in that is stopped straight away, so that connections to it are refused like a DS hub that is down */
+	TUniquePtr<FExecTestStandInWebSocketServer> RefusedStandIn;
+
+	/** DS hub URL from the server settings before the test replaced it */
+	FString PreviousDSHubServerUrl;
+
+	/** Watchdog URL from the server settings before the test replaced it */
+	FString PreviousWatchdogServerUrl;
+
+	/** Delegate callback for when registering the server completes */
+	void OnRegisterServerComplete(bool bWasSuccessful);
+
+	/** Disconnect from the DS hub, fail to connect to an endpoint that is down, then connect to the stand-in again */
+	void RunDSHubRetry();
+
+	/** Connect to the watchdog stand-in and send it the ready message */
+	void RunReadyToWatchdog();
+
+	/** Disconnect from the stand-ins, put the server settings back and report the result */
+	void Finish();
+
+};
+
+#endif
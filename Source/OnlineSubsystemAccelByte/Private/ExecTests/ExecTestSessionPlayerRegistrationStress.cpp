@@ -0,0 +1,106 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestSessionPlayerRegistrationStress.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSessionInterfaceV2AccelByte.h"
+#include "OnlineSubsystemUtils.h"
+
+FExecTestSessionPlayerRegistrationStress::FExecTestSessionPlayerRegistrationStress(UWorld* InWorld, const FName& InSubsystemName, int32 InPlayersPerSession, int32 InSessionCount)
+	: FExecTestBase(InWorld, InSubsystemName)
+	, PlayersPerSession(InPlayersPerSession)
+	, SessionCount(InSessionCount)
+{
+}
+
+bool FExecTestSessionPlayerRegistrationStress::Run()
+{
+	bIsComplete = true;
+
+	const IOnlineSubsystem* Subsystem = Online::GetSubsystem(World, SubsystemName);
+	if (!Check(Subsystem != nullptr, TEXT("subsystem is available")))
+	{
+		return ReportResult(TEXT("FExecTestSessionPlayerRegistrationStress"));
+	}
+
+	const TSharedPtr<FOnlineSessionV2AccelByte, ESPMode::ThreadSafe> SessionInterface = StaticCastSharedPtr<FOnlineSessionV2AccelByte>(Subsystem->GetSessionInterface());
+	if (!Check(SessionInterface.IsValid(), TEXT("V2 session interface is available")))
+	{
+		return ReportResult(TEXT("FExecTestSessionPlayerRegistrationStress"));
+	}
+
+	const auto MakePlayerId = [](int32 SessionIndex, int32 PlayerIndex) -> FUniqueNetIdRef {
+		FAccelByteUniqueIdComposite CompositeId;
+		CompositeId.Id = FString::Printf(TEXT("%08x%024x"), SessionIndex, PlayerIndex);
+		return FUniqueNetIdAccelByteUser::Create(CompositeId);
+	};
+
+	const double StartTimeInSeconds = FPlatformTime::Seconds();
+	for (int32 SessionIndex = 0; SessionIndex < SessionCount; SessionIndex++)
+	{
+		const FName SessionName(*FString::Printf(TEXT("ExecTestStressSession%d"), SessionIndex));
+		const FString SessionId = FString::Printf(TEXT("exectest%024x"), SessionIndex);
+
+		// Set up a local session with just enough backend data for registration to update open connections
+		TSharedPtr<FAccelByteModelsV2GameSession> BackendSessionData = MakeShared<FAccelByteModelsV2GameSession>();
+		BackendSessionData->ID = SessionId;
+		TSharedRef<FOnlineSessionInfoAccelByteV2> SessionInfo = MakeShared<FOnlineSessionInfoAccelByteV2>(SessionId);
+		SessionInfo->SetBackendSessionData(BackendSessionData);
+
+		FOnlineSessionSettings SessionSettings;
+		SessionSettings.NumPublicConnections = PlayersPerSession;
+		FNamedOnlineSession* Session = SessionInterface->AddNamedSession(SessionName, SessionSettings);
+		SessionInterface->SetNamedSessionInfo(*Session, SessionInfo);
+		Session->NumOpenPublicConnections = PlayersPerSession;
+
+		TArray<FUniqueNetIdRef> Players;
+		Players.Reserve(PlayersPerSession);
+		for (int32 PlayerIndex = 0; PlayerIndex < PlayersPerSession; PlayerIndex++)
+		{
+			Players.Emplace(MakePlayerId(SessionIndex, PlayerIndex));
+		}
+
+		// Register everyone twice to make sure duplicates are ignored
+		SessionInterface->RegisterPlayers(SessionName, Players);
+		SessionInterface->RegisterPlayers(SessionName, Players);
+		Check(Session->RegisteredPlayers.Num() == PlayersPerSession && Session->NumOpenPublicConnections == 0, TEXT("registering the same players twice only registers them once"));
+
+		Check(SessionInterface->GetNamedSessionById(SessionId) == Session, TEXT("session is found by its ID"));
+
+		bool bAllPlayersFound = true;
+		for (const FUniqueNetIdRef& Player : Players)
+		{
+			bAllPlayersFound &= SessionInterface->IsPlayerInSession(SessionName, Player.Get());
+		}
+		Check(bAllPlayersFound, TEXT("every registered player is in the session"));
+
+		// Unregister and register a single player again, making sure membership follows each change straight away
+		SessionInterface->UnregisterPlayers(SessionName, { Players[0] });
+		Check(!SessionInterface->IsPlayerInSession(SessionName, Players[0].Get()) && Session->RegisteredPlayers.Num() == PlayersPerSession - 1, TEXT("unregistered player leaves the session"));
+		SessionInterface->RegisterPlayers(SessionName, { Players[0] });
+		Check(SessionInterface->IsPlayerInSession(SessionName, Players[0].Get()) && Session->RegisteredPlayers.Num() == PlayersPerSession, TEXT("player registered again is back in the session"));
+
+		// Replacing the session info moves the ID index over to the new ID
+		const FString ReplacedSessionId = FString::Printf(TEXT("exectestreplaced%016x"), SessionIndex);
+		TSharedRef<FOnlineSessionInfoAccelByteV2> ReplacedSessionInfo = MakeShared<FOnlineSessionInfoAccelByteV2>(ReplacedSessionId);
+		ReplacedSessionInfo->SetBackendSessionData(BackendSessionData);
+		SessionInterface->SetNamedSessionInfo(*Session, ReplacedSessionInfo);
+		Check(SessionInterface->GetNamedSessionById(ReplacedSessionId) == Session && SessionInterface->GetNamedSessionById(SessionId) == nullptr, TEXT("session is found by its new ID only"));
+
+		SessionInterface->UnregisterPlayers(SessionName, Players);
+		Check(Session->RegisteredPlayers.Num() == 0 && Session->NumOpenPublicConnections == PlayersPerSession, TEXT("session is empty after unregistering every player"));
+		Check(!SessionInterface->IsPlayerInSession(SessionName, Players.Last().Get()), TEXT("unregistered player is no longer in the session"));
+
+		SessionInterface->RemoveNamedSession(SessionName);
+		Check(SessionInterface->GetNamedSessionById(ReplacedSessionId) == nullptr, TEXT("removed session is no longer found by its ID"));
+	}
+
+	const double ElapsedTimeInSeconds = FPlatformTime::Seconds() - StartTimeInSeconds;
+	UE_LOG_AB(Log, TEXT("FExecTestSessionPlayerRegistrationStress cycled %d players across %d sessions in %.3f seconds"), PlayersPerSession * SessionCount, SessionCount, ElapsedTimeInSeconds);
+	return ReportResult(TEXT("FExecTestSessionPlayerRegistrationStress"));
+}
+
+#endif
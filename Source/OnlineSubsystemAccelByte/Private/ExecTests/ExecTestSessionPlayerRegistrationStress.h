@@ -0,0 +1,44 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Stress test for FOnlineSessionV2AccelByte::RegisterPlayers and FOnlineSessionV2AccelByte::UnregisterPlayers, registering
+ * and unregistering a large amount of players across several local sessions, as well as looking up each session by ID.
+ * Also replaces the session info of each session to check that the session ID index follows it.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST SESSION STRESS <optional player count per session, defaults to 2000> <optional session count, defaults to 8>
+ */
+class FExecTestSessionPlayerRegistrationStress : public FExecTestBase, public TSharedFromThis<FExecTestSessionPlayerRegistrationStress>
+{
+public:
+
+	/**
+	 * Constructs an instance of the session player registration stress test case.
+	 * 
+	 * @param PlayersPerSession Amount of players to register to each session
+	 * @param SessionCount Amount of local sessions to create for the test
+	 */
+	FExecTestSessionPlayerRegistrationStress(UWorld* InWorld, const FName& InSubsystemName, int32 InPlayersPerSession, int32 InSessionCount);
+
+	virtual bool Run() override;
+
+private:
+
+	/** Amount of players to register to each session */
+	int32 PlayersPerSession;
+
+	/** Amount of local sessions to create for the test */
+	int32 SessionCount;
+
+};
+
+#endif
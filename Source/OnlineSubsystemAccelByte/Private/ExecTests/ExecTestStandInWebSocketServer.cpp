@@ -0,0 +1,354 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestStandInWebSocketServer.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "IPAddress.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/Base64.h"
+#include "Misc/SecureHash.h"
+
+namespace StandInWebSocketServer
+{
+	/** GUID appended to the client's key when answering an upgrade request, as set out by RFC 6455 */
+	const FString AcceptKeyGuid = TEXT("258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+
+	constexpr uint8 OpcodeText = 0x1;
+	constexpr uint8 OpcodeBinary = 0x2;
+	constexpr uint8 OpcodeClose = 0x8;
+	constexpr uint8 OpcodePing = 0x9;
+	constexpr uint8 OpcodePong = 0xA;
+
+	/** Seconds the server thread sleeps between polls of its sockets */
+	constexpr float PollIntervalSeconds = 0.005f;
+}
+
+FExecTestStandInWebSocketServer::FExecTestStandInWebSocketServer(const FString& InName)
+	: Name(InName)
+{
+}
+
+FExecTestStandInWebSocketServer::~FExecTestStandInWebSocketServer()
+{
+	StopServer();
+}
+
+bool FExecTestStandInWebSocketServer::StartServer()
+{
+	if (ServerThread.IsValid())
+	{
+		return true;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (SocketSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	ListenSocket = SocketSubsystem->CreateSocket(NAME_Stream, *Name, false);
+	if (ListenSocket == nullptr)
+	{
+		return false;
+	}
+
+	// Bind to port zero so that the platform picks a free port, then read back which one it picked
+	TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+	Address->SetLoopbackAddress();
+	Address->SetPort(0);
+	if (!ListenSocket->Bind(*Address) || !ListenSocket->Listen(8) || !ListenSocket->SetNonBlocking(true))
+	{
+		SocketSubsystem->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+		return false;
+	}
+	Port = ListenSocket->GetPortNo();
+
+	bIsStopRequested = false;
+	ServerThread.Reset(FRunnableThread::Create(this, *FString::Printf(TEXT("%sThread"), *Name)));
+	UE_LOG_AB(Log, TEXT("Stand-in websocket server %s listening at %s"), *Name, *GetUrl());
+	return true;
+}
+
+void FExecTestStandInWebSocketServer::StopServer()
+{
+	if (!ServerThread.IsValid())
+	{
+		return;
+	}
+
+	// Kill calls Stop on us, then waits for Run to return and close every connection
+	ServerThread->Kill(true);
+	ServerThread.Reset();
+
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+	ListenSocket = nullptr;
+	UE_LOG_AB(Log, TEXT("Stand-in websocket server %s stopped"), *Name);
+}
+
+FString FExecTestStandInWebSocketServer::GetUrl() const
+{
+	return FString::Printf(TEXT("ws://127.0.0.1:%d"), Port);
+}
+
+int32 FExecTestStandInWebSocketServer::GetConnectionCount() const
+{
+	FScopeLock ScopeLock(&StatsLock);
+	return ConnectionCount;
+}
+
+int32 FExecTestStandInWebSocketServer::GetOpenConnectionCount() const
+{
+	FScopeLock ScopeLock(&StatsLock);
+	return OpenConnectionCount;
+}
+
+int32 FExecTestStandInWebSocketServer::GetMessageCount() const
+{
+	FScopeLock ScopeLock(&StatsLock);
+	return Messages.Num();
+}
+
+TArray<FString> FExecTestStandInWebSocketServer::GetMessages() const
+{
+	FScopeLock ScopeLock(&StatsLock);
+	return Messages;
+}
+
+uint32 FExecTestStandInWebSocketServer::Run()
+{
+	while (!bIsStopRequested)
+	{
+		bool bHasPendingConnection = false;
+		while (ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+		{
+			FSocket* AcceptedSocket = ListenSocket->Accept(*Name);
+			if (AcceptedSocket == nullptr)
+			{
+				break;
+			}
+
+			AcceptedSocket->SetNonBlocking(true);
+			FConnection& Connection = Connections.AddDefaulted_GetRef();
+			Connection.Socket = AcceptedSocket;
+		}
+
+		for (FConnection& Connection : Connections)
+		{
+			uint32 PendingBytes = 0;
+			while (Connection.Socket->HasPendingData(PendingBytes) && PendingBytes > 0)
+			{
+				const int32 Offset = Connection.ReceivedBytes.Num();
+				Connection.ReceivedBytes.AddUninitialized(PendingBytes);
+
+				int32 BytesRead = 0;
+				Connection.Socket->Recv(Connection.ReceivedBytes.GetData() + Offset, PendingBytes, BytesRead);
+				Connection.ReceivedBytes.SetNum(Offset + BytesRead, false);
+				if (BytesRead <= 0)
+				{
+					break;
+				}
+			}
+
+			if (!Connection.bIsUpgraded)
+			{
+				HandleUpgradeRequest(Connection);
+			}
+			if (Connection.bIsUpgraded)
+			{
+				HandleFrames(Connection);
+			}
+
+			if (Connection.Socket->GetConnectionState() == SCS_ConnectionError)
+			{
+				Connection.bIsClosed = true;
+			}
+		}
+
+		for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+		{
+			if (Connections[Index].bIsClosed)
+			{
+				if (Connections[Index].bIsUpgraded)
+				{
+					FScopeLock ScopeLock(&StatsLock);
+					OpenConnectionCount--;
+				}
+				CloseConnection(Connections[Index]);
+				Connections.RemoveAtSwap(Index);
+			}
+		}
+
+		FPlatformProcess::Sleep(StandInWebSocketServer::PollIntervalSeconds);
+	}
+
+	for (FConnection& Connection : Connections)
+	{
+		CloseConnection(Connection);
+	}
+	Connections.Empty();
+
+	FScopeLock ScopeLock(&StatsLock);
+	OpenConnectionCount = 0;
+	return 0;
+}
+
+void FExecTestStandInWebSocketServer::Stop()
+{
+	bIsStopRequested = true;
+}
+
+void FExecTestStandInWebSocketServer::HandleUpgradeRequest(FConnection& Connection)
+{
+	// Wait for the whole request, which ends with an empty line
+	const FUTF8ToTCHAR RequestConverter(reinterpret_cast<const ANSICHAR*>(Connection.ReceivedBytes.GetData()), Connection.ReceivedBytes.Num());
+	const FString Request(RequestConverter.Length(), RequestConverter.Get());
+	const int32 RequestEnd = Request.Find(TEXT("\r\n\r\n"));
+	if (RequestEnd == INDEX_NONE)
+	{
+		return;
+	}
+
+	FString ClientKey;
+	TArray<FString> Lines;
+	Request.Left(RequestEnd).ParseIntoArrayLines(Lines);
+	for (const FString& Line : Lines)
+	{
+		FString Header;
+		FString Value;
+		if (Line.Split(TEXT(":"), &Header, &Value) && Header.TrimStartAndEnd().Equals(TEXT("Sec-WebSocket-Key"), ESearchCase::IgnoreCase))
+		{
+			ClientKey = Value.TrimStartAndEnd();
+		}
+	}
+
+	if (ClientKey.IsEmpty())
+	{
+		Connection.bIsClosed = true;
+		return;
+	}
+
+	const FTCHARToUTF8 KeyConverter(*(ClientKey + StandInWebSocketServer::AcceptKeyGuid));
+	uint8 KeyHash[FSHA1::DigestSize];
+	FSHA1::HashBuffer(KeyConverter.Get(), KeyConverter.Length(), KeyHash);
+	const FString AcceptKey = FBase64::Encode(KeyHash, FSHA1::DigestSize);
+
+	const FString Response = FString::Printf(TEXT("HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n"), *AcceptKey);
+	const FTCHARToUTF8 ResponseConverter(*Response);
+	int32 BytesSent = 0;
+	Connection.Socket->Send(reinterpret_cast<const uint8*>(ResponseConverter.Get()), ResponseConverter.Length(), BytesSent);
+
+	// The request is plain ASCII, so its length in characters is also its length in bytes
+	Connection.ReceivedBytes.RemoveAt(0, RequestEnd + 4, false);
+	Connection.bIsUpgraded = true;
+
+	FScopeLock ScopeLock(&StatsLock);
+	ConnectionCount++;
+	OpenConnectionCount++;
+}
+
+void FExecTestStandInWebSocketServer::HandleFrames(FConnection& Connection)
+{
+	while (Connection.ReceivedBytes.Num() >= 2 && !Connection.bIsClosed)
+	{
+		const uint8* Bytes = Connection.ReceivedBytes.GetData();
+		const uint8 Opcode = Bytes[0] & 0x0F;
+		const bool bIsMasked = (Bytes[1] & 0x80) != 0;
+		uint64 PayloadLength = Bytes[1] & 0x7F;
+		int32 HeaderLength = 2;
+
+		if (PayloadLength == 126)
+		{
+			if (Connection.ReceivedBytes.Num() < 4)
+			{
+				return;
+			}
+			PayloadLength = (static_cast<uint64>(Bytes[2]) << 8) | Bytes[3];
+			HeaderLength = 4;
+		}
+		else if (PayloadLength == 127)
+		{
+			if (Connection.ReceivedBytes.Num() < 10)
+			{
+				return;
+			}
+			PayloadLength = 0;
+			for (int32 Index = 2; Index < 10; ++Index)
+			{
+				PayloadLength = (PayloadLength << 8) | Bytes[Index];
+			}
+			HeaderLength = 10;
+		}
+
+		const int32 MaskLength = bIsMasked ? 4 : 0;
+		const int64 FrameLength = HeaderLength + MaskLength + static_cast<int64>(PayloadLength);
+		if (Connection.ReceivedBytes.Num() < FrameLength)
+		{
+			return;
+		}
+
+		TArray<uint8> Payload(Bytes + HeaderLength + MaskLength, static_cast<int32>(PayloadLength));
+		if (bIsMasked)
+		{
+			const uint8* Mask = Bytes + HeaderLength;
+			for (int32 Index = 0; Index < Payload.Num(); ++Index)
+			{
+				Payload[Index] ^= Mask[Index % 4];
+			}
+		}
+		Connection.ReceivedBytes.RemoveAt(0, static_cast<int32>(FrameLength), false);
+
+		switch (Opcode)
+		{
+		case StandInWebSocketServer::OpcodeText:
+		case StandInWebSocketServer::OpcodeBinary:
+		{
+			const FUTF8ToTCHAR MessageConverter(reinterpret_cast<const ANSICHAR*>(Payload.GetData()), Payload.Num());
+			FScopeLock ScopeLock(&StatsLock);
+			Messages.Emplace(MessageConverter.Length(), MessageConverter.Get());
+			break;
+		}
+		case StandInWebSocketServer::OpcodePing:
+			SendFrame(Connection, StandInWebSocketServer::OpcodePong, Payload);
+			break;
+		case StandInWebSocketServer::OpcodeClose:
+			SendFrame(Connection, StandInWebSocketServer::OpcodeClose, Payload);
+			Connection.bIsClosed = true;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void FExecTestStandInWebSocketServer::SendFrame(FConnection& Connection, uint8 Opcode, const TArray<uint8>& Payload)
+{
+	// Control frames never carry more than 125 bytes, which is all this server sends
+	TArray<uint8> Frame;
+	Frame.Reserve(Payload.Num() + 2);
+	Frame.Add(0x80 | Opcode);
+	Frame.Add(static_cast<uint8>(FMath::Min(Payload.Num(), 125)));
+	Frame.Append(Payload.GetData(), FMath::Min(Payload.Num(), 125));
+
+	int32 BytesSent = 0;
+	Connection.Socket->Send(Frame.GetData(), Frame.Num(), BytesSent);
+}
+
+void FExecTestStandInWebSocketServer::CloseConnection(FConnection& Connection)
+{
+	if (Connection.Socket == nullptr)
+	{
+		return;
+	}
+
+	Connection.Socket->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Connection.Socket);
+	Connection.Socket = nullptr;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+class FSocket;
+
+/**
+ * Minimal websocket server listening on a local port, standing in for a backend websocket endpoint such as the DS hub or
+ * the watchdog so that server tests can run without a real backend.
+ *
+ * Runs on its own thread so that it keeps accepting connections and messages while the game thread is blocked. Accepts
+ * any upgrade request without checking credentials, answers pings and close frames, and records every text or binary
+ * message it receives. Nothing is ever sent to clients unprompted.
+ */
+class FExecTestStandInWebSocketServer : public FRunnable
+{
+public:
+
+	/**
+	 * Constructs a stand-in server that is not listening yet.
+	 *
+	 * @param InName Name used for the listen socket and thread, and in logs
+	 */
+	explicit FExecTestStandInWebSocketServer(const FString& InName);
+
+	virtual ~FExecTestStandInWebSocketServer() override;
+
+	/**
+	 * Start listening on a free loopback port and start the server thread.
+	 *
+	 * @return true if the server is listening, false otherwise
+	 */
+	bool StartServer();
+
+	/**
+	 * Close every connection and the listen socket, waiting for the server thread to exit. The port is refused from then
+	 * on, so a stopped server can also stand in for an endpoint that is down.
+	 */
+	void StopServer();
+
+	/**
+	 * Get the websocket URL that clients should connect to, valid once the server has been started.
+	 */
+	FString GetUrl() const;
+
+	/**
+	 * Get the amount of connections that completed the websocket upgrade.
+	 */
+	int32 GetConnectionCount() const;
+
+	/**
+	 * Get the amount of connections that are currently open.
+	 */
+	int32 GetOpenConnectionCount() const;
+
+	/**
+	 * Get the amount of text or binary messages received over every connection.
+	 */
+	int32 GetMessageCount() const;
+
+	/**
+	 * Get a copy of every text or binary message received, oldest first.
+	 */
+	TArray<FString> GetMessages() const;
+
+	//~ Begin FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable
+
+private:
+
+	/** Connection accepted by the server, along with bytes received that have not been handled yet */
+	struct FConnection
+	{
+		FSocket* Socket = nullptr;
+		TArray<uint8> ReceivedBytes;
+		bool bIsUpgraded = false;
+		bool bIsClosed = false;
+	};
+
+	/**
+	 * Answer the upgrade request at the start of the connection's received bytes once it has fully arrived.
+	 */
+	void HandleUpgradeRequest(FConnection& Connection);
+
+	/**
+	 * Handle every complete frame in the connection's received bytes.
+	 */
+	void HandleFrames(FConnection& Connection);
+
+	/**
+	 * Send a single unmasked frame to a connection.
+	 */
+	static void SendFrame(FConnection& Connection, uint8 Opcode, const TArray<uint8>& Payload);
+
+	/**
+	 * Close a connection's socket and release it.
+	 */
+	static void CloseConnection(FConnection& Connection);
+
+	/** Name used for the listen socket and thread, and in logs */
+	FString Name;
+
+	/** Socket listening for new connections, valid while the server is running */
+	FSocket* ListenSocket = nullptr;
+
+	/** Port that the server is listening on */
+	int32 Port = 0;
+
+	/** Thread that connections are serviced from, valid while the server is running */
+	TUniquePtr<FRunnableThread> ServerThread;
+
+	/** Whether the server thread has been asked to stop */
+	FThreadSafeBool bIsStopRequested = false;
+
+	/** Connections accepted by the server, only touched from the server thread */
+	TArray<FConnection> Connections;
+
+	/** Mutex used to lock the counts and messages while the server thread updates them */
+	mutable FCriticalSection StatsLock;
+
+	/** Amount of connections that completed the websocket upgrade */
+	int32 ConnectionCount = 0;
+
+	/** Amount of connections that are currently open */
+	int32 OpenConnectionCount = 0;
+
+	/** Every text or binary message received, oldest first */
+	TArray<FString> Messages;
+
+};
+
+#endif
@@ -0,0 +1,150 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestStoreCatalog.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineStoreInterfaceV2AccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "HAL/FileManager.h"
+#include "Async/ParallelFor.h"
+
+FExecTestStoreCatalog::FExecTestStoreCatalog(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestStoreCatalog::Run()
+{
+	bIsComplete = true;
+
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	if (!Check(Subsystem != nullptr, TEXT("the AccelByte subsystem is available")))
+	{
+		return ReportResult(TEXT("FExecTestStoreCatalog"));
+	}
+
+	// Snapshots are saved under languages that no real catalog uses, and cleared first in case an earlier run failed
+	const FString LanguageA = TEXT("ExecTestStoreCatalogA");
+	const FString LanguageB = TEXT("ExecTestStoreCatalogB");
+	const TSharedRef<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe> Store = MakeShared<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe>(Subsystem);
+	IFileManager::Get().Delete(*Store->GetCatalogSnapshotPath(LanguageA));
+	IFileManager::Get().Delete(*Store->GetCatalogSnapshotPath(LanguageB));
+	Store->SetOffersLanguage(LanguageA).Wait();
+	Store->ResetOffers();
+	Check(Store->GetOffersLanguage() == LanguageA, TEXT("the store switches to the requested language"));
+
+	const auto MakeOffer = [](const FString& OfferId, const FString& UpdatedAt, int64 Price) {
+		FOnlineStoreOfferRef Offer = MakeShared<FOnlineStoreOffer>();
+		Offer->OfferId = OfferId;
+		Offer->Title = FText::FromString(OfferId);
+		Offer->NumericPrice = Price;
+		Offer->RegularPrice = Price;
+		Offer->CurrencyCode = TEXT("VC");
+		Offer->DynamicFields.Add(TEXT("Sku"), OfferId + TEXT("-sku"));
+		Offer->DynamicFields.Add(TEXT("UpdatedAt"), UpdatedAt);
+		return Offer;
+	};
+
+	// Complete catalog fetch of three offers
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> Catalog;
+	Catalog.Add(TEXT("OfferA"), MakeOffer(TEXT("OfferA"), TEXT("2022-01-01T00:00:00.000Z"), 100));
+	Catalog.Add(TEXT("OfferB"), MakeOffer(TEXT("OfferB"), TEXT("2022-01-01T00:00:00.000Z"), 200));
+	Catalog.Add(TEXT("OfferC"), MakeOffer(TEXT("OfferC"), TEXT("2022-01-01T00:00:00.000Z"), 300));
+	Check(Store->MergeOffers(Catalog, true, LanguageA) == 3, TEXT("every offer of the first catalog fetch is added"));
+	const TSharedPtr<FOnlineStoreOffer> CachedOfferA = Store->GetOffer(TEXT("OfferA"));
+
+	// Refresh where OfferA is unchanged, OfferB has a new price and OfferC has been delisted
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> RefreshedCatalog;
+	RefreshedCatalog.Add(TEXT("OfferA"), MakeOffer(TEXT("OfferA"), TEXT("2022-01-01T00:00:00.000Z"), 100));
+	RefreshedCatalog.Add(TEXT("OfferB"), MakeOffer(TEXT("OfferB"), TEXT("2022-02-01T00:00:00.000Z"), 250));
+	Check(Store->MergeOffers(RefreshedCatalog, true, LanguageA) == 2, TEXT("only the changed and the delisted offer count as changes"));
+	Check(Store->GetOffer(TEXT("OfferA")) == CachedOfferA, TEXT("an unchanged offer keeps its cached instance"));
+	Check(Store->GetOffer(TEXT("OfferB")).IsValid() && Store->GetOffer(TEXT("OfferB"))->NumericPrice == 250, TEXT("a changed offer is replaced"));
+	Check(!Store->GetOffer(TEXT("OfferC")).IsValid(), TEXT("a delisted offer is removed by a complete catalog fetch"));
+
+	// Offers from a filtered query are never treated as the whole catalog, so nothing is removed
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> FilteredOffers;
+	FilteredOffers.Add(TEXT("OfferD"), MakeOffer(TEXT("OfferD"), TEXT("2022-01-01T00:00:00.000Z"), 400));
+	Check(Store->MergeOffers(FilteredOffers, false, LanguageA) == 1 && Store->GetOffer(TEXT("OfferA")).IsValid(), TEXT("a filtered query does not remove catalog offers"));
+
+	// Round trip the catalog through its snapshot
+	Check(Store->SaveCatalogSnapshot(LanguageA), TEXT("the catalog snapshot is saved"));
+	Store->ResetOffers();
+	Check(Store->LoadCatalogSnapshot(LanguageA) == 2, TEXT("only catalog offers are saved to the snapshot"));
+
+	const TSharedPtr<FOnlineStoreOffer> LoadedOfferB = Store->GetOffer(TEXT("OfferB"));
+	Check(LoadedOfferB.IsValid() && LoadedOfferB->NumericPrice == 250 && LoadedOfferB->CurrencyCode == TEXT("VC"), TEXT("prices survive the snapshot round trip"));
+	Check(LoadedOfferB.IsValid() && LoadedOfferB->DynamicFields.FindRef(TEXT("Sku")) == TEXT("OfferB-sku"), TEXT("dynamic fields survive the snapshot round trip"));
+	Check(Store->MergeOffers(RefreshedCatalog, true, LanguageA) == 0, TEXT("a refresh matching the snapshot changes nothing"));
+
+	// Switching language drops the cached offers, and a fetch still in flight from the old language is discarded
+	Store->SetOffersLanguage(LanguageB).Wait();
+	Check(!Store->GetOffer(TEXT("OfferA")).IsValid(), TEXT("offers cached in the old language are dropped on a language switch"));
+	Check(Store->MergeOffers(RefreshedCatalog, true, LanguageA) == 0 && !Store->GetOffer(TEXT("OfferA")).IsValid(), TEXT("offers fetched in the old language are not merged"));
+	Check(!Store->SaveCatalogSnapshot(LanguageA), TEXT("the old language's snapshot is not overwritten with offers from another language"));
+	Check(Store->LoadCatalogSnapshot(LanguageA) == 0, TEXT("the old language's snapshot is not loaded into the new language"));
+
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> CatalogB;
+	CatalogB.Add(TEXT("OfferA"), MakeOffer(TEXT("OfferA"), TEXT("2022-03-01T00:00:00.000Z"), 900));
+	Check(Store->MergeOffers(CatalogB, true, LanguageB) == 1 && Store->SaveCatalogSnapshot(LanguageB), TEXT("the new language's catalog is merged and saved"));
+
+	// Switching back loads the snapshot of that language in the background, untouched by the other language
+	const int32 SwitchedBackOffers = Store->SetOffersLanguage(LanguageA).Get();
+	if (Store->IsCatalogSnapshotEnabled())
+	{
+		Check(SwitchedBackOffers == 2, TEXT("switching back loads the old language's snapshot in the background"));
+	}
+	else
+	{
+		Store->LoadCatalogSnapshot(LanguageA);
+	}
+	Check(Store->GetOffer(TEXT("OfferA")).IsValid() && Store->GetOffer(TEXT("OfferA"))->NumericPrice == 100, TEXT("switching back restores the old language's snapshot"));
+	Check(Store->GetOffer(TEXT("OfferB")).IsValid() && Store->GetOffer(TEXT("OfferB"))->NumericPrice == 250, TEXT("the old language's snapshot holds its own prices"));
+
+	// A snapshot load landing after a complete catalog fetch must not bring back offers that the fetch delisted
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> CatalogWithoutB;
+	CatalogWithoutB.Add(TEXT("OfferA"), MakeOffer(TEXT("OfferA"), TEXT("2022-01-01T00:00:00.000Z"), 100));
+	Store->ResetOffers();
+	Store->MergeOffers(CatalogWithoutB, true, LanguageA);
+	Check(Store->LoadCatalogSnapshot(LanguageA) == 0 && !Store->GetOffer(TEXT("OfferB")).IsValid(), TEXT("a late snapshot load does not restore offers delisted by a complete catalog fetch"));
+
+	// Catalog refreshes saving from many threads at once must leave the snapshot matching the last catalog cached
+	ParallelFor(32, [&](int32 Index) {
+		TMap<FUniqueOfferId, FOnlineStoreOfferRef> ConcurrentCatalog;
+		ConcurrentCatalog.Add(TEXT("OfferA"), MakeOffer(TEXT("OfferA"), FString::Printf(TEXT("2023-01-01T00:00:%02d.000Z"), Index), 1000 + Index));
+		Store->MergeOffers(ConcurrentCatalog, true, LanguageA);
+		Store->SaveCatalogSnapshot(LanguageA);
+	});
+	const TSharedPtr<FOnlineStoreOffer> FinalOfferA = Store->GetOffer(TEXT("OfferA"));
+
+	const TSharedRef<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe> ReloadedStore = MakeShared<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe>(Subsystem);
+	ReloadedStore->SetOffersLanguage(LanguageA).Wait();
+	ReloadedStore->ResetOffers();
+	Check(ReloadedStore->LoadCatalogSnapshot(LanguageA) == 1, TEXT("the snapshot written by concurrent saves can be loaded"));
+	const TSharedPtr<FOnlineStoreOffer> ReloadedOfferA = ReloadedStore->GetOffer(TEXT("OfferA"));
+	Check(FinalOfferA.IsValid() && ReloadedOfferA.IsValid() && ReloadedOfferA->NumericPrice == FinalOfferA->NumericPrice, TEXT("the last snapshot written matches the last catalog cached"));
+
+	// Identical queries only share a request when they are for the same user and language
+	FAccelByteUniqueIdComposite CompositeIdA;
+	CompositeIdA.Id = TEXT("ExecTestStoreCatalogUserA");
+	FAccelByteUniqueIdComposite CompositeIdB;
+	CompositeIdB.Id = TEXT("ExecTestStoreCatalogUserB");
+	const FUniqueNetIdAccelByteUserRef UserA = FUniqueNetIdAccelByteUser::Create(CompositeIdA);
+	const FUniqueNetIdAccelByteUserRef UserB = FUniqueNetIdAccelByteUser::Create(CompositeIdB);
+	FOnlineStoreFilter Filter;
+	Filter.Keywords.Add(TEXT("Sword"));
+	const FString QueryKey = FOnlineStoreV2AccelByte::GetOfferQueryKey(UserA.Get(), Filter, LanguageA);
+	Check(QueryKey == FOnlineStoreV2AccelByte::GetOfferQueryKey(UserA.Get(), Filter, LanguageA), TEXT("the same query by the same user shares a key"));
+	Check(QueryKey != FOnlineStoreV2AccelByte::GetOfferQueryKey(UserB.Get(), Filter, LanguageA), TEXT("the same query by another user gets its own key"));
+	Check(QueryKey != FOnlineStoreV2AccelByte::GetOfferQueryKey(UserA.Get(), Filter, LanguageB), TEXT("the same query in another language gets its own key"));
+
+	IFileManager::Get().Delete(*Store->GetCatalogSnapshotPath(LanguageA));
+	IFileManager::Get().Delete(*Store->GetCatalogSnapshotPath(LanguageB));
+
+	return ReportResult(TEXT("FExecTestStoreCatalog"));
+}
+
+#endif
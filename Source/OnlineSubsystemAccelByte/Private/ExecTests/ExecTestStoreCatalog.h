@@ -0,0 +1,35 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the store catalog cache, checking that merging fetched offers only replaces changed offers, that
+ * delisted offers are removed by a complete catalog fetch, and that the catalog survives a round trip through its
+ * on-disk snapshot. Also checks that switching language never mixes offers or snapshots between languages, that
+ * snapshots saved from many threads at once end with the last catalog cached, and that query keys are per user.
+ * Works on its own store instances and snapshot languages, so the subsystem's store is left untouched.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST STORE CATALOG
+ */
+class FExecTestStoreCatalog : public FExecTestBase, public TSharedFromThis<FExecTestStoreCatalog>
+{
+public:
+
+	/**
+	 * Constructs an instance of the store catalog test case.
+	 */
+	FExecTestStoreCatalog(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
@@ -0,0 +1,160 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ExecTestStoreOfferDynamicData.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineStoreInterfaceV2AccelByte.h"
+#include "OnlineSubsystemUtils.h"
+#include "ExecTestBackendOverrides.h"
+
+FExecTestStoreOfferDynamicData::FExecTestStoreOfferDynamicData(UWorld* InWorld, const FName& InSubsystemName)
+	: FExecTestBase(InWorld, InSubsystemName)
+{
+}
+
+bool FExecTestStoreOfferDynamicData::Run()
+{
+	bIsComplete = true;
+
+	FOnlineSubsystemAccelByte* Subsystem = static_cast<FOnlineSubsystemAccelByte*>(Online::GetSubsystem(World, SubsystemName));
+	if (!Check(Subsystem != nullptr, TEXT("the AccelByte subsystem is available")))
+	{
+		return ReportResult(TEXT("FExecTestStoreOfferDynamicData"));
+	}
+
+	const TSharedRef<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe> Store = MakeShared<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe>(Subsystem);
+	Store->SetOfferDynamicDataFreshness(60.0);
+
+	// Fetches are held here rather than sent to the backend, and completed by the test the same way the task does
+	struct FHeldFetch
+	{
+		TArray<FUniqueOfferId> OfferIds;
+		FOnQueryOnlineStoreOffersComplete Delegate;
+	};
+	TArray<FHeldFetch> HeldFetches;
+	Subsystem->GetExecTestBackendOverrides().FetchOfferDynamicData = [&HeldFetches](const FUniqueNetIdAccelByteUserRef& UserId, const TArray<FUniqueOfferId>& OfferIds, const FOnQueryOnlineStoreOffersComplete& Delegate) {
+		HeldFetches.Add({ OfferIds, Delegate });
+	};
+
+	FAccelByteUniqueIdComposite CompositeId;
+	CompositeId.Id = TEXT("ExecTestStoreOfferDynamicDataUser");
+	const FUniqueNetIdAccelByteUserRef TestUserId = FUniqueNetIdAccelByteUser::Create(CompositeId);
+
+	const auto MakeDynamicData = [](const FString& OfferId, int32 Count) {
+		TSharedRef<FAccelByteModelsItemDynamicData> DynamicData = MakeShared<FAccelByteModelsItemDynamicData>();
+		DynamicData->ItemId = OfferId;
+		DynamicData->AvailableCount = Count;
+		return DynamicData;
+	};
+
+	const auto CompleteFetch = [&Store, &TestUserId, &MakeDynamicData](const FHeldFetch& Fetch, bool bWasSuccessful, int32 Count) {
+		if (bWasSuccessful)
+		{
+			for (const FUniqueOfferId& OfferId : Fetch.OfferIds)
+			{
+				Store->EmplaceOfferDynamicData(TestUserId.Get(), MakeDynamicData(OfferId, Count));
+			}
+		}
+		Fetch.Delegate.ExecuteIfBound(bWasSuccessful, bWasSuccessful ? Fetch.OfferIds : TArray<FUniqueOfferId>(), bWasSuccessful ? TEXT("") : TEXT("ExecTestStoreOfferDynamicData failure"));
+	};
+
+	Check(Store->GetOfferDynamicDataVersion(TestUserId.Get()) == 0, TEXT("the version starts at zero for a user with nothing cached"));
+	Check(!Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferA")), TEXT("an offer that was never fetched is not fresh"));
+
+	Store->EmplaceOfferDynamicData(TestUserId.Get(), MakeDynamicData(TEXT("OfferA"), 10));
+	Store->EmplaceOfferDynamicData(TestUserId.Get(), MakeDynamicData(TEXT("OfferB"), 5));
+	Check(Store->GetOfferDynamicDataVersion(TestUserId.Get()) == 2, TEXT("the version moves for each new offer"));
+	Check(Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferA")), TEXT("a fetched offer is fresh"));
+
+	const TSharedPtr<FAccelByteModelsItemDynamicData> CachedOfferA = Store->GetOfferDynamicData(TestUserId.Get(), TEXT("OfferA"));
+	Store->EmplaceOfferDynamicData(TestUserId.Get(), MakeDynamicData(TEXT("OfferA"), 10));
+	Check(Store->GetOfferDynamicDataVersion(TestUserId.Get()) == 2, TEXT("refetching identical dynamic data leaves the version alone"));
+	Check(Store->GetOfferDynamicData(TestUserId.Get(), TEXT("OfferA")) == CachedOfferA, TEXT("identical dynamic data keeps its cached instance"));
+
+	Store->EmplaceOfferDynamicData(TestUserId.Get(), MakeDynamicData(TEXT("OfferA"), 9));
+	Check(Store->GetOfferDynamicDataVersion(TestUserId.Get()) == 3, TEXT("changed dynamic data moves the version"));
+
+	// Queries made within a frame are held until the next tick, and fresh offers are answered without a request
+	int32 CompletedQueries = 0;
+	int32 FailedQueries = 0;
+	const FOnQueryOnlineStoreOffersComplete OnQueryComplete = FOnQueryOnlineStoreOffersComplete::CreateLambda(
+		[&CompletedQueries, &FailedQueries](bool bWasSuccessful, const TArray<FUniqueOfferId>& OfferIds, const FString& Error) {
+			CompletedQueries++;
+			FailedQueries += bWasSuccessful ? 0 : 1;
+		});
+	Store->QueryOfferDynamicData(TestUserId.Get(), TEXT("OfferA"), OnQueryComplete);
+	Store->QueryOffersDynamicData(TestUserId.Get(), { TEXT("OfferA"), TEXT("OfferB") }, OnQueryComplete);
+	Check(CompletedQueries == 0, TEXT("queries are not answered before the next tick"));
+	Store->Tick(0.0f);
+	Check(CompletedQueries == 2 && FailedQueries == 0 && HeldFetches.Num() == 0, TEXT("queries for fresh offers are answered from the cache on the next tick"));
+
+	// A completed order makes the offer stale straight away, without waiting for the freshness window
+	Store->InvalidateOfferDynamicData(TestUserId.Get(), TEXT("OfferA"));
+	Check(!Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferA")), TEXT("an invalidated offer is no longer fresh"));
+	Check(Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferB")), TEXT("invalidating one offer leaves the others fresh"));
+
+	// Queries on later ticks for an offer that is already being fetched wait on that fetch rather than sending another
+	CompletedQueries = 0;
+	Store->QueryOfferDynamicData(TestUserId.Get(), TEXT("OfferA"), OnQueryComplete);
+	Store->Tick(0.0f);
+	Check(HeldFetches.Num() == 1 && HeldFetches[0].OfferIds == TArray<FUniqueOfferId>{ TEXT("OfferA") }, TEXT("only the stale offer is fetched"));
+	Store->QueryOfferDynamicData(TestUserId.Get(), TEXT("OfferA"), OnQueryComplete);
+	Store->QueryOffersDynamicData(TestUserId.Get(), { TEXT("OfferA"), TEXT("OfferB") }, OnQueryComplete);
+	Store->Tick(0.0f);
+	Check(HeldFetches.Num() == 1 && CompletedQueries == 0, TEXT("queries for an offer in flight wait on its fetch"));
+	CompleteFetch(HeldFetches[0], true, 8);
+	Check(CompletedQueries == 3 && FailedQueries == 0, TEXT("every query waiting on a fetch is answered once when it completes"));
+	Check(Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferA")), TEXT("a completed fetch makes the offer fresh again"));
+	HeldFetches.Reset();
+
+	// An order completing while a fetch is in flight leaves the offer stale, as the fetch may predate the order
+	CompletedQueries = 0;
+	Store->InvalidateOfferDynamicData(TestUserId.Get(), TEXT("OfferA"));
+	Store->QueryOfferDynamicData(TestUserId.Get(), TEXT("OfferA"), OnQueryComplete);
+	Store->Tick(0.0f);
+	Store->InvalidateOfferDynamicData(TestUserId.Get(), TEXT("OfferA"));
+	Store->QueryOfferDynamicData(TestUserId.Get(), TEXT("OfferA"), OnQueryComplete);
+	Store->Tick(0.0f);
+	Check(HeldFetches.Num() == 2, TEXT("a query after an invalidation starts a new fetch instead of waiting on the old one"));
+	if (HeldFetches.Num() == 2)
+	{
+		CompleteFetch(HeldFetches[0], true, 8);
+		Check(!Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferA")), TEXT("a fetch sent before the invalidation does not make the offer fresh"));
+		CompleteFetch(HeldFetches[1], true, 7);
+		Check(Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferA")), TEXT("a fetch sent after the invalidation makes the offer fresh"));
+		Check(Store->GetOfferDynamicData(TestUserId.Get(), TEXT("OfferA"))->AvailableCount == 7, TEXT("the dynamic data fetched after the order is cached"));
+	}
+	Check(CompletedQueries == 2 && FailedQueries == 0, TEXT("queries on both fetches are answered"));
+	HeldFetches.Reset();
+
+	// A failed fetch fails its waiting queries and is not counted as in flight any more, so the next query retries
+	CompletedQueries = 0;
+	Store->InvalidateOfferDynamicData(TestUserId.Get(), TEXT("OfferA"));
+	Store->QueryOffersDynamicData(TestUserId.Get(), { TEXT("OfferA"), TEXT("OfferB") }, OnQueryComplete);
+	Store->Tick(0.0f);
+	if (Check(HeldFetches.Num() == 1, TEXT("the stale offer is fetched")))
+	{
+		CompleteFetch(HeldFetches[0], false, 0);
+	}
+	Check(CompletedQueries == 1 && FailedQueries == 1, TEXT("a failed fetch fails the query waiting on it"));
+	Store->QueryOfferDynamicData(TestUserId.Get(), TEXT("OfferA"), OnQueryComplete);
+	Store->Tick(0.0f);
+	Check(HeldFetches.Num() == 2, TEXT("an offer whose fetch failed is fetched again by the next query"));
+	if (HeldFetches.Num() == 2)
+	{
+		CompleteFetch(HeldFetches[1], true, 7);
+	}
+	HeldFetches.Reset();
+
+	Store->SetOfferDynamicDataFreshness(0.0);
+	Check(!Store->IsOfferDynamicDataFresh(TestUserId.Get(), TEXT("OfferB")), TEXT("an offer is stale once the freshness window has passed"));
+
+	Subsystem->GetExecTestBackendOverrides().Reset();
+
+	return ReportResult(TEXT("FExecTestStoreOfferDynamicData"));
+}
+
+#endif
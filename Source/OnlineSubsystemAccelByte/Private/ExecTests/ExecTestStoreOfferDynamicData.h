@@ -0,0 +1,35 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExecTestBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Test case for the offer dynamic data cache, checking freshness tracking, that the per user version only moves when
+ * dynamic data changes, and that batched queries for fresh offers are answered from the cache on the next tick. Also
+ * checks that queries for an offer already being fetched wait on that fetch, that an order invalidating an offer
+ * mid-fetch leaves it stale, and that a failed fetch is retried. Works on its own store instance with fetches held by
+ * the test, so the subsystem's store is left untouched and nothing is sent to the backend.
+ * 
+ * Console command for running is as follows:
+ * ONLINE TEST STORE DYNAMICDATA
+ */
+class FExecTestStoreOfferDynamicData : public FExecTestBase, public TSharedFromThis<FExecTestStoreOfferDynamicData>
+{
+public:
+
+	/**
+	 * Constructs an instance of the offer dynamic data test case.
+	 */
+	FExecTestStoreOfferDynamicData(UWorld* InWorld, const FName& InSubsystemName);
+
+	virtual bool Run() override;
+
+};
+
+#endif
@@ -4,16 +4,49 @@
 
 #include "OnlineAsyncTaskManagerAccelByte.h"
 #include "OnlineSubsystemAccelByte.h"
+#include "OnlineAsyncTaskMetricsAccelByte.h"
+#include "Misc/ConfigCacheIni.h"
 
 FOnlineAsyncTaskManagerAccelByte::FOnlineAsyncTaskManagerAccelByte(FOnlineSubsystemAccelByte* ParentSubsystem)
 	: AccelByteSubsystem(ParentSubsystem)
 {
+	TimerWheelSlots.SetNum(NumTimerWheelSlots);
+	LastTimerWheelTick = GetTimerWheelTick(FPlatformTime::Seconds());
+
+	int32 PollingIntervalMs = 0;
+	if (GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("AsyncTaskPollingIntervalMs"), PollingIntervalMs, GEngineIni) && PollingIntervalMs > 0)
+	{
+		PollingInterval = static_cast<uint32>(PollingIntervalMs);
+	}
 }
 
 void FOnlineAsyncTaskManagerAccelByte::OnlineTick()
 {
 	check(AccelByteSubsystem);
 	check(FPlatformTLS::GetCurrentThreadId() == OnlineThreadId);
+
+	// Advance the timer wheel before tasks are ticked, so that any task flagged as timed out is completed this tick
+	AdvanceTimerWheel(FPlatformTime::Seconds());
+
+	const FOnlineAsyncTaskMetricsAccelBytePtr Metrics = AccelByteSubsystem->GetAsyncTaskMetrics();
+	if (!Metrics.IsValid() || !Metrics->IsEnabled())
+	{
+		return;
+	}
+
+	int32 QueuedSerialTasks = 0;
+	{
+		FScopeLock ScopeLock(&InQueueLock);
+		QueuedSerialTasks = InQueue.Num();
+	}
+
+	int32 NumParallelTasks = 0;
+	{
+		FScopeLock ScopeLock(&ParallelTasksLock);
+		NumParallelTasks = ParallelTasks.Num();
+	}
+
+	Metrics->RecordQueueDepths(QueuedSerialTasks, NumParallelTasks);
 }
 
 void FOnlineAsyncTaskManagerAccelByte::CheckMaxParallelTasks()
@@ -25,3 +58,75 @@ void FOnlineAsyncTaskManagerAccelByte::CheckMaxParallelTasks()
 	}
 #endif
 }
+
+void FOnlineAsyncTaskManagerAccelByte::RegisterTaskTimeout(const FAccelByteAsyncTaskTimeoutRef& Timeout)
+{
+	FScopeLock ScopeLock(&TimerWheelLock);
+	ScheduleTimeout(Timeout);
+}
+
+void FOnlineAsyncTaskManagerAccelByte::WakeOnlineThread()
+{
+	if (WorkEvent != nullptr && FPlatformTLS::GetCurrentThreadId() != OnlineThreadId)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+void FOnlineAsyncTaskManagerAccelByte::AdvanceTimerWheel(double CurrentTimeInSeconds)
+{
+	FScopeLock ScopeLock(&TimerWheelLock);
+
+	const int64 CurrentTick = GetTimerWheelTick(CurrentTimeInSeconds);
+	if (CurrentTick <= LastTimerWheelTick)
+	{
+		return;
+	}
+
+	// If more than a whole revolution has passed since we last advanced, every slot is due, so visit each only once
+	const int64 FirstTick = FMath::Max(LastTimerWheelTick + 1, CurrentTick - NumTimerWheelSlots + 1);
+	LastTimerWheelTick = CurrentTick;
+
+	TArray<FAccelByteAsyncTaskTimeoutRef> DueTimeouts;
+	for (int64 Tick = FirstTick; Tick <= CurrentTick; Tick++)
+	{
+		TArray<FAccelByteAsyncTaskTimeoutRef>& Slot = TimerWheelSlots[Tick % NumTimerWheelSlots];
+		DueTimeouts.Append(Slot);
+		Slot.Reset();
+	}
+
+	for (const FAccelByteAsyncTaskTimeoutRef& Timeout : DueTimeouts)
+	{
+		if (!Timeout->bIsActive)
+		{
+			continue;
+		}
+
+		// Deadlines are pushed back without touching the wheel, so only now move a timeout that has had progress since
+		// it was scheduled, or one that is more than a revolution away, to the slot for its current deadline
+		if (Timeout->DeadlineInSeconds > CurrentTimeInSeconds)
+		{
+			ScheduleTimeout(Timeout);
+			continue;
+		}
+
+		Timeout->bHasTimedOut = true;
+		if (!Timeout->bCompleteOnTimeout)
+		{
+			Timeout->DeadlineInSeconds = CurrentTimeInSeconds + Timeout->TimeoutInSeconds;
+			ScheduleTimeout(Timeout);
+		}
+	}
+}
+
+void FOnlineAsyncTaskManagerAccelByte::ScheduleTimeout(const FAccelByteAsyncTaskTimeoutRef& Timeout)
+{
+	// Never schedule into a tick that has already been processed, as it would not be visited until the next revolution
+	const int64 DeadlineTick = FMath::Max(GetTimerWheelTick(Timeout->DeadlineInSeconds), LastTimerWheelTick + 1);
+	TimerWheelSlots[DeadlineTick % NumTimerWheelSlots].Add(Timeout);
+}
+
+int64 FOnlineAsyncTaskManagerAccelByte::GetTimerWheelTick(double TimeInSeconds) const
+{
+	return static_cast<int64>(FMath::FloorToDouble(TimeInSeconds / TimerWheelResolutionSeconds));
+}
@@ -0,0 +1,187 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineAsyncTaskMetricsAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "Misc/ConfigCacheIni.h"
+
+const double FAccelByteAsyncTaskLatencyHistogram::BucketUpperBoundsMs[FAccelByteAsyncTaskLatencyHistogram::NumBuckets - 1] = {
+	1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0, 10000.0, 30000.0, 60000.0
+};
+
+void FAccelByteAsyncTaskLatencyHistogram::AddSample(double SampleMs)
+{
+	int32 BucketIndex = 0;
+	while (BucketIndex < NumBuckets - 1 && SampleMs > BucketUpperBoundsMs[BucketIndex])
+	{
+		BucketIndex++;
+	}
+
+	BucketCounts[BucketIndex]++;
+	Count++;
+	TotalMs += SampleMs;
+	MaxMs = FMath::Max(MaxMs, SampleMs);
+}
+
+double FAccelByteAsyncTaskLatencyHistogram::GetMeanMs() const
+{
+	return (Count > 0) ? TotalMs / Count : 0.0;
+}
+
+double FAccelByteAsyncTaskLatencyHistogram::GetPercentileMs(double Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	// Rank of the sample that the percentile lands on, counting from one
+	const uint32 TargetRank = FMath::Max(1U, static_cast<uint32>(FMath::CeilToDouble(FMath::Clamp(Percentile, 0.0, 1.0) * Count)));
+	uint32 SamplesSeen = 0;
+	for (int32 BucketIndex = 0; BucketIndex < NumBuckets - 1; BucketIndex++)
+	{
+		SamplesSeen += BucketCounts[BucketIndex];
+		if (SamplesSeen >= TargetRank)
+		{
+			// Never report more than the largest sample actually seen
+			return FMath::Min(BucketUpperBoundsMs[BucketIndex], MaxMs);
+		}
+	}
+
+	return MaxMs;
+}
+
+FOnlineAsyncTaskMetricsAccelByte::FOnlineAsyncTaskMetricsAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	bool bEnableOnStartup = false;
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bEnableAsyncTaskMetrics"), bEnableOnStartup, GEngineIni);
+	SetEnabled(bEnableOnStartup);
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::SetEnabled(bool bInIsEnabled)
+{
+	FScopeLock ScopeLock(&MetricsLock);
+	if (bInIsEnabled && !bIsEnabled && TaskNameToMetrics.Num() == 0)
+	{
+		RecordingStartTimeInSeconds = FPlatformTime::Seconds();
+	}
+	bIsEnabled = bInIsEnabled;
+}
+
+FAccelByteAsyncTaskMetricsSnapshot FOnlineAsyncTaskMetricsAccelByte::GetSnapshot() const
+{
+	FAccelByteAsyncTaskMetricsSnapshot Snapshot;
+
+	{
+		FScopeLock ScopeLock(&MetricsLock);
+		Snapshot.RecordedSeconds = (RecordingStartTimeInSeconds > 0.0) ? FPlatformTime::Seconds() - RecordingStartTimeInSeconds : 0.0;
+		Snapshot.QueuedSerialTasks = QueuedSerialTasks;
+		Snapshot.PeakQueuedSerialTasks = PeakQueuedSerialTasks;
+		Snapshot.ParallelTasks = ParallelTasks;
+		Snapshot.PeakParallelTasks = PeakParallelTasks;
+		TaskNameToMetrics.GenerateValueArray(Snapshot.TaskClasses);
+	}
+
+	Snapshot.TaskClasses.Sort([](const FAccelByteAsyncTaskClassMetrics& A, const FAccelByteAsyncTaskClassMetrics& B) {
+		return A.Execution.TotalMs > B.Execution.TotalMs;
+	});
+
+	return Snapshot;
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::Reset()
+{
+	FScopeLock ScopeLock(&MetricsLock);
+	TaskNameToMetrics.Empty();
+	QueuedSerialTasks = 0;
+	PeakQueuedSerialTasks = 0;
+	ParallelTasks = 0;
+	PeakParallelTasks = 0;
+	RecordingStartTimeInSeconds = bIsEnabled ? FPlatformTime::Seconds() : 0.0;
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::Dump(FOutputDevice& Ar) const
+{
+	const FAccelByteAsyncTaskMetricsSnapshot Snapshot = GetSnapshot();
+
+	Ar.Logf(TEXT("AccelByte async task metrics (%s, recorded for %.1f s)"), bIsEnabled ? TEXT("enabled") : TEXT("disabled"), Snapshot.RecordedSeconds);
+	Ar.Logf(TEXT("Queued serial tasks: %d (peak %d); Parallel tasks: %d (peak %d)"), Snapshot.QueuedSerialTasks, Snapshot.PeakQueuedSerialTasks, Snapshot.ParallelTasks, Snapshot.PeakParallelTasks);
+
+	// Each latency column is p50/p95/max in milliseconds
+	Ar.Logf(TEXT("%-64s %8s %8s %8s %8s %8s %26s %26s %26s"), TEXT("Task"), TEXT("Started"), TEXT("OK"), TEXT("Failed"), TEXT("TimedOut"), TEXT("InFlight"), TEXT("QueueWait ms"), TEXT("Execution ms"), TEXT("TimeToDelegates ms"));
+
+	const auto FormatLatency = [](const FAccelByteAsyncTaskLatencyHistogram& Histogram) {
+		return FString::Printf(TEXT("%.0f/%.0f/%.0f"), Histogram.GetPercentileMs(0.5), Histogram.GetPercentileMs(0.95), Histogram.MaxMs);
+	};
+
+	for (const FAccelByteAsyncTaskClassMetrics& TaskMetrics : Snapshot.TaskClasses)
+	{
+		Ar.Logf(TEXT("%-64s %8u %8u %8u %8u %8u %26s %26s %26s")
+			, *TaskMetrics.TaskName
+			, TaskMetrics.Started
+			, TaskMetrics.Succeeded
+			, TaskMetrics.Failed
+			, TaskMetrics.TimedOut
+			, TaskMetrics.GetInFlight()
+			, *FormatLatency(TaskMetrics.QueueWait)
+			, *FormatLatency(TaskMetrics.Execution)
+			, *FormatLatency(TaskMetrics.TimeToDelegates));
+	}
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::RecordTaskStarted(const FString& TaskName, double QueueWaitSeconds)
+{
+	FScopeLock ScopeLock(&MetricsLock);
+	FAccelByteAsyncTaskClassMetrics& TaskMetrics = FindOrAddTaskMetrics(TaskName);
+	TaskMetrics.Started++;
+	TaskMetrics.QueueWait.AddSample(QueueWaitSeconds * 1000.0);
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::RecordTaskCompleted(const FString& TaskName, double ExecutionSeconds, bool bWasSuccessful, bool bTimedOut)
+{
+	FScopeLock ScopeLock(&MetricsLock);
+	FAccelByteAsyncTaskClassMetrics& TaskMetrics = FindOrAddTaskMetrics(TaskName);
+	if (bWasSuccessful)
+	{
+		TaskMetrics.Succeeded++;
+	}
+	else if (bTimedOut)
+	{
+		TaskMetrics.TimedOut++;
+	}
+	else
+	{
+		TaskMetrics.Failed++;
+	}
+	TaskMetrics.Execution.AddSample(ExecutionSeconds * 1000.0);
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::RecordTaskDelegatesTriggered(const FString& TaskName, double TimeToDelegatesSeconds)
+{
+	FScopeLock ScopeLock(&MetricsLock);
+	FindOrAddTaskMetrics(TaskName).TimeToDelegates.AddSample(TimeToDelegatesSeconds * 1000.0);
+}
+
+void FOnlineAsyncTaskMetricsAccelByte::RecordQueueDepths(int32 InQueuedSerialTasks, int32 InParallelTasks)
+{
+	FScopeLock ScopeLock(&MetricsLock);
+	QueuedSerialTasks = InQueuedSerialTasks;
+	PeakQueuedSerialTasks = FMath::Max(PeakQueuedSerialTasks, InQueuedSerialTasks);
+	ParallelTasks = InParallelTasks;
+	PeakParallelTasks = FMath::Max(PeakParallelTasks, InParallelTasks);
+}
+
+FAccelByteAsyncTaskClassMetrics& FOnlineAsyncTaskMetricsAccelByte::FindOrAddTaskMetrics(const FString& TaskName)
+{
+	FAccelByteAsyncTaskClassMetrics* FoundMetrics = TaskNameToMetrics.Find(TaskName);
+	if (FoundMetrics != nullptr)
+	{
+		return *FoundMetrics;
+	}
+
+	FAccelByteAsyncTaskClassMetrics& NewMetrics = TaskNameToMetrics.Add(TaskName);
+	NewMetrics.TaskName = TaskName;
+	return NewMetrics;
+}
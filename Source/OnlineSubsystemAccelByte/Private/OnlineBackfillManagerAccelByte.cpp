@@ -0,0 +1,451 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineBackfillManagerAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineSessionInterfaceV2AccelByte.h"
+#include "OnlineSubsystemAccelByteSessionSettings.h"
+#include "Misc/ConfigCacheIni.h"
+
+FOnlineBackfillManagerAccelByte::FOnlineBackfillManagerAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bAutoHandleBackfillProposals"), bIsEnabled, GEngineIni);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("BackfillMaxPlayersPerTeam"), MaxPlayersPerTeam, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("BackfillReservationTimeoutSeconds"), ReservationTimeoutSeconds, GEngineIni);
+
+	TArray<FString> ConfigTeamSizes;
+	GConfig->GetArray(TEXT("OnlineSubsystemAccelByte"), TEXT("BackfillMatchPoolTeamSizes"), ConfigTeamSizes, GEngineIni);
+	for (const FString& Entry : ConfigTeamSizes)
+	{
+		FString MatchPool;
+		FString SizesString;
+		if (!Entry.Split(TEXT(":"), &MatchPool, &SizesString, ESearchCase::IgnoreCase, ESearchDir::FromEnd) || MatchPool.IsEmpty())
+		{
+			UE_LOG_AB(Warning, TEXT("Ignoring BackfillMatchPoolTeamSizes entry '%s', expected the match pool name followed by ':' and each team's size"), *Entry);
+			continue;
+		}
+
+		TArray<FString> SizeStrings;
+		SizesString.ParseIntoArray(SizeStrings, TEXT(","));
+		TArray<int32> TeamSizes;
+		for (const FString& SizeString : SizeStrings)
+		{
+			const int32 TeamSize = FCString::Atoi(*SizeString.TrimStartAndEnd());
+			if (TeamSize > 0)
+			{
+				TeamSizes.Add(TeamSize);
+			}
+		}
+
+		if (TeamSizes.Num() > 0)
+		{
+			MatchPoolTeamSizes.Emplace(MatchPool.TrimStartAndEnd(), MoveTemp(TeamSizes));
+		}
+	}
+}
+
+void FOnlineBackfillManagerAccelByte::SetEnabled(bool bInIsEnabled)
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	bIsEnabled = bInIsEnabled;
+}
+
+bool FOnlineBackfillManagerAccelByte::IsEnabled() const
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	return bIsEnabled;
+}
+
+void FOnlineBackfillManagerAccelByte::SetMatchPoolTeamSizes(const FString& MatchPool, const TArray<int32>& TeamSizes)
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	if (TeamSizes.Num() > 0)
+	{
+		MatchPoolTeamSizes.Emplace(MatchPool, TeamSizes);
+	}
+	else
+	{
+		MatchPoolTeamSizes.Remove(MatchPool);
+	}
+}
+
+void FOnlineBackfillManagerAccelByte::SetPolicy(const FAccelByteBackfillPolicy& InPolicy)
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	Policy = InPolicy;
+	if (Policy)
+	{
+		bIsEnabled = true;
+	}
+}
+
+FAccelByteBackfillMetrics FOnlineBackfillManagerAccelByte::GetMetrics() const
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	return Metrics;
+}
+
+EAccelByteBackfillDecision FOnlineBackfillManagerAccelByte::DefaultPolicy(const FAccelByteBackfillProposalContext& Context)
+{
+	if (!Context.bFitsCapacity)
+	{
+		return EAccelByteBackfillDecision::Reject;
+	}
+
+	// If this proposal takes the last open slots, there is nothing left for matchmaking to backfill
+	return (Context.ProposedNewPlayers >= Context.GetOpenSlots()) ? EAccelByteBackfillDecision::AcceptAndStopBackfilling : EAccelByteBackfillDecision::Accept;
+}
+
+void FOnlineBackfillManagerAccelByte::HandleProposal(const FAccelByteModelsV2MatchmakingBackfillProposalNotif& Proposal)
+{
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!ensure(FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface)))
+	{
+		return;
+	}
+
+	// Proposals only carry the backfill ticket, so find the session that the ticket was created for. Sessions that were
+	// claimed before the ticket was stored in their settings fall back to the game session.
+	FName SessionName = NAME_GameSession;
+	FNamedOnlineSession* Session = SessionInterface->GetNamedSessionByBackfillTicketId(Proposal.BackfillTicketID);
+	if (Session != nullptr)
+	{
+		SessionName = Session->SessionName;
+	}
+	else if (SessionInterface->GetNamedSession(SessionName) == nullptr)
+	{
+		UE_LOG_AB(Warning, TEXT("Could not find a session for backfill ticket '%s', passing proposal '%s' to the game"), *Proposal.BackfillTicketID, *Proposal.ProposalID);
+		SessionInterface->TriggerOnBackfillProposalReceivedDelegates(Proposal);
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&BackfillLock);
+		FSessionBackfillState& State = SessionStates.FindOrAdd(SessionName);
+		State.QueuedProposals.Add({Proposal, FPlatformTime::Seconds()});
+
+		Metrics.ProposalsReceived++;
+		Metrics.PeakQueuedProposals = FMath::Max(Metrics.PeakQueuedProposals, State.QueuedProposals.Num());
+	}
+
+	ProcessNextProposal(SessionName);
+}
+
+void FOnlineBackfillManagerAccelByte::OnDeferredProposalDecided(const FName& SessionName, const FString& ProposalID, bool bHoldSlots)
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	FSessionBackfillState* State = SessionStates.Find(SessionName);
+	if (State == nullptr)
+	{
+		return;
+	}
+
+	TArray<FString> DeferredUserIds;
+	if (!State->DeferredProposalUserIds.RemoveAndCopyValue(ProposalID, DeferredUserIds))
+	{
+		// Not a proposal we deferred, such as one we decided on ourselves
+		return;
+	}
+
+	// Accepted players now have until the reservation timeout to join, counted from when matchmaking confirmed them
+	const double CurrentTimeInSeconds = FPlatformTime::Seconds();
+	for (const FString& UserId : DeferredUserIds)
+	{
+		if (bHoldSlots)
+		{
+			State->ReservedUserIds.Emplace(UserId, CurrentTimeInSeconds);
+		}
+		else
+		{
+			State->ReservedUserIds.Remove(UserId);
+		}
+	}
+}
+
+void FOnlineBackfillManagerAccelByte::RemoveSession(const FName& SessionName)
+{
+	FScopeLock ScopeLock(&BackfillLock);
+	const FSessionBackfillState* State = SessionStates.Find(SessionName);
+	if (State != nullptr && State->QueuedProposals.Num() > 0)
+	{
+		UE_LOG_AB(Verbose, TEXT("Dropping %d backfill proposal(s) for session '%s' as the session was removed"), State->QueuedProposals.Num(), *SessionName.ToString());
+	}
+
+	SessionStates.Remove(SessionName);
+}
+
+void FOnlineBackfillManagerAccelByte::ProcessNextProposal(const FName& SessionName)
+{
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface))
+	{
+		return;
+	}
+
+	// Deferred proposals are finished immediately, so keep going until a decision is in flight or the queue is empty
+	while (true)
+	{
+		FQueuedProposal NextProposal;
+		FAccelByteBackfillProposalContext Context;
+		TArray<FString> NewUserIds;
+		FAccelByteBackfillPolicy PolicyToApply;
+		{
+			FScopeLock ScopeLock(&BackfillLock);
+			FSessionBackfillState* State = SessionStates.Find(SessionName);
+			if (State == nullptr || State->bIsDecisionInFlight || State->QueuedProposals.Num() <= 0)
+			{
+				return;
+			}
+
+			NextProposal = State->QueuedProposals[0];
+			State->QueuedProposals.RemoveAt(0);
+
+			if (!BuildProposalContext(SessionName, *State, NextProposal, Context, NewUserIds))
+			{
+				// Session has gone away since the proposal was queued, nothing can be accepted into it anymore. Remaining
+				// proposals for it will expire on the backend.
+				UE_LOG_AB(Warning, TEXT("Dropping %d backfill proposal(s) for session '%s' as the session no longer exists"), State->QueuedProposals.Num() + 1, *SessionName.ToString());
+				SessionStates.Remove(SessionName);
+				return;
+			}
+
+			// Claim the session until this decision is acknowledged, so that the next proposal is evaluated against the
+			// slots left after this one rather than the same slots
+			State->bIsDecisionInFlight = true;
+			PolicyToApply = Policy;
+		}
+
+		// Policy is called outside of the lock so that it is free to query the manager or the session interface
+		const EAccelByteBackfillDecision Decision = PolicyToApply ? PolicyToApply(Context) : DefaultPolicy(Context);
+		UE_LOG_AB(Verbose, TEXT("Backfill proposal '%s' for session '%s' adds %d player(s) with %d open slot(s), decision: %d"), *NextProposal.Proposal.ProposalID, *SessionName.ToString(), Context.ProposedNewPlayers, Context.GetOpenSlots(), static_cast<int32>(Decision));
+
+		switch (Decision)
+		{
+		case EAccelByteBackfillDecision::Accept:
+		case EAccelByteBackfillDecision::AcceptAndStopBackfilling:
+		{
+			const bool bStopBackfilling = Decision == EAccelByteBackfillDecision::AcceptAndStopBackfilling;
+			SessionInterface->AcceptBackfillProposal(SessionName, NextProposal.Proposal, bStopBackfilling, FOnAcceptBackfillProposalComplete::CreateThreadSafeSP(AsShared(), &FOnlineBackfillManagerAccelByte::OnDecisionComplete, SessionName, NextProposal.Proposal.ProposalID, Decision, NewUserIds, NextProposal.ReceivedTimeInSeconds));
+			return;
+		}
+		case EAccelByteBackfillDecision::Reject:
+		case EAccelByteBackfillDecision::RejectAndStopBackfilling:
+		{
+			const bool bStopBackfilling = Decision == EAccelByteBackfillDecision::RejectAndStopBackfilling;
+			SessionInterface->RejectBackfillProposal(SessionName, NextProposal.Proposal, bStopBackfilling, FOnRejectBackfillProposalComplete::CreateThreadSafeSP(AsShared(), &FOnlineBackfillManagerAccelByte::OnDecisionComplete, SessionName, NextProposal.Proposal.ProposalID, Decision, TArray<FString>(), NextProposal.ReceivedTimeInSeconds));
+			return;
+		}
+		case EAccelByteBackfillDecision::Defer:
+		default:
+		{
+			{
+				FScopeLock ScopeLock(&BackfillLock);
+				FSessionBackfillState* State = SessionStates.Find(SessionName);
+				if (State != nullptr)
+				{
+					State->bIsDecisionInFlight = false;
+
+					// The game may still accept this proposal, so hold its players' slots until the game decides rather
+					// than letting the next proposal be evaluated against the same slots
+					const double CurrentTimeInSeconds = FPlatformTime::Seconds();
+					for (const FString& UserId : NewUserIds)
+					{
+						State->ReservedUserIds.Emplace(UserId, CurrentTimeInSeconds);
+					}
+					State->DeferredProposalUserIds.Emplace(NextProposal.Proposal.ProposalID, NewUserIds);
+				}
+			}
+
+			SessionInterface->TriggerOnBackfillProposalReceivedDelegates(NextProposal.Proposal);
+
+			FAccelByteBackfillDecisionResult Result;
+			Result.SessionName = SessionName;
+			Result.ProposalID = NextProposal.Proposal.ProposalID;
+			Result.Decision = EAccelByteBackfillDecision::Defer;
+			Result.bWasSuccessful = true;
+			Result.DecisionLatencyMs = (FPlatformTime::Seconds() - NextProposal.ReceivedTimeInSeconds) * 1000.0;
+			FinishDecision(Result);
+			break;
+		}
+		}
+	}
+}
+
+bool FOnlineBackfillManagerAccelByte::BuildProposalContext(const FName& SessionName, FSessionBackfillState& State, const FQueuedProposal& QueuedProposal, FAccelByteBackfillProposalContext& OutContext, TArray<FString>& OutNewUserIds) const
+{
+	FOnlineSessionV2AccelBytePtr SessionInterface;
+	if (!FOnlineSessionV2AccelByte::GetFromSubsystem(Subsystem, SessionInterface))
+	{
+		return false;
+	}
+
+	FNamedOnlineSession* Session = SessionInterface->GetNamedSession(SessionName);
+	if (Session == nullptr)
+	{
+		return false;
+	}
+
+	TSharedPtr<FOnlineSessionInfoAccelByteV2> SessionInfo = StaticCastSharedPtr<FOnlineSessionInfoAccelByteV2>(Session->SessionInfo);
+	if (!SessionInfo.IsValid())
+	{
+		return false;
+	}
+
+	const TArray<FUniqueNetIdRef> JoinedMembers = SessionInfo->GetJoinedMembers();
+	TSet<FString> JoinedUserIds;
+	JoinedUserIds.Reserve(JoinedMembers.Num());
+	for (const FUniqueNetIdRef& Member : JoinedMembers)
+	{
+		JoinedUserIds.Add(FUniqueNetIdAccelByteUser::CastChecked(Member)->GetAccelByteId());
+	}
+
+	// Players that have joined no longer need a reservation, and players that never turned up give their slot back
+	const double CurrentTimeInSeconds = FPlatformTime::Seconds();
+	for (TMap<FString, double>::TIterator It = State.ReservedUserIds.CreateIterator(); It; ++It)
+	{
+		if (JoinedUserIds.Contains(It.Key()) || CurrentTimeInSeconds - It.Value() >= ReservationTimeoutSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Deferred proposals that the game never decided on are forgotten once none of their players hold a slot anymore
+	for (TMap<FString, TArray<FString>>::TIterator It = State.DeferredProposalUserIds.CreateIterator(); It; ++It)
+	{
+		const bool bIsHoldingSlots = It.Value().ContainsByPredicate([&State](const FString& UserId) {
+			return State.ReservedUserIds.Contains(UserId);
+		});
+		if (!bIsHoldingSlots)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	OutContext.SessionName = SessionName;
+	OutContext.Proposal = QueuedProposal.Proposal;
+	OutContext.MaxPlayers = SessionInterface->GetSessionMaxPlayerCount(*Session);
+	OutContext.JoinedPlayers = JoinedUserIds.Num();
+	OutContext.ReservedPlayers = State.ReservedUserIds.Num();
+	OutContext.SecondsQueued = CurrentTimeInSeconds - QueuedProposal.ReceivedTimeInSeconds;
+
+	const TArray<FAccelByteModelsV2GameSessionTeam>& ProposedTeams = QueuedProposal.Proposal.ProposedTeams;
+	bool bFitsTeams = true;
+	OutContext.Teams.Reserve(ProposedTeams.Num());
+	for (int32 TeamIndex = 0; TeamIndex < ProposedTeams.Num(); TeamIndex++)
+	{
+		FAccelByteBackfillTeamCapacity& TeamCapacity = OutContext.Teams.AddDefaulted_GetRef();
+		TeamCapacity.TeamIndex = TeamIndex;
+		TeamCapacity.MaxPlayers = GetTeamMaxPlayers(*Session, TeamIndex, OutContext.MaxPlayers);
+
+		for (const auto& Party : ProposedTeams[TeamIndex].Parties)
+		{
+			for (const FString& UserId : Party.UserIDs)
+			{
+				if (JoinedUserIds.Contains(UserId) || State.ReservedUserIds.Contains(UserId))
+				{
+					TeamCapacity.CurrentPlayers++;
+				}
+				else
+				{
+					TeamCapacity.ProposedNewPlayers++;
+					OutNewUserIds.AddUnique(UserId);
+				}
+			}
+		}
+
+		if (TeamCapacity.ProposedNewPlayers > TeamCapacity.GetOpenSlots())
+		{
+			bFitsTeams = false;
+		}
+	}
+
+	OutContext.ProposedNewPlayers = OutNewUserIds.Num();
+	OutContext.bFitsCapacity = bFitsTeams && OutContext.ProposedNewPlayers <= OutContext.GetOpenSlots();
+	return true;
+}
+
+int32 FOnlineBackfillManagerAccelByte::GetTeamMaxPlayers(const FOnlineSession& Session, int32 TeamIndex, int32 SessionMaxPlayers) const
+{
+	// Proposals only list the teams that players are being added to, so the team count in a proposal says nothing about
+	// how big each team is meant to be. Sizes have to come from the match pool the session was made from.
+	FString MatchPool;
+	if (Session.SessionSettings.Get(SETTING_SESSION_MATCHPOOL, MatchPool) && !MatchPool.IsEmpty())
+	{
+		const TArray<int32>* TeamSizes = MatchPoolTeamSizes.Find(MatchPool);
+		if (TeamSizes != nullptr && TeamSizes->Num() > 0)
+		{
+			return (*TeamSizes)[FMath::Min(TeamIndex, TeamSizes->Num() - 1)];
+		}
+	}
+
+	return (MaxPlayersPerTeam > 0) ? MaxPlayersPerTeam : SessionMaxPlayers;
+}
+
+void FOnlineBackfillManagerAccelByte::OnDecisionComplete(bool bWasSuccessful, FName SessionName, FString ProposalID, EAccelByteBackfillDecision Decision, TArray<FString> NewUserIds, double ReceivedTimeInSeconds)
+{
+	{
+		FScopeLock ScopeLock(&BackfillLock);
+		FSessionBackfillState* State = SessionStates.Find(SessionName);
+		if (State != nullptr)
+		{
+			State->bIsDecisionInFlight = false;
+
+			// Only hold slots once matchmaking has confirmed the players are on their way
+			if (bWasSuccessful)
+			{
+				const double CurrentTimeInSeconds = FPlatformTime::Seconds();
+				for (const FString& UserId : NewUserIds)
+				{
+					State->ReservedUserIds.Emplace(UserId, CurrentTimeInSeconds);
+				}
+			}
+		}
+	}
+
+	FAccelByteBackfillDecisionResult Result;
+	Result.SessionName = SessionName;
+	Result.ProposalID = ProposalID;
+	Result.Decision = Decision;
+	Result.bWasSuccessful = bWasSuccessful;
+	Result.DecisionLatencyMs = (FPlatformTime::Seconds() - ReceivedTimeInSeconds) * 1000.0;
+	FinishDecision(Result);
+
+	ProcessNextProposal(SessionName);
+}
+
+void FOnlineBackfillManagerAccelByte::FinishDecision(const FAccelByteBackfillDecisionResult& Result)
+{
+	{
+		FScopeLock ScopeLock(&BackfillLock);
+		if (!Result.bWasSuccessful)
+		{
+			Metrics.DecisionsFailed++;
+		}
+		else if (Result.Decision == EAccelByteBackfillDecision::Defer)
+		{
+			Metrics.ProposalsDeferred++;
+		}
+		else if (Result.Decision == EAccelByteBackfillDecision::Accept || Result.Decision == EAccelByteBackfillDecision::AcceptAndStopBackfilling)
+		{
+			Metrics.ProposalsAccepted++;
+		}
+		else
+		{
+			Metrics.ProposalsRejected++;
+		}
+
+		LatencySampleCount++;
+		Metrics.LastDecisionLatencyMs = Result.DecisionLatencyMs;
+		Metrics.AverageDecisionLatencyMs += (Result.DecisionLatencyMs - Metrics.AverageDecisionLatencyMs) / static_cast<double>(LatencySampleCount);
+		Metrics.MaxDecisionLatencyMs = FMath::Max(Metrics.MaxDecisionLatencyMs, Result.DecisionLatencyMs);
+	}
+
+	if (!Result.bWasSuccessful)
+	{
+		UE_LOG_AB(Warning, TEXT("Decision on backfill proposal '%s' for session '%s' was not acknowledged by matchmaking"), *Result.ProposalID, *Result.SessionName.ToString());
+	}
+
+	TriggerOnBackfillDecisionCompleteDelegates(Result);
+}
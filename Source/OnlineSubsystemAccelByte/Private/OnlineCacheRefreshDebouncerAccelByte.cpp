@@ -0,0 +1,96 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineCacheRefreshDebouncerAccelByte.h"
+
+FOnlineCacheRefreshDebouncerAccelByte::FOnlineCacheRefreshDebouncerAccelByte(double InWindowSeconds)
+	: WindowSeconds(FMath::Max(InWindowSeconds, 0.0))
+{
+}
+
+void FOnlineCacheRefreshDebouncerAccelByte::Schedule(int32 LocalUserNum, const FString& Entry, double CurrentTimeInSeconds)
+{
+	FScopeLock ScopeLock(&QueueLock);
+
+	if (PendingRefreshes.Num() == 0)
+	{
+		FlushTimeInSeconds = CurrentTimeInSeconds + WindowSeconds;
+	}
+
+	TSet<FString>& Entries = PendingRefreshes.FindOrAdd(LocalUserNum);
+	if (Entries.Contains(TEXT("")))
+	{
+		// Everything is already being refreshed for this user
+		return;
+	}
+
+	if (Entry.IsEmpty())
+	{
+		Entries.Empty();
+	}
+	Entries.Add(Entry);
+}
+
+bool FOnlineCacheRefreshDebouncerAccelByte::Flush(double CurrentTimeInSeconds, TMap<int32, TSet<FString>>& OutRefreshes)
+{
+	FScopeLock ScopeLock(&QueueLock);
+
+	if (PendingRefreshes.Num() == 0 || CurrentTimeInSeconds < FlushTimeInSeconds)
+	{
+		return false;
+	}
+
+	OutRefreshes = MoveTemp(PendingRefreshes);
+	PendingRefreshes.Reset();
+	return true;
+}
+
+bool FOnlineCacheRefreshDebouncerAccelByte::IsPending(int32 LocalUserNum, const FString& Entry) const
+{
+	FScopeLock ScopeLock(&QueueLock);
+
+	const TSet<FString>* Entries = PendingRefreshes.Find(LocalUserNum);
+	return Entries != nullptr && (Entries->Contains(Entry) || Entries->Contains(TEXT("")));
+}
+
+int32 FOnlineCacheRefreshDebouncerAccelByte::Num() const
+{
+	FScopeLock ScopeLock(&QueueLock);
+
+	int32 Count = 0;
+	for (const TPair<int32, TSet<FString>>& Pair : PendingRefreshes)
+	{
+		Count += Pair.Value.Num();
+	}
+	return Count;
+}
+
+void FOnlineCacheRefreshDebouncerAccelByte::SetWindowSeconds(double InWindowSeconds)
+{
+	FScopeLock ScopeLock(&QueueLock);
+	WindowSeconds = FMath::Max(InWindowSeconds, 0.0);
+}
+
+void FOnlineCacheRefreshDebouncerAccelByte::Cancel(int32 LocalUserNum, const FString& Entry)
+{
+	FScopeLock ScopeLock(&QueueLock);
+
+	TSet<FString>* Entries = PendingRefreshes.Find(LocalUserNum);
+	if (Entries == nullptr)
+	{
+		return;
+	}
+
+	Entries->Remove(Entry);
+	if (Entries->Num() == 0)
+	{
+		PendingRefreshes.Remove(LocalUserNum);
+	}
+}
+
+void FOnlineCacheRefreshDebouncerAccelByte::Reset()
+{
+	FScopeLock ScopeLock(&QueueLock);
+	PendingRefreshes.Reset();
+}
@@ -16,6 +16,7 @@
 #include "AsyncTasks/Chat/OnlineAsyncTaskAccelByteChatQueryRoomById.h"
 #include "AsyncTasks/Chat/OnlineAsyncTaskAccelByteChatSendPersonalChat.h"
 #include "AsyncTasks/Chat/OnlineAsyncTaskAccelByteChatSendRoomChat.h"
+#include "Misc/ConfigCacheIni.h"
 
 bool FOnlineChatAccelByte::GetFromSubsystem(const IOnlineSubsystem* Subsystem, FOnlineChatAccelBytePtr& OutInterfaceInstance)
 {
@@ -37,7 +38,34 @@ bool FOnlineChatAccelByte::GetFromWorld(const UWorld* World, FOnlineChatAccelByt
 
 FOnlineChatAccelByte::FOnlineChatAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
 	: AccelByteSubsystem(InSubsystem)
-{}
+{
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("ChatMemberJoinBatchWindowSeconds"), MemberJoinBatchWindowSeconds, GEngineIni);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("ChatMemberJoinMaxBatchSize"), MemberJoinMaxBatchSize, GEngineIni);
+}
+
+void FOnlineChatAccelByte::Tick(float DeltaTime)
+{
+	TArray<FString> RoomIdsToQuery;
+	for (TPair<FString, FChatRoomMemberJoinQueue>& Entry : RoomIdToMemberJoinQueue)
+	{
+		if (Entry.Value.MemberIdsToQuery.Num() <= 0)
+		{
+			continue;
+		}
+
+		Entry.Value.SecondsUntilQuery -= DeltaTime;
+		if (Entry.Value.SecondsUntilQuery <= 0.0f)
+		{
+			RoomIdsToQuery.Add(Entry.Key);
+		}
+	}
+
+	// Query outside of the loop, as a failed query triggers joins straight away and may remove the queue from the map
+	for (const FString& RoomId : RoomIdsToQuery)
+	{
+		QueryChatRoomMemberJoins(RoomId);
+	}
+}
 
 bool FOnlineChatAccelByte::Connect(int32 LocalUserNum)
 {
@@ -211,11 +239,13 @@ void FOnlineChatAccelByte::GetJoinedRooms(const FUniqueNetId& UserId, TArray<FCh
 
 	const FUniqueNetIdAccelByteUserRef AccelByteUserId = FUniqueNetIdAccelByteUser::CastChecked(UserId);
 	const FString AccelByteId = AccelByteUserId->GetAccelByteId();
-	for (const auto& Entry : TopicIdToChatRoomInfoCached)
+	const TSet<FString>* JoinedTopicIds = UserIdToJoinedTopicIdsCached.Find(AccelByteId);
+	if (JoinedTopicIds != nullptr)
 	{
-		if (Entry.Value->HasMember(AccelByteId))
+		OutRooms.Reserve(OutRooms.Num() + JoinedTopicIds->Num());
+		for (const FString& TopicId : *JoinedTopicIds)
 		{
-			OutRooms.Add(Entry.Value->GetRoomId());
+			OutRooms.Add(TopicId);
 		}
 	}
 
@@ -398,23 +428,209 @@ bool FOnlineChatAccelByte::HasPersonalChat(const FString& FromUserId, const FStr
 	return ChatRoomInfo != nullptr;
 }
 
+void FOnlineChatAccelByte::AddMemberToTopic(const FString& UserId, const FString& TopicId)
+{
+	const FAccelByteChatRoomInfoRef* ChatRoomInfo = TopicIdToChatRoomInfoCached.Find(TopicId);
+	if (ChatRoomInfo != nullptr && (*ChatRoomInfo)->AddMember(UserId))
+	{
+		UserIdToJoinedTopicIdsCached.FindOrAdd(UserId).Add(TopicId);
+	}
+}
+
 void FOnlineChatAccelByte::RemoveMemberFromTopic(const FString& UserId, const FString& TopicId)
 {
 	const FAccelByteChatRoomInfoRef* ChatRoomInfo = TopicIdToChatRoomInfoCached.Find(TopicId);
-	if (ChatRoomInfo != nullptr)
+	if (ChatRoomInfo != nullptr && (*ChatRoomInfo)->RemoveMember(UserId))
 	{
-		(*ChatRoomInfo)->RemoveMember(UserId);
+		UnindexTopicMember(UserId, TopicId);
 	}
 }
 
 void FOnlineChatAccelByte::AddTopic(const FAccelByteChatRoomInfoRef& ChatRoomInfo)
 {
+	// Topics get re-added whenever they are queried again, so drop the members of the copy being replaced first
+	const FAccelByteChatRoomInfoRef* ExistingChatRoomInfo = TopicIdToChatRoomInfoCached.Find(ChatRoomInfo->GetRoomId());
+	if (ExistingChatRoomInfo != nullptr)
+	{
+		UnindexTopicMembers(*ExistingChatRoomInfo);
+	}
+
 	TopicIdToChatRoomInfoCached.Add(ChatRoomInfo->GetRoomId(), ChatRoomInfo);
+	IndexTopicMembers(ChatRoomInfo);
 }
 
 void FOnlineChatAccelByte::RemoveTopic(const FString& TopicId)
 {
-	TopicIdToChatRoomInfoCached.Remove(TopicId);
+	FAccelByteChatRoomInfoRef ChatRoomInfo = FAccelByteChatRoomInfo::Create();
+	if (TopicIdToChatRoomInfoCached.RemoveAndCopyValue(TopicId, ChatRoomInfo))
+	{
+		UnindexTopicMembers(ChatRoomInfo);
+	}
+}
+
+void FOnlineChatAccelByte::QueueChatRoomMemberJoin(int32 LocalUserNum, const TSharedPtr<const FUniqueNetId>& UserId, const FString& RoomId, const FString& MemberId)
+{
+	const bool bHasMemberInfo = HasChatRoomMemberInfo(MemberId);
+	FChatRoomMemberJoinQueue* Queue = RoomIdToMemberJoinQueue.Find(RoomId);
+	if (Queue == nullptr)
+	{
+		if (bHasMemberInfo)
+		{
+			const FUniqueNetIdAccelByteUserRef MemberUserId = FUniqueNetIdAccelByteUser::Create(FAccelByteUniqueIdComposite(MemberId));
+			TriggerOnChatRoomMemberJoinDelegates(*UserId, RoomId, *MemberUserId);
+			return;
+		}
+
+		Queue = &RoomIdToMemberJoinQueue.Add(RoomId);
+		Queue->LocalUserNum = LocalUserNum;
+		Queue->UserId = UserId;
+	}
+
+	// Joins queue up behind any that are still waiting on member info, even if we already know this member, so that
+	// delegates for the room fire in the order the joins were received
+	Queue->MemberIds.Add(MemberId);
+	if (!bHasMemberInfo && !Queue->MemberIdsAwaitingInfo.Contains(MemberId))
+	{
+		if (Queue->MemberIdsToQuery.Num() <= 0)
+		{
+			Queue->SecondsUntilQuery = MemberJoinBatchWindowSeconds;
+		}
+		Queue->MemberIdsAwaitingInfo.Add(MemberId);
+		Queue->MemberIdsToQuery.Add(MemberId);
+
+		if (Queue->MemberIdsToQuery.Num() >= MemberJoinMaxBatchSize)
+		{
+			QueryChatRoomMemberJoins(RoomId);
+			return;
+		}
+	}
+
+	TriggerChatRoomMemberJoins(RoomId);
+}
+
+void FOnlineChatAccelByte::QueryChatRoomMemberJoins(const FString& RoomId)
+{
+	FChatRoomMemberJoinQueue* Queue = RoomIdToMemberJoinQueue.Find(RoomId);
+	if (Queue == nullptr || Queue->MemberIdsToQuery.Num() <= 0)
+	{
+		return;
+	}
+
+	const TArray<FString> MemberIds = MoveTemp(Queue->MemberIdsToQuery);
+	Queue->MemberIdsToQuery.Reset();
+
+	const FOnlineUserCacheAccelBytePtr UserStore = AccelByteSubsystem->GetUserCache();
+	if (UserStore.IsValid())
+	{
+		UE_LOG_AB(Verbose, TEXT("Querying member info for %d member(s) that joined room %s"), MemberIds.Num(), *RoomId);
+		const FOnQueryUsersComplete OnQueryUsersCompleteDelegate = FOnQueryUsersComplete::CreateThreadSafeSP(SharedThis(this), &FOnlineChatAccelByte::OnQueryChatMemberInfo_TriggerChatRoomMemberJoins, RoomId, MemberIds);
+		if (UserStore->QueryUsersByAccelByteIds(Queue->LocalUserNum, MemberIds, OnQueryUsersCompleteDelegate))
+		{
+			return;
+		}
+	}
+
+	UE_LOG_AB(Warning, TEXT("Unable to get member info for members that joined room %s, triggering their joins without it!"), *RoomId);
+	for (const FString& MemberId : MemberIds)
+	{
+		Queue->MemberIdsAwaitingInfo.Remove(MemberId);
+	}
+	TriggerChatRoomMemberJoins(RoomId);
+}
+
+void FOnlineChatAccelByte::TriggerChatRoomMemberJoins(const FString& RoomId)
+{
+	FChatRoomMemberJoinQueue* Queue = RoomIdToMemberJoinQueue.Find(RoomId);
+	if (Queue == nullptr)
+	{
+		return;
+	}
+
+	int32 TriggeredCount = 0;
+	while (TriggeredCount < Queue->MemberIds.Num() && !Queue->MemberIdsAwaitingInfo.Contains(Queue->MemberIds[TriggeredCount]))
+	{
+		TriggeredCount++;
+	}
+
+	// Copy everything needed out of the queue before firing, as delegates may queue further joins and move the map
+	TArray<FString> MemberIdsToTrigger(Queue->MemberIds.GetData(), TriggeredCount);
+	Queue->MemberIds.RemoveAt(0, TriggeredCount, false);
+	const TSharedPtr<const FUniqueNetId> UserId = Queue->UserId;
+	if (Queue->MemberIds.Num() <= 0 && Queue->MemberIdsAwaitingInfo.Num() <= 0)
+	{
+		RoomIdToMemberJoinQueue.Remove(RoomId);
+	}
+
+	for (const FString& MemberId : MemberIdsToTrigger)
+	{
+		const FUniqueNetIdAccelByteUserRef MemberUserId = FUniqueNetIdAccelByteUser::Create(FAccelByteUniqueIdComposite(MemberId));
+		TriggerOnChatRoomMemberJoinDelegates(*UserId, RoomId, *MemberUserId);
+	}
+}
+
+bool FOnlineChatAccelByte::HasChatRoomMemberInfo(const FString& MemberId)
+{
+	const FAccelByteChatRoomMemberRef* MemberPtr = UserIdToChatRoomMemberCached.Find(MemberId);
+	if (MemberPtr != nullptr && (*MemberPtr)->HasNickname())
+	{
+		return true;
+	}
+
+	// The user cache may already have this member from another query, in which case we can skip querying them again
+	const FOnlineUserCacheAccelBytePtr UserStore = AccelByteSubsystem->GetUserCache();
+	if (!UserStore.IsValid())
+	{
+		return false;
+	}
+
+	const TSharedPtr<const FAccelByteUserInfo> CachedUser = UserStore->GetUser(FAccelByteUniqueIdComposite(MemberId));
+	if (!CachedUser.IsValid() || !CachedUser->Id.IsValid())
+	{
+		return false;
+	}
+
+	if (MemberPtr != nullptr)
+	{
+		(*MemberPtr)->SetNickname(CachedUser->DisplayName);
+	}
+	else
+	{
+		UserIdToChatRoomMemberCached.Add(MemberId, FAccelByteChatRoomMember::Create(CachedUser->Id.ToSharedRef(), CachedUser->DisplayName));
+	}
+	return true;
+}
+
+void FOnlineChatAccelByte::IndexTopicMembers(const FAccelByteChatRoomInfoRef& ChatRoomInfo)
+{
+	const FString& TopicId = ChatRoomInfo->GetRoomId();
+	for (const FString& MemberId : ChatRoomInfo->GetMembers())
+	{
+		UserIdToJoinedTopicIdsCached.FindOrAdd(MemberId).Add(TopicId);
+	}
+}
+
+void FOnlineChatAccelByte::UnindexTopicMembers(const FAccelByteChatRoomInfoRef& ChatRoomInfo)
+{
+	const FString& TopicId = ChatRoomInfo->GetRoomId();
+	for (const FString& MemberId : ChatRoomInfo->GetMembers())
+	{
+		UnindexTopicMember(MemberId, TopicId);
+	}
+}
+
+void FOnlineChatAccelByte::UnindexTopicMember(const FString& UserId, const FString& TopicId)
+{
+	TSet<FString>* JoinedTopicIds = UserIdToJoinedTopicIdsCached.Find(UserId);
+	if (JoinedTopicIds == nullptr)
+	{
+		return;
+	}
+
+	JoinedTopicIds->Remove(TopicId);
+	if (JoinedTopicIds->Num() <= 0)
+	{
+		UserIdToJoinedTopicIdsCached.Remove(UserId);
+	}
 }
 
 FAccelByteChatRoomInfoPtr FOnlineChatAccelByte::GetTopic(const FString& TopicId)
@@ -600,29 +816,11 @@ void FOnlineChatAccelByte::OnAddToTopicNotification(const FAccelByteModelsChatUp
 	else
 	{
 		UE_LOG_AB(Verbose, TEXT("ChatRoomInfo for room ID %s found. Current member num: %d, adding member with ID %s"), *AddTopicEvent.TopicId, (*ChatRoomInfo)->GetMembers().Num(), *AddTopicEvent.SenderId);
-		(*ChatRoomInfo)->AddMember(AddTopicEvent.SenderId);
-				
-		FAccelByteChatRoomMemberRef* MemberPtr = UserIdToChatRoomMemberCached.Find(AddTopicEvent.SenderId);
-		// member is not cached get the info
-		if (MemberPtr == nullptr || !(*MemberPtr)->HasNickname())
-		{
-			const FOnlineUserCacheAccelBytePtr UserStore = AccelByteSubsystem->GetUserCache();
-			if (!UserStore.IsValid())
-			{
-				UE_LOG_AB(Warning, TEXT("Unable to get member info as our user store instance is invalid!"));
-				TriggerOnChatRoomMemberJoinDelegates(*UserIdPtr, AddTopicEvent.TopicId, *SenderUserId);
-			}
-			else
-			{
-				const TArray<FString> UserIds = {AddTopicEvent.SenderId};
-				const FOnQueryUsersComplete OnQueryUsersCompleteDelegate = FOnQueryUsersComplete::CreateThreadSafeSP(SharedThis(this), &FOnlineChatAccelByte::OnQueryChatMemberInfo_TriggerChatRoomMemberJoin, AddTopicEvent.TopicId, UserIdPtr, SenderUserId);
-				UserStore->QueryUsersByAccelByteIds(LocalUserNum, UserIds, OnQueryUsersCompleteDelegate);
-			}
-		}
-		else
-		{
-			TriggerOnChatRoomMemberJoinDelegates(*UserIdPtr, AddTopicEvent.TopicId, *SenderUserId);
-		}
+		AddMemberToTopic(AddTopicEvent.SenderId, AddTopicEvent.TopicId);
+
+		// Joins for members we don't have info for are buffered, so that a burst of joins to the same room is resolved
+		// with a single user query rather than one query per join
+		QueueChatRoomMemberJoin(LocalUserNum, UserIdPtr, AddTopicEvent.TopicId, AddTopicEvent.SenderId);
 	}	
 	
 	TriggerOnTopicAddedDelegates(AddTopicEvent.Name, AddTopicEvent.TopicId, AddTopicEvent.UserId);
@@ -732,11 +930,22 @@ void FOnlineChatAccelByte::OnQueryChatRoomInfoComplete(bool bWasSuccessful, TArr
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
 
-void FOnlineChatAccelByte::OnQueryChatMemberInfo_TriggerChatRoomMemberJoin(bool bIsSuccessful, TArray<TSharedRef<FAccelByteUserInfo>> UsersQueried, FString RoomId, TSharedPtr<const FUniqueNetId> InUserId, TSharedPtr<const FUniqueNetId> InMemberId)
+void FOnlineChatAccelByte::OnQueryChatMemberInfo_TriggerChatRoomMemberJoins(bool bIsSuccessful, TArray<TSharedRef<FAccelByteUserInfo>> UsersQueried, FString RoomId, TArray<FString> QueriedMemberIds)
 {
-	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("RoomId %s MemberId %s"), *RoomId, *InMemberId->ToDebugString());
-	
-	TriggerOnChatRoomMemberJoinDelegates(*InUserId, RoomId, *InMemberId);
+	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("RoomId %s MemberCount %d"), *RoomId, QueriedMemberIds.Num());
+
+	AddChatRoomMembers(UsersQueried);
+
+	// Joins still fire for members that failed to resolve, just without a nickname, as they did before batching
+	FChatRoomMemberJoinQueue* Queue = RoomIdToMemberJoinQueue.Find(RoomId);
+	if (Queue != nullptr)
+	{
+		for (const FString& MemberId : QueriedMemberIds)
+		{
+			Queue->MemberIdsAwaitingInfo.Remove(MemberId);
+		}
+		TriggerChatRoomMemberJoins(RoomId);
+	}
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
@@ -855,7 +1064,7 @@ FAccelByteChatRoomInfoRef FAccelByteChatRoomInfo::Create()
 
 bool FAccelByteChatRoomInfo::HasMember(const FString& UserId) const
 {
-	return TopicData.Members.Contains(UserId);
+	return MemberIdToIndex.Contains(UserId);
 }
 
 const TArray<FString>& FAccelByteChatRoomInfo::GetMembers() const
@@ -867,6 +1076,26 @@ void FAccelByteChatRoomInfo::SetTopicData(const FAccelByteModelsChatTopicQueryDa
 {
 	TopicData = InTopicData;
 
+	// Rebuild the member index, dropping any duplicate IDs from the backend so that the array and index stay one to one
+	MemberIdToIndex.Reset();
+	MemberIdToIndex.Reserve(TopicData.Members.Num());
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < TopicData.Members.Num(); ReadIndex++)
+	{
+		if (MemberIdToIndex.Contains(TopicData.Members[ReadIndex]))
+		{
+			continue;
+		}
+
+		MemberIdToIndex.Add(TopicData.Members[ReadIndex], WriteIndex);
+		if (WriteIndex != ReadIndex)
+		{
+			TopicData.Members[WriteIndex] = MoveTemp(TopicData.Members[ReadIndex]);
+		}
+		WriteIndex++;
+	}
+	TopicData.Members.SetNum(WriteIndex, false);
+
     // NOTE: actually the topic don't have an owner, so we set first member as the owner
 	if (TopicData.Members.Num() > 0)
 	{
@@ -900,12 +1129,32 @@ void FAccelByteChatRoomInfo::UpdateTopicData(const FAccelByteModelsChatUpdateTop
 	TopicData.Name = InUpdateTopic.Name;
 }
 
-void FAccelByteChatRoomInfo::AddMember(const FString& UserId)
+bool FAccelByteChatRoomInfo::AddMember(const FString& UserId)
 {
-	TopicData.Members.AddUnique(UserId);
+	if (MemberIdToIndex.Contains(UserId))
+	{
+		return false;
+	}
+
+	MemberIdToIndex.Add(UserId, TopicData.Members.Add(UserId));
+	return true;
 }
 
-void FAccelByteChatRoomInfo::RemoveMember(const FString& UserId)
+bool FAccelByteChatRoomInfo::RemoveMember(const FString& UserId)
 {
-	TopicData.Members.Remove(UserId);
+	int32 RemovedIndex = INDEX_NONE;
+	if (!MemberIdToIndex.RemoveAndCopyValue(UserId, RemovedIndex))
+	{
+		return false;
+	}
+
+	// Move the last member into the gap rather than shifting everything after it down
+	const int32 LastIndex = TopicData.Members.Num() - 1;
+	if (RemovedIndex != LastIndex)
+	{
+		TopicData.Members[RemovedIndex] = MoveTemp(TopicData.Members[LastIndex]);
+		MemberIdToIndex.FindChecked(TopicData.Members[RemovedIndex]) = RemovedIndex;
+	}
+	TopicData.Members.RemoveAt(LastIndex, 1, false);
+	return true;
 }
@@ -12,9 +12,19 @@
 #include "AsyncTasks/CloudSave/OnlineAsyncTaskAccelByteGetGameRecord.h"
 #include "AsyncTasks/CloudSave/OnlineAsyncTaskAccelByteReplaceGameRecord.h"
 #include "OnlineError.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Serialization/JsonSerializer.h"
 
 #define ONLINE_ERROR_NAMESPACE "FOnlineCloudSaveAccelByte"
 
+FOnlineCloudSaveAccelByte::FOnlineCloudSaveAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: AccelByteSubsystem(InSubsystem)
+{
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bEnableUserRecordCache"), bIsUserRecordCacheEnabled, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("UserRecordCacheFreshnessSeconds"), UserRecordCacheFreshnessSeconds, GEngineIni);
+	GConfig->GetArray(TEXT("OnlineSubsystemAccelByte"), TEXT("PublicUserRecordPrefetchKeys"), PublicUserRecordPrefetchKeys, GEngineIni);
+}
+
 bool FOnlineCloudSaveAccelByte::GetFromSubsystem(const IOnlineSubsystem* Subsystem, FOnlineCloudSaveAccelBytePtr& OutInterfaceInstance)
 {
 	const FOnlineSubsystemAccelByte* ABSubsystem = static_cast<const FOnlineSubsystemAccelByte*>(Subsystem);
@@ -113,7 +123,7 @@ bool FOnlineCloudSaveAccelByte::BulkGetPublicUserRecord(int32 LocalUserNum, cons
 			TSharedPtr<FUserOnlineAccount> UserAccount;
 			if (UserIdPtr.IsValid())
 			{
-				AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord>(AccelByteSubsystem, *UserIdPtr.Get(), Key, UserIds);
+				AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord>(AccelByteSubsystem, *UserIdPtr.Get(), TArray<FString>{Key}, UserIds, EAccelByteBulkGetPublicUserRecordMode::SingleKey);
 				return true;
 			}
 			const FString ErrorStr = TEXT("bulk-get-public-user-record-failed-userid-invalid");
@@ -140,6 +150,58 @@ bool FOnlineCloudSaveAccelByte::BulkGetPublicUserRecord(int32 LocalUserNum, cons
 	return BulkGetPublicUserRecord(LocalUserNum, Key, UserIds);
 }
 
+bool FOnlineCloudSaveAccelByte::BulkGetPublicUserRecords(int32 LocalUserNum, const TArray<FString>& Keys, const TArray<FString>& UserIds)
+{
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	if (IdentityInterface.IsValid())
+	{
+		// Check whether user is connected or not yet
+		if (IdentityInterface->GetLoginStatus(LocalUserNum) == ELoginStatus::LoggedIn)
+		{
+			const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface->GetUniquePlayerId(LocalUserNum);
+			if (UserIdPtr.IsValid())
+			{
+				AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord>(AccelByteSubsystem, *UserIdPtr.Get(), Keys, UserIds, EAccelByteBulkGetPublicUserRecordMode::MultipleKeys);
+				return true;
+			}
+			AB_OSS_INTERFACE_TRACE_END(TEXT("UserId is not valid at user index '%d'!"), LocalUserNum);
+			TriggerOnBulkGetPublicUserRecordsCompletedDelegates(LocalUserNum, ONLINE_ERROR(EOnlineErrorResult::InvalidUser), FAccelByteUserRecordsByKey());
+			return false;
+		}
+	}
+
+	AB_OSS_INTERFACE_TRACE_END(TEXT("User not logged in at user index '%d'!"), LocalUserNum);
+	TriggerOnBulkGetPublicUserRecordsCompletedDelegates(LocalUserNum, ONLINE_ERROR(EOnlineErrorResult::InvalidAuth), FAccelByteUserRecordsByKey());
+	return false;
+}
+
+bool FOnlineCloudSaveAccelByte::BulkGetPublicUserRecords(int32 LocalUserNum, const TArray<FString>& Keys, const TArray<FUniqueNetIdAccelByteUserRef>& UniqueNetIds)
+{
+	TArray<FString> UserIds{};
+	for (const auto& UniqueNetId : UniqueNetIds)
+	{
+		UserIds.Add(UniqueNetId->GetAccelByteId());
+	}
+	return BulkGetPublicUserRecords(LocalUserNum, Keys, UserIds);
+}
+
+bool FOnlineCloudSaveAccelByte::PrefetchPublicUserRecords(const FUniqueNetId& LocalUserId, const TArray<FString>& Keys, const TArray<FString>& UserIds)
+{
+	// Prefetched records only ever end up in the cache, so there is no point fetching them without it
+	if (!bIsUserRecordCacheEnabled || Keys.Num() <= 0 || UserIds.Num() <= 0)
+	{
+		return false;
+	}
+
+	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteBulkGetPublicUserRecord>(AccelByteSubsystem, LocalUserId, Keys, UserIds, EAccelByteBulkGetPublicUserRecordMode::Prefetch);
+	return true;
+}
+
+bool FOnlineCloudSaveAccelByte::PrefetchPublicUserRecords(const FUniqueNetId& LocalUserId, const TArray<FString>& UserIds)
+{
+	return PrefetchPublicUserRecords(LocalUserId, PublicUserRecordPrefetchKeys, UserIds);
+}
+
 bool FOnlineCloudSaveAccelByte::GetGameRecord(int32 LocalUserNum, const FString& Key, bool bAlwaysRequestToService)
 {
 	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
@@ -264,6 +326,19 @@ bool FOnlineCloudSaveAccelByte::ReplaceUserRecord(int32 LocalUserNum, const FStr
 			TSharedPtr<FUserOnlineAccount> UserAccount;
 			if (UserIdPtr.IsValid())
 			{
+				// Compare the value against the last one read for the record, in case the write can be skipped
+				if (bIsUserRecordCacheEnabled)
+				{
+					const FString SerializedValue = SerializeUserRecordValue(RecordRequest);
+					const FString RecordUserId = FUniqueNetIdAccelByteUser::CastChecked(UserIdPtr.ToSharedRef())->GetAccelByteId();
+					if (IsUserRecordValueUnchanged(RecordUserId, Key, IsPublic, SerializedValue))
+					{
+						UE_LOG_AB(Verbose, TEXT("Skipping replace of user record '%s' as its value is unchanged"), *Key);
+						TriggerOnReplaceUserRecordCompletedDelegates(LocalUserNum, ONLINE_ERROR(EOnlineErrorResult::Success), Key);
+						return true;
+					}
+				}
+
 				AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteReplaceUserRecord>(AccelByteSubsystem, *UserIdPtr.Get(), Key, RecordRequest, IsPublic);
 				return true;
 			}
@@ -289,4 +364,139 @@ void FOnlineCloudSaveAccelByte::AddGameRecordToMap(const FString& Key, const TSh
 	GameRecordMap.Add(Key, Record);
 }
 
+bool FOnlineCloudSaveAccelByte::GetUserRecordFromCache(const FString& Key, const FString& RecordUserId, bool bIsPublic, FAccelByteModelsUserRecord& OutRecord) const
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	const FCachedUserRecord* CachedRecord = UserRecordCache.Find(GetUserRecordCacheKey(RecordUserId, Key, bIsPublic));
+	if (CachedRecord == nullptr || CachedRecord->bIsInvalidated)
+	{
+		return false;
+	}
+
+	OutRecord = CachedRecord->Record;
+	return true;
+}
+
+FAccelByteCloudSaveUserRecordCacheMetrics FOnlineCloudSaveAccelByte::GetUserRecordCacheMetrics() const
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	return UserRecordCacheMetrics;
+}
+
+void FOnlineCloudSaveAccelByte::ClearUserRecordCache()
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	UserRecordCache.Empty();
+	UserRecordCacheMetrics = FAccelByteCloudSaveUserRecordCacheMetrics();
+}
+
+void FOnlineCloudSaveAccelByte::SetUserRecordCacheFreshness(double InFreshnessSeconds)
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	UserRecordCacheFreshnessSeconds = InFreshnessSeconds;
+}
+
+FOnlineCloudSaveAccelByte::EUserRecordCacheLookup FOnlineCloudSaveAccelByte::LookupUserRecordForRead(const FString& RecordUserId, const FString& Key, bool bIsPublic, FAccelByteModelsUserRecord& OutRecord)
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	const FCachedUserRecord* CachedRecord = UserRecordCache.Find(GetUserRecordCacheKey(RecordUserId, Key, bIsPublic));
+	if (CachedRecord == nullptr)
+	{
+		UserRecordCacheMetrics.Misses++;
+		return EUserRecordCacheLookup::Miss;
+	}
+
+	const double AgeInSeconds = FPlatformTime::Seconds() - CachedRecord->CachedTimeInSeconds;
+	if (CachedRecord->bIsInvalidated || AgeInSeconds >= UserRecordCacheFreshnessSeconds)
+	{
+		UserRecordCacheMetrics.Revalidations++;
+		return EUserRecordCacheLookup::Stale;
+	}
+
+	UserRecordCacheMetrics.Hits++;
+	OutRecord = CachedRecord->Record;
+	return EUserRecordCacheLookup::Hit;
+}
+
+void FOnlineCloudSaveAccelByte::AddUserRecordToCache(const FString& RecordUserId, const FString& Key, bool bIsPublic, const FAccelByteModelsUserRecord& Record)
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	FCachedUserRecord& CachedRecord = UserRecordCache.FindOrAdd(GetUserRecordCacheKey(RecordUserId, Key, bIsPublic));
+
+	// A revalidation that comes back with the version we already had doesn't need the value serialized again
+	const bool bIsSameVersion = CachedRecord.CachedTimeInSeconds > 0.0 && !CachedRecord.bIsInvalidated && CachedRecord.Record.UpdatedAt == Record.UpdatedAt;
+	if (bIsSameVersion)
+	{
+		UserRecordCacheMetrics.UnchangedRevalidations++;
+	}
+	else
+	{
+		CachedRecord.SerializedValue = Record.Value.JsonObject.IsValid() ? SerializeUserRecordValue(*Record.Value.JsonObject) : FString();
+	}
+
+	CachedRecord.Record = Record;
+	CachedRecord.CachedTimeInSeconds = FPlatformTime::Seconds();
+	CachedRecord.bIsInvalidated = false;
+}
+
+bool FOnlineCloudSaveAccelByte::IsUserRecordValueUnchanged(const FString& RecordUserId, const FString& Key, bool bIsPublic, const FString& SerializedValue)
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	const FCachedUserRecord* CachedRecord = UserRecordCache.Find(GetUserRecordCacheKey(RecordUserId, Key, bIsPublic));
+	if (CachedRecord == nullptr || CachedRecord->bIsInvalidated || CachedRecord->SerializedValue.IsEmpty())
+	{
+		return false;
+	}
+
+	// Only trust a value that we read back recently, any older and another client may have replaced it in the meantime
+	const double AgeInSeconds = FPlatformTime::Seconds() - CachedRecord->CachedTimeInSeconds;
+	if (AgeInSeconds >= UserRecordCacheFreshnessSeconds || !CachedRecord->SerializedValue.Equals(SerializedValue, ESearchCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	UserRecordCacheMetrics.SkippedReplaces++;
+	return true;
+}
+
+void FOnlineCloudSaveAccelByte::OnUserRecordReplaced(const FString& RecordUserId, const FString& Key, bool bIsPublic)
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+
+	// The replace may have changed the visibility of the record, so the cached copy of the other visibility is now wrong
+	if (UserRecordCache.Remove(GetUserRecordCacheKey(RecordUserId, Key, !bIsPublic)) > 0)
+	{
+		UserRecordCacheMetrics.Invalidations++;
+	}
+
+	// We don't know the updated at time the backend gave the new value, so reads have to go back to the backend. The
+	// value we wrote is not kept either, as only a value read back from the backend is safe to skip a replace against.
+	FCachedUserRecord* CachedRecord = UserRecordCache.Find(GetUserRecordCacheKey(RecordUserId, Key, bIsPublic));
+	if (CachedRecord != nullptr && !CachedRecord->bIsInvalidated)
+	{
+		UserRecordCacheMetrics.Invalidations++;
+		CachedRecord->bIsInvalidated = true;
+	}
+}
+
+void FOnlineCloudSaveAccelByte::RemoveUserRecordFromCache(const FString& RecordUserId, const FString& Key)
+{
+	FScopeLock ScopeLock(&UserRecordCacheLock);
+	UserRecordCacheMetrics.Invalidations += UserRecordCache.Remove(GetUserRecordCacheKey(RecordUserId, Key, true));
+	UserRecordCacheMetrics.Invalidations += UserRecordCache.Remove(GetUserRecordCacheKey(RecordUserId, Key, false));
+}
+
+FString FOnlineCloudSaveAccelByte::SerializeUserRecordValue(const FJsonObject& Value)
+{
+	FString OutputString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
+	FJsonSerializer::Serialize(MakeShared<FJsonObject>(Value), Writer);
+	return OutputString;
+}
+
+FString FOnlineCloudSaveAccelByte::GetUserRecordCacheKey(const FString& RecordUserId, const FString& Key, bool bIsPublic)
+{
+	return FString::Printf(TEXT("%s/%s/%s"), *RecordUserId, bIsPublic ? TEXT("public") : TEXT("private"), *Key);
+}
+
 #undef ONLINE_ERROR_NAMESPACE
\ No newline at end of file
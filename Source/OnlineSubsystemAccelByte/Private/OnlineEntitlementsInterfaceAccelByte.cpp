@@ -7,10 +7,24 @@
 #include "AsyncTasks/Entitlements/OnlineAsyncTaskAccelByteQueryEntitlements.h"
 #include "AsyncTasks/Entitlements/OnlineAsyncTaskAccelByteSyncPlatformPurchase.h"
 #include "AsyncTasks/Entitlements/OnlineAsyncTaskAccelByteSyncDLC.h"
+#include "OnlineIdentityInterfaceAccelByte.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 
 FOnlineEntitlementsAccelByte::FOnlineEntitlementsAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
 	: AccelByteSubsystem(InSubsystem)
 {
+	double RefreshDebounceSeconds = 1.0;
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("EcommerceCacheRefreshDebounceSeconds"), RefreshDebounceSeconds, GEngineIni);
+	RefreshDebouncer.SetWindowSeconds(RefreshDebounceSeconds);
+
+	GConfig->GetArray(TEXT("OnlineSubsystemAccelByte"), TEXT("EntitlementNotificationTopics"), EntitlementNotificationTopics, GEngineIni);
+	if (EntitlementNotificationTopics.Num() == 0)
+	{
+		EntitlementNotificationTopics.Add(TEXT("ENTITLEMENT_UPDATED"));
+	}
 }
 
 void FOnlineEntitlementsAccelByte::AddEntitlementToMap(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, TSharedRef<FOnlineEntitlement> Entitlement)
@@ -21,6 +35,138 @@ void FOnlineEntitlementsAccelByte::AddEntitlementToMap(const TSharedRef<const FU
 	
 	EntMap.Emplace(Entitlement->Id, Entitlement);
 	ItemEntMap.Emplace(Entitlement->ItemId, Entitlement);
+	LastUpdatedTimeMap.Emplace(UserId, FDateTime::UtcNow());
+}
+
+void FOnlineEntitlementsAccelByte::AddEntitlementsToMap(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TArray<TSharedRef<FOnlineEntitlement>>& Entitlements)
+{
+	if (Entitlements.Num() <= 0)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&EntitlementMapLock);
+	FEntitlementMap& EntMap = EntitlementMap.FindOrAdd(UserId);
+	FItemEntitlementMap& ItemEntMap = ItemEntitlementMap.FindOrAdd(UserId);
+
+	EntMap.Reserve(EntMap.Num() + Entitlements.Num());
+	ItemEntMap.Reserve(ItemEntMap.Num() + Entitlements.Num());
+	for (const TSharedRef<FOnlineEntitlement>& Entitlement : Entitlements)
+	{
+		EntMap.Emplace(Entitlement->Id, Entitlement);
+		ItemEntMap.Emplace(Entitlement->ItemId, Entitlement);
+	}
+	LastUpdatedTimeMap.Emplace(UserId, FDateTime::UtcNow());
+}
+
+void FOnlineEntitlementsAccelByte::ReplaceEntitlementsInMap(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const FString& ItemId, const TArray<TSharedRef<FOnlineEntitlement>>& Entitlements)
+{
+	FScopeLock ScopeLock(&EntitlementMapLock);
+	FEntitlementMap& EntMap = EntitlementMap.FindOrAdd(UserId);
+	FItemEntitlementMap& ItemEntMap = ItemEntitlementMap.FindOrAdd(UserId);
+
+	if (ItemId.IsEmpty())
+	{
+		EntMap.Reset();
+		ItemEntMap.Reset();
+	}
+	else
+	{
+		for (FEntitlementMap::TIterator It = EntMap.CreateIterator(); It; ++It)
+		{
+			if (It->Value->ItemId == ItemId)
+			{
+				It.RemoveCurrent();
+			}
+		}
+		ItemEntMap.Remove(ItemId);
+	}
+
+	EntMap.Reserve(EntMap.Num() + Entitlements.Num());
+	ItemEntMap.Reserve(ItemEntMap.Num() + Entitlements.Num());
+	for (const TSharedRef<FOnlineEntitlement>& Entitlement : Entitlements)
+	{
+		EntMap.Emplace(Entitlement->Id, Entitlement);
+		ItemEntMap.Emplace(Entitlement->ItemId, Entitlement);
+	}
+	LastUpdatedTimeMap.Emplace(UserId, FDateTime::UtcNow());
+}
+
+void FOnlineEntitlementsAccelByte::InvalidateItemEntitlement(int32 LocalUserNum, const FString& ItemId)
+{
+	UE_LOG_AB(Verbose, TEXT("Invalidated cached entitlements for item '%s' for user index '%d'"), *ItemId, LocalUserNum);
+	RefreshDebouncer.Schedule(LocalUserNum, ItemId, FPlatformTime::Seconds());
+}
+
+bool FOnlineEntitlementsAccelByte::OnNotificationReceived(int32 LocalUserNum, const FString& Topic, const FString& Payload)
+{
+	if (!EntitlementNotificationTopics.Contains(Topic))
+	{
+		return false;
+	}
+
+	TArray<FString> ItemIds;
+	TSharedPtr<FJsonObject> PayloadObject;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Payload);
+	if (FJsonSerializer::Deserialize(JsonReader, PayloadObject) && PayloadObject.IsValid())
+	{
+		FString ItemId;
+		if (PayloadObject->TryGetStringField(TEXT("itemId"), ItemId) && !ItemId.IsEmpty())
+		{
+			ItemIds.Add(ItemId);
+		}
+		PayloadObject->TryGetStringArrayField(TEXT("itemIds"), ItemIds);
+	}
+
+	// Without any item in the payload we cannot tell what changed, so an empty item ID refreshes everything
+	if (ItemIds.Num() == 0)
+	{
+		ItemIds.Add(TEXT(""));
+	}
+
+	for (const FString& ItemId : ItemIds)
+	{
+		InvalidateItemEntitlement(LocalUserNum, ItemId);
+	}
+	return true;
+}
+
+void FOnlineEntitlementsAccelByte::Tick(float DeltaTime)
+{
+	TMap<int32, TSet<FString>> Refreshes;
+	if (!RefreshDebouncer.Flush(FPlatformTime::Seconds(), Refreshes))
+	{
+		return;
+	}
+
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+	{
+		return;
+	}
+
+	for (const TPair<int32, TSet<FString>>& Refresh : Refreshes)
+	{
+		const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface->GetUniquePlayerId(Refresh.Key);
+		if (!UserIdPtr.IsValid() || IdentityInterface->GetLoginStatus(Refresh.Key) != ELoginStatus::LoggedIn)
+		{
+			continue;
+		}
+
+		for (const FString& ItemId : Refresh.Value)
+		{
+			UE_LOG_AB(Verbose, TEXT("Refreshing invalidated entitlements for item '%s' for user index '%d'"), *ItemId, Refresh.Key);
+			AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryEntitlements>(AccelByteSubsystem, *UserIdPtr, TEXT(""), FPagedQuery(), ItemId);
+		}
+	}
+}
+
+FDateTime FOnlineEntitlementsAccelByte::GetEntitlementsLastUpdatedTime(const FUniqueNetId& UserId) const
+{
+	const TSharedRef<const FUniqueNetIdAccelByteUser> SharedUserId = FUniqueNetIdAccelByteUser::CastChecked(UserId);
+	FScopeLock ScopeLock(&EntitlementMapLock);
+	const FDateTime* LastUpdatedTime = LastUpdatedTimeMap.Find(SharedUserId);
+	return LastUpdatedTime != nullptr ? *LastUpdatedTime : FDateTime::MinValue();
 }
 
 bool FOnlineEntitlementsAccelByte::GetFromSubsystem(const IOnlineSubsystem* Subsystem, FOnlineEntitlementsAccelBytePtr& OutInterfaceInstance)
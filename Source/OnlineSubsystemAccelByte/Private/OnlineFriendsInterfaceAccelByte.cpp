@@ -6,6 +6,7 @@
 #include "OnlineSubsystemAccelByte.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlinePresenceInterfaceAccelByte.h"
+#include "OnlineLobbyNotificationQueueAccelByte.h"
 #include "Core/AccelByteMultiRegistry.h"
 #include "Api/AccelByteLobbyApi.h"
 #include "AsyncTasks/Friends/OnlineAsyncTaskAccelByteReadFriendsList.h"
@@ -330,20 +331,23 @@ void FOnlineFriendsAccelByte::RegisterRealTimeLobbyDelegates(int32 LocalUserNum)
 		return;
 	}
 
-	// Set each delegate for the corresponding API client to be a new realtime delegate
-	AccelByte::Api::Lobby::FAcceptFriendsNotif OnFriendRequestAcceptedNotificationReceivedDelegate = AccelByte::Api::Lobby::FAcceptFriendsNotif::CreateThreadSafeSP(AsShared(), &FOnlineFriendsAccelByte::OnFriendRequestAcceptedNotificationReceived, LocalUserNum);
+	// Set each delegate for the corresponding API client to be a new realtime delegate, routed through the subsystem's
+	// notification queue. Friend notifications are never collapsed, as a request followed by a cancel must both be seen.
+	const FOnlineLobbyNotificationQueueAccelBytePtr NotificationQueue = AccelByteSubsystem->GetLobbyNotificationQueue();
+
+	AccelByte::Api::Lobby::FAcceptFriendsNotif OnFriendRequestAcceptedNotificationReceivedDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FAcceptFriendsNotif>(NotificationQueue, SharedThis(this), &FOnlineFriendsAccelByte::OnFriendRequestAcceptedNotificationReceived, EAccelByteLobbyNotificationPriority::Normal, TEXT("FriendRequestAccepted"), [](const FAccelByteModelsAcceptFriendsNotif& Notification) { return Notification.friendId; }, false, LocalUserNum);
 	ApiClient->Lobby.SetOnFriendRequestAcceptedNotifDelegate(OnFriendRequestAcceptedNotificationReceivedDelegate);
 
-	AccelByte::Api::Lobby::FRequestFriendsNotif OnFriendRequestReceivedNotificationReceivedDelegate = AccelByte::Api::Lobby::FRequestFriendsNotif::CreateThreadSafeSP(AsShared(), &FOnlineFriendsAccelByte::OnFriendRequestReceivedNotificationReceived, LocalUserNum);
+	AccelByte::Api::Lobby::FRequestFriendsNotif OnFriendRequestReceivedNotificationReceivedDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FRequestFriendsNotif>(NotificationQueue, SharedThis(this), &FOnlineFriendsAccelByte::OnFriendRequestReceivedNotificationReceived, EAccelByteLobbyNotificationPriority::Normal, TEXT("FriendRequestReceived"), [](const FAccelByteModelsRequestFriendsNotif& Notification) { return Notification.friendId; }, false, LocalUserNum);
 	ApiClient->Lobby.SetOnIncomingRequestFriendsNotifDelegate(OnFriendRequestReceivedNotificationReceivedDelegate);
 
-	AccelByte::Api::Lobby::FUnfriendNotif OnUnfriendNotificationReceivedDelegate = AccelByte::Api::Lobby::FUnfriendNotif::CreateThreadSafeSP(AsShared(), &FOnlineFriendsAccelByte::OnUnfriendNotificationReceived, LocalUserNum);
+	AccelByte::Api::Lobby::FUnfriendNotif OnUnfriendNotificationReceivedDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FUnfriendNotif>(NotificationQueue, SharedThis(this), &FOnlineFriendsAccelByte::OnUnfriendNotificationReceived, EAccelByteLobbyNotificationPriority::Normal, TEXT("Unfriend"), [](const FAccelByteModelsUnfriendNotif& Notification) { return Notification.friendId; }, false, LocalUserNum);
 	ApiClient->Lobby.SetOnUnfriendNotifDelegate(OnUnfriendNotificationReceivedDelegate);
 
-	AccelByte::Api::Lobby::FRejectFriendsNotif OnRejectFriendRequestNotificationReceivedDelegate = AccelByte::Api::Lobby::FRejectFriendsNotif::CreateThreadSafeSP(AsShared(), &FOnlineFriendsAccelByte::OnRejectFriendRequestNotificationReceived, LocalUserNum);
+	AccelByte::Api::Lobby::FRejectFriendsNotif OnRejectFriendRequestNotificationReceivedDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FRejectFriendsNotif>(NotificationQueue, SharedThis(this), &FOnlineFriendsAccelByte::OnRejectFriendRequestNotificationReceived, EAccelByteLobbyNotificationPriority::Normal, TEXT("FriendRequestRejected"), [](const FAccelByteModelsRejectFriendsNotif& Notification) { return Notification.userId; }, false, LocalUserNum);
 	ApiClient->Lobby.SetOnRejectFriendsNotifDelegate(OnRejectFriendRequestNotificationReceivedDelegate);
 
-	AccelByte::Api::Lobby::FCancelFriendsNotif OnCancelFriendRequestNotificationReceivedDelegate = AccelByte::Api::Lobby::FCancelFriendsNotif::CreateThreadSafeSP(AsShared(), &FOnlineFriendsAccelByte::OnCancelFriendRequestNotificationReceived, LocalUserNum);
+	AccelByte::Api::Lobby::FCancelFriendsNotif OnCancelFriendRequestNotificationReceivedDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FCancelFriendsNotif>(NotificationQueue, SharedThis(this), &FOnlineFriendsAccelByte::OnCancelFriendRequestNotificationReceived, EAccelByteLobbyNotificationPriority::Normal, TEXT("FriendRequestCanceled"), [](const FAccelByteModelsCancelFriendsNotif& Notification) { return Notification.userId; }, false, LocalUserNum);
 	ApiClient->Lobby.SetOnCancelFriendsNotifDelegate(OnCancelFriendRequestNotificationReceivedDelegate);
 
 	// Update the friend presence
@@ -416,11 +420,23 @@ void FOnlineFriendsAccelByte::RemoveFriendFromList(int32 LocalUserNum, const TSh
 		if (FoundFriendIndex != INDEX_NONE)
 		{
 			FoundFriendsList->RemoveAt(FoundFriendIndex);
+
+			// We will no longer receive presence updates for this user, so don't keep their last known presence around
+			RemovePresenceFromCache(FriendId);
 		}
 	}
 	TriggerOnFriendsChangeDelegates(LocalUserNum);
 }
 
+void FOnlineFriendsAccelByte::RemovePresenceFromCache(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId)
+{
+	const FOnlinePresenceAccelBytePtr PresenceInterface = StaticCastSharedPtr<FOnlinePresenceAccelByte>(AccelByteSubsystem->GetPresenceInterface());
+	if (PresenceInterface.IsValid())
+	{
+		PresenceInterface->RemoveCachedPresence(UserId->GetAccelByteId());
+	}
+}
+
 void FOnlineFriendsAccelByte::AddBlockedPlayersToList(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TArray<TSharedPtr<FOnlineBlockedPlayer>>& NewBlockedPlayers)
 {
 	// Try and get a local user index for the player first, as it is needed for the changed delegate
@@ -445,6 +461,14 @@ void FOnlineFriendsAccelByte::AddBlockedPlayersToList(const TSharedRef<const FUn
 	{
 		UserIdToBlockedPlayersMap.Add(UserId, NewBlockedPlayers);
 	}
+
+	for (const TSharedPtr<FOnlineBlockedPlayer>& BlockedPlayer : NewBlockedPlayers)
+	{
+		if (BlockedPlayer.IsValid())
+		{
+			RemovePresenceFromCache(FUniqueNetIdAccelByteUser::CastChecked(BlockedPlayer->GetUserId()));
+		}
+	}
 	TriggerOnBlockListChangeDelegates(LocalUserNum, EFriendsLists::ToString(EFriendsLists::Default));
 }
 
@@ -491,6 +515,11 @@ void FOnlineFriendsAccelByte::AddBlockedPlayerToList(int32 LocalUserNum, const T
 		NewBlockedPlayersList.Add(NewBlockedPlayer);
 		UserIdToBlockedPlayersMap.Add(NetId, NewBlockedPlayersList);
 	}
+
+	if (NewBlockedPlayer.IsValid())
+	{
+		RemovePresenceFromCache(FUniqueNetIdAccelByteUser::CastChecked(NewBlockedPlayer->GetUserId()));
+	}
 	TriggerOnBlockListChangeDelegates(LocalUserNum, EFriendsLists::ToString(EFriendsLists::Default));
 }
 
@@ -9,6 +9,7 @@
 #include "UObject/CoreOnline.h"
 #endif
 #include "OnlineSubsystemAccelByte.h"
+#include "OnlineLoginBootstrapAccelByte.h"
 #include "OnlineError.h"
 #include "Core/AccelByteRegistry.h"
 #include "Core/AccelByteMultiRegistry.h"
@@ -28,6 +29,7 @@
 #include "AsyncTasks/Server/OnlineAsyncTaskAccelByteLoginServer.h"
 #include "OnlineSubsystemUtils.h"
 #include "AsyncTasks/Chat/OnlineAsyncTaskAccelByteConnectChat.h"
+#include "OnlineOperationTraceAccelByte.h"
 
 /** Begin FOnlineIdentityAccelByte */
 FOnlineIdentityAccelByte::FOnlineIdentityAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
@@ -58,6 +60,7 @@ bool FOnlineIdentityAccelByte::GetFromWorld(const UWorld* World, FOnlineIdentity
 bool FOnlineIdentityAccelByte::Login(int32 LocalUserNum, const FOnlineAccountCredentials& AccountCredentials)
 {
 	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("LocalUserNum: %d; Type: %s; Id: %s"), LocalUserNum, *AccountCredentials.Type, *AccountCredentials.Id);
+	AB_OSS_TRACE_SPAN(AccelByteSubsystem, "Login");
 
 	// @todo multiuser Remove this check once the SDK supports more than one player
 	if (LocalUserNum < 0 || LocalUserNum >= MAX_LOCAL_PLAYERS)
@@ -596,6 +599,13 @@ void FOnlineIdentityAccelByte::AddNewAuthenticatedUser(int32 LocalUserNum, const
 
 void FOnlineIdentityAccelByte::OnLogout(const int32 LocalUserNum, bool bWasSuccessful)
 {
+	// Stop any post-login fetches still running for this user, so their results are not applied after logging out
+	const FOnlineLoginBootstrapAccelBytePtr LoginBootstrap = AccelByteSubsystem->GetLoginBootstrap();
+	if (LoginBootstrap.IsValid())
+	{
+		LoginBootstrap->CancelBootstrap(LocalUserNum);
+	}
+
 	TriggerOnLogoutCompleteDelegates(LocalUserNum, bWasSuccessful);
 	SetLoginStatus(LocalUserNum, ELoginStatus::NotLoggedIn);
 
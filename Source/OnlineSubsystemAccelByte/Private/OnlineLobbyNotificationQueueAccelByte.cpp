@@ -0,0 +1,195 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineLobbyNotificationQueueAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "Misc/ConfigCacheIni.h"
+
+FOnlineLobbyNotificationQueueAccelByte::FOnlineLobbyNotificationQueueAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	double TickBudgetMs = TickBudgetSeconds * 1000.0;
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("LobbyNotificationTickBudgetMs"), TickBudgetMs, GEngineIni);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("MaxQueuedLobbyNotifications"), MaxQueuedNotifications, GEngineIni);
+	SetLimits(TickBudgetMs / 1000.0, MaxQueuedNotifications);
+}
+
+void FOnlineLobbyNotificationQueueAccelByte::Enqueue(EAccelByteLobbyNotificationPriority Priority, const FString& Type, const FString& EntityId, bool bCollapseSuperseded, TFunction<void()>&& Handler)
+{
+	const int32 PriorityIndex = FMath::Clamp(static_cast<int32>(Priority), 0, static_cast<int32>(EAccelByteLobbyNotificationPriority::Count) - 1);
+	const bool bCanCollapse = bCollapseSuperseded && !EntityId.IsEmpty();
+	const FString CollapseKey = bCanCollapse ? FString::Printf(TEXT("%s:%s"), *Type, *EntityId) : FString();
+
+	FScopeLock ScopeLock(&QueueLock);
+	Metrics.EnqueuedCount++;
+
+	// A newer notification of the same type for the same entity replaces the waiting one in place, keeping its place
+	// in the queue but handling only the latest data
+	if (bCanCollapse)
+	{
+		FQueuedNotificationRef* FoundNotification = CollapsibleNotifications.Find(CollapseKey);
+		if (FoundNotification != nullptr)
+		{
+			(*FoundNotification)->Handler = MoveTemp(Handler);
+			Metrics.CollapsedCount++;
+			return;
+		}
+	}
+
+	if (Metrics.QueueDepth >= MaxQueuedNotifications)
+	{
+		// Only informational notifications may be dropped. Make room by dropping the oldest one waiting, or drop the
+		// incoming one if it is informational too. Anything else is queued past the limit rather than lost.
+		const int32 DroppablePriorityIndex = static_cast<int32>(EAccelByteLobbyNotificationPriority::Low);
+		if (QueueHeads[DroppablePriorityIndex] < Queues[DroppablePriorityIndex].Num())
+		{
+			PopNotification(DroppablePriorityIndex);
+			Metrics.DroppedCount++;
+		}
+		else if (PriorityIndex == DroppablePriorityIndex)
+		{
+			Metrics.DroppedCount++;
+			return;
+		}
+		else
+		{
+			Metrics.OverLimitCount++;
+		}
+	}
+
+	FQueuedNotificationRef Notification = MakeShared<FQueuedNotification, ESPMode::ThreadSafe>();
+	Notification->Type = Type;
+	Notification->EntityId = EntityId;
+	Notification->CollapseKey = CollapseKey;
+	Notification->Handler = MoveTemp(Handler);
+
+	Queues[PriorityIndex].Add(Notification);
+	if (bCanCollapse)
+	{
+		CollapsibleNotifications.Add(CollapseKey, Notification);
+	}
+
+	Metrics.QueueDepth++;
+	Metrics.PeakQueueDepth = FMath::Max(Metrics.PeakQueueDepth, Metrics.QueueDepth);
+}
+
+FOnlineLobbyNotificationQueueAccelByte::FQueuedNotificationRef FOnlineLobbyNotificationQueueAccelByte::PopNotification(int32 PriorityIndex)
+{
+	TArray<FQueuedNotificationRef>& Queue = Queues[PriorityIndex];
+	int32& QueueHead = QueueHeads[PriorityIndex];
+
+	FQueuedNotificationRef Notification = Queue[QueueHead];
+	QueueHead++;
+
+	// Popping from the front of an array is linear, so move a head index along instead and only shift the array once
+	// the consumed part is at least half of it
+	if (QueueHead >= Queue.Num())
+	{
+		Queue.Reset();
+		QueueHead = 0;
+	}
+	else if (QueueHead * 2 >= Queue.Num())
+	{
+		Queue.RemoveAt(0, QueueHead, false);
+		QueueHead = 0;
+	}
+
+	if (!Notification->CollapseKey.IsEmpty())
+	{
+		CollapsibleNotifications.Remove(Notification->CollapseKey);
+	}
+
+	Metrics.QueueDepth--;
+	return Notification;
+}
+
+int32 FOnlineLobbyNotificationQueueAccelByte::ProcessNotifications(double TimeBudgetSeconds)
+{
+	const double StartTimeSeconds = FPlatformTime::Seconds();
+	int32 ProcessedCount = 0;
+	bool bHasRemainingNotifications = false;
+
+	while (true)
+	{
+		TSharedPtr<FQueuedNotification, ESPMode::ThreadSafe> Notification;
+		{
+			FScopeLock ScopeLock(&QueueLock);
+			for (int32 PriorityIndex = 0; PriorityIndex < static_cast<int32>(EAccelByteLobbyNotificationPriority::Count); PriorityIndex++)
+			{
+				if (QueueHeads[PriorityIndex] < Queues[PriorityIndex].Num())
+				{
+					Notification = PopNotification(PriorityIndex);
+					break;
+				}
+			}
+		}
+
+		if (!Notification.IsValid())
+		{
+			break;
+		}
+
+		// Run the handler outside of the lock, as handlers are free to queue further notifications
+		if (Notification->Handler)
+		{
+			Notification->Handler();
+		}
+		ProcessedCount++;
+
+		if (TimeBudgetSeconds > 0.0 && (FPlatformTime::Seconds() - StartTimeSeconds) >= TimeBudgetSeconds)
+		{
+			bHasRemainingNotifications = Num() > 0;
+			break;
+		}
+	}
+
+	if (ProcessedCount > 0)
+	{
+		FScopeLock ScopeLock(&QueueLock);
+		Metrics.ProcessedCount += ProcessedCount;
+		Metrics.LastTickProcessingMs = (FPlatformTime::Seconds() - StartTimeSeconds) * 1000.0;
+		if (bHasRemainingNotifications)
+		{
+			Metrics.TicksOverBudget++;
+		}
+	}
+
+	return ProcessedCount;
+}
+
+void FOnlineLobbyNotificationQueueAccelByte::Tick(float DeltaTime)
+{
+	ProcessNotifications(TickBudgetSeconds);
+
+	const FAccelByteLobbyNotificationQueueMetrics CurrentMetrics = GetMetrics();
+	if (CurrentMetrics.DroppedCount > LastReportedDroppedCount)
+	{
+		UE_LOG_AB(Warning, TEXT("Dropped %llu lobby notifications as the notification queue was full! Queue depth: %d; Max queued: %d"), CurrentMetrics.DroppedCount - LastReportedDroppedCount, CurrentMetrics.QueueDepth, MaxQueuedNotifications);
+		LastReportedDroppedCount = CurrentMetrics.DroppedCount;
+	}
+	if (CurrentMetrics.OverLimitCount > LastReportedOverLimitCount)
+	{
+		UE_LOG_AB(Warning, TEXT("Queued %llu lobby notifications past the limit as nothing could be dropped! Queue depth: %d; Max queued: %d"), CurrentMetrics.OverLimitCount - LastReportedOverLimitCount, CurrentMetrics.QueueDepth, MaxQueuedNotifications);
+		LastReportedOverLimitCount = CurrentMetrics.OverLimitCount;
+	}
+}
+
+void FOnlineLobbyNotificationQueueAccelByte::SetLimits(double InTickBudgetSeconds, int32 InMaxQueuedNotifications)
+{
+	FScopeLock ScopeLock(&QueueLock);
+	TickBudgetSeconds = InTickBudgetSeconds;
+	MaxQueuedNotifications = FMath::Max(InMaxQueuedNotifications, 1);
+}
+
+FAccelByteLobbyNotificationQueueMetrics FOnlineLobbyNotificationQueueAccelByte::GetMetrics() const
+{
+	FScopeLock ScopeLock(&QueueLock);
+	return Metrics;
+}
+
+int32 FOnlineLobbyNotificationQueueAccelByte::Num() const
+{
+	FScopeLock ScopeLock(&QueueLock);
+	return Metrics.QueueDepth;
+}
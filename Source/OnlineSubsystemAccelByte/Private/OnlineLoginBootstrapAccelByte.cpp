@@ -0,0 +1,549 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineLoginBootstrapAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineIdentityInterfaceAccelByte.h"
+#include "OnlineFriendsInterfaceAccelByte.h"
+#include "OnlineEntitlementsInterfaceAccelByte.h"
+#include "OnlineWalletInterfaceAccelByte.h"
+#include "OnlineUserInterfaceAccelByte.h"
+#include "AsyncTasks/User/OnlineAsyncTaskAccelByteQueryUserProfile.h"
+#include "AsyncTasks/Entitlements/OnlineAsyncTaskAccelByteQueryEntitlements.h"
+#include "AsyncTasks/Friends/OnlineAsyncTaskAccelByteQueryBlockedPlayers.h"
+#include "AsyncTasks/Wallet/OnlineAsyncTaskAccelByteGetCurrencyList.h"
+#include "Misc/ConfigCacheIni.h"
+
+const FName FOnlineLoginBootstrapAccelByte::ConnectLobbyStage = FName(TEXT("ConnectLobby"));
+const FName FOnlineLoginBootstrapAccelByte::FriendsStage = FName(TEXT("Friends"));
+const FName FOnlineLoginBootstrapAccelByte::BlockedPlayersStage = FName(TEXT("BlockedPlayers"));
+const FName FOnlineLoginBootstrapAccelByte::EntitlementsStage = FName(TEXT("Entitlements"));
+const FName FOnlineLoginBootstrapAccelByte::CurrenciesStage = FName(TEXT("Currencies"));
+const FName FOnlineLoginBootstrapAccelByte::UserProfileStage = FName(TEXT("UserProfile"));
+
+FOnlineLoginBootstrapAccelByte::FOnlineLoginBootstrapAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	RegisterBuiltInStages();
+
+	TArray<FString> ConfigStages;
+	GConfig->GetArray(TEXT("OnlineSubsystemAccelByte"), TEXT("LoginBootstrapStages"), ConfigStages, GEngineIni);
+	for (const FString& ConfigStage : ConfigStages)
+	{
+		RequestedStages.AddUnique(FName(*ConfigStage));
+	}
+}
+
+void FOnlineLoginBootstrapAccelByte::RegisterStage(const FName& Stage, const TArray<FName>& Prerequisites, const FAccelByteLoginBootstrapStageFunction& Function)
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	FStageDefinition& Definition = StageDefinitions.FindOrAdd(Stage);
+	Definition.Prerequisites = Prerequisites;
+	Definition.Function = Function;
+}
+
+void FOnlineLoginBootstrapAccelByte::SetRequestedStages(const TArray<FName>& Stages)
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	RequestedStages = Stages;
+}
+
+TArray<FName> FOnlineLoginBootstrapAccelByte::GetRequestedStages() const
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	return RequestedStages;
+}
+
+bool FOnlineLoginBootstrapAccelByte::IsStageRequested(const FName& Stage) const
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	TArray<FName> OrderedStages;
+	return RequestedStages.Num() > 0 && ResolveStages(RequestedStages, OrderedStages) && OrderedStages.Contains(Stage);
+}
+
+bool FOnlineLoginBootstrapAccelByte::StartBootstrap(int32 LocalUserNum, TArray<FName>* OutStages)
+{
+	return StartBootstrap(LocalUserNum, GetRequestedStages(), OutStages);
+}
+
+bool FOnlineLoginBootstrapAccelByte::StartBootstrap(int32 LocalUserNum, const TArray<FName>& Stages, TArray<FName>* OutStages)
+{
+	if (Stages.Num() <= 0)
+	{
+		return false;
+	}
+
+	CancelBootstrap(LocalUserNum);
+
+	uint32 RunId = 0;
+	{
+		FScopeLock ScopeLock(&BootstrapLock);
+
+		TArray<FName> OrderedStages;
+		if (!ResolveStages(Stages, OrderedStages))
+		{
+			return false;
+		}
+
+		FBootstrapRun& Run = ActiveRuns.Add(LocalUserNum);
+		Run.RunId = NextRunId++;
+		Run.StartTimeInSeconds = FPlatformTime::Seconds();
+		Run.Stages.Reserve(OrderedStages.Num());
+		Run.PrerequisiteIndices.Reserve(OrderedStages.Num());
+		for (const FName& Stage : OrderedStages)
+		{
+			FAccelByteLoginBootstrapStageReport& StageReport = Run.Stages.AddDefaulted_GetRef();
+			StageReport.Stage = Stage;
+
+			TArray<int32>& Indices = Run.PrerequisiteIndices.AddDefaulted_GetRef();
+			for (const FName& Prerequisite : StageDefinitions.FindChecked(Stage).Prerequisites)
+			{
+				Indices.Add(OrderedStages.IndexOfByKey(Prerequisite));
+			}
+		}
+
+		RunId = Run.RunId;
+		if (OutStages != nullptr)
+		{
+			*OutStages = OrderedStages;
+		}
+		UE_LOG_AB(Log, TEXT("Starting login bootstrap for user %d with %d stages"), LocalUserNum, OrderedStages.Num());
+	}
+
+	AdvanceRun(LocalUserNum, RunId);
+	return true;
+}
+
+void FOnlineLoginBootstrapAccelByte::CancelBootstrap(int32 LocalUserNum)
+{
+	FAccelByteLoginBootstrapReport Report;
+	{
+		FScopeLock ScopeLock(&BootstrapLock);
+
+		FBootstrapRun Run;
+		if (!ActiveRuns.RemoveAndCopyValue(LocalUserNum, Run))
+		{
+			return;
+		}
+
+		for (FAccelByteLoginBootstrapStageReport& StageReport : Run.Stages)
+		{
+			if (StageReport.State == EAccelByteLoginBootstrapStageState::Pending || StageReport.State == EAccelByteLoginBootstrapStageState::Running)
+			{
+				StageReport.State = EAccelByteLoginBootstrapStageState::Cancelled;
+			}
+		}
+
+		Report = MakeReport(Run, FPlatformTime::Seconds());
+		Report.bWasCancelled = true;
+		LastReports.Add(LocalUserNum, Report);
+	}
+
+	UE_LOG_AB(Log, TEXT("Cancelled login bootstrap for user %d after %.3f seconds"), LocalUserNum, Report.TotalDurationSeconds);
+	TriggerOnLoginBootstrapCompleteDelegates(LocalUserNum, Report);
+}
+
+bool FOnlineLoginBootstrapAccelByte::IsBootstrapRunning(int32 LocalUserNum) const
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	return ActiveRuns.Contains(LocalUserNum);
+}
+
+bool FOnlineLoginBootstrapAccelByte::IsStageInBootstrap(int32 LocalUserNum, const FName& Stage) const
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	const FBootstrapRun* Run = ActiveRuns.Find(LocalUserNum);
+	return Run != nullptr && Run->Stages.ContainsByPredicate([&Stage](const FAccelByteLoginBootstrapStageReport& StageReport) {
+		return StageReport.Stage == Stage;
+	});
+}
+
+bool FOnlineLoginBootstrapAccelByte::GetBootstrapReport(int32 LocalUserNum, FAccelByteLoginBootstrapReport& OutReport) const
+{
+	FScopeLock ScopeLock(&BootstrapLock);
+	if (const FBootstrapRun* Run = ActiveRuns.Find(LocalUserNum))
+	{
+		OutReport = MakeReport(*Run, FPlatformTime::Seconds());
+		return true;
+	}
+
+	if (const FAccelByteLoginBootstrapReport* Report = LastReports.Find(LocalUserNum))
+	{
+		OutReport = *Report;
+		return true;
+	}
+
+	return false;
+}
+
+bool FOnlineLoginBootstrapAccelByte::ResolveStages(const TArray<FName>& Stages, TArray<FName>& OutOrderedStages) const
+{
+	// Depth first walk over the prerequisites of each stage, appending a stage only once all of its prerequisites have
+	// been appended. Stages on the current path are tracked separately so that cycles are caught rather than recursed.
+	TSet<FName> Visiting;
+	TFunction<bool(const FName&)> Visit = [this, &Visit, &Visiting, &OutOrderedStages](const FName& Stage) -> bool
+	{
+		if (OutOrderedStages.Contains(Stage))
+		{
+			return true;
+		}
+
+		const FStageDefinition* Definition = StageDefinitions.Find(Stage);
+		if (Definition == nullptr)
+		{
+			UE_LOG_AB(Warning, TEXT("Login bootstrap stage '%s' has not been registered"), *Stage.ToString());
+			return false;
+		}
+
+		bool bIsAlreadyVisiting = false;
+		Visiting.Add(Stage, &bIsAlreadyVisiting);
+		if (bIsAlreadyVisiting)
+		{
+			UE_LOG_AB(Warning, TEXT("Login bootstrap stage '%s' depends on itself"), *Stage.ToString());
+			return false;
+		}
+
+		for (const FName& Prerequisite : Definition->Prerequisites)
+		{
+			if (!Visit(Prerequisite))
+			{
+				return false;
+			}
+		}
+
+		Visiting.Remove(Stage);
+		OutOrderedStages.Add(Stage);
+		return true;
+	};
+
+	for (const FName& Stage : Stages)
+	{
+		if (!Visit(Stage))
+		{
+			OutOrderedStages.Empty();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void FOnlineLoginBootstrapAccelByte::AdvanceRun(int32 LocalUserNum, uint32 RunId)
+{
+	TArray<TPair<FName, FAccelByteLoginBootstrapStageFunction>> StagesToStart;
+	TArray<FAccelByteLoginBootstrapStageReport> SkippedStages;
+	bool bIsRunComplete = false;
+	FAccelByteLoginBootstrapReport Report;
+	{
+		FScopeLock ScopeLock(&BootstrapLock);
+
+		FBootstrapRun* Run = ActiveRuns.Find(LocalUserNum);
+		if (Run == nullptr || Run->RunId != RunId)
+		{
+			return;
+		}
+
+		// Stages are ordered after their prerequisites, so a single pass is enough to propagate skips down the graph
+		const double CurrentTimeInSeconds = FPlatformTime::Seconds();
+		bool bHasUnfinishedStages = false;
+		for (int32 Index = 0; Index < Run->Stages.Num(); Index++)
+		{
+			FAccelByteLoginBootstrapStageReport& StageReport = Run->Stages[Index];
+			if (StageReport.State != EAccelByteLoginBootstrapStageState::Pending)
+			{
+				bHasUnfinishedStages |= StageReport.State == EAccelByteLoginBootstrapStageState::Running;
+				continue;
+			}
+
+			bool bArePrerequisitesMet = true;
+			for (const int32 PrerequisiteIndex : Run->PrerequisiteIndices[Index])
+			{
+				const FAccelByteLoginBootstrapStageReport& PrerequisiteReport = Run->Stages[PrerequisiteIndex];
+				if (PrerequisiteReport.State == EAccelByteLoginBootstrapStageState::Failed || PrerequisiteReport.State == EAccelByteLoginBootstrapStageState::Skipped)
+				{
+					StageReport.State = EAccelByteLoginBootstrapStageState::Skipped;
+					StageReport.Error = FString::Printf(TEXT("prerequisite-%s-not-met"), *PrerequisiteReport.Stage.ToString());
+					SkippedStages.Add(StageReport);
+					break;
+				}
+
+				bArePrerequisitesMet &= PrerequisiteReport.State == EAccelByteLoginBootstrapStageState::Succeeded;
+			}
+
+			if (StageReport.State == EAccelByteLoginBootstrapStageState::Skipped)
+			{
+				continue;
+			}
+
+			bHasUnfinishedStages = true;
+			if (bArePrerequisitesMet)
+			{
+				StageReport.State = EAccelByteLoginBootstrapStageState::Running;
+				StageReport.StartOffsetSeconds = CurrentTimeInSeconds - Run->StartTimeInSeconds;
+				StagesToStart.Emplace(StageReport.Stage, StageDefinitions.FindChecked(StageReport.Stage).Function);
+			}
+		}
+
+		if (!bHasUnfinishedStages)
+		{
+			bIsRunComplete = true;
+			Report = MakeReport(*Run, CurrentTimeInSeconds);
+			LastReports.Add(LocalUserNum, Report);
+			ActiveRuns.Remove(LocalUserNum);
+		}
+	}
+
+	for (const FAccelByteLoginBootstrapStageReport& SkippedStage : SkippedStages)
+	{
+		UE_LOG_AB(Warning, TEXT("Skipping login bootstrap stage '%s' for user %d: %s"), *SkippedStage.Stage.ToString(), LocalUserNum, *SkippedStage.Error);
+		TriggerOnLoginBootstrapStageCompleteDelegates(LocalUserNum, SkippedStage);
+	}
+
+	if (bIsRunComplete)
+	{
+		UE_LOG_AB(Log, TEXT("Login bootstrap for user %d finished in %.3f seconds, bWasSuccessful: %s"), LocalUserNum, Report.TotalDurationSeconds, LOG_BOOL_FORMAT(Report.bWasSuccessful));
+		TriggerOnLoginBootstrapCompleteDelegates(LocalUserNum, Report);
+		return;
+	}
+
+	// Stage functions are started outside of the lock, as they are free to finish synchronously and advance the run again
+	for (const TPair<FName, FAccelByteLoginBootstrapStageFunction>& StageToStart : StagesToStart)
+	{
+		const FOnLoginBootstrapStageFinished OnFinished = FOnLoginBootstrapStageFinished::CreateThreadSafeSP(AsShared(), &FOnlineLoginBootstrapAccelByte::OnStageFinished, LocalUserNum, RunId, StageToStart.Key);
+		StageToStart.Value(LocalUserNum, OnFinished);
+	}
+}
+
+void FOnlineLoginBootstrapAccelByte::OnStageFinished(bool bWasSuccessful, const FString& Error, int32 LocalUserNum, uint32 RunId, FName Stage)
+{
+	FAccelByteLoginBootstrapStageReport StageReport;
+	{
+		FScopeLock ScopeLock(&BootstrapLock);
+
+		// Runs that have been cancelled or restarted since this stage was started are no longer in the map under this ID,
+		// so results from them are dropped here rather than being applied to the current run.
+		FBootstrapRun* Run = ActiveRuns.Find(LocalUserNum);
+		if (Run == nullptr || Run->RunId != RunId)
+		{
+			UE_LOG_AB(VeryVerbose, TEXT("Ignoring result of login bootstrap stage '%s' for user %d as its run is no longer active"), *Stage.ToString(), LocalUserNum);
+			return;
+		}
+
+		FAccelByteLoginBootstrapStageReport* FoundReport = Run->Stages.FindByPredicate([&Stage](const FAccelByteLoginBootstrapStageReport& Candidate) {
+			return Candidate.Stage == Stage;
+		});
+		if (FoundReport == nullptr || FoundReport->State != EAccelByteLoginBootstrapStageState::Running)
+		{
+			return;
+		}
+
+		FoundReport->State = bWasSuccessful ? EAccelByteLoginBootstrapStageState::Succeeded : EAccelByteLoginBootstrapStageState::Failed;
+		FoundReport->DurationSeconds = (FPlatformTime::Seconds() - Run->StartTimeInSeconds) - FoundReport->StartOffsetSeconds;
+		FoundReport->Error = Error;
+		StageReport = *FoundReport;
+	}
+
+	UE_LOG_AB(Verbose, TEXT("Login bootstrap stage '%s' for user %d finished in %.3f seconds, bWasSuccessful: %s"), *Stage.ToString(), LocalUserNum, StageReport.DurationSeconds, LOG_BOOL_FORMAT(bWasSuccessful));
+	TriggerOnLoginBootstrapStageCompleteDelegates(LocalUserNum, StageReport);
+	AdvanceRun(LocalUserNum, RunId);
+}
+
+FAccelByteLoginBootstrapReport FOnlineLoginBootstrapAccelByte::MakeReport(const FBootstrapRun& Run, double CurrentTimeInSeconds)
+{
+	FAccelByteLoginBootstrapReport Report;
+	Report.TotalDurationSeconds = CurrentTimeInSeconds - Run.StartTimeInSeconds;
+	Report.Stages = Run.Stages;
+	Report.bWasSuccessful = !Run.Stages.ContainsByPredicate([](const FAccelByteLoginBootstrapStageReport& StageReport) {
+		return StageReport.State != EAccelByteLoginBootstrapStageState::Succeeded;
+	});
+	return Report;
+}
+
+void FOnlineLoginBootstrapAccelByte::RegisterBuiltInStages()
+{
+	// Friends are loaded over the lobby websocket, whereas the other built in queries go over HTTP and can start as soon
+	// as the user has logged in.
+	RegisterStage(ConnectLobbyStage, {}, [this](int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) {
+		RunConnectLobbyStage(LocalUserNum, OnFinished);
+	});
+	RegisterStage(FriendsStage, { ConnectLobbyStage }, [this](int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) {
+		RunFriendsStage(LocalUserNum, OnFinished);
+	});
+	RegisterStage(BlockedPlayersStage, {}, [this](int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) {
+		RunBlockedPlayersStage(LocalUserNum, OnFinished);
+	});
+	RegisterStage(EntitlementsStage, {}, [this](int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) {
+		RunEntitlementsStage(LocalUserNum, OnFinished);
+	});
+	RegisterStage(CurrenciesStage, {}, [this](int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) {
+		RunCurrenciesStage(LocalUserNum, OnFinished);
+	});
+	RegisterStage(UserProfileStage, {}, [this](int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) {
+		RunUserProfileStage(LocalUserNum, OnFinished);
+	});
+}
+
+void FOnlineLoginBootstrapAccelByte::RunConnectLobbyStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const
+{
+	const FOnlineIdentityAccelBytePtr IdentityInterface = StaticCastSharedPtr<FOnlineIdentityAccelByte>(Subsystem->GetIdentityInterface());
+	const AccelByte::FApiClientPtr ApiClient = Subsystem->GetApiClient(LocalUserNum);
+	if (!IdentityInterface.IsValid() || !ApiClient.IsValid())
+	{
+		OnFinished.ExecuteIfBound(false, TEXT("connect-lobby-failed-not-logged-in"));
+		return;
+	}
+
+	if (ApiClient->Lobby.IsConnected())
+	{
+		OnFinished.ExecuteIfBound(true, TEXT(""));
+		return;
+	}
+
+	TSharedRef<FDelegateHandle> Handle = MakeShared<FDelegateHandle>();
+	const FOnlineSubsystemAccelByte* const OwningSubsystem = Subsystem;
+	*Handle = IdentityInterface->AddOnConnectLobbyCompleteDelegate_Handle(LocalUserNum, FOnConnectLobbyCompleteDelegate::CreateLambda(
+		[OwningSubsystem, Handle, OnFinished](int32 InLocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error) {
+			const IOnlineIdentityPtr Identity = OwningSubsystem->GetIdentityInterface();
+			if (Identity.IsValid())
+			{
+				StaticCastSharedPtr<FOnlineIdentityAccelByte>(Identity)->ClearOnConnectLobbyCompleteDelegate_Handle(InLocalUserNum, *Handle);
+			}
+			OnFinished.ExecuteIfBound(bWasSuccessful, Error);
+		}));
+
+	IdentityInterface->ConnectAccelByteLobby(LocalUserNum);
+}
+
+void FOnlineLoginBootstrapAccelByte::RunFriendsStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const
+{
+	const IOnlineFriendsPtr FriendsInterface = Subsystem->GetFriendsInterface();
+	if (!FriendsInterface.IsValid())
+	{
+		OnFinished.ExecuteIfBound(false, TEXT("read-friends-failed-interface-invalid"));
+		return;
+	}
+
+	FriendsInterface->ReadFriendsList(LocalUserNum, EFriendsLists::ToString(EFriendsLists::Default), FOnReadFriendsListComplete::CreateLambda(
+		[OnFinished](int32 InLocalUserNum, bool bWasSuccessful, const FString& ListName, const FString& Error) {
+			OnFinished.ExecuteIfBound(bWasSuccessful, Error);
+		}));
+}
+
+void FOnlineLoginBootstrapAccelByte::RunBlockedPlayersStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const
+{
+	const IOnlineFriendsPtr FriendsInterface = Subsystem->GetFriendsInterface();
+	const IOnlineIdentityPtr IdentityInterface = Subsystem->GetIdentityInterface();
+	const TSharedPtr<const FUniqueNetId> LocalUserId = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(LocalUserNum) : nullptr;
+	if (!FriendsInterface.IsValid() || !LocalUserId.IsValid())
+	{
+		OnFinished.ExecuteIfBound(false, TEXT("query-blocked-players-failed-not-logged-in"));
+		return;
+	}
+
+	// Query with a delegate of our own rather than the interface's, so that blocked player queries made by the game
+	// are not mistaken for the result of this stage
+	const FOnQueryBlockedPlayersCompleteDelegate OnQueryComplete = FOnQueryBlockedPlayersCompleteDelegate::CreateLambda(
+		[OnFinished](const FUniqueNetId& UserId, bool bWasSuccessful, const FString& Error) {
+			OnFinished.ExecuteIfBound(bWasSuccessful, Error);
+		});
+
+	Subsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryBlockedPlayers>(Subsystem, LocalUserId.ToSharedRef().Get(), OnQueryComplete);
+}
+
+void FOnlineLoginBootstrapAccelByte::RunEntitlementsStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const
+{
+	const IOnlineEntitlementsPtr EntitlementsInterface = Subsystem->GetEntitlementsInterface();
+	const IOnlineIdentityPtr IdentityInterface = Subsystem->GetIdentityInterface();
+	const TSharedPtr<const FUniqueNetId> LocalUserId = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(LocalUserNum) : nullptr;
+	if (!EntitlementsInterface.IsValid() || !LocalUserId.IsValid())
+	{
+		OnFinished.ExecuteIfBound(false, TEXT("query-entitlements-failed-not-logged-in"));
+		return;
+	}
+
+	// Query with a delegate of our own rather than the interface's, so that entitlement queries made by the game are
+	// not mistaken for the result of this stage
+	const FOnQueryEntitlementsCompleteDelegate OnQueryComplete = FOnQueryEntitlementsCompleteDelegate::CreateLambda(
+		[OnFinished](bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Namespace, const FString& Error) {
+			OnFinished.ExecuteIfBound(bWasSuccessful, Error);
+		});
+
+	Subsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryEntitlements>(Subsystem, LocalUserId.ToSharedRef().Get(), TEXT(""), FPagedQuery(), TEXT(""), OnQueryComplete);
+}
+
+void FOnlineLoginBootstrapAccelByte::RunCurrenciesStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const
+{
+	const FOnlineWalletAccelBytePtr WalletInterface = Subsystem->GetWalletInterface();
+	const IOnlineIdentityPtr IdentityInterface = Subsystem->GetIdentityInterface();
+	const TSharedPtr<const FUniqueNetId> LocalUserId = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(LocalUserNum) : nullptr;
+	if (!WalletInterface.IsValid() || !LocalUserId.IsValid())
+	{
+		OnFinished.ExecuteIfBound(false, TEXT("get-currency-list-failed-not-logged-in"));
+		return;
+	}
+
+	// Request with a delegate of our own rather than the interface's, so that currency list requests made by the game
+	// for this user are not mistaken for the result of this stage
+	const FOnGetCurrencyListCompletedDelegate OnGetComplete = FOnGetCurrencyListCompletedDelegate::CreateLambda(
+		[OnFinished](int32 InLocalUserNum, bool bWasSuccessful, const TArray<FAccelByteModelsCurrencyList>& Response, const FString& Error) {
+			OnFinished.ExecuteIfBound(bWasSuccessful, Error);
+		});
+
+	Subsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteGetCurrencyList>(Subsystem, LocalUserId.ToSharedRef().Get(), false, OnGetComplete);
+}
+
+void FOnlineLoginBootstrapAccelByte::RunUserProfileStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const
+{
+	FOnlineUserAccelBytePtr UserInterface = nullptr;
+	const IOnlineIdentityPtr IdentityInterface = Subsystem->GetIdentityInterface();
+	const TSharedPtr<const FUniqueNetId> LocalUserId = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(LocalUserNum) : nullptr;
+	if (!FOnlineUserAccelByte::GetFromSubsystem(Subsystem, UserInterface) || !LocalUserId.IsValid())
+	{
+		OnFinished.ExecuteIfBound(false, TEXT("query-user-profile-failed-not-logged-in"));
+		return;
+	}
+
+	// Query with a delegate of our own rather than the interface's, so that profile queries made by the game for this
+	// user are not mistaken for the result of this stage
+	const TSharedRef<const FUniqueNetId> LocalUserIdRef = LocalUserId.ToSharedRef();
+	FOnlineSubsystemAccelByte* const OwningSubsystem = Subsystem;
+	FOnQueryUserProfileComplete OnQueryComplete;
+	OnQueryComplete.AddLambda([OwningSubsystem, LocalUserIdRef, OnFinished](int32 InLocalUserNum, bool bWasSuccessful, const TArray<FUniqueNetIdRef>& UserIds, const FOnlineError& Error) {
+		// A failed query says nothing about whether the profile exists, so fail the stage rather than creating one
+		if (!bWasSuccessful)
+		{
+			OnFinished.ExecuteIfBound(false, Error.GetErrorCode());
+			return;
+		}
+
+		if (UserIds.Num() > 0)
+		{
+			OnFinished.ExecuteIfBound(true, TEXT(""));
+			return;
+		}
+
+		// No profile was returned for the user, so this is most likely their first login in the game namespace
+		FOnlineUserAccelBytePtr User = nullptr;
+		if (!FOnlineUserAccelByte::GetFromSubsystem(OwningSubsystem, User))
+		{
+			OnFinished.ExecuteIfBound(false, TEXT("create-user-profile-failed-interface-invalid"));
+			return;
+		}
+
+		TSharedRef<FDelegateHandle> Handle = MakeShared<FDelegateHandle>();
+		*Handle = User->AddOnCreateUserProfileCompleteDelegate_Handle(InLocalUserNum, FOnCreateUserProfileCompleteDelegate::CreateLambda(
+			[OwningSubsystem, Handle, OnFinished](int32 CreateLocalUserNum, bool bWasCreated, const FOnlineError& CreateError) {
+				FOnlineUserAccelBytePtr CreateUser = nullptr;
+				if (FOnlineUserAccelByte::GetFromSubsystem(OwningSubsystem, CreateUser))
+				{
+					CreateUser->ClearOnCreateUserProfileCompleteDelegate_Handle(CreateLocalUserNum, *Handle);
+				}
+				OnFinished.ExecuteIfBound(bWasCreated, CreateError.GetErrorCode());
+			}));
+
+		User->CreateUserProfile(LocalUserIdRef.Get());
+	});
+
+	Subsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryUserProfile>(Subsystem, LocalUserNum, TArray<TSharedRef<const FUniqueNetId>>{ LocalUserIdRef }, OnQueryComplete);
+}
@@ -0,0 +1,268 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineOperationTraceAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include <atomic>
+
+namespace
+{
+	/** Context of the span in progress on each thread */
+	thread_local FAccelByteTraceContext CurrentTraceContext;
+
+	/** Source of trace and span IDs, shared by every subsystem instance so that IDs never collide across instances */
+	std::atomic<uint64> NextTraceId{1};
+}
+
+FAccelByteTraceContext FAccelByteTraceContext::GetCurrent()
+{
+	return CurrentTraceContext;
+}
+
+FAccelByteTraceContext FAccelByteTraceContext::SetCurrent(const FAccelByteTraceContext& InContext)
+{
+	const FAccelByteTraceContext PreviousContext = CurrentTraceContext;
+	CurrentTraceContext = InContext;
+	return PreviousContext;
+}
+
+FOnlineOperationTraceAccelByte::FOnlineOperationTraceAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	bool bEnableOnStartup = false;
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bEnableOperationTracing"), bEnableOnStartup, GEngineIni);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("OperationTraceMaxSpans"), MaxSpans, GEngineIni);
+	MaxSpans = FMath::Max(1, MaxSpans);
+	bIsEnabled = bEnableOnStartup;
+}
+
+void FOnlineOperationTraceAccelByte::SetEnabled(bool bInIsEnabled)
+{
+	bIsEnabled = bInIsEnabled;
+}
+
+FAccelByteTraceContext FOnlineOperationTraceAccelByte::CreateSpanContext(const FAccelByteTraceContext& Parent) const
+{
+	FAccelByteTraceContext Context;
+	if (!bIsEnabled)
+	{
+		return Context;
+	}
+
+	Context.SpanId = NextTraceId++;
+	if (Parent.IsValid())
+	{
+		Context.TraceId = Parent.TraceId;
+		Context.ParentSpanId = Parent.SpanId;
+	}
+	else
+	{
+		// Root spans share their ID with the trace they start
+		Context.TraceId = Context.SpanId;
+	}
+	return Context;
+}
+
+void FOnlineOperationTraceAccelByte::AddSpan(const FString& Name, const FAccelByteTraceContext& Context, double StartTimeInSeconds, double EndTimeInSeconds)
+{
+	if (!Context.IsValid())
+	{
+		return;
+	}
+
+	FAccelByteTraceSpan Span;
+	Span.Name = Name;
+	Span.Context = Context;
+	Span.StartTimeInSeconds = StartTimeInSeconds;
+	Span.EndTimeInSeconds = FMath::Max(StartTimeInSeconds, EndTimeInSeconds);
+	Span.ThreadId = FPlatformTLS::GetCurrentThreadId();
+
+	FScopeLock ScopeLock(&SpansLock);
+	if (Spans.Num() < MaxSpans)
+	{
+		Spans.Emplace(MoveTemp(Span));
+		return;
+	}
+
+	Spans[NextSpanIndex] = MoveTemp(Span);
+	NextSpanIndex = (NextSpanIndex + 1) % MaxSpans;
+}
+
+TArray<FAccelByteTraceSpan> FOnlineOperationTraceAccelByte::GetSpans() const
+{
+	FScopeLock ScopeLock(&SpansLock);
+	return GetOrderedSpans();
+}
+
+TArray<FAccelByteTraceSpan> FOnlineOperationTraceAccelByte::GetSpansForTrace(uint64 TraceId) const
+{
+	TArray<FAccelByteTraceSpan> TraceSpans = GetSpans();
+	TraceSpans.RemoveAll([TraceId](const FAccelByteTraceSpan& Span) {
+		return Span.Context.TraceId != TraceId;
+	});
+	return TraceSpans;
+}
+
+void FOnlineOperationTraceAccelByte::Clear()
+{
+	FScopeLock ScopeLock(&SpansLock);
+	Spans.Empty();
+	NextSpanIndex = 0;
+}
+
+bool FOnlineOperationTraceAccelByte::ExportChromeTrace(const FString& FilePath, FString& OutFilePath) const
+{
+	OutFilePath = FilePath;
+	if (OutFilePath.IsEmpty())
+	{
+		OutFilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AccelByte"), TEXT("Traces"), FString::Printf(TEXT("OnlineTrace-%s.json"), *FDateTime::Now().ToString()));
+	}
+
+	return FFileHelper::SaveStringToFile(SerializeChromeTrace(), *OutFilePath);
+}
+
+FString FOnlineOperationTraceAccelByte::SerializeChromeTrace() const
+{
+	TArray<FAccelByteTraceSpan> ExportedSpans = GetSpans();
+
+	// Spans such as an interface call end as soon as they have dispatched their tasks, so extend each span to cover the
+	// spans nested under it. Otherwise an operation's root span would not contain the rest of its critical path.
+	TMap<uint64, int32> SpanIdToIndex;
+	SpanIdToIndex.Reserve(ExportedSpans.Num());
+	for (int32 Index = 0; Index < ExportedSpans.Num(); Index++)
+	{
+		SpanIdToIndex.Add(ExportedSpans[Index].Context.SpanId, Index);
+	}
+	for (const FAccelByteTraceSpan& Span : ExportedSpans)
+	{
+		uint64 ParentSpanId = Span.Context.ParentSpanId;
+		while (const int32* ParentIndex = SpanIdToIndex.Find(ParentSpanId))
+		{
+			FAccelByteTraceSpan& Parent = ExportedSpans[*ParentIndex];
+			if (Parent.EndTimeInSeconds >= Span.EndTimeInSeconds)
+			{
+				break;
+			}
+			Parent.EndTimeInSeconds = Span.EndTimeInSeconds;
+			ParentSpanId = Parent.Context.ParentSpanId;
+		}
+	}
+
+	ExportedSpans.Sort([](const FAccelByteTraceSpan& A, const FAccelByteTraceSpan& B) {
+		return A.StartTimeInSeconds < B.StartTimeInSeconds;
+	});
+	const double FirstStartTimeInSeconds = (ExportedSpans.Num() > 0) ? ExportedSpans[0].StartTimeInSeconds : 0.0;
+
+	FString OutString;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutString);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("displayTimeUnit"), TEXT("ms"));
+	Writer->WriteArrayStart(TEXT("traceEvents"));
+
+	// Each span is written as a pair of async begin and end events keyed by its own span ID. Keying by trace ID would let
+	// the viewer match the begin of one span to the end of an overlapping span of the same name, such as two tasks of the
+	// same class running in parallel. The trace ID is kept in the args, so that an operation's spans can still be found.
+	const auto WriteEvent = [&Writer, FirstStartTimeInSeconds](const FAccelByteTraceSpan& Span, const TCHAR* Phase, double TimeInSeconds) {
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("name"), Span.Name);
+		Writer->WriteValue(TEXT("cat"), TEXT("AccelByteOSS"));
+		Writer->WriteValue(TEXT("ph"), Phase);
+		Writer->WriteValue(TEXT("id"), FString::Printf(TEXT("0x%llx"), Span.Context.SpanId));
+		Writer->WriteValue(TEXT("ts"), (TimeInSeconds - FirstStartTimeInSeconds) * 1000000.0);
+		Writer->WriteValue(TEXT("pid"), 1);
+		Writer->WriteValue(TEXT("tid"), static_cast<int64>(Span.ThreadId));
+		Writer->WriteObjectStart(TEXT("args"));
+		Writer->WriteValue(TEXT("traceId"), FString::Printf(TEXT("0x%llx"), Span.Context.TraceId));
+		Writer->WriteValue(TEXT("spanId"), FString::Printf(TEXT("0x%llx"), Span.Context.SpanId));
+		Writer->WriteValue(TEXT("parentSpanId"), FString::Printf(TEXT("0x%llx"), Span.Context.ParentSpanId));
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	};
+
+	for (const FAccelByteTraceSpan& Span : ExportedSpans)
+	{
+		WriteEvent(Span, TEXT("b"), Span.StartTimeInSeconds);
+		WriteEvent(Span, TEXT("e"), Span.EndTimeInSeconds);
+	}
+
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+	return OutString;
+}
+
+void FOnlineOperationTraceAccelByte::SetMaxSpans(int32 InMaxSpans)
+{
+	FScopeLock ScopeLock(&SpansLock);
+	MaxSpans = FMath::Max(1, InMaxSpans);
+	Spans.Empty();
+	NextSpanIndex = 0;
+}
+
+TArray<FAccelByteTraceSpan> FOnlineOperationTraceAccelByte::GetOrderedSpans() const
+{
+	if (Spans.Num() < MaxSpans)
+	{
+		return Spans;
+	}
+
+	// Once the buffer is full, the oldest span is the one that will be overwritten next
+	TArray<FAccelByteTraceSpan> OrderedSpans;
+	OrderedSpans.Reserve(Spans.Num());
+	OrderedSpans.Append(Spans.GetData() + NextSpanIndex, Spans.Num() - NextSpanIndex);
+	OrderedSpans.Append(Spans.GetData(), NextSpanIndex);
+	return OrderedSpans;
+}
+
+FAccelByteTraceContextScope::FAccelByteTraceContextScope(const FAccelByteTraceContext& InContext)
+{
+	if (InContext.IsValid())
+	{
+		PreviousContext = FAccelByteTraceContext::SetCurrent(InContext);
+		bHasSetContext = true;
+	}
+}
+
+FAccelByteTraceContextScope::~FAccelByteTraceContextScope()
+{
+	if (bHasSetContext)
+	{
+		FAccelByteTraceContext::SetCurrent(PreviousContext);
+	}
+}
+
+FAccelByteTraceSpanScope::FAccelByteTraceSpanScope(const FOnlineSubsystemAccelByte* InSubsystem, const TCHAR* InName)
+	: FAccelByteTraceSpanScope((InSubsystem != nullptr) ? InSubsystem->GetOperationTrace() : nullptr, InName)
+{
+}
+
+FAccelByteTraceSpanScope::FAccelByteTraceSpanScope(const TSharedPtr<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe>& InTrace, const TCHAR* InName)
+	: Trace(InTrace)
+	, Name(InName)
+{
+	if (!Trace.IsValid() || !Trace->IsEnabled())
+	{
+		return;
+	}
+
+	Context = Trace->CreateSpanContext(FAccelByteTraceContext::GetCurrent());
+	PreviousContext = FAccelByteTraceContext::SetCurrent(Context);
+	StartTimeInSeconds = FPlatformTime::Seconds();
+}
+
+FAccelByteTraceSpanScope::~FAccelByteTraceSpanScope()
+{
+	if (!Context.IsValid())
+	{
+		return;
+	}
+
+	FAccelByteTraceContext::SetCurrent(PreviousContext);
+	Trace->AddSpan(Name, Context, StartTimeInSeconds, FPlatformTime::Seconds());
+}
@@ -4,10 +4,12 @@
 
 #include "OnlinePartyInterfaceAccelByte.h"
 #include "OnlineSubsystemAccelByte.h"
+#include "OnlineLobbyNotificationQueueAccelByte.h"
 #include "OnlineError.h"
 #include "Api/AccelByteLobbyApi.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineSessionInterfaceV1AccelByte.h"
+#include "OnlineCloudSaveInterfaceAccelByte.h"
 #include "OnlineSessionSettings.h"
 #include "AsyncTasks/PartyV1/OnlineAsyncTaskAccelByteCreateV1Party.h"
 #include "AsyncTasks/PartyV1/OnlineAsyncTaskAccelByteJoinV1Party.h"
@@ -26,6 +28,9 @@
 // we do not support the current method that the developer is attempting to call
 #define UNSUPPORTED_METHOD_REASON -10000
 
+/** Amount of times in a row that a failed party data write is queued again before its changes are dropped */
+#define PARTY_DATA_WRITE_MAX_RETRIES 3
+
 bool WarnForUsingV1PartyWithV2Sessions()
 {
 #if AB_USE_V2_SESSIONS
@@ -84,6 +89,7 @@ FOnlinePartyAccelByte::FOnlinePartyAccelByte(const TSharedRef<FOnlinePartySystem
 {
 	SetState(EPartyState::Active);
 	LeaderId = InLeaderId;
+	RefreshCrossplayCache();
 }
 
 bool FOnlinePartyAccelByte::CanLocalUserInvite(const FUniqueNetId& LocalUserId) const
@@ -145,16 +151,22 @@ TSharedRef<FOnlinePartyAccelByte> FOnlinePartyAccelByte::CreatePartyFromPartyInf
 		LeaderCompositeId = (*FoundPartyLeader)->Id.ToSharedRef();
 	}
 
+	// Index member statuses by user ID up front so that each member below is a single lookup rather than a scan
+	TMap<FString, const FAccelByteModelsUserStatusNotif*> UserIdToMemberStatusMap;
+	UserIdToMemberStatusMap.Reserve(InPartyMemberStatus.Data.Num());
+	for (const FAccelByteModelsUserStatusNotif& Status : InPartyMemberStatus.Data)
+	{
+		UserIdToMemberStatusMap.Add(Status.UserID, &Status);
+	}
+
 	TSharedRef<FOnlinePartyAccelByte> Party = MakeShared<FOnlinePartyAccelByte>(PartyInterface, PartyInfo.PartyId, PartyInfo.InvitationToken, Config, LeaderCompositeId, InPartyData);
 	for (const TSharedRef<FAccelByteUserInfo>& Member : PartyMemberInfo)
 	{
 		TSharedRef<FOnlinePartyMemberAccelByte> PartyMember = MakeShared<FOnlinePartyMemberAccelByte>(Member->Id.ToSharedRef(), Member->DisplayName);
-		const FAccelByteModelsUserStatusNotif* MemberStatus = InPartyMemberStatus.Data.FindByPredicate([&Member](FAccelByteModelsUserStatusNotif const& Status)
-		{
-			return Member->Id->GetAccelByteId().Equals(Status.UserID);
-		});
-		if(MemberStatus != nullptr)
+		const FAccelByteModelsUserStatusNotif* const* FoundMemberStatus = UserIdToMemberStatusMap.Find(Member->Id->GetAccelByteId());
+		if (FoundMemberStatus != nullptr)
 		{
+			const FAccelByteModelsUserStatusNotif* MemberStatus = *FoundMemberStatus;
 			EMemberConnectionStatus NewMemberStatusConnection = EMemberConnectionStatus::Uninitialized;
 			switch(MemberStatus->Availability)
 			{
@@ -200,7 +212,17 @@ TSharedRef<FOnlinePartyAccelByte> FOnlinePartyAccelByte::CreatePartyFromPartyInf
 void FOnlinePartyAccelByte::AddMember(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const TSharedRef<FOnlinePartyMemberAccelByte>& Member)
 {
 	TSharedRef<const FUniqueNetId> NewMemberId = Member->GetUserId();
-	UserIdToPartyMemberMap.Add(FUniqueNetIdAccelByteUser::CastChecked(NewMemberId), Member);
+	TSharedRef<const FUniqueNetIdAccelByteUser> NewMemberAccelByteId = FUniqueNetIdAccelByteUser::CastChecked(NewMemberId);
+
+	// If we already have this user under a different composite ID, drop the old entry so that both maps stay in sync
+	const TSharedRef<FOnlinePartyMemberAccelByte>* ExistingMember = AccelByteIdToPartyMemberMap.Find(NewMemberAccelByteId->GetAccelByteId());
+	if (ExistingMember != nullptr)
+	{
+		UserIdToPartyMemberMap.Remove(FUniqueNetIdAccelByteUser::CastChecked((*ExistingMember)->GetUserId()));
+	}
+
+	UserIdToPartyMemberMap.Add(NewMemberAccelByteId, Member);
+	AccelByteIdToPartyMemberMap.Add(NewMemberAccelByteId->GetAccelByteId(), Member);
 	OwningInterface->TriggerOnPartyMemberJoinedDelegates(LocalUserId.Get(), PartyId.Get(), NewMemberId.Get());
 }
 
@@ -212,13 +234,15 @@ void FOnlinePartyAccelByte::AddUserToInvitedPlayers(const TSharedRef<const FUniq
 
 TSharedPtr<const FOnlinePartyMemberAccelByte> FOnlinePartyAccelByte::GetMember(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId) const
 {
-	for (auto UserIdToPartyMemberPair : UserIdToPartyMemberMap)
+	return GetMemberByAccelByteId(UserId->GetAccelByteId());
+}
+
+TSharedPtr<FOnlinePartyMemberAccelByte> FOnlinePartyAccelByte::GetMemberByAccelByteId(const FString& AccelByteId) const
+{
+	const TSharedRef<FOnlinePartyMemberAccelByte>* FoundMember = AccelByteIdToPartyMemberMap.Find(AccelByteId);
+	if (FoundMember != nullptr)
 	{
-		TSharedRef<const FUniqueNetIdAccelByteUser> UserIdKey = UserIdToPartyMemberPair.Key;
-		if (UserIdKey->GetAccelByteId() == UserId->GetAccelByteId())
-		{
-			return UserIdToPartyMemberPair.Value;
-		}
+		return *FoundMember;
 	}
 	return nullptr;
 }
@@ -226,23 +250,23 @@ TSharedPtr<const FOnlinePartyMemberAccelByte> FOnlinePartyAccelByte::GetMember(c
 bool FOnlinePartyAccelByte::RemoveMember(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const TSharedRef<const FUniqueNetIdAccelByteUser>& RemovedUserId, const EMemberExitedReason& ExitReason)
 {
 	bool bIsMemberFound = false;
-	// First, try and find the party member in the map of members, if we find them then we can remove
-	for (auto UserIdToPartyMemberPair : UserIdToPartyMemberMap)
+	// First, try and find the party member by their AccelByte ID, if we find them then we can remove
+	const FString RemovedAccelByteId = RemovedUserId->GetAccelByteId();
+	const TSharedRef<FOnlinePartyMemberAccelByte>* FoundMember = AccelByteIdToPartyMemberMap.Find(RemovedAccelByteId);
+	if (FoundMember != nullptr)
 	{
-		TSharedRef<const FUniqueNetIdAccelByteUser> UserIdKey = UserIdToPartyMemberPair.Key;
-		if (UserIdKey->GetAccelByteId() == RemovedUserId->GetAccelByteId())
-		{
-			// Only commit to removing the user from the party data if we are the leader, otherwise there will be duplicate requests
-			// to remove the user from the party storage on the backend
-			if (LeaderId.ToSharedRef().Get() == LocalUserId.Get())
-			{
-				RemovePlayerCrossplayPreferenceAndPlatform(LocalUserId, RemovedUserId);
-			}
+		const TSharedRef<const FUniqueNetIdAccelByteUser> MemberKey = FUniqueNetIdAccelByteUser::CastChecked((*FoundMember)->GetUserId());
 
-			UserIdToPartyMemberMap.Remove(UserIdKey);
-			bIsMemberFound = true;
-			break;
+		// Only commit to removing the user from the party data if we are the leader, otherwise there will be duplicate requests
+		// to remove the user from the party storage on the backend
+		if (LeaderId.ToSharedRef().Get() == LocalUserId.Get())
+		{
+			RemovePlayerCrossplayPreferenceAndPlatform(LocalUserId, RemovedUserId);
 		}
+
+		UserIdToPartyMemberMap.Remove(MemberKey);
+		AccelByteIdToPartyMemberMap.Remove(RemovedAccelByteId);
+		bIsMemberFound = true;
 	}
 	OwningInterface->TriggerOnPartyMemberExitedDelegates(LocalUserId.Get(), PartyId.Get(), RemovedUserId.Get(), ExitReason);
 	return bIsMemberFound;
@@ -314,6 +338,131 @@ TSharedRef<const FOnlinePartyData> FOnlinePartyAccelByte::GetPartyData() const
 void FOnlinePartyAccelByte::SetPartyData(TSharedRef<FOnlinePartyData> InPartyData)
 {
 	PartyData = InPartyData;
+
+	// Re-apply any local changes that have not been flushed yet, otherwise they would be lost if new party data arrives
+	// from the backend in the same frame that they were made
+	for (const TPair<FString, FVariantData>& Attribute : PendingChangedAttributes)
+	{
+		PartyData->SetAttribute(Attribute.Key, Attribute.Value);
+	}
+	for (const FString& AttrName : PendingRemovedAttributes)
+	{
+		PartyData->RemoveAttribute(AttrName);
+	}
+
+	// Pending changes are tracked and sent separately, so the shared data never carries dirty flags of its own
+	PartyData->ClearDirty();
+
+	RefreshCrossplayCache();
+}
+
+void FOnlinePartyAccelByte::SetPartyDataAttribute(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const FString& AttrName, const FVariantData& AttrValue)
+{
+	// Copy rather than change the shared data in place, so that data the game already holds is left alone, and clear the
+	// dirty flags on the copy. A game that later copies this data and changes one key then only sends that key, rather
+	// than every key changed since the last notification.
+	TSharedRef<FOnlinePartyData> NewPartyData = MakeShared<FOnlinePartyData>(PartyData.Get());
+	NewPartyData->SetAttribute(AttrName, AttrValue);
+	NewPartyData->ClearDirty();
+	PartyData = NewPartyData;
+	PendingChangedAttributes.Add(AttrName, AttrValue);
+	PendingRemovedAttributes.Remove(AttrName);
+
+	if (AttrName == CROSSPLAY_OBJECT_NAME)
+	{
+		RefreshCrossplayCache();
+	}
+
+	SchedulePartyDataFlush(LocalUserId);
+}
+
+void FOnlinePartyAccelByte::RemovePartyDataAttribute(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const FString& AttrName)
+{
+	// Copy on write with dirty flags cleared, for the same reasons as SetPartyDataAttribute
+	TSharedRef<FOnlinePartyData> NewPartyData = MakeShared<FOnlinePartyData>(PartyData.Get());
+	NewPartyData->RemoveAttribute(AttrName);
+	NewPartyData->ClearDirty();
+	PartyData = NewPartyData;
+	PendingChangedAttributes.Remove(AttrName);
+	PendingRemovedAttributes.Add(AttrName);
+
+	if (AttrName == CROSSPLAY_OBJECT_NAME)
+	{
+		RefreshCrossplayCache();
+	}
+
+	SchedulePartyDataFlush(LocalUserId);
+}
+
+void FOnlinePartyAccelByte::SchedulePartyDataFlush(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId)
+{
+	if (bIsPartyDataFlushScheduled)
+	{
+		return;
+	}
+
+	bIsPartyDataFlushScheduled = true;
+	OwningInterface->FlushPartyDataUpdatesNextTick(LocalUserId, StaticCastSharedRef<FOnlinePartyAccelByte>(AsShared()));
+}
+
+void FOnlinePartyAccelByte::FlushPendingPartyDataUpdates(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId)
+{
+	bIsPartyDataFlushScheduled = false;
+	if (PendingChangedAttributes.Num() <= 0 && PendingRemovedAttributes.Num() <= 0)
+	{
+		return;
+	}
+
+	OwningInterface->UpdatePartyDataAttributes(LocalUserId, StaticCastSharedRef<const FOnlinePartyIdAccelByte>(PartyId), PendingChangedAttributes, PendingRemovedAttributes.Array());
+
+	PendingChangedAttributes.Empty();
+	PendingRemovedAttributes.Empty();
+}
+
+void FOnlinePartyAccelByte::OnPartyDataUpdateComplete(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, bool bWasSuccessful, const FOnlineKeyValuePairs<FString, FVariantData>& ChangedAttributes, const TArray<FString>& RemovedAttributes)
+{
+	if (bWasSuccessful)
+	{
+		ConsecutivePartyDataWriteFailures = 0;
+		return;
+	}
+
+	ConsecutivePartyDataWriteFailures++;
+	if (ConsecutivePartyDataWriteFailures > PARTY_DATA_WRITE_MAX_RETRIES)
+	{
+		UE_LOG_AB(Warning, TEXT("Dropping %d changed and %d removed party data attribute(s) for party '%s' after %d failed writes!"), ChangedAttributes.Num(), RemovedAttributes.Num(), *PartyId->ToString(), ConsecutivePartyDataWriteFailures);
+		ConsecutivePartyDataWriteFailures = 0;
+		return;
+	}
+
+	// Keys that were changed again locally since the failed write are already queued with a newer value, so skip those.
+	// Everything else is queued with its current local value, as party data may have been replaced since the write.
+	const auto RequeueAttribute = [this](const FString& AttrName) {
+		if (PendingChangedAttributes.Contains(AttrName) || PendingRemovedAttributes.Contains(AttrName))
+		{
+			return;
+		}
+
+		FVariantData AttrValue;
+		if (PartyData->GetAttribute(AttrName, AttrValue))
+		{
+			PendingChangedAttributes.Add(AttrName, AttrValue);
+		}
+		else
+		{
+			PendingRemovedAttributes.Add(AttrName);
+		}
+	};
+	for (const TPair<FString, FVariantData>& Attribute : ChangedAttributes)
+	{
+		RequeueAttribute(Attribute.Key);
+	}
+	for (const FString& AttrName : RemovedAttributes)
+	{
+		RequeueAttribute(AttrName);
+	}
+
+	SchedulePartyDataFlush(LocalUserId);
 }
 
 void FOnlinePartyAccelByte::AddPlayerCrossplayPreferenceAndPlatform(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId)
@@ -370,18 +519,9 @@ void FOnlinePartyAccelByte::AddPlayerCrossplayPreferenceAndPlatform(const TShare
 	// Map the current user by their AccelByte ID to their platform and crossplay preference
 	CrossplayPlatformMapObject->SetObjectField(LocalUserId->GetAccelByteId(), CurrentPlayerPreferences);
 
-	// Create a copy of the old party data instance, add our updated crossplay platform map object to the copy
-	// and then set the copy as the new party data
-	TSharedRef<FOnlinePartyData> NewPartyData = MakeShared<FOnlinePartyData>(CurrentPartyData.Get());
-	NewPartyData->SetAttribute(CROSSPLAY_OBJECT_NAME, FVariantData(CrossplayPlatformMapObject.ToSharedRef()));
-	SetPartyData(NewPartyData);
-
-	// Finally, send a request to update the party data on the backend
-#if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 26)
-	OwningInterface->UpdatePartyData(LocalUserId.Get(), PartyId.Get(), NAME_Game, PartyData.Get());
-#else
-	OwningInterface->UpdatePartyData(LocalUserId.Get(), PartyId.Get(), PartyData.Get());
-#endif
+	// Finally, set the updated crossplay platform map object on our party data, this will be sent to the backend along
+	// with any other attribute changes made this frame
+	SetPartyDataAttribute(LocalUserId, CROSSPLAY_OBJECT_NAME, FVariantData(CrossplayPlatformMapObject.ToSharedRef()));
 }
 
 void FOnlinePartyAccelByte::RemovePlayerCrossplayPreferenceAndPlatform(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const TSharedRef<const FUniqueNetIdAccelByteUser>& UserToRemove)
@@ -402,20 +542,16 @@ void FOnlinePartyAccelByte::RemovePlayerCrossplayPreferenceAndPlatform(const TSh
 	}
 
 	// Remove the crossplay/platform preference mapped to the user specified
+	if (!CrossplayPlatformMapObject.IsValid() || !CrossplayPlatformMapObject->HasField(UserToRemove->GetAccelByteId()))
+	{
+		// Nothing to remove, so there is no need to send an update
+		return;
+	}
 	CrossplayPlatformMapObject->RemoveField(UserToRemove->GetAccelByteId());
 
-	// Create a copy of the old party data instance, add our updated crossplay platform map object to the copy
-	// and then set the copy as the new party data
-	TSharedRef<FOnlinePartyData> NewPartyData = MakeShared<FOnlinePartyData>(CurrentPartyData.Get());
-	NewPartyData->SetAttribute(CROSSPLAY_OBJECT_NAME, FVariantData(CrossplayPlatformMapObject.ToSharedRef()));
-	SetPartyData(NewPartyData);
-
-	// Finally, send a request to update the party data on the backend
-#if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 26)
-	OwningInterface->UpdatePartyData(LocalUserId.Get(), PartyId.Get(), NAME_Game, PartyData.Get());
-#else
-	OwningInterface->UpdatePartyData(LocalUserId.Get(), PartyId.Get(), PartyData.Get());
-#endif
+	// Finally, set the updated crossplay platform map object on our party data, this will be sent to the backend along
+	// with any other attribute changes made this frame
+	SetPartyDataAttribute(LocalUserId, CROSSPLAY_OBJECT_NAME, FVariantData(CrossplayPlatformMapObject.ToSharedRef()));
 }
 
 void FOnlinePartyAccelByte::AddPlayerAcceptedTicketId(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const FString& TicketId, const FString& MatchId)
@@ -446,92 +582,78 @@ void FOnlinePartyAccelByte::RemovePlayerAcceptedTicketId(const TSharedRef<const
 
 void FOnlinePartyAccelByte::SetPartyCode(const FString& PartyCode)
 {
-	// Create a copy of the old party data instance, and append our party code to it, then set it
-	TSharedRef<FOnlinePartyData> NewPartyData = MakeShared<FOnlinePartyData>(PartyData.Get());
-	NewPartyData->SetAttribute(PARTYDATA_PARTYCODE_ATTR, PartyCode);
-	SetPartyData(NewPartyData);
+	// Party code is only stored locally, so just set it on our existing party data rather than copying the whole instance
+	PartyData->SetAttribute(PARTYDATA_PARTYCODE_ATTR, PartyCode);
 }
 
-bool FOnlinePartyAccelByte::IsCrossplayParty()
+bool FOnlinePartyAccelByte::IsCrossplayParty() const
 {
-	FVariantData OutVariantData;
-	if (!PartyData->GetAttribute(CROSSPLAY_OBJECT_NAME, OutVariantData))
-	{
-		// Cannot confirm that this party is crossplay, so just return false
-		return false;
-	}
+	return bIsCrossplayParty;
+}
 
-	TSharedPtr<FJsonObject> CrossplayObject;
-	OutVariantData.GetValue(CrossplayObject);
-	if (!CrossplayObject.IsValid())
-	{
-		// Still cannot confirm that this party is crossplay, so return false
-		return false;
-	}
+const TArray<FString>& FOnlinePartyAccelByte::GetUniquePlatformsForParty() const
+{
+	return UniquePlatforms;
+}
 
-	// Iterate through each value in the crossplay object to get the object associated with the user and then to
-	// subsequently check their crossplay preference, if that preference is false, then this party isn't crossplay
-	for (const TPair<FString, TSharedPtr<FJsonValue>>& KV : CrossplayObject->Values)
+bool FOnlinePartyAccelByte::GetMemberCrossplayInfo(const FString& AccelByteId, FAccelBytePartyMemberCrossplayInfo& OutCrossplayInfo) const
+{
+	const FAccelBytePartyMemberCrossplayInfo* FoundInfo = MemberCrossplayInfoMap.Find(AccelByteId);
+	if (FoundInfo == nullptr)
 	{
-		TSharedPtr<FJsonObject> PrefObject = KV.Value->AsObject();
-		if (!PrefObject.IsValid())
-		{
-			// We cannot validate if this party is crossplay if we cannot grab preferences for the user, so return false
-			return false;
-		}
-
-		bool bWantsCrossplay = false;
-		if (!PrefObject->TryGetBoolField(CROSSPLAY_OBJECT_PLAYER_CROSSPLAY_FIELD, bWantsCrossplay))
-		{
-			// We cannot validate if this user wanted crossplay, so just return false for no crossplay
-			return false;
-		}
-
-		// Finally, if this user explicitly doesn't want crossplay, then the whole party cannot play crossplay
-		if (!bWantsCrossplay)
-		{
-			return false;
-		}
+		return false;
 	}
 
-	// We have gotten through each member and they all want crossplay, so return true
+	OutCrossplayInfo = *FoundInfo;
 	return true;
 }
 
-TArray<FString> FOnlinePartyAccelByte::GetUniquePlatformsForParty()
+void FOnlinePartyAccelByte::RefreshCrossplayCache()
 {
-	TArray<FString> OutPlatforms;
+	MemberCrossplayInfoMap.Empty();
+	UniquePlatforms.Empty();
+	bIsCrossplayParty = false;
+
 	FVariantData OutVariantData;
 	if (!PartyData->GetAttribute(CROSSPLAY_OBJECT_NAME, OutVariantData))
 	{
-		return OutPlatforms;
+		// Cannot confirm that this party is crossplay, so leave the cache empty
+		return;
 	}
 
 	TSharedPtr<FJsonObject> CrossplayObject;
 	OutVariantData.GetValue(CrossplayObject);
 	if (!CrossplayObject.IsValid())
 	{
-		return OutPlatforms;
+		return;
 	}
 
+	// Iterate through each value in the crossplay object to get the object associated with the user, and then parse
+	// their platform and crossplay preference. If any entry is malformed, we cannot validate that this party is crossplay.
+	bool bAllMembersWantCrossplay = true;
 	for (const TPair<FString, TSharedPtr<FJsonValue>>& KV : CrossplayObject->Values)
 	{
-		TSharedPtr<FJsonObject> PrefObject = KV.Value->AsObject();
-		if (!PrefObject.IsValid())
+		const TSharedPtr<FJsonObject>* PrefObject = nullptr;
+		if (!KV.Value.IsValid() || !KV.Value->TryGetObject(PrefObject) || PrefObject == nullptr || !PrefObject->IsValid())
 		{
-			return OutPlatforms;
+			bAllMembersWantCrossplay = false;
+			break;
 		}
 
-		FString Platform;
-		if (!PrefObject->TryGetStringField(CROSSPLAY_OBJECT_PLAYER_PLATFORM_FIELD, Platform))
+		FAccelBytePartyMemberCrossplayInfo CrossplayInfo;
+		if (!(*PrefObject)->TryGetStringField(CROSSPLAY_OBJECT_PLAYER_PLATFORM_FIELD, CrossplayInfo.Platform)
+			|| !(*PrefObject)->TryGetBoolField(CROSSPLAY_OBJECT_PLAYER_CROSSPLAY_FIELD, CrossplayInfo.bCrossplayEnabled))
 		{
-			return OutPlatforms;
+			bAllMembersWantCrossplay = false;
+			break;
 		}
 
-		OutPlatforms.AddUnique(Platform);
+		UniquePlatforms.AddUnique(CrossplayInfo.Platform);
+		bAllMembersWantCrossplay &= CrossplayInfo.bCrossplayEnabled;
+		MemberCrossplayInfoMap.Add(KV.Key, MoveTemp(CrossplayInfo));
 	}
 
-	return OutPlatforms;
+	bIsCrossplayParty = bAllMembersWantCrossplay;
 }
 
 FOnlinePartyMemberAccelByte::FOnlinePartyMemberAccelByte(const TSharedRef<const FUniqueNetIdAccelByteUser>& InUserId, const FString& InDisplayName)
@@ -734,6 +856,23 @@ TSharedPtr<FOnlinePartyAccelByte> FOnlinePartySystemAccelByte::GetFirstPartyForU
 	return nullptr;
 }
 
+void FOnlinePartySystemAccelByte::FlushPartyDataUpdatesNextTick(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<FOnlinePartyAccelByte>& InParty)
+{
+	// Hold a weak reference so that a party that is left before the next tick does not send a stale update
+	AccelByteSubsystem->ExecuteNextTick([UserId, WeakParty = TWeakPtr<FOnlinePartyAccelByte>(InParty)]() {
+		TSharedPtr<FOnlinePartyAccelByte> Party = WeakParty.Pin();
+		if (Party.IsValid())
+		{
+			Party->FlushPendingPartyDataUpdates(UserId);
+		}
+	});
+}
+
+void FOnlinePartySystemAccelByte::UpdatePartyDataAttributes(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FOnlinePartyIdAccelByte>& PartyId, const FOnlineKeyValuePairs<FString, FVariantData>& ChangedAttributes, const TArray<FString>& RemovedAttributes)
+{
+	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteUpdateV1PartyData>(AccelByteSubsystem, UserId.Get(), PartyId.Get(), NAME_Game, ChangedAttributes, RemovedAttributes);
+}
+
 TSharedPtr<const FOnlinePartyId> FOnlinePartySystemAccelByte::GetFirstPartyIdForUser(const FUniqueNetId& UserId) {
 	TSharedRef<const FUniqueNetIdAccelByteUser> AccelbyteId = FUniqueNetIdAccelByteUser::CastChecked(UserId);
 	TSharedPtr<FOnlinePartyAccelByte> Party = GetFirstPartyForUser(AccelbyteId);
@@ -815,11 +954,23 @@ void FOnlinePartySystemAccelByte::OnPartyJoinNotification(const FAccelByteModels
 		}));
 	}
 
+	// Warm public records of the player that just joined, so that UI reading them finds them in cache
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = AccelByteSubsystem->GetCloudSaveInterface();
+	if (CloudSaveInterface.IsValid())
+	{
+		CloudSaveInterface->PrefetchPublicUserRecords(UserId.Get(), TArray<FString>{ Notification.UserId });
+	}
+
 	// Remove party invitation from the joined party member.
 	FPartyInviteArray& InvitesArray = UserIdToPartyInvitesMap.FindOrAdd(UserId);
-	InvitesArray.RemoveAll([Notification](const TSharedRef<const FAccelBytePartyInvite>& ExistingInvite)
+	InvitesArray.RemoveAll([this, &UserId, &Notification](const TSharedRef<const FAccelBytePartyInvite>& ExistingInvite)
 	{
-		return Notification.UserId == ExistingInvite->InviterId->GetAccelByteId();
+		if (Notification.UserId != ExistingInvite->InviterId->GetAccelByteId())
+		{
+			return false;
+		}
+		RemoveInviteFromIndex(UserId, ExistingInvite);
+		return true;
 	});
 	TriggerOnPartyInvitesChangedDelegates(UserId.Get());
 
@@ -898,16 +1049,10 @@ void FOnlinePartySystemAccelByte::OnPartyMemberConnectNotification(const FAccelB
 	TSharedPtr<FOnlinePartyAccelByte> Party = GetPartyForUser(UserId, MakeShared<const FOnlinePartyIdAccelByte>(Notification.PartyId));
 	if (Party.IsValid())
 	{
-		for(TPair<TSharedRef<const FUniqueNetIdAccelByteUser>, TSharedRef<FOnlinePartyMemberAccelByte>>& UserIdToPartyPair : Party->UserIdToPartyMemberMap)
+		TSharedPtr<FOnlinePartyMemberAccelByte> Member = Party->GetMemberByAccelByteId(Notification.UserId);
+		if (Member.IsValid() && Member->MemberConnectionStatus != EMemberConnectionStatus::Connected)
 		{
-			if(UserIdToPartyPair.Key->GetAccelByteId().Equals(Notification.UserId))
-			{
-				if(UserIdToPartyPair.Value->MemberConnectionStatus != EMemberConnectionStatus::Connected)
-				{
-					UserIdToPartyPair.Value->SetMemberConnectionStatus(EMemberConnectionStatus::Connected);
-				}
-				break;
-			}
+			Member->SetMemberConnectionStatus(EMemberConnectionStatus::Connected);
 		}
 	}
 }
@@ -917,16 +1062,10 @@ void FOnlinePartySystemAccelByte::OnPartyMemberDisconnectNotification(const FAcc
 	TSharedPtr<FOnlinePartyAccelByte> Party = GetPartyForUser(UserId, MakeShared<const FOnlinePartyIdAccelByte>(Notification.PartyId));
 	if (Party.IsValid())
 	{
-		for(TPair<TSharedRef<const FUniqueNetIdAccelByteUser>, TSharedRef<FOnlinePartyMemberAccelByte>>& UserIdToPartyPair : Party->UserIdToPartyMemberMap)
+		TSharedPtr<FOnlinePartyMemberAccelByte> Member = Party->GetMemberByAccelByteId(Notification.UserId);
+		if (Member.IsValid() && Member->MemberConnectionStatus != EMemberConnectionStatus::Disconnected)
 		{
-			if(UserIdToPartyPair.Key->GetAccelByteId().Equals(Notification.UserId))
-			{
-				if(UserIdToPartyPair.Value->MemberConnectionStatus != EMemberConnectionStatus::Disconnected)
-				{
-					UserIdToPartyPair.Value->SetMemberConnectionStatus(EMemberConnectionStatus::Disconnected);
-				}
-				break;
-			}
+			Member->SetMemberConnectionStatus(EMemberConnectionStatus::Disconnected);
 		}
 	}
 }
@@ -935,10 +1074,14 @@ void FOnlinePartySystemAccelByte::OnPartyDataChangeNotification(const FAccelByte
 {
 	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("UserId: %s; PartyId: %s"), *UserId->ToDebugString(), *Notification.PartyId);
 
-	FString NotificationString;
-	FJsonObjectConverter::UStructToJsonObjectString(Notification, NotificationString);
+	// Only serialize the notification for logging if it will actually be logged, as party storage can be large
+	if (UE_LOG_ACTIVE(LogAccelByteOSSParty, Verbose))
+	{
+		FString NotificationString;
+		FJsonObjectConverter::UStructToJsonObjectString(Notification, NotificationString);
 
-	UE_LOG(LogAccelByteOSSParty, Verbose, TEXT("Updated party information recieved! Data: %s"), *NotificationString);
+		UE_LOG(LogAccelByteOSSParty, Verbose, TEXT("Updated party information recieved! Data: %s"), *NotificationString);
+	}
 
 	// First, check if the party leader ID has changed and if so, set the current leader ID to be the new one from the notification
 	TSharedPtr<FOnlinePartyAccelByte> Party = GetPartyForUser(UserId, MakeShared<const FOnlinePartyIdAccelByte>(Notification.PartyId));
@@ -1036,6 +1179,10 @@ void FOnlinePartySystemAccelByte::OnPartyDataChangeNotification(const FAccelByte
 	// Finally, we can provide this JSON string to the FromJson method of our PartyData instance which will populate our values
 	TSharedRef<FOnlinePartyData> PartyData = MakeShared<FOnlinePartyData>();
 	PartyData->FromJson(JSONString);
+
+	// Data from the backend is already in sync with party storage, so clear the dirty flags set by FromJson so that later
+	// updates built from this data only send the keys that were actually changed
+	PartyData->ClearDirty();
 	Party->SetPartyData(PartyData);
 
 #if !(ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION < 26)
@@ -1126,28 +1273,32 @@ void FOnlinePartySystemAccelByte::RegisterRealTimeLobbyDelegates(const TSharedRe
 		return;
 	}
 
-	AccelByte::Api::Lobby::FPartyGetInvitedNotif OnReceivedPartyInviteNotifDelegate = AccelByte::Api::Lobby::FPartyGetInvitedNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnReceivedPartyInviteNotification, UserId);
+	// Route each notification through the subsystem's notification queue. Party data notifications carry the full party
+	// data, so only the latest one waiting for a party needs handling.
+	const FOnlineLobbyNotificationQueueAccelBytePtr NotificationQueue = AccelByteSubsystem->GetLobbyNotificationQueue();
+
+	AccelByte::Api::Lobby::FPartyGetInvitedNotif OnReceivedPartyInviteNotifDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyGetInvitedNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnReceivedPartyInviteNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyGetInvited"), [](const FAccelByteModelsPartyGetInvitedNotice& Notification) { return Notification.PartyId + TEXT(":") + Notification.From; }, false, UserId);
 	ApiClient->Lobby.SetPartyGetInvitedNotifDelegate(OnReceivedPartyInviteNotifDelegate);
 
-	AccelByte::Api::Lobby::FPartyInviteNotif OnPartyInviteSentNotifDelegate = AccelByte::Api::Lobby::FPartyInviteNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyInviteSentNotification, UserId);
+	AccelByte::Api::Lobby::FPartyInviteNotif OnPartyInviteSentNotifDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyInviteNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyInviteSentNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyInvite"), nullptr, false, UserId);
 	ApiClient->Lobby.SetPartyInviteNotifDelegate(OnPartyInviteSentNotifDelegate);
 
-	AccelByte::Api::Lobby::FPartyJoinNotif OnPartyJoinNotificationDelegate = AccelByte::Api::Lobby::FPartyJoinNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyJoinNotification, UserId);
+	AccelByte::Api::Lobby::FPartyJoinNotif OnPartyJoinNotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyJoinNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyJoinNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyJoin"), nullptr, false, UserId);
 	ApiClient->Lobby.SetPartyJoinNotifDelegate(OnPartyJoinNotificationDelegate);
 
-	AccelByte::Api::Lobby::FPartyMemberLeaveNotif OnPartyMemberLeaveNotificationDelegate = AccelByte::Api::Lobby::FPartyMemberLeaveNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyMemberLeaveNotification, UserId);
+	AccelByte::Api::Lobby::FPartyMemberLeaveNotif OnPartyMemberLeaveNotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyMemberLeaveNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyMemberLeaveNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyMemberLeave"), nullptr, false, UserId);
 	ApiClient->Lobby.SetPartyMemberLeaveNotifDelegate(OnPartyMemberLeaveNotificationDelegate);
 
-	AccelByte::Api::Lobby::FPartyKickNotif OnPartyKickNotificationDelegate = AccelByte::Api::Lobby::FPartyKickNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyKickNotification, UserId);
+	AccelByte::Api::Lobby::FPartyKickNotif OnPartyKickNotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyKickNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyKickNotification, EAccelByteLobbyNotificationPriority::Critical, TEXT("PartyKick"), [](const FAccelByteModelsGotKickedFromPartyNotice& Notification) { return Notification.PartyId; }, false, UserId);
 	ApiClient->Lobby.SetPartyKickNotifDelegate(OnPartyKickNotificationDelegate);
 
-	AccelByte::Api::Lobby::FPartyDataUpdateNotif OnPartyDataChangeNotificationDelegate = AccelByte::Api::Lobby::FPartyDataUpdateNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyDataChangeNotification, UserId);
+	AccelByte::Api::Lobby::FPartyDataUpdateNotif OnPartyDataChangeNotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyDataUpdateNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyDataChangeNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyDataUpdate"), [](const FAccelByteModelsPartyDataNotif& Notification) { return Notification.PartyId; }, true, UserId);
 	ApiClient->Lobby.SetPartyDataUpdateResponseDelegate(OnPartyDataChangeNotificationDelegate);
 
-	AccelByte::Api::Lobby::FPartyMemberConnectNotif OnPartyMemberConnectNotificationDelegate = AccelByte::Api::Lobby::FPartyMemberConnectNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyMemberConnectNotification, UserId);
+	AccelByte::Api::Lobby::FPartyMemberConnectNotif OnPartyMemberConnectNotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyMemberConnectNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyMemberConnectNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyMemberConnect"), nullptr, false, UserId);
 	ApiClient->Lobby.SetPartyMemberConnectNotifDelegate(OnPartyMemberConnectNotificationDelegate);
 	
-	AccelByte::Api::Lobby::FPartyMemberConnectNotif OnPartyMemberDisconnectNotificationDelegate = AccelByte::Api::Lobby::FPartyMemberDisconnectNotif::CreateThreadSafeSP(AsShared(), &FOnlinePartySystemAccelByte::OnPartyMemberDisconnectNotification, UserId);
+	AccelByte::Api::Lobby::FPartyMemberDisconnectNotif OnPartyMemberDisconnectNotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FPartyMemberDisconnectNotif>(NotificationQueue, SharedThis(this), &FOnlinePartySystemAccelByte::OnPartyMemberDisconnectNotification, EAccelByteLobbyNotificationPriority::Normal, TEXT("PartyMemberDisconnect"), nullptr, false, UserId);
 	ApiClient->Lobby.SetPartyMemberDisconnectNotifDelegate(OnPartyMemberDisconnectNotificationDelegate);
 	
 	FOnPartyJoinedDelegate PartyJoinedDelegate = FOnPartyJoinedDelegate::CreateThreadSafeSP(this, &FOnlinePartySystemAccelByte::OnPartyJoinedComplete);
@@ -1263,13 +1414,10 @@ int32 FOnlinePartySystemAccelByte::GetCurrentPartyMemberCount(const FUniqueNetId
 
 TSharedPtr<const FAccelBytePartyInvite> FOnlinePartySystemAccelByte::GetInviteForParty(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FOnlinePartyIdAccelByte>& PartyId)
 {
-	FPartyInviteArray* FoundInvitesArray = UserIdToPartyInvitesMap.Find(UserId);
-	if (FoundInvitesArray != nullptr)
+	const FAccelBytePartyInviteIndex* FoundInviteIndex = UserIdToPartyInviteIndexMap.Find(UserId);
+	if (FoundInviteIndex != nullptr)
 	{
-		TSharedRef<const FAccelBytePartyInvite>* FoundInvite = FoundInvitesArray->FindByPredicate([&PartyId](const TSharedRef<const FAccelBytePartyInvite>& Invite) {
-			return Invite->PartyId.Get() == PartyId.Get();
-		});
-
+		const TSharedRef<const FAccelBytePartyInvite>* FoundInvite = FoundInviteIndex->ByPartyId.Find(PartyId->ToString());
 		if (FoundInvite != nullptr)
 		{
 			return *FoundInvite;
@@ -1280,13 +1428,10 @@ TSharedPtr<const FAccelBytePartyInvite> FOnlinePartySystemAccelByte::GetInviteFo
 
 TSharedPtr<const FAccelBytePartyInvite> FOnlinePartySystemAccelByte::GetInviteForParty(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FUniqueNetIdAccelByteUser>& InviterId)
 {
-	FPartyInviteArray* FoundInvitesArray = UserIdToPartyInvitesMap.Find(UserId);
-	if (FoundInvitesArray != nullptr)
+	const FAccelBytePartyInviteIndex* FoundInviteIndex = UserIdToPartyInviteIndexMap.Find(UserId);
+	if (FoundInviteIndex != nullptr)
 	{
-		TSharedRef<const FAccelBytePartyInvite>* FoundInvite = FoundInvitesArray->FindByPredicate([&InviterId](const TSharedRef<const FAccelBytePartyInvite>& Invite) {
-			return Invite->InviterId.Get() == InviterId.Get();
-		});
-
+		const TSharedRef<const FAccelBytePartyInvite>* FoundInvite = FoundInviteIndex->ByInviterId.Find(InviterId->GetAccelByteId());
 		if (FoundInvite != nullptr)
 		{
 			return *FoundInvite;
@@ -1295,16 +1440,58 @@ TSharedPtr<const FAccelBytePartyInvite> FOnlinePartySystemAccelByte::GetInviteFo
 	return nullptr;
 }
 
+void FOnlinePartySystemAccelByte::AddInviteToIndex(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FAccelBytePartyInvite>& Invite)
+{
+	FAccelBytePartyInviteIndex& InviteIndex = UserIdToPartyInviteIndexMap.FindOrAdd(UserId);
+	InviteIndex.ByPartyId.Add(Invite->PartyId->ToString(), Invite);
+	InviteIndex.ByInviterId.Add(Invite->InviterId->GetAccelByteId(), Invite);
+}
+
+void FOnlinePartySystemAccelByte::RemoveInviteFromIndex(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FAccelBytePartyInvite>& Invite)
+{
+	FAccelBytePartyInviteIndex* FoundInviteIndex = UserIdToPartyInviteIndexMap.Find(UserId);
+	if (FoundInviteIndex == nullptr)
+	{
+		return;
+	}
+
+	// Only drop entries that still point at this invite, a newer invite may have replaced one of its keys
+	const FString PartyIdString = Invite->PartyId->ToString();
+	const TSharedRef<const FAccelBytePartyInvite>* FoundByPartyId = FoundInviteIndex->ByPartyId.Find(PartyIdString);
+	if (FoundByPartyId != nullptr && *FoundByPartyId == Invite)
+	{
+		FoundInviteIndex->ByPartyId.Remove(PartyIdString);
+	}
+
+	const FString InviterIdString = Invite->InviterId->GetAccelByteId();
+	const TSharedRef<const FAccelBytePartyInvite>* FoundByInviterId = FoundInviteIndex->ByInviterId.Find(InviterIdString);
+	if (FoundByInviterId != nullptr && *FoundByInviterId == Invite)
+	{
+		FoundInviteIndex->ByInviterId.Remove(InviterIdString);
+	}
+
+	if (FoundInviteIndex->ByPartyId.Num() <= 0 && FoundInviteIndex->ByInviterId.Num() <= 0)
+	{
+		UserIdToPartyInviteIndexMap.Remove(UserId);
+	}
+}
+
 void FOnlinePartySystemAccelByte::AddPartyInvite(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<FAccelBytePartyInvite>& Invite)
 {
 	FPartyInviteArray& InvitesArray = UserIdToPartyInvitesMap.FindOrAdd(UserId);
 	// Remove existing invite with same party Id, so it won't duplicates
-	InvitesArray.RemoveAll([Invite](const TSharedRef<const FAccelBytePartyInvite>& ExistingInvite)
+	InvitesArray.RemoveAll([this, &UserId, &Invite](const TSharedRef<const FAccelBytePartyInvite>& ExistingInvite)
 	{
-		return Invite->PartyId->ToString() == ExistingInvite->PartyId->ToString()
-			|| Invite->InviterId->ToString() == ExistingInvite->InviterId->ToString();
+		if (Invite->PartyId->ToString() != ExistingInvite->PartyId->ToString()
+			&& Invite->InviterId->ToString() != ExistingInvite->InviterId->ToString())
+		{
+			return false;
+		}
+		RemoveInviteFromIndex(UserId, ExistingInvite);
+		return true;
 	});
 	InvitesArray.Add(Invite);
+	AddInviteToIndex(UserId, Invite);
 #if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
 	TriggerOnPartyInviteReceivedDelegates(UserId.Get(), Invite->PartyId.Get(), Invite->InviterId.Get());
 #endif
@@ -1328,6 +1515,7 @@ bool FOnlinePartySystemAccelByte::RemoveInviteForParty(const TSharedRef<const FU
 			const TSharedRef<const FUniqueNetIdAccelByteUser> SenderId = (*FoundInvitesArray)[FoundInviteIndex]->InviterId;
 			const FString SenderDisplayName = (*FoundInvitesArray)[FoundInviteIndex]->InviterDisplayName;
 			
+			RemoveInviteFromIndex(UserId, (*FoundInvitesArray)[FoundInviteIndex]);
 			FoundInvitesArray->RemoveAt(FoundInviteIndex);
 #if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
 			TriggerOnPartyInviteRemovedDelegates(UserId.Get(), PartyId.Get(), SenderId.Get(), InvitationRemovalReason);
@@ -1359,6 +1547,7 @@ bool FOnlinePartySystemAccelByte::RemoveInviteForParty(const TSharedRef<const FU
 #if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
 			TriggerOnPartyInviteRemovedDelegates(UserId.Get(), Invite->PartyId.Get(), Invite->InviterId.Get(), InvitationRemovalReason);
 #endif
+			RemoveInviteFromIndex(UserId, Invite);
 			FoundInvitesArray->RemoveAt(FoundInviteIndex);
 			return true;
 		}
@@ -1376,12 +1565,21 @@ bool FOnlinePartySystemAccelByte::ClearInviteForParty(const TSharedRef<const FUn
 		// With this in mind, we will iterate through all invites, check if the party ID matches, and if so, remove it.
 		if (PartyId.IsValid())
 		{
-			FoundInvites->RemoveAll([&PartyId](const TSharedRef<const FAccelBytePartyInvite>& Invite) { return Invite->PartyId == PartyId; });
+			FoundInvites->RemoveAll([this, &UserId, &PartyId](const TSharedRef<const FAccelBytePartyInvite>& Invite)
+			{
+				if (Invite->PartyId != PartyId)
+				{
+					return false;
+				}
+				RemoveInviteFromIndex(UserId, Invite);
+				return true;
+			});
 		}
 		// Otherwise, just remove all invites we have cached
 		else
 		{
 			FoundInvites->Empty();
+			UserIdToPartyInviteIndexMap.Remove(UserId);
 		}
 		return true;
 	}
@@ -1805,6 +2003,26 @@ bool FOnlinePartySystemAccelByte::UpdatePartyData(const FUniqueNetId& LocalUserI
 		return false;
 	}
 
+	// Route changes for a party that we have locally through the same per-frame batching as internal attribute changes,
+	// so that several calls in one frame are sent as a single write containing only the dirty keys
+	const TSharedRef<const FUniqueNetIdAccelByteUser> LocalUserIdAccelByte = FUniqueNetIdAccelByteUser::CastChecked(LocalUserId);
+	TSharedPtr<FOnlinePartyAccelByte> Party = GetPartyForUser(LocalUserIdAccelByte, StaticCastSharedRef<const FOnlinePartyIdAccelByte>(PartyId.AsShared()));
+	if (Party.IsValid())
+	{
+		FOnlineKeyValuePairs<FString, FVariantData> ChangedAttributes;
+		TArray<FString> RemovedAttributes;
+		PartyData.GetDirtyKeyValAttrs(ChangedAttributes, RemovedAttributes);
+		for (const TPair<FString, FVariantData>& Attribute : ChangedAttributes)
+		{
+			Party->SetPartyDataAttribute(LocalUserIdAccelByte, Attribute.Key, Attribute.Value);
+		}
+		for (const FString& AttrName : RemovedAttributes)
+		{
+			Party->RemovePartyDataAttribute(LocalUserIdAccelByte, AttrName);
+		}
+		return true;
+	}
+
 #if (ENGINE_MAJOR_VERSION == 4 && ENGINE_MINOR_VERSION <= 25)
 	FName Namespace{};
 #endif
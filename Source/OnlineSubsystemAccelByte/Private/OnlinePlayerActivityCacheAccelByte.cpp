@@ -0,0 +1,125 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlinePlayerActivityCacheAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "Misc/ConfigCacheIni.h"
+
+FOnlinePlayerActivityCacheAccelByte::FOnlinePlayerActivityCacheAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("PlayerActivityIdleTimeoutSeconds"), IdleTimeoutSeconds, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("PlayerActivityDisconnectedTimeoutSeconds"), DisconnectedTimeoutSeconds, GEngineIni);
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("PlayerActivityPurgeIntervalSeconds"), PurgeIntervalSeconds, GEngineIni);
+}
+
+void FOnlinePlayerActivityCacheAccelByte::SetPlatform(const FString& AccelByteId, const FString& Platform)
+{
+	FScopeLock ScopeLock(&CacheLock);
+	FindOrAddEntry(AccelByteId).Platform = Platform;
+}
+
+void FOnlinePlayerActivityCacheAccelByte::SetJoinTime(const FString& AccelByteId, const FDateTime& JoinTime)
+{
+	FScopeLock ScopeLock(&CacheLock);
+	FAccelBytePlayerActivity& Entry = FindOrAddEntry(AccelByteId);
+	Entry.JoinTime = JoinTime;
+	Entry.bIsUnregistered = false;
+}
+
+void FOnlinePlayerActivityCacheAccelByte::SetDisconnectedTime(const FString& AccelByteId, const FDateTime& DisconnectedTime)
+{
+	FScopeLock ScopeLock(&CacheLock);
+	FAccelBytePlayerActivity& Entry = FindOrAddEntry(AccelByteId);
+	Entry.DisconnectedTime = DisconnectedTime;
+	Entry.bIsUnregistered = true;
+}
+
+bool FOnlinePlayerActivityCacheAccelByte::GetPlayerActivity(const FString& AccelByteId, FAccelBytePlayerActivity& OutActivity) const
+{
+	FScopeLock ScopeLock(&CacheLock);
+	const FAccelBytePlayerActivity* FoundEntry = AccelByteIdToActivityMap.Find(AccelByteId);
+	if (FoundEntry == nullptr)
+	{
+		return false;
+	}
+
+	OutActivity = *FoundEntry;
+	return true;
+}
+
+void FOnlinePlayerActivityCacheAccelByte::RemovePlayer(const FString& AccelByteId)
+{
+	FScopeLock ScopeLock(&CacheLock);
+	AccelByteIdToActivityMap.Remove(AccelByteId);
+}
+
+int32 FOnlinePlayerActivityCacheAccelByte::Num() const
+{
+	FScopeLock ScopeLock(&CacheLock);
+	return AccelByteIdToActivityMap.Num();
+}
+
+SIZE_T FOnlinePlayerActivityCacheAccelByte::GetAllocatedSize() const
+{
+	FScopeLock ScopeLock(&CacheLock);
+	return AccelByteIdToActivityMap.GetAllocatedSize();
+}
+
+int32 FOnlinePlayerActivityCacheAccelByte::Purge(double CurrentTimeInSeconds)
+{
+	FScopeLock ScopeLock(&CacheLock);
+
+	int32 ItemsPurged = 0;
+	for (TMap<FString, FAccelBytePlayerActivity>::TIterator It = AccelByteIdToActivityMap.CreateIterator(); It; ++It)
+	{
+		const FAccelBytePlayerActivity& Entry = It.Value();
+		const double TimeoutSeconds = Entry.bIsUnregistered ? DisconnectedTimeoutSeconds : IdleTimeoutSeconds;
+		if (CurrentTimeInSeconds - Entry.LastUpdatedTimeInSeconds >= TimeoutSeconds)
+		{
+			It.RemoveCurrent();
+			ItemsPurged++;
+		}
+	}
+
+	// Removing from a TMap leaves holes in its sparse storage, so give the slack back once a purge has actually removed
+	// something. Otherwise a burst of players would keep the high water mark allocated for the lifetime of the server.
+	if (ItemsPurged > 0)
+	{
+		AccelByteIdToActivityMap.Compact();
+		AccelByteIdToActivityMap.Shrink();
+	}
+
+	return ItemsPurged;
+}
+
+void FOnlinePlayerActivityCacheAccelByte::Tick(float DeltaTime)
+{
+	TimeSinceLastPurgeSeconds += DeltaTime;
+	if (TimeSinceLastPurgeSeconds < PurgeIntervalSeconds)
+	{
+		return;
+	}
+
+	TimeSinceLastPurgeSeconds = 0.0f;
+	const int32 ItemsPurged = Purge(FPlatformTime::Seconds());
+	if (ItemsPurged > 0)
+	{
+		UE_LOG_AB(VeryVerbose, TEXT("Purged %d expired entries from the player activity cache"), ItemsPurged);
+	}
+}
+
+void FOnlinePlayerActivityCacheAccelByte::SetTimeouts(double InIdleTimeoutSeconds, double InDisconnectedTimeoutSeconds)
+{
+	FScopeLock ScopeLock(&CacheLock);
+	IdleTimeoutSeconds = InIdleTimeoutSeconds;
+	DisconnectedTimeoutSeconds = InDisconnectedTimeoutSeconds;
+}
+
+FAccelBytePlayerActivity& FOnlinePlayerActivityCacheAccelByte::FindOrAddEntry(const FString& AccelByteId)
+{
+	FAccelBytePlayerActivity& Entry = AccelByteIdToActivityMap.FindOrAdd(AccelByteId);
+	Entry.LastUpdatedTimeInSeconds = FPlatformTime::Seconds();
+	return Entry;
+}
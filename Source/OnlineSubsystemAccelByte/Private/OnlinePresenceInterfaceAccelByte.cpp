@@ -5,15 +5,18 @@
 #include "OnlinePresenceInterfaceAccelByte.h"
 #include "OnlineIdentityInterfaceAccelByte.h"
 #include "OnlineSubsystemAccelByte.h"
+#include "OnlineLobbyNotificationQueueAccelByte.h"
 #include "Online.h"
 #include "Core/AccelByteMultiRegistry.h"
 #include "AsyncTasks/User/OnlineAsyncTaskAccelByteQueryUserPresence.h"
 #include "AsyncTasks/User/OnlineAsyncTaskAccelByteSetUserPresence.h"
 #include "OnlineSubsystemUtils.h"
+#include "Misc/ConfigCacheIni.h"
 
 FOnlinePresenceAccelByte::FOnlinePresenceAccelByte(FOnlineSubsystemAccelByte* InSubsystem) 
 	: AccelByteSubsystem(InSubsystem)
 {
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("MaxCachedPresenceEntries"), MaxCachedPresenceEntries, GEngineIni);
 }
 
 bool FOnlinePresenceAccelByte::GetFromSubsystem(const IOnlineSubsystem* Subsystem, FOnlinePresenceAccelBytePtr& OutInterfaceInstance)
@@ -42,39 +45,145 @@ IOnlinePresencePtr FOnlinePresenceAccelByte::GetPlatformOnlinePresenceInterface(
 
 void FOnlinePresenceAccelByte::OnFriendStatusChangedNotificationReceived(const FAccelByteModelsUsersPresenceNotice& Notification, int32 LocalUserNum)
 {
-	// First, we want to get our own net ID, as delegates will require it
-	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
-	if (!IdentityInterface.IsValid())
+	// Presence notifications tend to arrive in bursts, such as when many friends log in at once. Rather than updating the
+	// cache and firing delegates for each one, just keep the latest notification for each user and apply them all in
+	// one batch on the next tick.
+	FScopeLock ScopeLock(&PendingNotificationsLock);
+	PendingNotifications.FindOrAdd(LocalUserNum).Add(Notification.UserID, Notification);
+}
+
+void FOnlinePresenceAccelByte::Tick(float DeltaTime)
+{
+	TMap<int32, TMap<FString, FAccelByteModelsUsersPresenceNotice>> NotificationsToApply;
 	{
-		UE_LOG_AB(Warning, TEXT("Received a notification for a friend status changed, but cannot act on it as the identity interface is not valid!"));
-		return;
+		FScopeLock ScopeLock(&PendingNotificationsLock);
+		if (PendingNotifications.Num() <= 0)
+		{
+			return;
+		}
+
+		NotificationsToApply = MoveTemp(PendingNotifications);
+		PendingNotifications.Reset();
+	}
+
+	for (const TPair<int32, TMap<FString, FAccelByteModelsUsersPresenceNotice>>& LocalUserNotifications : NotificationsToApply)
+	{
+		TArray<TSharedRef<const FUniqueNetIdAccelByteUser>> UpdatedUserIds;
+		TArray<TSharedRef<FOnlineUserPresenceAccelByte>> UpdatedPresences;
+		UpdatedUserIds.Reserve(LocalUserNotifications.Value.Num());
+		UpdatedPresences.Reserve(LocalUserNotifications.Value.Num());
+
+		{
+			FScopeLock ScopeLock(&CacheLock);
+			for (const TPair<FString, FAccelByteModelsUsersPresenceNotice>& Notification : LocalUserNotifications.Value)
+			{
+				// Only create a composite ID the first time we see a user, afterwards reuse the one stored with their presence
+				FCachedPresenceEntry* Entry = CachedPresenceByUserId.Find(Notification.Key);
+				if (Entry == nullptr)
+				{
+					FAccelByteUniqueIdComposite FriendCompositeId;
+					FriendCompositeId.Id = Notification.Key;
+					Entry = &TouchCachedPresence(Notification.Key, FUniqueNetIdAccelByteUser::Create(FriendCompositeId));
+				}
+				else
+				{
+					Entry = &TouchCachedPresence(Notification.Key, Entry->UserId);
+				}
+
+				FOnlineUserPresenceStatusAccelByte PresenceStatus;
+				PresenceStatus.StatusStr = Notification.Value.Activity;
+				PresenceStatus.SetPresenceStatus(Notification.Value.Availability);
+
+				Entry->Presence->Status = PresenceStatus;
+				Entry->Presence->bIsOnline = Notification.Value.Availability == EAvailability::Online ? true : false;
+				Entry->Presence->bIsPlayingThisGame = Notification.Value.Availability == EAvailability::Online ? true : false;
+
+				UpdatedUserIds.Add(Entry->UserId);
+				UpdatedPresences.Add(Entry->Presence);
+			}
+
+			TrimCache();
+		}
+
+		// Fire delegates outside of the cache lock, as handlers are free to read the cache back
+		for (int32 Index = 0; Index < UpdatedUserIds.Num(); Index++)
+		{
+			TriggerOnPresenceReceivedDelegates(UpdatedUserIds[Index].Get(), UpdatedPresences[Index]);
+		}
+		TriggerOnPresenceBatchReceivedDelegates(LocalUserNotifications.Key, UpdatedUserIds);
+	}
+}
+
+FOnlinePresenceAccelByte::FCachedPresenceEntry& FOnlinePresenceAccelByte::TouchCachedPresence(const FString& AccelByteId, const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId)
+{
+	FCachedPresenceEntry* Entry = CachedPresenceByUserId.Find(AccelByteId);
+	if (Entry == nullptr)
+	{
+		Entry = &CachedPresenceByUserId.Add(AccelByteId, FCachedPresenceEntry(UserId));
 	}
 
-	TSharedPtr<const FUniqueNetId> UserId = IdentityInterface->GetUniquePlayerId(LocalUserNum);
-	if (!UserId.IsValid())
+	// Move this entry to the tail of the LRU list, reusing its node so that an update never allocates
+	if (Entry->LRUNode == nullptr)
+	{
+		Entry->LRUNode = new TDoubleLinkedList<FString>::TDoubleLinkedListNode(AccelByteId);
+	}
+	else
+	{
+		CachedPresenceLRU.RemoveNode(Entry->LRUNode, false);
+	}
+	CachedPresenceLRU.AddTail(Entry->LRUNode);
+
+	Entry->LastUpdatedTimeInSeconds = FPlatformTime::Seconds();
+	return *Entry;
+}
+
+void FOnlinePresenceAccelByte::TrimCache()
+{
+	const int32 ExcessEntries = CachedPresenceByUserId.Num() - MaxCachedPresenceEntries;
+	if (MaxCachedPresenceEntries <= 0 || ExcessEntries <= 0)
 	{
-		UE_LOG_AB(Warning, TEXT("Received a notification for a friend status changed, but cannot act on it as the current user's ID is not valid!"));
 		return;
 	}
 
-	// Next, we assume that we don't have this user in our friends list already as they just sent us an invite, so just
-	// create an async task to get data about that friend and then add them to the list afterwards, and fire off the delegates
-	FAccelByteUniqueIdComposite FriendCompositeId;
-	FriendCompositeId.Id = Notification.UserID;
-	TSharedRef<const FUniqueNetIdAccelByteUser> FriendId = FUniqueNetIdAccelByteUser::Create(FriendCompositeId);
+	// The head of the LRU list is always the least recently updated entry, so eviction only costs the excess
+	for (int32 Index = 0; Index < ExcessEntries; Index++)
+	{
+		TDoubleLinkedList<FString>::TDoubleLinkedListNode* OldestNode = CachedPresenceLRU.GetHead();
+		if (OldestNode == nullptr)
+		{
+			break;
+		}
 
-	TSharedPtr<FOnlineUserPresenceAccelByte> FriendPresence = FindOrCreatePresence(FriendId);
-	
-	FOnlineUserPresenceStatusAccelByte PresenceStatus;
+		CachedPresenceByUserId.Remove(OldestNode->GetValue());
+		CachedPresenceLRU.RemoveNode(OldestNode);
+	}
 
-	PresenceStatus.StatusStr = Notification.Activity;
-	PresenceStatus.SetPresenceStatus(Notification.Availability);
+	UE_LOG_AB(VeryVerbose, TEXT("Evicted %d least recently updated entries from the presence cache"), ExcessEntries);
+}
 
-	FriendPresence->Status = PresenceStatus;
-	FriendPresence->bIsOnline = Notification.Availability == EAvailability::Online ? true : false;
-	FriendPresence->bIsPlayingThisGame = Notification.Availability == EAvailability::Online ? true : false;
+void FOnlinePresenceAccelByte::RemoveCachedPresence(const FString& AccelByteId)
+{
+	{
+		FScopeLock ScopeLock(&CacheLock);
+		const FCachedPresenceEntry* Entry = CachedPresenceByUserId.Find(AccelByteId);
+		if (Entry != nullptr)
+		{
+			CachedPresenceLRU.RemoveNode(Entry->LRUNode);
+			CachedPresenceByUserId.Remove(AccelByteId);
+		}
+	}
 
-	TriggerOnPresenceReceivedDelegates(FriendId.Get(), FriendPresence.ToSharedRef());
+	FScopeLock ScopeLock(&PendingNotificationsLock);
+	for (TPair<int32, TMap<FString, FAccelByteModelsUsersPresenceNotice>>& LocalUserNotifications : PendingNotifications)
+	{
+		LocalUserNotifications.Value.Remove(AccelByteId);
+	}
+}
+
+int32 FOnlinePresenceAccelByte::GetCachedPresenceNum() const
+{
+	FScopeLock ScopeLock(&CacheLock);
+	return CachedPresenceByUserId.Num();
 }
 
 void FOnlinePresenceAccelByte::SetPresence(const FUniqueNetId& User, const FOnlineUserPresenceStatus& Status, const FOnPresenceTaskCompleteDelegate& Delegate) 
@@ -109,10 +218,12 @@ void FOnlinePresenceAccelByte::QueryPresence(const FUniqueNetId& User, const FOn
 EOnlineCachedResult::Type FOnlinePresenceAccelByte::GetCachedPresence(const FUniqueNetId& User, TSharedPtr<FOnlineUserPresence>& OutPresence) 
 {
 	TSharedRef<const FUniqueNetIdAccelByteUser> CompositeId = FUniqueNetIdAccelByteUser::CastChecked(User);
-	TSharedRef<FOnlineUserPresenceAccelByte>* FoundPresence = CachedPresenceByUserId.Find(CompositeId->GetAccelByteId());
-	if (FoundPresence != nullptr)
+
+	FScopeLock ScopeLock(&CacheLock);
+	const FCachedPresenceEntry* FoundEntry = CachedPresenceByUserId.Find(CompositeId->GetAccelByteId());
+	if (FoundEntry != nullptr)
 	{
-		OutPresence = *FoundPresence;
+		OutPresence = FoundEntry->Presence;
 		return EOnlineCachedResult::Success;
 	}
 
@@ -171,19 +282,17 @@ void FOnlinePresenceAccelByte::RegisterRealTimeLobbyDelegates(int32 LocalUserNum
 		return;
 	}
 
-	// Set each delegate for the corresponding API client to be a new realtime delegate
-	AccelByte::Api::Lobby::FFriendStatusNotif OnFriendStatusChangedNotificationReceivedDelegate = AccelByte::Api::Lobby::FFriendStatusNotif::CreateThreadSafeSP(AsShared(), &FOnlinePresenceAccelByte::OnFriendStatusChangedNotificationReceived, LocalUserNum);
+	// Set each delegate for the corresponding API client to be a new realtime delegate. Presence is the least urgent
+	// notification, and only the latest status for each user matters.
+	AccelByte::Api::Lobby::FFriendStatusNotif OnFriendStatusChangedNotificationReceivedDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<AccelByte::Api::Lobby::FFriendStatusNotif>(AccelByteSubsystem->GetLobbyNotificationQueue(), SharedThis(this), &FOnlinePresenceAccelByte::OnFriendStatusChangedNotificationReceived, EAccelByteLobbyNotificationPriority::Low, TEXT("FriendStatusChanged"), [](const FAccelByteModelsUsersPresenceNotice& Notification) { return Notification.UserID; }, true, LocalUserNum);
 	ApiClient->Lobby.SetUserPresenceNotifDelegate(OnFriendStatusChangedNotificationReceivedDelegate);
 }
 
 
 TSharedRef<FOnlineUserPresenceAccelByte> FOnlinePresenceAccelByte::FindOrCreatePresence(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId) 
 {
-	TSharedRef<FOnlineUserPresenceAccelByte>* UserPresence = CachedPresenceByUserId.Find(UserId->GetAccelByteId());
-	if (UserPresence == nullptr)
-	{
-		UserPresence = &(CachedPresenceByUserId.Add(UserId->GetAccelByteId(), MakeShared<FOnlineUserPresenceAccelByte>()));
-	}
-
-	return *UserPresence;
+	FScopeLock ScopeLock(&CacheLock);
+	const TSharedRef<FOnlineUserPresenceAccelByte> Presence = TouchCachedPresence(UserId->GetAccelByteId(), UserId).Presence;
+	TrimCache();
+	return Presence;
 }
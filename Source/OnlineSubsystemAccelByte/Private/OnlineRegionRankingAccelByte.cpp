@@ -0,0 +1,197 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineRegionRankingAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "OnlineIdentityInterfaceAccelByte.h"
+#include "Core/AccelByteApiClient.h"
+#include "Misc/ConfigCacheIni.h"
+
+/**
+ * Gain used for the jitter estimate, matching the interarrival jitter calculation from RFC 3550
+ */
+#define REGION_JITTER_GAIN (1.0f / 16.0f)
+
+FOnlineRegionRankingAccelByte::FOnlineRegionRankingAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("QosLatencySmoothingFactor"), SmoothingFactor, GEngineIni);
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("QosJitterWeight"), JitterWeight, GEngineIni);
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("QosPreferredRegionHysteresis"), PreferredRegionHysteresis, GEngineIni);
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("QosRepingIntervalSeconds"), RepingIntervalSeconds, GEngineIni);
+	SmoothingFactor = FMath::Clamp(SmoothingFactor, 0.01f, 1.0f);
+	PreferredRegionHysteresis = FMath::Clamp(PreferredRegionHysteresis, 0.0f, 1.0f);
+
+	LatencySource = [this](const FOnRegionLatenciesReceived& OnLatenciesReceived) {
+		RequestLatenciesFromQos(OnLatenciesReceived);
+	};
+}
+
+bool FOnlineRegionRankingAccelByte::AddLatencySamples(const TArray<TPair<FString, float>>& Latencies)
+{
+	FScopeLock ScopeLock(&RankingLock);
+
+	if (Latencies.Num() <= 0 || Latencies == LastReceivedLatencies)
+	{
+		return false;
+	}
+	LastReceivedLatencies = Latencies;
+
+	for (const TPair<FString, float>& Latency : Latencies)
+	{
+		FAccelByteRegionLatency& RegionLatency = RegionLatencies.FindOrAdd(Latency.Key);
+		if (RegionLatency.SampleCount == 0)
+		{
+			RegionLatency.Region = Latency.Key;
+			RegionLatency.SmoothedLatencyMs = Latency.Value;
+			RegionLatency.JitterMs = 0.0f;
+		}
+		else
+		{
+			const float Deviation = FMath::Abs(Latency.Value - RegionLatency.LastSampleMs);
+			RegionLatency.JitterMs += (Deviation - RegionLatency.JitterMs) * REGION_JITTER_GAIN;
+			RegionLatency.SmoothedLatencyMs += (Latency.Value - RegionLatency.SmoothedLatencyMs) * SmoothingFactor;
+		}
+
+		RegionLatency.LastSampleMs = Latency.Value;
+		RegionLatency.SampleCount++;
+		RegionLatency.Score = RegionLatency.SmoothedLatencyMs + (RegionLatency.JitterMs * JitterWeight);
+	}
+
+	RebuildRanking();
+	return true;
+}
+
+TArray<FString> FOnlineRegionRankingAccelByte::GetRankedRegions() const
+{
+	FScopeLock ScopeLock(&RankingLock);
+	return RankedRegions;
+}
+
+FString FOnlineRegionRankingAccelByte::GetPreferredRegion() const
+{
+	FScopeLock ScopeLock(&RankingLock);
+	return (RankedRegions.Num() > 0) ? RankedRegions[0] : FString();
+}
+
+bool FOnlineRegionRankingAccelByte::GetRegionLatency(const FString& Region, FAccelByteRegionLatency& OutRegionLatency) const
+{
+	FScopeLock ScopeLock(&RankingLock);
+	const FAccelByteRegionLatency* FoundRegionLatency = RegionLatencies.Find(Region);
+	if (FoundRegionLatency == nullptr)
+	{
+		return false;
+	}
+
+	OutRegionLatency = *FoundRegionLatency;
+	return true;
+}
+
+void FOnlineRegionRankingAccelByte::RequestLatencies()
+{
+	if (bIsRequestInFlight || !LatencySource)
+	{
+		return;
+	}
+
+	bIsRequestInFlight = true;
+	LatencySource(FOnRegionLatenciesReceived::CreateThreadSafeSP(AsShared(), &FOnlineRegionRankingAccelByte::OnLatenciesReceived));
+}
+
+void FOnlineRegionRankingAccelByte::SetLatencySource(const FRegionLatencySource& InLatencySource)
+{
+	LatencySource = InLatencySource;
+	bIsRequestInFlight = false;
+}
+
+void FOnlineRegionRankingAccelByte::Tick(float DeltaTime)
+{
+	if (RepingIntervalSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	TimeSinceLastRepingSeconds += DeltaTime;
+	if (TimeSinceLastRepingSeconds < RepingIntervalSeconds)
+	{
+		return;
+	}
+
+	TimeSinceLastRepingSeconds = 0.0f;
+	RequestLatencies();
+}
+
+void FOnlineRegionRankingAccelByte::SetRepingIntervalSeconds(float InRepingIntervalSeconds)
+{
+	RepingIntervalSeconds = InRepingIntervalSeconds;
+	TimeSinceLastRepingSeconds = 0.0f;
+}
+
+void FOnlineRegionRankingAccelByte::RebuildRanking()
+{
+	const FString PreviousPreferredRegion = (RankedRegions.Num() > 0) ? RankedRegions[0] : FString();
+
+	RankedRegions.Reset(RegionLatencies.Num());
+	for (const TPair<FString, FAccelByteRegionLatency>& RegionLatency : RegionLatencies)
+	{
+		RankedRegions.Emplace(RegionLatency.Key);
+	}
+
+	RankedRegions.Sort([this](const FString& LeftHandRegion, const FString& RightHandRegion) {
+		return RegionLatencies.FindChecked(LeftHandRegion).Score < RegionLatencies.FindChecked(RightHandRegion).Score;
+	});
+
+	// Keep the previous preferred region at the front unless the new best region beats it by the hysteresis margin
+	const FAccelByteRegionLatency* PreviousPreferred = RegionLatencies.Find(PreviousPreferredRegion);
+	if (PreviousPreferred != nullptr && RankedRegions[0] != PreviousPreferredRegion)
+	{
+		const float BestScore = RegionLatencies.FindChecked(RankedRegions[0]).Score;
+		if (BestScore > PreviousPreferred->Score * (1.0f - PreferredRegionHysteresis))
+		{
+			RankedRegions.Remove(PreviousPreferredRegion);
+			RankedRegions.Insert(PreviousPreferredRegion, 0);
+		}
+	}
+}
+
+void FOnlineRegionRankingAccelByte::OnLatenciesReceived(const TArray<TPair<FString, float>>& Latencies)
+{
+	bIsRequestInFlight = false;
+	AddLatencySamples(Latencies);
+}
+
+void FOnlineRegionRankingAccelByte::RequestLatenciesFromQos(const FOnRegionLatenciesReceived& OnLatenciesReceived) const
+{
+	// Servers do not need to know their latency to other regions
+	if (IsRunningDedicatedServer())
+	{
+		OnLatenciesReceived.ExecuteIfBound(TArray<TPair<FString, float>>());
+		return;
+	}
+
+	const FOnlineIdentityAccelBytePtr IdentityInterface = StaticCastSharedPtr<FOnlineIdentityAccelByte>(Subsystem->GetIdentityInterface());
+	const int32 LocalUserNum = Subsystem->GetLocalUserNumCached();
+	if (!IdentityInterface.IsValid() || IdentityInterface->GetLoginStatus(LocalUserNum) != ELoginStatus::LoggedIn)
+	{
+		OnLatenciesReceived.ExecuteIfBound(TArray<TPair<FString, float>>());
+		return;
+	}
+
+	const AccelByte::FApiClientPtr ApiClient = IdentityInterface->GetApiClient(LocalUserNum);
+	if (!ApiClient.IsValid())
+	{
+		OnLatenciesReceived.ExecuteIfBound(TArray<TPair<FString, float>>());
+		return;
+	}
+
+	ApiClient->Qos.GetServerLatencies(THandler<TArray<TPair<FString, float>>>::CreateLambda([OnLatenciesReceived](const TArray<TPair<FString, float>>& Latencies) {
+			OnLatenciesReceived.ExecuteIfBound(Latencies);
+		}),
+		FErrorHandler::CreateLambda([OnLatenciesReceived](int32 ErrorCode, const FString& ErrorMessage) {
+			UE_LOG_AB(Verbose, TEXT("Failed to re-ping QoS regions! Error code: %d; Error message: %s"), ErrorCode, *ErrorMessage);
+			OnLatenciesReceived.ExecuteIfBound(TArray<TPair<FString, float>>());
+		}));
+}
+
+#undef REGION_JITTER_GAIN
@@ -0,0 +1,174 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#include "OnlineServerHeartbeatAccelByte.h"
+#include "OnlineSubsystemAccelByte.h"
+#include "Core/AccelByteRegistry.h"
+#include "GameServerApi/AccelByteServerWatchdogApi.h"
+#include "GameServerApi/AccelByteServerDSHubApi.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ConfigCacheIni.h"
+
+FOnlineServerHeartbeatAccelByte::FOnlineServerHeartbeatAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: Subsystem(InSubsystem)
+{
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bUseServerHeartbeatThread"), bStartWithServer, GEngineIni);
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerHeartbeatIntervalSeconds"), IntervalSeconds, GEngineIni);
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FOnlineServerHeartbeatAccelByte::~FOnlineServerHeartbeatAccelByte()
+{
+	StopHeartbeat();
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+void FOnlineServerHeartbeatAccelByte::StartHeartbeat()
+{
+	if (HeartbeatThread.IsValid())
+	{
+		return;
+	}
+
+	bIsStopRequested = false;
+	HeartbeatThread.Reset(FRunnableThread::Create(this, TEXT("AccelByteServerHeartbeatThread"), 0, TPri_AboveNormal));
+	UE_LOG_AB(Log, TEXT("Started server heartbeat thread with an interval of %.2f seconds"), GetHeartbeatInterval());
+}
+
+void FOnlineServerHeartbeatAccelByte::StopHeartbeat()
+{
+	if (!HeartbeatThread.IsValid())
+	{
+		return;
+	}
+
+	// Kill calls Stop on us, which wakes the thread, then waits for Run to return
+	HeartbeatThread->Kill(true);
+	HeartbeatThread.Reset();
+	UE_LOG_AB(Log, TEXT("Stopped server heartbeat thread"));
+}
+
+bool FOnlineServerHeartbeatAccelByte::IsHeartbeatRunning() const
+{
+	return HeartbeatThread.IsValid();
+}
+
+int64 FOnlineServerHeartbeatAccelByte::GetHeartbeatCount() const
+{
+	return HeartbeatCount.GetValue();
+}
+
+double FOnlineServerHeartbeatAccelByte::GetSecondsSinceLastHeartbeat() const
+{
+	FScopeLock ScopeLock(&HeartbeatLock);
+	if (LastHeartbeatTimeInSeconds < 0.0)
+	{
+		return -1.0;
+	}
+
+	return FPlatformTime::Seconds() - LastHeartbeatTimeInSeconds;
+}
+
+float FOnlineServerHeartbeatAccelByte::GetHeartbeatInterval() const
+{
+	FScopeLock ScopeLock(&HeartbeatLock);
+	return IntervalSeconds;
+}
+
+void FOnlineServerHeartbeatAccelByte::SetHeartbeatInterval(float InIntervalSeconds)
+{
+	{
+		FScopeLock ScopeLock(&HeartbeatLock);
+		IntervalSeconds = InIntervalSeconds;
+	}
+
+	// Wake the thread so that it picks up the new interval rather than finishing its current wait
+	WakeEvent->Trigger();
+}
+
+FCriticalSection& FOnlineServerHeartbeatAccelByte::GetServerConnectionLock()
+{
+	static FCriticalSection ServerConnectionLock;
+	return ServerConnectionLock;
+}
+
+bool FOnlineServerHeartbeatAccelByte::ShouldStartWithServer() const
+{
+	return bStartWithServer;
+}
+
+uint32 FOnlineServerHeartbeatAccelByte::Run()
+{
+	while (!bIsStopRequested)
+	{
+		const double HeartbeatStartTimeInSeconds = FPlatformTime::Seconds();
+		SendHeartbeat();
+
+		// Sleep for whatever is left of the interval, so that slow heartbeats don't push later ones back
+		const double ElapsedSeconds = FPlatformTime::Seconds() - HeartbeatStartTimeInSeconds;
+		const double WaitSeconds = FMath::Max(static_cast<double>(GetHeartbeatInterval()) - ElapsedSeconds, 0.0);
+		if (WaitSeconds > 0.0 && !bIsStopRequested)
+		{
+			WakeEvent->Wait(FTimespan::FromSeconds(WaitSeconds));
+		}
+	}
+
+	return 0;
+}
+
+void FOnlineServerHeartbeatAccelByte::Stop()
+{
+	bIsStopRequested = true;
+	WakeEvent->Trigger();
+}
+
+void FOnlineServerHeartbeatAccelByte::SendHeartbeat()
+{
+	bool bWasSent = false;
+	{
+		FScopeLock ConnectionLock(&GetServerConnectionLock());
+		if (FRegistry::ServerWatchdog.IsConnected())
+		{
+			FRegistry::ServerWatchdog.SendHeartbeat();
+			bWasSent = true;
+		}
+
+		if (FRegistry::ServerDSHub.IsConnected())
+		{
+			FRegistry::ServerDSHub.SendHeartbeat();
+			bWasSent = true;
+		}
+	}
+
+	RecordHeartbeatResult(bWasSent);
+}
+
+void FOnlineServerHeartbeatAccelByte::RecordHeartbeatResult(bool bWasSent)
+{
+	{
+		FScopeLock ScopeLock(&HeartbeatLock);
+		if (bWasSent)
+		{
+			HeartbeatCount.Increment();
+			LastHeartbeatTimeInSeconds = FPlatformTime::Seconds();
+		}
+
+		if (bWasSent == bIsHealthy)
+		{
+			return;
+		}
+		bIsHealthy = bWasSent;
+	}
+
+	// Delegates are bound by game code, so hand the change over to the game thread rather than firing it from here
+	Subsystem->ExecuteNextTick([HeartbeatWPtr = TWeakPtr<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe>(AsShared()), bWasSent]() {
+		TSharedPtr<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe> Heartbeat = HeartbeatWPtr.Pin();
+		if (Heartbeat.IsValid())
+		{
+			UE_LOG_AB(Log, TEXT("Server heartbeats are now %s"), bWasSent ? TEXT("being sent") : TEXT("failing to send"));
+			Heartbeat->TriggerOnServerHeartbeatHealthChangedDelegates(bWasSent);
+		}
+	});
+}
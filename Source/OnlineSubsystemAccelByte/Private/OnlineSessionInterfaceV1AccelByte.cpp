@@ -408,6 +408,7 @@ void FOnlineSessionV1AccelByte::RemoveNamedSession(FName SessionName)
 	{
 		if (Sessions[SearchIndex].SessionName == SessionName)
 		{
+			InvalidateLANBeaconSettings(SessionName);
 			Sessions.RemoveAtSwap(SearchIndex);
 			bHasRemovedSession = true;
 			break;
@@ -671,6 +672,9 @@ bool FOnlineSessionV1AccelByte::UpdateSession(FName SessionName, FOnlineSessionS
 	// Currently we do support updating a session through the backend, only for current player, max player and session settings
 	UE_LOG_AB(Warning, TEXT("FOnlineSessionAccelByte::UpdateSession is currently only support changing current player, max player and session settings!"));
 
+	// Settings are usually changed in place before calling update, so make sure the next LAN beacon carries them
+	InvalidateLANBeaconSettings(SessionName);
+
 	FNamedOnlineSession* Session = GetNamedSession(SessionName);
 	if (Session == nullptr)
 	{
@@ -1485,6 +1489,13 @@ uint32 FOnlineSessionV1AccelByte::FindLANSession()
 	FNboSerializeToBufferAccelByte Packet(LAN_BEACON_MAX_PACKET_SIZE);
 	LANSessionManager.CreateClientQueryPacket(Packet, LANSessionManager.LanNonce);
 	LANPingStartSeconds = FPlatformTime::Seconds();
+
+	// Size the results up front so that each response only fills in a new element rather than growing the array
+	if (SessionSearchHandle.IsValid() && SessionSearchHandle->MaxSearchResults > 0)
+	{
+		SessionSearchHandle->SearchResults.Reserve(SessionSearchHandle->MaxSearchResults);
+	}
+
 	if (!LANSessionManager.Search(Packet, ResponseDelegate, TimeoutDelegate))
 	{
 		Return = ONLINE_FAIL;
@@ -1504,19 +1515,20 @@ uint32 FOnlineSessionV1AccelByte::FinalizeLANSearch()
 	return UpdateLANStatus();
 }
 
-void FOnlineSessionV1AccelByte::AppendSessionToPacket(FNboSerializeToBufferAccelByte& Packet, FOnlineSession* Session)
+void FOnlineSessionV1AccelByte::AppendSessionToPacket(FNboSerializeToBufferAccelByte& Packet, FNamedOnlineSession* Session)
 {
-	Packet << *FUniqueNetIdAccelByteUser::CastChecked(Session->OwningUserId.ToSharedRef());
+	((FNboSerializeToBuffer&)Packet) << static_cast<uint8>(LAN_BEACON_FORMAT_VERSION);
+	Packet.WriteCompactUserId(*FUniqueNetIdAccelByteUser::CastChecked(Session->OwningUserId.ToSharedRef()));
 	((FNboSerializeToBuffer&)Packet) << Session->OwningUserName;
 	((FNboSerializeToBuffer&)Packet) << Session->NumOpenPrivateConnections;
 	((FNboSerializeToBuffer&)Packet) << Session->NumOpenPublicConnections;
 	SetPortFromNetDriver(*AccelByteSubsystem, Session->SessionInfo);
 	Packet << *StaticCastSharedPtr<FOnlineSessionInfoAccelByteV1>(Session->SessionInfo);
-	AppendSessionSettingsToPacket(Packet, &Session->SessionSettings);
+	AppendSessionSettingsToPacket(Packet, Session->SessionName, &Session->SessionSettings);
 }
 
 void FOnlineSessionV1AccelByte::AppendSessionSettingsToPacket(FNboSerializeToBufferAccelByte& Packet,
-	FOnlineSessionSettings* SessionSettings)
+	FName SessionName, FOnlineSessionSettings* SessionSettings)
 {
 	((FNboSerializeToBuffer&)Packet) << SessionSettings->NumPublicConnections
 		<< SessionSettings->NumPrivateConnections
@@ -1532,52 +1544,199 @@ void FOnlineSessionV1AccelByte::AppendSessionSettingsToPacket(FNboSerializeToBuf
 		<< static_cast<uint8>(SessionSettings->bAntiCheatProtected)
 		<< SessionSettings->BuildUniqueId;
 
-	int32 Num = 0;
+	// Settings may have been changed in place since the block was encoded, so only reuse it while the hash of the
+	// advertised settings still matches. Hashing is a single pass that skips serializing every setting again.
+	const uint32 SettingsHash = HashLANBeaconSettings(*SessionSettings);
+	FScopeLock ScopeLock(&SessionLock);
+	FLANBeaconSettingsCache* Cache = LANBeaconSettingsCache.Find(SessionName);
+	if (Cache == nullptr || Cache->SettingsHash != SettingsHash)
+	{
+		Cache = &LANBeaconSettingsCache.Add(SessionName);
+		EncodeLANBeaconSettings(*SessionSettings, *Cache);
+		Cache->SettingsHash = SettingsHash;
+	}
+
+	if (Cache->bIsEncoded)
+	{
+		Packet.WriteEncodedBytes(Cache->EncodedSettings);
+		return;
+	}
+
+	// Settings did not fit in a beacon on their own, write them out directly so that the packet reports the overflow
+	((FNboSerializeToBuffer&)Packet) << Cache->AdvertisedNum;
 	for (FSessionSettings::TConstIterator It(SessionSettings->Settings); It; ++It)
-	{	
-		const auto& Setting = It.Value();
-		if (Setting.AdvertisementType >= EOnlineDataAdvertisementType::ViaOnlineService)
+	{
+		if (It.Value().AdvertisementType >= EOnlineDataAdvertisementType::ViaOnlineService)
 		{
-			Num++;
+			((FNboSerializeToBuffer&)Packet) << It.Key();
+#if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+			((FNboSerializeToBuffer&)Packet) << It.Value();
+#else
+			((FNboSerializeToBufferOSS&)Packet) << It.Value();
+#endif
 		}
 	}
+}
 
-	((FNboSerializeToBuffer&)Packet) << Num;
-	for (FSessionSettings::TConstIterator It(SessionSettings->Settings); It; ++It)
+void FOnlineSessionV1AccelByte::InvalidateLANBeaconSettings(FName SessionName)
+{
+	FScopeLock ScopeLock(&SessionLock);
+	LANBeaconSettingsCache.Remove(SessionName);
+}
+
+uint32 FOnlineSessionV1AccelByte::HashLANBeaconSettings(const FOnlineSessionSettings& SessionSettings)
+{
+	uint32 Hash = 0;
+	for (FSessionSettings::TConstIterator It(SessionSettings.Settings); It; ++It)
+	{
+		const FOnlineSessionSetting& Setting = It.Value();
+		if (Setting.AdvertisementType < EOnlineDataAdvertisementType::ViaOnlineService)
+		{
+			continue;
+		}
+
+		uint32 ValueHash = 0;
+		switch (Setting.Data.GetType())
+		{
+		case EOnlineKeyValuePairDataType::Int32:
+		{
+			int32 Value = 0;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::UInt32:
+		{
+			uint32 Value = 0;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::Int64:
+		{
+			int64 Value = 0;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::UInt64:
+		{
+			uint64 Value = 0;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::Float:
+		{
+			float Value = 0.0f;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::Double:
+		{
+			double Value = 0.0;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::Bool:
+		{
+			bool Value = false;
+			Setting.Data.GetValue(Value);
+			ValueHash = Value ? 1 : 0;
+			break;
+		}
+		case EOnlineKeyValuePairDataType::String:
+		{
+			FString Value;
+			Setting.Data.GetValue(Value);
+			ValueHash = GetTypeHash(Value);
+			break;
+		}
+		case EOnlineKeyValuePairDataType::Blob:
+		{
+			TArray<uint8> Value;
+			Setting.Data.GetValue(Value);
+			ValueHash = FCrc::MemCrc32(Value.GetData(), Value.Num());
+			break;
+		}
+		default:
+			ValueHash = GetTypeHash(Setting.Data.ToString());
+			break;
+		}
+
+		Hash = HashCombine(Hash, GetTypeHash(It.Key()));
+		Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Setting.Data.GetType())));
+		Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Setting.AdvertisementType)));
+		Hash = HashCombine(Hash, ValueHash);
+	}
+	return Hash;
+}
+
+void FOnlineSessionV1AccelByte::EncodeLANBeaconSettings(const FOnlineSessionSettings& SessionSettings, FLANBeaconSettingsCache& OutCache)
+{
+	OutCache.AdvertisedNum = 0;
+
+	// Encode the entries in the same pass that counts them, then put the count in front once we know it
+	FNboSerializeToBufferAccelByte Entries(LAN_BEACON_MAX_PACKET_SIZE);
+	for (FSessionSettings::TConstIterator It(SessionSettings.Settings); It; ++It)
 	{
-		const auto& Setting = It.Value();
+		const FOnlineSessionSetting& Setting = It.Value();
 		if (Setting.AdvertisementType >= EOnlineDataAdvertisementType::ViaOnlineService)
 		{
-			((FNboSerializeToBuffer&)Packet) << It.Key();
+			((FNboSerializeToBuffer&)Entries) << It.Key();
 #if !(ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
-			((FNboSerializeToBuffer&)Packet) << Setting;
+			((FNboSerializeToBuffer&)Entries) << Setting;
 #else
-			((FNboSerializeToBufferOSS&)Packet) << Setting;
+			((FNboSerializeToBufferOSS&)Entries) << Setting;
 #endif
+			OutCache.AdvertisedNum++;
 		}
 	}
+
+	FNboSerializeToBufferAccelByte Block(LAN_BEACON_MAX_PACKET_SIZE);
+	((FNboSerializeToBuffer&)Block) << OutCache.AdvertisedNum;
+	if (!Entries.HasOverflow() && Entries.GetByteCount() > 0)
+	{
+		Block.WriteBinary(Entries.GetRawBuffer(0), Entries.GetByteCount());
+	}
+
+	OutCache.bIsEncoded = !Entries.HasOverflow() && !Block.HasOverflow();
+	OutCache.EncodedSettings.Reset();
+	if (OutCache.bIsEncoded)
+	{
+		OutCache.EncodedSettings.Append(Block.GetRawBuffer(0), Block.GetByteCount());
+	}
 }
 
-void FOnlineSessionV1AccelByte::ReadSessionFromPacket(FNboSerializeFromBufferAccelByte& Packet, FOnlineSession* Session)
+bool FOnlineSessionV1AccelByte::ReadSessionFromPacket(FNboSerializeFromBufferAccelByte& Packet, FOnlineSession* Session)
 {
-	TSharedRef<FUniqueNetIdAccelByteUser> UniqueId = ConstCastSharedRef<FUniqueNetIdAccelByteUser>(FUniqueNetIdAccelByteUser::Invalid());
-	Packet >> *UniqueId
-		>> Session->OwningUserName
+	uint8 FormatVersion = 0;
+	Packet >> FormatVersion;
+	if (Packet.HasOverflow() || FormatVersion != LAN_BEACON_FORMAT_VERSION)
+	{
+		UE_LOG_AB(Warning, TEXT("Ignoring LAN beacon response with format version %d, expected version %d"), FormatVersion, LAN_BEACON_FORMAT_VERSION);
+		return false;
+	}
+
+	Session->OwningUserId = Packet.ReadCompactUserId();
+	Packet >> Session->OwningUserName
 		>> Session->NumOpenPrivateConnections
 		>> Session->NumOpenPublicConnections;
 
-	Session->OwningUserId = UniqueId;
+	// Session info creates its own host address on construction, so read straight into that rather than making another
 	TSharedRef<FOnlineSessionInfoAccelByteV1> SessionInfo = MakeShared<FOnlineSessionInfoAccelByteV1>();
-	SessionInfo->SetHostAddr(ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr());
 	Packet >> *SessionInfo;
 	Session->SessionInfo = SessionInfo;
 
 	ReadSettingsFromPacket(Packet, Session->SessionSettings);
+	return true;
 }
 
 void FOnlineSessionV1AccelByte::ReadSettingsFromPacket(FNboSerializeFromBufferAccelByte& Packet, FOnlineSessionSettings& SessionSettings)
 {
-	SessionSettings.Settings.Empty();
+	SessionSettings.Settings.Reset();
 	Packet >> SessionSettings.NumPublicConnections >> SessionSettings.NumPrivateConnections;
 	uint8 Read = 0;
 	Packet >> Read;
@@ -1605,13 +1764,15 @@ void FOnlineSessionV1AccelByte::ReadSettingsFromPacket(FNboSerializeFromBufferAc
 	Packet >> Num;
 	if (!Packet.HasOverflow())
 	{
+		// Each entry takes at least a byte, so never reserve more entries than the packet could hold
+		SessionSettings.Settings.Reserve(FMath::Clamp(Num, 0, LAN_BEACON_MAX_PACKET_SIZE));
+
+		// Read each setting straight into its slot in the map rather than building it up separately and copying it in
 		FName Key;
 		for (int32 i = 0; i < Num && !Packet.HasOverflow(); i++)
 		{
-			FOnlineSessionSetting Setting;
 			Packet >> Key;
-			Packet >> Setting;
-			SessionSettings.Set(Key, Setting);
+			Packet >> SessionSettings.Settings.FindOrAdd(Key);
 		}
 	}
 	
@@ -1647,7 +1808,14 @@ void FOnlineSessionV1AccelByte::OnValidQueryPacketReceived(uint8* PacketData, in
 
 void FOnlineSessionV1AccelByte::OnValidResponsePacketReceived(uint8* PacketData, int32 PacketLength)
 {
-	FOnlineSessionSettings NewServer;
+	// The format version is the first byte of a response, so hosts running an incompatible build can be ignored before
+	// a search result is added for them
+	if (PacketLength < 1 || PacketData[0] != LAN_BEACON_FORMAT_VERSION)
+	{
+		UE_LOG_AB(Warning, TEXT("Ignoring LAN beacon response with an unsupported format version"));
+		return;
+	}
+
 	if (SessionSearchHandle.IsValid())
 	{
 		// NOTE(Maxwell, 6/17/2021): For anyone else that might stumble upon this. This line creates the new search
@@ -5,7 +5,13 @@
 #include "OnlineSessionInterfaceV2AccelByte.h"
 #include "OnlineSubsystemAccelByteSessionSettings.h"
 #include "OnlineSubsystemAccelByteInternalHelpers.h"
+#include "OnlineRegionRankingAccelByte.h"
+#include "OnlineLobbyNotificationQueueAccelByte.h"
+#include "OnlineBackfillManagerAccelByte.h"
+#include "OnlineServerHeartbeatAccelByte.h"
+#include "OnlineCloudSaveInterfaceAccelByte.h"
 #include "Interfaces/OnlineIdentityInterface.h"
+#include "Misc/ConfigCacheIni.h"
 #include "AsyncTasks/SessionV2/OnlineAsyncTaskAccelByteCreateGameSessionV2.h"
 #include "AsyncTasks/SessionV2/OnlineAsyncTaskAccelByteUpdateGameSessionV2.h"
 #include "AsyncTasks/SessionV2/OnlineAsyncTaskAccelByteJoinV2GameSession.h"
@@ -51,6 +57,7 @@
 #include "OnlineSessionSettingsAccelByte.h"
 #include "OnlineSubsystemUtils.h"
 #include "Core/AccelByteUtilities.h"
+#include "OnlineOperationTraceAccelByte.h"
 #include <algorithm>
 
 #define ONLINE_ERROR_NAMESPACE "FOnlineSessionV2AccelByte"
@@ -663,32 +670,37 @@ void FOnlineSessionV2AccelByte::RegisterSessionNotificationDelegates(const FUniq
 		return;
 	}
 
-	#define BIND_LOBBY_NOTIFICATION(NotificationDelegateName, Verb) \
+	// Route notifications through the subsystem's notification queue, tagged with the ID of the session, party or ticket
+	// they are for. Notifications carrying a full snapshot collapse into the latest one if several are waiting. Invites
+	// are also tagged with their sender, so that invites from different players to the same session are all kept.
+	const FOnlineLobbyNotificationQueueAccelBytePtr NotificationQueue = AccelByteSubsystem->GetLobbyNotificationQueue();
+
+	#define BIND_LOBBY_NOTIFICATION(NotificationDelegateName, Verb, Priority, EntityIdExpr, bCollapseSuperseded) \
 		typedef AccelByte::Api::Lobby::FV2##NotificationDelegateName##Notif F##Verb##NotificationDelegate; \
-		const F##Verb##NotificationDelegate On##Verb##NotificationDelegate = F##Verb##NotificationDelegate::CreateThreadSafeSP(SharedThis(this), &FOnlineSessionV2AccelByte::On##Verb##Notification, LocalUserNum); \
+		const F##Verb##NotificationDelegate On##Verb##NotificationDelegate = FOnlineLobbyNotificationQueueAccelByte::CreateQueuedDelegate<F##Verb##NotificationDelegate>(NotificationQueue, SharedThis(this), &FOnlineSessionV2AccelByte::On##Verb##Notification, EAccelByteLobbyNotificationPriority::Priority, TEXT(#Verb), [](const auto& Notification) { return FString(EntityIdExpr); }, bCollapseSuperseded, LocalUserNum); \
 		ApiClient->Lobby.SetV2##NotificationDelegateName##NotifDelegate(On##Verb##NotificationDelegate); \
 
 	// Begin Game Session Notifications
-	BIND_LOBBY_NOTIFICATION(GameSessionInvited, InvitedToGameSession);
-	BIND_LOBBY_NOTIFICATION(GameSessionMembersChanged, GameSessionMembersChanged);
-	BIND_LOBBY_NOTIFICATION(GameSessionUpdated, GameSessionUpdated);
-	BIND_LOBBY_NOTIFICATION(GameSessionKicked, KickedFromGameSession);
-	BIND_LOBBY_NOTIFICATION(DSStatusChanged, DsStatusChanged);
+	BIND_LOBBY_NOTIFICATION(GameSessionInvited, InvitedToGameSession, Normal, Notification.SessionID + TEXT(":") + Notification.SenderID, true);
+	BIND_LOBBY_NOTIFICATION(GameSessionMembersChanged, GameSessionMembersChanged, Normal, Notification.Session.ID, true);
+	BIND_LOBBY_NOTIFICATION(GameSessionUpdated, GameSessionUpdated, Normal, Notification.ID, true);
+	BIND_LOBBY_NOTIFICATION(GameSessionKicked, KickedFromGameSession, Critical, Notification.SessionID, false);
+	BIND_LOBBY_NOTIFICATION(DSStatusChanged, DsStatusChanged, High, Notification.SessionID, true);
 	//~ End Game Session Notifications
 
 	// Begin Party Session Notifications
-	BIND_LOBBY_NOTIFICATION(PartyInvited, InvitedToPartySession);
-	BIND_LOBBY_NOTIFICATION(PartyMembersChanged, PartySessionMembersChanged);
-	BIND_LOBBY_NOTIFICATION(PartyUpdated, PartySessionUpdated);
-	BIND_LOBBY_NOTIFICATION(PartyKicked, KickedFromPartySession);
-	BIND_LOBBY_NOTIFICATION(PartyRejected, PartySessionInviteRejected);
+	BIND_LOBBY_NOTIFICATION(PartyInvited, InvitedToPartySession, Normal, Notification.PartyID + TEXT(":") + Notification.SenderID, true);
+	BIND_LOBBY_NOTIFICATION(PartyMembersChanged, PartySessionMembersChanged, Normal, Notification.Session.ID, true);
+	BIND_LOBBY_NOTIFICATION(PartyUpdated, PartySessionUpdated, Normal, Notification.ID, true);
+	BIND_LOBBY_NOTIFICATION(PartyKicked, KickedFromPartySession, Critical, Notification.PartyID, false);
+	BIND_LOBBY_NOTIFICATION(PartyRejected, PartySessionInviteRejected, Normal, Notification.PartyID, false);
 	//~ End Party Session Notifications
 
 	// Begin Matchmaking Notifications
-	BIND_LOBBY_NOTIFICATION(MatchmakingStart, MatchmakingStarted);
-	BIND_LOBBY_NOTIFICATION(MatchmakingMatchFound, MatchmakingMatchFound);
-	BIND_LOBBY_NOTIFICATION(MatchmakingExpired, MatchmakingExpired);
-	BIND_LOBBY_NOTIFICATION(MatchmakingCanceled, MatchmakingCanceled)
+	BIND_LOBBY_NOTIFICATION(MatchmakingStart, MatchmakingStarted, High, Notification.TicketID, false);
+	BIND_LOBBY_NOTIFICATION(MatchmakingMatchFound, MatchmakingMatchFound, High, Notification.Id, false);
+	BIND_LOBBY_NOTIFICATION(MatchmakingExpired, MatchmakingExpired, High, Notification.TicketID, false);
+	BIND_LOBBY_NOTIFICATION(MatchmakingCanceled, MatchmakingCanceled, High, Notification.TicketID, false)
 	//~ End Matchmaking Notifications
 
 	#undef BIND_LOBBY_NOTIFICATION
@@ -790,6 +802,7 @@ FNamedOnlineSession* FOnlineSessionV2AccelByte::AddNamedSession(FName SessionNam
 
 	TSharedPtr<FNamedOnlineSession> NewNamedSession = MakeShared<FNamedOnlineSession>(SessionName, SessionSettings);
 	Sessions.Emplace(SessionName, NewNamedSession);
+	SessionNameToRegisteredPlayersMap.Emplace(SessionName);
 
 	return NewNamedSession.Get();
 }
@@ -801,6 +814,15 @@ FNamedOnlineSession* FOnlineSessionV2AccelByte::AddNamedSession(FName SessionNam
 	TSharedPtr<FNamedOnlineSession> NewNamedSession = MakeShared<FNamedOnlineSession>(SessionName, Session);
 	Sessions.Emplace(SessionName, NewNamedSession);
 
+	SessionNameToRegisteredPlayersMap.Emplace(SessionName);
+
+	// Sessions added from a search result or backend model already have their ID, so index it straight away
+	const FString SessionId = NewNamedSession->GetSessionIdStr();
+	if (!SessionId.IsEmpty())
+	{
+		SessionIdToSessionNameMap.Emplace(SessionId, SessionName);
+	}
+
 	return NewNamedSession.Get();
 }
 
@@ -831,9 +853,87 @@ FNamedOnlineSession* FOnlineSessionV2AccelByte::GetNamedSession(FName SessionNam
 }
 
 void FOnlineSessionV2AccelByte::RemoveNamedSession(FName SessionName)
+{
+	{
+		FScopeLock ScopeLock(&SessionLock);
+
+		const TSharedPtr<FNamedOnlineSession>* FoundNamedSession = Sessions.Find(SessionName);
+		if (FoundNamedSession != nullptr && FoundNamedSession->IsValid())
+		{
+			const FString SessionId = (*FoundNamedSession)->GetSessionIdStr();
+			const FName* IndexedSessionName = SessionIdToSessionNameMap.Find(SessionId);
+			if (IndexedSessionName != nullptr && *IndexedSessionName == SessionName)
+			{
+				SessionIdToSessionNameMap.Remove(SessionId);
+			}
+		}
+
+		SessionNameToRegisteredPlayersMap.Remove(SessionName);
+		Sessions.Remove(SessionName);
+	}
+
+	// Backfill manager looks sessions up while holding its own lock, so only tell it once the session lock is released
+	FOnlineBackfillManagerAccelBytePtr BackfillManager = AccelByteSubsystem->GetBackfillManager();
+	if (BackfillManager.IsValid())
+	{
+		BackfillManager->RemoveSession(SessionName);
+	}
+}
+
+void FOnlineSessionV2AccelByte::SetNamedSessionInfo(FNamedOnlineSession& Session, const TSharedRef<FOnlineSessionInfoAccelByteV2>& SessionInfo)
 {
 	FScopeLock ScopeLock(&SessionLock);
-	Sessions.Remove(SessionName);
+
+	// Drop the entry for the ID the session had before, unless it has already been taken over by another session
+	const FString PreviousSessionId = Session.GetSessionIdStr();
+	const FName* IndexedSessionName = SessionIdToSessionNameMap.Find(PreviousSessionId);
+	if (IndexedSessionName != nullptr && *IndexedSessionName == Session.SessionName)
+	{
+		SessionIdToSessionNameMap.Remove(PreviousSessionId);
+	}
+
+	Session.SessionInfo = SessionInfo;
+
+	const FString SessionId = Session.GetSessionIdStr();
+	if (!SessionId.IsEmpty())
+	{
+		SessionIdToSessionNameMap.Emplace(SessionId, Session.SessionName);
+	}
+}
+
+const TSet<FUniqueNetIdRef, FUniqueNetIdConstSharedRefSetKeyFuncs>& FOnlineSessionV2AccelByte::GetRegisteredPlayerSet(const FNamedOnlineSession& Session)
+{
+	return SessionNameToRegisteredPlayersMap.FindOrAdd(Session.SessionName);
+}
+
+void FOnlineSessionV2AccelByte::UpdateRegisteredPlayers(FNamedOnlineSession& Session, const TArray<FUniqueNetIdRef>& Players, bool bRegister, TArray<FUniqueNetIdRef>& OutChangedPlayers)
+{
+	TSet<FUniqueNetIdRef, FUniqueNetIdConstSharedRefSetKeyFuncs>& RegisteredPlayerSet = SessionNameToRegisteredPlayersMap.FindOrAdd(Session.SessionName);
+	for (const FUniqueNetIdRef& Player : Players)
+	{
+		if (bRegister)
+		{
+			bool bIsAlreadyRegistered = false;
+			RegisteredPlayerSet.Add(Player, &bIsAlreadyRegistered);
+			if (!bIsAlreadyRegistered)
+			{
+				Session.RegisteredPlayers.Emplace(Player);
+				OutChangedPlayers.Emplace(Player);
+			}
+		}
+		else if (RegisteredPlayerSet.Remove(Player) > 0)
+		{
+			OutChangedPlayers.Emplace(Player);
+		}
+	}
+
+	// Remove every unregistered player from the array in a single pass, keeping the order of the remaining players
+	if (!bRegister && OutChangedPlayers.Num() > 0)
+	{
+		Session.RegisteredPlayers.RemoveAll([&RegisteredPlayerSet](const FUniqueNetIdRef& RegisteredPlayer) {
+			return !RegisteredPlayerSet.Contains(RegisteredPlayer);
+		});
+	}
 }
 
 bool FOnlineSessionV2AccelByte::HasPresenceSession()
@@ -886,6 +986,8 @@ bool FOnlineSessionV2AccelByte::CreateSession(int32 HostingPlayerNum, FName Sess
 
 bool FOnlineSessionV2AccelByte::CreateSession(const FUniqueNetId& HostingPlayerId, FName SessionName, const FOnlineSessionSettings& NewSessionSettings)
 {
+	AB_OSS_TRACE_SPAN(AccelByteSubsystem, "CreateSession");
+
 	if (!IsRunningDedicatedServer())
 	{
 		AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("HostingPlayerId: %s; SessionName: %s"), *HostingPlayerId.ToString(), *SessionName.ToString());
@@ -1056,7 +1158,7 @@ void FOnlineSessionV2AccelByte::FinalizeCreateGameSession(const FName& SessionNa
 	TSharedRef<FOnlineSessionInfoAccelByteV2> SessionInfo = MakeShared<FOnlineSessionInfoAccelByteV2>(BackendSessionInfo.ID);
 	SessionInfo->SetBackendSessionData(MakeShared<FAccelByteModelsV2GameSession>(BackendSessionInfo));
 	SessionInfo->SetTeamAssignments(BackendSessionInfo.Teams);
-	NewSession->SessionInfo = SessionInfo;
+	SetNamedSessionInfo(*NewSession, SessionInfo);
 
 	// Closed and invite only sessions populate the private connection num, open populates the public num
 	if (BackendSessionInfo.Configuration.Joinability == EAccelByteV2SessionJoinability::INVITE_ONLY || BackendSessionInfo.Configuration.Joinability == EAccelByteV2SessionJoinability::CLOSED)
@@ -1113,7 +1215,7 @@ void FOnlineSessionV2AccelByte::FinalizeCreatePartySession(const FName& SessionN
 	// Create new session info based off of the created session, set by filling session ID
 	TSharedRef<FOnlineSessionInfoAccelByteV2> SessionInfo = MakeShared<FOnlineSessionInfoAccelByteV2>(BackendSessionInfo.ID);
 	SessionInfo->SetBackendSessionData(MakeShared<FAccelByteModelsV2PartySession>(BackendSessionInfo));
-	Session->SessionInfo = SessionInfo;
+	SetNamedSessionInfo(*Session, SessionInfo);
 
 	// Parties are always invite only, so we just want to update the private connection num
 	Session->SessionSettings.NumPrivateConnections = BackendSessionInfo.Configuration.MaxPlayers;
@@ -1418,6 +1520,7 @@ bool FOnlineSessionV2AccelByte::GetServerClaimedSession(FName SessionName, const
 
 	// Flag that creation is underway
 	bIsGettingServerClaimedSession = true;
+	BeginServerStartupPhase(EAccelByteServerStartupPhase::ClaimedSessionFetch);
 
 	// Create a new game session instance that will be further filled out by the subsequent async task.
 	// #NOTE Intentionally passing an invalid ID as we don't know who is hosting the session currently.
@@ -2147,9 +2250,8 @@ bool FOnlineSessionV2AccelByte::IsPlayerInSession(FName SessionName, const FUniq
 		return false;
 	}
 
-	// Create a unique ID matcher instance to check if the registered players array contains the unique ID specified
-	FUniqueNetIdMatcher PlayerMatch(UniqueId);
-	return Session->RegisteredPlayers.ContainsByPredicate(PlayerMatch);
+	FScopeLock ScopeLock(&SessionLock);
+	return GetRegisteredPlayerSet(*Session).Contains(UniqueId.AsShared());
 }
 
 bool FOnlineSessionV2AccelByte::StartMatchmaking(const TArray<TSharedRef<const FUniqueNetId>>& LocalPlayers, FName SessionName, const FOnlineSessionSettings& NewSessionSettings, TSharedRef<FOnlineSessionSearch>& SearchSettings)
@@ -2175,6 +2277,7 @@ bool FOnlineSessionV2AccelByte::StartMatchmaking(const TArray<TSharedRef<const F
 bool FOnlineSessionV2AccelByte::StartMatchmaking(const TArray<FSessionMatchmakingUser>& LocalPlayers, FName SessionName, const FOnlineSessionSettings& NewSessionSettings, TSharedRef<FOnlineSessionSearch>& SearchSettings, const FOnStartMatchmakingComplete& CompletionDelegate)
 {
 	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("LocalPlayerId: %s; SessionName: %s"), ((LocalPlayers.IsValidIndex(0)) ? *LocalPlayers[0].UserId->ToDebugString() : TEXT("")), *SessionName.ToString());
+	AB_OSS_TRACE_SPAN(AccelByteSubsystem, "StartMatchmaking");
 
 	// Check if we already have a session stored with the name specified, if so, inform that they have to leave before matchmaking
 	if (GetNamedSession(SessionName) != nullptr)
@@ -2313,6 +2416,7 @@ bool FOnlineSessionV2AccelByte::FindSessions(int32 SearchingPlayerNum, const TSh
 bool FOnlineSessionV2AccelByte::FindSessions(const FUniqueNetId& SearchingPlayerId, const TSharedRef<FOnlineSessionSearch>& SearchSettings)
 {
 	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("SearchingPlayerId: %s"), *SearchingPlayerId.ToDebugString());
+	AB_OSS_TRACE_SPAN(AccelByteSubsystem, "FindSessions");
 
 	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteFindGameSessionsV2>(AccelByteSubsystem, SearchingPlayerId, SearchSettings);
 
@@ -2362,6 +2466,7 @@ bool FOnlineSessionV2AccelByte::JoinSession(int32 LocalUserNum, FName SessionNam
 bool FOnlineSessionV2AccelByte::JoinSession(const FUniqueNetId& LocalUserId, FName SessionName, const FOnlineSessionSearchResult& DesiredSession)
 {
 	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("LocalUserId: %s; SessionName: %s"), *LocalUserId.ToDebugString(), *SessionName.ToString());
+	AB_OSS_TRACE_SPAN(AccelByteSubsystem, "JoinSession");
 
 	if (GetNamedSession(SessionName) != nullptr)
 	{
@@ -2724,33 +2829,19 @@ bool FOnlineSessionV2AccelByte::RegisterPlayers(FName SessionName, const TArray<
 		return false;
 	}
 
-	for (const TSharedRef<const FUniqueNetId>& PlayerToAdd : Players)
-	{
-		FUniqueNetIdMatcher PlayerToAddMatcher(PlayerToAdd.Get());
-		int32 FoundPlayerIndex = Session->RegisteredPlayers.IndexOfByPredicate(PlayerToAddMatcher);
-		if (FoundPlayerIndex == INDEX_NONE)
-		{
-			Session->RegisteredPlayers.Emplace(PlayerToAdd);
+	FScopeLock ScopeLock(&SessionLock);
+	TArray<FUniqueNetIdRef> AddedPlayers;
+	UpdateRegisteredPlayers(*Session, Players, true, AddedPlayers);
 
-			// Update session player counts based on join type
-			const bool bClosedSession = SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::INVITE_ONLY || SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::CLOSED;
-			if (bClosedSession)
-			{
-				Session->NumOpenPrivateConnections--;
-				if (Session->NumOpenPrivateConnections < 0)
-				{
-					Session->NumOpenPrivateConnections = 0;
-				}
-			}
-			else
-			{
-				Session->NumOpenPublicConnections--;
-				if (Session->NumOpenPublicConnections < 0)
-				{
-					Session->NumOpenPublicConnections = 0;
-				}
-			}
-		}
+	// Update session player counts based on join type
+	const bool bClosedSession = SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::INVITE_ONLY || SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::CLOSED;
+	if (bClosedSession)
+	{
+		Session->NumOpenPrivateConnections = FMath::Max(Session->NumOpenPrivateConnections - AddedPlayers.Num(), 0);
+	}
+	else
+	{
+		Session->NumOpenPublicConnections = FMath::Max(Session->NumOpenPublicConnections - AddedPlayers.Num(), 0);
 	}
 
 	AccelByteSubsystem->ExecuteNextTick([SessionInterface = AsShared(), Players, SessionName]() {
@@ -2807,25 +2898,19 @@ bool FOnlineSessionV2AccelByte::UnregisterPlayers(FName SessionName, const TArra
 		return false;
 	}
 
-	for (const TSharedRef<const FUniqueNetId>& PlayerToRemove : Players)
-	{
-		FUniqueNetIdMatcher PlayerToRemoveMatcher(PlayerToRemove.Get());
-		int32 FoundPlayerIndex = Session->RegisteredPlayers.IndexOfByPredicate(PlayerToRemoveMatcher);
-		if (FoundPlayerIndex != INDEX_NONE)
-		{
-			Session->RegisteredPlayers.RemoveAt(FoundPlayerIndex);
+	FScopeLock ScopeLock(&SessionLock);
+	TArray<FUniqueNetIdRef> RemovedPlayers;
+	UpdateRegisteredPlayers(*Session, Players, false, RemovedPlayers);
 
-			// Update session player counts based on join type
-			const bool bClosedSession = SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::INVITE_ONLY || SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::CLOSED;
-			if (bClosedSession)
-			{
-				Session->NumOpenPrivateConnections++;
-			}
-			else
-			{
-				Session->NumOpenPublicConnections++;
-			}
-		}
+	// Update session player counts based on join type
+	const bool bClosedSession = SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::INVITE_ONLY || SessionData->Configuration.Joinability == EAccelByteV2SessionJoinability::CLOSED;
+	if (bClosedSession)
+	{
+		Session->NumOpenPrivateConnections += RemovedPlayers.Num();
+	}
+	else
+	{
+		Session->NumOpenPublicConnections += RemovedPlayers.Num();
 	}
 
 	AccelByteSubsystem->ExecuteNextTick([SessionInterface = AsShared(), Players, SessionName]() {
@@ -3004,10 +3089,35 @@ bool FOnlineSessionV2AccelByte::LeaveRestoredSession(const FUniqueNetId& LocalUs
 
 FNamedOnlineSession* FOnlineSessionV2AccelByte::GetNamedSessionById(const FString& SessionIdString)
 {
+	FScopeLock ScopeLock(&SessionLock);
+
+	const FName* IndexedSessionName = SessionIdToSessionNameMap.Find(SessionIdString);
+	if (IndexedSessionName == nullptr)
+	{
+		return nullptr;
+	}
+
+	const TSharedPtr<FNamedOnlineSession>* FoundNamedSession = Sessions.Find(*IndexedSessionName);
+	if (FoundNamedSession == nullptr)
+	{
+		return nullptr;
+	}
+
+	return (*FoundNamedSession).Get();
+}
+
+FNamedOnlineSession* FOnlineSessionV2AccelByte::GetNamedSessionByBackfillTicketId(const FString& BackfillTicketId)
+{
+	if (BackfillTicketId.IsEmpty())
+	{
+		return nullptr;
+	}
+
 	FScopeLock ScopeLock(&SessionLock);
 	for (const TPair<FName, TSharedPtr<FNamedOnlineSession>>& SessionPair : Sessions)
 	{
-		if (SessionPair.Value->GetSessionIdStr().Equals(SessionIdString))
+		FString SessionBackfillTicketId;
+		if (SessionPair.Value.IsValid() && SessionPair.Value->SessionSettings.Get(SETTING_MATCHMAKING_BACKFILL_TICKET_ID, SessionBackfillTicketId) && SessionBackfillTicketId.Equals(BackfillTicketId))
 		{
 			return SessionPair.Value.Get();
 		}
@@ -3030,10 +3140,47 @@ void FOnlineSessionV2AccelByte::RegisterServer(FName SessionName, const FOnRegis
 	const AccelByte::GameServerApi::ServerWatchdog::FOnWatchdogDrainReceived OnWatchdogDrainReceivedDelegate = AccelByte::GameServerApi::ServerWatchdog::FOnWatchdogDrainReceived::CreateThreadSafeSP(SharedThis(this), &FOnlineSessionV2AccelByte::OnWatchdogDrain);
 	FRegistry::ServerWatchdog.SetOnWatchdogDrainReceivedDelegate(OnWatchdogDrainReceivedDelegate);
 
+	// Keep the server alive from its own thread, so that hitches on the game thread don't delay heartbeats
+	FOnlineServerHeartbeatAccelBytePtr ServerHeartbeat = AccelByteSubsystem->GetServerHeartbeat();
+	if (ServerHeartbeat.IsValid() && ServerHeartbeat->ShouldStartWithServer())
+	{
+		ServerHeartbeat->StartHeartbeat();
+	}
+
+	BeginServerStartupPhase(EAccelByteServerStartupPhase::RegisterServer);
+
 	// For an Armada-spawned server pod, there will always be a POD_NAME environment variable set. For local servers this
 	// will most likely never be the case. With this, if we have the pod name variable, then register as a non-local server
 	// otherwise, register as a local server.
 	const FString PodName = FPlatformMisc::GetEnvironmentVariable(TEXT("POD_NAME"));
+
+	// Neither the DS hub connection nor the claimed session fetch depend on registration finishing, only on the server
+	// being logged in. Start both alongside registration rather than after it, so that a server spawned for a session
+	// already has that session by the time registration completes. The registration tasks skip whichever of these have
+	// already been started.
+	bool bOverlapServerStartup = true;
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bOverlapServerStartup"), bOverlapServerStartup, GEngineIni);
+	if (bOverlapServerStartup)
+	{
+		FString ServerName = PodName;
+		if (ServerName.IsEmpty())
+		{
+			GetLocalServerName(ServerName);
+		}
+
+		if (!ServerName.IsEmpty())
+		{
+			ConnectToDSHub(ServerName);
+		}
+
+		// #NOTE Local servers can never be spawned for a session, so only remote servers prefetch a claimed session
+		const FString SessionId = FPlatformMisc::GetEnvironmentVariable(TEXT("NOMAD_META_session_id"));
+		if (!PodName.IsEmpty() && !SessionId.IsEmpty() && !bIsGettingServerClaimedSession && GetNamedSession(SessionName) == nullptr)
+		{
+			GetServerClaimedSession(SessionName, SessionId);
+		}
+	}
+
 	if (!PodName.IsEmpty())
 	{
 		AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteRegisterRemoteServerV2>(AccelByteSubsystem, SessionName, Delegate);
@@ -3075,6 +3222,77 @@ void FOnlineSessionV2AccelByte::UnregisterServer(FName SessionName, const FOnUnr
 	}
 }
 
+TArray<FAccelByteServerStartupPhaseTiming> FOnlineSessionV2AccelByte::GetServerStartupTimings() const
+{
+	FScopeLock ScopeLock(&ServerStartupTimingsLock);
+
+	TArray<FAccelByteServerStartupPhaseTiming> OutTimings;
+	OutTimings.Reserve(AccelByteServerStartupPhaseCount);
+	for (const FAccelByteServerStartupPhaseTiming& Timing : ServerStartupTimings)
+	{
+		if (Timing.StartSeconds >= 0.0)
+		{
+			OutTimings.Add(Timing);
+		}
+	}
+
+	return OutTimings;
+}
+
+void FOnlineSessionV2AccelByte::LogServerStartupTimings() const
+{
+	static const TCHAR* PhaseNames[AccelByteServerStartupPhaseCount] = {
+		TEXT("ServerLogin"),
+		TEXT("RegisterServer"),
+		TEXT("ConnectToDSHub"),
+		TEXT("ClaimedSessionFetch"),
+		TEXT("ReadyToWatchdog")
+	};
+
+	const TArray<FAccelByteServerStartupPhaseTiming> Timings = GetServerStartupTimings();
+	UE_LOG_AB(Log, TEXT("Dedicated server startup timings, in seconds since process start:"));
+	for (const FAccelByteServerStartupPhaseTiming& Timing : Timings)
+	{
+		const TCHAR* PhaseName = PhaseNames[static_cast<int32>(Timing.Phase)];
+		if (Timing.IsComplete())
+		{
+			UE_LOG_AB(Log, TEXT("  %s: started at %.3f, took %.3f (%s)"), PhaseName, Timing.StartSeconds, Timing.GetDurationSeconds(), Timing.bWasSuccessful ? TEXT("succeeded") : TEXT("failed"));
+		}
+		else
+		{
+			UE_LOG_AB(Log, TEXT("  %s: started at %.3f, still running"), PhaseName, Timing.StartSeconds);
+		}
+	}
+}
+
+void FOnlineSessionV2AccelByte::BeginServerStartupPhase(EAccelByteServerStartupPhase Phase)
+{
+	FScopeLock ScopeLock(&ServerStartupTimingsLock);
+
+	FAccelByteServerStartupPhaseTiming& Timing = ServerStartupTimings[static_cast<int32>(Phase)];
+	if (Timing.StartSeconds >= 0.0)
+	{
+		return;
+	}
+
+	Timing.Phase = Phase;
+	Timing.StartSeconds = FPlatformTime::Seconds() - GStartTime;
+}
+
+void FOnlineSessionV2AccelByte::EndServerStartupPhase(EAccelByteServerStartupPhase Phase, bool bWasSuccessful)
+{
+	FScopeLock ScopeLock(&ServerStartupTimingsLock);
+
+	FAccelByteServerStartupPhaseTiming& Timing = ServerStartupTimings[static_cast<int32>(Phase)];
+	if (Timing.StartSeconds < 0.0 || Timing.IsComplete())
+	{
+		return;
+	}
+
+	Timing.EndSeconds = FPlatformTime::Seconds() - GStartTime;
+	Timing.bWasSuccessful = bWasSuccessful;
+}
+
 EAccelByteV2SessionType FOnlineSessionV2AccelByte::GetSessionTypeByName(const FName& SessionName)
 {
 	FNamedOnlineSession* Session = GetNamedSession(SessionName);
@@ -3187,19 +3405,18 @@ TArray<FString> FOnlineSessionV2AccelByte::GetRegionList(const FUniqueNetId& Loc
 		return TArray<FString>();
 	}
 
-	// Get latencies to QOS regions, and sort by lowest latency
-	TArray<TPair<FString, float>> Latencies = ApiClient->Qos.GetCachedLatencies();
-	Latencies.Sort([](const TPair<FString, float>& LeftHandLatency, const TPair<FString, float>& RightHandLatency) {
-		return LeftHandLatency.Value < RightHandLatency.Value;
-	});
-
-	// Now add each region to the output array
-	TArray<FString> OutRegions;
-	for (const TPair<FString, float>& Latency : Latencies)
+	const FOnlineRegionRankingAccelBytePtr RegionRanking = AccelByteSubsystem->GetRegionRanking();
+	if (!ensure(RegionRanking.IsValid()))
 	{
-		OutRegions.Emplace(Latency.Key);
+		AB_OSS_INTERFACE_TRACE_END_VERBOSITY(Warning, TEXT("Could not get list of regions as our region ranking is invalid!"));
+		return TArray<FString>();
 	}
 
+	// Fold in the SDK's cached latencies on every call, as they are refreshed whenever anything pings QoS. The ranking
+	// skips a set that is identical to the last one it received, so this only recomputes when the cache has changed.
+	RegionRanking->AddLatencySamples(ApiClient->Qos.GetCachedLatencies());
+	TArray<FString> OutRegions = RegionRanking->GetRankedRegions();
+
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 	return OutRegions;
 }
@@ -3439,7 +3656,23 @@ bool FOnlineSessionV2AccelByte::AcceptBackfillProposal(const FName& SessionName,
 		return false;
 	}
 
-	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteAcceptBackfillProposal>(AccelByteSubsystem, SessionName, Proposal, bStopBackfilling, Delegate);
+	// If the backfill manager deferred this proposal to the game, it is holding slots for its players until it hears back
+	FOnAcceptBackfillProposalComplete OnAcceptComplete = Delegate;
+	FOnlineBackfillManagerAccelBytePtr BackfillManager = AccelByteSubsystem->GetBackfillManager();
+	if (BackfillManager.IsValid())
+	{
+		TWeakPtr<FOnlineBackfillManagerAccelByte, ESPMode::ThreadSafe> BackfillManagerWPtr = BackfillManager;
+		OnAcceptComplete = FOnAcceptBackfillProposalComplete::CreateLambda([BackfillManagerWPtr, SessionName, ProposalID = Proposal.ProposalID, Delegate](bool bWasSuccessful) {
+			FOnlineBackfillManagerAccelBytePtr PinnedBackfillManager = BackfillManagerWPtr.Pin();
+			if (PinnedBackfillManager.IsValid())
+			{
+				PinnedBackfillManager->OnDeferredProposalDecided(SessionName, ProposalID, bWasSuccessful);
+			}
+			Delegate.ExecuteIfBound(bWasSuccessful);
+		});
+	}
+
+	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteAcceptBackfillProposal>(AccelByteSubsystem, SessionName, Proposal, bStopBackfilling, OnAcceptComplete);
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 	return true;
@@ -3459,6 +3692,13 @@ bool FOnlineSessionV2AccelByte::RejectBackfillProposal(const FName& SessionName,
 		return false;
 	}
 
+	// Rejecting a proposal deferred to the game gives its slots back straight away, whether or not matchmaking acknowledges it
+	FOnlineBackfillManagerAccelBytePtr BackfillManager = AccelByteSubsystem->GetBackfillManager();
+	if (BackfillManager.IsValid())
+	{
+		BackfillManager->OnDeferredProposalDecided(SessionName, Proposal.ProposalID, false);
+	}
+
 	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteRejectBackfillProposal>(AccelByteSubsystem, SessionName, Proposal, bStopBackfilling, Delegate);
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
@@ -4046,21 +4286,38 @@ void FOnlineSessionV2AccelByte::UpdateSessionMembers(FNamedOnlineSession* Sessio
 	// We need to diff the previous members array and the new members array to figure out what changed.
 	// If the status changes to Leave or Disconnect, we need to unregister that player. If it changes
 	// to join or connect we need to register them.
+	// Index previous members and registered players by AccelByte ID up front, so that diffing stays linear in the
+	// amount of members rather than scanning both arrays for every member
+	TMap<FString, const FAccelByteModelsV2SessionUser*> PreviousMemberMap;
+	PreviousMemberMap.Reserve(PreviousMembers.Num());
+	for (const FAccelByteModelsV2SessionUser& Member : PreviousMembers)
+	{
+		PreviousMemberMap.Add(Member.ID, &Member);
+	}
+
+	TSet<FString> RegisteredPlayerIds;
+	{
+		FScopeLock ScopeLock(&SessionLock);
+		const TSet<FUniqueNetIdRef, FUniqueNetIdConstSharedRefSetKeyFuncs>& RegisteredPlayerSet = GetRegisteredPlayerSet(*Session);
+		RegisteredPlayerIds.Reserve(RegisteredPlayerSet.Num());
+		for (const FUniqueNetIdRef& PlayerId : RegisteredPlayerSet)
+		{
+			RegisteredPlayerIds.Add(FUniqueNetIdAccelByteUser::CastChecked(PlayerId)->GetAccelByteId());
+		}
+	}
+
+	TArray<FString> NewlyJoinedMemberIds;
 	for (const FAccelByteModelsV2SessionUser& NewMember : SessionData->Members)
 	{
-		const FAccelByteModelsV2SessionUser* PreviousMember = PreviousMembers.FindByPredicate([&NewMember](const FAccelByteModelsV2SessionUser& Member) {
-			return Member.ID == NewMember.ID;
-		});
+		const FAccelByteModelsV2SessionUser* const* FoundPreviousMember = PreviousMemberMap.Find(NewMember.ID);
+		const FAccelByteModelsV2SessionUser* PreviousMember = FoundPreviousMember != nullptr ? *FoundPreviousMember : nullptr;
 
 		// If this user's status hasn't changed, then we want to ensure that we have this player in the RegisteredPlayers
 		// array. If they are already in the array, then skip. Otherwise, register them.
 		if (PreviousMember != nullptr && PreviousMember->Status == NewMember.Status)
 		{
 			const bool bIsJoined = (PreviousMember->Status == EAccelByteV2SessionMemberStatus::JOINED || PreviousMember->Status == EAccelByteV2SessionMemberStatus::CONNECTED);
-			const bool bNeedsRegistration = bIsJoined && !Session->RegisteredPlayers.ContainsByPredicate([&PreviousMember](const FUniqueNetIdRef& PlayerId) {
-				FUniqueNetIdAccelByteUserRef AccelBytePlayerId = FUniqueNetIdAccelByteUser::CastChecked(PlayerId);
-				return AccelBytePlayerId->GetAccelByteId() == PreviousMember->ID;
-			});
+			const bool bNeedsRegistration = bIsJoined && !RegisteredPlayerIds.Contains(PreviousMember->ID);
 
 			if (bNeedsRegistration)
 			{
@@ -4076,6 +4333,7 @@ void FOnlineSessionV2AccelByte::UpdateSessionMembers(FNamedOnlineSession* Sessio
 		if (bIsJoinStatus)
 		{
 			RegisterJoinedSessionMember(Session, NewMember);
+			NewlyJoinedMemberIds.Add(NewMember.ID);
 		}
 		else if (bIsLeaveStatus)
 		{
@@ -4083,6 +4341,13 @@ void FOnlineSessionV2AccelByte::UpdateSessionMembers(FNamedOnlineSession* Sessio
 		}
 	}
 
+	// Warm public records of players that just joined in one batch, so that UI reading them finds them in cache
+	const FOnlineCloudSaveAccelBytePtr CloudSaveInterface = AccelByteSubsystem->GetCloudSaveInterface();
+	if (!IsRunningDedicatedServer() && NewlyJoinedMemberIds.Num() > 0 && Session->LocalOwnerId.IsValid() && CloudSaveInterface.IsValid())
+	{
+		CloudSaveInterface->PrefetchPublicUserRecords(Session->LocalOwnerId.ToSharedRef().Get(), NewlyJoinedMemberIds);
+	}
+
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
 
@@ -4388,15 +4653,34 @@ void FOnlineSessionV2AccelByte::ConnectToDSHub(const FString& ServerName)
 		return;
 	}
 
+	// Also bail if we have already started connecting, such as when the connection was started alongside registration.
+	// Registration may call in from a task thread, so check and set the flag in one step.
+	if (bHasRequestedDSHubConnection.AtomicSet(true))
+	{
+		AB_OSS_INTERFACE_TRACE_END(TEXT("Connection to DS hub already requested, skipping!"));
+		return;
+	}
+	BeginServerStartupPhase(EAccelByteServerStartupPhase::ConnectToDSHub);
+
 	// First, register any delegates that we want to listen to from DS hub
+	const FVoidHandler OnDSHubConnectSuccessNotificationDelegate = FVoidHandler::CreateThreadSafeSP(SharedThis(this), &FOnlineSessionV2AccelByte::OnDSHubConnectSuccessNotification);
+	FRegistry::ServerDSHub.SetOnConnectSuccessDelegate(OnDSHubConnectSuccessNotificationDelegate);
+
+	const FErrorHandler OnDSHubConnectFailedNotificationDelegate = FErrorHandler::CreateThreadSafeSP(SharedThis(this), &FOnlineSessionV2AccelByte::OnDSHubConnectFailedNotification);
+	FRegistry::ServerDSHub.SetOnConnectFailedDelegate(OnDSHubConnectFailedNotificationDelegate);
+
 	const AccelByte::GameServerApi::FOnServerClaimedNotification OnServerClaimedNotificationDelegate = AccelByte::GameServerApi::FOnServerClaimedNotification::CreateThreadSafeSP(SharedThis(this), &FOnlineSessionV2AccelByte::OnServerClaimedNotification);
 	FRegistry::ServerDSHub.SetOnServerClaimedNotificationDelegate(OnServerClaimedNotificationDelegate);
 
 	const AccelByte::GameServerApi::FOnV2BackfillProposalNotification OnV2BackfillProposalNotificationDelegate = AccelByte::GameServerApi::FOnV2BackfillProposalNotification::CreateThreadSafeSP(SharedThis(this), &FOnlineSessionV2AccelByte::OnV2BackfillProposalNotification);
 	FRegistry::ServerDSHub.SetOnV2BackfillProposalNotificationDelegate(OnV2BackfillProposalNotificationDelegate);
 
-	// Finally, connect to the DS hub websocket
-	FRegistry::ServerDSHub.Connect(ServerName);
+	// Finally, connect to the DS hub websocket. The heartbeat thread may be sending over the DS hub at the same time, so
+	// hold the server connection lock while we replace the connection.
+	{
+		FScopeLock ConnectionLock(&FOnlineServerHeartbeatAccelByte::GetServerConnectionLock());
+		FRegistry::ServerDSHub.Connect(ServerName);
+	}
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
@@ -4413,15 +4697,47 @@ void FOnlineSessionV2AccelByte::DisconnectFromDSHub()
 	}
 
 	// Unbind any delegates that we want to stop listening to DS hub for
+	FRegistry::ServerDSHub.SetOnConnectSuccessDelegate(FVoidHandler());
+	FRegistry::ServerDSHub.SetOnConnectFailedDelegate(FErrorHandler());
 	FRegistry::ServerDSHub.SetOnServerClaimedNotificationDelegate(AccelByte::GameServerApi::FOnServerClaimedNotification());
 	FRegistry::ServerDSHub.SetOnV2BackfillProposalNotificationDelegate(AccelByte::GameServerApi::FOnV2BackfillProposalNotification());
 
 	// Finally, disconnect the DS hub websocket
-	FRegistry::ServerDSHub.Disconnect();
+	{
+		FScopeLock ConnectionLock(&FOnlineServerHeartbeatAccelByte::GetServerConnectionLock());
+		FRegistry::ServerDSHub.Disconnect();
+	}
+	bHasRequestedDSHubConnection = false;
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
 
+bool FOnlineSessionV2AccelByte::HasRequestedDSHubConnection() const
+{
+	return bHasRequestedDSHubConnection;
+}
+
+void FOnlineSessionV2AccelByte::OnDSHubConnectSuccessNotification()
+{
+	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT(""));
+
+	EndServerStartupPhase(EAccelByteServerStartupPhase::ConnectToDSHub, true);
+
+	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
+}
+
+void FOnlineSessionV2AccelByte::OnDSHubConnectFailedNotification(int32 ErrorCode, const FString& ErrorMessage)
+{
+	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("ErrorCode: %d; ErrorMessage: %s"), ErrorCode, *ErrorMessage);
+
+	EndServerStartupPhase(EAccelByteServerStartupPhase::ConnectToDSHub, false);
+
+	// Allow the connection to be requested again, otherwise the server could never reach the DS hub after one failure
+	bHasRequestedDSHubConnection = false;
+
+	AB_OSS_INTERFACE_TRACE_END_VERBOSITY(Warning, TEXT("Failed to connect to DS hub, connection may be requested again"));
+}
+
 void FOnlineSessionV2AccelByte::OnServerClaimedNotification(const FAccelByteModelsServerClaimedNotification& Notification)
 {
 	AB_OSS_INTERFACE_TRACE_BEGIN(TEXT("SessionId: %s"), *Notification.Session_id)
@@ -4457,7 +4773,16 @@ void FOnlineSessionV2AccelByte::OnV2BackfillProposalNotification(const FAccelByt
 		return;
 	}
 
-	TriggerOnBackfillProposalReceivedDelegates(Notification);
+	// Let the backfill manager decide on the proposal if the game has opted in, otherwise leave it to the game
+	FOnlineBackfillManagerAccelBytePtr BackfillManager = AccelByteSubsystem->GetBackfillManager();
+	if (BackfillManager.IsValid() && BackfillManager->IsEnabled())
+	{
+		BackfillManager->HandleProposal(Notification);
+	}
+	else
+	{
+		TriggerOnBackfillProposalReceivedDelegates(Notification);
+	}
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
@@ -4471,7 +4796,14 @@ void FOnlineSessionV2AccelByte::SendReadyToWatchdog()
 		AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 		return;
 	}
-	FRegistry::ServerWatchdog.SendReadyMessage();
+	{
+		FScopeLock ConnectionLock(&FOnlineServerHeartbeatAccelByte::GetServerConnectionLock());
+		FRegistry::ServerWatchdog.SendReadyMessage();
+	}
+
+	BeginServerStartupPhase(EAccelByteServerStartupPhase::ReadyToWatchdog);
+	EndServerStartupPhase(EAccelByteServerStartupPhase::ReadyToWatchdog, true);
+	LogServerStartupTimings();
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
@@ -4487,11 +4819,21 @@ void FOnlineSessionV2AccelByte::DisconnectFromWatchdog()
 		return;
 	}
 
+	// Stop sending heartbeats before the connection they go over is closed
+	FOnlineServerHeartbeatAccelBytePtr ServerHeartbeat = AccelByteSubsystem->GetServerHeartbeat();
+	if (ServerHeartbeat.IsValid())
+	{
+		ServerHeartbeat->StopHeartbeat();
+	}
+
 	// Unbind any delegates that we want to stop listening to Watchdog for
 	FRegistry::ServerWatchdog.SetOnWatchdogDrainReceivedDelegate(AccelByte::GameServerApi::ServerWatchdog::FOnWatchdogDrainReceived());
 
 	// Finally, disconnect the DS watchdog websocket
-	FRegistry::ServerWatchdog.Disconnect();
+	{
+		FScopeLock ConnectionLock(&FOnlineServerHeartbeatAccelByte::GetServerConnectionLock());
+		FRegistry::ServerWatchdog.Disconnect();
+	}
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
 }
@@ -4507,6 +4849,16 @@ void FOnlineSessionV2AccelByte::OnWatchdogDrain()
 		return;
 	}
 
+	// Drain handlers are game code, so make sure they run on the game thread whichever thread the drain arrived on
+	if (!IsInGameThread())
+	{
+		AccelByteSubsystem->ExecuteNextTick([SessionInterface = SharedThis(this)]() {
+			SessionInterface->TriggerOnWatchdogDrainReceivedDelegates();
+		});
+		AB_OSS_INTERFACE_TRACE_END(TEXT("Drain received off the game thread, deferring delegates to the next tick"));
+		return;
+	}
+
 	TriggerOnWatchdogDrainReceivedDelegates();
 
 	AB_OSS_INTERFACE_TRACE_END(TEXT(""));
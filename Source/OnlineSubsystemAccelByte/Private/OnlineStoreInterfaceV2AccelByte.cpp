@@ -10,11 +10,38 @@
 #include "AsyncTasks/Store/OnlineAsyncTaskAccelByteQueryOfferBySku.h"
 #include "AsyncTasks/Store/OnlineAsyncTaskAccelByteQueryOfferDynamicData.h"
 #include "OnlineSubsystemUtils.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#if WITH_DEV_AUTOMATION_TESTS
+#include "ExecTests/ExecTestBackendOverrides.h"
+#endif
+
+namespace
+{
+	/** Version of the catalog snapshot format, snapshots saved with any other version are ignored */
+	constexpr int32 CatalogSnapshotVersion = 1;
+
+	/** Dynamic field that holds the time an offer was last updated on the backend, used to detect changed offers */
+	const TCHAR* OfferUpdatedAtField = TEXT("UpdatedAt");
+}
 
 FOnlineStoreV2AccelByte::FOnlineStoreV2AccelByte(FOnlineSubsystemAccelByte* InSubsystem) 
 	: AccelByteSubsystem(InSubsystem)
 	, ServiceLabel(1)
-{}
+{
+	GConfig->GetBool(TEXT("OnlineSubsystemAccelByte"), TEXT("bEnableStoreCatalogSnapshot"), bIsCatalogSnapshotEnabled, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("OfferDynamicDataFreshnessSeconds"), OfferDynamicDataFreshnessSeconds, GEngineIni);
+
+	// The snapshot for this language is loaded by the subsystem once the interface is shared, see LoadCatalogSnapshotInBackground
+	OffersLanguage = AccelByteSubsystem->GetLanguage();
+}
 
 void FOnlineStoreV2AccelByte::ReplaceCategories(TArray<FOnlineStoreCategory> InCategories)
 {
@@ -54,6 +81,286 @@ void FOnlineStoreV2AccelByte::ResetOffers()
 {
 	FScopeLock ScopeLock(&OffersLock);
 	StoreOffers.Reset();
+	CatalogOfferIds.Reset();
+}
+
+int32 FOnlineStoreV2AccelByte::MergeOffers(const TMap<FUniqueOfferId, FOnlineStoreOfferRef>& InOffers, bool bIsCompleteCatalog, const FString& InLanguage)
+{
+	FScopeLock ScopeLock(&OffersLock);
+	if (!OffersLanguage.Equals(InLanguage))
+	{
+		UE_LOG_AB(Verbose, TEXT("Discarding %d offers fetched in language '%s' as the store is now in language '%s'"), InOffers.Num(), *InLanguage, *OffersLanguage);
+		return 0;
+	}
+
+	int32 ChangedOffers = 0;
+	for (const TPair<FUniqueOfferId, FOnlineStoreOfferRef>& Offer : InOffers)
+	{
+		if (bIsCompleteCatalog)
+		{
+			CatalogOfferIds.Add(Offer.Key);
+		}
+
+		// Offers without an update time can't be compared, so they are always treated as changed
+		const FOnlineStoreOfferRef* CachedOffer = StoreOffers.Find(Offer.Key);
+		const FString* UpdatedAt = Offer.Value->DynamicFields.Find(OfferUpdatedAtField);
+		if (CachedOffer != nullptr && UpdatedAt != nullptr)
+		{
+			const FString* CachedUpdatedAt = (*CachedOffer)->DynamicFields.Find(OfferUpdatedAtField);
+			if (CachedUpdatedAt != nullptr && CachedUpdatedAt->Equals(*UpdatedAt))
+			{
+				continue;
+			}
+		}
+
+		StoreOffers.Emplace(Offer.Key, Offer.Value);
+		ChangedOffers++;
+	}
+
+	if (bIsCompleteCatalog)
+	{
+		for (TSet<FUniqueOfferId>::TIterator It = CatalogOfferIds.CreateIterator(); It; ++It)
+		{
+			if (!InOffers.Contains(*It))
+			{
+				StoreOffers.Remove(*It);
+				It.RemoveCurrent();
+				ChangedOffers++;
+			}
+		}
+	}
+
+	return ChangedOffers;
+}
+
+TFuture<int32> FOnlineStoreV2AccelByte::SetOffersLanguage(const FString& InLanguage)
+{
+	{
+		FScopeLock ScopeLock(&OffersLock);
+		if (OffersLanguage.Equals(InLanguage))
+		{
+			TPromise<int32> Promise;
+			Promise.SetValue(0);
+			return Promise.GetFuture();
+		}
+		StoreOffers.Reset();
+		CatalogOfferIds.Reset();
+		OffersLanguage = InLanguage;
+	}
+
+	return LoadCatalogSnapshotInBackground(InLanguage);
+}
+
+TFuture<int32> FOnlineStoreV2AccelByte::LoadCatalogSnapshotInBackground(const FString& InLanguage)
+{
+	if (!bIsCatalogSnapshotEnabled)
+	{
+		TPromise<int32> Promise;
+		Promise.SetValue(0);
+		return Promise.GetFuture();
+	}
+
+	// Read and parse the snapshot off the game thread, as the catalog may hold thousands of offers. If the language is
+	// switched again before this finishes, LoadCatalogSnapshot sees that and loads nothing.
+	const TWeakPtr<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe> StoreV2InterfaceWeak = AsShared();
+	return Async(EAsyncExecution::ThreadPool, [StoreV2InterfaceWeak, InLanguage]() {
+		const TSharedPtr<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe> StoreV2Interface = StoreV2InterfaceWeak.Pin();
+		if (!StoreV2Interface.IsValid())
+		{
+			return 0;
+		}
+
+		const int32 LoadedOffers = StoreV2Interface->LoadCatalogSnapshot(InLanguage);
+		if (LoadedOffers > 0)
+		{
+			UE_LOG_AB(Log, TEXT("Loaded %d offers from the store catalog snapshot for language '%s'"), LoadedOffers, *InLanguage);
+		}
+		return LoadedOffers;
+	});
+}
+
+FString FOnlineStoreV2AccelByte::GetOffersLanguage() const
+{
+	FScopeLock ScopeLock(&OffersLock);
+	return OffersLanguage;
+}
+
+int32 FOnlineStoreV2AccelByte::LoadCatalogSnapshot(const FString& InLanguage)
+{
+	FString SnapshotString;
+	bool bIsSnapshotLoaded = false;
+	{
+		FScopeLock SnapshotScopeLock(&CatalogSnapshotLock);
+		bIsSnapshotLoaded = FFileHelper::LoadFileToString(SnapshotString, *GetCatalogSnapshotPath(InLanguage));
+	}
+	if (!bIsSnapshotLoaded)
+	{
+		return 0;
+	}
+
+	TSharedPtr<FJsonObject> SnapshotObject;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(SnapshotString);
+	if (!FJsonSerializer::Deserialize(JsonReader, SnapshotObject) || !SnapshotObject.IsValid()
+		|| SnapshotObject->GetIntegerField(TEXT("version")) != CatalogSnapshotVersion)
+	{
+		UE_LOG_AB(Warning, TEXT("Ignoring store catalog snapshot for language '%s' as it could not be read"), *InLanguage);
+		return 0;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* OfferValues = nullptr;
+	if (!SnapshotObject->TryGetArrayField(TEXT("offers"), OfferValues))
+	{
+		return 0;
+	}
+
+	TMap<FUniqueOfferId, FOnlineStoreOfferRef> SnapshotOffers;
+	SnapshotOffers.Reserve(OfferValues->Num());
+	for (const TSharedPtr<FJsonValue>& OfferValue : *OfferValues)
+	{
+		const TSharedPtr<FJsonObject>* OfferObject = nullptr;
+		if (!OfferValue.IsValid() || !OfferValue->TryGetObject(OfferObject))
+		{
+			continue;
+		}
+
+		FOnlineStoreOfferRef Offer = MakeShared<FOnlineStoreOffer>();
+		Offer->OfferId = (*OfferObject)->GetStringField(TEXT("offerId"));
+		Offer->Title = FText::FromString((*OfferObject)->GetStringField(TEXT("title")));
+		Offer->CurrencyCode = (*OfferObject)->GetStringField(TEXT("currencyCode"));
+		Offer->NumericPrice = static_cast<int64>((*OfferObject)->GetNumberField(TEXT("numericPrice")));
+		Offer->RegularPrice = static_cast<int64>((*OfferObject)->GetNumberField(TEXT("regularPrice")));
+
+		const TSharedPtr<FJsonObject>* DynamicFieldsObject = nullptr;
+		if ((*OfferObject)->TryGetObjectField(TEXT("dynamicFields"), DynamicFieldsObject))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : (*DynamicFieldsObject)->Values)
+			{
+				Offer->DynamicFields.Add(Field.Key, Field.Value->AsString());
+			}
+		}
+
+		if (!Offer->OfferId.IsEmpty())
+		{
+			SnapshotOffers.Add(Offer->OfferId, Offer);
+		}
+	}
+
+	// Offers fetched before the snapshot was loaded are newer, so never overwrite them. Once a complete catalog has been
+	// fetched in this language the whole snapshot is older than it, so load nothing rather than bring back delisted offers.
+	FScopeLock ScopeLock(&OffersLock);
+	if (!OffersLanguage.Equals(InLanguage) || CatalogOfferIds.Num() > 0)
+	{
+		return 0;
+	}
+
+	int32 LoadedOffers = 0;
+	for (const TPair<FUniqueOfferId, FOnlineStoreOfferRef>& Offer : SnapshotOffers)
+	{
+		if (!StoreOffers.Contains(Offer.Key))
+		{
+			StoreOffers.Add(Offer.Key, Offer.Value);
+			CatalogOfferIds.Add(Offer.Key);
+			LoadedOffers++;
+		}
+	}
+	return LoadedOffers;
+}
+
+bool FOnlineStoreV2AccelByte::SaveCatalogSnapshot(const FString& InLanguage) const
+{
+	// Hold the snapshot lock from reading the offers until the file is written, so saves land in the order they read
+	FScopeLock SnapshotScopeLock(&CatalogSnapshotLock);
+
+	TArray<TSharedPtr<FJsonValue>> OfferValues;
+	{
+		FScopeLock ScopeLock(&OffersLock);
+		if (!OffersLanguage.Equals(InLanguage))
+		{
+			UE_LOG_AB(Verbose, TEXT("Skipping store catalog snapshot for language '%s' as the store is now in language '%s'"), *InLanguage, *OffersLanguage);
+			return false;
+		}
+
+		OfferValues.Reserve(CatalogOfferIds.Num());
+		for (const FUniqueOfferId& OfferId : CatalogOfferIds)
+		{
+			const FOnlineStoreOfferRef* Offer = StoreOffers.Find(OfferId);
+			if (Offer == nullptr)
+			{
+				continue;
+			}
+
+			const TSharedRef<FJsonObject> OfferObject = MakeShared<FJsonObject>();
+			OfferObject->SetStringField(TEXT("offerId"), (*Offer)->OfferId);
+			OfferObject->SetStringField(TEXT("title"), (*Offer)->Title.ToString());
+			OfferObject->SetStringField(TEXT("currencyCode"), (*Offer)->CurrencyCode);
+			OfferObject->SetNumberField(TEXT("numericPrice"), (*Offer)->NumericPrice);
+			OfferObject->SetNumberField(TEXT("regularPrice"), (*Offer)->RegularPrice);
+
+			const TSharedRef<FJsonObject> DynamicFieldsObject = MakeShared<FJsonObject>();
+			for (const TPair<FString, FString>& Field : (*Offer)->DynamicFields)
+			{
+				DynamicFieldsObject->SetStringField(Field.Key, Field.Value);
+			}
+			OfferObject->SetObjectField(TEXT("dynamicFields"), DynamicFieldsObject);
+			OfferValues.Add(MakeShared<FJsonValueObject>(OfferObject));
+		}
+	}
+
+	const TSharedRef<FJsonObject> SnapshotObject = MakeShared<FJsonObject>();
+	SnapshotObject->SetNumberField(TEXT("version"), CatalogSnapshotVersion);
+	SnapshotObject->SetStringField(TEXT("namespace"), AccelByteSubsystem->GetAppId());
+	SnapshotObject->SetStringField(TEXT("language"), InLanguage);
+	SnapshotObject->SetStringField(TEXT("savedAt"), FDateTime::UtcNow().ToIso8601());
+	SnapshotObject->SetArrayField(TEXT("offers"), OfferValues);
+
+	FString SnapshotString;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&SnapshotString);
+	if (!FJsonSerializer::Serialize(SnapshotObject, Writer))
+	{
+		return false;
+	}
+
+	const FString SnapshotPath = GetCatalogSnapshotPath(InLanguage);
+	if (!FFileHelper::SaveStringToFile(SnapshotString, *SnapshotPath))
+	{
+		UE_LOG_AB(Warning, TEXT("Failed to save store catalog snapshot to %s"), *SnapshotPath);
+		return false;
+	}
+	return true;
+}
+
+FString FOnlineStoreV2AccelByte::GetCatalogSnapshotPath(const FString& InLanguage) const
+{
+	const FString FileName = FPaths::MakeValidFileName(FString::Printf(TEXT("%s-%s.json"), *AccelByteSubsystem->GetAppId(), *InLanguage));
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AccelByte"), TEXT("StoreCatalog"), FileName);
+}
+
+FString FOnlineStoreV2AccelByte::GetOfferQueryKey(const FUniqueNetId& UserId, const FOnlineStoreFilter& Filter, const FString& InLanguage)
+{
+	const auto JoinCategories = [](const TArray<FOnlineStoreCategory>& Categories) {
+		TArray<FString> CategoryIds;
+		for (const FOnlineStoreCategory& Category : Categories)
+		{
+			CategoryIds.Add(Category.Id);
+		}
+		return FString::Join(CategoryIds, TEXT(","));
+	};
+
+	return FString::Printf(TEXT("%s|%s|%s|%s|%s"), *UserId.ToString(), *InLanguage, *FString::Join(Filter.Keywords, TEXT(",")), *JoinCategories(Filter.IncludeCategories), *JoinCategories(Filter.ExcludeCategories));
+}
+
+void FOnlineStoreV2AccelByte::OnQueryOffersByFilterComplete(bool bWasSuccessful, const TArray<FUniqueOfferId>& OfferIds, const FString& Error, FString QueryKey)
+{
+	TArray<FOnQueryOnlineStoreOffersComplete> WaitingDelegates;
+	{
+		FScopeLock ScopeLock(&PendingOfferQueriesLock);
+		PendingOfferQueries.RemoveAndCopyValue(QueryKey, WaitingDelegates);
+	}
+
+	for (const FOnQueryOnlineStoreOffersComplete& WaitingDelegate : WaitingDelegates)
+	{
+		WaitingDelegate.ExecuteIfBound(bWasSuccessful, OfferIds, Error);
+	}
 }
 
 void FOnlineStoreV2AccelByte::EmplaceOfferDynamicData(const FUniqueNetId& InUserId, TSharedRef<FAccelByteModelsItemDynamicData> InDynamicData)
@@ -61,7 +368,200 @@ void FOnlineStoreV2AccelByte::EmplaceOfferDynamicData(const FUniqueNetId& InUser
 	FScopeLock ScopeLock(&DynamicDataLock);
 	const TSharedRef<const FUniqueNetIdAccelByteUser> SharedUserId = FUniqueNetIdAccelByteUser::CastChecked(InUserId);
 	FOfferToDynamicDataMap& FoundDynamicDataMap = OffersDynamicData.FindOrAdd(SharedUserId);
+	FAccelByteOfferDynamicDataFreshness& Freshness = OffersDynamicDataFreshness.FindOrAdd(SharedUserId);
+	Freshness.FetchedTimeInSeconds.Add(InDynamicData->ItemId, FPlatformTime::Seconds());
+
+	// Keep the cached instance if nothing changed, so that the version only moves when there is something new to show
+	const TSharedRef<FAccelByteModelsItemDynamicData>* CachedDynamicData = FoundDynamicDataMap.Find(InDynamicData->ItemId);
+	if (CachedDynamicData != nullptr && FAccelByteModelsItemDynamicData::StaticStruct()->CompareScriptStruct(&CachedDynamicData->Get(), &InDynamicData.Get(), PPF_None))
+	{
+		return;
+	}
+
 	FoundDynamicDataMap.Emplace(InDynamicData->ItemId, InDynamicData);
+	Freshness.Version++;
+}
+
+void FOnlineStoreV2AccelByte::Tick(float DeltaTime)
+{
+	TArray<FPendingOfferDynamicDataQuery> Queries;
+	{
+		FScopeLock ScopeLock(&PendingDynamicDataQueriesLock);
+		if (PendingDynamicDataQueries.Num() == 0)
+		{
+			return;
+		}
+		Queries = MoveTemp(PendingDynamicDataQueries);
+		PendingDynamicDataQueries.Reset();
+	}
+
+	TMap<FString, TArray<FPendingOfferDynamicDataQuery>> QueriesByUser;
+	for (FPendingOfferDynamicDataQuery& Query : Queries)
+	{
+		QueriesByUser.FindOrAdd(Query.UserId->GetAccelByteId()).Add(MoveTemp(Query));
+	}
+
+	for (TPair<FString, TArray<FPendingOfferDynamicDataQuery>>& UserQueries : QueriesByUser)
+	{
+		const FUniqueNetIdAccelByteUserRef UserId = UserQueries.Value[0].UserId;
+		const TSharedRef<FOfferDynamicDataFetch> NewFetch = MakeShared<FOfferDynamicDataFetch>();
+		TSet<FUniqueOfferId> StaleOfferIds;
+		TArray<FPendingOfferDynamicDataQuery> FreshQueries;
+		{
+			FScopeLock ScopeLock(&PendingDynamicDataQueriesLock);
+			TMap<FUniqueOfferId, TSharedRef<FOfferDynamicDataFetch>>& InFlightFetches = InFlightDynamicDataFetches.FindOrAdd(UserQueries.Key);
+			for (FPendingOfferDynamicDataQuery& Query : UserQueries.Value)
+			{
+				// Offers that are already being fetched wait on that fetch rather than being requested again
+				TArray<TSharedRef<FOfferDynamicDataFetch>> WaitingOnFetches;
+				for (const FUniqueOfferId& OfferId : Query.OfferIds)
+				{
+					const TSharedRef<FOfferDynamicDataFetch>* InFlightFetch = InFlightFetches.Find(OfferId);
+					if (InFlightFetch != nullptr)
+					{
+						WaitingOnFetches.AddUnique(*InFlightFetch);
+					}
+					else if (!IsOfferDynamicDataFresh(UserId.Get(), OfferId))
+					{
+						StaleOfferIds.Add(OfferId);
+						WaitingOnFetches.AddUnique(NewFetch);
+					}
+				}
+
+				if (WaitingOnFetches.Num() == 0)
+				{
+					FreshQueries.Add(MoveTemp(Query));
+					continue;
+				}
+
+				const TSharedRef<FOfferDynamicDataQueryState> QueryState = MakeShared<FOfferDynamicDataQueryState>();
+				QueryState->Query = MoveTemp(Query);
+				QueryState->OutstandingFetches = WaitingOnFetches.Num();
+				for (const TSharedRef<FOfferDynamicDataFetch>& Fetch : WaitingOnFetches)
+				{
+					Fetch->WaitingQueries.Add(QueryState);
+				}
+			}
+
+			for (const FUniqueOfferId& OfferId : StaleOfferIds)
+			{
+				InFlightFetches.Add(OfferId, NewFetch);
+			}
+			if (InFlightFetches.Num() == 0)
+			{
+				InFlightDynamicDataFetches.Remove(UserQueries.Key);
+			}
+		}
+
+		// Everything these queries asked for is still fresh, so answer straight from the cache
+		for (const FPendingOfferDynamicDataQuery& Query : FreshQueries)
+		{
+			Query.Delegate.ExecuteIfBound(true, Query.OfferIds, TEXT(""));
+		}
+
+		if (StaleOfferIds.Num() == 0)
+		{
+			continue;
+		}
+
+		const TArray<FUniqueOfferId> FetchOfferIds = StaleOfferIds.Array();
+		const FOnQueryOnlineStoreOffersComplete OnFetchComplete = FOnQueryOnlineStoreOffersComplete::CreateRaw(this, &FOnlineStoreV2AccelByte::OnOfferDynamicDataFetchComplete, UserId, NewFetch, FetchOfferIds);
+#if WITH_DEV_AUTOMATION_TESTS
+		const TFunction<void(const FUniqueNetIdAccelByteUserRef&, const TArray<FUniqueOfferId>&, const FOnQueryOnlineStoreOffersComplete&)> FetchOverride = AccelByteSubsystem->GetExecTestBackendOverrides().FetchOfferDynamicData;
+		if (FetchOverride)
+		{
+			FetchOverride(UserId, FetchOfferIds, OnFetchComplete);
+			continue;
+		}
+#endif
+		AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryOfferDynamicData>(AccelByteSubsystem, UserId.Get(), FetchOfferIds, OnFetchComplete);
+	}
+}
+
+void FOnlineStoreV2AccelByte::OnOfferDynamicDataFetchComplete(bool bWasSuccessful, const TArray<FUniqueOfferId>& /*FetchedOfferIds*/, const FString& Error, FUniqueNetIdAccelByteUserRef UserId, TSharedRef<FOfferDynamicDataFetch> Fetch, TArray<FUniqueOfferId> RequestedOfferIds)
+{
+	TArray<TSharedRef<FOfferDynamicDataQueryState>> CompletedQueries;
+	{
+		FScopeLock ScopeLock(&PendingDynamicDataQueriesLock);
+		TMap<FUniqueOfferId, TSharedRef<FOfferDynamicDataFetch>>* InFlightFetches = InFlightDynamicDataFetches.Find(UserId->GetAccelByteId());
+		if (InFlightFetches != nullptr)
+		{
+			for (const FUniqueOfferId& OfferId : RequestedOfferIds)
+			{
+				const TSharedRef<FOfferDynamicDataFetch>* InFlightFetch = InFlightFetches->Find(OfferId);
+				if (InFlightFetch != nullptr && *InFlightFetch == Fetch)
+				{
+					InFlightFetches->Remove(OfferId);
+				}
+			}
+			if (InFlightFetches->Num() == 0)
+			{
+				InFlightDynamicDataFetches.Remove(UserId->GetAccelByteId());
+			}
+		}
+
+		// Dynamic data answered before the offer was invalidated may predate the order, so it must not count as fresh
+		if (Fetch->InvalidatedOfferIds.Num() > 0)
+		{
+			FScopeLock DynamicDataScopeLock(&DynamicDataLock);
+			FAccelByteOfferDynamicDataFreshness* Freshness = OffersDynamicDataFreshness.Find(UserId);
+			if (Freshness != nullptr)
+			{
+				for (const FUniqueOfferId& OfferId : Fetch->InvalidatedOfferIds)
+				{
+					Freshness->FetchedTimeInSeconds.Remove(OfferId);
+				}
+			}
+		}
+
+		for (const TSharedRef<FOfferDynamicDataQueryState>& QueryState : Fetch->WaitingQueries)
+		{
+			if (!bWasSuccessful)
+			{
+				QueryState->bWasSuccessful = false;
+				QueryState->Error = Error;
+			}
+			if (--QueryState->OutstandingFetches == 0)
+			{
+				CompletedQueries.Add(QueryState);
+			}
+		}
+		Fetch->WaitingQueries.Reset();
+	}
+
+	for (const TSharedRef<FOfferDynamicDataQueryState>& QueryState : CompletedQueries)
+	{
+		QueryState->Query.Delegate.ExecuteIfBound(QueryState->bWasSuccessful, QueryState->Query.OfferIds, QueryState->Error);
+	}
+}
+
+void FOnlineStoreV2AccelByte::InvalidateOfferDynamicData(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId)
+{
+	const TSharedRef<const FUniqueNetIdAccelByteUser> SharedUserId = FUniqueNetIdAccelByteUser::CastChecked(UserId);
+	{
+		// Later queries start a new fetch, and the one in flight leaves the offer stale when it completes
+		FScopeLock ScopeLock(&PendingDynamicDataQueriesLock);
+		TMap<FUniqueOfferId, TSharedRef<FOfferDynamicDataFetch>>* InFlightFetches = InFlightDynamicDataFetches.Find(SharedUserId->GetAccelByteId());
+		const TSharedRef<FOfferDynamicDataFetch>* InFlightFetch = (InFlightFetches != nullptr) ? InFlightFetches->Find(OfferId) : nullptr;
+		if (InFlightFetch != nullptr)
+		{
+			(*InFlightFetch)->InvalidatedOfferIds.Add(OfferId);
+			InFlightFetches->Remove(OfferId);
+		}
+	}
+
+	FScopeLock ScopeLock(&DynamicDataLock);
+	FAccelByteOfferDynamicDataFreshness* Freshness = OffersDynamicDataFreshness.Find(SharedUserId);
+	if (Freshness != nullptr)
+	{
+		Freshness->FetchedTimeInSeconds.Remove(OfferId);
+	}
+}
+
+void FOnlineStoreV2AccelByte::SetOfferDynamicDataFreshness(double InFreshnessSeconds)
+{
+	FScopeLock ScopeLock(&DynamicDataLock);
+	OfferDynamicDataFreshnessSeconds = InFreshnessSeconds;
 }
 
 bool FOnlineStoreV2AccelByte::GetFromSubsystem(const IOnlineSubsystem* Subsystem, FOnlineStoreV2AccelBytePtr& OutInterfaceInstance)
@@ -116,7 +616,22 @@ void FOnlineStoreV2AccelByte::GetCategory(const FString& CategoryPath, FOnlineSt
 
 void FOnlineStoreV2AccelByte::QueryOffersByFilter(const FUniqueNetId& UserId, const FOnlineStoreFilter& Filter, const FOnQueryOnlineStoreOffersComplete& Delegate)
 {
-	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryOfferByFilter>(AccelByteSubsystem, UserId, Filter, Delegate);
+	// Identical queries made while one is already in flight wait on that query rather than fetching the catalog again
+	const FString QueryKey = GetOfferQueryKey(UserId, Filter, AccelByteSubsystem->GetLanguage());
+	{
+		FScopeLock ScopeLock(&PendingOfferQueriesLock);
+		TArray<FOnQueryOnlineStoreOffersComplete>* WaitingDelegates = PendingOfferQueries.Find(QueryKey);
+		if (WaitingDelegates != nullptr)
+		{
+			WaitingDelegates->Add(Delegate);
+			UE_LOG_AB(Verbose, TEXT("Offer query '%s' is already in flight, waiting on it with %d other callers"), *QueryKey, WaitingDelegates->Num() - 1);
+			return;
+		}
+		PendingOfferQueries.Add(QueryKey, { Delegate });
+	}
+
+	const FOnQueryOnlineStoreOffersComplete OnQueryComplete = FOnQueryOnlineStoreOffersComplete::CreateRaw(this, &FOnlineStoreV2AccelByte::OnQueryOffersByFilterComplete, QueryKey);
+	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryOfferByFilter>(AccelByteSubsystem, UserId, Filter, OnQueryComplete);
 }
 
 void FOnlineStoreV2AccelByte::QueryOffersById(const FUniqueNetId& UserId, const TArray<FUniqueOfferId>& OfferIds,
@@ -132,7 +647,13 @@ void FOnlineStoreV2AccelByte::QueryOfferBySku(const FUniqueNetId& UserId, const
 
 void FOnlineStoreV2AccelByte::QueryOfferDynamicData(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId, const FOnQueryOnlineStoreOffersComplete& Delegate)
 {
-	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteQueryOfferDynamicData>(AccelByteSubsystem, UserId, OfferId, Delegate);
+	QueryOffersDynamicData(UserId, TArray<FUniqueOfferId>{OfferId}, Delegate);
+}
+
+void FOnlineStoreV2AccelByte::QueryOffersDynamicData(const FUniqueNetId& UserId, const TArray<FUniqueOfferId>& OfferIds, const FOnQueryOnlineStoreOffersComplete& Delegate)
+{
+	FScopeLock ScopeLock(&PendingDynamicDataQueriesLock);
+	PendingDynamicDataQueries.Add({ FUniqueNetIdAccelByteUser::CastChecked(UserId), OfferIds, Delegate });
 }
 
 void FOnlineStoreV2AccelByte::GetOffers(TArray<FOnlineStoreOfferRef>& OutOffers) const
@@ -180,3 +701,25 @@ TSharedPtr<FAccelByteModelsItemDynamicData> FOnlineStoreV2AccelByte::GetOfferDyn
 	}
 	return nullptr;
 }
+
+bool FOnlineStoreV2AccelByte::IsOfferDynamicDataFresh(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId) const
+{
+	FScopeLock ScopeLock(&DynamicDataLock);
+	const TSharedRef<const FUniqueNetIdAccelByteUser> SharedUserId = FUniqueNetIdAccelByteUser::CastChecked(UserId);
+	const FAccelByteOfferDynamicDataFreshness* Freshness = OffersDynamicDataFreshness.Find(SharedUserId);
+	if (Freshness == nullptr)
+	{
+		return false;
+	}
+
+	const double* FetchedTimeInSeconds = Freshness->FetchedTimeInSeconds.Find(OfferId);
+	return FetchedTimeInSeconds != nullptr && FPlatformTime::Seconds() - *FetchedTimeInSeconds < OfferDynamicDataFreshnessSeconds;
+}
+
+uint32 FOnlineStoreV2AccelByte::GetOfferDynamicDataVersion(const FUniqueNetId& UserId) const
+{
+	FScopeLock ScopeLock(&DynamicDataLock);
+	const TSharedRef<const FUniqueNetIdAccelByteUser> SharedUserId = FUniqueNetIdAccelByteUser::CastChecked(UserId);
+	const FAccelByteOfferDynamicDataFreshness* Freshness = OffersDynamicDataFreshness.Find(SharedUserId);
+	return (Freshness != nullptr) ? Freshness->Version : 0;
+}
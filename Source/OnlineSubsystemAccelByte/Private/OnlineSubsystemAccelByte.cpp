@@ -13,6 +13,14 @@
 #include "OnlinePartyInterfaceAccelByte.h"
 #include "OnlinePresenceInterfaceAccelByte.h"
 #include "OnlineUserCacheAccelByte.h"
+#include "OnlinePlayerActivityCacheAccelByte.h"
+#include "OnlineRegionRankingAccelByte.h"
+#include "OnlineLobbyNotificationQueueAccelByte.h"
+#include "OnlineLoginBootstrapAccelByte.h"
+#include "OnlineBackfillManagerAccelByte.h"
+#include "OnlineServerHeartbeatAccelByte.h"
+#include "OnlineAsyncTaskMetricsAccelByte.h"
+#include "OnlineOperationTraceAccelByte.h"
 #include "OnlineAgreementInterfaceAccelByte.h"
 #include "OnlineWalletInterfaceAccelByte.h"
 #include "OnlineCloudSaveInterfaceAccelByte.h"
@@ -32,6 +40,27 @@
 
 #if WITH_DEV_AUTOMATION_TESTS
 #include "ExecTests/ExecTestBase.h"
+#include "ExecTests/ExecTestBackendOverrides.h"
+#include "ExecTests/ExecTestPartyIndex.h"
+#include "ExecTests/ExecTestPlayerActivityCacheSoak.h"
+#include "ExecTests/ExecTestSessionPlayerRegistrationStress.h"
+#include "ExecTests/ExecTestRegionRanking.h"
+#include "ExecTests/ExecTestServerClock.h"
+#include "ExecTests/ExecTestLobbyNotificationQueue.h"
+#include "ExecTests/ExecTestLoginBootstrap.h"
+#include "ExecTests/ExecTestLANBeacon.h"
+#include "ExecTests/ExecTestServerStartup.h"
+#include "ExecTests/ExecTestServerHeartbeat.h"
+#include "ExecTests/ExecTestChatRoomMembership.h"
+#include "ExecTests/ExecTestCloudSaveRecordCache.h"
+#include "ExecTests/ExecTestCloudSaveBulkGet.h"
+#include "ExecTests/ExecTestAsyncTaskMetrics.h"
+#include "ExecTests/ExecTestAsyncTaskBenchmark.h"
+#include "ExecTests/ExecTestOperationTrace.h"
+#include "ExecTests/ExecTestStoreCatalog.h"
+#include "ExecTests/ExecTestStoreOfferDynamicData.h"
+#include "ExecTests/ExecTestEcommerceCacheInvalidation.h"
+#include "ExecTests/ExecTestBackfillManager.h"
 #endif
 #include "OnlineAgreementInterfaceAccelByte.h"
 #include "OnlineChatInterfaceAccelByte.h"
@@ -41,6 +70,10 @@
 
 bool FOnlineSubsystemAccelByte::Init()
 {
+#if WITH_DEV_AUTOMATION_TESTS
+	ExecTestBackendOverrides = MakeShared<FExecTestBackendOverrides, ESPMode::ThreadSafe>();
+#endif
+
 	// Create each shared instance of our interface implementations, passing in ourselves as the parent
 #if AB_USE_V2_SESSIONS
 	SessionInterface = MakeShared<FOnlineSessionV2AccelByte, ESPMode::ThreadSafe>(this);
@@ -57,11 +90,19 @@ bool FOnlineSubsystemAccelByte::Init()
 	PartyInterface = MakeShared<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe>(this);
 	PresenceInterface = MakeShared<FOnlinePresenceAccelByte, ESPMode::ThreadSafe>(this);
 	UserCache = MakeShared<FOnlineUserCacheAccelByte, ESPMode::ThreadSafe>(this);
+	PlayerActivityCache = MakeShared<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe>(this);
+	RegionRanking = MakeShared<FOnlineRegionRankingAccelByte, ESPMode::ThreadSafe>(this);
+	LobbyNotificationQueue = MakeShared<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe>(this);
+	LoginBootstrap = MakeShared<FOnlineLoginBootstrapAccelByte, ESPMode::ThreadSafe>(this);
+	BackfillManager = MakeShared<FOnlineBackfillManagerAccelByte, ESPMode::ThreadSafe>(this);
+	ServerHeartbeat = MakeShared<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe>(this);
 	AgreementInterface = MakeShared<FOnlineAgreementAccelByte, ESPMode::ThreadSafe>(this);
 	WalletInterface = MakeShared<FOnlineWalletAccelByte, ESPMode::ThreadSafe>(this);
 	CloudSaveInterface = MakeShared<FOnlineCloudSaveAccelByte, ESPMode::ThreadSafe>(this);
 	EntitlementsInterface = MakeShared<FOnlineEntitlementsAccelByte, ESPMode::ThreadSafe>(this);
 	StoreV2Interface = MakeShared<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe>(this);
+	// Load the snapshot of the last complete catalog fetch, so that offers can be shown before the first query completes
+	StoreV2Interface->LoadCatalogSnapshotInBackground(GetLanguage());
 	PurchaseInterface = MakeShared<FOnlinePurchaseAccelByte, ESPMode::ThreadSafe>(this);
 	TimeInterface = MakeShared<FOnlineTimeAccelByte, ESPMode::ThreadSafe>(this);
 	AnalyticsInterface = MakeShared<FOnlineAnalyticsAccelByte, ESPMode::ThreadSafe>(this);
@@ -70,6 +111,10 @@ bool FOnlineSubsystemAccelByte::Init()
 	AuthInterface = MakeShared<FOnlineAuthAccelByte, ESPMode::ThreadSafe>(this);
 	AchievementInterface = MakeShared<FOnlineAchievementsAccelByte, ESPMode::ThreadSafe>(this);
 	
+	// Create our async task metrics before the manager, as the manager and each task it runs record into them
+	AsyncTaskMetrics = MakeShared<FOnlineAsyncTaskMetricsAccelByte, ESPMode::ThreadSafe>(this);
+	OperationTrace = MakeShared<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe>(this);
+
 	// Create an async task manager and a thread for the manager to process tasks on
 	AsyncTaskManager = MakeShared<FOnlineAsyncTaskManagerAccelByte, ESPMode::ThreadSafe>(this);
 	AsyncTaskManagerThread.Reset(FRunnableThread::Create(AsyncTaskManager.Get(), *FString::Printf(TEXT("OnlineAsyncTaskThread %s"), *InstanceName.ToString())));
@@ -105,6 +150,10 @@ bool FOnlineSubsystemAccelByte::Shutdown()
 		AsyncTaskManager.Reset();
 	}
 
+	// Only clear our async task metrics and trace once the manager is gone, as any task destroyed with it may still record into them
+	AsyncTaskMetrics.Reset();
+	OperationTrace.Reset();
+
 #if WITH_DEV_AUTOMATION_TESTS
 	// Clear out any exec tests that we have added
 	ActiveExecTests.Empty();
@@ -142,6 +191,16 @@ bool FOnlineSubsystemAccelByte::Shutdown()
 	IdentityInterface.Reset();
 	SessionInterface.Reset();
 	UserCache.Reset();
+	PlayerActivityCache.Reset();
+	RegionRanking.Reset();
+	LobbyNotificationQueue.Reset();
+	LoginBootstrap.Reset();
+	BackfillManager.Reset();
+	if (ServerHeartbeat.IsValid())
+	{
+		ServerHeartbeat->StopHeartbeat();
+		ServerHeartbeat.Reset();
+	}
 	AgreementInterface.Reset();
 	WalletInterface.Reset();
 	EntitlementsInterface.Reset();
@@ -223,6 +282,51 @@ FOnlineUserCacheAccelBytePtr FOnlineSubsystemAccelByte::GetUserCache() const
 	return UserCache;
 }
 
+FOnlinePlayerActivityCacheAccelBytePtr FOnlineSubsystemAccelByte::GetPlayerActivityCache() const
+{
+	return PlayerActivityCache;
+}
+
+FOnlineRegionRankingAccelBytePtr FOnlineSubsystemAccelByte::GetRegionRanking() const
+{
+	return RegionRanking;
+}
+
+FOnlineLobbyNotificationQueueAccelBytePtr FOnlineSubsystemAccelByte::GetLobbyNotificationQueue() const
+{
+	return LobbyNotificationQueue;
+}
+
+FOnlineLoginBootstrapAccelBytePtr FOnlineSubsystemAccelByte::GetLoginBootstrap() const
+{
+	return LoginBootstrap;
+}
+
+FOnlineBackfillManagerAccelBytePtr FOnlineSubsystemAccelByte::GetBackfillManager() const
+{
+	return BackfillManager;
+}
+
+FOnlineServerHeartbeatAccelBytePtr FOnlineSubsystemAccelByte::GetServerHeartbeat() const
+{
+	return ServerHeartbeat;
+}
+
+FOnlineAsyncTaskMetricsAccelBytePtr FOnlineSubsystemAccelByte::GetAsyncTaskMetrics() const
+{
+	return AsyncTaskMetrics;
+}
+
+FOnlineOperationTraceAccelBytePtr FOnlineSubsystemAccelByte::GetOperationTrace() const
+{
+	return OperationTrace;
+}
+
+FOnlineAsyncTaskManagerAccelBytePtr FOnlineSubsystemAccelByte::GetAsyncTaskManager() const
+{
+	return AsyncTaskManager;
+}
+
 IOnlineEntitlementsPtr FOnlineSubsystemAccelByte::GetEntitlementsInterface() const
 {
 	return EntitlementsInterface;
@@ -314,8 +418,229 @@ bool FOnlineSubsystemAccelByte::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputD
 		{
 			bWasHandled = UserInterface->TestExec(InWorld, Cmd, Ar);
 		}
+		else if (FParse::Command(&Cmd, TEXT("PARTY")) && FParse::Command(&Cmd, TEXT("INDEX")))
+		{
+			// Full command to test the party member and invite indexes is ONLINE TEST PARTY INDEX <optional party size> <optional party count>
+			const FString PartySizeStr = FParse::Token(Cmd, false);
+			const int32 PartySize = PartySizeStr.IsEmpty() ? 50 : FCString::Atoi(*PartySizeStr);
+			const FString PartyCountStr = FParse::Token(Cmd, false);
+			const int32 PartyCount = PartyCountStr.IsEmpty() ? 100 : FCString::Atoi(*PartyCountStr);
+
+			RunExecTest<FExecTestPartyIndex>(InWorld, PartySize, PartyCount);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("PLAYERACTIVITY")) && FParse::Command(&Cmd, TEXT("SOAK")))
+		{
+			// Full command to soak the player activity cache is ONLINE TEST PLAYERACTIVITY SOAK <optional player count>
+			const FString PlayerCountStr = FParse::Token(Cmd, false);
+			const int32 PlayerCount = PlayerCountStr.IsEmpty() ? 100000 : FCString::Atoi(*PlayerCountStr);
+
+			RunExecTest<FExecTestPlayerActivityCacheSoak>(InWorld, PlayerCount);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("QOS")) && FParse::Command(&Cmd, TEXT("RANKING")))
+		{
+			// Full command to test the QoS region ranking is ONLINE TEST QOS RANKING
+			RunExecTest<FExecTestRegionRanking>(InWorld);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("TIME")) && FParse::Command(&Cmd, TEXT("CLOCK")))
+		{
+			// Full command to test the drift corrected server clock is ONLINE TEST TIME CLOCK
+			RunExecTest<FExecTestServerClock>(InWorld);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("LOBBYNOTIFICATION")) && FParse::Command(&Cmd, TEXT("QUEUE")))
+		{
+			// Full command to test the lobby notification queue is ONLINE TEST LOBBYNOTIFICATION QUEUE
+			RunExecTest<FExecTestLobbyNotificationQueue>(InWorld);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("LOGIN")) && FParse::Command(&Cmd, TEXT("BOOTSTRAP")))
+		{
+			// Full command to test the post-login bootstrap is ONLINE TEST LOGIN BOOTSTRAP
+			RunExecTest<FExecTestLoginBootstrap>(InWorld);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("LAN")) && FParse::Command(&Cmd, TEXT("BEACON")))
+		{
+			// Full command to test LAN beacon packets is ONLINE TEST LAN BEACON <optional iteration count>
+			const FString IterationsStr = FParse::Token(Cmd, false);
+			const int32 Iterations = IterationsStr.IsEmpty() ? 1000 : FCString::Atoi(*IterationsStr);
+
+			RunExecTest<FExecTestLANBeacon>(InWorld, Iterations);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("SERVER")))
+		{
+			// Server tests share a keyword, so match the second keyword separately for each test
+			if (FParse::Command(&Cmd, TEXT("HEARTBEAT")))
+			{
+				// Full command to test the server heartbeat thread is ONLINE TEST SERVER HEARTBEAT <optional seconds to block for>
+				const FString BlockSecondsStr = FParse::Token(Cmd, false);
+				const float BlockSeconds = BlockSecondsStr.IsEmpty() ? 5.0f : FCString::Atof(*BlockSecondsStr);
+
+				RunExecTest<FExecTestServerHeartbeat>(InWorld, BlockSeconds);
+				bWasHandled = true;
+			}
+#if AB_USE_V2_SESSIONS
+			else if (FParse::Command(&Cmd, TEXT("STARTUP")))
+			{
+				// Full command to test the dedicated server startup pipeline is ONLINE TEST SERVER STARTUP
+				RunExecTest<FExecTestServerStartup>(InWorld);
+				bWasHandled = true;
+			}
+#endif
+		}
+		else if (FParse::Command(&Cmd, TEXT("CHAT")) && FParse::Command(&Cmd, TEXT("MEMBERSHIP")))
+		{
+			// Full command to test chat room membership caching is ONLINE TEST CHAT MEMBERSHIP <optional members per room> <optional room count>
+			const FString MembersPerRoomStr = FParse::Token(Cmd, false);
+			const int32 MembersPerRoom = MembersPerRoomStr.IsEmpty() ? 10000 : FCString::Atoi(*MembersPerRoomStr);
+			const FString RoomCountStr = FParse::Token(Cmd, false);
+			const int32 RoomCount = RoomCountStr.IsEmpty() ? 10 : FCString::Atoi(*RoomCountStr);
+
+			RunExecTest<FExecTestChatRoomMembership>(InWorld, MembersPerRoom, RoomCount);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("CLOUDSAVE")))
+		{
+			if (FParse::Command(&Cmd, TEXT("CACHE")))
+			{
+				// Full command to test the CloudSave user record cache is ONLINE TEST CLOUDSAVE CACHE
+				RunExecTest<FExecTestCloudSaveRecordCache>(InWorld);
+				bWasHandled = true;
+			}
+			else if (FParse::Command(&Cmd, TEXT("BULK")))
+			{
+				// Full command to test bulk public user record fetches is ONLINE TEST CLOUDSAVE BULK
+				RunExecTest<FExecTestCloudSaveBulkGet>(InWorld);
+				bWasHandled = true;
+			}
+		}
+		else if (FParse::Command(&Cmd, TEXT("ASYNCTASK")))
+		{
+			if (FParse::Command(&Cmd, TEXT("METRICS")))
+			{
+				// Full command to test the async task metrics is ONLINE TEST ASYNCTASK METRICS
+				RunExecTest<FExecTestAsyncTaskMetrics>(InWorld);
+				bWasHandled = true;
+			}
+			else if (FParse::Command(&Cmd, TEXT("BENCHMARK")))
+			{
+				// Full command to benchmark the async task manager is ONLINE TEST ASYNCTASK BENCHMARK <optional task count> <optional idle seconds>
+				const FString TaskCountStr = FParse::Token(Cmd, false);
+				const int32 TaskCount = TaskCountStr.IsEmpty() ? 1000 : FCString::Atoi(*TaskCountStr);
+				const FString IdleSecondsStr = FParse::Token(Cmd, false);
+				const float IdleSeconds = IdleSecondsStr.IsEmpty() ? 2.0f : FCString::Atof(*IdleSecondsStr);
+
+				RunExecTest<FExecTestAsyncTaskBenchmark>(InWorld, TaskCount, IdleSeconds);
+				bWasHandled = true;
+			}
+		}
+		else if (FParse::Command(&Cmd, TEXT("TRACE")) && FParse::Command(&Cmd, TEXT("SPANS")))
+		{
+			// Full command to test the operation trace is ONLINE TEST TRACE SPANS
+			RunExecTest<FExecTestOperationTrace>(InWorld);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("STORE")))
+		{
+			if (FParse::Command(&Cmd, TEXT("CATALOG")))
+			{
+				// Full command to test the store catalog cache is ONLINE TEST STORE CATALOG
+				RunExecTest<FExecTestStoreCatalog>(InWorld);
+				bWasHandled = true;
+			}
+			else if (FParse::Command(&Cmd, TEXT("DYNAMICDATA")))
+			{
+				// Full command to test the offer dynamic data cache is ONLINE TEST STORE DYNAMICDATA
+				RunExecTest<FExecTestStoreOfferDynamicData>(InWorld);
+				bWasHandled = true;
+			}
+		}
+		else if (FParse::Command(&Cmd, TEXT("ECOMMERCE")) && FParse::Command(&Cmd, TEXT("INVALIDATION")))
+		{
+			// Full command to test wallet and entitlement cache invalidation is ONLINE TEST ECOMMERCE INVALIDATION
+			RunExecTest<FExecTestEcommerceCacheInvalidation>(InWorld);
+			bWasHandled = true;
+		}
+#if AB_USE_V2_SESSIONS
+		else if (FParse::Command(&Cmd, TEXT("SESSION")) && FParse::Command(&Cmd, TEXT("STRESS")))
+		{
+			// Full command to stress session player registration is ONLINE TEST SESSION STRESS <optional players per session> <optional session count>
+			const FString PlayersPerSessionStr = FParse::Token(Cmd, false);
+			const FString SessionCountStr = FParse::Token(Cmd, false);
+			const int32 PlayersPerSession = PlayersPerSessionStr.IsEmpty() ? 2000 : FCString::Atoi(*PlayersPerSessionStr);
+			const int32 SessionCount = SessionCountStr.IsEmpty() ? 8 : FCString::Atoi(*SessionCountStr);
+
+			RunExecTest<FExecTestSessionPlayerRegistrationStress>(InWorld, PlayersPerSession, SessionCount);
+			bWasHandled = true;
+		}
+		else if (FParse::Command(&Cmd, TEXT("BACKFILL")) && FParse::Command(&Cmd, TEXT("MANAGER")))
+		{
+			// Full command to test backfill slot reservations is ONLINE TEST BACKFILL MANAGER
+			RunExecTest<FExecTestBackfillManager>(InWorld);
+			bWasHandled = true;
+		}
+#endif
 #endif
 	}
+	else if (FParse::Command(&Cmd, TEXT("ASYNCTASK")) && FParse::Command(&Cmd, TEXT("METRICS")) && AsyncTaskMetrics.IsValid())
+	{
+		// Full command to inspect async task metrics is ONLINE ASYNCTASK METRICS <optional ENABLE, DISABLE or RESET>
+		if (FParse::Command(&Cmd, TEXT("ENABLE")))
+		{
+			AsyncTaskMetrics->SetEnabled(true);
+		}
+		else if (FParse::Command(&Cmd, TEXT("DISABLE")))
+		{
+			AsyncTaskMetrics->SetEnabled(false);
+		}
+		else if (FParse::Command(&Cmd, TEXT("RESET")))
+		{
+			AsyncTaskMetrics->Reset();
+		}
+
+		AsyncTaskMetrics->Dump(Ar);
+		bWasHandled = true;
+	}
+	else if (FParse::Command(&Cmd, TEXT("TRACE")) && OperationTrace.IsValid())
+	{
+		// Full command to record operation traces is ONLINE TRACE <START, STOP, CLEAR or EXPORT> <optional export file path>
+		if (FParse::Command(&Cmd, TEXT("START")))
+		{
+			OperationTrace->SetEnabled(true);
+			Ar.Logf(TEXT("AccelByte operation tracing started"));
+		}
+		else if (FParse::Command(&Cmd, TEXT("STOP")))
+		{
+			OperationTrace->SetEnabled(false);
+			Ar.Logf(TEXT("AccelByte operation tracing stopped"));
+		}
+		else if (FParse::Command(&Cmd, TEXT("CLEAR")))
+		{
+			OperationTrace->Clear();
+			Ar.Logf(TEXT("AccelByte operation trace cleared"));
+		}
+		else if (FParse::Command(&Cmd, TEXT("EXPORT")))
+		{
+			FString FilePath;
+			if (OperationTrace->ExportChromeTrace(FParse::Token(Cmd, false), FilePath))
+			{
+				Ar.Logf(TEXT("AccelByte operation trace exported to %s"), *FilePath);
+			}
+			else
+			{
+				Ar.Logf(TEXT("Failed to export AccelByte operation trace to %s"), *FilePath);
+			}
+		}
+		else
+		{
+			Ar.Logf(TEXT("AccelByte operation tracing is %s, %d spans recorded"), OperationTrace->IsEnabled() ? TEXT("enabled") : TEXT("disabled"), OperationTrace->GetSpans().Num());
+		}
+		bWasHandled = true;
+	}
 	
 	// If we didn't handle any exec tests, then just pass handling to the super method
 	if (!bWasHandled)
@@ -343,6 +668,12 @@ bool FOnlineSubsystemAccelByte::Tick(float DeltaTime)
 		AsyncTaskManager->GameTick();
 	}
 
+	// Handle queued lobby notifications before ticking interfaces, so that they see the results on this tick
+	if (LobbyNotificationQueue.IsValid())
+	{
+		LobbyNotificationQueue->Tick(DeltaTime);
+	}
+
 	if (SessionInterface.IsValid())
 	{
 		SessionInterface->Tick(DeltaTime);
@@ -353,6 +684,46 @@ bool FOnlineSubsystemAccelByte::Tick(float DeltaTime)
 		AuthInterface->Tick(DeltaTime);
 	}
 
+	if (PresenceInterface.IsValid())
+	{
+		PresenceInterface->Tick(DeltaTime);
+	}
+
+	if (TimeInterface.IsValid())
+	{
+		TimeInterface->Tick(DeltaTime);
+	}
+
+	if (PlayerActivityCache.IsValid())
+	{
+		PlayerActivityCache->Tick(DeltaTime);
+	}
+
+	if (RegionRanking.IsValid())
+	{
+		RegionRanking->Tick(DeltaTime);
+	}
+
+	if (ChatInterface.IsValid())
+	{
+		ChatInterface->Tick(DeltaTime);
+	}
+
+	if (StoreV2Interface.IsValid())
+	{
+		StoreV2Interface->Tick(DeltaTime);
+	}
+
+	if (WalletInterface.IsValid())
+	{
+		WalletInterface->Tick(DeltaTime);
+	}
+
+	if (EntitlementsInterface.IsValid())
+	{
+		EntitlementsInterface->Tick(DeltaTime);
+	}
+
 	// If we have automation testing enabled, check if we have any exec tests that are complete and if so, remove them
 #if WITH_DEV_AUTOMATION_TESTS
 	ActiveExecTests.RemoveAll([](const TSharedPtr<FExecTestBase>& ExecTest) { return ExecTest->bIsComplete; });
@@ -520,7 +891,18 @@ void FOnlineSubsystemAccelByte::OnLoginCallback(int32 LocalUserNum, bool bWasSuc
 	}
 	
 	ApiClient->Lobby.SetMessageNotifDelegate(Delegate);
-	if (bIsAutoLobbyConnectAfterLoginSuccess && IdentityInterface.IsValid())
+
+	// Start the fetches requested by the game for this user. If lobby connection is one of the stages, the bootstrap
+	// connects to the lobby itself, so skip the auto connect to avoid connecting twice. The stages are taken from the
+	// start call, as the run may already have finished by the time it returns.
+	bool bIsLobbyConnectedByBootstrap = false;
+	TArray<FName> BootstrapStages;
+	if (LoginBootstrap.IsValid() && LoginBootstrap->StartBootstrap(LocalUserNum, &BootstrapStages))
+	{
+		bIsLobbyConnectedByBootstrap = BootstrapStages.Contains(FOnlineLoginBootstrapAccelByte::ConnectLobbyStage);
+	}
+
+	if (bIsAutoLobbyConnectAfterLoginSuccess && !bIsLobbyConnectedByBootstrap && IdentityInterface.IsValid())
 	{
 		IdentityInterface->ConnectAccelByteLobby(LocalUserNum);
 	}
@@ -534,6 +916,18 @@ void FOnlineSubsystemAccelByte::OnLoginCallback(int32 LocalUserNum, bool bWasSuc
 void FOnlineSubsystemAccelByte::OnMessageNotif(const FAccelByteModelsNotificationMessage& InMessage, int32 LocalUserNum)
 {
 	UE_LOG_AB(Verbose, TEXT("Got freeform notification from backend at %s!\nTopic: %s\nPayload: %s"), *InMessage.SentAt.ToString(), *InMessage.Topic, *InMessage.Payload);
+
+	// Let the e-commerce caches queue refreshes for anything the notification says has changed. A single topic can be
+	// configured for both, such as a fulfillment that credits a wallet and grants an item, so every cache gets to see it.
+	if (WalletInterface.IsValid())
+	{
+		WalletInterface->OnNotificationReceived(LocalUserNum, InMessage.Topic, InMessage.Payload);
+	}
+
+	if (EntitlementsInterface.IsValid())
+	{
+		EntitlementsInterface->OnNotificationReceived(LocalUserNum, InMessage.Topic, InMessage.Payload);
+	}
 }
 
 void FOnlineSubsystemAccelByte::OnLobbyConnectedCallback(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UniqueNetId, const FString& ErrorMessage)
@@ -667,6 +1061,12 @@ FString FOnlineSubsystemAccelByte::GetLanguage()
 void FOnlineSubsystemAccelByte::SetLanguage(const FString& InLanguage)
 {
 	Language = InLanguage;
+
+	// Offers cached in the previous language are no longer valid, so switch the store over to the new one
+	if (StoreV2Interface.IsValid())
+	{
+		StoreV2Interface->SetOffersLanguage(InLanguage);
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -3,6 +3,7 @@
 #include "HAL/Platform.h"
 #include "OnlineSubsystemAccelByteDefines.h"
 #include "OnlineSubsystemAccelByte.h"
+#include "OnlinePlayerActivityCacheAccelByte.h"
 #include "Interfaces/OnlineUserInterface.h"
 #include "Online.h"
 #include "OnlineSubsystemAccelByteTypes.h"
@@ -201,48 +202,122 @@ EAccelByteLoginType FOnlineSubsystemAccelByteUtils::GetAccelByteLoginTypeFromNat
 	return EAccelByteLoginType::None;
 }
 
-TMap<FString, FString> FOnlineSubsystemAccelByteUtils::UserPlatformMaps;
-TMap<FString, FString> FOnlineSubsystemAccelByteUtils::UserJoinCached;
-TMap<FString, FString> FOnlineSubsystemAccelByteUtils::UserDisconnectedCached;
+bool FOnlineSubsystemAccelByteUtils::GetOffsetAndLimitFromPagingUrl(const FString& PagingUrl, int32& OutOffset, int32& OutLimit)
+{
+	int32 QueryStartIndex = INDEX_NONE;
+	if (!PagingUrl.FindChar(TEXT('?'), QueryStartIndex))
+	{
+		return false;
+	}
+
+	bool bFoundOffset = false;
+	bool bFoundLimit = false;
+	TArray<FString> Params;
+	PagingUrl.RightChop(QueryStartIndex + 1).ParseIntoArray(Params, TEXT("&"));
+	for (const FString& Param : Params)
+	{
+		FString Key;
+		FString Value;
+		if (!Param.Split(TEXT("="), &Key, &Value) || !Value.IsNumeric())
+		{
+			continue;
+		}
+
+		if (Key.Equals(TEXT("offset")))
+		{
+			OutOffset = FCString::Atoi(*Value);
+			bFoundOffset = true;
+		}
+		else if (Key.Equals(TEXT("limit")))
+		{
+			OutLimit = FCString::Atoi(*Value);
+			bFoundLimit = true;
+		}
+	}
 
-void FOnlineSubsystemAccelByteUtils::AddUserPlatform(const FString& UserId, const FString PlatformName)
+	return bFoundOffset && bFoundLimit;
+}
+
+TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> FOnlineSubsystemAccelByteUtils::GetPlayerActivityCache(const FOnlineSubsystemAccelByte* Subsystem)
 {
-	UserPlatformMaps.Add(UserId, PlatformName);
+	if (Subsystem == nullptr)
+	{
+		Subsystem = static_cast<FOnlineSubsystemAccelByte*>(IOnlineSubsystem::Get(ACCELBYTE_SUBSYSTEM));
+	}
+	if (Subsystem == nullptr)
+	{
+		return nullptr;
+	}
+
+	return Subsystem->GetPlayerActivityCache();
+}
+
+void FOnlineSubsystemAccelByteUtils::AddUserPlatform(const FString& UserId, const FString PlatformName, const FOnlineSubsystemAccelByte* Subsystem)
+{
+	const TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> ActivityCache = GetPlayerActivityCache(Subsystem);
+	if (ActivityCache.IsValid())
+	{
+		ActivityCache->SetPlatform(UserId, PlatformName);
+	}
 }
 
-FString FOnlineSubsystemAccelByteUtils::GetUserPlatform(const FString& UserId)
+FString FOnlineSubsystemAccelByteUtils::GetUserPlatform(const FString& UserId, const FOnlineSubsystemAccelByte* Subsystem)
 {
-	if(UserPlatformMaps.Contains(UserId))
+	const TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> ActivityCache = GetPlayerActivityCache(Subsystem);
+	FAccelBytePlayerActivity Activity;
+	if (ActivityCache.IsValid() && ActivityCache->GetPlayerActivity(UserId, Activity) && !Activity.Platform.IsEmpty())
 	{
-		return UserPlatformMaps[UserId];
+		return Activity.Platform;
 	}
 	return TEXT("NULL");
 }
 
-void FOnlineSubsystemAccelByteUtils::AddUserJoinTime(const FString& UserId, const FString Value)
+void FOnlineSubsystemAccelByteUtils::AddUserJoinTime(const FString& UserId, const FString Value, const FOnlineSubsystemAccelByte* Subsystem)
 {
-	UserJoinCached.Add(UserId, Value);
+	const TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> ActivityCache = GetPlayerActivityCache(Subsystem);
+	FDateTime JoinTime;
+	if (ActivityCache.IsValid() && FDateTime::ParseIso8601(*Value, JoinTime))
+	{
+		ActivityCache->SetJoinTime(UserId, JoinTime);
+	}
+}
+
+FString FOnlineSubsystemAccelByteUtils::GetUserJoinTime(const FString& UserId, const FOnlineSubsystemAccelByte* Subsystem)
+{
+	FDateTime JoinTime = FDateTime::MinValue();
+	GetUserJoinTime(UserId, JoinTime, Subsystem);
+	return JoinTime.ToIso8601();
 }
 
-FString FOnlineSubsystemAccelByteUtils::GetUserJoinTime(const FString& UserId)
+bool FOnlineSubsystemAccelByteUtils::GetUserJoinTime(const FString& UserId, FDateTime& OutJoinTime, const FOnlineSubsystemAccelByte* Subsystem)
 {
-	if(UserJoinCached.Contains(UserId))
+	const TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> ActivityCache = GetPlayerActivityCache(Subsystem);
+	FAccelBytePlayerActivity Activity;
+	if (ActivityCache.IsValid() && ActivityCache->GetPlayerActivity(UserId, Activity) && Activity.JoinTime != FDateTime::MinValue())
 	{
-		return UserJoinCached[UserId];
+		OutJoinTime = Activity.JoinTime;
+		return true;
 	}
-	return FDateTime::Now().ToIso8601();
+	return false;
 }
 
-void FOnlineSubsystemAccelByteUtils::AddUserDisconnectedTime(const FString& UserId, const FString Value)
+void FOnlineSubsystemAccelByteUtils::AddUserDisconnectedTime(const FString& UserId, const FString Value, const FOnlineSubsystemAccelByte* Subsystem)
 {
-	UserDisconnectedCached.Add(UserId, Value);
+	const TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> ActivityCache = GetPlayerActivityCache(Subsystem);
+	FDateTime DisconnectedTime;
+	if (ActivityCache.IsValid() && FDateTime::ParseIso8601(*Value, DisconnectedTime))
+	{
+		ActivityCache->SetDisconnectedTime(UserId, DisconnectedTime);
+	}
 }
 
-FString FOnlineSubsystemAccelByteUtils::GetUserDisconnectedTime(const FString& UserId)
+FString FOnlineSubsystemAccelByteUtils::GetUserDisconnectedTime(const FString& UserId, const FOnlineSubsystemAccelByte* Subsystem)
 {
-	if(UserDisconnectedCached.Contains(UserId))
+	const TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> ActivityCache = GetPlayerActivityCache(Subsystem);
+	FAccelBytePlayerActivity Activity;
+	if (ActivityCache.IsValid() && ActivityCache->GetPlayerActivity(UserId, Activity) && Activity.DisconnectedTime != FDateTime::MinValue())
 	{
-		return UserDisconnectedCached[UserId];
+		return Activity.DisconnectedTime.ToIso8601();
 	}
 	return FString();
 }
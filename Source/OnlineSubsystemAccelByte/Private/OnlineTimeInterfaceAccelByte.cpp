@@ -5,11 +5,219 @@
 #include "OnlineTimeInterfaceAccelByte.h"
 #include "OnlineSubsystemUtils.h"
 #include "AsyncTasks/Time/OnlineAsyncTaskAccelByteGetServerTime.h"
+#include "Misc/ConfigCacheIni.h"
+
+FOnlineServerClockAccelByte::FOnlineServerClockAccelByte()
+	: LocalClockSource([]() { return FPlatformTime::Seconds(); })
+{
+	LoadConfig();
+}
+
+FOnlineServerClockAccelByte::FOnlineServerClockAccelByte(const FLocalClockSource& InLocalClockSource)
+	: LocalClockSource(InLocalClockSource)
+{
+	LoadConfig();
+}
+
+void FOnlineServerClockAccelByte::LoadConfig()
+{
+	if (GConfig == nullptr)
+	{
+		return;
+	}
+
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerClockMaxSamples"), MaxSamples, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerClockOutlierRttFactor"), OutlierRttFactor, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerClockMinDriftSpanSeconds"), MinDriftSpanSeconds, GEngineIni);
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerClockMaxDriftPpm"), MaxDriftPpm, GEngineIni);
+	MaxSamples = FMath::Max(MaxSamples, 1);
+	OutlierRttFactor = FMath::Max(OutlierRttFactor, 1.0);
+}
+
+bool FOnlineServerClockAccelByte::AddSample(const FDateTime& ServerTime, double RequestSentLocalSeconds, double ResponseReceivedLocalSeconds)
+{
+	const double RoundTripSeconds = ResponseReceivedLocalSeconds - RequestSentLocalSeconds;
+	if (RoundTripSeconds < 0.0 || ServerTime == FDateTime::MinValue())
+	{
+		UE_LOG_AB(Warning, TEXT("Ignoring invalid server time sample with a round trip of %.3f seconds"), RoundTripSeconds);
+		return false;
+	}
+
+	FServerClockSample Sample;
+	Sample.LocalMidpointSeconds = RequestSentLocalSeconds + (RoundTripSeconds * 0.5);
+	Sample.RoundTripSeconds = RoundTripSeconds;
+	Sample.OffsetTicks = ServerTime.GetTicks() - static_cast<int64>(Sample.LocalMidpointSeconds * ETimespan::TicksPerSecond);
+
+	FScopeLock ScopeLock(&SampleLock);
+	Samples.Add(Sample);
+	if (Samples.Num() > MaxSamples)
+	{
+		Samples.RemoveAt(0, Samples.Num() - MaxSamples, false);
+	}
+
+	RebuildModel();
+	return true;
+}
+
+void FOnlineServerClockAccelByte::RebuildModel()
+{
+	if (Samples.Num() <= 0)
+	{
+		return;
+	}
+
+	// The best sample is the one with the shortest round trip, as it leaves the least room for asymmetric delays
+	const FServerClockSample* BestSample = &Samples[0];
+	for (const FServerClockSample& Sample : Samples)
+	{
+		if (Sample.RoundTripSeconds < BestSample->RoundTripSeconds)
+		{
+			BestSample = &Sample;
+		}
+	}
+
+	const double RoundTripThreshold = (BestSample->RoundTripSeconds * OutlierRttFactor) + OutlierRttToleranceSeconds;
+	TArray<const FServerClockSample*> KeptSamples;
+	KeptSamples.Reserve(Samples.Num());
+	double EarliestMidpoint = TNumericLimits<double>::Max();
+	double LatestMidpoint = TNumericLimits<double>::Lowest();
+	for (const FServerClockSample& Sample : Samples)
+	{
+		if (Sample.RoundTripSeconds <= RoundTripThreshold)
+		{
+			KeptSamples.Add(&Sample);
+			EarliestMidpoint = FMath::Min(EarliestMidpoint, Sample.LocalMidpointSeconds);
+			LatestMidpoint = FMath::Max(LatestMidpoint, Sample.LocalMidpointSeconds);
+		}
+	}
+
+	// Without enough history to see drift, just trust the best sample
+	if (KeptSamples.Num() < 3 || (LatestMidpoint - EarliestMidpoint) < MinDriftSpanSeconds)
+	{
+		PublishModel(BestSample->LocalMidpointSeconds, BestSample->OffsetTicks, 0.0);
+		return;
+	}
+
+	// Fit a line through the offsets of the kept samples with least squares. Offsets are taken relative to the best
+	// sample so that the sums stay small enough for doubles to hold sub-microsecond precision.
+	double MeanMidpoint = 0.0;
+	double MeanOffsetSeconds = 0.0;
+	for (const FServerClockSample* Sample : KeptSamples)
+	{
+		MeanMidpoint += Sample->LocalMidpointSeconds;
+		MeanOffsetSeconds += static_cast<double>(Sample->OffsetTicks - BestSample->OffsetTicks) / ETimespan::TicksPerSecond;
+	}
+	MeanMidpoint /= KeptSamples.Num();
+	MeanOffsetSeconds /= KeptSamples.Num();
+
+	double Covariance = 0.0;
+	double Variance = 0.0;
+	for (const FServerClockSample* Sample : KeptSamples)
+	{
+		const double MidpointDelta = Sample->LocalMidpointSeconds - MeanMidpoint;
+		const double OffsetDelta = (static_cast<double>(Sample->OffsetTicks - BestSample->OffsetTicks) / ETimespan::TicksPerSecond) - MeanOffsetSeconds;
+		Covariance += MidpointDelta * OffsetDelta;
+		Variance += MidpointDelta * MidpointDelta;
+	}
+
+	const double MaxDriftRate = MaxDriftPpm / 1000000.0;
+	const double DriftRate = FMath::Clamp(Variance > 0.0 ? Covariance / Variance : 0.0, -MaxDriftRate, MaxDriftRate);
+	const int64 MeanOffsetTicks = BestSample->OffsetTicks + static_cast<int64>(MeanOffsetSeconds * ETimespan::TicksPerSecond);
+	PublishModel(MeanMidpoint, MeanOffsetTicks, DriftRate);
+}
+
+void FOnlineServerClockAccelByte::PublishModel(double ReferenceLocalSeconds, int64 ReferenceOffsetTicks, double DriftRate)
+{
+	// Sequence lock, readers retry if the sequence is odd or has changed by the time they finish reading
+	const uint32 Sequence = ModelSequence.load(std::memory_order_relaxed);
+	ModelSequence.store(Sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	ModelReferenceLocalSeconds.store(ReferenceLocalSeconds, std::memory_order_relaxed);
+	ModelReferenceOffsetTicks.store(ReferenceOffsetTicks, std::memory_order_relaxed);
+	ModelDriftRate.store(DriftRate, std::memory_order_relaxed);
+
+	ModelSequence.store(Sequence + 2, std::memory_order_release);
+	bHasModel.store(true, std::memory_order_release);
+}
+
+bool FOnlineServerClockAccelByte::IsSynced() const
+{
+	return bHasModel.load(std::memory_order_acquire);
+}
+
+int64 FOnlineServerClockAccelByte::GetServerUtcNowTicks() const
+{
+	if (!IsSynced())
+	{
+		return FDateTime::MinValue().GetTicks();
+	}
+
+	double ReferenceLocalSeconds = 0.0;
+	int64 ReferenceOffsetTicks = 0;
+	double DriftRate = 0.0;
+	uint32 SequenceBefore = 0;
+	uint32 SequenceAfter = 0;
+	do
+	{
+		SequenceBefore = ModelSequence.load(std::memory_order_acquire);
+		ReferenceLocalSeconds = ModelReferenceLocalSeconds.load(std::memory_order_relaxed);
+		ReferenceOffsetTicks = ModelReferenceOffsetTicks.load(std::memory_order_relaxed);
+		DriftRate = ModelDriftRate.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		SequenceAfter = ModelSequence.load(std::memory_order_relaxed);
+	} while ((SequenceBefore & 1) != 0 || SequenceBefore != SequenceAfter);
+
+	const double LocalSeconds = GetLocalSeconds();
+	const int64 EstimatedTicks = static_cast<int64>(LocalSeconds * ETimespan::TicksPerSecond)
+		+ ReferenceOffsetTicks
+		+ static_cast<int64>(DriftRate * (LocalSeconds - ReferenceLocalSeconds) * ETimespan::TicksPerSecond);
+
+	// Never hand out a time earlier than one we have already returned. If a new sample moved the estimate back, the
+	// returned time holds still until the estimate catches up rather than stepping backwards.
+	int64 LastTicks = LastReturnedTicks.load(std::memory_order_relaxed);
+	while (EstimatedTicks > LastTicks && !LastReturnedTicks.compare_exchange_weak(LastTicks, EstimatedTicks, std::memory_order_relaxed))
+	{
+	}
+
+	return FMath::Max(EstimatedTicks, LastTicks);
+}
+
+FDateTime FOnlineServerClockAccelByte::GetServerUtcNow() const
+{
+	return FDateTime(GetServerUtcNowTicks());
+}
+
+double FOnlineServerClockAccelByte::GetLocalSeconds() const
+{
+	return LocalClockSource();
+}
+
+double FOnlineServerClockAccelByte::GetDriftRate() const
+{
+	return ModelDriftRate.load(std::memory_order_relaxed);
+}
+
+int32 FOnlineServerClockAccelByte::GetSampleCount() const
+{
+	FScopeLock ScopeLock(&SampleLock);
+	return Samples.Num();
+}
+
+void FOnlineServerClockAccelByte::Reset()
+{
+	FScopeLock ScopeLock(&SampleLock);
+	Samples.Empty();
+	bHasModel.store(false, std::memory_order_release);
+	LastReturnedTicks.store(0, std::memory_order_relaxed);
+}
 
 FOnlineTimeAccelByte::FOnlineTimeAccelByte(FOnlineSubsystemAccelByte* InSubsystem) 
 	: AccelByteSubsystem(InSubsystem)
 	, ServerTimestamp(-1)
 {
+	GConfig->GetFloat(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerClockResyncIntervalSeconds"), ResyncIntervalSeconds, GEngineIni);
+	GConfig->GetInt(TEXT("OnlineSubsystemAccelByte"), TEXT("ServerClockSamplesPerResync"), SamplesPerResync, GEngineIni);
 }
 
 void FOnlineTimeAccelByte::UpdateServerTime(const FDateTime& Time)
@@ -19,6 +227,43 @@ void FOnlineTimeAccelByte::UpdateServerTime(const FDateTime& Time)
 	LastServerTime = Time;
 }
 
+void FOnlineTimeAccelByte::UpdateServerTime(const FDateTime& Time, double RequestSentLocalSeconds, double ResponseReceivedLocalSeconds)
+{
+	UpdateServerTime(Time);
+	ServerClock.AddSample(Time, RequestSentLocalSeconds, ResponseReceivedLocalSeconds);
+}
+
+void FOnlineTimeAccelByte::OnResyncSampleComplete()
+{
+	bIsResyncSampleInFlight = false;
+}
+
+void FOnlineTimeAccelByte::Tick(float DeltaTime)
+{
+	if (!bIsBackgroundResyncEnabled)
+	{
+		return;
+	}
+
+	if (ResyncIntervalSeconds > 0.0f)
+	{
+		TimeSinceLastResyncSeconds += DeltaTime;
+		if (TimeSinceLastResyncSeconds >= ResyncIntervalSeconds)
+		{
+			TimeSinceLastResyncSeconds = 0.0f;
+			RemainingResyncSamples = SamplesPerResync;
+		}
+	}
+
+	// Take samples one after the other rather than all at once, so they don't queue behind each other and skew the round trip
+	if (RemainingResyncSamples > 0 && !bIsResyncSampleInFlight)
+	{
+		RemainingResyncSamples--;
+		bIsResyncSampleInFlight = true;
+		AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteGetServerTime>(AccelByteSubsystem, true);
+	}
+}
+
 bool FOnlineTimeAccelByte::GetFromSubsystem(const IOnlineSubsystem* Subsystem, FOnlineTimeAccelBytePtr& OutInterfaceInstance)
 {
 	OutInterfaceInstance = StaticCastSharedPtr<FOnlineTimeAccelByte>(Subsystem->GetTimeInterface());
@@ -40,6 +285,15 @@ bool FOnlineTimeAccelByte::GetFromWorld(const UWorld* World, FOnlineTimeAccelByt
 bool FOnlineTimeAccelByte::QueryServerUtcTime()
 {
 	AccelByteSubsystem->CreateAndDispatchAsyncTaskParallel<FOnlineAsyncTaskAccelByteGetServerTime>(AccelByteSubsystem);
+
+	// A single sample can be skewed by an asymmetric round trip, so follow up with a few background samples to settle
+	// the server clock, and keep it in sync from then on
+	if (!bIsBackgroundResyncEnabled)
+	{
+		bIsBackgroundResyncEnabled = true;
+		TimeSinceLastResyncSeconds = 0.0f;
+		RemainingResyncSamples = FMath::Max(SamplesPerResync - 1, 0);
+	}
 	return true;
 }
 
@@ -56,6 +310,11 @@ FString FOnlineTimeAccelByte::GetLastServerUtcTime()
 
 FString FOnlineTimeAccelByte::GetBackCalculatedServerTime()
 {
+	if (ServerClock.IsSynced())
+	{
+		return ServerClock.GetServerUtcNow().ToString();
+	}
+
 	if (ServerTimestamp < 0)
 	{
 		return FDateTime::MinValue().ToString();
@@ -67,3 +326,23 @@ FString FOnlineTimeAccelByte::GetBackCalculatedServerTime()
 	FDateTime BackCalculated = LastServerTime + Timespan;
 	return BackCalculated.ToString();
 }
+
+FDateTime FOnlineTimeAccelByte::GetServerUtcNow() const
+{
+	return ServerClock.GetServerUtcNow();
+}
+
+int64 FOnlineTimeAccelByte::GetServerUtcNowTicks() const
+{
+	return ServerClock.GetServerUtcNowTicks();
+}
+
+bool FOnlineTimeAccelByte::IsServerClockSynced() const
+{
+	return ServerClock.IsSynced();
+}
+
+const FOnlineServerClockAccelByte& FOnlineTimeAccelByte::GetServerClock() const
+{
+	return ServerClock;
+}
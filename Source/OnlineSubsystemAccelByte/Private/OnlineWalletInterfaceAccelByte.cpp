@@ -11,6 +11,24 @@
 #include "AsyncTasks/Wallet/OnlineAsyncTaskAccelByteGetWalletTransactions.h"
 #include "OnlineSubsystemUtils.h"
 #include "Engine/World.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+FOnlineWalletAccelByte::FOnlineWalletAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
+	: AccelByteSubsystem(InSubsystem)
+{
+	double RefreshDebounceSeconds = 1.0;
+	GConfig->GetDouble(TEXT("OnlineSubsystemAccelByte"), TEXT("EcommerceCacheRefreshDebounceSeconds"), RefreshDebounceSeconds, GEngineIni);
+	RefreshDebouncer.SetWindowSeconds(RefreshDebounceSeconds);
+
+	GConfig->GetArray(TEXT("OnlineSubsystemAccelByte"), TEXT("WalletNotificationTopics"), WalletNotificationTopics, GEngineIni);
+	if (WalletNotificationTopics.Num() == 0)
+	{
+		WalletNotificationTopics.Add(TEXT("WALLET_UPDATED"));
+	}
+}
 
 bool FOnlineWalletAccelByte::GetFromWorld(const UWorld* World, FOnlineWalletAccelBytePtr& OutInterfaceInstance)
 {
@@ -157,13 +175,22 @@ bool FOnlineWalletAccelByte::GetWalletInfoByCurrencyCode(int32 LocalUserNum, con
 bool FOnlineWalletAccelByte::GetWalletInfoFromCache(int32 LocalUserNum, const FString& CurrencyCode, FAccelByteModelsWalletInfo& OutWalletInfo)
 {
 	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
-	if (IdentityInterface.IsValid())
+	const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(LocalUserNum) : nullptr;
+	if (UserIdPtr.IsValid())
 	{
 		FScopeLock ScopeLock(&WalletInfoListLock);
-		TMap<FString, TSharedRef<FAccelByteModelsWalletInfo>> CurrencyToWalletInfoMap = UserToWalletInfoMap.FindRef(IdentityInterface->GetUniquePlayerId(LocalUserNum)->AsShared());
-		if (CurrencyToWalletInfoMap.Num() > 0)
+
+		// A stale wallet may no longer match the backend, such as after a checkout spent from it
+		const TSet<FString>* StaleWallets = UserToStaleWalletMap.Find(UserIdPtr.ToSharedRef());
+		if (StaleWallets != nullptr && StaleWallets->Contains(CurrencyCode))
 		{
-			TSharedRef<FAccelByteModelsWalletInfo>* WalletInfo = CurrencyToWalletInfoMap.Find(CurrencyCode);
+			return false;
+		}
+
+		const TMap<FString, TSharedRef<FAccelByteModelsWalletInfo>>* CurrencyToWalletInfoMap = UserToWalletInfoMap.Find(UserIdPtr.ToSharedRef());
+		if (CurrencyToWalletInfoMap != nullptr)
+		{
+			const TSharedRef<FAccelByteModelsWalletInfo>* WalletInfo = CurrencyToWalletInfoMap->Find(CurrencyCode);
 			if (WalletInfo != nullptr)
 			{
 				OutWalletInfo = WalletInfo->Get();
@@ -190,9 +217,190 @@ void FOnlineWalletAccelByte::AddWalletInfoToList(int32 LocalUserNum, const FStri
 				auto CurrencyCodeToWalletInfo = UserToWalletInfoMap.FindRef(UserIdPtr.ToSharedRef());
 				CurrencyCodeToWalletInfo.Emplace(CurrencyCode, InWalletInfo);
 				UserToWalletInfoMap.Emplace(UserIdPtr.ToSharedRef(), CurrencyCodeToWalletInfo);
+
+				UserToWalletLastUpdatedMap.FindOrAdd(UserIdPtr.ToSharedRef()).Emplace(CurrencyCode, FDateTime::UtcNow());
+				if (TSet<FString>* StaleWallets = UserToStaleWalletMap.Find(UserIdPtr.ToSharedRef()))
+				{
+					StaleWallets->Remove(CurrencyCode);
+				}
+			}
+		}
+	}
+}
+
+FDateTime FOnlineWalletAccelByte::GetWalletLastUpdatedTime(int32 LocalUserNum, const FString& CurrencyCode) const
+{
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+	{
+		return FDateTime::MinValue();
+	}
+
+	const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface->GetUniquePlayerId(LocalUserNum);
+	if (!UserIdPtr.IsValid())
+	{
+		return FDateTime::MinValue();
+	}
+
+	FScopeLock ScopeLock(&WalletInfoListLock);
+	const TMap<FString, FDateTime>* LastUpdatedTimes = UserToWalletLastUpdatedMap.Find(UserIdPtr.ToSharedRef());
+	if (LastUpdatedTimes == nullptr)
+	{
+		return FDateTime::MinValue();
+	}
+
+	const FDateTime* LastUpdatedTime = LastUpdatedTimes->Find(CurrencyCode);
+	return LastUpdatedTime != nullptr ? *LastUpdatedTime : FDateTime::MinValue();
+}
+
+void FOnlineWalletAccelByte::InvalidateWalletInfo(int32 LocalUserNum, const FString& CurrencyCode)
+{
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+	{
+		return;
+	}
+
+	const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface->GetUniquePlayerId(LocalUserNum);
+	if (!UserIdPtr.IsValid())
+	{
+		return;
+	}
+
+	{
+		FScopeLock ScopeLock(&WalletInfoListLock);
+		const TMap<FString, TSharedRef<FAccelByteModelsWalletInfo>>* CurrencyCodeToWalletInfo = UserToWalletInfoMap.Find(UserIdPtr.ToSharedRef());
+		if (CurrencyCodeToWalletInfo == nullptr || !CurrencyCodeToWalletInfo->Contains(CurrencyCode))
+		{
+			return;
+		}
+
+		UserToStaleWalletMap.FindOrAdd(UserIdPtr.ToSharedRef()).Add(CurrencyCode);
+	}
+
+	UE_LOG_AB(Verbose, TEXT("Invalidated cached wallet '%s' for user index '%d'"), *CurrencyCode, LocalUserNum);
+	RefreshDebouncer.Schedule(LocalUserNum, CurrencyCode, FPlatformTime::Seconds());
+}
+
+void FOnlineWalletAccelByte::InvalidateWalletInfoByWalletId(int32 LocalUserNum, const FString& WalletId)
+{
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+	{
+		return;
+	}
+
+	const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface->GetUniquePlayerId(LocalUserNum);
+	if (!UserIdPtr.IsValid())
+	{
+		return;
+	}
+
+	FString CurrencyCode;
+	{
+		FScopeLock ScopeLock(&WalletInfoListLock);
+		const TMap<FString, TSharedRef<FAccelByteModelsWalletInfo>>* CurrencyCodeToWalletInfo = UserToWalletInfoMap.Find(UserIdPtr.ToSharedRef());
+		if (CurrencyCodeToWalletInfo == nullptr)
+		{
+			return;
+		}
+
+		for (const TPair<FString, TSharedRef<FAccelByteModelsWalletInfo>>& Pair : *CurrencyCodeToWalletInfo)
+		{
+			if (Pair.Value->Id == WalletId)
+			{
+				CurrencyCode = Pair.Key;
+				break;
 			}
 		}
 	}
+
+	if (!CurrencyCode.IsEmpty())
+	{
+		InvalidateWalletInfo(LocalUserNum, CurrencyCode);
+	}
+}
+
+bool FOnlineWalletAccelByte::IsWalletInfoStale(int32 LocalUserNum, const FString& CurrencyCode) const
+{
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	if (!IdentityInterface.IsValid())
+	{
+		return false;
+	}
+
+	const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface->GetUniquePlayerId(LocalUserNum);
+	if (!UserIdPtr.IsValid())
+	{
+		return false;
+	}
+
+	FScopeLock ScopeLock(&WalletInfoListLock);
+	const TSet<FString>* StaleWallets = UserToStaleWalletMap.Find(UserIdPtr.ToSharedRef());
+	return StaleWallets != nullptr && StaleWallets->Contains(CurrencyCode);
+}
+
+bool FOnlineWalletAccelByte::OnNotificationReceived(int32 LocalUserNum, const FString& Topic, const FString& Payload)
+{
+	if (!WalletNotificationTopics.Contains(Topic))
+	{
+		return false;
+	}
+
+	FString CurrencyCode;
+	TSharedPtr<FJsonObject> PayloadObject;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Payload);
+	if (FJsonSerializer::Deserialize(JsonReader, PayloadObject) && PayloadObject.IsValid())
+	{
+		PayloadObject->TryGetStringField(TEXT("currencyCode"), CurrencyCode);
+	}
+
+	if (!CurrencyCode.IsEmpty())
+	{
+		InvalidateWalletInfo(LocalUserNum, CurrencyCode);
+		return true;
+	}
+
+	// No currency in the payload, so we cannot tell which wallet changed and have to refresh all of them
+	const IOnlineIdentityPtr IdentityInterface = AccelByteSubsystem->GetIdentityInterface();
+	const TSharedPtr<const FUniqueNetId> UserIdPtr = IdentityInterface.IsValid() ? IdentityInterface->GetUniquePlayerId(LocalUserNum) : nullptr;
+	if (!UserIdPtr.IsValid())
+	{
+		return true;
+	}
+
+	TArray<FString> CachedCurrencyCodes;
+	{
+		FScopeLock ScopeLock(&WalletInfoListLock);
+		if (const TMap<FString, TSharedRef<FAccelByteModelsWalletInfo>>* CurrencyCodeToWalletInfo = UserToWalletInfoMap.Find(UserIdPtr.ToSharedRef()))
+		{
+			CurrencyCodeToWalletInfo->GenerateKeyArray(CachedCurrencyCodes);
+		}
+	}
+
+	for (const FString& CachedCurrencyCode : CachedCurrencyCodes)
+	{
+		InvalidateWalletInfo(LocalUserNum, CachedCurrencyCode);
+	}
+	return true;
+}
+
+void FOnlineWalletAccelByte::Tick(float DeltaTime)
+{
+	TMap<int32, TSet<FString>> Refreshes;
+	if (!RefreshDebouncer.Flush(FPlatformTime::Seconds(), Refreshes))
+	{
+		return;
+	}
+
+	for (const TPair<int32, TSet<FString>>& Refresh : Refreshes)
+	{
+		for (const FString& CurrencyCode : Refresh.Value)
+		{
+			UE_LOG_AB(Verbose, TEXT("Refreshing invalidated wallet '%s' for user index '%d'"), *CurrencyCode, Refresh.Key);
+			GetWalletInfoByCurrencyCode(Refresh.Key, CurrencyCode, true);
+		}
+	}
 }
 
 bool FOnlineWalletAccelByte::ListWalletTransactionsByCurrencyCode(int32 LocalUserNum, const FString& CurrencyCode, int32 Offset, int32 Limit)
@@ -54,6 +54,27 @@ public:
 		((FNboSerializeToBuffer&)Ar) << UniqueId.UniqueNetIdStr;
 		return Ar;
 	}
+
+	/**
+	 * Write a user ID as its AccelByte ID and platform fields, rather than as the Base64 encoded composite string,
+	 * which is roughly twice the size. Read back with FNboSerializeFromBufferAccelByte::ReadCompactUserId.
+	 */
+	FNboSerializeToBufferAccelByte& WriteCompactUserId(const FUniqueNetIdAccelByteUser& UniqueId)
+	{
+		((FNboSerializeToBuffer&)*this) << UniqueId.GetAccelByteId()
+			<< UniqueId.GetPlatformType()
+			<< UniqueId.GetPlatformId();
+		return *this;
+	}
+
+	/**
+	 * Append bytes that were already encoded by another buffer, such as a cached block of session settings.
+	 */
+	FNboSerializeToBufferAccelByte& WriteEncodedBytes(const TArray<uint8>& EncodedBytes)
+	{
+		WriteBinary(EncodedBytes.GetData(), EncodedBytes.Num());
+		return *this;
+	}
 };
 
 class FNboSerializeFromBufferAccelByte 
@@ -76,8 +97,11 @@ public:
 	friend inline FNboSerializeFromBufferAccelByte& operator>>(FNboSerializeFromBufferAccelByte& Ar, FOnlineSessionInfoAccelByteV1& SessionInfo)
 	{
 		check(SessionInfo.GetHostAddr().IsValid());
-		TSharedRef<FUniqueNetIdAccelByteResource> Session = ConstCastSharedRef<FUniqueNetIdAccelByteResource>(SessionInfo.GetSessionIdRef());
-		Ar >> *Session;
+
+		// Read into a new ID rather than the existing one, as a default constructed session info shares the invalid ID
+		FString SessionId;
+		Ar >> SessionId;
+		SessionInfo.SetSessionId(SessionId);
 		Ar >> *SessionInfo.GetHostAddr();
 		return Ar;
 	}
@@ -93,4 +117,16 @@ public:
 		Ar >> UniqueId.UniqueNetIdStr;
 		return Ar;
 	}
+
+	/**
+	 * Read a user ID written by FNboSerializeToBufferAccelByte::WriteCompactUserId.
+	 */
+	FUniqueNetIdAccelByteUserRef ReadCompactUserId()
+	{
+		FAccelByteUniqueIdComposite CompositeId;
+		*this >> CompositeId.Id
+			>> CompositeId.PlatformType
+			>> CompositeId.PlatformId;
+		return FUniqueNetIdAccelByteUser::Create(CompositeId);
+	}
 };
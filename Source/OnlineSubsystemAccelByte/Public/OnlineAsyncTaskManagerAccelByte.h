@@ -5,9 +5,61 @@
 #pragma once
 
 #include "OnlineAsyncTaskManager.h"
+#include <atomic>
 
 class FOnlineSubsystemAccelByte;
 
+/**
+ * @brief Timeout state of a single async task, shared between the task and the manager's timer wheel.
+ *
+ * The task owns the deadline and pushes it back whenever it makes progress, while the timer wheel raises the timed out
+ * flag once the deadline has passed. As both sides only hold a shared reference, a task can be destroyed while its
+ * timeout is still in the wheel, in which case the wheel drops it the next time it is visited.
+ */
+struct FAccelByteAsyncTaskTimeout
+{
+public:
+
+	/**
+	 * @brief Platform time in seconds that the task times out at, pushed back each time the task makes progress
+	 */
+	std::atomic<double> DeadlineInSeconds{0.0};
+
+	/**
+	 * @brief Set by the timer wheel once the deadline has passed, and cleared by the task once it has handled it
+	 */
+	std::atomic<bool> bHasTimedOut{false};
+
+	/**
+	 * @brief Cleared once the task has completed or been destroyed, so that the timer wheel stops tracking it
+	 */
+	std::atomic<bool> bIsActive{true};
+
+	/**
+	 * @brief Length of the task's timeout in seconds, used to re-arm the timeout of tasks that are not completed by it
+	 */
+	double TimeoutInSeconds{30.0};
+
+	/**
+	 * @brief Whether the task is completed once it times out. Otherwise the timeout is re-armed, so that the task is
+	 * flagged once per timeout period for as long as it runs.
+	 */
+	bool bCompleteOnTimeout{true};
+
+};
+
+typedef TSharedRef<FAccelByteAsyncTaskTimeout, ESPMode::ThreadSafe> FAccelByteAsyncTaskTimeoutRef;
+
+/**
+ * Async task manager for the AccelByte OSS.
+ *
+ * Rather than each task checking its own timeout on every tick, task timeouts are tracked in a single hashed timer wheel
+ * that is advanced once per online tick, so the cost of timeouts no longer grows with the amount of tasks in flight. Tasks
+ * also wake the online thread as soon as they are completed from another thread, so that their delegates are not held
+ * back until the next poll. As completions wake the thread, the poll interval can be raised with
+ * `AsyncTaskPollingIntervalMs` in the `OnlineSubsystemAccelByte` section of `DefaultEngine.ini` to cut idle CPU usage,
+ * as long as no task relies on being ticked to make progress.
+ */
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineAsyncTaskManagerAccelByte : public FOnlineAsyncTaskManager
 {
 public:
@@ -17,12 +69,58 @@ public:
 
 	virtual ~FOnlineAsyncTaskManagerAccelByte() = default;
 
+	/**
+	 * Samples the depth of our task queues into the subsystem's async task metrics, if they are enabled.
+	 */
 	void OnlineTick() override;
 
 	void CheckMaxParallelTasks();
 
+	/**
+	 * Start tracking the timeout of a task in the timer wheel. The task should push back the deadline on the timeout state
+	 * each time it makes progress, and clear its active flag once it has completed.
+	 */
+	void RegisterTaskTimeout(const FAccelByteAsyncTaskTimeoutRef& Timeout);
+
+	/**
+	 * Wake the online thread so that it ticks immediately, such as when a task has been completed from another thread.
+	 * Does nothing when called from the online thread, as it will already pick up the change at the end of its tick.
+	 */
+	void WakeOnlineThread();
+
 private:
 
+	/**
+	 * Flag every timeout in the timer wheel that has passed its deadline, and move any timeout that has been pushed back to
+	 * the slot for its new deadline.
+	 */
+	void AdvanceTimerWheel(double CurrentTimeInSeconds);
+
+	/**
+	 * Add a timeout to the slot of the timer wheel for its deadline. Must be called with the timer wheel lock held.
+	 */
+	void ScheduleTimeout(const FAccelByteAsyncTaskTimeoutRef& Timeout);
+
+	/**
+	 * Get the tick of the timer wheel that the given platform time falls into.
+	 */
+	int64 GetTimerWheelTick(double TimeInSeconds) const;
+
+	/** Amount of slots in the timer wheel, one revolution covering the default task timeout */
+	static constexpr int32 NumTimerWheelSlots = 256;
+
+	/** Length of time in seconds covered by each slot of the timer wheel */
+	static constexpr double TimerWheelResolutionSeconds = 0.5;
+
+	/** Slots of the timer wheel, each holding the timeouts with a deadline that falls into that slot's ticks */
+	TArray<TArray<FAccelByteAsyncTaskTimeoutRef>> TimerWheelSlots;
+
+	/** Last tick of the timer wheel that has been processed */
+	int64 LastTimerWheelTick = 0;
+
+	/** Mutex used to lock the timer wheel, as tasks register their timeouts from the game thread */
+	FCriticalSection TimerWheelLock;
+
 	/** Pointer to subsystem instance that constructed this manager */
 	FOnlineSubsystemAccelByte* AccelByteSubsystem;
 
@@ -0,0 +1,291 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+
+class FOnlineSubsystemAccelByte;
+
+/**
+ * @brief Histogram of latencies recorded for a single stage of an async task, in milliseconds.
+ *
+ * Samples are counted into fixed buckets rather than stored, so recording is constant time and percentiles are
+ * approximated by the upper bound of the bucket they fall into.
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelByteAsyncTaskLatencyHistogram
+{
+public:
+
+	/**
+	 * @brief Amount of buckets in the histogram, the last bucket holding any sample over the largest bucket bound
+	 */
+	static constexpr int32 NumBuckets = 16;
+
+	/**
+	 * @brief Upper bound in milliseconds of each bucket in the histogram, other than the overflow bucket
+	 */
+	static const double BucketUpperBoundsMs[NumBuckets - 1];
+
+	/**
+	 * @brief Amount of samples recorded into each bucket
+	 */
+	uint32 BucketCounts[NumBuckets] = {};
+
+	/**
+	 * @brief Total amount of samples recorded
+	 */
+	uint32 Count{0};
+
+	/**
+	 * @brief Sum of every sample recorded, in milliseconds
+	 */
+	double TotalMs{0.0};
+
+	/**
+	 * @brief Largest sample recorded, in milliseconds
+	 */
+	double MaxMs{0.0};
+
+	/**
+	 * @brief Record a single sample into the histogram.
+	 */
+	void AddSample(double SampleMs);
+
+	/**
+	 * @brief Get the mean of every sample recorded, or zero if nothing has been recorded.
+	 */
+	double GetMeanMs() const;
+
+	/**
+	 * @brief Get an approximation of the given percentile, as the upper bound of the bucket that it falls into. Samples
+	 * in the overflow bucket are reported as the largest sample recorded.
+	 *
+	 * @param Percentile Percentile to get, between 0 and 1
+	 */
+	double GetPercentileMs(double Percentile) const;
+
+};
+
+/**
+ * @brief Counters and latencies recorded for every async task of a single class, keyed by task name.
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelByteAsyncTaskClassMetrics
+{
+public:
+
+	/**
+	 * @brief Name of the task class these metrics were recorded for
+	 */
+	FString TaskName{};
+
+	/**
+	 * @brief Amount of tasks that have been picked up from the queue and initialized
+	 */
+	uint32 Started{0};
+
+	/**
+	 * @brief Amount of tasks that have completed successfully
+	 */
+	uint32 Succeeded{0};
+
+	/**
+	 * @brief Amount of tasks that have completed unsuccessfully, other than through a timeout
+	 */
+	uint32 Failed{0};
+
+	/**
+	 * @brief Amount of tasks that were completed by hitting their timeout
+	 */
+	uint32 TimedOut{0};
+
+	/**
+	 * @brief Time between a task being created and it being initialized
+	 */
+	FAccelByteAsyncTaskLatencyHistogram QueueWait{};
+
+	/**
+	 * @brief Time between a task being initialized and it being completed
+	 */
+	FAccelByteAsyncTaskLatencyHistogram Execution{};
+
+	/**
+	 * @brief Time between a task being completed and its delegates having been triggered on the game thread
+	 */
+	FAccelByteAsyncTaskLatencyHistogram TimeToDelegates{};
+
+	/**
+	 * @brief Get the amount of tasks that have started but not completed yet.
+	 */
+	uint32 GetInFlight() const
+	{
+		const uint32 Completed = Succeeded + Failed + TimedOut;
+		return (Started > Completed) ? Started - Completed : 0;
+	}
+
+};
+
+/**
+ * @brief Copy of every async task metric recorded, taken at a single point in time.
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelByteAsyncTaskMetricsSnapshot
+{
+public:
+
+	/**
+	 * @brief Seconds that metrics had been recorded for when this snapshot was taken
+	 */
+	double RecordedSeconds{0.0};
+
+	/**
+	 * @brief Amount of serial tasks waiting in the manager's queue when last sampled
+	 */
+	int32 QueuedSerialTasks{0};
+
+	/**
+	 * @brief Largest amount of serial tasks seen waiting in the manager's queue
+	 */
+	int32 PeakQueuedSerialTasks{0};
+
+	/**
+	 * @brief Amount of tasks running in parallel when last sampled
+	 */
+	int32 ParallelTasks{0};
+
+	/**
+	 * @brief Largest amount of tasks seen running in parallel
+	 */
+	int32 PeakParallelTasks{0};
+
+	/**
+	 * @brief Metrics for each task class that has been recorded, ordered by total execution time, longest first
+	 */
+	TArray<FAccelByteAsyncTaskClassMetrics> TaskClasses;
+
+};
+
+/**
+ * Records per task class counters and latency histograms for async tasks run by the AccelByte OSS, so that a backend
+ * slowdown can be narrowed down to the task types that are queueing, running long or timing out.
+ *
+ * Each async task records when it is initialized, when it completes and when its delegates have been triggered, and the
+ * async task manager samples the depth of its queues on each online tick. Recording is disabled by default, in which case
+ * each task only pays for a single flag check. Set `bEnableAsyncTaskMetrics` in the `OnlineSubsystemAccelByte` section
+ * of `DefaultEngine.ini` to enable it on startup, or toggle it at runtime with the console command:
+ * ONLINE ASYNCTASK METRICS [ENABLE|DISABLE|RESET]
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineAsyncTaskMetricsAccelByte : public TSharedFromThis<FOnlineAsyncTaskMetricsAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Whether metrics are currently being recorded.
+	 */
+	bool IsEnabled() const
+	{
+		return bIsEnabled;
+	}
+
+	/**
+	 * Start or stop recording metrics. Metrics recorded so far are kept until Reset is called.
+	 */
+	void SetEnabled(bool bInIsEnabled);
+
+	/**
+	 * Take a copy of every metric recorded so far.
+	 */
+	FAccelByteAsyncTaskMetricsSnapshot GetSnapshot() const;
+
+	/**
+	 * Discard every metric recorded so far.
+	 */
+	void Reset();
+
+	/**
+	 * Write a table of every metric recorded so far to the output device given, such as the console.
+	 */
+	void Dump(FOutputDevice& Ar) const;
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the async task metrics, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlineAsyncTaskMetricsAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Record that a task has been initialized, after waiting in a queue for the time given.
+	 */
+	void RecordTaskStarted(const FString& TaskName, double QueueWaitSeconds);
+
+	/**
+	 * Record that a task has completed, after executing for the time given.
+	 */
+	void RecordTaskCompleted(const FString& TaskName, double ExecutionSeconds, bool bWasSuccessful, bool bTimedOut);
+
+	/**
+	 * Record that the delegates of a completed task have been triggered, the time given after the task completed.
+	 */
+	void RecordTaskDelegatesTriggered(const FString& TaskName, double TimeToDelegatesSeconds);
+
+	/**
+	 * Record the current depth of the async task manager's queues.
+	 */
+	void RecordQueueDepths(int32 InQueuedSerialTasks, int32 InParallelTasks);
+
+private:
+
+	/**
+	 * Mutex used to lock the metrics while we record to or read from them
+	 */
+	mutable FCriticalSection MetricsLock;
+
+	/**
+	 * Metrics for each task class, keyed by task name
+	 */
+	TMap<FString, FAccelByteAsyncTaskClassMetrics> TaskNameToMetrics;
+
+	/**
+	 * Amount of serial tasks waiting in the manager's queue when last sampled
+	 */
+	int32 QueuedSerialTasks = 0;
+
+	/**
+	 * Largest amount of serial tasks seen waiting in the manager's queue
+	 */
+	int32 PeakQueuedSerialTasks = 0;
+
+	/**
+	 * Amount of tasks running in parallel when last sampled
+	 */
+	int32 ParallelTasks = 0;
+
+	/**
+	 * Largest amount of tasks seen running in parallel
+	 */
+	int32 PeakParallelTasks = 0;
+
+	/**
+	 * Platform time in seconds that metrics started being recorded at, or were last reset at
+	 */
+	double RecordingStartTimeInSeconds = 0.0;
+
+	/**
+	 * Whether metrics are currently being recorded
+	 */
+	FThreadSafeBool bIsEnabled = false;
+
+	/**
+	 * Get the metrics for a task class, creating them if needed. Must be called with the metrics lock held.
+	 */
+	FAccelByteAsyncTaskClassMetrics& FindOrAddTaskMetrics(const FString& TaskName);
+
+	/**
+	 * AccelByte online subsystem instance that owns these metrics.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
@@ -0,0 +1,432 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+#include "OnlineDelegateMacros.h"
+#include "Models/AccelByteMatchmakingModels.h"
+
+class FOnlineSubsystemAccelByte;
+class FOnlineSession;
+
+/**
+ * Decision made on a backfill proposal, either by the game's policy or by the default policy.
+ */
+enum class EAccelByteBackfillDecision : uint8
+{
+	/** Accept the proposal and keep backfilling */
+	Accept,
+	/** Accept the proposal and tell matchmaking to stop backfilling, such as when it fills the session */
+	AcceptAndStopBackfilling,
+	/** Reject the proposal and keep backfilling */
+	Reject,
+	/** Reject the proposal and tell matchmaking to stop backfilling */
+	RejectAndStopBackfilling,
+	/** Leave the proposal to the game, firing OnBackfillProposalReceived on the session interface for it. The players in the
+	 * proposal hold their slots until the game accepts or rejects it, or until the reservation times out. */
+	Defer
+};
+
+/**
+ * @brief Slot capacity of a single team in a session, as seen when a backfill proposal is evaluated.
+ */
+struct FAccelByteBackfillTeamCapacity
+{
+public:
+
+	/**
+	 * @brief Index of the team in the proposed team layout
+	 */
+	int32 TeamIndex{INDEX_NONE};
+
+	/**
+	 * @brief Most players this team may have
+	 */
+	int32 MaxPlayers{0};
+
+	/**
+	 * @brief Players already in this team, either joined or reserved by an earlier accepted proposal
+	 */
+	int32 CurrentPlayers{0};
+
+	/**
+	 * @brief Players the proposal would add to this team
+	 */
+	int32 ProposedNewPlayers{0};
+
+	/**
+	 * @brief Get the slots left in this team before the proposal is applied
+	 */
+	int32 GetOpenSlots() const
+	{
+		return FMath::Max(MaxPlayers - CurrentPlayers, 0);
+	}
+
+};
+
+/**
+ * @brief Everything a backfill policy gets to decide on a proposal with.
+ */
+struct FAccelByteBackfillProposalContext
+{
+public:
+
+	/**
+	 * @brief Name of the local session that the proposal is for
+	 */
+	FName SessionName{};
+
+	/**
+	 * @brief Proposal received from matchmaking
+	 */
+	FAccelByteModelsV2MatchmakingBackfillProposalNotif Proposal{};
+
+	/**
+	 * @brief Most players the session may have
+	 */
+	int32 MaxPlayers{0};
+
+	/**
+	 * @brief Players that have joined the session
+	 */
+	int32 JoinedPlayers{0};
+
+	/**
+	 * @brief Players accepted through earlier proposals that have not joined the session yet
+	 */
+	int32 ReservedPlayers{0};
+
+	/**
+	 * @brief Players the proposal would add to the session
+	 */
+	int32 ProposedNewPlayers{0};
+
+	/**
+	 * @brief Capacity of each team in the proposed team layout
+	 */
+	TArray<FAccelByteBackfillTeamCapacity> Teams{};
+
+	/**
+	 * @brief Whether the proposal fits in both the session's open slots and each team's open slots
+	 */
+	bool bFitsCapacity{false};
+
+	/**
+	 * @brief Seconds the proposal waited behind earlier proposals for the same session before being evaluated
+	 */
+	double SecondsQueued{0.0};
+
+	/**
+	 * @brief Get the slots left in the session before the proposal is applied
+	 */
+	int32 GetOpenSlots() const
+	{
+		return FMath::Max(MaxPlayers - JoinedPlayers - ReservedPlayers, 0);
+	}
+
+};
+
+/**
+ * @brief Outcome of a decision on a backfill proposal.
+ */
+struct FAccelByteBackfillDecisionResult
+{
+public:
+
+	/**
+	 * @brief Name of the local session that the proposal was for
+	 */
+	FName SessionName{};
+
+	/**
+	 * @brief ID of the proposal that was decided on
+	 */
+	FString ProposalID{};
+
+	/**
+	 * @brief Decision that was made on the proposal
+	 */
+	EAccelByteBackfillDecision Decision{EAccelByteBackfillDecision::Reject};
+
+	/**
+	 * @brief Whether the decision was sent to matchmaking successfully, always true for deferred proposals
+	 */
+	bool bWasSuccessful{false};
+
+	/**
+	 * @brief Milliseconds between the proposal being received and the decision being acknowledged by matchmaking
+	 */
+	double DecisionLatencyMs{0.0};
+
+};
+
+/**
+ * @brief Counters kept by the backfill manager.
+ */
+struct FAccelByteBackfillMetrics
+{
+public:
+
+	/**
+	 * @brief Proposals received from matchmaking
+	 */
+	uint64 ProposalsReceived{0};
+
+	/**
+	 * @brief Proposals accepted successfully
+	 */
+	uint64 ProposalsAccepted{0};
+
+	/**
+	 * @brief Proposals rejected successfully
+	 */
+	uint64 ProposalsRejected{0};
+
+	/**
+	 * @brief Proposals left to the game
+	 */
+	uint64 ProposalsDeferred{0};
+
+	/**
+	 * @brief Decisions that matchmaking did not acknowledge, such as when the proposal had already expired
+	 */
+	uint64 DecisionsFailed{0};
+
+	/**
+	 * @brief Most proposals that were waiting on a decision for a single session at once
+	 */
+	int32 PeakQueuedProposals{0};
+
+	/**
+	 * @brief Latency from proposal to acknowledged decision for the most recent decision, in milliseconds
+	 */
+	double LastDecisionLatencyMs{0.0};
+
+	/**
+	 * @brief Average latency from proposal to acknowledged decision, in milliseconds
+	 */
+	double AverageDecisionLatencyMs{0.0};
+
+	/**
+	 * @brief Highest latency from proposal to acknowledged decision, in milliseconds
+	 */
+	double MaxDecisionLatencyMs{0.0};
+
+};
+
+/**
+ * Function used by the game to decide on a backfill proposal.
+ */
+using FAccelByteBackfillPolicy = TFunction<EAccelByteBackfillDecision(const FAccelByteBackfillProposalContext& /*Context*/)>;
+
+/**
+ * Delegate fired when a decision on a backfill proposal has been acknowledged by matchmaking, or deferred to the game.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBackfillDecisionComplete, const FAccelByteBackfillDecisionResult& /*Result*/);
+typedef FOnBackfillDecisionComplete::FDelegate FOnBackfillDecisionCompleteDelegate;
+
+/**
+ * Decides on backfill proposals for game servers as they arrive, rather than leaving each one to the game.
+ *
+ * When enabled, each proposal is evaluated against the open slots of the session it is for, both overall and per team.
+ * Players accepted through a proposal hold their slots until they join the session, or until
+ * `BackfillReservationTimeoutSeconds` has passed. The game can supply a policy to make the decision itself, otherwise
+ * proposals that fit are accepted, and backfilling is stopped once a proposal fills the session.
+ *
+ * Decisions for a session are made one at a time, so a proposal is only evaluated once the decision on the one before it
+ * has been acknowledged, and two proposals can never be given the same slots. Proposals deferred to the game hold their
+ * players' slots in the same way as accepted ones, until the game accepts or rejects them through the session interface.
+ * Proposals for different sessions do not wait on each other.
+ *
+ * The following values can be configured in the `OnlineSubsystemAccelByte` section of `DefaultEngine.ini`:
+ * - `bAutoHandleBackfillProposals` whether proposals go through the manager, defaults to false
+ * - `BackfillMatchPoolTeamSizes` most players in each team for sessions from a match pool, as the match pool name
+ *   followed by each team's size, such as `+BackfillMatchPoolTeamSizes=ranked-5v5:5,5`. Teams past the last size listed
+ *   use the last size.
+ * - `BackfillMaxPlayersPerTeam` most players in each team for sessions whose match pool has no team sizes configured, 0
+ *   to only limit the players in the session as a whole, defaults to 0
+ * - `BackfillReservationTimeoutSeconds` seconds an accepted player holds their slot before joining, defaults to 30
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineBackfillManagerAccelByte : public TSharedFromThis<FOnlineBackfillManagerAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Set whether proposals go through the manager. When disabled, proposals are passed straight to the game through
+	 * OnBackfillProposalReceived on the session interface.
+	 */
+	void SetEnabled(bool bInIsEnabled);
+
+	/**
+	 * Whether proposals go through the manager.
+	 */
+	bool IsEnabled() const;
+
+	/**
+	 * Set the policy used to decide on proposals, or pass nullptr to go back to the default policy. Setting a policy also
+	 * enables the manager.
+	 */
+	void SetPolicy(const FAccelByteBackfillPolicy& InPolicy);
+
+	/**
+	 * Set the most players in each team for sessions from a match pool, matching the team sizes in its ruleset. Pass an
+	 * empty array to go back to `BackfillMaxPlayersPerTeam` for the match pool.
+	 *
+	 * @param MatchPool Name of the match pool, as stored in the session's SETTING_SESSION_MATCHPOOL setting
+	 * @param TeamSizes Most players in each team, in team order. Teams past the last size use the last size.
+	 */
+	void SetMatchPoolTeamSizes(const FString& MatchPool, const TArray<int32>& TeamSizes);
+
+	/**
+	 * Get a copy of the counters kept by the manager.
+	 */
+	FAccelByteBackfillMetrics GetMetrics() const;
+
+	/**
+	 * Default policy, accepting proposals that fit and stopping backfill once a proposal fills the session.
+	 */
+	static EAccelByteBackfillDecision DefaultPolicy(const FAccelByteBackfillProposalContext& Context);
+
+	DEFINE_ONLINE_DELEGATE_ONE_PARAM(OnBackfillDecisionComplete, const FAccelByteBackfillDecisionResult& /*Result*/);
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the backfill manager, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlineBackfillManagerAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Queue a proposal received from matchmaking to be decided on. Called by the session interface when the manager is
+	 * enabled.
+	 */
+	void HandleProposal(const FAccelByteModelsV2MatchmakingBackfillProposalNotif& Proposal);
+
+	/**
+	 * Called by the session interface once the game has decided on a proposal. If the proposal was deferred to the game,
+	 * the slots held for its players are either kept until they join, or given back.
+	 *
+	 * @param bHoldSlots true if the proposal was accepted by matchmaking, false if it was rejected or could not be accepted
+	 */
+	void OnDeferredProposalDecided(const FName& SessionName, const FString& ProposalID, bool bHoldSlots);
+
+	/**
+	 * Drop the backfill state of a session that has been removed locally, along with any proposals queued for it.
+	 */
+	void RemoveSession(const FName& SessionName);
+
+private:
+
+	/**
+	 * Proposal waiting on a decision
+	 */
+	struct FQueuedProposal
+	{
+		FAccelByteModelsV2MatchmakingBackfillProposalNotif Proposal;
+		double ReceivedTimeInSeconds{0.0};
+	};
+
+	/**
+	 * Backfill state of a single session
+	 */
+	struct FSessionBackfillState
+	{
+		/** Proposals waiting on a decision, oldest first */
+		TArray<FQueuedProposal> QueuedProposals;
+
+		/** Whether a decision for this session is waiting on matchmaking */
+		bool bIsDecisionInFlight{false};
+
+		/** AccelByte IDs of players accepted into this session that have not joined yet, with when they were accepted */
+		TMap<FString, double> ReservedUserIds;
+
+		/** AccelByte IDs of players in proposals deferred to the game that are holding slots, keyed by proposal ID */
+		TMap<FString, TArray<FString>> DeferredProposalUserIds;
+	};
+
+	/**
+	 * Decide on the oldest queued proposal for the session, if no decision for the session is already in flight.
+	 */
+	void ProcessNextProposal(const FName& SessionName);
+
+	/**
+	 * Work out the capacity of the session for a proposal, dropping reservations for players that have joined or whose
+	 * reservation has expired. Must be called with the manager lock held.
+	 *
+	 * @returns false if the session could not be found
+	 */
+	bool BuildProposalContext(const FName& SessionName, FSessionBackfillState& State, const FQueuedProposal& QueuedProposal, FAccelByteBackfillProposalContext& OutContext, TArray<FString>& OutNewUserIds) const;
+
+	/**
+	 * Get the most players a team in the session may have, from the team sizes of the session's match pool or
+	 * `BackfillMaxPlayersPerTeam`. Without either, teams are only limited by the session's max players. Must be called
+	 * with the manager lock held.
+	 */
+	int32 GetTeamMaxPlayers(const FOnlineSession& Session, int32 TeamIndex, int32 SessionMaxPlayers) const;
+
+	/**
+	 * Handler for matchmaking acknowledging a decision.
+	 */
+	void OnDecisionComplete(bool bWasSuccessful, FName SessionName, FString ProposalID, EAccelByteBackfillDecision Decision, TArray<FString> NewUserIds, double ReceivedTimeInSeconds);
+
+	/**
+	 * Record a decision in the metrics and fire the decision delegate.
+	 */
+	void FinishDecision(const FAccelByteBackfillDecisionResult& Result);
+
+	/**
+	 * Mutex used to lock the session states and metrics while we read or update them
+	 */
+	mutable FCriticalSection BackfillLock;
+
+	/**
+	 * Backfill state of each session we have received proposals for, keyed by session name
+	 */
+	TMap<FName, FSessionBackfillState> SessionStates;
+
+	/**
+	 * Policy supplied by the game, or unset to use the default policy
+	 */
+	FAccelByteBackfillPolicy Policy;
+
+	/**
+	 * Counters kept by the manager
+	 */
+	FAccelByteBackfillMetrics Metrics;
+
+	/**
+	 * Amount of decisions folded into the average latency
+	 */
+	uint64 LatencySampleCount = 0;
+
+	/**
+	 * Whether proposals go through the manager
+	 */
+	bool bIsEnabled = false;
+
+	/**
+	 * Most players in each team for sessions whose match pool has no team sizes, or zero to only limit the session as a
+	 * whole
+	 */
+	int32 MaxPlayersPerTeam = 0;
+
+	/**
+	 * Most players in each team in team order, keyed by match pool name
+	 */
+	TMap<FString, TArray<int32>> MatchPoolTeamSizes;
+
+	/**
+	 * Seconds an accepted player holds their slot before joining the session
+	 */
+	double ReservationTimeoutSeconds = 30.0;
+
+	/**
+	 * AccelByte online subsystem instance that owns this manager.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
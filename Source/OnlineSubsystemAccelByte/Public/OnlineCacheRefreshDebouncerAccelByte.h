@@ -0,0 +1,94 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Collects refresh requests for cached e-commerce data, such as wallets or item entitlements, and releases them in a
+ * single batch once a short window has passed. A burst of purchases or backend notifications touching the same wallet
+ * therefore results in one refresh rather than one per event.
+ *
+ * Requests are keyed by local user and by an entry name, such as a currency code or item ID. An empty entry name stands
+ * for everything cached for that user, and replaces any specific entries already queued for them.
+ *
+ * The window starts with the first request of a burst and is not extended by later requests, so a steady stream of
+ * events cannot hold a refresh back indefinitely.
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineCacheRefreshDebouncerAccelByte
+{
+public:
+
+	/**
+	 * @param InWindowSeconds Seconds to wait after the first request of a burst before releasing the batch
+	 */
+	explicit FOnlineCacheRefreshDebouncerAccelByte(double InWindowSeconds = 1.0);
+
+	/**
+	 * Queue a refresh of an entry for a local user, opening a new window if nothing is currently queued.
+	 *
+	 * @param LocalUserNum Index of the local user that the cached data belongs to
+	 * @param Entry Name of the entry to refresh, or an empty string to refresh everything cached for the user
+	 * @param CurrentTimeInSeconds Platform time that the request was made at
+	 */
+	void Schedule(int32 LocalUserNum, const FString& Entry, double CurrentTimeInSeconds);
+
+	/**
+	 * Move every queued refresh out once the current window has closed.
+	 *
+	 * @param CurrentTimeInSeconds Platform time to compare against the end of the window
+	 * @param OutRefreshes Queued entries for each local user, only written to if the window has closed
+	 * @returns true if refreshes were released, false if nothing is queued or the window is still open
+	 */
+	bool Flush(double CurrentTimeInSeconds, TMap<int32, TSet<FString>>& OutRefreshes);
+
+	/**
+	 * Check whether a refresh of an entry is queued for a local user, either directly or through a full refresh.
+	 */
+	bool IsPending(int32 LocalUserNum, const FString& Entry) const;
+
+	/**
+	 * Get the amount of entries queued across every local user.
+	 */
+	int32 Num() const;
+
+	/**
+	 * Override the window length, such as with a value read from config.
+	 */
+	void SetWindowSeconds(double InWindowSeconds);
+
+	/**
+	 * Drop a queued refresh of an entry for a local user without releasing it. A queued full refresh is left in place.
+	 */
+	void Cancel(int32 LocalUserNum, const FString& Entry);
+
+	/**
+	 * Drop every queued refresh without releasing them.
+	 */
+	void Reset();
+
+private:
+
+	/**
+	 * Mutex used to lock the queue, as requests are made from async task and notification callbacks
+	 */
+	mutable FCriticalSection QueueLock;
+
+	/**
+	 * Entries queued for refresh, keyed by local user index
+	 */
+	TMap<int32, TSet<FString>> PendingRefreshes;
+
+	/**
+	 * Platform time that the current window closes at
+	 */
+	double FlushTimeInSeconds = 0.0;
+
+	/**
+	 * Seconds to wait after the first request of a burst before releasing the batch
+	 */
+	double WindowSeconds = 1.0;
+
+};
@@ -133,14 +133,30 @@ public:
 PACKAGE_SCOPE:
 	void SetTopicData(const FAccelByteModelsChatTopicQueryData& InTopicData);
 	void UpdateTopicData(const FAccelByteModelsChatUpdateTopicNotif& InUpdateTopic);
-	void AddMember(const FString& UserId);
-	void RemoveMember(const FString& UserId);
+
+	/**
+	 * Add a member to the room, returning true if they were not already a member
+	 */
+	bool AddMember(const FString& UserId);
+
+	/**
+	 * Remove a member from the room, returning true if they were a member. Moves the last member into the removed
+	 * member's place, so the order of GetMembers is not kept.
+	 */
+	bool RemoveMember(const FString& UserId);
 	
 	FUniqueNetIdRef OwnerId{FUniqueNetIdAccelByteUser::Invalid()};
 	bool bIsPrivate{};
 	bool bIsJoined{};
 	FChatRoomConfig RoomConfig;
 	FAccelByteModelsChatTopicQueryData TopicData;
+
+private:
+	/**
+	 * Index of each member's ID to their position in TopicData.Members, so that membership checks and removals don't
+	 * scan the array. Rebuilt on SetTopicData and kept in sync by AddMember and RemoveMember.
+	 */
+	TMap<FString, int32> MemberIdToIndex;
 };
 
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineChatAccelByte : public IOnlineChat, public TSharedFromThis<FOnlineChatAccelByte, ESPMode::ThreadSafe>
@@ -365,8 +381,18 @@ public:
 PACKAGE_SCOPE:
 	void RegisterChatDelegates(const FUniqueNetId& PlayerId);
 
+	/**
+	 * Resolves member info for buffered room join notifications once their batch window has passed. Do not call this
+	 * method directly, it will be called from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
 	//~ Begin Utility functions
 	/**
+	* Add member to topic cache. Called on EventAddedToTopic
+	*/
+	void AddMemberToTopic(const FString& UserId, const FString& TopicId);
+	/**
 	* Remove member to topic cache. Called on EventRemovedFromTopic
 	*/
 	void RemoveMemberFromTopic(const FString &UserId, const FString &TopicId);
@@ -411,14 +437,60 @@ private:
 
 	//~ Begin Chat Internal Handlers
 	void OnQueryChatRoomInfoComplete(bool bWasSuccessful, TArray<FAccelByteChatRoomInfoRef> RoomList, int32 LocalUserNum);
-	void OnQueryChatMemberInfo_TriggerChatRoomMemberJoin(bool bIsSuccessful, TArray<TSharedRef<FAccelByteUserInfo>> UsersQueried, FString RoomId, TSharedPtr<const FUniqueNetId> UserId, TSharedPtr<const FUniqueNetId> MemberId);
+	void OnQueryChatMemberInfo_TriggerChatRoomMemberJoins(bool bIsSuccessful, TArray<TSharedRef<FAccelByteUserInfo>> UsersQueried, FString RoomId, TArray<FString> QueriedMemberIds);
 	void OnQueryChatRoomById_TriggerChatRoomMemberJoin(bool bWasSuccessful, FAccelByteChatRoomInfoPtr RoomInfo, int32 LocalUserNum, TSharedPtr<const FUniqueNetId> UserId, TSharedPtr<const FUniqueNetId> MemberId);
 	//~ End Chat Internal Handlers
 
+	/**
+	 * Join notifications for a single room that are waiting on member info, kept in the order they were received so
+	 * that the member join delegates fire in that order.
+	 */
+	struct FChatRoomMemberJoinQueue
+	{
+		int32 LocalUserNum{INDEX_NONE};
+		TSharedPtr<const FUniqueNetId> UserId{nullptr};
+		/** Members that have joined and not had the join delegate fired yet, in the order they joined */
+		TArray<FString> MemberIds{};
+		/** Members whose info is either buffered for the next query or being queried */
+		TSet<FString> MemberIdsAwaitingInfo{};
+		/** Members buffered for the next bulk user query */
+		TArray<FString> MemberIdsToQuery{};
+		/** Seconds left until the buffered members are queried */
+		float SecondsUntilQuery{0.0f};
+	};
+
+	/**
+	 * Queue a member join for a room, firing it straight away if the member info is cached and nothing is queued ahead
+	 * of it, or buffering it to be resolved with other joins for the same room otherwise.
+	 */
+	void QueueChatRoomMemberJoin(int32 LocalUserNum, const TSharedPtr<const FUniqueNetId>& UserId, const FString& RoomId, const FString& MemberId);
+
+	/** Send a single user query for every member buffered for the room */
+	void QueryChatRoomMemberJoins(const FString& RoomId);
+
+	/** Fire join delegates for members at the front of the room's queue that no longer wait on member info */
+	void TriggerChatRoomMemberJoins(const FString& RoomId);
+
+	/** Whether we have a nickname for the member, copying it over from the user cache if needed */
+	bool HasChatRoomMemberInfo(const FString& MemberId);
+
+	/** Add or remove every member of a cached topic from the joined topic index */
+	void IndexTopicMembers(const FAccelByteChatRoomInfoRef& ChatRoomInfo);
+	void UnindexTopicMembers(const FAccelByteChatRoomInfoRef& ChatRoomInfo);
+	void UnindexTopicMember(const FString& UserId, const FString& TopicId);
+
 	/** Cache chat room info. Populated after connect and updated on topic related events */
 	TMap<FString, FAccelByteChatRoomInfoRef> TopicIdToChatRoomInfoCached;
+	/** Index of each user ID to the IDs of the cached topics they are a member of. Kept in sync with TopicIdToChatRoomInfoCached */
+	TMap<FString, TSet<FString>> UserIdToJoinedTopicIdsCached;
 	/** Cache chat room member. Populated along with the topic events */
 	TMap<FString, FAccelByteChatRoomMemberRef> UserIdToChatRoomMemberCached;
 	/** Cache live chat messages */
 	FUserIdToRoomChatMessages UserIdToChatRoomMessagesCached;
+	/** Member join notifications waiting on member info, keyed by room ID */
+	TMap<FString, FChatRoomMemberJoinQueue> RoomIdToMemberJoinQueue;
+	/** Seconds to buffer member joins for a room before querying their info, read from ChatMemberJoinBatchWindowSeconds */
+	float MemberJoinBatchWindowSeconds{0.25f};
+	/** Amount of buffered members for a room that will query their info without waiting, read from ChatMemberJoinMaxBatchSize */
+	int32 MemberJoinMaxBatchSize{100};
 };
@@ -21,25 +21,133 @@ typedef FOnDeleteUserRecordCompleted::FDelegate FOnDeleteUserRecordCompletedDele
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnBulkGetPublicUserRecordCompleted, int32 /*LocalUserNum*/, const FOnlineError& /*Result*/, const FListAccelByteModelsUserRecord&);
 typedef FOnBulkGetPublicUserRecordCompleted::FDelegate FOnBulkGetPublicUserRecordCompletedDelegate;
 
+/** Public user records found for each key requested in a multi-key bulk fetch */
+typedef TMap<FString, FListAccelByteModelsUserRecord> FAccelByteUserRecordsByKey;
+
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnBulkGetPublicUserRecordsCompleted, int32 /*LocalUserNum*/, const FOnlineError& /*Result*/, const FAccelByteUserRecordsByKey& /*KeyToUserRecords*/);
+typedef FOnBulkGetPublicUserRecordsCompleted::FDelegate FOnBulkGetPublicUserRecordsCompletedDelegate;
+
 DECLARE_MULTICAST_DELEGATE_FourParams(FOnGetGameRecordCompleted, int32 /*LocalUserNum*/, const FOnlineError& /*Result*/,const FString& /*Key*/, const FAccelByteModelsGameRecord&);
 typedef FOnGetGameRecordCompleted::FDelegate FOnGetGameRecordCompletedDelegate;
 
 DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnReplaceGameRecordCompleted, int32 /*LocalUserNum*/, const FOnlineError& /*Result*/,const FString& /*Key*/);
 typedef FOnReplaceGameRecordCompleted::FDelegate FOnReplaceGameRecordCompletedDelegate;
 
+/**
+ * @brief Counters for how user record reads and replaces were served by the user record cache.
+ */
+struct FAccelByteCloudSaveUserRecordCacheMetrics
+{
+	/**
+	 * @brief Reads served from a cached record that was still within the freshness window
+	 */
+	int32 Hits{0};
+
+	/**
+	 * @brief Reads for records that were not cached, and so went to the backend
+	 */
+	int32 Misses{0};
+
+	/**
+	 * @brief Reads for cached records that were past the freshness window, and so were revalidated with the backend
+	 */
+	int32 Revalidations{0};
+
+	/**
+	 * @brief Revalidations where the backend returned the same updated at time that we had cached
+	 */
+	int32 UnchangedRevalidations{0};
+
+	/**
+	 * @brief Replaces that were skipped as the value was identical to a fresh copy of the record read from the backend
+	 */
+	int32 SkippedReplaces{0};
+
+	/**
+	 * @brief Cached records invalidated by a replace or delete
+	 */
+	int32 Invalidations{0};
+
+};
+
 /**
  * Implementation of Cloud Save service from AccelByte services
+ *
+ * User records read through this interface are cached per user, key and visibility, using the updated at time of the
+ * record as its version. Reads within `UserRecordCacheFreshnessSeconds` of the record being fetched are served from the
+ * cache, and older records are fetched again to revalidate them. Replacing a record with the value this client last read
+ * for it is skipped while that read is still fresh, and replaces and deletes invalidate the cached record. The cache can
+ * be turned off by setting `bEnableUserRecordCache` to false, both in the `OnlineSubsystemAccelByte` section of
+ * `DefaultEngine.ini`.
+ *
+ * Bulk public record fetches are split into requests of at most `BulkGetPublicUserRecordChunkSize` users, with up to
+ * `MaxConcurrentUserRecordQueries` requests in flight. Public records listed in `PublicUserRecordPrefetchKeys` are
+ * fetched into the cache for players as they join a session, including V2 party sessions, or a V1 lobby party.
  */
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineCloudSaveAccelByte : public TSharedFromThis<FOnlineCloudSaveAccelByte, ESPMode::ThreadSafe>
 {
 PACKAGE_SCOPE:
-	FOnlineCloudSaveAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
-		: AccelByteSubsystem(InSubsystem)
-	{}
+	FOnlineCloudSaveAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
 
 	TMap<FString, TSharedRef<FAccelByteModelsGameRecord>> GameRecordMap;
 	/** Critical sections for thread safe operation of CurrencyCodeToCurrencyListMap */
 	mutable FCriticalSection GameRecordMapLock;
+
+	/** Result of looking up a user record in the cache for a read */
+	enum class EUserRecordCacheLookup : uint8
+	{
+		Miss,
+		Stale,
+		Hit
+	};
+
+	/**
+	 * Look up a user record that is about to be read, counting the lookup towards the cache metrics. The record is only
+	 * copied out on a hit, as stale records must be revalidated with the backend.
+	 */
+	EUserRecordCacheLookup LookupUserRecordForRead(const FString& RecordUserId, const FString& Key, bool bIsPublic, FAccelByteModelsUserRecord& OutRecord);
+
+	/**
+	 * Cache a user record that was fetched from the backend, restarting its freshness window.
+	 */
+	void AddUserRecordToCache(const FString& RecordUserId, const FString& Key, bool bIsPublic, const FAccelByteModelsUserRecord& Record);
+
+	/**
+	 * Check whether a replace would write the value of a fresh copy of the record that this client read from the backend,
+	 * counting it as a skipped replace if so. Records past the freshness window or invalidated by a replace are never
+	 * compared against, as another client may have written to them since.
+	 */
+	bool IsUserRecordValueUnchanged(const FString& RecordUserId, const FString& Key, bool bIsPublic, const FString& SerializedValue);
+
+	/**
+	 * Invalidate the cached record after a successful replace, so that it is read from the backend again before a later
+	 * replace can be skipped against it.
+	 */
+	void OnUserRecordReplaced(const FString& RecordUserId, const FString& Key, bool bIsPublic);
+
+	/**
+	 * Remove both the public and private cached records for a key after a successful delete.
+	 */
+	void RemoveUserRecordFromCache(const FString& RecordUserId, const FString& Key);
+
+	/**
+	 * Serialize a record value to the condensed string we compare replaces against.
+	 */
+	static FString SerializeUserRecordValue(const FJsonObject& Value);
+
+	/**
+	 * Whether user records should be read from and written to the cache.
+	 */
+	bool IsUserRecordCacheEnabled() const
+	{
+		return bIsUserRecordCacheEnabled;
+	}
+
+	/**
+	 * Override the freshness window read from config, used by exec tests to force revalidation.
+	 */
+	void SetUserRecordCacheFreshness(double InFreshnessSeconds);
+
 public:
 	virtual ~FOnlineCloudSaveAccelByte() {};
 
@@ -65,6 +173,7 @@ public:
 	DEFINE_ONLINE_PLAYER_DELEGATE_TWO_PARAM(MAX_LOCAL_PLAYERS, OnReplaceUserRecordCompleted, const FOnlineError&,const FString&);
 	DEFINE_ONLINE_PLAYER_DELEGATE_TWO_PARAM(MAX_LOCAL_PLAYERS, OnDeleteUserRecordCompleted, const FOnlineError&, const FString&);
 	DEFINE_ONLINE_PLAYER_DELEGATE_TWO_PARAM(MAX_LOCAL_PLAYERS, OnBulkGetPublicUserRecordCompleted, const FOnlineError&, const FListAccelByteModelsUserRecord&);
+	DEFINE_ONLINE_PLAYER_DELEGATE_TWO_PARAM(MAX_LOCAL_PLAYERS, OnBulkGetPublicUserRecordsCompleted, const FOnlineError&, const FAccelByteUserRecordsByKey&);
 	DEFINE_ONLINE_PLAYER_DELEGATE_THREE_PARAM(MAX_LOCAL_PLAYERS, OnGetGameRecordCompleted, const FOnlineError&, const FString&, const FAccelByteModelsGameRecord&);
 	DEFINE_ONLINE_PLAYER_DELEGATE_TWO_PARAM(MAX_LOCAL_PLAYERS, OnReplaceGameRecordCompleted, const FOnlineError&,const FString&);
 
@@ -146,6 +255,47 @@ public:
 	 */
 	bool BulkGetPublicUserRecord(int32 LocalUserNum, const FString& Key, const TArray<FUniqueNetIdAccelByteUserRef>& UniqueNetIds);
 
+	/**
+	 * @brief Get public records (arbitrary JSON data) of several keys for a list of users at once. Fires
+	 * OnBulkGetPublicUserRecordsCompleted with the records found for each key.
+	 *
+	 * @param LocalUserNum Index of user that is attempting to get bulk public user records
+	 * @param Keys Keys of the records to get
+	 * @param UserIds List UserId(s) of the record owners
+	 */
+	bool BulkGetPublicUserRecords(int32 LocalUserNum, const TArray<FString>& Keys, const TArray<FString>& UserIds);
+
+	/**
+	 * @brief Get public records (arbitrary JSON data) of several keys for a list of users at once. Fires
+	 * OnBulkGetPublicUserRecordsCompleted with the records found for each key.
+	 *
+	 * @param LocalUserNum Index of user that is attempting to get bulk public user records
+	 * @param Keys Keys of the records to get
+	 * @param UniqueNetIds List UniqueNetId(UserId)(s) of the record owners
+	 */
+	bool BulkGetPublicUserRecords(int32 LocalUserNum, const TArray<FString>& Keys, const TArray<FUniqueNetIdAccelByteUserRef>& UniqueNetIds);
+
+	/**
+	 * @brief Fetch public records for a list of users into the user record cache ahead of them being read, such as when
+	 * players join a session or party. No delegates are fired. Does nothing if the user record cache is disabled.
+	 *
+	 * @param LocalUserId ID of the local user to fetch the records with
+	 * @param Keys Keys of the records to fetch
+	 * @param UserIds List UserId(s) of the record owners
+	 * @returns true if a fetch was started, false if there was nothing to fetch or the cache is disabled
+	 */
+	bool PrefetchPublicUserRecords(const FUniqueNetId& LocalUserId, const TArray<FString>& Keys, const TArray<FString>& UserIds);
+
+	/**
+	 * @brief Fetch the public records listed in PublicUserRecordPrefetchKeys in config for a list of users. Called when
+	 * players join a session or party, does nothing if no keys are configured.
+	 *
+	 * @param LocalUserId ID of the local user to fetch the records with
+	 * @param UserIds List UserId(s) of the record owners
+	 * @returns true if a fetch was started, false otherwise
+	 */
+	bool PrefetchPublicUserRecords(const FUniqueNetId& LocalUserId, const TArray<FString>& UserIds);
+
 	/**
 	 * @brief Get a record by its key in namespace-level.
 	 *
@@ -173,6 +323,27 @@ public:
 	bool ReplaceGameRecord(int32 LocalUserNum, const FString& Key, const FJsonObject& RecordRequest);
 	void AddGameRecordToMap(const FString& Key, const TSharedRef<FAccelByteModelsGameRecord>& Record);
 
+	/**
+	 * @brief Get a user record from cache, regardless of whether it is still within the freshness window.
+	 *
+	 * @param Key The record key to get
+	 * @param RecordUserId The AccelByte ID of the record owner
+	 * @param bIsPublic Whether to get the cached public record or the cached private record
+	 * @param OutRecord Cached record if found
+	 * @returns true if a record was cached, false otherwise
+	 */
+	bool GetUserRecordFromCache(const FString& Key, const FString& RecordUserId, bool bIsPublic, FAccelByteModelsUserRecord& OutRecord) const;
+
+	/**
+	 * @brief Get a snapshot of the hit and miss counts of the user record cache.
+	 */
+	FAccelByteCloudSaveUserRecordCacheMetrics GetUserRecordCacheMetrics() const;
+
+	/**
+	 * @brief Remove every record from the user record cache and reset its metrics.
+	 */
+	void ClearUserRecordCache();
+
 protected:
 	/** Hidden default constructor, the constructor that takes in a subsystem instance should be used instead. */
 	FOnlineCloudSaveAccelByte()
@@ -185,4 +356,38 @@ protected:
 private:
 	bool GetUserRecord(int32 LocalUserNum, const FString& Key, bool IsPublic, const FString& UserId = TEXT(""));
 	bool ReplaceUserRecord(int32 LocalUserNum, const FString& Key, const FJsonObject& RecordRequest, bool IsPublic);
+
+	/** Build the key that a user record is cached under */
+	static FString GetUserRecordCacheKey(const FString& RecordUserId, const FString& Key, bool bIsPublic);
+
+	/** A user record as last fetched from the backend */
+	struct FCachedUserRecord
+	{
+		/** Record as last fetched from the backend. Its updated at time acts as the version of the record. */
+		FAccelByteModelsUserRecord Record{};
+		/** Condensed serialization of the fetched record value, compared against when deciding whether to skip a replace */
+		FString SerializedValue{};
+		/** Platform time in seconds that the record was fetched from the backend */
+		double CachedTimeInSeconds{0.0};
+		/** Whether the record has been invalidated by a replace, in which case reads must go to the backend */
+		bool bIsInvalidated{false};
+	};
+
+	/** Cached user records, keyed by record owner, visibility and key */
+	TMap<FString, FCachedUserRecord> UserRecordCache;
+
+	/** Hit and miss counts for the user record cache */
+	FAccelByteCloudSaveUserRecordCacheMetrics UserRecordCacheMetrics;
+
+	/** Critical section for thread safe operation of UserRecordCache and UserRecordCacheMetrics */
+	mutable FCriticalSection UserRecordCacheLock;
+
+	/** Whether user records should be read from and written to the cache */
+	bool bIsUserRecordCacheEnabled{true};
+
+	/** Seconds that a cached user record is served for before it is revalidated with the backend */
+	double UserRecordCacheFreshnessSeconds{30.0};
+
+	/** Keys of the public records to prefetch for players joining a session or party, read from PublicUserRecordPrefetchKeys */
+	TArray<FString> PublicUserRecordPrefetchKeys;
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "OnlineSubsystemAccelByteUtils.h"
 #include "Interfaces/OnlineEntitlementsInterface.h"
 #include "Models/AccelByteEcommerceModels.h"
+#include "OnlineCacheRefreshDebouncerAccelByte.h"
 
 using FEntitlementMap = TMap<FUniqueEntitlementId, TSharedRef<FOnlineEntitlement>>;
 using FUserIDToEntitlementMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FEntitlementMap, FDefaultSetAllocator, TUserUniqueIdConstSharedRefMapKeyFuncs<FEntitlementMap>>;
@@ -15,6 +16,16 @@ using FUserIDToEntitlementMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>
 using FItemEntitlementMap = TMap<FString, TSharedRef<FOnlineEntitlement>>;
 using FUserIDToItemEntitlementMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FItemEntitlementMap, FDefaultSetAllocator, TUserUniqueIdConstSharedRefMapKeyFuncs<FItemEntitlementMap>>;
 
+using FUserIDToLastUpdatedTimeMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FDateTime, FDefaultSetAllocator, TUserUniqueIdConstSharedRefMapKeyFuncs<FDateTime>>;
+
+/**
+ * Implementation of Entitlements service from AccelByte services
+ *
+ * Entitlements for an item are refreshed from the backend after a successful checkout of that item, or when a lobby
+ * notification with one of the `EntitlementNotificationTopics` configured in the `OnlineSubsystemAccelByte` section of
+ * `DefaultEngine.ini` arrives. Refreshes are batched once `EcommerceCacheRefreshDebounceSeconds` has passed, defaulting
+ * to one second, and fire the usual query entitlements complete delegates when they finish.
+ */
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineEntitlementsAccelByte : public IOnlineEntitlements
 {
 PACKAGE_SCOPE:
@@ -23,6 +34,47 @@ PACKAGE_SCOPE:
 
 	virtual void AddEntitlementToMap(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, TSharedRef<FOnlineEntitlement> Entitlement);
 
+	/** Add a batch of entitlements for a user to the cache, taking the map lock once for the whole batch */
+	virtual void AddEntitlementsToMap(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TArray<TSharedRef<FOnlineEntitlement>>& Entitlements);
+
+	/**
+	 * Replace the cached entitlements for a user with the result of a full refresh, dropping any that were revoked or
+	 * consumed since they were cached.
+	 *
+	 * @param UserId ID of the user that owns the entitlements
+	 * @param ItemId ID of the item whose entitlements were refreshed, or an empty string to replace every entitlement
+	 * @param Entitlements Every entitlement the backend returned for the refresh
+	 */
+	virtual void ReplaceEntitlementsInMap(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const FString& ItemId, const TArray<TSharedRef<FOnlineEntitlement>>& Entitlements);
+
+	/**
+	 * Queue a refresh of the entitlements for an item from the backend.
+	 *
+	 * @param LocalUserNum Index of the local user that owns the entitlements
+	 * @param ItemId ID of the item to refresh entitlements for, or an empty string to refresh every entitlement
+	 */
+	void InvalidateItemEntitlement(int32 LocalUserNum, const FString& ItemId);
+
+	/**
+	 * Queue entitlement refreshes if the notification topic is one of the configured entitlement topics. Refreshes only
+	 * the items named by an `itemId` or `itemIds` field in the payload if present, otherwise every entitlement.
+	 *
+	 * @returns true if the notification was for the entitlement service
+	 */
+	bool OnNotificationReceived(int32 LocalUserNum, const FString& Topic, const FString& Payload);
+
+	/**
+	 * Sends queued entitlement refreshes once the debounce window has closed. Do not call this method directly, it will
+	 * be called from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
+	/** Entitlement refreshes queued by invalidation, keyed by local user and item ID */
+	FOnlineCacheRefreshDebouncerAccelByte RefreshDebouncer;
+
+	/** Lobby notification topics that indicate a change to entitlements, read from EntitlementNotificationTopics in config */
+	TArray<FString> EntitlementNotificationTopics;
+
 public:
 	/**
 	 * Convenience method to get an instance of this interface from the subsystem passed in.
@@ -46,6 +98,15 @@ public:
 	virtual TSharedPtr<FOnlineEntitlement> GetItemEntitlement(const FUniqueNetId& UserId, const FString& ItemId) override;
 	virtual void GetAllEntitlements(const FUniqueNetId& UserId, const FString& Namespace, TArray<TSharedRef<FOnlineEntitlement>>& OutUserEntitlements) override;
 	virtual bool QueryEntitlements(const FUniqueNetId& UserId, const FString& Namespace, const FPagedQuery& Page) override;
+
+	/**
+	 * Get the time that entitlements were last written to the cache for a user, so that callers can skip querying
+	 * entitlements that they have already seen.
+	 *
+	 * @returns UTC time of the last write, or FDateTime::MinValue() if nothing has been cached for the user
+	 */
+	FDateTime GetEntitlementsLastUpdatedTime(const FUniqueNetId& UserId) const;
+
 	void SyncPlatformPurchase(int32 LocalUserNum, FAccelByteModelsEntitlementSyncBase EntitlementSyncBase, const FOnRequestCompleted& CompletionDelegate = FOnRequestCompleted());
 	void SyncDLC(const FUniqueNetId& InLocalUserId, const FOnRequestCompleted& CompletionDelegate);
 
@@ -57,6 +118,9 @@ private:
 	FUserIDToEntitlementMap EntitlementMap;
 	FUserIDToItemEntitlementMap ItemEntitlementMap;
 	
+	/** Time that entitlements were last written to the cache for each user, guarded by EntitlementMapLock */
+	FUserIDToLastUpdatedTimeMap LastUpdatedTimeMap;
+
 	/** Critical sections for thread safe operation of EntitlementMap */
 	mutable FCriticalSection EntitlementMapLock;
 
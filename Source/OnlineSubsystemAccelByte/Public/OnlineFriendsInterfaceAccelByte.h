@@ -316,4 +316,7 @@ protected:
 
 	void OnPresenceReceived(const FUniqueNetId& UserId, const TSharedRef<FOnlineUserPresence>& Presence, int32 LocalUserNum);
 
+	/** Evict a user's presence from the presence interface's cache, used once they are no longer a friend or are blocked */
+	void RemovePresenceFromCache(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId);
+
 };
\ No newline at end of file
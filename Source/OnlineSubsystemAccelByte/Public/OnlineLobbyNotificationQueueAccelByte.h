@@ -0,0 +1,251 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+
+class FOnlineSubsystemAccelByte;
+
+/**
+ * Order that queued lobby notifications are processed in, from first to last.
+ */
+enum class EAccelByteLobbyNotificationPriority : uint8
+{
+	/** Notifications removing the player from something, such as being kicked from a session or party */
+	Critical = 0,
+	/** Matchmaking and server status notifications that the player is actively waiting on */
+	High,
+	/** Session, party and friend updates */
+	Normal,
+	/** Presence updates, the only notifications that may be dropped when the queue is full */
+	Low,
+	Count
+};
+
+/**
+ * @brief Snapshot of the counters kept by the lobby notification queue.
+ */
+struct FAccelByteLobbyNotificationQueueMetrics
+{
+public:
+
+	/**
+	 * @brief Amount of notifications currently waiting to be processed
+	 */
+	int32 QueueDepth{0};
+
+	/**
+	 * @brief Highest amount of notifications that have been waiting to be processed at once
+	 */
+	int32 PeakQueueDepth{0};
+
+	/**
+	 * @brief Amount of notifications that have been queued
+	 */
+	uint64 EnqueuedCount{0};
+
+	/**
+	 * @brief Amount of notifications whose handlers have been run
+	 */
+	uint64 ProcessedCount{0};
+
+	/**
+	 * @brief Amount of notifications replaced by a newer notification of the same type for the same entity
+	 */
+	uint64 CollapsedCount{0};
+
+	/**
+	 * @brief Amount of notifications dropped as the queue was full
+	 */
+	uint64 DroppedCount{0};
+
+	/**
+	 * @brief Amount of notifications queued past the limit, as the queue was full with nothing that could be dropped
+	 */
+	uint64 OverLimitCount{0};
+
+	/**
+	 * @brief Amount of ticks that ran out of time budget before the queue was empty
+	 */
+	uint64 TicksOverBudget{0};
+
+	/**
+	 * @brief Time spent running notification handlers in the last tick that processed any, in milliseconds
+	 */
+	double LastTickProcessingMs{0.0};
+
+};
+
+/**
+ * Central queue that lobby notifications are routed through before reaching the interface that handles them.
+ *
+ * Each notification is tagged with its type and the ID of the entity it is for, such as a session or user. When a newer
+ * notification of the same type arrives for an entity that still has one waiting, the waiting notification is replaced,
+ * so that superseded updates replayed after a reconnect are not handled one by one. Notifications are processed on the
+ * game thread in priority order, so that kicks and matches are acted on before presence, and in arrival order within a
+ * priority.
+ *
+ * Handlers are run from the subsystem's ticker until the per-tick time budget is used up, leaving the rest for the next
+ * tick. If the queue fills up, the oldest low priority notification is dropped to make room. Notifications of any other
+ * priority change state, such as a kick or new party data, so they are never dropped and are queued past the limit if
+ * nothing can be dropped. The following values can be
+ * configured in the `OnlineSubsystemAccelByte` section of `DefaultEngine.ini`:
+ * - `LobbyNotificationTickBudgetMs` time that handlers may run for each tick, 0 or less for no limit, defaults to 2
+ * - `MaxQueuedLobbyNotifications` amount of notifications that may wait at once, defaults to 4096
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineLobbyNotificationQueueAccelByte : public TSharedFromThis<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Queue a notification to be handled on a later tick.
+	 *
+	 * @param Priority Priority of the notification
+	 * @param Type Name of the notification type
+	 * @param EntityId ID of the session, party, user or ticket that the notification is for, may be blank
+	 * @param bCollapseSuperseded Whether this notification replaces a waiting notification of the same type for the same entity
+	 * @param Handler Function run to handle the notification
+	 */
+	void Enqueue(EAccelByteLobbyNotificationPriority Priority, const FString& Type, const FString& EntityId, bool bCollapseSuperseded, TFunction<void()>&& Handler);
+
+	/**
+	 * Create a notification delegate that routes notifications through the given queue to a handler on the owner. If
+	 * the queue no longer exists when a notification arrives, the handler is run straight away.
+	 *
+	 * @param Queue Queue to route notifications through
+	 * @param Owner Object that handles the notification, only held weakly
+	 * @param Handler Method on the owner that handles the notification
+	 * @param Priority Priority of notifications from this delegate
+	 * @param Type Name of the notification type
+	 * @param GetEntityId Function returning the ID of the entity a notification is for, or nullptr if there is none
+	 * @param bCollapseSuperseded Whether notifications replace a waiting notification of the same type for the same entity
+	 * @param Payload Extra values passed to the handler after the notification
+	 */
+	template <typename DelegateType, typename UserClass, typename NotificationType, typename... HandlerVarTypes, typename... PayloadTypes>
+	static DelegateType CreateQueuedDelegate(const TSharedPtr<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe>& Queue
+		, const TSharedRef<UserClass, ESPMode::ThreadSafe>& Owner
+		, void (UserClass::*Handler)(NotificationType, HandlerVarTypes...)
+		, EAccelByteLobbyNotificationPriority Priority
+		, const FString& Type
+		, TFunction<FString(const typename TDecay<NotificationType>::Type&)> GetEntityId
+		, bool bCollapseSuperseded
+		, PayloadTypes... Payload)
+	{
+		typedef typename TDecay<NotificationType>::Type FNotification;
+		const TWeakPtr<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe> QueueWeak = Queue;
+		const TWeakPtr<UserClass, ESPMode::ThreadSafe> OwnerWeak = Owner;
+
+		return DelegateType::CreateLambda([QueueWeak, OwnerWeak, Handler, Priority, Type, GetEntityId, bCollapseSuperseded, Payload...](NotificationType Notification) {
+			TFunction<void()> Dispatch = [OwnerWeak, Handler, Notification = FNotification(Notification), Payload...]() {
+				const TSharedPtr<UserClass, ESPMode::ThreadSafe> PinnedOwner = OwnerWeak.Pin();
+				if (PinnedOwner.IsValid())
+				{
+					(PinnedOwner.Get()->*Handler)(Notification, Payload...);
+				}
+			};
+
+			const TSharedPtr<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe> PinnedQueue = QueueWeak.Pin();
+			if (!PinnedQueue.IsValid())
+			{
+				Dispatch();
+				return;
+			}
+
+			const FString EntityId = GetEntityId ? GetEntityId(Notification) : FString();
+			PinnedQueue->Enqueue(Priority, Type, EntityId, bCollapseSuperseded, MoveTemp(Dispatch));
+		});
+	}
+
+	/**
+	 * Get a snapshot of the queue's counters.
+	 */
+	FAccelByteLobbyNotificationQueueMetrics GetMetrics() const;
+
+	/**
+	 * Get the amount of notifications currently waiting to be processed.
+	 */
+	int32 Num() const;
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the notification queue, should only be one of these in existence. Will be owned by the subsystem
+	 * instance that created it.
+	 */
+	FOnlineLobbyNotificationQueueAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Run waiting notification handlers in priority order until the queue is empty or the time budget is used up. At
+	 * least one handler is always run if any are waiting.
+	 *
+	 * @param TimeBudgetSeconds Time that handlers may run for, 0 or less for no limit
+	 * @returns amount of notifications processed
+	 */
+	int32 ProcessNotifications(double TimeBudgetSeconds);
+
+	/**
+	 * Processes waiting notifications within the per-tick budget. Do not call this method directly, it will be called
+	 * from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
+	/**
+	 * Override the limits read from config, used by exec tests.
+	 */
+	void SetLimits(double InTickBudgetSeconds, int32 InMaxQueuedNotifications);
+
+private:
+
+	/** Single notification waiting to be processed */
+	struct FQueuedNotification
+	{
+		FString Type;
+		FString EntityId;
+		FString CollapseKey;
+		TFunction<void()> Handler;
+	};
+
+	typedef TSharedRef<FQueuedNotification, ESPMode::ThreadSafe> FQueuedNotificationRef;
+
+	/**
+	 * Remove and return the next notification from the given priority's queue. Must be called with the queue lock held,
+	 * and with the priority's queue not empty.
+	 */
+	FQueuedNotificationRef PopNotification(int32 PriorityIndex);
+
+	/** Mutex used to lock the queues while we add to or take from them */
+	mutable FCriticalSection QueueLock;
+
+	/** Waiting notifications for each priority, oldest first from each queue's head index */
+	TArray<FQueuedNotificationRef> Queues[static_cast<int32>(EAccelByteLobbyNotificationPriority::Count)];
+
+	/** Index of the oldest waiting notification in each priority's queue */
+	int32 QueueHeads[static_cast<int32>(EAccelByteLobbyNotificationPriority::Count)] = {};
+
+	/** Waiting notifications that can be collapsed, keyed by type and entity ID */
+	TMap<FString, FQueuedNotificationRef> CollapsibleNotifications;
+
+	/** Counters reported through GetMetrics */
+	FAccelByteLobbyNotificationQueueMetrics Metrics;
+
+	/** Time that handlers may run for each tick, in seconds */
+	double TickBudgetSeconds = 0.002;
+
+	/** Amount of notifications that may wait at once */
+	int32 MaxQueuedNotifications = 4096;
+
+	/** Dropped count the last time the ticker checked, used to warn once per tick about drops */
+	uint64 LastReportedDroppedCount = 0;
+
+	/** Over limit count the last time the ticker checked, used to warn once per tick about exceeding the limit */
+	uint64 LastReportedOverLimitCount = 0;
+
+	/**
+	 * AccelByte online subsystem instance that owns this queue.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
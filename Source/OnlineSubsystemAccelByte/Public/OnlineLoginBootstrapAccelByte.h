@@ -0,0 +1,342 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+#include "OnlineDelegateMacros.h"
+
+class FOnlineSubsystemAccelByte;
+
+/**
+ * State of a single stage within a login bootstrap run.
+ */
+enum class EAccelByteLoginBootstrapStageState : uint8
+{
+	/** Stage is waiting for its prerequisites to finish */
+	Pending,
+	/** Stage has been started and is waiting on its fetch to complete */
+	Running,
+	/** Stage finished successfully */
+	Succeeded,
+	/** Stage finished with an error */
+	Failed,
+	/** Stage was never started as one of its prerequisites did not succeed */
+	Skipped,
+	/** Stage was pending or running when the bootstrap was cancelled */
+	Cancelled
+};
+
+/**
+ * @brief Timing and result information for a single stage of a login bootstrap run.
+ */
+struct FAccelByteLoginBootstrapStageReport
+{
+public:
+
+	/**
+	 * @brief Name of the stage this report is for
+	 */
+	FName Stage{};
+
+	/**
+	 * @brief State the stage was in when this report was taken
+	 */
+	EAccelByteLoginBootstrapStageState State{EAccelByteLoginBootstrapStageState::Pending};
+
+	/**
+	 * @brief Seconds between the bootstrap starting and this stage starting, or -1 if the stage never started
+	 */
+	double StartOffsetSeconds{-1.0};
+
+	/**
+	 * @brief Seconds this stage took to complete, or zero if it has not completed
+	 */
+	double DurationSeconds{0.0};
+
+	/**
+	 * @brief Error reported by the stage, or why it was skipped, blank on success
+	 */
+	FString Error{};
+
+};
+
+/**
+ * @brief Result of a whole login bootstrap run for a local user.
+ */
+struct FAccelByteLoginBootstrapReport
+{
+public:
+
+	/**
+	 * @brief Whether every stage in the run succeeded
+	 */
+	bool bWasSuccessful{false};
+
+	/**
+	 * @brief Whether the run was cancelled before every stage finished, such as by the user logging out
+	 */
+	bool bWasCancelled{false};
+
+	/**
+	 * @brief Seconds between the bootstrap starting and the last stage finishing, or the run being cancelled
+	 */
+	double TotalDurationSeconds{0.0};
+
+	/**
+	 * @brief Reports for each stage in the run, ordered so that a stage always comes after its prerequisites
+	 */
+	TArray<FAccelByteLoginBootstrapStageReport> Stages{};
+
+};
+
+/**
+ * Delegate passed to a stage function, to be fired exactly once when the stage's fetch has completed. May be fired
+ * synchronously from within the stage function.
+ */
+DECLARE_DELEGATE_TwoParams(FOnLoginBootstrapStageFinished, bool /*bWasSuccessful*/, const FString& /*Error*/);
+
+/**
+ * Function used to run a stage of the login bootstrap for a local user.
+ */
+using FAccelByteLoginBootstrapStageFunction = TFunction<void(int32 /*LocalUserNum*/, const FOnLoginBootstrapStageFinished& /*OnFinished*/)>;
+
+/**
+ * Delegate fired when a stage of a login bootstrap run has finished.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLoginBootstrapStageComplete, int32 /*LocalUserNum*/, const FAccelByteLoginBootstrapStageReport& /*StageReport*/);
+typedef FOnLoginBootstrapStageComplete::FDelegate FOnLoginBootstrapStageCompleteDelegate;
+
+/**
+ * Delegate fired when a login bootstrap run has finished every stage, or has been cancelled.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnLoginBootstrapComplete, int32 /*LocalUserNum*/, const FAccelByteLoginBootstrapReport& /*Report*/);
+typedef FOnLoginBootstrapComplete::FDelegate FOnLoginBootstrapCompleteDelegate;
+
+/**
+ * Runs the fetches a game needs after login as a graph of stages, rather than as a chain of requests that each wait on
+ * the one before.
+ *
+ * The game lists the stages it wants, either through `SetRequestedStages` or the `LoginBootstrapStages` array in the
+ * `OnlineSubsystemAccelByte` section of `DefaultEngine.ini`. Once a user logs in, every requested stage, along with any
+ * stages they depend on, is started as soon as its own prerequisites have succeeded, so independent fetches run side by
+ * side. A stage whose prerequisite fails is skipped rather than started.
+ *
+ * Built in stages cover lobby connection and the common post-login queries. Games can register their own stages, such
+ * as loading cloud save records or stats, through `RegisterStage`. Each stage reports how long it took, and the run as a
+ * whole is cancelled when the user logs out, with any callbacks from stages still in flight being ignored.
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineLoginBootstrapAccelByte : public TSharedFromThis<FOnlineLoginBootstrapAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	/** Connects to the lobby, finishing immediately if already connected */
+	static const FName ConnectLobbyStage;
+
+	/** Reads the friends list, requires the lobby connection */
+	static const FName FriendsStage;
+
+	/** Queries the list of blocked players */
+	static const FName BlockedPlayersStage;
+
+	/** Queries the entitlements owned by the user */
+	static const FName EntitlementsStage;
+
+	/** Queries the currencies available in the namespace */
+	static const FName CurrenciesStage;
+
+	/**
+	 * Queries the user's profile, creating a blank one in the game namespace if they have none. When requested, the login
+	 * task leaves profile creation to the bootstrap rather than chaining it after login.
+	 */
+	static const FName UserProfileStage;
+
+	/**
+	 * Register a stage that can be requested as part of the bootstrap, replacing any stage already registered with the
+	 * same name. Should not be called while a bootstrap is running.
+	 *
+	 * @param Stage Name of the stage
+	 * @param Prerequisites Names of stages that must succeed before this stage is started
+	 * @param Function Function that runs the stage
+	 */
+	void RegisterStage(const FName& Stage, const TArray<FName>& Prerequisites, const FAccelByteLoginBootstrapStageFunction& Function);
+
+	/**
+	 * Set the stages that are run automatically once a local user logs in. Prerequisites do not need to be listed.
+	 */
+	void SetRequestedStages(const TArray<FName>& Stages);
+
+	/**
+	 * Get the stages that are run automatically once a local user logs in.
+	 */
+	TArray<FName> GetRequestedStages() const;
+
+	/**
+	 * Whether a run started with the requested stages would include the stage, either requested directly or as a
+	 * prerequisite of another stage.
+	 */
+	bool IsStageRequested(const FName& Stage) const;
+
+	/**
+	 * Start a bootstrap run for a local user with the requested stages. Any run already in progress for the user is
+	 * cancelled first.
+	 *
+	 * @param OutStages If set, filled with every stage in the run, including prerequisites. Filled as the run is started,
+	 * so it is still accurate if the run finishes before this call returns.
+	 * @returns true if a run was started, false if no stages were requested or the stages could not be resolved
+	 */
+	bool StartBootstrap(int32 LocalUserNum, TArray<FName>* OutStages = nullptr);
+
+	/**
+	 * Start a bootstrap run for a local user with the stages passed in. Any run already in progress for the user is
+	 * cancelled first.
+	 *
+	 * @param OutStages If set, filled with every stage in the run, including prerequisites. Filled as the run is started,
+	 * so it is still accurate if the run finishes before this call returns.
+	 * @returns true if a run was started, false if no stages were passed or the stages could not be resolved
+	 */
+	bool StartBootstrap(int32 LocalUserNum, const TArray<FName>& Stages, TArray<FName>* OutStages = nullptr);
+
+	/**
+	 * Cancel the bootstrap run in progress for a local user, if any. Stages still in flight will finish their own
+	 * requests, but their results are ignored by the bootstrap.
+	 */
+	void CancelBootstrap(int32 LocalUserNum);
+
+	/**
+	 * Whether a bootstrap run is in progress for the local user.
+	 */
+	bool IsBootstrapRunning(int32 LocalUserNum) const;
+
+	/**
+	 * Whether the bootstrap run in progress for the local user includes the stage, either requested directly or as a
+	 * prerequisite of another stage. A run whose stages all finish straight away is no longer in progress by the time
+	 * StartBootstrap returns, so use its OutStages parameter to check the stages of a run just started.
+	 */
+	bool IsStageInBootstrap(int32 LocalUserNum, const FName& Stage) const;
+
+	/**
+	 * Get a report for the bootstrap run in progress for a local user, or for the last one to finish if none are running.
+	 *
+	 * @returns true if a report was found, false if no bootstrap has run for this user
+	 */
+	bool GetBootstrapReport(int32 LocalUserNum, FAccelByteLoginBootstrapReport& OutReport) const;
+
+	DEFINE_ONLINE_PLAYER_DELEGATE_ONE_PARAM(MAX_LOCAL_PLAYERS, OnLoginBootstrapStageComplete, const FAccelByteLoginBootstrapStageReport& /*StageReport*/);
+
+	DEFINE_ONLINE_PLAYER_DELEGATE_ONE_PARAM(MAX_LOCAL_PLAYERS, OnLoginBootstrapComplete, const FAccelByteLoginBootstrapReport& /*Report*/);
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the login bootstrap, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlineLoginBootstrapAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+private:
+
+	/**
+	 * Definition of a registered stage
+	 */
+	struct FStageDefinition
+	{
+		TArray<FName> Prerequisites;
+		FAccelByteLoginBootstrapStageFunction Function;
+	};
+
+	/**
+	 * State of a bootstrap run for a single local user
+	 */
+	struct FBootstrapRun
+	{
+		/** Identifier for this run, used to ignore callbacks from stages of a run that has since been cancelled */
+		uint32 RunId{0};
+
+		/** Platform time in seconds that this run was started */
+		double StartTimeInSeconds{0.0};
+
+		/** Reports for each stage in the run, ordered so that a stage always comes after its prerequisites */
+		TArray<FAccelByteLoginBootstrapStageReport> Stages;
+
+		/** Prerequisites of each stage in the run, as indices into the stage array */
+		TArray<TArray<int32>> PrerequisiteIndices;
+	};
+
+	/**
+	 * Resolve the stages passed in, along with their prerequisites, into an order where every stage comes after its
+	 * prerequisites. Must be called with the bootstrap lock held.
+	 *
+	 * @returns false if a stage is not registered, or if there is a cycle between stages
+	 */
+	bool ResolveStages(const TArray<FName>& Stages, TArray<FName>& OutOrderedStages) const;
+
+	/**
+	 * Start every pending stage whose prerequisites have succeeded, skip those whose prerequisites did not, and finish the
+	 * run once every stage is done.
+	 */
+	void AdvanceRun(int32 LocalUserNum, uint32 RunId);
+
+	/**
+	 * Handler for a stage of a run finishing.
+	 */
+	void OnStageFinished(bool bWasSuccessful, const FString& Error, int32 LocalUserNum, uint32 RunId, FName Stage);
+
+	/**
+	 * Build a report for a run as of the current time. Must be called with the bootstrap lock held.
+	 */
+	static FAccelByteLoginBootstrapReport MakeReport(const FBootstrapRun& Run, double CurrentTimeInSeconds);
+
+	/**
+	 * Register the built in stages with their default prerequisites.
+	 */
+	void RegisterBuiltInStages();
+
+	/**
+	 * Built in stage functions, each completing once the matching interface reports its request is done.
+	 */
+	void RunConnectLobbyStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const;
+	void RunFriendsStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const;
+	void RunBlockedPlayersStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const;
+	void RunEntitlementsStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const;
+	void RunCurrenciesStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const;
+	void RunUserProfileStage(int32 LocalUserNum, const FOnLoginBootstrapStageFinished& OnFinished) const;
+
+	/**
+	 * Mutex used to lock the stage definitions and runs while we read or update them
+	 */
+	mutable FCriticalSection BootstrapLock;
+
+	/**
+	 * Stages that can be requested, keyed by stage name
+	 */
+	TMap<FName, FStageDefinition> StageDefinitions;
+
+	/**
+	 * Stages that are run automatically once a local user logs in
+	 */
+	TArray<FName> RequestedStages;
+
+	/**
+	 * Runs in progress, keyed by local user number
+	 */
+	TMap<int32, FBootstrapRun> ActiveRuns;
+
+	/**
+	 * Reports for the last run to finish or be cancelled, keyed by local user number
+	 */
+	TMap<int32, FAccelByteLoginBootstrapReport> LastReports;
+
+	/**
+	 * Identifier to give to the next run that is started
+	 */
+	uint32 NextRunId = 1;
+
+	/**
+	 * AccelByte online subsystem instance that owns this bootstrap.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
@@ -0,0 +1,288 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+
+class FOnlineSubsystemAccelByte;
+class FOnlineOperationTraceAccelByte;
+
+/**
+ * Record a span covering the rest of the current scope, and make it the parent of any async task or span started within
+ * that scope. Starts a new trace if no trace is in progress on this thread. Does nothing when tracing is disabled.
+ *
+ * @param Subsystem AccelByte subsystem that the span should be recorded into
+ * @param Name Name of the span, will automatically be wrapped in the TEXT macro
+ */
+#define AB_OSS_TRACE_SPAN(Subsystem, Name) const FAccelByteTraceSpanScope ANONYMOUS_VARIABLE(AccelByteTraceSpan)(Subsystem, TEXT(Name))
+
+/**
+ * @brief Identifies a single span within a trace, along with the span that it is a child of.
+ *
+ * An online operation such as a login is given a trace ID when it is started, and each step of the operation, such as
+ * an async task or a nested request, records a span under that trace ID. Trace and span IDs are never zero, so a
+ * default constructed context means that no trace is in progress.
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelByteTraceContext
+{
+public:
+
+	/**
+	 * @brief ID of the trace that this span belongs to, shared by every span of a single online operation
+	 */
+	uint64 TraceId{0};
+
+	/**
+	 * @brief ID of this span
+	 */
+	uint64 SpanId{0};
+
+	/**
+	 * @brief ID of the span that this span is a child of, zero for the root span of a trace
+	 */
+	uint64 ParentSpanId{0};
+
+	/**
+	 * @brief Whether this context belongs to a trace.
+	 */
+	bool IsValid() const
+	{
+		return TraceId != 0;
+	}
+
+	/**
+	 * @brief Get the context of the span currently in progress on this thread, invalid if there is none.
+	 */
+	static FAccelByteTraceContext GetCurrent();
+
+	/**
+	 * @brief Set the context of the span in progress on this thread, returning the context that it replaces.
+	 */
+	static FAccelByteTraceContext SetCurrent(const FAccelByteTraceContext& InContext);
+
+};
+
+/**
+ * @brief A single span recorded for a trace, with its start and end in platform time.
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelByteTraceSpan
+{
+public:
+
+	/**
+	 * @brief Name of the step of the operation that this span covers
+	 */
+	FString Name{};
+
+	/**
+	 * @brief Trace, span and parent span IDs for this span
+	 */
+	FAccelByteTraceContext Context{};
+
+	/**
+	 * @brief Platform time in seconds that this span started at
+	 */
+	double StartTimeInSeconds{0.0};
+
+	/**
+	 * @brief Platform time in seconds that this span ended at
+	 */
+	double EndTimeInSeconds{0.0};
+
+	/**
+	 * @brief ID of the thread that this span was recorded on
+	 */
+	uint32 ThreadId{0};
+
+};
+
+/**
+ * Records spans for online operations, such as a login or joining a session, so that the critical path through the async
+ * tasks and requests that make up an operation can be inspected.
+ *
+ * A trace is started when a traced interface method is called, and its context is propagated to any async task created
+ * while that method runs. Each task records a span for its whole lifetime, with child spans for the time it spent queued,
+ * executing and waiting for its delegates. Tasks make their own span the current context while their SDK delegates,
+ * Finalize and TriggerDelegates run, so that anything they dispatch in turn is recorded under the same trace.
+ *
+ * Spans are kept in a bounded ring buffer and can be exported to a JSON file in the Chrome trace event format, to be
+ * opened in chrome://tracing or Perfetto. Tracing is disabled by default. Set `bEnableOperationTracing` in the
+ * `OnlineSubsystemAccelByte` section of `DefaultEngine.ini` to enable it on startup, and `OperationTraceMaxSpans` to
+ * change the amount of spans kept, or use the console command:
+ * ONLINE TRACE [START|STOP|CLEAR|EXPORT <optional file path>]
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineOperationTraceAccelByte : public TSharedFromThis<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Whether spans are currently being recorded.
+	 */
+	bool IsEnabled() const
+	{
+		return bIsEnabled;
+	}
+
+	/**
+	 * Start or stop recording spans. Spans recorded so far are kept until Clear is called.
+	 */
+	void SetEnabled(bool bInIsEnabled);
+
+	/**
+	 * Create the context for a new span as a child of the parent given, or as the root of a new trace if the parent is
+	 * invalid. Returns an invalid context if tracing is disabled.
+	 */
+	FAccelByteTraceContext CreateSpanContext(const FAccelByteTraceContext& Parent) const;
+
+	/**
+	 * Record a span that has ended. Does nothing if the context given is invalid.
+	 */
+	void AddSpan(const FString& Name, const FAccelByteTraceContext& Context, double StartTimeInSeconds, double EndTimeInSeconds);
+
+	/**
+	 * Get a copy of every span recorded, oldest first.
+	 */
+	TArray<FAccelByteTraceSpan> GetSpans() const;
+
+	/**
+	 * Get a copy of every span recorded for a single trace, oldest first.
+	 */
+	TArray<FAccelByteTraceSpan> GetSpansForTrace(uint64 TraceId) const;
+
+	/**
+	 * Discard every span recorded so far.
+	 */
+	void Clear();
+
+	/**
+	 * Write every span recorded so far to a file in the Chrome trace event format. Each span is extended to cover the
+	 * spans nested under it, so that the root span of an operation covers the whole operation.
+	 *
+	 * @param FilePath Path of the file to write, defaults to a timestamped file in the Saved/AccelByte/Traces directory
+	 * @param OutFilePath Path of the file that was written
+	 * @returns true if the file was written, false otherwise
+	 */
+	bool ExportChromeTrace(const FString& FilePath, FString& OutFilePath) const;
+
+	/**
+	 * Serialize every span recorded so far to a string in the Chrome trace event format.
+	 */
+	FString SerializeChromeTrace() const;
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the operation trace, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlineOperationTraceAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Override the amount of spans kept, used by exec tests to check the ring buffer. Discards any span recorded so far.
+	 */
+	void SetMaxSpans(int32 InMaxSpans);
+
+private:
+
+	/**
+	 * Mutex used to lock the recorded spans while we add to or read from them
+	 */
+	mutable FCriticalSection SpansLock;
+
+	/**
+	 * Ring buffer of recorded spans, overwriting the oldest span once full
+	 */
+	TArray<FAccelByteTraceSpan> Spans;
+
+	/**
+	 * Index in the ring buffer that the next span will be written to once the buffer is full
+	 */
+	int32 NextSpanIndex = 0;
+
+	/**
+	 * Maximum amount of spans kept in the ring buffer
+	 */
+	int32 MaxSpans = 20000;
+
+	/**
+	 * Whether spans are currently being recorded
+	 */
+	FThreadSafeBool bIsEnabled = false;
+
+	/**
+	 * Get a copy of every span recorded, oldest first. Must be called with the spans lock held.
+	 */
+	TArray<FAccelByteTraceSpan> GetOrderedSpans() const;
+
+	/**
+	 * AccelByte online subsystem instance that owns this trace.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
+
+/**
+ * Makes a trace context current on this thread for the lifetime of the scope, restoring the previous context once the
+ * scope ends. Does nothing if the context given is invalid.
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FAccelByteTraceContextScope
+{
+public:
+
+	explicit FAccelByteTraceContextScope(const FAccelByteTraceContext& InContext);
+
+	~FAccelByteTraceContextScope();
+
+private:
+
+	/** Context that was current before this scope, restored once the scope ends */
+	FAccelByteTraceContext PreviousContext;
+
+	/** Whether this scope changed the current context */
+	bool bHasSetContext = false;
+
+};
+
+/**
+ * Records a span for the lifetime of the scope, making it the current context on this thread while the scope is alive.
+ * Use through the AB_OSS_TRACE_SPAN macro.
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FAccelByteTraceSpanScope
+{
+public:
+
+	FAccelByteTraceSpanScope(const FOnlineSubsystemAccelByte* InSubsystem, const TCHAR* InName);
+
+	FAccelByteTraceSpanScope(const TSharedPtr<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe>& InTrace, const TCHAR* InName);
+
+	~FAccelByteTraceSpanScope();
+
+	/**
+	 * Get the context of the span recorded by this scope, invalid if tracing is disabled.
+	 */
+	const FAccelByteTraceContext& GetContext() const
+	{
+		return Context;
+	}
+
+private:
+
+	/** Trace that the span will be recorded into */
+	TSharedPtr<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe> Trace;
+
+	/** Name of the span */
+	const TCHAR* Name;
+
+	/** Context of the span recorded by this scope */
+	FAccelByteTraceContext Context;
+
+	/** Context that was current before this scope, restored once the scope ends */
+	FAccelByteTraceContext PreviousContext;
+
+	/** Platform time in seconds that this scope started at */
+	double StartTimeInSeconds = 0.0;
+
+};
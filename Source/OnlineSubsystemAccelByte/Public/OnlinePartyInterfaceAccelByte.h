@@ -100,12 +100,27 @@ private:
 
 };
 
+/**
+ * Parsed crossplay preference and platform for a single party member, read from the CROSSPLAY_OBJECT_NAME party attribute
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelBytePartyMemberCrossplayInfo
+{
+	/** Simplified native platform name that this member is playing on */
+	FString Platform;
+
+	/** Whether or not this member has crossplay enabled */
+	bool bCrossplayEnabled = false;
+};
+
 /** TPair for an invited user, with the first element being the user that invited them, and the second element being the invited user */
 using FInvitedPlayerPair = TPair<TSharedRef<const FUniqueNetIdAccelByteUser>, TSharedRef<const FUniqueNetIdAccelByteUser>>;
 
 /** Map of user IDs to party member instances */
 using FUserIdToPartyMemberMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, TSharedRef<FOnlinePartyMemberAccelByte>, FDefaultSetAllocator, TUserUniqueIdConstSharedRefMapKeyFuncs<TSharedRef<FOnlinePartyMemberAccelByte>>>;
 
+/** Map of AccelByte IDs to party member instances, used for lookups where only the backend ID is known */
+using FAccelByteIdToPartyMemberMap = TMap<FString, TSharedRef<FOnlinePartyMemberAccelByte>>;
+
 /**
  * Representation of a party on the AccelByte backend
  */
@@ -174,6 +189,9 @@ PACKAGE_SCOPE:
 	/** Method internally for interface and other tasks to get a member of this party by their ID */
 	TSharedPtr<const FOnlinePartyMemberAccelByte> GetMember(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId) const;
 
+	/** Internal method to get a mutable member of this party by their AccelByte ID, used when handling notifications */
+	TSharedPtr<FOnlinePartyMemberAccelByte> GetMemberByAccelByteId(const FString& AccelByteId) const;
+
 	/** Internal method to remove a party member from a party, usually used in notifications or on kick */
 	bool RemoveMember(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const TSharedRef<const FUniqueNetIdAccelByteUser>& RemovedUserId, const EMemberExitedReason& ExitReason);
 
@@ -195,21 +213,60 @@ PACKAGE_SCOPE:
 	/** Internal method to set party code associated with this party instance */
 	void SetPartyCode(const FString& PartyCode);
 
+	/**
+	 * Set a single attribute on our party data locally, and queue it to be written to party storage. All attribute
+	 * changes made within the same frame are merged and sent as one update containing only the changed keys. The party
+	 * data is replaced with a copy that holds the change and has no dirty keys, so data from GetPartyData only ever has
+	 * the keys that the game changes on it marked dirty.
+	 */
+	void SetPartyDataAttribute(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const FString& AttrName, const FVariantData& AttrValue);
+
+	/**
+	 * Remove a single attribute from our party data locally, and queue the removal to be written to party storage along
+	 * with any other changes made within the same frame. Replaces the party data with a copy in the same way as
+	 * SetPartyDataAttribute.
+	 */
+	void RemovePartyDataAttribute(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, const FString& AttrName);
+
+	/** Send all attribute changes queued since the last flush to party storage in a single update */
+	void FlushPendingPartyDataUpdates(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId);
+
+	/**
+	 * Handle the result of a write of flushed attribute changes. On failure, every key from the write that has not been
+	 * changed again since is queued once more with its current local value, up to a limited number of retries.
+	 */
+	void OnPartyDataUpdateComplete(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId, bool bWasSuccessful, const FOnlineKeyValuePairs<FString, FVariantData>& ChangedAttributes, const TArray<FString>& RemovedAttributes);
+
 	/**
 	 * Check whether this party is a crossplay enabled party or not. This will check the preferences of all members to see
 	 * if their crossplay flag is enabled.
 	 *
 	 * @return true if all members have crossplay enabled, false otherwise
 	 */
-	bool IsCrossplayParty();
+	bool IsCrossplayParty() const;
 
 	/**
 	 * Gets an array of the unique platforms that each party member is on
 	 */
-	TArray<FString> GetUniquePlatformsForParty();
+	const TArray<FString>& GetUniquePlatformsForParty() const;
+
+	/**
+	 * Get the parsed crossplay preference and platform stored in party data for the given member.
+	 *
+	 * @param AccelByteId AccelByte ID of the member to get crossplay information for
+	 * @param OutCrossplayInfo Crossplay preference and platform of the member, if found
+	 * @return true if the member has a valid crossplay entry in party data, false otherwise
+	 */
+	bool GetMemberCrossplayInfo(const FString& AccelByteId, FAccelBytePartyMemberCrossplayInfo& OutCrossplayInfo) const;
 
 private:
 
+	/**
+	 * Re-parse the crossplay attribute from our party data into the typed crossplay cache. Should be called whenever
+	 * the party data instance is replaced, so that crossplay queries do not need to walk the JSON object.
+	 */
+	void RefreshCrossplayCache();
+
 	/** Interface that owns this party instance, used to fire delegates on member changes */
 	TSharedRef<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe> OwningInterface;
 
@@ -222,12 +279,42 @@ private:
 	/** Map of users that are currently in this party */
 	FUserIdToPartyMemberMap UserIdToPartyMemberMap;
 
+	/**
+	 * Index of the members in UserIdToPartyMemberMap by their AccelByte ID. Composite IDs from notifications usually do
+	 * not carry platform information, so they will not hash the same as the full IDs that we store as member keys.
+	 */
+	FAccelByteIdToPartyMemberMap AccelByteIdToPartyMemberMap;
+
 	/** Array of user IDs representing players that we have invited to this party */
 	TArray<FInvitedPlayerPair> InvitedPlayers;
 
 	/** Instance of party data that is grabbed from the backend and modified locally */
 	TSharedRef<FOnlinePartyData> PartyData;
 
+	/** Parsed crossplay entries from party data, keyed by the AccelByte ID of each member */
+	TMap<FString, FAccelBytePartyMemberCrossplayInfo> MemberCrossplayInfoMap;
+
+	/** Unique platforms across all members, in the order that they appear in party data */
+	TArray<FString> UniquePlatforms;
+
+	/** Whether every member in party data has crossplay enabled, computed on each crossplay cache refresh */
+	bool bIsCrossplayParty = false;
+
+	/** Attributes changed locally that have not yet been sent to party storage */
+	FOnlineKeyValuePairs<FString, FVariantData> PendingChangedAttributes;
+
+	/** Attributes removed locally that have not yet been removed from party storage */
+	TSet<FString> PendingRemovedAttributes;
+
+	/** Whether a flush of pending attribute changes has already been scheduled for the next tick */
+	bool bIsPartyDataFlushScheduled = false;
+
+	/** Amount of attribute writes in a row that have failed, reset once a write succeeds */
+	int32 ConsecutivePartyDataWriteFailures = 0;
+
+	/** Queue a flush of pending attribute changes for the next tick if one is not already scheduled */
+	void SchedulePartyDataFlush(const TSharedRef<const FUniqueNetIdAccelByteUser>& LocalUserId);
+
 	friend class FOnlinePartySystemAccelByte;
 };
 
@@ -337,6 +424,21 @@ using FPartyInviteArray = TArray<TSharedRef<const FAccelBytePartyInvite>>;
 /** Map of user IDs to an array of invite structures */
 using FUserIdToPartyInvitesMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FPartyInviteArray, FDefaultSetAllocator, TUserUniqueIdConstSharedRefMapKeyFuncs<FPartyInviteArray>>;
 
+/**
+ * Lookup tables for a user's pending party invites, keyed by party ID and by the AccelByte ID of the inviter
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FAccelBytePartyInviteIndex
+{
+	/** Invites keyed by the string form of the party ID that they are for */
+	TMap<FString, TSharedRef<const FAccelBytePartyInvite>> ByPartyId;
+
+	/** Invites keyed by the AccelByte ID of the user that sent them */
+	TMap<FString, TSharedRef<const FAccelBytePartyInvite>> ByInviterId;
+};
+
+/** Map of user IDs to the lookup tables for their pending invites */
+using FUserIdToPartyInviteIndexMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FAccelBytePartyInviteIndex, FDefaultSetAllocator, TUserUniqueIdConstSharedRefMapKeyFuncs<FAccelBytePartyInviteIndex>>;
+
 class ONLINESUBSYSTEMACCELBYTE_API FOnlinePartySystemAccelByte : public IOnlinePartySystem, public TSharedFromThis<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe>
 {
 PACKAGE_SCOPE:
@@ -437,6 +539,17 @@ PACKAGE_SCOPE:
 	/** Convenience method to get first party for user. */
 	TSharedPtr<FOnlinePartyAccelByte> GetFirstPartyForUser(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId);
 
+	/**
+	 * Flush the pending party data attribute changes for the given party on the next tick, so that changes made
+	 * within the same frame are merged into one party storage update.
+	 */
+	void FlushPartyDataUpdatesNextTick(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<FOnlinePartyAccelByte>& Party);
+
+	/**
+	 * Dispatch a party storage update that only writes the attributes passed in, leaving all other keys as they are.
+	 */
+	void UpdatePartyDataAttributes(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FOnlinePartyIdAccelByte>& PartyId, const FOnlineKeyValuePairs<FString, FVariantData>& ChangedAttributes, const TArray<FString>& RemovedAttributes);
+
 	/** Internal method to get a non-const AccelByte party object for operating on */
 	TSharedPtr<FOnlinePartyAccelByte> GetPartyForUser(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FOnlinePartyIdAccelByte>& PartyId);
 
@@ -572,6 +685,9 @@ protected:
 	/** Map of user IDs associated with an array of party invites */
 	FUserIdToPartyInvitesMap UserIdToPartyInvitesMap;
 
+	/** Lookup tables mirroring UserIdToPartyInvitesMap, updated alongside every add or remove on a user's invite array */
+	FUserIdToPartyInviteIndexMap UserIdToPartyInviteIndexMap;
+
 	/** Store an array of delegates to execute when party join complete */
 	TArray<FOnPartyJoinedDelegate> OnPartyJoinedPendingTasks;
 
@@ -607,6 +723,12 @@ private:
 	/** Delegate handler for when party data changes */
 	void OnPartyDataChangeNotification(const FAccelByteModelsPartyDataNotif& Notification, TSharedRef<const FUniqueNetIdAccelByteUser> UserId);
 	
+	/** Add an invite to the given user's invite lookup tables, replacing any entries with the same party or inviter */
+	void AddInviteToIndex(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FAccelBytePartyInvite>& Invite);
+
+	/** Remove an invite from the given user's invite lookup tables, leaving entries that belong to other invites */
+	void RemoveInviteFromIndex(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId, const TSharedRef<const FAccelBytePartyInvite>& Invite);
+
 	/** Convenience function for executing code after party joined complete. Used for when local user is still joining a party */
 	void RunOnPartyJoinedComplete(const FOnPartyJoinedDelegate& Delegate);
 
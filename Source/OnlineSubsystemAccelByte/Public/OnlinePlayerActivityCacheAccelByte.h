@@ -0,0 +1,179 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+
+class FOnlineSubsystemAccelByte;
+
+/**
+ * @brief Plain data structure for the activity we track for a single player, keyed by their AccelByte ID.
+ */
+struct FAccelBytePlayerActivity
+{
+public:
+
+	/**
+	 * @brief Name of the platform that the player is playing on, blank if never set
+	 */
+	FString Platform{};
+
+	/**
+	 * @brief Time that the player was last registered to a session, or FDateTime::MinValue() if never set
+	 */
+	FDateTime JoinTime{FDateTime::MinValue()};
+
+	/**
+	 * @brief Time that the player was last unregistered from a session, or FDateTime::MinValue() if never set
+	 */
+	FDateTime DisconnectedTime{FDateTime::MinValue()};
+
+private:
+
+	/**
+	 * Platform time in seconds that this entry was last written to. Used to determine when the entry has expired.
+	 */
+	double LastUpdatedTimeInSeconds{0.0};
+
+	/**
+	 * Whether the player has been unregistered since they last joined. Unregistered players are evicted after the
+	 * shorter disconnected timeout rather than the idle timeout.
+	 */
+	bool bIsUnregistered{false};
+
+	/**
+	 * Setting the activity cache as a friend class to set the expiry bookkeeping
+	 */
+	friend class FOnlinePlayerActivityCacheAccelByte;
+
+};
+
+/**
+ * Tracks platform, join and disconnect times for players that pass through sessions hosted or joined by this instance.
+ *
+ * Entries are keyed by AccelByte ID and stored with native FDateTime timestamps. All access is guarded by a lock, as
+ * entries are written from async task and notification callbacks.
+ *
+ * To keep memory flat on long-lived servers, entries are evicted in two ways. Players that get unregistered from a
+ * session are evicted once `PlayerActivityDisconnectedTimeoutSeconds` has passed, so that their disconnect time can
+ * still be read shortly after they leave. Any other entry is evicted once it has not been written to for
+ * `PlayerActivityIdleTimeoutSeconds`. Both can be configured in the `OnlineSubsystemAccelByte` section of
+ * `DefaultEngine.ini`.
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlinePlayerActivityCacheAccelByte
+{
+public:
+
+	/**
+	 * Set the platform name for the player with the given AccelByte ID, creating an entry if one does not exist.
+	 */
+	void SetPlatform(const FString& AccelByteId, const FString& Platform);
+
+	/**
+	 * Mark the player with the given AccelByte ID as registered to a session at the given time.
+	 */
+	void SetJoinTime(const FString& AccelByteId, const FDateTime& JoinTime);
+
+	/**
+	 * Mark the player with the given AccelByte ID as unregistered from a session at the given time. The entry will
+	 * be evicted once the disconnected timeout has passed, unless the player joins again before then.
+	 */
+	void SetDisconnectedTime(const FString& AccelByteId, const FDateTime& DisconnectedTime);
+
+	/**
+	 * Attempt to get a copy of the activity tracked for the player with the given AccelByte ID.
+	 *
+	 * @returns true if an entry was found for the player, false otherwise
+	 */
+	bool GetPlayerActivity(const FString& AccelByteId, FAccelBytePlayerActivity& OutActivity) const;
+
+	/**
+	 * Remove any activity tracked for the player with the given AccelByte ID immediately.
+	 */
+	void RemovePlayer(const FString& AccelByteId);
+
+	/**
+	 * Get the amount of players that are currently tracked in this cache.
+	 */
+	int32 Num() const;
+
+	/**
+	 * Get the amount of memory in bytes currently allocated by the cache's containers.
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the activity cache, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlinePlayerActivityCacheAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Evicts every entry that has exceeded its timeout, returning the number of entries evicted.
+	 *
+	 * @param CurrentTimeInSeconds Platform time to compare each entry's last update against
+	 */
+	int32 Purge(double CurrentTimeInSeconds);
+
+	/**
+	 * Purges expired entries at most once per purge interval. Do not call this method directly, it will be called from
+	 * the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
+	/**
+	 * Override the timeouts read from config, used by exec tests to force eviction.
+	 */
+	void SetTimeouts(double InIdleTimeoutSeconds, double InDisconnectedTimeoutSeconds);
+
+private:
+
+	/**
+	 * Get the entry for the player, creating it if needed, and refresh its last updated time. Must be called with the
+	 * cache lock held.
+	 */
+	FAccelBytePlayerActivity& FindOrAddEntry(const FString& AccelByteId);
+
+	/**
+	 * Mutex used to lock the activity map while we add to or retrieve from it
+	 */
+	mutable FCriticalSection CacheLock;
+
+	/**
+	 * Map of AccelByte IDs to the activity we have tracked for that player
+	 */
+	TMap<FString, FAccelBytePlayerActivity> AccelByteIdToActivityMap;
+
+	/**
+	 * Length of time in seconds that an entry will stay in the cache without being written to before being evicted.
+	 * Defaults to 3600 seconds, or one hour.
+	 */
+	double IdleTimeoutSeconds = 3600.0;
+
+	/**
+	 * Length of time in seconds that an unregistered player will stay in the cache before being evicted.
+	 * Defaults to 300 seconds, or five minutes.
+	 */
+	double DisconnectedTimeoutSeconds = 300.0;
+
+	/**
+	 * Interval in seconds between purges run from the ticker.
+	 */
+	float PurgeIntervalSeconds = 30.0f;
+
+	/**
+	 * Seconds elapsed since the last purge was run from the ticker.
+	 */
+	float TimeSinceLastPurgeSeconds = 0.0f;
+
+	/**
+	 * AccelByte online subsystem instance that owns this cache.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
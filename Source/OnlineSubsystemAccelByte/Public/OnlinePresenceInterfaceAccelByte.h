@@ -4,6 +4,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/List.h"
 #if ENGINE_MAJOR_VERSION >= 5
 #include "Online/CoreOnline.h"
 #else
@@ -17,6 +18,12 @@
 
 class FOnlineSubsystemAccelByte;
 
+/**
+ * Delegate fired once per batch of presence notifications applied to the cache, with the IDs of every user whose
+ * presence changed in that batch. Per-user OnPresenceReceived delegates are still fired for each of these users.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPresenceBatchReceived, int32 /*LocalUserNum*/, const TArray<TSharedRef<const FUniqueNetIdAccelByteUser>>& /*UpdatedUserIds*/);
+typedef FOnPresenceBatchReceived::FDelegate FOnPresenceBatchReceivedDelegate;
 
 class FOnlineUserPresenceAccelByte : public FOnlineUserPresence
 {
@@ -90,6 +97,12 @@ public:
 	//~ Begin Custom Presence
 	virtual void PlatformQueryPresence(const FUniqueNetId& User, const FOnPresenceTaskCompleteDelegate& Delegate = FOnPresenceTaskCompleteDelegate());
 	virtual EOnlineCachedResult::Type GetPlatformCachedPresence(const FUniqueNetId& User, TSharedPtr<FOnlineUserPresence>& OutPresence);
+
+	/**
+	 * Delegate fired once per tick with every user whose presence was updated by the notifications received since the
+	 * last tick. Fired after the cache has been updated and the per-user OnPresenceReceived delegates have been fired.
+	 */
+	DEFINE_ONLINE_PLAYER_DELEGATE_ONE_PARAM(MAX_LOCAL_PLAYERS, OnPresenceBatchReceived, const TArray<TSharedRef<const FUniqueNetIdAccelByteUser>>& /*UpdatedUserIds*/);
 	//~ End Custom Presence
 
 PACKAGE_SCOPE:
@@ -103,6 +116,21 @@ PACKAGE_SCOPE:
 	/** Used to update cached Presence */
 	TSharedRef<FOnlineUserPresenceAccelByte> FindOrCreatePresence(const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId);
 
+	/**
+	 * Evict the cached presence for a user, along with any notification for them that has not been applied yet. Used
+	 * when a user is no longer a friend or has been blocked, as we will stop receiving updates for them.
+	 */
+	void RemoveCachedPresence(const FString& AccelByteId);
+
+	/** Get the amount of users that currently have presence cached */
+	int32 GetCachedPresenceNum() const;
+
+	/**
+	 * Applies every presence notification received since the last tick to the cache in one batch. Do not call this
+	 * method directly, it will be called from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
 protected: 
 
 	/** Instance of the subsystem that created this interface */
@@ -119,8 +147,60 @@ protected:
 
 private: 
 
-	/** All presence information we have */
-	TMap<FString, TSharedRef<FOnlineUserPresenceAccelByte>> CachedPresenceByUserId;
+	/** Presence cached for a single user, along with the ID it was created for so that it can be reused for delegates */
+	struct FCachedPresenceEntry
+	{
+		FCachedPresenceEntry(const TSharedRef<const FUniqueNetIdAccelByteUser>& InUserId)
+			: UserId(InUserId)
+			, Presence(MakeShared<FOnlineUserPresenceAccelByte>())
+		{
+		}
+
+		TSharedRef<const FUniqueNetIdAccelByteUser> UserId;
+		TSharedRef<FOnlineUserPresenceAccelByte> Presence;
+
+		/** Platform time in seconds that this entry was last written to */
+		double LastUpdatedTimeInSeconds{0.0};
+
+		/** Node for this entry in CachedPresenceLRU, owned by the list */
+		TDoubleLinkedList<FString>::TDoubleLinkedListNode* LRUNode{nullptr};
+	};
+
+	/**
+	 * Find or add the cache entry for the given user and mark it as the most recently updated. Must be called with the
+	 * cache lock held.
+	 */
+	FCachedPresenceEntry& TouchCachedPresence(const FString& AccelByteId, const TSharedRef<const FUniqueNetIdAccelByteUser>& UserId);
+
+	/**
+	 * Evict the least recently updated entries until the cache is within MaxCachedPresenceEntries. Must be called with
+	 * the cache lock held.
+	 */
+	void TrimCache();
+
+	/** Mutex used to lock the presence cache while we add to or retrieve from it */
+	mutable FCriticalSection CacheLock;
+
+	/** All presence information we have, keyed by AccelByte ID */
+	TMap<FString, FCachedPresenceEntry> CachedPresenceByUserId;
+
+	/** AccelByte IDs of cached presence ordered from least to most recently updated, so eviction never has to sort */
+	TDoubleLinkedList<FString> CachedPresenceLRU;
+
+	/** Mutex used to lock the pending notifications, as they are queued from the lobby websocket */
+	FCriticalSection PendingNotificationsLock;
+
+	/**
+	 * Presence notifications received since the last tick, keyed by local user num and then by the AccelByte ID of the
+	 * user the notification is for. Only the latest notification for each user is kept.
+	 */
+	TMap<int32, TMap<FString, FAccelByteModelsUsersPresenceNotice>> PendingNotifications;
+
+	/**
+	 * Maximum amount of users to keep presence cached for before evicting the least recently updated. Can be configured
+	 * with `MaxCachedPresenceEntries` in the `OnlineSubsystemAccelByte` section of `DefaultEngine.ini`, defaults to 2000.
+	 */
+	int32 MaxCachedPresenceEntries = 2000;
 };
 
 typedef TSharedPtr<FOnlinePresenceAccelByte, ESPMode::ThreadSafe> FOnlinePresenceAccelBytePtr;
\ No newline at end of file
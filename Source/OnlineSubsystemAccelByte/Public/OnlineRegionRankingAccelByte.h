@@ -0,0 +1,216 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+
+class FOnlineSubsystemAccelByte;
+
+/**
+ * Delegate fired by a latency source once it has latencies for each region, in milliseconds.
+ */
+DECLARE_DELEGATE_OneParam(FOnRegionLatenciesReceived, const TArray<TPair<FString, float>>& /*Latencies*/);
+
+/**
+ * Function used to request fresh region latencies. Should fire the delegate passed in once latencies are available, and
+ * may do so synchronously. By default this pings QoS servers through the API client of the cached local user.
+ */
+using FRegionLatencySource = TFunction<void(const FOnRegionLatenciesReceived&)>;
+
+/**
+ * @brief Smoothed latency information for a single QoS region.
+ */
+struct FAccelByteRegionLatency
+{
+public:
+
+	/**
+	 * @brief Name of the region these latencies are for
+	 */
+	FString Region{};
+
+	/**
+	 * @brief Exponentially weighted moving average of latency samples for this region, in milliseconds
+	 */
+	float SmoothedLatencyMs{0.0f};
+
+	/**
+	 * @brief Smoothed mean deviation between consecutive latency samples for this region, in milliseconds
+	 */
+	float JitterMs{0.0f};
+
+	/**
+	 * @brief Latest raw latency sample received for this region, in milliseconds
+	 */
+	float LastSampleMs{0.0f};
+
+	/**
+	 * @brief Number of samples that have been folded into the smoothed values
+	 */
+	int32 SampleCount{0};
+
+	/**
+	 * @brief Score used to rank this region, lower is better. Smoothed latency plus weighted jitter.
+	 */
+	float Score{0.0f};
+
+};
+
+/**
+ * Keeps a ranking of QoS regions by latency to the player, so that callers such as GetRegionList can read a cached
+ * ranking rather than sorting latencies on every call.
+ *
+ * Each time a new set of latencies comes in, each region's latency is smoothed with an exponentially weighted moving
+ * average and a jitter estimate, and the ranking is rebuilt. Identical sets of latencies, such as the same SDK cache
+ * being read twice, are ignored. To stop the preferred region from flapping between two regions with similar latency,
+ * the current preferred region is only replaced once another region beats its score by a configurable margin.
+ *
+ * GetRegionList folds in the SDK's cached latencies each time it is called, so the ranking follows any QoS pings made
+ * elsewhere. Latencies can also be refreshed periodically in the background through the latency source, which is off
+ * unless a re-ping interval is configured. The following values can be configured in the `OnlineSubsystemAccelByte`
+ * section of `DefaultEngine.ini`:
+ * - `QosLatencySmoothingFactor` weight of each new sample in the moving average, defaults to 0.25
+ * - `QosJitterWeight` multiplier applied to jitter when scoring a region, defaults to 1.0
+ * - `QosPreferredRegionHysteresis` fraction a region must beat the preferred region's score by to replace it, defaults to 0.1
+ * - `QosRepingIntervalSeconds` seconds between background re-pings, 0 or less to disable, defaults to 0
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineRegionRankingAccelByte : public TSharedFromThis<FOnlineRegionRankingAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	/**
+	 * Fold a set of latencies into the ranking. Does nothing if the latencies are identical to the last set received.
+	 *
+	 * @param Latencies Pairs of region name and latency in milliseconds
+	 * @returns true if the ranking was recomputed, false if the latencies were unchanged
+	 */
+	bool AddLatencySamples(const TArray<TPair<FString, float>>& Latencies);
+
+	/**
+	 * Get the regions ordered from most to least preferred. Empty until latencies have been received.
+	 */
+	TArray<FString> GetRankedRegions() const;
+
+	/**
+	 * Get the most preferred region, or an empty string if latencies have not been received.
+	 */
+	FString GetPreferredRegion() const;
+
+	/**
+	 * Get the smoothed latency information for a region.
+	 *
+	 * @returns true if the region has been seen, false otherwise
+	 */
+	bool GetRegionLatency(const FString& Region, FAccelByteRegionLatency& OutRegionLatency) const;
+
+	/**
+	 * Request fresh latencies from the latency source immediately, rather than waiting for the next re-ping.
+	 */
+	void RequestLatencies();
+
+	/**
+	 * Replace the source used to request fresh latencies, such as with a fake source for testing.
+	 */
+	void SetLatencySource(const FRegionLatencySource& InLatencySource);
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the region ranking, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlineRegionRankingAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Re-pings regions once the re-ping interval has passed. Do not call this method directly, it will be called from the
+	 * owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
+	/**
+	 * Override the re-ping interval read from config, used by exec tests to drive background re-pings.
+	 */
+	void SetRepingIntervalSeconds(float InRepingIntervalSeconds);
+
+private:
+
+	/**
+	 * Rebuild the ranked region list from the current region latencies. Must be called with the ranking lock held.
+	 */
+	void RebuildRanking();
+
+	/**
+	 * Default latency source, pinging QoS servers with the API client of the cached local user.
+	 */
+	void RequestLatenciesFromQos(const FOnRegionLatenciesReceived& OnLatenciesReceived) const;
+
+	/**
+	 * Mutex used to lock the ranking while we update or read from it
+	 */
+	mutable FCriticalSection RankingLock;
+
+	/**
+	 * Smoothed latencies for each region we have received samples for, keyed by region name
+	 */
+	TMap<FString, FAccelByteRegionLatency> RegionLatencies;
+
+	/**
+	 * Regions ordered from most to least preferred
+	 */
+	TArray<FString> RankedRegions;
+
+	/**
+	 * Last set of raw latencies received, used to skip folding in the same samples twice
+	 */
+	TArray<TPair<FString, float>> LastReceivedLatencies;
+
+	/**
+	 * Source used to request fresh latencies
+	 */
+	FRegionLatencySource LatencySource;
+
+	/**
+	 * Weight of each new sample in the moving average of a region's latency
+	 */
+	float SmoothingFactor = 0.25f;
+
+	/**
+	 * Multiplier applied to a region's jitter when scoring it
+	 */
+	float JitterWeight = 1.0f;
+
+	/**
+	 * Fraction that a region's score must beat the preferred region's score by to become the new preferred region
+	 */
+	float PreferredRegionHysteresis = 0.1f;
+
+	/**
+	 * Seconds between background re-pings, disabled if zero or less. Off by default, as each re-ping sends traffic to
+	 * every QoS region.
+	 */
+	float RepingIntervalSeconds = 0.0f;
+
+	/**
+	 * Seconds elapsed since latencies were last requested from the ticker
+	 */
+	float TimeSinceLastRepingSeconds = 0.0f;
+
+	/**
+	 * Whether a request to the latency source is in flight, so that we don't stack up re-pings
+	 */
+	FThreadSafeBool bIsRequestInFlight = false;
+
+	/**
+	 * Handler for latencies coming back from the latency source
+	 */
+	void OnLatenciesReceived(const TArray<TPair<FString, float>>& Latencies);
+
+	/**
+	 * AccelByte online subsystem instance that owns this ranking.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
@@ -0,0 +1,174 @@
+// Copyright (c) 2022 AccelByte Inc. All Rights Reserved.
+// This is licensed software from AccelByte Inc, for limitations
+// and restrictions contact your company contract manager.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OnlineSubsystemAccelByteTypes.h"
+#include "OnlineDelegateMacros.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+class FOnlineSubsystemAccelByte;
+
+/**
+ * Delegate fired on the game thread when heartbeats start or stop being sent successfully.
+ */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnServerHeartbeatHealthChanged, bool /*bIsHealthy*/);
+typedef FOnServerHeartbeatHealthChanged::FDelegate FOnServerHeartbeatHealthChangedDelegate;
+
+/**
+ * Sends keepalive heartbeats to the watchdog and DS hub for a dedicated server from its own thread, rather than from the
+ * game thread's tick.
+ *
+ * Heartbeats that are sent from the tick are delayed whenever the game thread hitches, such as during level streaming,
+ * garbage collection or a heavy simulation frame. The orchestrator may then treat the server as unhealthy. This thread
+ * sleeps on an event between heartbeats, so it keeps to its interval no matter what the game thread is doing.
+ *
+ * Each heartbeat is sent straight from this thread over whichever of the watchdog and DS hub websockets are connected.
+ * The SDK queues websocket messages for the websocket service thread to send, so nothing waits on the game thread. Sends
+ * are made while holding the server connection lock, which the session interface also holds while it connects,
+ * disconnects or sends its own messages over these websockets, so that the two threads never use a connection at once.
+ *
+ * The heartbeat thread never touches game thread state. When heartbeats start or stop being sent successfully, the
+ * change is marshalled back to the game thread and fired through OnServerHeartbeatHealthChanged.
+ *
+ * The following values can be configured in the `OnlineSubsystemAccelByte` section of `DefaultEngine.ini`:
+ * - `bUseServerHeartbeatThread` whether registering a server starts the heartbeat thread, defaults to true
+ * - `ServerHeartbeatIntervalSeconds` seconds between heartbeats, defaults to 5
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineServerHeartbeatAccelByte : public FRunnable, public TSharedFromThis<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe>
+{
+public:
+
+	virtual ~FOnlineServerHeartbeatAccelByte() override;
+
+	/**
+	 * Start the heartbeat thread, sending the first heartbeat immediately. Does nothing if the thread is already running.
+	 */
+	void StartHeartbeat();
+
+	/**
+	 * Stop the heartbeat thread, waiting for any heartbeat being sent to finish. Does nothing if the thread is not running.
+	 */
+	void StopHeartbeat();
+
+	/**
+	 * Whether the heartbeat thread is running.
+	 */
+	bool IsHeartbeatRunning() const;
+
+	/**
+	 * Get the amount of heartbeats sent successfully since the subsystem started.
+	 */
+	int64 GetHeartbeatCount() const;
+
+	/**
+	 * Get the seconds since a heartbeat was last sent successfully, or a negative value if none have been sent.
+	 */
+	double GetSecondsSinceLastHeartbeat() const;
+
+	/**
+	 * Get the seconds between heartbeats.
+	 */
+	float GetHeartbeatInterval() const;
+
+	/**
+	 * Set the seconds between heartbeats. Takes effect immediately if the thread is running.
+	 */
+	void SetHeartbeatInterval(float InIntervalSeconds);
+
+	/**
+	 * Get the lock held while the watchdog or DS hub websockets are used, which anything connecting, disconnecting or
+	 * sending over them should also hold so that it never runs at the same time as a heartbeat being sent.
+	 */
+	static FCriticalSection& GetServerConnectionLock();
+
+	DEFINE_ONLINE_DELEGATE_ONE_PARAM(OnServerHeartbeatHealthChanged, bool /*bIsHealthy*/);
+
+	//~ Begin FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable
+
+PACKAGE_SCOPE:
+
+	/**
+	 * Constructs the server heartbeat, should only be one of these in existence. Will be owned by the subsystem instance
+	 * that created it.
+	 */
+	FOnlineServerHeartbeatAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
+
+	/**
+	 * Whether registering a server should start the heartbeat thread.
+	 */
+	bool ShouldStartWithServer() const;
+
+private:
+
+	/**
+	 * Send a single heartbeat to the watchdog and DS hub, over whichever of them are connected. Called on the heartbeat
+	 * thread.
+	 */
+	void SendHeartbeat();
+
+	/**
+	 * Count a heartbeat and track whether heartbeats are healthy. Called on the heartbeat thread.
+	 */
+	void RecordHeartbeatResult(bool bWasSent);
+
+	/**
+	 * Mutex used to lock the heartbeat timing while we update or read from it
+	 */
+	mutable FCriticalSection HeartbeatLock;
+
+	/**
+	 * Thread that heartbeats are sent from, valid while running
+	 */
+	TUniquePtr<FRunnableThread> HeartbeatThread;
+
+	/**
+	 * Event the heartbeat thread sleeps on between heartbeats, triggered to wake it early when stopping or when the
+	 * interval changes
+	 */
+	FEvent* WakeEvent = nullptr;
+
+	/**
+	 * Whether the heartbeat thread has been asked to stop
+	 */
+	FThreadSafeBool bIsStopRequested = false;
+
+	/**
+	 * Amount of heartbeats sent successfully, counting a heartbeat once however many connections it went out over
+	 */
+	FThreadSafeCounter64 HeartbeatCount;
+
+	/**
+	 * Platform time in seconds that a heartbeat was last sent successfully, or a negative value if none have been sent
+	 */
+	double LastHeartbeatTimeInSeconds = -1.0;
+
+	/**
+	 * Whether the last heartbeat was sent successfully. Guarded by HeartbeatLock.
+	 */
+	bool bIsHealthy = false;
+
+	/**
+	 * Seconds between heartbeats
+	 */
+	float IntervalSeconds = 5.0f;
+
+	/**
+	 * Whether registering a server should start the heartbeat thread
+	 */
+	bool bStartWithServer = true;
+
+	/**
+	 * AccelByte online subsystem instance that owns this heartbeat.
+	 */
+	FOnlineSubsystemAccelByte* Subsystem;
+
+};
@@ -51,6 +51,12 @@ class IOnlineSubsystem;
   */
 #define SETTING_SUBGAMEMODE FName(TEXT("ABSUBGAMEMODE"))
 
+/**
+ * Version of the LAN beacon response format, written as the first byte of each response. Responses with any other
+ * version are ignored by searching clients. Bump this whenever the layout of a response changes.
+ */
+#define LAN_BEACON_FORMAT_VERSION 2
+
 /**
  * Internal structure for tracking matches that we are still getting information for from the matchmaker and other queries.
  */
@@ -158,6 +164,39 @@ private:
 	/** Handles advertising sessions over LAN and client searches */
 	FLANSession LANSessionManager;
 
+	/**
+	 * Advertised settings of a hosted session encoded for LAN beacons. Lets beacon responses reuse the encoded block
+	 * until any advertised setting changes, or the session is updated or destroyed.
+	 */
+	struct FLANBeaconSettingsCache
+	{
+		/** Setting count followed by each encoded key and setting */
+		TArray<uint8> EncodedSettings;
+
+		/** Hash of the advertised settings keys, values and advertisement types when the block was encoded */
+		uint32 SettingsHash = 0;
+
+		/** Amount of advertised settings in the encoded block */
+		int32 AdvertisedNum = 0;
+
+		/** Whether the encoded block is usable, false if it did not fit in a beacon */
+		bool bIsEncoded = false;
+	};
+
+	/** Encoded advertised settings for each session we have answered LAN queries for, keyed by session name */
+	TMap<FName, FLANBeaconSettingsCache> LANBeaconSettingsCache;
+
+	/**
+	 * Rebuild the encoded advertised settings in the cache from the session settings, in a single pass over the settings.
+	 */
+	static void EncodeLANBeaconSettings(const FOnlineSessionSettings& SessionSettings, FLANBeaconSettingsCache& OutCache);
+
+	/**
+	 * Hash the advertised settings of a session without encoding them. Settings can be changed in place through
+	 * GetSessionSettings without going through the interface, so the cache is checked against this on every beacon.
+	 */
+	static uint32 HashLANBeaconSettings(const FOnlineSessionSettings& SessionSettings);
+
 	/**
 	 * Session search handle that is currently being used, this will be set either explicitly by the user when
 	 * StartMatchmaking is called, or when a start matchmaking notification is received and we need a handle.
@@ -329,9 +368,15 @@ PACKAGE_SCOPE:
 	uint32 JoinLANSession(int32 PlayerNum, class FNamedOnlineSession* Session, const class FOnlineSession* SearchSession);
 	uint32 FindLANSession();
 	uint32 FinalizeLANSearch();	
-	void AppendSessionToPacket(class FNboSerializeToBufferAccelByte& Packet, class FOnlineSession* Session);
-	void AppendSessionSettingsToPacket(class FNboSerializeToBufferAccelByte& Packet, FOnlineSessionSettings* SessionSettings);	
-	void ReadSessionFromPacket(class FNboSerializeFromBufferAccelByte& Packet, class FOnlineSession* Session);
+	void AppendSessionToPacket(class FNboSerializeToBufferAccelByte& Packet, class FNamedOnlineSession* Session);
+	void AppendSessionSettingsToPacket(class FNboSerializeToBufferAccelByte& Packet, FName SessionName, FOnlineSessionSettings* SessionSettings);
+
+	/**
+	 * Read a session from a LAN beacon response.
+	 *
+	 * @returns false if the response was written with a different LAN_BEACON_FORMAT_VERSION, in which case nothing else is read
+	 */
+	bool ReadSessionFromPacket(class FNboSerializeFromBufferAccelByte& Packet, class FOnlineSession* Session);
 	void ReadSettingsFromPacket(class FNboSerializeFromBufferAccelByte& Packet, FOnlineSessionSettings& SessionSettings);
 	void OnValidQueryPacketReceived(uint8* PacketData, int32 PacketLength, uint64 ClientNonce);
 	void OnValidResponsePacketReceived(uint8* PacketData, int32 PacketLength);
@@ -339,6 +384,12 @@ PACKAGE_SCOPE:
 	bool IsHost(const FNamedOnlineSession& Session) const;
 	static void SetPortFromNetDriver(const FOnlineSubsystemAccelByte& Subsystem, const TSharedPtr<FOnlineSessionInfo>& SessionInfo);
 
+	/**
+	 * Drop the encoded LAN beacon settings for a session, so that the next beacon encodes its current settings. Called
+	 * whenever the session is updated or removed.
+	 */
+	void InvalidateLANBeaconSettings(FName SessionName);
+
 public:
 
 	/**
@@ -21,6 +21,7 @@
 #include "Models/AccelByteDSHubModels.h"
 #include "AccelByteNetworkingStatus.h"
 #include "GameServerApi/AccelByteServerWatchdogApi.h"
+#include "HAL/ThreadSafeBool.h"
 
 class FInternetAddr;
 class FNamedOnlineSession;
@@ -399,6 +400,71 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSessionInviteRejected, FName /*SessionNa
 typedef FOnSessionInviteRejected::FDelegate FOnSessionInviteRejectedDelegate;
 //~ End custom delegates
 
+/**
+ * Phases that a dedicated server goes through between starting up and being ready to accept players.
+ */
+enum class EAccelByteServerStartupPhase : uint8
+{
+	/** Authenticating the server with client credentials */
+	ServerLogin = 0,
+	/** Registering the server to Armada, either as a local or remote server */
+	RegisterServer,
+	/** Connecting to the DS hub websocket, finishing once the connection has been established */
+	ConnectToDSHub,
+	/** Retrieving the session that claimed this server from the backend */
+	ClaimedSessionFetch,
+	/** Telling the watchdog that the server is ready, recorded as a single point in time */
+	ReadyToWatchdog
+};
+
+/** Amount of phases in EAccelByteServerStartupPhase */
+constexpr int32 AccelByteServerStartupPhaseCount = static_cast<int32>(EAccelByteServerStartupPhase::ReadyToWatchdog) + 1;
+
+/**
+ * @brief Timing of a single phase of dedicated server startup. Times are in seconds since the process started.
+ */
+struct FAccelByteServerStartupPhaseTiming
+{
+public:
+
+	/**
+	 * @brief Phase that this timing is for
+	 */
+	EAccelByteServerStartupPhase Phase{EAccelByteServerStartupPhase::ServerLogin};
+
+	/**
+	 * @brief Seconds since process start that the phase began, or a negative value if it has not begun
+	 */
+	double StartSeconds{-1.0};
+
+	/**
+	 * @brief Seconds since process start that the phase finished, or a negative value if it has not finished
+	 */
+	double EndSeconds{-1.0};
+
+	/**
+	 * @brief Whether the phase finished successfully
+	 */
+	bool bWasSuccessful{false};
+
+	/**
+	 * @brief Whether the phase has finished
+	 */
+	bool IsComplete() const
+	{
+		return EndSeconds >= 0.0;
+	}
+
+	/**
+	 * @brief Get the time the phase took, or zero if it has not finished
+	 */
+	double GetDurationSeconds() const
+	{
+		return IsComplete() ? FMath::Max(EndSeconds - StartSeconds, 0.0) : 0.0;
+	}
+
+};
+
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineSessionV2AccelByte : public IOnlineSession, public TSharedFromThis<FOnlineSessionV2AccelByte, ESPMode::ThreadSafe>
 {
 public:
@@ -546,6 +612,11 @@ public:
 	 */
 	FNamedOnlineSession* GetNamedSessionById(const FString& SessionIdString);
 
+	/**
+	 * Attempt to get a named session instance by the ID of the backfill ticket stored in its settings
+	 */
+	FNamedOnlineSession* GetNamedSessionByBackfillTicketId(const FString& BackfillTicketId);
+
 	/**
 	 * Register a dedicated server to Armada, either as a local server for testing, or as a managed Armada pod.
 	 * This will also establish a connection with the DSHub service for session updates.
@@ -557,6 +628,17 @@ public:
 	 */
 	void UnregisterServer(FName SessionName, const FOnUnregisterServerComplete& Delegate = FOnUnregisterServerComplete());
 
+	/**
+	 * Get the timing of each dedicated server startup phase that has begun so far, in the order they are listed in
+	 * EAccelByteServerStartupPhase.
+	 */
+	TArray<FAccelByteServerStartupPhaseTiming> GetServerStartupTimings() const;
+
+	/**
+	 * Log the timing of each dedicated server startup phase that has begun so far.
+	 */
+	void LogServerStartupTimings() const;
+
 	/**
 	 * Get session type from session by its name
 	 */
@@ -1055,6 +1137,11 @@ PACKAGE_SCOPE:
 	 */
 	void DisconnectFromDSHub();
 
+	/**
+	 * Whether a connection to the DS hub has been requested and has not since failed or been disconnected.
+	 */
+	bool HasRequestedDSHubConnection() const;
+
 	/**
 	 * Send ready message to Watchdog
 	 */
@@ -1065,6 +1152,16 @@ PACKAGE_SCOPE:
 	 */
 	void DisconnectFromWatchdog();
 
+	/**
+	 * Mark a dedicated server startup phase as begun. Only the first attempt at each phase is recorded.
+	 */
+	void BeginServerStartupPhase(EAccelByteServerStartupPhase Phase);
+
+	/**
+	 * Mark a dedicated server startup phase as finished, if it has begun and not already finished.
+	 */
+	void EndServerStartupPhase(EAccelByteServerStartupPhase Phase, bool bWasSuccessful);
+
 private:
 	/** Parent subsystem of this interface instance */
 	FOnlineSubsystemAccelByte* AccelByteSubsystem = nullptr;
@@ -1075,9 +1172,56 @@ private:
 	/** Sessions stored in this interface, associated by session name */
 	TMap<FName, TSharedPtr<FNamedOnlineSession>> Sessions;
 
+	/**
+	 * Index of backend session IDs to the name of the session stored in Sessions. Updated when a session is added or
+	 * removed, and whenever its session info is set through SetNamedSessionInfo. Guarded by SessionLock.
+	 */
+	TMap<FString, FName> SessionIdToSessionNameMap;
+
+	/**
+	 * Hashed copy of the RegisteredPlayers array for each session, associated by session name. Used to check membership
+	 * without scanning the array. Created when a session is added and only changed through UpdateRegisteredPlayers.
+	 * Guarded by SessionLock.
+	 */
+	TMap<FName, TSet<FUniqueNetIdRef, FUniqueNetIdConstSharedRefSetKeyFuncs>> SessionNameToRegisteredPlayersMap;
+
+	/**
+	 * Set the session info of a named session, moving its entry in the session ID index to the ID of the new info.
+	 * Session info of a named session should always be set through this rather than assigned directly.
+	 */
+	void SetNamedSessionInfo(FNamedOnlineSession& Session, const TSharedRef<FOnlineSessionInfoAccelByteV2>& SessionInfo);
+
+	/**
+	 * Get the hashed set of registered players for the session. Must be called with SessionLock held.
+	 */
+	const TSet<FUniqueNetIdRef, FUniqueNetIdConstSharedRefSetKeyFuncs>& GetRegisteredPlayerSet(const FNamedOnlineSession& Session);
+
+	/**
+	 * Register or unregister players in the session, updating both its RegisteredPlayers array and the hashed set of
+	 * registered players. Every change to the registered players of a session goes through here so that the two never
+	 * drift apart. Must be called with SessionLock held.
+	 *
+	 * @param Players Players to register or unregister
+	 * @param bRegister Whether to register the players rather than unregister them
+	 * @param OutChangedPlayers Players that were actually added or removed, skipping ones already in that state
+	 */
+	void UpdateRegisteredPlayers(FNamedOnlineSession& Session, const TArray<FUniqueNetIdRef>& Players, bool bRegister, TArray<FUniqueNetIdRef>& OutChangedPlayers);
+
 	/** Flag denoting whether there is already a task in progress to get a session associated with a server */
 	bool bIsGettingServerClaimedSession{ false };
 
+	/**
+	 * Flag denoting whether a connection to the DS hub has been requested, so that it is not requested twice. Cleared if
+	 * the connection fails so that it can be requested again.
+	 */
+	FThreadSafeBool bHasRequestedDSHubConnection{ false };
+
+	/** Critical section to lock server startup timings while accessing */
+	mutable FCriticalSection ServerStartupTimingsLock;
+
+	/** Timing of each dedicated server startup phase, indexed by EAccelByteServerStartupPhase */
+	FAccelByteServerStartupPhaseTiming ServerStartupTimings[AccelByteServerStartupPhaseCount];
+
 	/** Flag denoting whether there has been an update to any of the sessions in the interface */
 	bool bReceivedSessionUpdate{ false };
 
@@ -1150,6 +1294,8 @@ private:
 	//~ Begin Server Notification Handlers
 	void OnServerClaimedNotification(const FAccelByteModelsServerClaimedNotification& Notification);
 	void OnV2BackfillProposalNotification(const FAccelByteModelsV2MatchmakingBackfillProposalNotif& Notification);
+	void OnDSHubConnectSuccessNotification();
+	void OnDSHubConnectFailedNotification(int32 ErrorCode, const FString& ErrorMessage);
 	//~ End Server Notification Handlers
 
 	void UpdateSessionMembers(FNamedOnlineSession* Session, const TArray<FAccelByteModelsV2SessionUser>& PreviousMembers, const bool bHasInvitedPlayersChanged);
@@ -1192,6 +1338,12 @@ protected:
 
 	// Making this async task a friend so that it can add new named sessions
 	friend class FOnlineAsyncTaskAccelByteGetServerClaimedV2Session;
+
+	// Making this exec test a friend so that it can add named sessions and set their info to register players against
+	friend class FExecTestSessionPlayerRegistrationStress;
+
+	// Making this exec test a friend so that it can add named sessions for backfill proposals to be evaluated against
+	friend class FExecTestBackfillManager;
 };
 
 typedef TSharedPtr<FOnlineSessionV2AccelByte, ESPMode::ThreadSafe> FOnlineSessionV2AccelBytePtr;
@@ -6,13 +6,24 @@
 #include "OnlineSubsystemAccelByte.h"
 #include "Interfaces/OnlineStoreInterfaceV2.h"
 #include "Models/AccelByteEcommerceModels.h"
+#include "Async/Future.h"
 
 /** Typedef for a map of Offers to Item's Dynamic Data Map */
 using FOfferToDynamicDataMap = TMap<FUniqueOfferId, TSharedRef<FAccelByteModelsItemDynamicData>>;
 /** Typedef for a map of user IDs to Item's Dynamic Data Map */
 using FUserIDToDynamicDataMap = TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FOfferToDynamicDataMap>;
 
-class ONLINESUBSYSTEMACCELBYTE_API FOnlineStoreV2AccelByte : public IOnlineStoreV2
+/** Freshness of the dynamic data cached for a single user's offers */
+struct FAccelByteOfferDynamicDataFreshness
+{
+	/** Platform time in seconds that the dynamic data of each offer was last fetched at */
+	TMap<FUniqueOfferId, double> FetchedTimeInSeconds;
+
+	/** Incremented each time the dynamic data of any of the user's offers changes */
+	uint32 Version = 0;
+};
+
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineStoreV2AccelByte : public IOnlineStoreV2, public TSharedFromThis<FOnlineStoreV2AccelByte, ESPMode::ThreadSafe>
 {
 PACKAGE_SCOPE:
 	/** Constructor that is invoked by the Subsystem instance to create a store interface instance */
@@ -25,12 +36,96 @@ PACKAGE_SCOPE:
 	virtual void ReplaceOffers(TMap<FUniqueOfferId, FOnlineStoreOfferRef> InOffer);
 	virtual void EmplaceOffers(const TMap<FUniqueOfferId, FOnlineStoreOfferRef>& InOffer);
 	virtual void ResetOffers();
+
+	/**
+	 * Merge offers fetched from the backend into the cached offers. An offer whose UpdatedAt field matches the cached
+	 * offer keeps its cached instance, so only changed offers are replaced. If the offers are the complete catalog, any
+	 * catalog offer that is no longer listed is removed. Offers fetched in any language other than the one the cache
+	 * holds are discarded, as the language was switched while they were in flight.
+	 *
+	 * @param InOffers Offers fetched from the backend, keyed by offer ID
+	 * @param bIsCompleteCatalog Whether the offers are every purchasable offer in the namespace
+	 * @param InLanguage Language the offers were fetched in
+	 * @returns number of offers that were added, replaced or removed
+	 */
+	int32 MergeOffers(const TMap<FUniqueOfferId, FOnlineStoreOfferRef>& InOffers, bool bIsCompleteCatalog, const FString& InLanguage);
+
+	/**
+	 * Switch the cached offers to the given language. Offers cached for any other language are dropped and the
+	 * snapshot saved for the new language is loaded in their place on a background thread.
+	 *
+	 * @returns future set to the number of offers loaded from the snapshot once the load has finished
+	 */
+	TFuture<int32> SetOffersLanguage(const FString& InLanguage);
+
+	/** Get the language of the cached offers */
+	FString GetOffersLanguage() const;
+
+	/**
+	 * Load the catalog snapshot saved on disk for the current namespace and the given language into the cached offers.
+	 * Nothing is loaded if the cached offers are in another language, or if a complete catalog has already been cached
+	 * in this language.
+	 *
+	 * @returns number of offers loaded from the snapshot, or zero if there was no snapshot to load
+	 */
+	int32 LoadCatalogSnapshot(const FString& InLanguage);
+
+	/**
+	 * Load the catalog snapshot for the given language on a background thread, so that reading and parsing it never
+	 * stalls the game thread. Does nothing if catalog snapshots are disabled.
+	 *
+	 * @returns future set to the number of offers loaded from the snapshot once the load has finished
+	 */
+	TFuture<int32> LoadCatalogSnapshotInBackground(const FString& InLanguage);
+
+	/**
+	 * Save the catalog offers currently cached to disk as the snapshot for the current namespace and the given language.
+	 * Nothing is saved if the cached offers are in another language. Safe to call from any thread, saves are serialised
+	 * so that an older catalog never overwrites a newer one.
+	 */
+	bool SaveCatalogSnapshot(const FString& InLanguage) const;
+
+	/** Get the file path of the catalog snapshot for the current namespace and the given language */
+	FString GetCatalogSnapshotPath(const FString& InLanguage) const;
+
+	/**
+	 * Whether complete catalog fetches should be saved to disk and loaded again on startup.
+	 */
+	bool IsCatalogSnapshotEnabled() const
+	{
+		return bIsCatalogSnapshotEnabled;
+	}
+
 	/** Critical sections for thread safe operation of Offers */
 	mutable FCriticalSection OffersLock;
 	virtual void EmplaceOfferDynamicData(const FUniqueNetId& InUserId, TSharedRef<FAccelByteModelsItemDynamicData> InDynamicData);
 	/** Critical sections for thread safe operation of DynamicData */
 	mutable FCriticalSection DynamicDataLock;
 
+	/**
+	 * Sends the dynamic data queries made since the last tick, in one batch per user. Do not call this method directly,
+	 * it will be called from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
+	/**
+	 * Override the dynamic data freshness window read from config, used by exec tests to force a refresh.
+	 */
+	void SetOfferDynamicDataFreshness(double InFreshnessSeconds);
+
+	/**
+	 * Mark the dynamic data cached for an offer as stale, so that the next query fetches it again. Called once an order
+	 * for the offer completes, as its purchase limits and stock have changed. A fetch of the offer already in flight is
+	 * not trusted to refresh it, as the backend may have answered it before the order went through.
+	 */
+	void InvalidateOfferDynamicData(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId);
+
+	/**
+	 * Get the key that identifies an offer query, so that identical queries in flight at once can share one request.
+	 * The user is part of the key, as each query is sent with that user's credentials.
+	 */
+	static FString GetOfferQueryKey(const FUniqueNetId& UserId, const FOnlineStoreFilter& Filter, const FString& InLanguage);
+
 	int32 GetServiceLabel();
 	void SetServiceLabel(int32 InServiceLabel);
 public:
@@ -60,18 +155,103 @@ public:
 	virtual void QueryOffersById(const FUniqueNetId& UserId, const TArray<FUniqueOfferId>& OfferIds, const FOnQueryOnlineStoreOffersComplete& Delegate) override;
 	virtual void QueryOfferBySku(const FUniqueNetId& UserId, const FString& Sku, const FOnQueryOnlineStoreOffersComplete& Delegate);
 	virtual void QueryOfferDynamicData(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId, const FOnQueryOnlineStoreOffersComplete& Delegate);
+
+	/**
+	 * Query the dynamic data of several offers for a user, such as purchase limits and stock. Queries made within the same
+	 * frame are sent as one batch on the next tick, and only offers whose cached dynamic data is no longer fresh are
+	 * fetched. The delegate is always fired on a later tick, with the offer IDs that were asked for.
+	 */
+	virtual void QueryOffersDynamicData(const FUniqueNetId& UserId, const TArray<FUniqueOfferId>& OfferIds, const FOnQueryOnlineStoreOffersComplete& Delegate);
 	virtual void GetOffers(TArray<FOnlineStoreOfferRef>& OutOffers) const override;
 	virtual TSharedPtr<FOnlineStoreOffer> GetOffer(const FUniqueOfferId& OfferId) const override;
 	virtual TSharedPtr<FOnlineStoreOffer> GetOfferBySku(const FString& Sku) const;
 	virtual TSharedPtr<FAccelByteModelsItemDynamicData> GetOfferDynamicData(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId) const;
+
+	/**
+	 * Check whether the dynamic data cached for an offer was fetched within the freshness window, configured with
+	 * OfferDynamicDataFreshnessSeconds, and has not been invalidated by an order since.
+	 */
+	bool IsOfferDynamicDataFresh(const FUniqueNetId& UserId, const FUniqueOfferId& OfferId) const;
+
+	/**
+	 * Get a counter that is incremented whenever the dynamic data of any offer for the user changes, or zero if nothing
+	 * has been cached for them. UI can compare this against the version it last drew to skip redundant refreshes.
+	 */
+	uint32 GetOfferDynamicDataVersion(const FUniqueNetId& UserId) const;
 	
 protected:
+	/** Dynamic data query waiting for the next tick to be sent */
+	struct FPendingOfferDynamicDataQuery
+	{
+		FUniqueNetIdAccelByteUserRef UserId;
+		TArray<FUniqueOfferId> OfferIds;
+		FOnQueryOnlineStoreOffersComplete Delegate;
+	};
+
+	/** Dynamic data query waiting on one or more fetches, answered once the last of them completes */
+	struct FOfferDynamicDataQueryState
+	{
+		FPendingOfferDynamicDataQuery Query;
+		int32 OutstandingFetches = 0;
+		bool bWasSuccessful = true;
+		FString Error;
+	};
+
+	/** Dynamic data fetch in flight for a user, shared by every query that needs one of its offers */
+	struct FOfferDynamicDataFetch
+	{
+		TArray<TSharedRef<FOfferDynamicDataQueryState>> WaitingQueries;
+
+		/** Offers invalidated while the fetch was in flight, which are left stale when it completes */
+		TSet<FUniqueOfferId> InvalidatedOfferIds;
+	};
+
+	/** Handler for a dynamic data fetch completing, answering every query that was only waiting on it */
+	void OnOfferDynamicDataFetchComplete(bool bWasSuccessful, const TArray<FUniqueOfferId>& FetchedOfferIds, const FString& Error, FUniqueNetIdAccelByteUserRef UserId, TSharedRef<FOfferDynamicDataFetch> Fetch, TArray<FUniqueOfferId> RequestedOfferIds);
+
+	/** Handler for a shared offer query completing, fanning the result out to every caller waiting on it */
+	void OnQueryOffersByFilterComplete(bool bWasSuccessful, const TArray<FUniqueOfferId>& OfferIds, const FString& Error, FString QueryKey);
+
+
 	/** Instance of the subsystem that created this interface */
 	FOnlineSubsystemAccelByte* AccelByteSubsystem = nullptr;
 	TMap<FUniqueCategoryId, FOnlineStoreCategory> StoreCategories;
 	TMap<FUniqueOfferId, FOnlineStoreOfferRef> StoreOffers;
 	FUserIDToDynamicDataMap OffersDynamicData;
 
+	/** Freshness and version of the dynamic data cached for each user, guarded by DynamicDataLock */
+	TMap<TSharedRef<const FUniqueNetIdAccelByteUser>, FAccelByteOfferDynamicDataFreshness> OffersDynamicDataFreshness;
+
+	/** Dynamic data queries made since the last tick */
+	TArray<FPendingOfferDynamicDataQuery> PendingDynamicDataQueries;
+
+	/** Critical sections for thread safe operation of PendingDynamicDataQueries and InFlightDynamicDataFetches, taken before DynamicDataLock */
+	FCriticalSection PendingDynamicDataQueriesLock;
+
+	/** Dynamic data fetch in flight for each offer, keyed by AccelByte user ID and then by offer ID */
+	TMap<FString, TMap<FUniqueOfferId, TSharedRef<FOfferDynamicDataFetch>>> InFlightDynamicDataFetches;
+
+	/** Seconds that fetched dynamic data is considered fresh for, read from OfferDynamicDataFreshnessSeconds in config */
+	double OfferDynamicDataFreshnessSeconds = 30.0;
+
+	/** IDs of the cached offers that came from a complete catalog fetch or snapshot, guarded by OffersLock */
+	TSet<FUniqueOfferId> CatalogOfferIds;
+
+	/** Language of the cached offers, guarded by OffersLock */
+	FString OffersLanguage;
+
+	/** Critical section serialising reads and writes of the catalog snapshot files, taken before OffersLock */
+	mutable FCriticalSection CatalogSnapshotLock;
+
+	/** Delegates waiting on each offer query in flight, keyed by the query key */
+	TMap<FString, TArray<FOnQueryOnlineStoreOffersComplete>> PendingOfferQueries;
+
+	/** Critical sections for thread safe operation of PendingOfferQueries */
+	FCriticalSection PendingOfferQueriesLock;
+
+	/** Whether complete catalog fetches are saved to disk, read from bEnableStoreCatalogSnapshot in config */
+	bool bIsCatalogSnapshotEnabled = true;
+
 private:
 	int32 ServiceLabel;
 };
@@ -39,6 +39,14 @@ class FOnlinePresenceAccelByte;
 class FOnlineFriendsAccelByte;
 class FOnlinePartySystemAccelByte;
 class FOnlineUserCacheAccelByte;
+class FOnlinePlayerActivityCacheAccelByte;
+class FOnlineRegionRankingAccelByte;
+class FOnlineLobbyNotificationQueueAccelByte;
+class FOnlineLoginBootstrapAccelByte;
+class FOnlineBackfillManagerAccelByte;
+class FOnlineServerHeartbeatAccelByte;
+class FOnlineAsyncTaskMetricsAccelByte;
+class FOnlineOperationTraceAccelByte;
 class FOnlineEntitlementsAccelByte;
 class FOnlineStoreV2AccelByte;
 class FOnlinePurchaseAccelByte;
@@ -51,6 +59,7 @@ class FOnlineStatisticAccelByte;
 class FOnlineChatAccelByte;
 class FOnlineAuthAccelByte;
 class FExecTestBase;
+class FExecTestBackendOverrides;
 class FOnlineAchievementsAccelByte;
 
 struct FAccelByteModelsNotificationMessage;
@@ -89,6 +98,30 @@ typedef TSharedPtr<FOnlinePartySystemAccelByte, ESPMode::ThreadSafe> FOnlinePart
 /** Shared pointer to the AccelByte user store */
 typedef TSharedPtr<FOnlineUserCacheAccelByte, ESPMode::ThreadSafe> FOnlineUserCacheAccelBytePtr;
 
+/** Shared pointer to the AccelByte implementation of the player activity cache */
+typedef TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> FOnlinePlayerActivityCacheAccelBytePtr;
+
+/** Shared pointer to the AccelByte implementation of the QoS region ranking */
+typedef TSharedPtr<FOnlineRegionRankingAccelByte, ESPMode::ThreadSafe> FOnlineRegionRankingAccelBytePtr;
+
+/** Shared pointer to the AccelByte lobby notification queue */
+typedef TSharedPtr<FOnlineLobbyNotificationQueueAccelByte, ESPMode::ThreadSafe> FOnlineLobbyNotificationQueueAccelBytePtr;
+
+/** Shared pointer to the AccelByte post-login bootstrap */
+typedef TSharedPtr<FOnlineLoginBootstrapAccelByte, ESPMode::ThreadSafe> FOnlineLoginBootstrapAccelBytePtr;
+
+/** Shared pointer to the AccelByte game server backfill manager */
+typedef TSharedPtr<FOnlineBackfillManagerAccelByte, ESPMode::ThreadSafe> FOnlineBackfillManagerAccelBytePtr;
+
+/** Shared pointer to the AccelByte game server heartbeat */
+typedef TSharedPtr<FOnlineServerHeartbeatAccelByte, ESPMode::ThreadSafe> FOnlineServerHeartbeatAccelBytePtr;
+
+/** Shared pointer to the AccelByte async task metrics */
+typedef TSharedPtr<FOnlineAsyncTaskMetricsAccelByte, ESPMode::ThreadSafe> FOnlineAsyncTaskMetricsAccelBytePtr;
+
+/** Shared pointer to the AccelByte operation trace */
+typedef TSharedPtr<FOnlineOperationTraceAccelByte, ESPMode::ThreadSafe> FOnlineOperationTraceAccelBytePtr;
+
 /** Shared pointer to the AccelByte async task manager for this OSS */
 typedef TSharedPtr<FOnlineAsyncTaskManagerAccelByte, ESPMode::ThreadSafe> FOnlineAsyncTaskManagerAccelBytePtr;
 
@@ -176,6 +209,51 @@ public:
 	 */
 	FOnlineUserCacheAccelBytePtr GetUserCache() const;
 
+	/**
+	 * Retrieves the cache of platform, join and disconnect times for players that pass through our sessions
+	 */
+	FOnlinePlayerActivityCacheAccelBytePtr GetPlayerActivityCache() const;
+
+	/**
+	 * Retrieves the ranking of QoS regions by latency to the player for this subsystem
+	 */
+	FOnlineRegionRankingAccelBytePtr GetRegionRanking() const;
+
+	/**
+	 * Retrieves the queue that lobby notifications are routed through before being handled by each interface
+	 */
+	FOnlineLobbyNotificationQueueAccelBytePtr GetLobbyNotificationQueue() const;
+
+	/**
+	 * Retrieves the bootstrap that runs the fetches requested by the game once a local user logs in
+	 */
+	FOnlineLoginBootstrapAccelBytePtr GetLoginBootstrap() const;
+
+	/**
+	 * Retrieves the manager that decides on backfill proposals received by a game server
+	 */
+	FOnlineBackfillManagerAccelBytePtr GetBackfillManager() const;
+
+	/**
+	 * Retrieves the heartbeat that keeps a game server alive from its own thread
+	 */
+	FOnlineServerHeartbeatAccelBytePtr GetServerHeartbeat() const;
+
+	/**
+	 * Retrieves the latency and throughput metrics recorded for async tasks run by this subsystem
+	 */
+	FOnlineAsyncTaskMetricsAccelBytePtr GetAsyncTaskMetrics() const;
+
+	/**
+	 * Retrieves the trace that records spans for online operations run by this subsystem
+	 */
+	FOnlineOperationTraceAccelBytePtr GetOperationTrace() const;
+
+	/**
+	 * Retrieves the manager that runs async tasks for this subsystem on the online async task thread
+	 */
+	FOnlineAsyncTaskManagerAccelBytePtr GetAsyncTaskManager() const;
+
 	//~ Begin FTickerObjectBase
 	virtual bool Tick(float DeltaTime) override;
 	//~ End FTickerObjectBase
@@ -240,6 +318,14 @@ PACKAGE_SCOPE:
 		, PartyInterface(nullptr)
 		, PresenceInterface(nullptr)
 		, UserCache(nullptr)
+		, PlayerActivityCache(nullptr)
+		, RegionRanking(nullptr)
+		, LobbyNotificationQueue(nullptr)
+		, LoginBootstrap(nullptr)
+		, BackfillManager(nullptr)
+		, ServerHeartbeat(nullptr)
+		, AsyncTaskMetrics(nullptr)
+		, OperationTrace(nullptr)
 		, AsyncTaskManager(nullptr)
 		, TimeInterface(nullptr)
 		, AnalyticsInterface(nullptr)
@@ -300,6 +386,31 @@ PACKAGE_SCOPE:
 	{
 		ActiveExecTests.Add(ExecTest);
 	}
+
+	/**
+	 * Construct an exec test against this subsystem, run it and add it to the list of active exec tests.
+	 *
+	 * @param InWorld World instance that the test should get the subsystem instance from
+	 * @param Arguments Any arguments specific to the test type, passed after the world and subsystem name
+	 */
+	template<typename TExecTest, typename... TArguments>
+	void RunExecTest(UWorld* InWorld, TArguments&&... Arguments)
+	{
+		static_assert(TIsDerivedFrom<TExecTest, FExecTestBase>::IsDerived, "Type passed to RunExecTest must derive from FExecTestBase");
+
+		TSharedPtr<TExecTest> ExecTest = MakeShared<TExecTest>(InWorld, ACCELBYTE_SUBSYSTEM, Forward<TArguments>(Arguments)...);
+		ExecTest->Run();
+		AddExecTest(ExecTest);
+	}
+
+	/**
+	 * Get the backend calls that exec tests are answering themselves on this subsystem instance.
+	 */
+	FExecTestBackendOverrides& GetExecTestBackendOverrides() const
+	{
+		check(ExecTestBackendOverrides.IsValid());
+		return *ExecTestBackendOverrides;
+	}
 #endif
 
 	/**
@@ -348,6 +459,12 @@ PACKAGE_SCOPE:
 	
 	bool IsMultipleLocalUsersEnabled() const;
 
+	/**
+	 * Delegate handler fired when a freeform notification arrives from the lobby, passing it on to every cache that
+	 * listens for notification topics.
+	 */
+	void OnMessageNotif(const FAccelByteModelsNotificationMessage &InMessage, int32 LocalUserNum);
+
 private:
 	bool bIsAutoLobbyConnectAfterLoginSuccess = false;
 	bool bIsAutoChatConnectAfterLoginSuccess = false;
@@ -383,6 +500,30 @@ private:
 	/** Shared instance of our user cache */
 	FOnlineUserCacheAccelBytePtr UserCache;
 
+	/** Shared instance of our player activity cache */
+	FOnlinePlayerActivityCacheAccelBytePtr PlayerActivityCache;
+
+	/** Shared instance of our QoS region ranking */
+	FOnlineRegionRankingAccelBytePtr RegionRanking;
+
+	/** Shared instance of our lobby notification queue */
+	FOnlineLobbyNotificationQueueAccelBytePtr LobbyNotificationQueue;
+
+	/** Shared instance of our post-login bootstrap */
+	FOnlineLoginBootstrapAccelBytePtr LoginBootstrap;
+
+	/** Shared instance of our game server backfill manager */
+	FOnlineBackfillManagerAccelBytePtr BackfillManager;
+
+	/** Shared instance of our game server heartbeat */
+	FOnlineServerHeartbeatAccelBytePtr ServerHeartbeat;
+
+	/** Shared instance of our async task metrics */
+	FOnlineAsyncTaskMetricsAccelBytePtr AsyncTaskMetrics;
+
+	/** Shared instance of our operation trace */
+	FOnlineOperationTraceAccelBytePtr OperationTrace;
+
 	/** Async task manager used by interfaces in our OSS to handle async */
 	FOnlineAsyncTaskManagerAccelBytePtr AsyncTaskManager;
 
@@ -431,6 +572,9 @@ private:
 #if WITH_DEV_AUTOMATION_TESTS
 	/** An array of console command exec tests that are marked as incomplete. Completed tests will be removed on each tick. */
 	TArray<TSharedPtr<FExecTestBase>> ActiveExecTests;
+
+	/** Backend calls that exec tests are answering themselves, created on init so that async tasks can read it from any thread */
+	TSharedPtr<FExecTestBackendOverrides, ESPMode::ThreadSafe> ExecTestBackendOverrides;
 #endif
 
 	/**
@@ -438,8 +582,6 @@ private:
 	 */
 	void OnLoginCallback(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UserId, const FString& Error);
 
-	void OnMessageNotif(const FAccelByteModelsNotificationMessage &InMessage, int32 LocalUserNum);
-
 	void OnLobbyConnectedCallback(int32 LocalUserNum, bool bWasSuccessful, const FUniqueNetId& UniqueNetId, const FString& ErrorMessage);
 
 	void OnLobbyConnectionClosed(int32 StatusCode, const FString& Reason, bool WasClean, int32 InLocalUserNum);
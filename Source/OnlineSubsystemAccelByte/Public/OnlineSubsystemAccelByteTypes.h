@@ -425,6 +425,28 @@ struct ONLINESUBSYSTEMACCELBYTE_API TUserUniqueIdConstSharedRefMapKeyFuncs : pub
 	}
 };
 
+/**
+ * Key functions for a set of shared references to unique IDs, hashing and comparing the IDs themselves rather than the
+ * references so that two references to equal IDs are treated as the same element.
+ */
+struct ONLINESUBSYSTEMACCELBYTE_API FUniqueNetIdConstSharedRefSetKeyFuncs : public BaseKeyFuncs<TSharedRef<const FUniqueNetId>, TSharedRef<const FUniqueNetId>, false>
+{
+	static const TSharedRef<const FUniqueNetId>& GetSetKey(const TSharedRef<const FUniqueNetId>& Element)
+	{
+		return Element;
+	}
+
+	static uint32 GetKeyHash(const TSharedRef<const FUniqueNetId>& Key)
+	{
+		return GetTypeHash(Key.Get());
+	}
+
+	static bool Matches(const TSharedRef<const FUniqueNetId>& A, const TSharedRef<const FUniqueNetId>& B)
+	{
+		return (A == B) || (A.Get() == B.Get());
+	}
+};
+
 /**
  * Array of user IDs corresponding to players in a party in this session
  */
@@ -12,6 +12,9 @@
 #include "OnlineSubsystemAccelByteTypes.h"
 #include "Models/AccelByteUserModels.h"
 
+class FOnlineSubsystemAccelByte;
+class FOnlinePlayerActivityCacheAccelByte;
+
 DECLARE_DELEGATE_OneParam(FOnGetDisplayNameComplete, FString /*DisplayName*/);
 
 DECLARE_DELEGATE_TwoParams(FOnRequestCompleted, bool /*bWasSuccessful*/, const FString& /*Error*/);
@@ -62,12 +65,30 @@ public:
 	 */
 	static EAccelByteLoginType GetAccelByteLoginTypeFromNativeSubsystem(const FName& SubsystemName);
 
-	static void AddUserPlatform(const FString &UserId, const FString PlatformName);
-	static FString GetUserPlatform(const FString &UserId);
-	static void AddUserJoinTime(const FString &UserId, const FString Value);
-	static FString GetUserJoinTime(const FString &UserId);
-	static void AddUserDisconnectedTime(const FString &UserId, const FString Value);
-	static FString GetUserDisconnectedTime(const FString &UserId);
+	/**
+	 * Legacy string accessors for player platform, join and disconnect times. These now forward to the player activity
+	 * cache owned by the AccelByte subsystem, see FOnlinePlayerActivityCacheAccelByte for native timestamp access.
+	 *
+	 * Pass the subsystem instance that you are working with, otherwise the default AccelByte subsystem instance is
+	 * used, which is not the right one when running multiple worlds in the same process. GetUserJoinTime returns
+	 * FDateTime::MinValue in ISO 8601 format for players without a tracked join time.
+	 */
+	static void AddUserPlatform(const FString &UserId, const FString PlatformName, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
+	static FString GetUserPlatform(const FString &UserId, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
+	static void AddUserJoinTime(const FString &UserId, const FString Value, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
+	static FString GetUserJoinTime(const FString &UserId, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
+	static void AddUserDisconnectedTime(const FString &UserId, const FString Value, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
+	static FString GetUserDisconnectedTime(const FString &UserId, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
+
+	/**
+	 * Get the time that the given player last joined a session, as tracked by the player activity cache.
+	 *
+	 * @param UserId AccelByte ID of the player to get the join time for
+	 * @param OutJoinTime Join time of the player, only set if one was found
+	 * @param Subsystem Subsystem instance that owns the activity cache, the default instance is used if not set
+	 * @returns true if a join time is tracked for the player, false otherwise
+	 */
+	static bool GetUserJoinTime(const FString& UserId, FDateTime& OutJoinTime, const FOnlineSubsystemAccelByte* Subsystem = nullptr);
 	
 	/**
 	 * Method to calculate a local offset timestamp from UTC
@@ -75,6 +96,17 @@ public:
 	static FString GetLocalTimeOffsetFromUTC();
 
 	static EAccelBytePlatformType GetCurrentAccelBytePlatformType(const FName& NativeSubsystemName);
+
+	/**
+	 * Parse the offset and limit query parameters from a paging URL returned by the backend, such as Paging.Next or
+	 * Paging.Last on a paged result.
+	 *
+	 * @param PagingUrl URL from the paging field of a paged result
+	 * @param OutOffset Offset parsed from the URL, untouched if not found
+	 * @param OutLimit Limit parsed from the URL, untouched if not found
+	 * @returns true if both an offset and a limit were parsed from the URL, false otherwise
+	 */
+	static bool GetOffsetAndLimitFromPagingUrl(const FString& PagingUrl, int32& OutOffset, int32& OutLimit);
 	
 private:
 
@@ -84,19 +116,10 @@ private:
 	static FDelegateHandle QueryUserHandle;
 
 	/**
-	 * Cache the user platform
+	 * Get the player activity cache from the given AccelByte subsystem, falling back to the default AccelByte subsystem
+	 * instance if none is given. Returns nullptr if no subsystem is available.
 	 */
-	static TMap<FString, FString> UserPlatformMaps;
-
-	/**
-	* Cache the user join
-	*/
-	static TMap<FString, FString> UserJoinCached;
-
-	/**
-	* Cache the user progression
-	*/
-	static TMap<FString, FString> UserDisconnectedCached;
+	static TSharedPtr<FOnlinePlayerActivityCacheAccelByte, ESPMode::ThreadSafe> GetPlayerActivityCache(const FOnlineSubsystemAccelByte* Subsystem);
 
 	/**
 	 * Handler for when we successfully query user information
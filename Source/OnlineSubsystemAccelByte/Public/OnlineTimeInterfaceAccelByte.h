@@ -7,6 +7,159 @@
 #include "Interfaces/OnlineTimeInterface.h"
 #include "OnlineSubsystemAccelByteTypes.h"
 #include "Misc/DateTime.h"
+#include <atomic>
+
+/**
+ * Function returning a monotonic local clock in seconds. Defaults to FPlatformTime::Seconds, and can be replaced with a
+ * simulated clock for testing.
+ */
+using FLocalClockSource = TFunction<double()>;
+
+/**
+ * Estimates the backend's UTC clock from server time queries, in the same way that NTP does.
+ *
+ * Each sample records the local time that the request was sent and the response was received. The server time is
+ * assumed to have been read halfway through the round trip, so the offset between the server and local clocks is taken
+ * at the midpoint. Samples whose round trip is much longer than the best one seen are treated as outliers and ignored,
+ * as a slow round trip says little about when the server read its clock. Once the kept samples span long enough, a line
+ * is fit through their offsets to model the slow drift between the two clocks.
+ *
+ * Reading the estimated server time is lock free, and the returned time never goes backwards, even if a new sample
+ * moves the estimate back. The following values can be configured in the `OnlineSubsystemAccelByte` section of
+ * `DefaultEngine.ini`:
+ * - `ServerClockMaxSamples` amount of recent samples to keep, defaults to 16
+ * - `ServerClockOutlierRttFactor` multiple of the best round trip time above which samples are ignored, defaults to 2.0
+ * - `ServerClockMinDriftSpanSeconds` time that kept samples must span before drift is modelled, defaults to 60
+ * - `ServerClockMaxDriftPpm` largest drift that will be modelled in parts per million, defaults to 500
+ */
+class ONLINESUBSYSTEMACCELBYTE_API FOnlineServerClockAccelByte
+{
+public:
+
+	FOnlineServerClockAccelByte();
+
+	/**
+	 * Construct a clock reading local time from the given source rather than FPlatformTime::Seconds.
+	 */
+	explicit FOnlineServerClockAccelByte(const FLocalClockSource& InLocalClockSource);
+
+	/**
+	 * Add a server time sample and update the estimate.
+	 *
+	 * @param ServerTime UTC time returned by the backend
+	 * @param RequestSentLocalSeconds Local clock time that the request was sent
+	 * @param ResponseReceivedLocalSeconds Local clock time that the response was received
+	 * @returns true if the sample was accepted, false if it was invalid
+	 */
+	bool AddSample(const FDateTime& ServerTime, double RequestSentLocalSeconds, double ResponseReceivedLocalSeconds);
+
+	/**
+	 * Whether at least one sample has been received, and so whether the estimated server time can be read.
+	 */
+	bool IsSynced() const;
+
+	/**
+	 * Get the estimated current server UTC time in ticks. Lock free and monotonic. Returns FDateTime::MinValue() ticks
+	 * if no samples have been received.
+	 */
+	int64 GetServerUtcNowTicks() const;
+
+	/**
+	 * Get the estimated current server UTC time. Lock free and monotonic. Returns FDateTime::MinValue() if no samples
+	 * have been received.
+	 */
+	FDateTime GetServerUtcNow() const;
+
+	/**
+	 * Get the current time of the local clock used by this estimator, in seconds.
+	 */
+	double GetLocalSeconds() const;
+
+	/**
+	 * Get the modelled drift of the server clock relative to the local clock, in seconds per second.
+	 */
+	double GetDriftRate() const;
+
+	/**
+	 * Get the amount of samples currently kept.
+	 */
+	int32 GetSampleCount() const;
+
+	/**
+	 * Forget every sample and the current estimate.
+	 */
+	void Reset();
+
+private:
+
+	/** Single server time sample, with the offset between the server and local clocks at the round trip's midpoint */
+	struct FServerClockSample
+	{
+		double LocalMidpointSeconds{0.0};
+		double RoundTripSeconds{0.0};
+		int64 OffsetTicks{0};
+	};
+
+	/**
+	 * Rebuild the offset and drift model from the kept samples and publish it for readers. Must be called with the
+	 * sample lock held.
+	 */
+	void RebuildModel();
+
+	/**
+	 * Publish a new model for lock free readers. Must be called with the sample lock held, as only one writer is allowed.
+	 */
+	void PublishModel(double ReferenceLocalSeconds, int64 ReferenceOffsetTicks, double DriftRate);
+
+	/** Read local config overrides for the estimator */
+	void LoadConfig();
+
+	/** Source of the local clock */
+	FLocalClockSource LocalClockSource;
+
+	/** Mutex used to lock the samples while we add to or rebuild the model from them */
+	mutable FCriticalSection SampleLock;
+
+	/** Most recent samples received, oldest first */
+	TArray<FServerClockSample> Samples;
+
+	/**
+	 * Sequence counter guarding the published model. Odd while the model is being written, readers retry if it is odd or
+	 * changes while they read.
+	 */
+	std::atomic<uint32> ModelSequence{0};
+
+	/** Local time that the published model's offset was measured at */
+	std::atomic<double> ModelReferenceLocalSeconds{0.0};
+
+	/** Offset between the server and local clocks at the reference time, in ticks */
+	std::atomic<int64> ModelReferenceOffsetTicks{0};
+
+	/** Drift of the server clock relative to the local clock, in seconds per second */
+	std::atomic<double> ModelDriftRate{0.0};
+
+	/** Whether a model has been published */
+	std::atomic<bool> bHasModel{false};
+
+	/** Latest server time returned to a caller, used to keep the returned time monotonic */
+	mutable std::atomic<int64> LastReturnedTicks{0};
+
+	/** Amount of recent samples to keep */
+	int32 MaxSamples = 16;
+
+	/** Multiple of the best round trip time above which samples are ignored */
+	double OutlierRttFactor = 2.0;
+
+	/** Slack added to the outlier threshold, so that very fast round trips don't reject samples over a millisecond */
+	double OutlierRttToleranceSeconds = 0.002;
+
+	/** Time that kept samples must span before drift is modelled */
+	double MinDriftSpanSeconds = 60.0;
+
+	/** Largest drift that will be modelled, in parts per million */
+	double MaxDriftPpm = 500.0;
+
+};
 
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineTimeAccelByte : public IOnlineTime
 {
@@ -15,6 +168,24 @@ PACKAGE_SCOPE:
 	FOnlineTimeAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
 
 	void UpdateServerTime(const FDateTime& Time);
+
+	/**
+	 * Update the last server time and add a sample to the server clock estimate.
+	 *
+	 * @param Time UTC time returned by the backend
+	 * @param RequestSentLocalSeconds FPlatformTime::Seconds() when the request was sent
+	 * @param ResponseReceivedLocalSeconds FPlatformTime::Seconds() when the response was received
+	 */
+	void UpdateServerTime(const FDateTime& Time, double RequestSentLocalSeconds, double ResponseReceivedLocalSeconds);
+
+	/** Called by a background resync task once it has finished, successfully or not */
+	void OnResyncSampleComplete();
+
+	/**
+	 * Queries server time in the background to keep the server clock in sync, once QueryServerUtcTime has been called.
+	 * Do not call this method directly, it will be called from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
 	
 public:
 	/**
@@ -45,6 +216,29 @@ public:
 	 */
 	virtual FString GetBackCalculatedServerTime();
 
+	/**
+	 * Get the current server UTC time from the drift corrected server clock. Lock free and never goes backwards, so it
+	 * is cheap enough to call every frame.
+	 *
+	 * @returns estimated server time, or FDateTime::MinValue() if server time has not been queried yet
+	 */
+	FDateTime GetServerUtcNow() const;
+
+	/**
+	 * Get the current server UTC time from the drift corrected server clock, in ticks.
+	 */
+	int64 GetServerUtcNowTicks() const;
+
+	/**
+	 * Whether the server clock has received at least one server time sample.
+	 */
+	bool IsServerClockSynced() const;
+
+	/**
+	 * Get the estimator backing the server clock.
+	 */
+	const FOnlineServerClockAccelByte& GetServerClock() const;
+
 protected:
 	/** Instance of the subsystem that created this interface */
 	FOnlineSubsystemAccelByte* AccelByteSubsystem = nullptr;
@@ -53,4 +247,31 @@ protected:
 	FTimespan ServerTimestamp;
 	/** Critical sections for thread safe operation of ServerTime */
 	mutable FCriticalSection ServerTimeLock;
+
+	/** Drift corrected estimate of the server clock */
+	FOnlineServerClockAccelByte ServerClock;
+
+	/** Whether to resync the server clock in the background, enabled once server time has been queried */
+	FThreadSafeBool bIsBackgroundResyncEnabled = false;
+
+	/** Whether a background resync task is in flight, so that only one sample is taken at a time */
+	FThreadSafeBool bIsResyncSampleInFlight = false;
+
+	/** Amount of samples left to take in the current resync */
+	int32 RemainingResyncSamples = 0;
+
+	/** Seconds elapsed since the last resync was started */
+	float TimeSinceLastResyncSeconds = 0.0f;
+
+	/**
+	 * Seconds between background resyncs, disabled if zero or less. Can be configured with
+	 * `ServerClockResyncIntervalSeconds`, defaults to 300.
+	 */
+	float ResyncIntervalSeconds = 300.0f;
+
+	/**
+	 * Amount of samples taken back to back in each resync. Can be configured with `ServerClockSamplesPerResync`,
+	 * defaults to 4.
+	 */
+	int32 SamplesPerResync = 4;
 };
@@ -8,6 +8,7 @@
 #include "OnlineDelegateMacros.h"
 #include "OnlineSubsystemAccelByte.h"
 #include "OnlineUserCacheAccelByte.h"
+#include "OnlineCacheRefreshDebouncerAccelByte.h"
 #include "Models/AccelByteEcommerceModels.h"
 
 class UWorld;
@@ -23,15 +24,19 @@ typedef FOnGetWalletTransactionsCompleted::FDelegate FOnGetWalletTransactionsCom
 
 /**
  * Implementation of Wallet service from AccelByte services
+ *
+ * Wallet info is cached per user and currency. A cached wallet is marked stale when a checkout or code redemption
+ * touches it, or when a lobby notification with one of the `WalletNotificationTopics` configured in the
+ * `OnlineSubsystemAccelByte` section of `DefaultEngine.ini` arrives. Stale wallets are refreshed from the backend in a
+ * single batch once `EcommerceCacheRefreshDebounceSeconds` has passed, defaulting to one second, and are never served
+ * from the cache in the meantime.
  */
 class ONLINESUBSYSTEMACCELBYTE_API FOnlineWalletAccelByte : public TSharedFromThis<FOnlineWalletAccelByte, ESPMode::ThreadSafe>
 {
 PACKAGE_SCOPE:
 
 	/** Constructor that is invoked by the Subsystem instance to create a user cloud instance */
-	FOnlineWalletAccelByte(FOnlineSubsystemAccelByte* InSubsystem)
-		: AccelByteSubsystem(InSubsystem)
-	{};
+	FOnlineWalletAccelByte(FOnlineSubsystemAccelByte* InSubsystem);
 
 	TMap<FString, TSharedRef<FAccelByteModelsCurrencyList>> CurrencyCodeToCurrencyListMap;
 	/** Critical sections for thread safe operation of CurrencyCodeToCurrencyListMap */
@@ -42,6 +47,47 @@ PACKAGE_SCOPE:
 	/** Critical sections for thread safe operation of UserToWalletInfoMap */
 	mutable FCriticalSection WalletInfoListLock;
 
+	/** Time that each cached wallet of each user was last written to, guarded by WalletInfoListLock */
+	TUniqueNetIdMap<TMap<FString, FDateTime>> UserToWalletLastUpdatedMap;
+
+	/** Currency codes of cached wallets that are known to be out of date for each user, guarded by WalletInfoListLock */
+	TUniqueNetIdMap<TSet<FString>> UserToStaleWalletMap;
+
+	/**
+	 * Mark a cached wallet as out of date and queue a refresh for it. Does nothing if the wallet is not cached, such as
+	 * for a currency that the user has never queried or a real money currency.
+	 */
+	void InvalidateWalletInfo(int32 LocalUserNum, const FString& CurrencyCode);
+
+	/**
+	 * Mark the cached wallet with the given wallet ID as out of date and queue a refresh for it, for events that only
+	 * identify a wallet by ID such as credits from a code redemption.
+	 */
+	void InvalidateWalletInfoByWalletId(int32 LocalUserNum, const FString& WalletId);
+
+	/** Whether the cached wallet for the currency has been invalidated and not yet refreshed */
+	bool IsWalletInfoStale(int32 LocalUserNum, const FString& CurrencyCode) const;
+
+	/**
+	 * Invalidate cached wallets if the notification topic is one of the configured wallet topics. Refreshes only the
+	 * wallet named by a `currencyCode` field in the payload if present, otherwise every cached wallet for the user.
+	 *
+	 * @returns true if the notification was for the wallet service
+	 */
+	bool OnNotificationReceived(int32 LocalUserNum, const FString& Topic, const FString& Payload);
+
+	/**
+	 * Sends queued wallet refreshes once the debounce window has closed. Do not call this method directly, it will be
+	 * called from the owning OnlineSubsystem's ticker!
+	 */
+	void Tick(float DeltaTime);
+
+	/** Wallet refreshes queued by invalidation, keyed by local user and currency code */
+	FOnlineCacheRefreshDebouncerAccelByte RefreshDebouncer;
+
+	/** Lobby notification topics that indicate a change to a wallet, read from WalletNotificationTopics in config */
+	TArray<FString> WalletNotificationTopics;
+
 public:
 	virtual ~FOnlineWalletAccelByte() {};
 
@@ -79,10 +125,24 @@ public:
 	
 	bool GetWalletInfoByCurrencyCode(int32 LocalUserNum, const FString& CurrencyCode, bool bAlwaysRequestToService = false);
 
+	/**
+	 * Get the cached wallet for a currency. Wallets that have been invalidated are not served until they are refreshed,
+	 * so callers should query the wallet again when this returns false.
+	 *
+	 * @returns true if an up to date wallet was cached for the currency
+	 */
 	bool GetWalletInfoFromCache(int32 LocalUserNum, const FString& CurrencyCode, FAccelByteModelsWalletInfo& OutWalletInfo);
 
 	void AddWalletInfoToList(int32 LocalUserNum, const FString& CurrencyCode, const TSharedRef<FAccelByteModelsWalletInfo>& InWalletInfo);
 
+	/**
+	 * Get the time that the cached wallet for a currency was last refreshed, so that callers can skip querying a wallet
+	 * that they have already seen.
+	 *
+	 * @returns UTC time of the last refresh, or FDateTime::MinValue() if the wallet is not cached
+	 */
+	FDateTime GetWalletLastUpdatedTime(int32 LocalUserNum, const FString& CurrencyCode) const;
+
 	bool ListWalletTransactionsByCurrencyCode(int32 LocalUserNum, const FString& CurrencyCode, int32 Offset = 0, int32 Limit = 20);
 
 protected: